@@ -25,6 +25,7 @@
 #include <QtCore/QJsonDocument>
 #include <QtCore/QSaveFile>
 #include <QtCore/QString>
+#include <QtCore/QThread>
 #include <QtGui/QImageReader>
 #include <QtCore/QVector>
 #include <QtCore/QUrlQuery>
@@ -305,6 +306,8 @@ AssetServer::AssetServer(ReceivedMessage& message) :
     static const int TASK_POOL_THREAD_COUNT = 50;
     _transferTaskPool.setMaxThreadCount(TASK_POOL_THREAD_COUNT);
     _bakingTaskPool.setMaxThreadCount(1);
+    // keep the threads, and with them their oven workers, around between bakes
+    _bakingTaskPool.setExpiryTimeout(-1);
 
     // Queue all requests until the Asset Server is fully setup
     auto& packetReceiver = DependencyManager::get<NodeList>()->getPacketReceiver();
@@ -392,6 +395,16 @@ void AssetServer::completeSetup() {
                     " (" << maxBandwidth << "bits/s)";
     }
 
+    // bake several assets at once, each in an oven worker of its own
+    static const QString MAX_CONCURRENT_BAKES_OPTION = "max_concurrent_bakes";
+    int maxConcurrentBakes = assetServerObject[MAX_CONCURRENT_BAKES_OPTION].toInt(0);
+    if (maxConcurrentBakes <= 0) {
+        // the texture bakers are multi-threaded themselves, so leave them some cores
+        maxConcurrentBakes = std::max(QThread::idealThreadCount() / 2, 1);
+    }
+    _bakingTaskPool.setMaxThreadCount(maxConcurrentBakes);
+    qCInfo(asset_server) << "Baking up to" << maxConcurrentBakes << "assets at once";
+
     // get the path to the asset folder from the domain server settings
     static const QString ASSETS_PATH_OPTION = "assets_path";
     auto assetsJSONValue = assetServerObject[ASSETS_PATH_OPTION];
@@ -957,6 +970,35 @@ void AssetServer::sendStatsPacket() {
         serverStats[uuid] = nodeStats;
     });
 
+    quint64 now = usecTimestampNow();
+    float elapsedMinutes = _lastStatsTime > 0 ? (float)(now - _lastStatsTime) / (USECS_PER_SECOND * SECS_PER_MINUTE) : 0.0f;
+    int numFinishedBakes = _numCompletedBakes + _numFailedBakes;
+    int numRunningBakes = 0;
+    for (const auto& task : _pendingBakes) {
+        numRunningBakes += task->isBaking() ? 1 : 0;
+    }
+
+    QJsonObject bakingStats;
+    bakingStats["1. Queued"] = _pendingBakes.size() - numRunningBakes;
+    bakingStats["2. Baking"] = numRunningBakes;
+    bakingStats["3. Max Concurrent"] = _bakingTaskPool.maxThreadCount();
+    bakingStats["4. Completed"] = _numCompletedBakes;
+    bakingStats["5. Failed"] = _numFailedBakes;
+    bakingStats["6. Bakes/min"] = elapsedMinutes > 0.0f ? numFinishedBakes / elapsedMinutes : 0.0f;
+    bakingStats["7. Avg Bake Time (s)"] = numFinishedBakes > 0 ?
+        (float)_totalBakeTime / (numFinishedBakes * USECS_PER_SECOND) : 0.0f;
+    quint64 numBakeCacheLookups = _numBakeCacheHits + _numBakeCacheMisses;
+    bakingStats["8. Bake Cache Hit Rate"] = numBakeCacheLookups > 0 ?
+        (float)_numBakeCacheHits / numBakeCacheLookups : 0.0f;
+    serverStats["Baking"] = bakingStats;
+
+    _lastStatsTime = now;
+    _numCompletedBakes = 0;
+    _numFailedBakes = 0;
+    _totalBakeTime = 0;
+    _numBakeCacheHits = 0;
+    _numBakeCacheMisses = 0;
+
     // send off the stats packets
     ThreadedAssignment::addPacketStatsAndSendStatsPacket(serverStats);
 }
@@ -1097,6 +1139,16 @@ bool pathIsFolder(const AssetUtils::AssetPath& path) {
 void AssetServer::removeBakedPathsForDeletedAsset(AssetUtils::AssetHash hash) {
     // we deleted the file with this hash
 
+    // stop baking it, if it still was
+    auto it = _pendingBakes.find(hash);
+    if (it != _pendingBakes.end()) {
+        if (_bakingTaskPool.tryTake(it->get())) {
+            _pendingBakes.erase(it);
+        } else {
+            it.value()->abort();
+        }
+    }
+
     // check if we had baked content for that file that should also now be removed
     // by calling deleteMappings for the hidden baked content folder for this hash
     AssetUtils::AssetPathList hiddenBakedFolder { AssetUtils::HIDDEN_BAKED_CONTENT_FOLDER + hash + "/" };
@@ -1309,9 +1361,20 @@ void AssetServer::handleFailedBake(QString originalAssetHash, QString assetPath,
 
     writeMetaFile(originalAssetHash, meta);
 
+    recordBakeStats(originalAssetHash);
+    _numFailedBakes++;
     _pendingBakes.remove(originalAssetHash);
 }
 
+void AssetServer::recordBakeStats(const AssetUtils::AssetHash& originalAssetHash) {
+    auto it = _pendingBakes.find(originalAssetHash);
+    if (it != _pendingBakes.end()) {
+        _totalBakeTime += it.value()->getBakeTime();
+        _numBakeCacheHits += it.value()->getCacheHits();
+        _numBakeCacheMisses += it.value()->getCacheMisses();
+    }
+}
+
 void AssetServer::handleCompletedBake(QString originalAssetHash, QString originalAssetPath,
                                       QString bakedTempOutputDir) {
     auto reportCompletion = [this, originalAssetPath, originalAssetHash](bool errorCompletingBake,
@@ -1332,6 +1395,12 @@ void AssetServer::handleCompletedBake(QString originalAssetHash, QString origina
 
         writeMetaFile(originalAssetHash, meta);
 
+        recordBakeStats(originalAssetHash);
+        if (errorCompletingBake) {
+            _numFailedBakes++;
+        } else {
+            _numCompletedBakes++;
+        }
         _pendingBakes.remove(originalAssetHash);
     };
 
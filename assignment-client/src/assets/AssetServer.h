@@ -41,6 +41,7 @@ enum class BakedAssetType : int {
 enum class ModelBakeVersion : BakeVersion {
     Initial = INITIAL_BAKE_VERSION,
     MetaTextureJson,
+    HFMBlob,
 
     COUNT
 };
@@ -140,6 +141,7 @@ private:
     void handleCompletedBake(QString originalAssetHash, QString assetPath, QString bakedTempOutputDir);
     void handleFailedBake(QString originalAssetHash, QString assetPath, QString errors);
     void handleAbortedBake(QString originalAssetHash, QString assetPath);
+    void recordBakeStats(const AssetUtils::AssetHash& originalAssetHash);
 
     /// Create meta file to describe baked content for original asset
     std::pair<bool, AssetMeta> readMetaFile(AssetUtils::AssetHash hash);
@@ -156,9 +158,19 @@ private:
     /// Task pool for handling uploads and downloads of assets
     QThreadPool _transferTaskPool;
 
+    /// Bakes are keyed by the hash of the asset content, so the same content is only baked once, whatever its paths
     QHash<AssetUtils::AssetHash, std::shared_ptr<BakeAssetTask>> _pendingBakes;
+    /// Each thread of the baking pool keeps an oven worker process of its own
     QThreadPool _bakingTaskPool;
 
+    // bake stats, since the last stats packet
+    int _numCompletedBakes { 0 };
+    int _numFailedBakes { 0 };
+    quint64 _totalBakeTime { 0 };
+    quint64 _numBakeCacheHits { 0 };
+    quint64 _numBakeCacheMisses { 0 };
+    quint64 _lastStatsTime { 0 };
+
     QMutex _queuedRequestsMutex;
     bool _isQueueingRequests { true };
     using RequestQueue = QVector<QPair<QSharedPointer<ReceivedMessage>, SharedNodePointer>>;
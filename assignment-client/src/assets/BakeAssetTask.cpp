@@ -11,29 +11,18 @@
 
 #include "BakeAssetTask.h"
 
-#include <mutex>
-
-#include <QtCore/QThread>
-#include <QCoreApplication>
+#include <QtCore/QFile>
 
 #include <PathUtils.h>
+#include <SharedUtil.h>
 
-static const int OVEN_STATUS_CODE_SUCCESS { 0 };
-static const int OVEN_STATUS_CODE_FAIL { 1 };
-static const int OVEN_STATUS_CODE_ABORT { 2 };
-
-std::once_flag registerMetaTypesFlag;
+#include "OvenWorker.h"
 
 BakeAssetTask::BakeAssetTask(const AssetUtils::AssetHash& assetHash, const AssetUtils::AssetPath& assetPath, const QString& filePath) :
     _assetHash(assetHash),
     _assetPath(assetPath),
     _filePath(filePath)
 {
-
-    std::call_once(registerMetaTypesFlag, []() {
-        qRegisterMetaType<QProcess::ProcessError>("QProcess::ProcessError");
-        qRegisterMetaType<QProcess::ExitStatus>("QProcess::ExitStatus");
-    });
 }
 
 void BakeAssetTask::run() {
@@ -42,6 +31,14 @@ void BakeAssetTask::run() {
         return;
     }
 
+    if (_wasAborted) {
+        // aborted while it was still queued
+        emit bakeAborted(_assetHash, _assetPath);
+        return;
+    }
+
+    quint64 start = usecTimestampNow();
+
     // Make a new temporary directory for the Oven to work in
     QString tempOutputDir = PathUtils::generateTemporaryDir();
     QString tempOutputDirName = QDir(tempOutputDir).dirName();
@@ -63,82 +60,44 @@ void BakeAssetTask::run() {
         return;
     }
 
-    auto base = QFileInfo(QCoreApplication::applicationFilePath()).absoluteDir();
-    QString path = base.absolutePath() + "/oven";
     QString extension = _assetPath.mid(_assetPath.lastIndexOf('.') + 1);
-    QStringList args {
-        "-i", tempAssetPath,
-        "-o", tempOutputDir,
-        "-t", extension,
-    };
-
-    _ovenProcess.reset(new QProcess());
-
-    QEventLoop loop;
 
-    connect(_ovenProcess.get(), static_cast<void(QProcess::*)(int, QProcess::ExitStatus)>(&QProcess::finished),
-            this, [&loop, this, tempOutputDir, tempAssetPath, tempOutputDirName](int exitCode, QProcess::ExitStatus exitStatus) {
-        qDebug() << "Baking process finished: " << exitCode << exitStatus;
-
-        if (exitStatus == QProcess::CrashExit) {
-            PathUtils::deleteMyTemporaryDir(tempOutputDirName);
-            if (_wasAborted) {
-                emit bakeAborted(_assetHash, _assetPath);
-            } else {
-                QString errors = "Fatal error occurred while baking";
-                emit bakeFailed(_assetHash, _assetPath, errors);
-            }
-        } else if (exitCode == OVEN_STATUS_CODE_SUCCESS) {
-            emit bakeComplete(_assetHash, _assetPath, tempOutputDir);
-        } else if (exitStatus == QProcess::NormalExit && exitCode == OVEN_STATUS_CODE_ABORT) {
-            _wasAborted.store(true);
-            PathUtils::deleteMyTemporaryDir(tempOutputDirName);
-            emit bakeAborted(_assetHash, _assetPath);
+    qDebug() << "Baking" << _assetPath << "in an oven worker";
+    auto& worker = OvenWorker::getForCurrentThread();
+    int status = worker.bake(tempAssetPath, tempOutputDir, extension, _wasAborted);
+    _bakeTime = usecTimestampNow() - start;
+    _cacheHits = worker.getLastCacheHits();
+    _cacheMisses = worker.getLastCacheMisses();
+    qDebug() << "Baking finished:" << _assetPath << status;
+
+    if (status == OVEN_STATUS_CODE_SUCCESS) {
+        emit bakeComplete(_assetHash, _assetPath, tempOutputDir);
+    } else if (status == OVEN_STATUS_CODE_ABORT || _wasAborted) {
+        _wasAborted.store(true);
+        PathUtils::deleteMyTemporaryDir(tempOutputDirName);
+        emit bakeAborted(_assetHash, _assetPath);
+    } else if (status == OVEN_STATUS_CODE_CRASH) {
+        PathUtils::deleteMyTemporaryDir(tempOutputDirName);
+        QString errors = "Fatal error occurred while baking";
+        emit bakeFailed(_assetHash, _assetPath, errors);
+    } else {
+        QString errors;
+        QDir outputDir = tempOutputDir;
+        auto errorFilePath = outputDir.absoluteFilePath("errors.txt");
+        QFile errorFile { errorFilePath };
+        if (errorFile.open(QIODevice::ReadOnly)) {
+            errors = errorFile.readAll();
+            errorFile.close();
         } else {
-            QString errors;
-            if (exitCode == OVEN_STATUS_CODE_FAIL) {
-                QDir outputDir = tempOutputDir;
-                auto errorFilePath = outputDir.absoluteFilePath("errors.txt");
-                QFile errorFile { errorFilePath };
-                if (errorFile.open(QIODevice::ReadOnly)) {
-                    errors = errorFile.readAll();
-                    errorFile.close();
-                } else {
-                    errors = "Unknown error occurred while baking";
-                }
-            }
-            PathUtils::deleteMyTemporaryDir(tempOutputDirName);
-            emit bakeFailed(_assetHash, _assetPath, errors);
+            errors = "Unknown error occurred while baking";
         }
-
-        loop.quit();
-    });
-
-    qDebug() << "Starting oven for " << _assetPath;
-    _ovenProcess->start(path, args, QIODevice::ReadOnly);
-    qDebug() << "Running:" << path << args;
-    if (!_ovenProcess->waitForStarted()) {
         PathUtils::deleteMyTemporaryDir(tempOutputDirName);
-
-        QString errors = "Oven process failed to start";
         emit bakeFailed(_assetHash, _assetPath, errors);
-        return;
     }
-
-    _isBaking = true;
-
-    loop.exec();
 }
 
 void BakeAssetTask::abort() {
-    if (QThread::currentThread() != thread()) {
-        QMetaObject::invokeMethod(this, "abort");
-        return;
-    }
+    // a running bake notices within a moment, and one that is still queued won't start
     qDebug() << "Aborting BakeAssetTask for" << _assetHash;
-    if (_ovenProcess->state() != QProcess::NotRunning) {
-        qDebug() << "Teminating oven process for" << _assetHash;
-        _wasAborted = true;
-        _ovenProcess->terminate();
-    }
+    _wasAborted = true;
 }
@@ -18,7 +18,6 @@
 #include <QtCore/QObject>
 #include <QtCore/QRunnable>
 #include <QDir>
-#include <QProcess>
 
 #include <AssetUtils.h>
 
@@ -30,10 +29,13 @@ public:
     // Thread-safe inspection methods
     bool isBaking() { return _isBaking.load(); }
     bool wasAborted() const { return _wasAborted.load(); }
+    quint64 getBakeTime() const { return _bakeTime.load(); }
+    uint32_t getCacheHits() const { return _cacheHits.load(); }
+    uint32_t getCacheMisses() const { return _cacheMisses.load(); }
 
     void run() override;
 
-public slots:
+    /// Thread-safe, stops the bake if it is running, or skips it if it hasn't started yet.
     void abort();
 
 signals:
@@ -46,8 +48,10 @@ private:
     AssetUtils::AssetHash _assetHash;
     AssetUtils::AssetPath _assetPath;
     QString _filePath;
-    std::unique_ptr<QProcess> _ovenProcess { nullptr };
     std::atomic<bool> _wasAborted { false };
+    std::atomic<quint64> _bakeTime { 0 };
+    std::atomic<uint32_t> _cacheHits { 0 };
+    std::atomic<uint32_t> _cacheMisses { 0 };
 };
 
 #endif // hifi_BakeAssetTask_h
@@ -0,0 +1,133 @@
+//
+//  OvenWorker.cpp
+//  assignment-client/src/assets
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "OvenWorker.h"
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QDir>
+#include <QtCore/QFileInfo>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtCore/QThreadStorage>
+
+#include "AssetServerLogging.h"
+
+// see OVEN_WORKER_RESULT_PREFIX in tools/oven/src/BakerCLI.h
+static const QByteArray RESULT_PREFIX = "OVEN_RESULT ";
+
+static const int MAX_BAKES_PER_WORKER = 100;
+static const int START_TIMEOUT_MSECS = 30 * 1000;
+// how often a running bake checks whether it was aborted
+static const int ABORT_CHECK_INTERVAL_MSECS = 100;
+
+OvenWorker& OvenWorker::getForCurrentThread() {
+    static QThreadStorage<OvenWorker*> workers;
+    if (!workers.hasLocalData()) {
+        workers.setLocalData(new OvenWorker());
+    }
+    return *workers.localData();
+}
+
+OvenWorker::~OvenWorker() {
+    stop();
+}
+
+bool OvenWorker::start() {
+    auto base = QFileInfo(QCoreApplication::applicationFilePath()).absoluteDir();
+    QString path = base.absolutePath() + "/oven";
+
+    _process.reset(new QProcess());
+    // the oven logs to stderr, which no one reads
+    _process->setStandardErrorFile(QProcess::nullDevice());
+    _process->start(path, { "--worker" });
+    if (!_process->waitForStarted(START_TIMEOUT_MSECS)) {
+        qCWarning(asset_server) << "Oven worker failed to start:" << _process->errorString();
+        _process.reset();
+        return false;
+    }
+
+    qCDebug(asset_server) << "Started oven worker" << _process->processId();
+    _output.clear();
+    _numBakes = 0;
+    return true;
+}
+
+void OvenWorker::stop() {
+    if (!_process) {
+        return;
+    }
+    if (_process->state() != QProcess::NotRunning) {
+        // closing stdin lets an idle worker exit on its own
+        _process->closeWriteChannel();
+        if (!_process->waitForFinished(ABORT_CHECK_INTERVAL_MSECS)) {
+            _process->kill();
+            _process->waitForFinished();
+        }
+    }
+    _process.reset();
+}
+
+int OvenWorker::bake(const QString& inputPath, const QString& outputDir, const QString& type,
+                     const std::atomic<bool>& wasAborted) {
+    if (_process && (_process->state() != QProcess::Running || _numBakes >= MAX_BAKES_PER_WORKER)) {
+        stop();
+    }
+    if (!_process && !start()) {
+        return OVEN_STATUS_CODE_CRASH;
+    }
+
+    QJsonObject job;
+    job["input"] = inputPath;
+    job["output"] = outputDir;
+    job["type"] = type;
+    _process->write(QJsonDocument(job).toJson(QJsonDocument::Compact) + '\n');
+    _numBakes++;
+    _lastCacheHits = 0;
+    _lastCacheMisses = 0;
+
+    int result = readResult(wasAborted);
+    if (result == OVEN_STATUS_CODE_CRASH || result == OVEN_STATUS_CODE_ABORT) {
+        // there's no telling what state an interrupted oven is in, so the next bake gets a fresh one
+        stop();
+    }
+    return result;
+}
+
+int OvenWorker::readResult(const std::atomic<bool>& wasAborted) {
+    while (true) {
+        int end;
+        while ((end = _output.indexOf('\n')) >= 0) {
+            QByteArray line = _output.left(end).trimmed();
+            _output.remove(0, end + 1);
+            // anything else the bakers print goes to stdout too
+            if (line.startsWith(RESULT_PREFIX)) {
+                // the status code, followed by the bake cache hits and misses
+                auto fields = line.mid(RESULT_PREFIX.size()).split(' ');
+                bool ok;
+                int status = fields[0].toInt(&ok);
+                if (fields.size() >= 3) {
+                    _lastCacheHits = fields[1].toUInt();
+                    _lastCacheMisses = fields[2].toUInt();
+                }
+                return ok ? status : OVEN_STATUS_CODE_FAIL;
+            }
+        }
+
+        if (wasAborted) {
+            return OVEN_STATUS_CODE_ABORT;
+        }
+        if (_process->state() != QProcess::Running) {
+            qCWarning(asset_server) << "Oven worker exited while baking:" << _process->exitCode() << _process->exitStatus();
+            return OVEN_STATUS_CODE_CRASH;
+        }
+        _process->waitForReadyRead(ABORT_CHECK_INTERVAL_MSECS);
+        _output.append(_process->readAllStandardOutput());
+    }
+}
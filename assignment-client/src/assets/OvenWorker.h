@@ -0,0 +1,58 @@
+//
+//  OvenWorker.h
+//  assignment-client/src/assets
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_OvenWorker_h
+#define hifi_OvenWorker_h
+
+#include <atomic>
+#include <memory>
+
+#include <QtCore/QProcess>
+#include <QtCore/QString>
+
+static const int OVEN_STATUS_CODE_SUCCESS { 0 };
+static const int OVEN_STATUS_CODE_FAIL { 1 };
+static const int OVEN_STATUS_CODE_ABORT { 2 };
+// not a status the oven returns, the worker process crashed or couldn't be started
+static const int OVEN_STATUS_CODE_CRASH { -1 };
+
+// An oven process started in worker mode, which bakes one file after another rather than exiting after each.
+//
+// Each thread of the baking task pool keeps a worker of its own, so bakes don't pay for the oven's startup, while a
+// crash still only takes down the bake that caused it. A worker is restarted after a crash, after an aborted bake,
+// and every so often to bound what the bakers may leak.
+class OvenWorker {
+public:
+    /// The worker of the current thread, which is started when first used and stopped when the thread exits.
+    static OvenWorker& getForCurrentThread();
+
+    ~OvenWorker();
+
+    /// Bakes a file into outputDir, blocking until the oven is done, and returns its status code.
+    /// Stops the bake, and returns OVEN_STATUS_CODE_ABORT, as soon as wasAborted is set.
+    int bake(const QString& inputPath, const QString& outputDir, const QString& type, const std::atomic<bool>& wasAborted);
+
+    /// How many of the results of the last bake came from the bake cache, and how many had to be baked.
+    uint32_t getLastCacheHits() const { return _lastCacheHits; }
+    uint32_t getLastCacheMisses() const { return _lastCacheMisses; }
+
+private:
+    bool start();
+    void stop();
+    int readResult(const std::atomic<bool>& wasAborted);
+
+    std::unique_ptr<QProcess> _process;
+    QByteArray _output;
+    int _numBakes { 0 };
+    uint32_t _lastCacheHits { 0 };
+    uint32_t _lastCacheMisses { 0 };
+};
+
+#endif // hifi_OvenWorker_h
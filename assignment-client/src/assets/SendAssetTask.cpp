@@ -36,6 +36,14 @@ SendAssetTask::SendAssetTask(QSharedPointer<ReceivedMessage> message, const Shar
 }
 
 void SendAssetTask::run() {
+    // a request may carry the gets of many assets, or of many ranges of one, each of which gets a reply of its own
+    const qint64 GET_SIZE = sizeof(MessageID) + AssetUtils::SHA256_HASH_LENGTH + 2 * sizeof(AssetUtils::DataOffset);
+    while (_message->getBytesLeftToRead() >= GET_SIZE) {
+        sendAsset();
+    }
+}
+
+void SendAssetTask::sendAsset() {
     MessageID messageID;
     ByteRange byteRange;
 
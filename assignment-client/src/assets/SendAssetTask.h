@@ -30,6 +30,8 @@ public:
     void run() override;
 
 private:
+    void sendAsset();
+
     QSharedPointer<ReceivedMessage> _message;
     SharedNodePointer _senderNode;
     QDir _resourcesDir;
@@ -309,9 +309,17 @@ void AudioMixer::sendStatsPacket() {
     addTiming(_mixTiming, "mix");
     addTiming(_eventsTiming, "events");
 
-#ifdef HIFI_AUDIO_MIXER_DEBUG
+    // per stage CPU time, summed across slave threads
+    const float NSECS_PER_USEC_F = 1000.0f;
+    auto addStageTiming = [&](uint64_t time, string name) {
+        timingStats[("us_per_stage_" + name).c_str()] = (float)time / NSECS_PER_USEC_F / (float)_numStatFrames;
+    };
+    addStageTiming(_stats.decodeTime, "decode");
+    addStageTiming(_stats.mixTime, "mix");
+    addStageTiming(_stats.encodeTime, "encode");
+    addStageTiming(_stats.sendTime, "send");
+
     timingStats["ns_per_mix"] = (_stats.totalMixes > 0) ?  (float)(_stats.mixTime / _stats.totalMixes) : 0;
-#endif
 
     // call it "avg_..." to keep it higher in the display, sorted alphabetically
     statsObject["avg_timing_stats"] = timingStats;
@@ -623,21 +631,26 @@ void AudioMixer::parseSettingsObject(const QJsonObject& settingsObject) {
             deprecationNotice(MAX_FRAMES_OVER_DESIRED_JSON_KEY, QString::number(maxFramesOverDesired));
         }
 
+        // the defaults of the settings that went with the old jitter buffer, which are only worth a notice if changed
+        const int OLD_WINDOW_STARVE_THRESHOLD = 3;
+        const int OLD_WINDOW_SECONDS_FOR_DESIRED_CALC_ON_TOO_MANY_STARVES = 50;
+        const int OLD_WINDOW_SECONDS_FOR_DESIRED_REDUCTION = 10;
+
         const QString WINDOW_STARVE_THRESHOLD_JSON_KEY = "window_starve_threshold";
         int windowStarveThreshold = audioBufferGroupObject[WINDOW_STARVE_THRESHOLD_JSON_KEY].toString().toInt(&ok);
-        if (ok && windowStarveThreshold != InboundAudioStream::WINDOW_STARVE_THRESHOLD) {
+        if (ok && windowStarveThreshold != OLD_WINDOW_STARVE_THRESHOLD) {
             deprecationNotice(WINDOW_STARVE_THRESHOLD_JSON_KEY, QString::number(windowStarveThreshold));
         }
 
         const QString WINDOW_SECONDS_FOR_DESIRED_CALC_ON_TOO_MANY_STARVES_JSON_KEY = "window_seconds_for_desired_calc_on_too_many_starves";
         int windowSecondsForDesiredCalcOnTooManyStarves = audioBufferGroupObject[WINDOW_SECONDS_FOR_DESIRED_CALC_ON_TOO_MANY_STARVES_JSON_KEY].toString().toInt(&ok);
-        if (ok && windowSecondsForDesiredCalcOnTooManyStarves != InboundAudioStream::WINDOW_SECONDS_FOR_DESIRED_CALC_ON_TOO_MANY_STARVES) {
+        if (ok && windowSecondsForDesiredCalcOnTooManyStarves != OLD_WINDOW_SECONDS_FOR_DESIRED_CALC_ON_TOO_MANY_STARVES) {
             deprecationNotice(WINDOW_SECONDS_FOR_DESIRED_CALC_ON_TOO_MANY_STARVES_JSON_KEY, QString::number(windowSecondsForDesiredCalcOnTooManyStarves));
         }
 
         const QString WINDOW_SECONDS_FOR_DESIRED_REDUCTION_JSON_KEY = "window_seconds_for_desired_reduction";
         int windowSecondsForDesiredReduction = audioBufferGroupObject[WINDOW_SECONDS_FOR_DESIRED_REDUCTION_JSON_KEY].toString().toInt(&ok);
-        if (ok && windowSecondsForDesiredReduction != InboundAudioStream::WINDOW_SECONDS_FOR_DESIRED_REDUCTION) {
+        if (ok && windowSecondsForDesiredReduction != OLD_WINDOW_SECONDS_FOR_DESIRED_REDUCTION) {
             deprecationNotice(WINDOW_SECONDS_FOR_DESIRED_REDUCTION_JSON_KEY, QString::number(windowSecondsForDesiredReduction));
         }
 
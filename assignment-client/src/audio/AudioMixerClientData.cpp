@@ -553,6 +553,7 @@ int AudioMixerClientData::checkBuffersBeforeFrameSend() {
         SharedStreamPointer stream = *it;
 
         if (stream->popFrames(1, true) > 0) {
+            stream->captureLastPopOutput();
             stream->updateLastPopOutputLoudnessAndTrailingLoudness();
         }
 
@@ -648,6 +649,23 @@ void AudioMixerClientData::sendAudioStreamStatsPackets(const SharedNodePointer&
     }
 }
 
+// adds the adaptive jitter buffer state of an upstream stream to its stats
+static void addJitterBufferStats(QJsonObject& stats, const InboundAudioStream& stream) {
+    const AudioJitterEstimator& estimator = stream.getJitterEstimator();
+    stats["desired_percentile"] = estimator.getPercentileFrames();
+    stats["desired_peak"] = estimator.getPeakFrames();
+    stats["accelerated"] = stream.getAccelerateCount();
+    stats["expanded"] = stream.getExpandCount();
+
+    // count of frames played with [i * bucket_ms, (i + 1) * bucket_ms) of audio still buffered
+    QJsonArray latencyHistogram;
+    for (auto count : stream.getLatencyHistogram()) {
+        latencyHistogram.push_back((double)count);
+    }
+    stats["latency_bucket_ms"] = InboundAudioStream::LATENCY_HISTOGRAM_BUCKET_MSECS;
+    stats["latency_histogram"] = latencyHistogram;
+}
+
 QJsonObject AudioMixerClientData::getAudioStreamStats() {
     QJsonObject result;
 
@@ -694,6 +712,7 @@ QJsonObject AudioMixerClientData::getAudioStreamStats() {
         upstreamStats["min_gap_30s"] = formatUsecTime(streamStats._timeGapWindowMin);
         upstreamStats["max_gap_30s"] = formatUsecTime(streamStats._timeGapWindowMax);
         upstreamStats["avg_gap_30s"] = formatUsecTime(streamStats._timeGapWindowAverage);
+        addJitterBufferStats(upstreamStats, *avatarAudioStream);
 
         result["upstream"] = upstreamStats;
     } else {
@@ -724,6 +743,7 @@ QJsonObject AudioMixerClientData::getAudioStreamStats() {
             upstreamStats["min_gap_30s"] = formatUsecTime(streamStats._timeGapWindowMin);
             upstreamStats["max_gap_30s"] = formatUsecTime(streamStats._timeGapWindowMax);
             upstreamStats["avg_gap_30s"] = formatUsecTime(streamStats._timeGapWindowAverage);
+            addJitterBufferStats(upstreamStats, *injectorPair);
 
             injectorArray.push_back(upstreamStats);
         }
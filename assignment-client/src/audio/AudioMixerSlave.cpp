@@ -55,11 +55,21 @@ inline float computeGain(float masterAvatarGain, float masterInjectorGain, const
 inline float computeAzimuth(const AvatarAudioStream& listeningNodeStream, const PositionalAudioStream& streamToAdd,
         const glm::vec3& relativePosition);
 
+template <class F>
+void timeStage(uint64_t& stageTime, F&& stage) {
+    auto start = p_high_resolution_clock::now();
+    stage();
+    stageTime += std::chrono::duration_cast<std::chrono::nanoseconds>(p_high_resolution_clock::now() - start).count();
+}
+
 void AudioMixerSlave::processPackets(const SharedNodePointer& node) {
     AudioMixerClientData* data = (AudioMixerClientData*)node->getLinkedData();
     if (data) {
         // process packets and collect the number of streams available for this frame
-        stats.sumStreams += data->processPackets(_sharedData.addedStreams);
+        // this decodes each source stream exactly once, ahead of the mixes that read it
+        timeStage(stats.decodeTime, [&] {
+            stats.sumStreams += data->processPackets(_sharedData.addedStreams);
+        });
     }
 }
 
@@ -97,34 +107,45 @@ void AudioMixerSlave::mix(const SharedNodePointer& node) {
         ++stats.sumListeners;
 
         // mix the audio
-        bool mixHasAudio = prepareMix(node);
+        bool mixHasAudio = false;
+        timeStage(stats.mixTime, [&] {
+            mixHasAudio = prepareMix(node);
+        });
 
         // send audio packet
         if (mixHasAudio || data->shouldFlushEncoder()) {
             QByteArray encodedBuffer;
-            if (mixHasAudio) {
-                // encode the audio
-                QByteArray decodedBuffer(reinterpret_cast<char*>(_bufferSamples), AudioConstants::NETWORK_FRAME_BYTES_STEREO);
-                data->encode(decodedBuffer, encodedBuffer);
-            } else {
-                // time to flush (resets shouldFlush until the next encode)
-                data->encodeFrameOfZeros(encodedBuffer);
-            }
+            timeStage(stats.encodeTime, [&] {
+                if (mixHasAudio) {
+                    // encode the audio
+                    QByteArray decodedBuffer(reinterpret_cast<char*>(_bufferSamples), AudioConstants::NETWORK_FRAME_BYTES_STEREO);
+                    data->encode(decodedBuffer, encodedBuffer);
+                } else {
+                    // time to flush (resets shouldFlush until the next encode)
+                    data->encodeFrameOfZeros(encodedBuffer);
+                }
+            });
 
-            sendMixPacket(node, *data, encodedBuffer);
+            timeStage(stats.sendTime, [&] {
+                sendMixPacket(node, *data, encodedBuffer);
+            });
         } else {
             ++stats.sumListenersSilent;
-            sendSilentPacket(node, *data);
+            timeStage(stats.sendTime, [&] {
+                sendSilentPacket(node, *data);
+            });
         }
 
-        // send environment packet
-        sendEnvironmentPacket(node, *data);
+        timeStage(stats.sendTime, [&] {
+            // send environment packet
+            sendEnvironmentPacket(node, *data);
 
-        // send stats packet (about every second)
-        const unsigned int NUM_FRAMES_PER_SEC = (int)ceil(AudioConstants::NETWORK_FRAMES_PER_SEC);
-        if (data->shouldSendStats(_frame % NUM_FRAMES_PER_SEC)) {
-            data->sendAudioStreamStatsPackets(node);
-        }
+            // send stats packet (about every second)
+            const unsigned int NUM_FRAMES_PER_SEC = (int)ceil(AudioConstants::NETWORK_FRAMES_PER_SEC);
+            if (data->shouldSendStats(_frame % NUM_FRAMES_PER_SEC)) {
+                data->sendAudioStreamStatsPackets(node);
+            }
+        });
     }
 }
 
@@ -467,12 +488,6 @@ bool AudioMixerSlave::prepareMix(const SharedNodePointer& listener) {
     // clear the newly ignored, un-ignored, ignoring, and un-ignoring streams now that we've processed them
     listenerData->clearStagedIgnoreChanges();
 
-#ifdef HIFI_AUDIO_MIXER_DEBUG
-    auto mixEnd = p_high_resolution_clock::now();
-    auto mixTime = std::chrono::duration_cast<std::chrono::nanoseconds>(mixEnd - mixStart);
-    stats.mixTime += mixTime.count();
-#endif
-
     // check for silent audio before limiting
     // limiting uses a dither and can only guarantee abs(sample) <= 1
     bool hasAudio = false;
@@ -515,7 +530,7 @@ void AudioMixerSlave::addStream(AudioMixerClientData::MixableStream& mixableStre
     if (!streamToAdd->lastPopSucceeded()) {
         bool forceSilentBlock = true;
 
-        if (!streamToAdd->getLastPopOutput().isNull()) {
+        if (streamToAdd->hasLastPopSamples()) {
             bool isInjector = dynamic_cast<const InjectedAudioStream*>(streamToAdd);
 
             // in an injector, just go silent - the injector has likely ended
@@ -546,30 +561,25 @@ void AudioMixerSlave::addStream(AudioMixerClientData::MixableStream& mixableStre
         }
     }
 
-    // grab the stream from the ring buffer
-    AudioRingBuffer::ConstIterator streamPopOutput = streamToAdd->getLastPopOutput();
-
+    // the source frame was copied out of its ring buffer (and converted to float, for mono sources)
+    // once when packets were processed, so every listener reads the same contiguous samples
     if (streamToAdd->isStereo()) {
 
-        streamPopOutput.readSamples(_bufferSamples, AudioConstants::NETWORK_FRAME_SAMPLES_STEREO);
-
         // stereo sources are not passed through HRTF
-        mixableStream.hrtf->mixStereo(_bufferSamples, _mixSamples, gain, AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+        mixableStream.hrtf->mixStereo(streamToAdd->getLastPopSamples(), _mixSamples, gain,
+                                      AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
 
         ++stats.manualStereoMixes;
     } else if (isEcho) {
 
-        streamPopOutput.readSamples(_bufferSamples, AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
-
         // echo sources are not passed through HRTF
-        mixableStream.hrtf->mixMono(_bufferSamples, _mixSamples, gain, AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+        mixableStream.hrtf->mixMono(streamToAdd->getLastPopSamples(), _mixSamples, gain,
+                                    AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
 
         ++stats.manualEchoMixes;
     } else {
 
-        streamPopOutput.readSamples(_bufferSamples, AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
-
-        mixableStream.hrtf->render(_bufferSamples, _mixSamples, HRTF_DATASET_INDEX, azimuth, distance, gain,
+        mixableStream.hrtf->render(streamToAdd->getLastPopFloatSamples(), _mixSamples, HRTF_DATASET_INDEX, azimuth, distance, gain,
                                    AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
         ++stats.hrtfRenders;
     }
@@ -36,9 +36,10 @@ void AudioMixerStats::reset() {
     inactive = 0;
     active = 0;
 
-#ifdef HIFI_AUDIO_MIXER_DEBUG
+    decodeTime = 0;
     mixTime = 0;
-#endif
+    encodeTime = 0;
+    sendTime = 0;
 }
 
 void AudioMixerStats::accumulate(const AudioMixerStats& otherStats) {
@@ -66,7 +67,8 @@ void AudioMixerStats::accumulate(const AudioMixerStats& otherStats) {
     inactive += otherStats.inactive;
     active += otherStats.active;
 
-#ifdef HIFI_AUDIO_MIXER_DEBUG
+    decodeTime += otherStats.decodeTime;
     mixTime += otherStats.mixTime;
-#endif
+    encodeTime += otherStats.encodeTime;
+    sendTime += otherStats.sendTime;
 }
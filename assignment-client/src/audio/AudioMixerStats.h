@@ -12,9 +12,7 @@
 #ifndef hifi_AudioMixerStats_h
 #define hifi_AudioMixerStats_h
 
-#ifdef HIFI_AUDIO_MIXER_DEBUG
 #include <cstdint>
-#endif
 
 struct AudioMixerStats {
     int sumStreams { 0 };
@@ -41,9 +39,11 @@ struct AudioMixerStats {
     int inactive { 0 };
     int active { 0 };
 
-#ifdef HIFI_AUDIO_MIXER_DEBUG
+    // per stage timings in nanoseconds, summed across slave threads
+    uint64_t decodeTime { 0 };
     uint64_t mixTime { 0 };
-#endif
+    uint64_t encodeTime { 0 };
+    uint64_t sendTime { 0 };
 
     void reset();
     void accumulate(const AudioMixerStats& otherStats);
@@ -84,6 +84,13 @@ void EntityServer::aboutToFinish() {
 }
 
 void EntityServer::handleEntityPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
+    if (message->getType() == PacketType::EntityEdit) {
+        if (senderNode && senderNode->getType() == NodeType::EntityScriptServer) {
+            _scriptServerEditRate.increment();
+        } else {
+            _clientEditRate.increment();
+        }
+    }
     if (_octreeInboundPacketProcessor) {
         _octreeInboundPacketProcessor->queueReceivedPacket(message, senderNode);
     }
@@ -458,6 +465,29 @@ QString EntityServer::serverSubclassStats() {
     return statsString;
 }
 
+QJsonObject EntityServer::serverSubclassEditStats() {
+    quint64 now = usecTimestampNow();
+    int simulationOwnerChanges = 0;
+    if (_tree) {
+        simulationOwnerChanges = std::static_pointer_cast<EntityTree>(_tree)->getTotalSimulationOwnerChanges();
+    }
+    float elapsed = _lastEditStatsTime > 0 ? (float)(now - _lastEditStatsTime) / (float)USECS_PER_SECOND : 0.0f;
+
+    float clientEditRate = _clientEditRate.rate();
+    float scriptServerEditRate = _scriptServerEditRate.rate();
+
+    QJsonObject editStats;
+    editStats["1. editPackets/s"] = clientEditRate + scriptServerEditRate;
+    editStats["2. editPackets/s from clients"] = clientEditRate;
+    editStats["3. editPackets/s from entity-script-server"] = scriptServerEditRate;
+    editStats["4. simulationOwnerChanges/s"] = elapsed > 0.0f ?
+        (double)(simulationOwnerChanges - _lastSimulationOwnerChanges) / elapsed : 0.0;
+
+    _lastEditStatsTime = now;
+    _lastSimulationOwnerChanges = simulationOwnerChanges;
+    return editStats;
+}
+
 void EntityServer::domainSettingsRequestFailed() {
     auto nodeList = DependencyManager::get<NodeList>();
     qCDebug(entities) << "The EntityServer couldn't get the Domain Settings. Starting dynamic domain verification with default values...";
@@ -18,6 +18,7 @@
 
 #include <EntityItem.h>
 #include <EntityTree.h>
+#include <shared/RateCounter.h>
 #include <SimpleEntitySimulation.h>
 
 #include "EntityServerConsts.h"
@@ -53,6 +54,7 @@ public:
     virtual void entityCreated(const EntityItem& newEntity, const SharedNodePointer& senderNode) override;
     virtual void readAdditionalConfiguration(const QJsonObject& settingsSectionObject) override;
     virtual QString serverSubclassStats() override;
+    virtual QJsonObject serverSubclassEditStats() override;
 
     virtual void trackSend(const QUuid& dataID, quint64 dataLastEdited, const QUuid& sessionID) override;
     virtual void trackViewerGone(const QUuid& sessionID) override;
@@ -77,6 +79,12 @@ private:
     SimpleEntitySimulationPointer _entitySimulation;
     QTimer* _pruneDeletedEntitiesTimer = nullptr;
 
+    // edit packets by where they come from, so the effect of the entity-script-server hosting physics shows
+    RateCounter<> _clientEditRate;
+    RateCounter<> _scriptServerEditRate;
+    quint64 _lastEditStatsTime { 0 };
+    int _lastSimulationOwnerChanges { 0 };
+
     QReadWriteLock _viewerSendingStatsLock;
     QMap<QUuid, QMap<QUuid, ViewerSendingStats>> _viewerSendingStats;
 
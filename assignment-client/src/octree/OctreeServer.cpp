@@ -1477,6 +1477,11 @@ void OctreeServer::sendStatsPacket() {
     jsonArray["3. outbound"] = statsObject2;
     jsonArray["4. inbound"] = statsObject3;
 
+    QJsonObject editStats = serverSubclassEditStats();
+    if (!editStats.isEmpty()) {
+        jsonArray["5. edits"] = editStats;
+    }
+
     QJsonObject statsObject;
     statsObject[QString(getMyServerName()) + "Server"] = jsonArray;
     addPacketStatsAndSendStatsPacket(statsObject);
@@ -0,0 +1,142 @@
+//
+//  EntityPhysicsHost.cpp
+//  assignment-client/src/scripts
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityPhysicsHost.h"
+
+#include <GLMHelpers.h>
+#include <NodeList.h>
+#include <PhysicsHelpers.h>
+#include <SimulationFlags.h>
+
+#include "EntityScriptServerLogging.h"
+
+const int EntityPhysicsHost::DEFAULT_UPDATES_PER_SECOND = 10;
+const int EntityPhysicsHost::DEFAULT_MAX_PPS = 900;
+
+// step about as often as the substep, so that each step has one or two substeps to do
+static const int STEP_INTERVAL_MSECS = (int)(PHYSICS_ENGINE_FIXED_SUBSTEP * MSECS_PER_SECOND);
+
+EntityPhysicsHost::EntityPhysicsHost(EntityTreePointer tree, QObject* parent) :
+    QObject(parent),
+    _tree(tree),
+    _physicsEngine(new PhysicsEngine(Vectors::ZERO)),
+    _entitySimulation(new PhysicalEntitySimulation()),
+    _releaseInterval(USECS_PER_SECOND / DEFAULT_UPDATES_PER_SECOND)
+{
+    ObjectMotionState::setShapeManager(&_shapeManager);
+    _physicsEngine->init();
+
+    // there is no workload space here, so every entity counts as close enough to simulate
+    _entitySimulation->init(_tree, _physicsEngine, &_packetSender);
+    // nor are models loaded, so model entities with hull or mesh colliders stay with the clients
+    _entitySimulation->setModelShapesAvailable(false);
+
+    _packetSender.setPacketsPerSecond(DEFAULT_MAX_PPS);
+    _packetSender.setProcessCallIntervalHint(STEP_INTERVAL_MSECS * USECS_PER_MSEC);
+
+    _stepTimer.setTimerType(Qt::PreciseTimer);
+    _stepTimer.setInterval(STEP_INTERVAL_MSECS);
+    connect(&_stepTimer, &QTimer::timeout, this, &EntityPhysicsHost::step);
+
+    auto nodeList = DependencyManager::get<NodeList>();
+    connect(nodeList.data(), &NodeList::uuidChanged, this, &EntityPhysicsHost::updateSessionUUID);
+    updateSessionUUID(nodeList->getSessionUUID());
+}
+
+EntityPhysicsHost::~EntityPhysicsHost() {
+    stop();
+    // release the motion states, and with them their shapes, while the shape manager is still around
+    _tree->withWriteLock([&] {
+        _entitySimulation->clearEntities();
+    });
+}
+
+void EntityPhysicsHost::setUpdatesPerSecond(int updatesPerSecond) {
+    _releaseInterval = USECS_PER_SECOND / std::max(updatesPerSecond, 1);
+}
+
+void EntityPhysicsHost::setMaxPacketsPerSecond(int packetsPerSecond) {
+    _packetSender.setPacketsPerSecond(packetsPerSecond);
+}
+
+void EntityPhysicsHost::start() {
+    Physics::setVolunteerPriority(HOST_SIMULATION_PRIORITY);
+    _stepTimer.start();
+    qCDebug(entity_script_server) << "Hosting entity physics, updates every" << _releaseInterval / USECS_PER_MSEC << "msecs";
+}
+
+void EntityPhysicsHost::stop() {
+    _stepTimer.stop();
+    Physics::setVolunteerPriority(VOLUNTEER_SIMULATION_PRIORITY);
+}
+
+void EntityPhysicsHost::updateSessionUUID(const QUuid& sessionUUID) {
+    Physics::setSessionUUID(sessionUUID);
+}
+
+void EntityPhysicsHost::step() {
+    if (!_packetSender.serversExist()) {
+        return;
+    }
+
+    _entitySimulation->removeDeadEntities();
+    {
+        PhysicsEngine::Transaction transaction;
+        _entitySimulation->buildPhysicsTransaction(transaction);
+        _physicsEngine->processTransaction(transaction);
+        _entitySimulation->handleProcessedPhysicsTransaction(transaction);
+    }
+
+    _entitySimulation->applyDynamicChanges();
+    _physicsEngine->forEachDynamic([&](EntityDynamicPointer dynamic) {
+        dynamic->prepareForPhysicsSimulation();
+    });
+
+    _tree->withWriteLock([&] {
+        _physicsEngine->stepSimulation();
+    });
+
+    if (_physicsEngine->hasOutgoingChanges()) {
+        // the updates and bids are queued here, and packed together until the next release
+        _tree->withWriteLock([&] {
+            _entitySimulation->handleChangedMotionStates(_physicsEngine->getChangedMotionStates());
+            _entitySimulation->handleDeactivatedMotionStates(_physicsEngine->getDeactivatedMotionStates());
+        });
+        _entitySimulation->handleCollisionEvents(_physicsEngine->getCollisionEvents());
+    }
+
+    quint64 now = usecTimestampNow();
+    if (now >= _nextRelease) {
+        _packetSender.releaseQueuedMessages();
+        _nextRelease = now + _releaseInterval;
+        ++_numReleases;
+    }
+
+    // we run the sender unthreaded, so give it a chance to send what was released
+    _packetSender.process();
+}
+
+QJsonObject EntityPhysicsHost::getStats() {
+    quint64 now = usecTimestampNow();
+    quint64 packetsSent = _packetSender.getLifetimePacketsSent();
+    float elapsed = _lastStatsTime > 0 ? (float)(now - _lastStatsTime) / (float)USECS_PER_SECOND : 0.0f;
+
+    QJsonObject stats;
+    stats["physical_entities"] = (double)_physicsEngine->getNumCollisionObjects();
+    stats["owned_entities"] = (double)_entitySimulation->getNumOwnedEntities();
+    stats["edit_packets/s"] = elapsed > 0.0f ? (double)(packetsSent - _lastStatsPacketsSent) / elapsed : 0.0;
+    stats["releases/s"] = elapsed > 0.0f ? (double)_numReleases / elapsed : 0.0;
+    stats["queued_edit_packets"] = (double)_packetSender.packetsToSendCount();
+
+    _lastStatsTime = now;
+    _lastStatsPacketsSent = packetsSent;
+    _numReleases = 0;
+    return stats;
+}
@@ -0,0 +1,69 @@
+//
+//  EntityPhysicsHost.h
+//  assignment-client/src/scripts
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntityPhysicsHost_h
+#define hifi_EntityPhysicsHost_h
+
+#include <QtCore/QJsonObject>
+#include <QtCore/QObject>
+#include <QtCore/QTimer>
+
+#include <EntityEditPacketSender.h>
+#include <PhysicalEntitySimulation.h>
+#include <PhysicsEngine.h>
+#include <ShapeManager.h>
+
+// Runs the entity physics simulation headlessly, against the tree of an entity viewer, on behalf of the domain.
+//
+// It bids for simulation ownership at HOST priority rather than VOLUNTEER, so it ends up simulating the active
+// objects nobody is interacting with, while the clients still take them over (at POKE or GRAB) when they touch
+// or grab them. Since one participant then owns most of the moving objects, their ownership stops bouncing
+// between clients, and their updates are batched: queued edits are only released a few times per second.
+class EntityPhysicsHost : public QObject {
+    Q_OBJECT
+public:
+    static const int DEFAULT_UPDATES_PER_SECOND;
+    static const int DEFAULT_MAX_PPS;
+
+    EntityPhysicsHost(EntityTreePointer tree, QObject* parent = nullptr);
+    ~EntityPhysicsHost();
+
+    EntitySimulationPointer getSimulation() const { return _entitySimulation; }
+
+    // how often queued updates are released to the entity server, and the most packets per second to send them with
+    void setUpdatesPerSecond(int updatesPerSecond);
+    void setMaxPacketsPerSecond(int packetsPerSecond);
+
+    void start();
+    void stop();
+
+    QJsonObject getStats();
+
+private slots:
+    void step();
+    void updateSessionUUID(const QUuid& sessionUUID);
+
+private:
+    EntityTreePointer _tree;
+    ShapeManager _shapeManager;
+    PhysicsEnginePointer _physicsEngine;
+    PhysicalEntitySimulationPointer _entitySimulation;
+    EntityEditPacketSender _packetSender;
+    QTimer _stepTimer;
+
+    quint64 _releaseInterval;
+    quint64 _nextRelease { 0 };
+
+    quint64 _lastStatsTime { 0 };
+    quint64 _lastStatsPacketsSent { 0 };
+    quint32 _numReleases { 0 };
+};
+
+#endif // hifi_EntityPhysicsHost_h
@@ -151,6 +151,7 @@ void EntityScriptServer::handleSettings() {
 
     if (!settingsObject.contains(ENTITY_SCRIPT_SERVER_SETTINGS_KEY)) {
         qWarning() << "Received settings from the domain-server with no entity_script_server section.";
+        startEntityViewer();
         return;
     }
 
@@ -161,14 +162,25 @@ void EntityScriptServer::handleSettings() {
 
     if (!entityScriptServerSettings.contains(MAX_ENTITY_PPS_OPTION) || !entityScriptServerSettings.contains(ENTITY_PPS_PER_SCRIPT)) {
         qWarning() << "Received settings from the domain-server with no max_total_entity_pps or entity_pps_per_script properties.";
-        return;
+    } else {
+        _maxEntityPPS = std::max(0, entityScriptServerSettings[MAX_ENTITY_PPS_OPTION].toInt());
+        _entityPPSPerScript = std::max(0, entityScriptServerSettings[ENTITY_PPS_PER_SCRIPT].toInt());
+
+        qDebug() << QString("Received entity script server settings, Max Entity PPS: %1, Entity PPS Per Entity Script: %2")
+                    .arg(_maxEntityPPS).arg(_entityPPSPerScript);
     }
 
-    _maxEntityPPS = std::max(0, entityScriptServerSettings[MAX_ENTITY_PPS_OPTION].toInt());
-    _entityPPSPerScript = std::max(0, entityScriptServerSettings[ENTITY_PPS_PER_SCRIPT].toInt());
+    static const QString HOST_PHYSICS_OPTION = "host_physics";
+    static const QString PHYSICS_UPDATES_PER_SECOND_OPTION = "physics_updates_per_second";
+    static const QString PHYSICS_MAX_ENTITY_PPS_OPTION = "physics_max_entity_pps";
 
-    qDebug() << QString("Received entity script server settings, Max Entity PPS: %1, Entity PPS Per Entity Script: %2")
-                .arg(_maxEntityPPS).arg(_entityPPSPerScript);
+    _hostPhysics = entityScriptServerSettings[HOST_PHYSICS_OPTION].toBool(false);
+    _physicsUpdatesPerSecond = std::max(1, entityScriptServerSettings[PHYSICS_UPDATES_PER_SECOND_OPTION]
+                                               .toInt(EntityPhysicsHost::DEFAULT_UPDATES_PER_SECOND));
+    _physicsMaxEntityPPS = std::max(1, entityScriptServerSettings[PHYSICS_MAX_ENTITY_PPS_OPTION]
+                                           .toInt(EntityPhysicsHost::DEFAULT_MAX_PPS));
+
+    startEntityViewer();
 }
 
 void EntityScriptServer::updateEntityPPS() {
@@ -267,6 +279,7 @@ void EntityScriptServer::run() {
 
     DomainHandler& domainHandler = DependencyManager::get<NodeList>()->getDomainHandler();
     connect(&domainHandler, &DomainHandler::settingsReceived, this, &EntityScriptServer::handleSettings);
+    connect(&domainHandler, &DomainHandler::settingsReceiveFail, this, &EntityScriptServer::startEntityViewer);
 
     // make sure we hear about connected nodes so we can grab an ATP script if a request is pending
     connect(nodeList.data(), &LimitedNodeList::nodeActivated, this, &EntityScriptServer::nodeActivated);
@@ -284,39 +297,59 @@ void EntityScriptServer::run() {
     entityScriptingInterface->init();
 
     _entityViewer.init();
-    
-    // setup the JSON filter that asks for entities with a non-default serverScripts property
-    QJsonObject queryJSONParameters;
-    queryJSONParameters[EntityJSONQueryProperties::SERVER_SCRIPTS_PROPERTY] = EntityQueryFilterSymbol::NonDefault;
-
-    QJsonObject queryFlags;
-
-    queryFlags[EntityJSONQueryProperties::INCLUDE_ANCESTORS_PROPERTY] = true;
-    queryFlags[EntityJSONQueryProperties::INCLUDE_DESCENDANTS_PROPERTY] = true;
-
-    queryJSONParameters[EntityJSONQueryProperties::FLAGS_PROPERTY] = queryFlags;
-    
-    // setup the JSON parameters so that OctreeQuery does not use a frustum and uses our JSON filter
-    _entityViewer.getOctreeQuery().setJSONParameters(queryJSONParameters);
 
+    // the query and the simulation depend on whether we host the physics, so they wait for the domain settings
     entityScriptingInterface->setEntityTree(_entityViewer.getTree());
 
     auto treePtr = _entityViewer.getTree();
     DependencyManager::set<AssignmentParentFinder>(treePtr);
 
-    if (!_entitySimulation) {
-        SimpleEntitySimulationPointer simpleSimulation { new SimpleEntitySimulation() };
-        simpleSimulation->setEntityTree(treePtr);
-        treePtr->setSimulation(simpleSimulation);
-        _entitySimulation = simpleSimulation;
-    }
-
     auto tree = treePtr.get();
     connect(tree, &EntityTree::deletingEntity, this, &EntityScriptServer::deletingEntity, Qt::QueuedConnection);
     connect(tree, &EntityTree::addingEntity, this, &EntityScriptServer::addingEntity, Qt::QueuedConnection);
     connect(tree, &EntityTree::entityServerScriptChanging, this, &EntityScriptServer::entityServerScriptChanging, Qt::QueuedConnection);
 }
 
+void EntityScriptServer::startEntityViewer() {
+    if (_entityViewerStarted || _shuttingDown) {
+        return;
+    }
+    _entityViewerStarted = true;
+
+    auto treePtr = _entityViewer.getTree();
+    QJsonObject queryJSONParameters;
+
+    if (_hostPhysics) {
+        // a dynamic entity can collide with anything, so we ask for the whole domain, without a filter:
+        // the server scripts are found amongst it as the entities arrive
+        _physicsHost.reset(new EntityPhysicsHost(treePtr));
+        _physicsHost->setUpdatesPerSecond(_physicsUpdatesPerSecond);
+        _physicsHost->setMaxPacketsPerSecond(_physicsMaxEntityPPS);
+        treePtr->setSimulation(_physicsHost->getSimulation());
+        _physicsHost->start();
+    } else {
+        // setup the JSON filter that asks for entities with a non-default serverScripts property
+        queryJSONParameters[EntityJSONQueryProperties::SERVER_SCRIPTS_PROPERTY] = EntityQueryFilterSymbol::NonDefault;
+
+        QJsonObject queryFlags;
+
+        queryFlags[EntityJSONQueryProperties::INCLUDE_ANCESTORS_PROPERTY] = true;
+        queryFlags[EntityJSONQueryProperties::INCLUDE_DESCENDANTS_PROPERTY] = true;
+
+        queryJSONParameters[EntityJSONQueryProperties::FLAGS_PROPERTY] = queryFlags;
+
+        if (!_entitySimulation) {
+            SimpleEntitySimulationPointer simpleSimulation { new SimpleEntitySimulation() };
+            simpleSimulation->setEntityTree(treePtr);
+            treePtr->setSimulation(simpleSimulation);
+            _entitySimulation = simpleSimulation;
+        }
+    }
+
+    // setup the JSON parameters so that OctreeQuery does not use a frustum and uses our JSON filter
+    _entityViewer.getOctreeQuery().setJSONParameters(queryJSONParameters);
+}
+
 void EntityScriptServer::cleanupOldKilledListeners() {
     auto threshold = usecTimestampNow() - 5 * USECS_PER_SECOND;
     using ValueType = std::pair<QUuid, quint64>;
@@ -457,6 +490,9 @@ void EntityScriptServer::resetEntitiesScriptEngine() {
     connect(newEngine.data(), &ScriptEngine::infoMessage, scriptEngines, &ScriptEngines::onInfoMessage);
 
     connect(newEngine.data(), &ScriptEngine::update, this, [this] {
+        if (!_entityViewerStarted) {
+            return;
+        }
         _entityViewer.queryOctree();
         _entityViewer.getTree()->preUpdate();
         _entityViewer.getTree()->update();
@@ -600,6 +636,11 @@ void EntityScriptServer::sendStatsPacket() {
     });
 
     statsObject["nodes"] = nodesObject;
+
+    if (_physicsHost) {
+        statsObject["physics_host"] = _physicsHost->getStats();
+    }
+
     addPacketStatsAndSendStatsPacket(statsObject);
 }
 
@@ -635,6 +676,11 @@ void EntityScriptServer::handleOctreePacket(QSharedPointer<ReceivedMessage> mess
 void EntityScriptServer::aboutToFinish() {
     shutdownScriptEngine();
 
+    if (_physicsHost) {
+        _entityViewer.getTree()->setSimulation(nullptr);
+        _physicsHost.reset();
+    }
+
     DependencyManager::get<EntityScriptingInterface>()->setEntityTree(nullptr);
     DependencyManager::get<ResourceManager>()->cleanup();
 
@@ -12,6 +12,7 @@
 #ifndef hifi_EntityScriptServer_h
 #define hifi_EntityScriptServer_h
 
+#include <memory>
 #include <set>
 #include <vector>
 
@@ -24,6 +25,7 @@
 #include <SimpleEntitySimulation.h>
 #include <ThreadedAssignment.h>
 #include "../entities/EntityTreeHeadlessViewer.h"
+#include "EntityPhysicsHost.h"
 
 class EntityScriptServer : public ThreadedAssignment {
     Q_OBJECT
@@ -62,6 +64,7 @@ private:
     void selectAudioFormat(const QString& selectedCodecName);
 
     void resetEntitiesScriptEngine();
+    void startEntityViewer();
     void clear();
     void shutdownScriptEngine();
 
@@ -79,10 +82,16 @@ private:
     SimpleEntitySimulationPointer _entitySimulation;
     EntityEditPacketSender _entityEditSender;
     EntityTreeHeadlessViewer _entityViewer;
+    bool _entityViewerStarted { false };
 
     int _maxEntityPPS { DEFAULT_MAX_ENTITY_PPS };
     int _entityPPSPerScript { DEFAULT_ENTITY_PPS_PER_SCRIPT };
 
+    bool _hostPhysics { false };
+    int _physicsUpdatesPerSecond { EntityPhysicsHost::DEFAULT_UPDATES_PER_SECOND };
+    int _physicsMaxEntityPPS { EntityPhysicsHost::DEFAULT_MAX_PPS };
+    std::unique_ptr<EntityPhysicsHost> _physicsHost;
+
     std::set<QUuid> _logListeners;
     std::vector<std::pair<QUuid, quint64>> _killedListeners;
 
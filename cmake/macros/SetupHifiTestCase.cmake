@@ -95,6 +95,11 @@ macro(SETUP_HIFI_TESTCASE)
       
         add_executable(${TARGET_NAME} ${TEST_FILE} ${EXTRA_FILES})
         add_test(${TARGET_NAME}-test  ${TARGET_NAME})
+
+        # the benchmarks in the test classes are built, and run along with the tests, with BUILD_TEST_BENCHMARKS
+        if (BUILD_TEST_BENCHMARKS)
+          target_compile_definitions(${TARGET_NAME} PRIVATE MANUAL_TEST)
+        endif ()
         set_target_properties(${TARGET_NAME} PROPERTIES 
           EXCLUDE_FROM_DEFAULT_BUILD TRUE
           EXCLUDE_FROM_ALL TRUE)
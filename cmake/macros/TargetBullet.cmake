@@ -25,6 +25,10 @@ macro(TARGET_BULLET)
       target_include_directories(${TARGET_NAME} SYSTEM PRIVATE ${BULLET_INCLUDE_DIRS})
     endif()
     target_link_libraries(${TARGET_NAME} ${BULLET_LIBRARIES})
+    if (NOT ANDROID)
+        # the vcpkg port is built with BULLET2_MULTITHREADING, and the headers must agree
+        target_compile_definitions(${TARGET_NAME} PRIVATE BT_THREADSAFE=1)
+    endif()
 endmacro()
 
 
@@ -24,6 +24,7 @@
 #include <QSharedMemory>
 #include <QRegularExpression>
 #include <QStandardPaths>
+#include <QThread>
 #include <QTimer>
 #include <QUrlQuery>
 #include <QCommandLineParser>
@@ -55,7 +56,7 @@
 #include "EntitiesBackupHandler.h"
 #include "NodeConnectionData.h"
 
-#include <Gzip.h>
+#include <GzipDevice.h>
 
 #include <OctreeDataUtils.h>
 
@@ -3528,13 +3529,16 @@ bool DomainServer::handleOctreeFileReplacement(QByteArray octreeFile, QString so
     if (data.readOctreeDataInfoFromData(octreeFile)) {
         data.resetIdAndVersion();
 
-        QByteArray compressedOctree;
-        gzip(data.toByteArray(), compressedOctree);
-
-        // write the compressed octree data to a special file
+        // compress the octree data straight into a special file, in parallel
         auto replacementFilePath = getEntitiesReplacementFilePath();
         QFile replacementFile(replacementFilePath);
-        if (replacementFile.open(QIODevice::WriteOnly) && replacementFile.write(compressedOctree) != -1) {
+        bool written = false;
+        if (replacementFile.open(QIODevice::WriteOnly)) {
+            GzipDevice gzipDevice(&replacementFile, -1, QThread::idealThreadCount());
+            written = gzipDevice.open(QIODevice::WriteOnly) && gzipDevice.write(data.toByteArray()) != -1 &&
+                gzipDevice.finish();
+        }
+        if (written) {
             // we've now written our replacement file, time to take the server down so it can
             // process it when it comes back up
             qInfo() << "Wrote octree replacement file to" << replacementFilePath << "- stopping server";
@@ -226,7 +226,8 @@ Item {
                     StatText {
                         visible: root.expanded;
                         text: "Processing: " + root.processing +
-                              ", Pending: " + root.processingPending;
+                              ", Pending: " + root.processingPending +
+                              ", Wait: " + root.processingWaitTime + " ms";
                     }
                     StatText {
                         visible: root.expanded && root.downloadUrls.length > 0;
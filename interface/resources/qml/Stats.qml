@@ -296,7 +296,8 @@ Item {
                     StatText {
                         visible: root.expanded;
                         text: "Processing: " + root.processing +
-                              ", Pending: " + root.processingPending;
+                              ", Pending: " + root.processingPending +
+                              ", Wait: " + root.processingWaitTime + " ms";
                     }
                     StatText {
                         visible: root.expanded && root.downloadUrls.length > 0;
@@ -393,6 +394,10 @@ Item {
                         visible: root.expanded;
                         text: "  External Memory: " + root.gpuTextureExternalMemory + " MB";
                     }
+                    StatText {
+                        visible: root.expanded;
+                        text: "  KTX First Mip / Streamed: " + root.ktxTimeToFirstMip + " ms / " + root.ktxBytesPerTexture + " KB";
+                    }
                     StatText {
                         visible: root.expanded;
                         text: "GPU Buffers: "
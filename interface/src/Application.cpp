@@ -93,6 +93,7 @@
 #include <gpu/Context.h>
 #include <InfoView.h>
 #include <input-plugins/InputPlugin.h>
+#include <JobScheduler.h>
 #include <controllers/UserInputMapper.h>
 #include <controllers/InputRecorder.h>
 #include <controllers/ScriptingInterface.h>
@@ -1129,6 +1130,7 @@ Application::Application(int& argc, char** argv, QElapsedTimer& startupTimer, bo
     PluginManager::getInstance()->setContainer(pluginContainer);
 
     QThreadPool::globalInstance()->setMaxThreadCount(MIN_PROCESSING_THREAD_POOL_SIZE);
+    JobScheduler::getInstance().setMaxThreadCount(MIN_PROCESSING_THREAD_POOL_SIZE);
     thread()->setPriority(QThread::HighPriority);
     thread()->setObjectName("Main Thread");
 
@@ -2237,7 +2239,8 @@ Application::Application(int& argc, char** argv, QElapsedTimer& startupTimer, bo
         auto statTracker = DependencyManager::get<StatTracker>();
 
         properties["processing_resources"] = statTracker->getStat("Processing").toInt();
-        properties["pending_processing_resources"] = statTracker->getStat("PendingProcessing").toInt();
+        properties["pending_processing_resources"] = JobScheduler::getInstance().getNumQueuedJobs();
+        properties["processing_wait_usecs"] = (int)JobScheduler::getInstance().getAverageWaitTime();
 
         QJsonObject startedRequests;
         startedRequests["atp"] = statTracker->getStat(STAT_ATP_REQUEST_STARTED).toInt();
@@ -2796,7 +2799,9 @@ void Application::cleanupBeforeQuit() {
     getEntities()->shutdown(); // tell the entities system we're shutting down, so it will stop running scripts
 
     // Clear any queued processing (I/O, FBX/OBJ/Texture parsing)
+    JobScheduler::getInstance().clear();
     QThreadPool::globalInstance()->clear();
+    JobScheduler::getInstance().waitForDone();
     QThreadPool::globalInstance()->waitForDone();
 
     DependencyManager::destroy<RecordingScriptingInterface>();
@@ -5206,7 +5211,8 @@ void Application::idle() {
     PROFILE_COUNTER_IF_CHANGED(app, "currentDownloads", uint32_t, ResourceCache::getLoadingRequests().length());
     PROFILE_COUNTER_IF_CHANGED(app, "pendingDownloads", uint32_t, ResourceCache::getPendingRequestCount());
     PROFILE_COUNTER_IF_CHANGED(app, "currentProcessing", int, DependencyManager::get<StatTracker>()->getStat("Processing").toInt());
-    PROFILE_COUNTER_IF_CHANGED(app, "pendingProcessing", int, DependencyManager::get<StatTracker>()->getStat("PendingProcessing").toInt());
+    PROFILE_COUNTER_IF_CHANGED(app, "pendingProcessing", int, JobScheduler::getInstance().getNumQueuedJobs());
+    PROFILE_COUNTER_IF_CHANGED(app, "processingWaitTime", int, (int)JobScheduler::getInstance().getAverageWaitTime());
     auto renderConfig = _graphicsEngine.getRenderEngine()->getConfiguration();
     PROFILE_COUNTER_IF_CHANGED(render, "gpuTime", float, (float)_graphicsEngine.getGPUContext()->getFrameTimerGPUAverage());
 
@@ -5627,6 +5633,8 @@ void Application::init() {
         return atan2(maxSize, distance);
     });
 
+    // reduced hulls and mesh BVHs persist across sessions
+    _shapeManager.setHullCache(HullCache::create());
     ObjectMotionState::setShapeManager(&_shapeManager);
     _physicsEngine->init();
 
@@ -9388,6 +9396,7 @@ void Application::updateThreadPoolCount() const {
     qCDebug(interfaceapp) << "Reserved threads " << reservedThreads;
     qCDebug(interfaceapp) << "Setting thread pool size to " << threadPoolSize;
     QThreadPool::globalInstance()->setMaxThreadCount(threadPoolSize);
+    JobScheduler::getInstance().setMaxThreadCount(threadPoolSize);
 }
 
 void Application::updateSystemTabletMode() {
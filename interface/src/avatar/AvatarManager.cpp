@@ -11,6 +11,7 @@
 
 #include "AvatarManager.h"
 
+#include <cfloat>
 #include <string>
 
 #include <QScriptEngine>
@@ -23,6 +24,7 @@
 #endif
 
 #include <glm/gtx/string_cast.hpp>
+#include <tbb/task_arena.h>
 
 #if defined(__GNUC__) && !defined(__clang__)
 #pragma GCC diagnostic pop
@@ -35,6 +37,7 @@
 #include <RegisteredMetaTypes.h>
 #include <Rig.h>
 #include <SettingHandle.h>
+#include <TBBHelpers.h>
 #include <UsersScriptingInterface.h>
 #include <UUID.h>
 #include <shared/ConicalViewFrustum.h>
@@ -216,6 +219,10 @@ float AvatarManager::getAvatarSimulationRate(const QUuid& sessionID, const QStri
     return avatar ? avatar->getSimulationRate(rateName) : 0.0f;
 }
 
+// beyond these distances from the nearest view, other avatars decode their joint data at half and quarter rate
+const float HALF_RATE_ANIMATION_DISTANCE = 10.0f;
+const float QUARTER_RATE_ANIMATION_DISTANCE = 25.0f;
+
 void AvatarManager::updateOtherAvatars(float deltaTime) {
     {
         // lock the hash for read to check the size
@@ -286,6 +293,47 @@ void AvatarManager::updateOtherAvatars(float deltaTime) {
     // process in sorted order
     uint64_t startTime = usecTimestampNow();
 
+    {
+        // Decoding the joint data and building the rig poses is most of the work for each avatar,
+        // and only touches that avatar's rig, so do it for them in parallel, a batch at a time in sorted order,
+        // and stop once the time budget is spent, since the sorted pass below won't simulate the rest this frame.
+        // That pass then only has to upload the joints and queue the transactions.
+        PerformanceTimer perfTimer("jointPoses");
+        struct JointPosesJob {
+            OtherAvatar* avatar;
+            bool inView;
+        };
+        std::vector<JointPosesJob> jobs;
+        jobs.reserve(avatarMap.size());
+        for (int p = kHero; p < NumVariants; p++) {
+            for (const auto& sortData : avatarPriorityQueues[p].getSortedVector()) {
+                auto avatar = std::static_pointer_cast<OtherAvatar>(sortData.getAvatar());
+                float distance = FLT_MAX;
+                for (const auto& view : views) {
+                    distance = std::min(distance, glm::distance(view.getPosition(), avatar->getWorldPosition()));
+                }
+                if (p == kHero || distance < HALF_RATE_ANIMATION_DISTANCE) {
+                    avatar->setAnimationLOD(OtherAvatar::FullRate);
+                } else if (distance < QUARTER_RATE_ANIMATION_DISTANCE) {
+                    avatar->setAnimationLOD(OtherAvatar::HalfRate);
+                } else {
+                    avatar->setAnimationLOD(OtherAvatar::QuarterRate);
+                }
+                jobs.push_back({ avatar.get(), sortData.getPriority() > OUT_OF_VIEW_THRESHOLD });
+            }
+        }
+        const size_t batchSize = 2 * (size_t)std::max(tbb::this_task_arena::max_concurrency(), 1);
+        const uint64_t expiry = startTime + MAX_UPDATE_AVATARS_TIME_BUDGET;
+        for (size_t begin = 0; begin < jobs.size() && usecTimestampNow() < expiry; begin += batchSize) {
+            size_t end = std::min(begin + batchSize, jobs.size());
+            tbb::parallel_for(tbb::blocked_range<size_t>(begin, end), [&](const tbb::blocked_range<size_t>& range) {
+                for (size_t i = range.begin(); i < range.end(); i++) {
+                    jobs[i].avatar->updateJointPoses(jobs[i].inView);
+                }
+            });
+        }
+    }
+
     const uint64_t MAX_UPDATE_HEROS_TIME_BUDGET = uint64_t(0.8 * MAX_UPDATE_AVATARS_TIME_BUDGET);
 
     uint64_t updatePriorityExpiries[NumVariants] = { startTime + MAX_UPDATE_HEROS_TIME_BUDGET, startTime + MAX_UPDATE_AVATARS_TIME_BUDGET };
@@ -341,7 +389,8 @@ void AvatarManager::updateOtherAvatars(float deltaTime) {
                     avatar->setIsNewAvatar(false);
                 }
                 avatar->simulate(deltaTime, inView);
-                if (avatar->getSkeletonModel()->isLoaded() && avatar->getWorkloadRegion() == workload::Region::R1) {
+                if (avatar->getSkeletonModel()->isLoaded() && avatar->getWorkloadRegion() == workload::Region::R1 &&
+                    avatar->getAnimationLOD() == OtherAvatar::FullRate) {
                     _myAvatar->addAvatarHandsToFlow(avatar);
                 }
                 if (_drawOtherAvatarSkeletons) {
@@ -48,6 +48,9 @@ OtherAvatar::OtherAvatar(QThread* thread) : Avatar(thread) {
     connect(_skeletonModel.get(), &Model::setURLFinished, this, &Avatar::setModelURLFinished);
     connect(_skeletonModel.get(), &Model::rigReady, this, &Avatar::rigReady);
     connect(_skeletonModel.get(), &Model::rigReset, this, &Avatar::rigReset);
+
+    // spread the reduced rate joint updates of a crowd over different frames
+    _animationFrame = (uint32_t)randIntInRange(0, (1 << (NumAnimationLODs - 1)) - 1);
 }
 
 OtherAvatar::~OtherAvatar() {
@@ -243,6 +246,45 @@ void OtherAvatar::setCollisionWithOtherAvatarsFlags() {
     }
 }
 
+void OtherAvatar::updateJointPoses(bool inView) {
+    _jointPosesPrepared = true;
+    if (!inView) {
+        return;
+    }
+
+    Rig& rig = _skeletonModel->getRig();
+    bool hasNewJointData = _hasNewJointData || _transit.isActive();
+    uint32_t interval = 1 << _animationLOD;
+    _animationFrame++;
+
+    if (interval == 1) {
+        _interpolationToPoses.clear();
+        if (!hasNewJointData) {
+            return;
+        }
+        rig.copyJointsFromJointData(_jointData);
+        _jointDataDecoded = true;
+    } else {
+        if (hasNewJointData && (_animationFrame % interval) == 0) {
+            // interpolate from the current pose to the new one over the next interval frames
+            _interpolationFromPoses = rig.getRelativePoses();
+            if (rig.decodeJointData(_jointData, _interpolationToPoses)) {
+                _interpolationStep = 0;
+            }
+            _jointDataDecoded = true;
+        }
+        if (_interpolationToPoses.empty() || _interpolationStep >= interval) {
+            return;
+        }
+        _interpolationStep++;
+        rig.interpolateJointPoses(_interpolationFromPoses, _interpolationToPoses, (float)_interpolationStep / (float)interval);
+    }
+
+    glm::mat4 rootTransform = glm::scale(_skeletonModel->getScale()) * glm::translate(_skeletonModel->getOffset());
+    rig.computeExternalPoses(rootTransform);
+    _jointPosesChanged = true;
+}
+
 void OtherAvatar::simulate(float deltaTime, bool inView) {
     PROFILE_RANGE(simulation, "simulate");
 
@@ -259,18 +301,25 @@ void OtherAvatar::simulate(float deltaTime, bool inView) {
     PerformanceTimer perfTimer("simulate");
     {
         PROFILE_RANGE(simulation, "updateJoints");
+        if (!_jointPosesPrepared) {
+            updateJointPoses(inView);
+        }
+        _jointPosesPrepared = false;
+
         if (inView) {
             Head* head = getHead();
-            if (_hasNewJointData || _transit.isActive()) {
-                _skeletonModel->getRig().copyJointsFromJointData(_jointData);
-                glm::mat4 rootTransform = glm::scale(_skeletonModel->getScale()) * glm::translate(_skeletonModel->getOffset());
-                _skeletonModel->getRig().computeExternalPoses(rootTransform);
+            if (_jointDataDecoded) {
+                _jointDataDecoded = false;
                 _jointDataSimulationRate.increment();
+                _hasNewJointData = false;
+            }
+            if (_jointPosesChanged) {
+                _jointPosesChanged = false;
 
+                // upload the joints built by updateJointPoses()
                 _skeletonModel->simulate(deltaTime, true);
 
                 locationChanged(); // joints changed, so if there are any children, update them.
-                _hasNewJointData = false;
 
                 glm::vec3 headPosition = getWorldPosition();
                 if (!_skeletonModel->getHeadPosition(headPosition)) {
@@ -12,6 +12,7 @@
 #include <memory>
 #include <vector>
 
+#include <AnimPose.h>
 #include <avatars-renderer/Avatar.h>
 #include <workload/Space.h>
 
@@ -32,6 +33,14 @@ public:
         MultiSphereHigh // All joints
     };
 
+    // How often the joint data is decoded, the poses are interpolated in between
+    enum AnimationLOD {
+        FullRate = 0,   // every frame
+        HalfRate,       // every 2nd frame
+        QuarterRate,    // every 4th frame
+        NumAnimationLODs
+    };
+
     virtual void instantiableAvatar() override { };
     virtual void createOrb() override;
     virtual void indicateLoadingStatus(LoadingStatus loadingStatus) override;
@@ -63,6 +72,13 @@ public:
 
     void setCollisionWithOtherAvatarsFlags() override;
 
+    void setAnimationLOD(AnimationLOD lod) { _animationLOD = lod; }
+    AnimationLOD getAnimationLOD() const { return _animationLOD; }
+
+    // The part of simulate() that only touches this avatar's rig: decode the joint data and build the poses.
+    // Safe to run for several avatars at once, ahead of simulate() on the main thread.
+    void updateJointPoses(bool inView);
+
     void simulate(float deltaTime, bool inView) override;
     void debugJointData() const;
     friend AvatarManager;
@@ -91,6 +107,15 @@ protected:
     uint8_t _workloadRegion { workload::Region::INVALID };
     BodyLOD _bodyLOD { BodyLOD::Sphere };
     bool _needsDetailedRebuild { false };
+
+    AnimationLOD _animationLOD { FullRate };
+    uint32_t _animationFrame { 0 };
+    uint32_t _interpolationStep { 0 };
+    AnimPoseVec _interpolationFromPoses;
+    AnimPoseVec _interpolationToPoses;
+    bool _jointPosesPrepared { false }; // updateJointPoses() already ran this frame
+    bool _jointPosesChanged { false };
+    bool _jointDataDecoded { false };
 };
 
 using OtherAvatarPointer = std::shared_ptr<OtherAvatar>;
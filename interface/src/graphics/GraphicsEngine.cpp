@@ -73,7 +73,9 @@ void GraphicsEngine::initializeRender() {
 #ifndef Q_OS_ANDROID
     _renderEngine->addJob<SecondaryCameraRenderTask>("SecondaryCameraJob", cullFunctor);
 #endif
-    _renderEngine->addJob<RenderViewTask>("RenderMainView", cullFunctor, render::ItemKey::TAG_BITS_0, render::ItemKey::TAG_BITS_0);
+    // the main view is the one that culls and sorts the whole scene, so it's the one worth culling in parallel
+    const bool PARALLEL_CULL = true;
+    _renderEngine->addJob<RenderViewTask>("RenderMainView", cullFunctor, render::ItemKey::TAG_BITS_0, render::ItemKey::TAG_BITS_0, PARALLEL_CULL);
     _renderEngine->load();
     _renderEngine->registerScene(_renderScene);
 
@@ -14,6 +14,7 @@
 #include <shared/FileUtils.h>
 #include <shared/QtHelpers.h>
 #include <DependencyManager.h>
+#include <JobScheduler.h>
 #include <MainWindow.h>
 #include <OffscreenUi.h>
 #include <StatTracker.h>
@@ -47,7 +48,7 @@ void TestScriptingInterface::waitForDownloadIdle() {
 void TestScriptingInterface::waitForProcessingIdle() {
     auto statTracker = DependencyManager::get<StatTracker>();
     waitForCondition(0, [statTracker]()->bool {
-        return (0 == statTracker->getStat("Processing").toInt() && 0 == statTracker->getStat("PendingProcessing").toInt());
+        return (0 == statTracker->getStat("Processing").toInt() && 0 == JobScheduler::getInstance().getNumQueuedJobs());
     });
 }
 
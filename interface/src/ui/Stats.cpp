@@ -22,11 +22,13 @@
 #include <Application.h>
 #include <AudioClient.h>
 #include <GeometryCache.h>
+#include <JobScheduler.h>
 #include <LODManager.h>
 #include <OffscreenUi.h>
 #include <PerfStat.h>
 #include <plugins/DisplayPlugin.h>
 #include <PickManager.h>
+#include <TextureCache.h>
 
 #include <gl/Context.h>
 
@@ -292,7 +294,8 @@ void Stats::updateStats(bool force) {
         STAT_UPDATE(downloadLimit, (int)ResourceCache::getRequestLimit())
         STAT_UPDATE(downloadsPending, (int)ResourceCache::getPendingRequestCount());
         STAT_UPDATE(processing, DependencyManager::get<StatTracker>()->getStat("Processing").toInt());
-        STAT_UPDATE(processingPending, DependencyManager::get<StatTracker>()->getStat("PendingProcessing").toInt());
+        STAT_UPDATE(processingPending, JobScheduler::getInstance().getNumQueuedJobs());
+        STAT_UPDATE(processingWaitTime, (int)(JobScheduler::getInstance().getAverageWaitTime() / USECS_PER_MSEC));
 
         // See if the active download urls have changed
         bool shouldUpdateUrls = _downloads != _downloadUrls.size();
@@ -410,6 +413,9 @@ void Stats::updateStats(bool force) {
         STAT_UPDATE(gpuFreeMemory, (int)BYTES_TO_MB(gpu::Context::getFreeGPUMemSize()));
         STAT_UPDATE(rectifiedTextureCount, (int)RECTIFIED_TEXTURE_COUNT.load());
         STAT_UPDATE(decimatedTextureCount, (int)DECIMATED_TEXTURE_COUNT.load());
+        auto textureCache = DependencyManager::get<TextureCache>();
+        STAT_UPDATE(ktxTimeToFirstMip, (int)(textureCache->getAverageTimeToFirstMip() / USECS_PER_MSEC));
+        STAT_UPDATE(ktxBytesPerTexture, (int)(textureCache->getAverageStreamedBytesPerTexture() / BYTES_PER_KILOBYTE));
     }
 
     gpu::ContextStats gpuFrameStats;
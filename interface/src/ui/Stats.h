@@ -97,6 +97,7 @@ private: \
  * @property {string[]} downloadUrls - <em>Read-only.</em>
  * @property {number} processing - <em>Read-only.</em>
  * @property {number} processingPending - <em>Read-only.</em>
+ * @property {number} processingWaitTime - <em>Read-only.</em>
  * @property {number} triangles - <em>Read-only.</em>
  * @property {number} materialSwitches - <em>Read-only.</em>
  * @property {number} itemConsidered - <em>Read-only.</em>
@@ -122,6 +123,10 @@ private: \
  * @property {number} localLeaves - <em>Read-only.</em>
  * @property {number} rectifiedTextureCount - <em>Read-only.</em>
  * @property {number} decimatedTextureCount - <em>Read-only.</em>
+ * @property {number} ktxTimeToFirstMip - The average time, in ms, from the request of a streamed KTX texture until its
+ *     first mips were loaded. <em>Read-only.</em>
+ * @property {number} ktxBytesPerTexture - The average number of bytes, in KB, streamed for each KTX texture.
+ *     <em>Read-only.</em>
  * @property {number} gpuBuffers - <em>Read-only.</em>
  * @property {number} gpuBufferMemory - <em>Read-only.</em>
  * @property {number} gpuTextures - <em>Read-only.</em>
@@ -261,6 +266,7 @@ class Stats : public QQuickItem {
     Q_PROPERTY(QStringList downloadUrls READ downloadUrls NOTIFY downloadUrlsChanged)
     STATS_PROPERTY(int, processing, 0)
     STATS_PROPERTY(int, processingPending, 0)
+    STATS_PROPERTY(int, processingWaitTime, 0)
     STATS_PROPERTY(int, triangles, 0)
     STATS_PROPERTY(quint32 , drawcalls, 0)
     STATS_PROPERTY(int, materialSwitches, 0)
@@ -287,6 +293,8 @@ class Stats : public QQuickItem {
     STATS_PROPERTY(int, localLeaves, 0)
     STATS_PROPERTY(int, rectifiedTextureCount, 0)
     STATS_PROPERTY(int, decimatedTextureCount, 0)
+    STATS_PROPERTY(int, ktxTimeToFirstMip, 0)
+    STATS_PROPERTY(int, ktxBytesPerTexture, 0)
     STATS_PROPERTY(int, gpuBuffers, 0)
     STATS_PROPERTY(int, gpuBufferMemory, 0)
     STATS_PROPERTY(int, gpuTextures, 0)
@@ -770,6 +778,13 @@ signals:
      */
     void processingPendingChanged();
 
+    /**jsdoc
+     * Triggered when the value of the <code>processingWaitTime</code> property changes.
+     * @function Stats.processingWaitTimeChanged
+     * @returns {Signal}
+     */
+    void processingWaitTimeChanged();
+
     /**jsdoc
      * Triggered when the value of the <code>triangles</code> property changes.
      * @function Stats.trianglesChanged
@@ -1100,6 +1115,20 @@ signals:
      */
     void decimatedTextureCountChanged();
 
+    /**jsdoc
+     * Triggered when the value of the <code>ktxTimeToFirstMip</code> property changes.
+     * @function Stats.ktxTimeToFirstMipChanged
+     * @returns {Signal}
+     */
+    void ktxTimeToFirstMipChanged();
+
+    /**jsdoc
+     * Triggered when the value of the <code>ktxBytesPerTexture</code> property changes.
+     * @function Stats.ktxBytesPerTextureChanged
+     * @returns {Signal}
+     */
+    void ktxBytesPerTextureChanged();
+
 
     void refreshRateTargetChanged();
 
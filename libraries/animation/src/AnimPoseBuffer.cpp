@@ -0,0 +1,289 @@
+//
+//  AnimPoseBuffer.cpp
+//  libraries/animation/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AnimPoseBuffer.h"
+
+#include <cassert>
+#include <cmath>
+
+void AnimPoseBuffer::resize(int numPoses) {
+    // contents are not preserved when the stride changes
+    int stride = (numPoses + POSE_LANES - 1) & ~(POSE_LANES - 1);
+    if (stride != _stride) {
+        _data.resize(NUM_CHANNELS * stride);
+        _stride = stride;
+    }
+    _size = numPoses;
+
+    for (int i = numPoses; i < stride; i++) {
+        setPose(i, AnimPose::identity);
+    }
+}
+
+AnimPose AnimPoseBuffer::getPose(int i) const {
+    const float* d = _data.data() + i;
+    return AnimPose(glm::vec3(d[SCALE_X * _stride], d[SCALE_Y * _stride], d[SCALE_Z * _stride]),
+                    glm::quat(d[ROT_W * _stride], d[ROT_X * _stride], d[ROT_Y * _stride], d[ROT_Z * _stride]),
+                    glm::vec3(d[TRANS_X * _stride], d[TRANS_Y * _stride], d[TRANS_Z * _stride]));
+}
+
+void AnimPoseBuffer::setPose(int i, const AnimPose& pose) {
+    float* d = _data.data() + i;
+    d[SCALE_X * _stride] = pose.scale().x;
+    d[SCALE_Y * _stride] = pose.scale().y;
+    d[SCALE_Z * _stride] = pose.scale().z;
+    d[ROT_X * _stride] = pose.rot().x;
+    d[ROT_Y * _stride] = pose.rot().y;
+    d[ROT_Z * _stride] = pose.rot().z;
+    d[ROT_W * _stride] = pose.rot().w;
+    d[TRANS_X * _stride] = pose.trans().x;
+    d[TRANS_Y * _stride] = pose.trans().y;
+    d[TRANS_Z * _stride] = pose.trans().z;
+}
+
+void AnimPoseBuffer::load(const AnimPose* poses, int numPoses, const int* order) {
+    resize(numPoses);
+    for (int i = 0; i < numPoses; i++) {
+        setPose(i, poses[order ? order[i] : i]);
+    }
+}
+
+void AnimPoseBuffer::store(AnimPose* poses, const int* order) const {
+    for (int i = 0; i < _size; i++) {
+        poses[order ? order[i] : i] = getPose(i);
+    }
+}
+
+//
+// Portable reference code
+//
+
+static void composePoses_ref(const AnimPoseBuffer& relative, const int* parents, int begin, int end, AnimPoseBuffer& absolute) {
+    const float* csx = relative.channel(AnimPoseBuffer::SCALE_X);
+    const float* csy = relative.channel(AnimPoseBuffer::SCALE_Y);
+    const float* csz = relative.channel(AnimPoseBuffer::SCALE_Z);
+    const float* cqx = relative.channel(AnimPoseBuffer::ROT_X);
+    const float* cqy = relative.channel(AnimPoseBuffer::ROT_Y);
+    const float* cqz = relative.channel(AnimPoseBuffer::ROT_Z);
+    const float* cqw = relative.channel(AnimPoseBuffer::ROT_W);
+    const float* ctx = relative.channel(AnimPoseBuffer::TRANS_X);
+    const float* cty = relative.channel(AnimPoseBuffer::TRANS_Y);
+    const float* ctz = relative.channel(AnimPoseBuffer::TRANS_Z);
+
+    float* sx = absolute.channel(AnimPoseBuffer::SCALE_X);
+    float* sy = absolute.channel(AnimPoseBuffer::SCALE_Y);
+    float* sz = absolute.channel(AnimPoseBuffer::SCALE_Z);
+    float* qx = absolute.channel(AnimPoseBuffer::ROT_X);
+    float* qy = absolute.channel(AnimPoseBuffer::ROT_Y);
+    float* qz = absolute.channel(AnimPoseBuffer::ROT_Z);
+    float* qw = absolute.channel(AnimPoseBuffer::ROT_W);
+    float* tx = absolute.channel(AnimPoseBuffer::TRANS_X);
+    float* ty = absolute.channel(AnimPoseBuffer::TRANS_Y);
+    float* tz = absolute.channel(AnimPoseBuffer::TRANS_Z);
+
+    for (int i = begin; i < end; i++) {
+        int p = parents[i - begin];
+
+        // the parent scale is uniform, so it commutes with the child rotation
+        float s = sx[p];
+        float px = qx[p], py = qy[p], pz = qz[p], pw = qw[p];
+
+        sx[i] = s * csx[i];
+        sy[i] = s * csy[i];
+        sz[i] = s * csz[i];
+
+        float cx = cqx[i], cy = cqy[i], cz = cqz[i], cw = cqw[i];
+        qx[i] = pw * cx + px * cw + py * cz - pz * cy;
+        qy[i] = pw * cy - px * cz + py * cw + pz * cx;
+        qz[i] = pw * cz + px * cy - py * cx + pz * cw;
+        qw[i] = pw * cw - px * cx - py * cy - pz * cz;
+
+        // rotate the scaled child translation by the parent rotation: v + w * t + cross(q, t), t = 2 * cross(q, v)
+        float vx = s * ctx[i], vy = s * cty[i], vz = s * ctz[i];
+        float ux = 2.0f * (py * vz - pz * vy);
+        float uy = 2.0f * (pz * vx - px * vz);
+        float uz = 2.0f * (px * vy - py * vx);
+        tx[i] = tx[p] + vx + pw * ux + (py * uz - pz * uy);
+        ty[i] = ty[p] + vy + pw * uy + (pz * ux - px * uz);
+        tz[i] = tz[p] + vz + pw * uz + (px * uy - py * ux);
+    }
+}
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+
+#include <emmintrin.h>
+
+//
+// SSE2 code
+//
+
+static void blendPoses_SSE(const AnimPoseBuffer& a, const AnimPoseBuffer& b, const float* alphas, AnimPoseBuffer& result) {
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 signMask = _mm_set1_ps(-0.0f);
+    int end = result.stride();
+
+    for (int c : { AnimPoseBuffer::SCALE_X, AnimPoseBuffer::SCALE_Y, AnimPoseBuffer::SCALE_Z,
+                   AnimPoseBuffer::TRANS_X, AnimPoseBuffer::TRANS_Y, AnimPoseBuffer::TRANS_Z }) {
+        const float* pa = a.channel(c);
+        const float* pb = b.channel(c);
+        float* pr = result.channel(c);
+        for (int i = 0; i < end; i += 4) {
+            __m128 wb = _mm_loadu_ps(&alphas[i]);
+            __m128 wa = _mm_sub_ps(one, wb);
+            __m128 r = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(&pa[i]), wa), _mm_mul_ps(_mm_loadu_ps(&pb[i]), wb));
+            _mm_storeu_ps(&pr[i], r);
+        }
+    }
+
+    const float* ax = a.channel(AnimPoseBuffer::ROT_X);
+    const float* ay = a.channel(AnimPoseBuffer::ROT_Y);
+    const float* az = a.channel(AnimPoseBuffer::ROT_Z);
+    const float* aw = a.channel(AnimPoseBuffer::ROT_W);
+    const float* bx = b.channel(AnimPoseBuffer::ROT_X);
+    const float* by = b.channel(AnimPoseBuffer::ROT_Y);
+    const float* bz = b.channel(AnimPoseBuffer::ROT_Z);
+    const float* bw = b.channel(AnimPoseBuffer::ROT_W);
+    float* rx = result.channel(AnimPoseBuffer::ROT_X);
+    float* ry = result.channel(AnimPoseBuffer::ROT_Y);
+    float* rz = result.channel(AnimPoseBuffer::ROT_Z);
+    float* rw = result.channel(AnimPoseBuffer::ROT_W);
+
+    for (int i = 0; i < end; i += 4) {
+        __m128 qax = _mm_loadu_ps(&ax[i]);
+        __m128 qay = _mm_loadu_ps(&ay[i]);
+        __m128 qaz = _mm_loadu_ps(&az[i]);
+        __m128 qaw = _mm_loadu_ps(&aw[i]);
+        __m128 qbx = _mm_loadu_ps(&bx[i]);
+        __m128 qby = _mm_loadu_ps(&by[i]);
+        __m128 qbz = _mm_loadu_ps(&bz[i]);
+        __m128 qbw = _mm_loadu_ps(&bw[i]);
+        __m128 wb = _mm_loadu_ps(&alphas[i]);
+        __m128 wa = _mm_sub_ps(one, wb);
+
+        // take the shortest arc, by giving b the sign of dot(a, b)
+        __m128 dot = _mm_add_ps(_mm_add_ps(_mm_mul_ps(qax, qbx), _mm_mul_ps(qay, qby)),
+                                _mm_add_ps(_mm_mul_ps(qaz, qbz), _mm_mul_ps(qaw, qbw)));
+        __m128 weight = _mm_xor_ps(wb, _mm_and_ps(dot, signMask));
+
+        __m128 x = _mm_add_ps(_mm_mul_ps(qax, wa), _mm_mul_ps(qbx, weight));
+        __m128 y = _mm_add_ps(_mm_mul_ps(qay, wa), _mm_mul_ps(qby, weight));
+        __m128 z = _mm_add_ps(_mm_mul_ps(qaz, wa), _mm_mul_ps(qbz, weight));
+        __m128 w = _mm_add_ps(_mm_mul_ps(qaw, wa), _mm_mul_ps(qbw, weight));
+
+        __m128 lengthSquared = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)),
+                                          _mm_add_ps(_mm_mul_ps(z, z), _mm_mul_ps(w, w)));
+        __m128 norm = _mm_div_ps(one, _mm_sqrt_ps(lengthSquared));
+
+        _mm_storeu_ps(&rx[i], _mm_mul_ps(x, norm));
+        _mm_storeu_ps(&ry[i], _mm_mul_ps(y, norm));
+        _mm_storeu_ps(&rz[i], _mm_mul_ps(z, norm));
+        _mm_storeu_ps(&rw[i], _mm_mul_ps(w, norm));
+    }
+}
+
+//
+// Runtime CPU dispatch
+//
+
+#include "CPUDetect.h"
+
+void blendPoses_AVX2(const AnimPoseBuffer& a, const AnimPoseBuffer& b, const float* alphas, AnimPoseBuffer& result);
+int composePoses_AVX2(const AnimPoseBuffer& relative, const int* parents, int begin, int end, AnimPoseBuffer& absolute);
+
+static void blendPoses(const AnimPoseBuffer& a, const AnimPoseBuffer& b, const float* alphas, AnimPoseBuffer& result) {
+    static auto f = cpuSupportsAVX2() ? blendPoses_AVX2 : blendPoses_SSE;
+    (*f)(a, b, alphas, result);  // dispatch
+}
+
+static void composeLevel(const AnimPoseBuffer& relative, const int* parents, int begin, int end, AnimPoseBuffer& absolute) {
+    static bool avx2 = cpuSupportsAVX2();
+    int i = begin;
+    if (avx2) {
+        i = composePoses_AVX2(relative, parents, begin, end, absolute);
+    }
+    composePoses_ref(relative, parents + (i - begin), i, end, absolute);
+}
+
+#else   // portable reference code
+
+static void blendPoses(const AnimPoseBuffer& a, const AnimPoseBuffer& b, const float* alphas, AnimPoseBuffer& result) {
+    int end = result.stride();
+
+    for (int c : { AnimPoseBuffer::SCALE_X, AnimPoseBuffer::SCALE_Y, AnimPoseBuffer::SCALE_Z,
+                   AnimPoseBuffer::TRANS_X, AnimPoseBuffer::TRANS_Y, AnimPoseBuffer::TRANS_Z }) {
+        const float* pa = a.channel(c);
+        const float* pb = b.channel(c);
+        float* pr = result.channel(c);
+        for (int i = 0; i < end; i++) {
+            pr[i] = pa[i] * (1.0f - alphas[i]) + pb[i] * alphas[i];
+        }
+    }
+
+    const float* ax = a.channel(AnimPoseBuffer::ROT_X);
+    const float* ay = a.channel(AnimPoseBuffer::ROT_Y);
+    const float* az = a.channel(AnimPoseBuffer::ROT_Z);
+    const float* aw = a.channel(AnimPoseBuffer::ROT_W);
+    const float* bx = b.channel(AnimPoseBuffer::ROT_X);
+    const float* by = b.channel(AnimPoseBuffer::ROT_Y);
+    const float* bz = b.channel(AnimPoseBuffer::ROT_Z);
+    const float* bw = b.channel(AnimPoseBuffer::ROT_W);
+    float* rx = result.channel(AnimPoseBuffer::ROT_X);
+    float* ry = result.channel(AnimPoseBuffer::ROT_Y);
+    float* rz = result.channel(AnimPoseBuffer::ROT_Z);
+    float* rw = result.channel(AnimPoseBuffer::ROT_W);
+
+    for (int i = 0; i < end; i++) {
+        // take the shortest arc
+        float dot = ax[i] * bx[i] + ay[i] * by[i] + az[i] * bz[i] + aw[i] * bw[i];
+        float beta = 1.0f - alphas[i];
+        float weight = (dot < 0.0f) ? -alphas[i] : alphas[i];
+
+        float x = ax[i] * beta + bx[i] * weight;
+        float y = ay[i] * beta + by[i] * weight;
+        float z = az[i] * beta + bz[i] * weight;
+        float w = aw[i] * beta + bw[i] * weight;
+
+        float norm = 1.0f / sqrtf(x * x + y * y + z * z + w * w);
+        rx[i] = x * norm;
+        ry[i] = y * norm;
+        rz[i] = z * norm;
+        rw[i] = w * norm;
+    }
+}
+
+static auto& composeLevel = composePoses_ref;
+
+#endif
+
+// the kernels read a weight for every pose up to the stride, so the weights are padded out to it
+static void blendPaddedPoses(const AnimPoseBuffer& a, const AnimPoseBuffer& b, std::vector<float>& alphas,
+                             AnimPoseBuffer& result) {
+    assert(a.size() == b.size());
+    result.resize(a.size());
+    alphas.resize(result.stride(), 0.0f);
+    blendPoses(a, b, alphas.data(), result);
+}
+
+void blend(const AnimPoseBuffer& a, const AnimPoseBuffer& b, float alpha, AnimPoseBuffer& result) {
+    static thread_local std::vector<float> alphas;
+    alphas.assign(a.size(), alpha);
+    blendPaddedPoses(a, b, alphas, result);
+}
+
+void blend(const AnimPoseBuffer& a, const AnimPoseBuffer& b, const float* alphas, AnimPoseBuffer& result) {
+    static thread_local std::vector<float> paddedAlphas;
+    paddedAlphas.assign(alphas, alphas + a.size());
+    blendPaddedPoses(a, b, paddedAlphas, result);
+}
+
+void composePoses(const AnimPoseBuffer& relative, const int* parents, int begin, int end, AnimPoseBuffer& absolute) {
+    assert(end <= relative.size() && end <= absolute.size());
+    composeLevel(relative, parents, begin, end, absolute);
+}
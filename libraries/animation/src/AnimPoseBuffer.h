@@ -0,0 +1,74 @@
+//
+//  AnimPoseBuffer.h
+//  libraries/animation/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AnimPoseBuffer_h
+#define hifi_AnimPoseBuffer_h
+
+#include <vector>
+
+#include "AnimPose.h"
+
+// Structure-of-arrays storage for a set of joint poses.
+// Each channel is padded out to a multiple of POSE_LANES, with identity poses in the padding,
+// so that the SIMD kernels can always run over whole registers.
+class AnimPoseBuffer {
+public:
+    enum Channel {
+        SCALE_X = 0,
+        SCALE_Y,
+        SCALE_Z,
+        ROT_X,
+        ROT_Y,
+        ROT_Z,
+        ROT_W,
+        TRANS_X,
+        TRANS_Y,
+        TRANS_Z,
+        NUM_CHANNELS
+    };
+
+    static const int POSE_LANES = 8;
+
+    AnimPoseBuffer() {}
+    explicit AnimPoseBuffer(int numPoses) { resize(numPoses); }
+
+    void resize(int numPoses);
+    int size() const { return _size; }
+    int stride() const { return _stride; }
+
+    float* channel(int c) { return _data.data() + c * _stride; }
+    const float* channel(int c) const { return _data.data() + c * _stride; }
+
+    AnimPose getPose(int i) const;
+    void setPose(int i, const AnimPose& pose);
+
+    // convert to and from AnimPose arrays; when given, order[i] is the AnimPose index stored at i
+    void load(const AnimPose* poses, int numPoses, const int* order = nullptr);
+    void store(AnimPose* poses, const int* order = nullptr) const;
+
+private:
+    std::vector<float> _data;
+    int _size { 0 };
+    int _stride { 0 };
+};
+
+// same as ::blend() from AnimUtil.h: lerp the scale and translation, and nlerp the rotation along the shortest arc.
+// result may alias a or b.
+void blend(const AnimPoseBuffer& a, const AnimPoseBuffer& b, float alpha, AnimPoseBuffer& result);
+
+// the same, with a weight for each pose
+void blend(const AnimPoseBuffer& a, const AnimPoseBuffer& b, const float* alphas, AnimPoseBuffer& result);
+
+// absolute[i] = absolute[parents[i - begin]] * relative[i], for i in [begin, end).
+// every parent must come before begin, and must have uniform scale, which lets the product be formed
+// directly from the scale, rotation and translation instead of going through a matrix.
+void composePoses(const AnimPoseBuffer& relative, const int* parents, int begin, int end, AnimPoseBuffer& absolute);
+
+#endif // hifi_AnimPoseBuffer_h
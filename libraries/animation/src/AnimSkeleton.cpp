@@ -15,6 +15,15 @@
 #include <GLMHelpers.h>
 
 #include "AnimationLogging.h"
+#include "AnimPoseBuffer.h"
+
+// composing poses from their scale, rotation and translation is only exact when the parent scale is uniform
+static const float UNIFORM_SCALE_TOLERANCE = 1.0e-4f;
+
+static bool isUniformScale(const glm::vec3& scale) {
+    float tolerance = UNIFORM_SCALE_TOLERANCE * fabsf(scale.x);
+    return fabsf(scale.y - scale.x) <= tolerance && fabsf(scale.z - scale.x) <= tolerance;
+}
 
 AnimSkeleton::AnimSkeleton(const HFMModel& hfmModel) {
 
@@ -132,13 +141,55 @@ AnimPose AnimSkeleton::getAbsolutePose(int jointIndex, const AnimPoseVec& relati
 
 void AnimSkeleton::convertRelativePosesToAbsolute(AnimPoseVec& poses) const {
     // poses start off relative and leave in absolute frame
-    int lastIndex = std::min((int)poses.size(), _jointsSize);
-    for (int i = 0; i < lastIndex; ++i) {
-        int parentIndex = _parentIndices[i];
-        if (parentIndex != -1) {
-            poses[i] = poses[parentIndex] * poses[i];
+    buildAbsolutePoses(poses, poses);
+}
+
+void AnimSkeleton::buildAbsolutePoses(const AnimPoseVec& relativePoses, AnimPoseVec& absolutePosesOut, const AnimPose* rootPose) const {
+    int numPoses = (int)relativePoses.size();
+
+    bool uniformScale = (numPoses == _jointsSize) && (numPoses > 0) && (!rootPose || isUniformScale(rootPose->scale()));
+    for (int i = 0; uniformScale && i < numPoses; ++i) {
+        uniformScale = isUniformScale(relativePoses[i].scale());
+    }
+
+    if (!uniformScale) {
+        // one joint at a time, through a matrix
+        absolutePosesOut.resize(numPoses);
+        int lastIndex = std::min(numPoses, _jointsSize);
+        for (int i = 0; i < numPoses; ++i) {
+            int parentIndex = (i < lastIndex) ? _parentIndices[i] : -1;
+            if (parentIndex != -1) {
+                absolutePosesOut[i] = absolutePosesOut[parentIndex] * relativePoses[i];
+            } else if (rootPose && i < lastIndex) {
+                absolutePosesOut[i] = *rootPose * relativePoses[i];
+            } else {
+                absolutePosesOut[i] = relativePoses[i];
+            }
         }
+        return;
+    }
+
+    // scratch buffers, since a skeleton is shared by every rig that uses the model
+    static thread_local AnimPoseBuffer relativeBuffer;
+    static thread_local AnimPoseBuffer absoluteBuffer;
+
+    relativeBuffer.load(relativePoses.data(), numPoses, _levelOrder.data());
+    absoluteBuffer.resize(numPoses);
+
+    int numRoots = _levelOffsets[1];
+    for (int i = 0; i < numRoots; ++i) {
+        const AnimPose& relativePose = relativePoses[_levelOrder[i]];
+        absoluteBuffer.setPose(i, rootPose ? *rootPose * relativePose : relativePose);
     }
+
+    for (int level = 1; level < (int)_levelOffsets.size() - 1; ++level) {
+        int begin = _levelOffsets[level];
+        int end = _levelOffsets[level + 1];
+        composePoses(relativeBuffer, &_levelParents[begin], begin, end, absoluteBuffer);
+    }
+
+    absolutePosesOut.resize(numPoses);
+    absoluteBuffer.store(absolutePosesOut.data(), _levelOrder.data());
 }
 
 void AnimSkeleton::convertAbsolutePosesToRelative(AnimPoseVec& poses) const {
@@ -215,6 +266,8 @@ void AnimSkeleton::buildSkeletonFromJoints(const std::vector<HFMJoint>& joints,
     }
 
     _jointsSize = (int)joints.size();
+    buildLevelOrder();
+
     // build a cache of bind poses
 
     // build a chache of default poses
@@ -296,6 +349,38 @@ void AnimSkeleton::buildSkeletonFromJoints(const std::vector<HFMJoint>& joints,
     }
 }
 
+void AnimSkeleton::buildLevelOrder() {
+    std::vector<int> depths(_jointsSize);
+    int numLevels = 0;
+    for (int i = 0; i < _jointsSize; i++) {
+        depths[i] = getChainDepth(i) - 1;
+        numLevels = std::max(numLevels, depths[i] + 1);
+    }
+
+    // counting sort by depth, keeping joints in index order within a level
+    _levelOffsets.assign(numLevels + 1, 0);
+    for (int i = 0; i < _jointsSize; i++) {
+        _levelOffsets[depths[i] + 1]++;
+    }
+    for (int level = 0; level < numLevels; level++) {
+        _levelOffsets[level + 1] += _levelOffsets[level];
+    }
+
+    std::vector<int> positions(_jointsSize);
+    std::vector<int> next(_levelOffsets.begin(), _levelOffsets.end() - 1);
+    _levelOrder.resize(_jointsSize);
+    for (int i = 0; i < _jointsSize; i++) {
+        positions[i] = next[depths[i]]++;
+        _levelOrder[positions[i]] = i;
+    }
+
+    _levelParents.resize(_jointsSize);
+    for (int position = 0; position < _jointsSize; position++) {
+        int parentIndex = _parentIndices[_levelOrder[position]];
+        _levelParents[position] = (parentIndex != -1) ? positions[parentIndex] : -1;
+    }
+}
+
 void AnimSkeleton::dump(bool verbose) const {
     qCDebug(animation) << "[";
     for (int i = 0; i < getNumJoints(); i++) {
@@ -53,6 +53,10 @@ public:
     AnimPose getAbsolutePose(int jointIndex, const AnimPoseVec& relativePoses) const;
 
     void convertRelativePosesToAbsolute(AnimPoseVec& poses) const;
+
+    // same as convertRelativePosesToAbsolute, but with the roots multiplied by rootPose, when given.
+    // composes a whole level of the hierarchy at a time with the AnimPoseBuffer kernels, when the scales allow it.
+    void buildAbsolutePoses(const AnimPoseVec& relativePoses, AnimPoseVec& absolutePosesOut, const AnimPose* rootPose = nullptr) const;
     void convertAbsolutePosesToRelative(AnimPoseVec& poses) const;
 
     void convertRelativeRotationsToAbsolute(std::vector<glm::quat>& rotations) const;
@@ -72,10 +76,16 @@ public:
 
 protected:
     void buildSkeletonFromJoints(const std::vector<HFMJoint>& joints, const QMap<int, glm::quat> jointOffsets);
+    void buildLevelOrder();
 
     std::vector<HFMJoint> _joints;
     std::vector<int> _parentIndices;
     int _jointsSize { 0 };
+
+    // joints sorted by depth, so that each level of the hierarchy can be composed with its parents at once
+    std::vector<int> _levelOrder;       // joint index at each position
+    std::vector<int> _levelParents;     // position of the parent of each position, -1 for roots
+    std::vector<int> _levelOffsets;     // first position of each level, followed by the end
     AnimPoseVec _relativeDefaultPoses;
     AnimPoseVec _absoluteDefaultPoses;
     AnimPoseVec _relativePreRotationPoses;
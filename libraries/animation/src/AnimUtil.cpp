@@ -9,21 +9,48 @@
 //
 
 #include "AnimUtil.h"
+#include "AnimPoseBuffer.h"
 #include <GLMHelpers.h>
 #include <NumericalConstants.h>
 #include <DebugDraw.h>
 
-// TODO: use restrict keyword
-// TODO: excellent candidate for simd vectorization.
+// fewer poses than fill one SIMD register are blended directly, rather than through an AnimPoseBuffer
+static const size_t MIN_SIMD_BLEND_POSES = AnimPoseBuffer::POSE_LANES;
+
+static void blendPose(const AnimPose& aPose, const AnimPose& bPose, float alpha, AnimPose& result) {
+    result.scale() = lerp(aPose.scale(), bPose.scale(), alpha);
+    result.rot() = safeLerp(aPose.rot(), bPose.rot(), alpha);
+    result.trans() = lerp(aPose.trans(), bPose.trans(), alpha);
+}
+
 void blend(size_t numPoses, const AnimPose* a, const AnimPose* b, float alpha, AnimPose* result) {
-    for (size_t i = 0; i < numPoses; i++) {
-        const AnimPose& aPose = a[i];
-        const AnimPose& bPose = b[i];
+    if (numPoses < MIN_SIMD_BLEND_POSES) {
+        for (size_t i = 0; i < numPoses; i++) {
+            blendPose(a[i], b[i], alpha, result[i]);
+        }
+        return;
+    }
+    static thread_local AnimPoseBuffer aBuffer;
+    static thread_local AnimPoseBuffer bBuffer;
+    aBuffer.load(a, (int)numPoses);
+    bBuffer.load(b, (int)numPoses);
+    ::blend(aBuffer, bBuffer, alpha, aBuffer);
+    aBuffer.store(result);
+}
 
-        result[i].scale() = lerp(aPose.scale(), bPose.scale(), alpha);
-        result[i].rot() = safeLerp(aPose.rot(), bPose.rot(), alpha);
-        result[i].trans() = lerp(aPose.trans(), bPose.trans(), alpha);
+void blend(size_t numPoses, const AnimPose* a, const AnimPose* b, const float* alphas, AnimPose* result) {
+    if (numPoses < MIN_SIMD_BLEND_POSES) {
+        for (size_t i = 0; i < numPoses; i++) {
+            blendPose(a[i], b[i], alphas[i], result[i]);
+        }
+        return;
     }
+    static thread_local AnimPoseBuffer aBuffer;
+    static thread_local AnimPoseBuffer bBuffer;
+    aBuffer.load(a, (int)numPoses);
+    bBuffer.load(b, (int)numPoses);
+    ::blend(aBuffer, bBuffer, alphas, aBuffer);
+    aBuffer.store(result);
 }
 
 void blend3(size_t numPoses, const AnimPose* a, const AnimPose* b, const AnimPose* c, float* alphas, AnimPose* result) {
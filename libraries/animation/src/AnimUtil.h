@@ -16,6 +16,9 @@
 // this is where the magic happens
 void blend(size_t numPoses, const AnimPose* a, const AnimPose* b, float alpha, AnimPose* result);
 
+// the same, with a weight for each pose
+void blend(size_t numPoses, const AnimPose* a, const AnimPose* b, const float* alphas, AnimPose* result);
+
 // blend between three sets of poses
 void blend3(size_t numPoses, const AnimPose* a, const AnimPose* b, const AnimPose* c, float* alphas, AnimPose* result);
 
@@ -12,7 +12,6 @@
 #include "AnimationCache.h"
 
 #include <QRunnable>
-#include <QThreadPool>
 
 #include <shared/QtHelpers.h>
 #include <Trace.h>
@@ -47,11 +46,9 @@ QSharedPointer<Resource> AnimationCache::createResourceCopy(const QSharedPointer
 AnimationReader::AnimationReader(const QUrl& url, const QByteArray& data) :
     _url(url),
     _data(data) {
-    DependencyManager::get<StatTracker>()->incrementStat("PendingProcessing");
 }
 
 void AnimationReader::run() {
-    DependencyManager::get<StatTracker>()->decrementStat("PendingProcessing");
     CounterStat counter("Processing");
 
     PROFILE_RANGE_EX(resource_parse, __FUNCTION__, 0xFF00FF00, 0, { { "url", _url.toString() } });
@@ -132,7 +129,7 @@ void Animation::downloadFinished(const QByteArray& data) {
     AnimationReader* animationReader = new AnimationReader(_url, data);
     connect(animationReader, SIGNAL(onSuccess(HFMModel::Pointer)), SLOT(animationParseSuccess(HFMModel::Pointer)));
     connect(animationReader, SIGNAL(onError(int, QString)), SLOT(animationParseError(int, QString)));
-    QThreadPool::globalInstance()->start(animationReader);
+    Resource::scheduleJob(JobScheduler::GEOMETRY, _self, animationReader);
 }
 
 void Animation::animationParseSuccess(HFMModel::Pointer hfmModel) {
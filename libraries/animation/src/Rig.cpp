@@ -2460,17 +2460,9 @@ void Rig::buildAbsoluteRigPoses(const AnimPoseVec& relativePoses, AnimPoseVec& a
 
     ASSERT(_animSkeleton->getNumJoints() == (int)relativePoses.size());
 
-    absolutePosesOut.resize(relativePoses.size());
+    // transform all root absolute poses into rig space
     AnimPose geometryToRigTransform(_geometryToRigTransform);
-    for (int i = 0; i < (int)relativePoses.size(); i++) {
-        int parentIndex = _animSkeleton->getParentIndex(i);
-        if (parentIndex == -1) {
-            // transform all root absolute poses into rig space
-            absolutePosesOut[i] = geometryToRigTransform * relativePoses[i];
-        } else {
-            absolutePosesOut[i] = absolutePosesOut[parentIndex] * relativePoses[i];
-        }
-    }
+    _animSkeleton->buildAbsolutePoses(relativePoses, absolutePosesOut, &geometryToRigTransform);
 }
 
 int Rig::getOverrideJointCount() const {
@@ -2538,14 +2530,18 @@ void Rig::copyJointsFromJointData(const QVector<JointData>& jointDataVec) {
     DETAILED_PROFILE_RANGE(simulation_animation_detail, "copyJoints");
     DETAILED_PERFORMANCE_TIMER("copyJoints");
 
+    decodeJointData(jointDataVec, _internalPoseSet._relativePoses);
+}
+
+bool Rig::decodeJointData(const QVector<JointData>& jointDataVec, AnimPoseVec& relativePosesOut) const {
     if (!_animSkeleton) {
-        return;
+        return false;
     }
     int numJoints = jointDataVec.size();
     const AnimPoseVec& absoluteDefaultPoses = _animSkeleton->getAbsoluteDefaultPoses();
     if (numJoints != (int)absoluteDefaultPoses.size()) {
         // jointData is incompatible
-        return;
+        return false;
     }
 
     // make a vector of rotations in absolute-model-frame
@@ -2567,20 +2563,29 @@ void Rig::copyJointsFromJointData(const QVector<JointData>& jointDataVec) {
     _animSkeleton->convertAbsoluteRotationsToRelative(rotations);
 
     // store new relative poses
-    if (numJoints != (int)_internalPoseSet._relativePoses.size()) {
-        _internalPoseSet._relativePoses = _animSkeleton->getRelativeDefaultPoses();
+    if (numJoints != (int)relativePosesOut.size()) {
+        relativePosesOut = _animSkeleton->getRelativeDefaultPoses();
     }
     const AnimPoseVec& relativeDefaultPoses = _animSkeleton->getRelativeDefaultPoses();
     for (int i = 0; i < numJoints; i++) {
         const JointData& data = jointDataVec.at(i);
-        _internalPoseSet._relativePoses[i].rot() = rotations[i];
+        relativePosesOut[i].rot() = rotations[i];
         if (data.translationIsDefaultPose) {
-            _internalPoseSet._relativePoses[i].trans() = relativeDefaultPoses[i].trans();
+            relativePosesOut[i].trans() = relativeDefaultPoses[i].trans();
         } else {
             // JointData translations are in relative-frame
-            _internalPoseSet._relativePoses[i].trans() = data.translation;
+            relativePosesOut[i].trans() = data.translation;
         }
     }
+    return true;
+}
+
+void Rig::interpolateJointPoses(const AnimPoseVec& fromPoses, const AnimPoseVec& toPoses, float alpha) {
+    auto& relativePoses = _internalPoseSet._relativePoses;
+    if (fromPoses.size() != relativePoses.size() || toPoses.size() != relativePoses.size()) {
+        return;
+    }
+    ::blend(relativePoses.size(), fromPoses.data(), toPoses.data(), alpha, relativePoses.data());
 }
 
 void Rig::computeExternalPoses(const glm::mat4& modelOffsetMat) {
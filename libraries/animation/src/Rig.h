@@ -226,6 +226,14 @@ public:
     void copyJointsFromJointData(const QVector<JointData>& jointDataVec);
     void computeExternalPoses(const glm::mat4& modelOffsetMat);
 
+    // Same as copyJointsFromJointData, but into relativePosesOut rather than the rig's own poses.
+    // Returns false if the joint data does not match the skeleton.
+    bool decodeJointData(const QVector<JointData>& jointDataVec, AnimPoseVec& relativePosesOut) const;
+
+    // Set the relative poses to a blend of two decoded poses, used to interpolate remote avatars between joint updates
+    void interpolateJointPoses(const AnimPoseVec& fromPoses, const AnimPoseVec& toPoses, float alpha);
+    const AnimPoseVec& getRelativePoses() const { return _internalPoseSet._relativePoses; }
+
     void computeAvatarBoundingCapsule(const HFMModel& hfmModel, float& radiusOut, float& heightOut, glm::vec3& offsetOut) const;
 
     void setEnableInverseKinematics(bool enable);
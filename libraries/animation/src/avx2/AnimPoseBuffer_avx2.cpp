@@ -0,0 +1,173 @@
+//
+//  AnimPoseBuffer_avx2.cpp
+//  libraries/animation/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifdef __AVX2__
+
+#include <immintrin.h>
+
+#include "../AnimPoseBuffer.h"
+
+//
+// Blend 8 poses at a time (see blendPoses_SSE)
+//
+void blendPoses_AVX2(const AnimPoseBuffer& a, const AnimPoseBuffer& b, const float* alphas, AnimPoseBuffer& result) {
+    const __m256 one = _mm256_set1_ps(1.0f);
+    const __m256 signMask = _mm256_set1_ps(-0.0f);
+    int end = result.stride();
+
+    for (int c : { AnimPoseBuffer::SCALE_X, AnimPoseBuffer::SCALE_Y, AnimPoseBuffer::SCALE_Z,
+                   AnimPoseBuffer::TRANS_X, AnimPoseBuffer::TRANS_Y, AnimPoseBuffer::TRANS_Z }) {
+        const float* pa = a.channel(c);
+        const float* pb = b.channel(c);
+        float* pr = result.channel(c);
+        for (int i = 0; i < end; i += 8) {
+            __m256 wb = _mm256_loadu_ps(&alphas[i]);
+            __m256 wa = _mm256_sub_ps(one, wb);
+            __m256 r = _mm256_fmadd_ps(_mm256_loadu_ps(&pb[i]), wb, _mm256_mul_ps(_mm256_loadu_ps(&pa[i]), wa));
+            _mm256_storeu_ps(&pr[i], r);
+        }
+    }
+
+    const float* ax = a.channel(AnimPoseBuffer::ROT_X);
+    const float* ay = a.channel(AnimPoseBuffer::ROT_Y);
+    const float* az = a.channel(AnimPoseBuffer::ROT_Z);
+    const float* aw = a.channel(AnimPoseBuffer::ROT_W);
+    const float* bx = b.channel(AnimPoseBuffer::ROT_X);
+    const float* by = b.channel(AnimPoseBuffer::ROT_Y);
+    const float* bz = b.channel(AnimPoseBuffer::ROT_Z);
+    const float* bw = b.channel(AnimPoseBuffer::ROT_W);
+    float* rx = result.channel(AnimPoseBuffer::ROT_X);
+    float* ry = result.channel(AnimPoseBuffer::ROT_Y);
+    float* rz = result.channel(AnimPoseBuffer::ROT_Z);
+    float* rw = result.channel(AnimPoseBuffer::ROT_W);
+
+    for (int i = 0; i < end; i += 8) {
+        __m256 qax = _mm256_loadu_ps(&ax[i]);
+        __m256 qay = _mm256_loadu_ps(&ay[i]);
+        __m256 qaz = _mm256_loadu_ps(&az[i]);
+        __m256 qaw = _mm256_loadu_ps(&aw[i]);
+        __m256 qbx = _mm256_loadu_ps(&bx[i]);
+        __m256 qby = _mm256_loadu_ps(&by[i]);
+        __m256 qbz = _mm256_loadu_ps(&bz[i]);
+        __m256 qbw = _mm256_loadu_ps(&bw[i]);
+        __m256 wb = _mm256_loadu_ps(&alphas[i]);
+        __m256 wa = _mm256_sub_ps(one, wb);
+
+        // take the shortest arc, by giving b the sign of dot(a, b)
+        __m256 dot = _mm256_mul_ps(qax, qbx);
+        dot = _mm256_fmadd_ps(qay, qby, dot);
+        dot = _mm256_fmadd_ps(qaz, qbz, dot);
+        dot = _mm256_fmadd_ps(qaw, qbw, dot);
+        __m256 weight = _mm256_xor_ps(wb, _mm256_and_ps(dot, signMask));
+
+        __m256 x = _mm256_fmadd_ps(qbx, weight, _mm256_mul_ps(qax, wa));
+        __m256 y = _mm256_fmadd_ps(qby, weight, _mm256_mul_ps(qay, wa));
+        __m256 z = _mm256_fmadd_ps(qbz, weight, _mm256_mul_ps(qaz, wa));
+        __m256 w = _mm256_fmadd_ps(qbw, weight, _mm256_mul_ps(qaw, wa));
+
+        __m256 lengthSquared = _mm256_mul_ps(x, x);
+        lengthSquared = _mm256_fmadd_ps(y, y, lengthSquared);
+        lengthSquared = _mm256_fmadd_ps(z, z, lengthSquared);
+        lengthSquared = _mm256_fmadd_ps(w, w, lengthSquared);
+        __m256 norm = _mm256_div_ps(one, _mm256_sqrt_ps(lengthSquared));
+
+        _mm256_storeu_ps(&rx[i], _mm256_mul_ps(x, norm));
+        _mm256_storeu_ps(&ry[i], _mm256_mul_ps(y, norm));
+        _mm256_storeu_ps(&rz[i], _mm256_mul_ps(z, norm));
+        _mm256_storeu_ps(&rw[i], _mm256_mul_ps(w, norm));
+    }
+
+    _mm256_zeroupper();
+}
+
+//
+// Compose 8 poses at a time with their parents (see composePoses_ref).
+// Returns the index of the first pose not processed, leaving the remainder to the caller.
+//
+int composePoses_AVX2(const AnimPoseBuffer& relative, const int* parents, int begin, int end, AnimPoseBuffer& absolute) {
+    const float* csx = relative.channel(AnimPoseBuffer::SCALE_X);
+    const float* csy = relative.channel(AnimPoseBuffer::SCALE_Y);
+    const float* csz = relative.channel(AnimPoseBuffer::SCALE_Z);
+    const float* cqx = relative.channel(AnimPoseBuffer::ROT_X);
+    const float* cqy = relative.channel(AnimPoseBuffer::ROT_Y);
+    const float* cqz = relative.channel(AnimPoseBuffer::ROT_Z);
+    const float* cqw = relative.channel(AnimPoseBuffer::ROT_W);
+    const float* ctx = relative.channel(AnimPoseBuffer::TRANS_X);
+    const float* cty = relative.channel(AnimPoseBuffer::TRANS_Y);
+    const float* ctz = relative.channel(AnimPoseBuffer::TRANS_Z);
+
+    float* sx = absolute.channel(AnimPoseBuffer::SCALE_X);
+    float* sy = absolute.channel(AnimPoseBuffer::SCALE_Y);
+    float* sz = absolute.channel(AnimPoseBuffer::SCALE_Z);
+    float* qx = absolute.channel(AnimPoseBuffer::ROT_X);
+    float* qy = absolute.channel(AnimPoseBuffer::ROT_Y);
+    float* qz = absolute.channel(AnimPoseBuffer::ROT_Z);
+    float* qw = absolute.channel(AnimPoseBuffer::ROT_W);
+    float* tx = absolute.channel(AnimPoseBuffer::TRANS_X);
+    float* ty = absolute.channel(AnimPoseBuffer::TRANS_Y);
+    float* tz = absolute.channel(AnimPoseBuffer::TRANS_Z);
+
+    const __m256 two = _mm256_set1_ps(2.0f);
+
+    int i = begin;
+    for (; i < end - 7; i += 8) {
+        __m256i p = _mm256_loadu_si256((const __m256i*)&parents[i - begin]);
+
+        // gather the parents, which were completed by an earlier level
+        __m256 s = _mm256_i32gather_ps(sx, p, 4);
+        __m256 px = _mm256_i32gather_ps(qx, p, 4);
+        __m256 py = _mm256_i32gather_ps(qy, p, 4);
+        __m256 pz = _mm256_i32gather_ps(qz, p, 4);
+        __m256 pw = _mm256_i32gather_ps(qw, p, 4);
+        __m256 ptx = _mm256_i32gather_ps(tx, p, 4);
+        __m256 pty = _mm256_i32gather_ps(ty, p, 4);
+        __m256 ptz = _mm256_i32gather_ps(tz, p, 4);
+
+        _mm256_storeu_ps(&sx[i], _mm256_mul_ps(s, _mm256_loadu_ps(&csx[i])));
+        _mm256_storeu_ps(&sy[i], _mm256_mul_ps(s, _mm256_loadu_ps(&csy[i])));
+        _mm256_storeu_ps(&sz[i], _mm256_mul_ps(s, _mm256_loadu_ps(&csz[i])));
+
+        __m256 cx = _mm256_loadu_ps(&cqx[i]);
+        __m256 cy = _mm256_loadu_ps(&cqy[i]);
+        __m256 cz = _mm256_loadu_ps(&cqz[i]);
+        __m256 cw = _mm256_loadu_ps(&cqw[i]);
+
+        __m256 rx = _mm256_fnmadd_ps(pz, cy, _mm256_fmadd_ps(py, cz, _mm256_fmadd_ps(px, cw, _mm256_mul_ps(pw, cx))));
+        __m256 ry = _mm256_fmadd_ps(pz, cx, _mm256_fmadd_ps(py, cw, _mm256_fnmadd_ps(px, cz, _mm256_mul_ps(pw, cy))));
+        __m256 rz = _mm256_fmadd_ps(pz, cw, _mm256_fnmadd_ps(py, cx, _mm256_fmadd_ps(px, cy, _mm256_mul_ps(pw, cz))));
+        __m256 rw = _mm256_fnmadd_ps(pz, cz, _mm256_fnmadd_ps(py, cy, _mm256_fnmadd_ps(px, cx, _mm256_mul_ps(pw, cw))));
+
+        _mm256_storeu_ps(&qx[i], rx);
+        _mm256_storeu_ps(&qy[i], ry);
+        _mm256_storeu_ps(&qz[i], rz);
+        _mm256_storeu_ps(&qw[i], rw);
+
+        __m256 vx = _mm256_mul_ps(s, _mm256_loadu_ps(&ctx[i]));
+        __m256 vy = _mm256_mul_ps(s, _mm256_loadu_ps(&cty[i]));
+        __m256 vz = _mm256_mul_ps(s, _mm256_loadu_ps(&ctz[i]));
+
+        __m256 ux = _mm256_mul_ps(two, _mm256_fmsub_ps(py, vz, _mm256_mul_ps(pz, vy)));
+        __m256 uy = _mm256_mul_ps(two, _mm256_fmsub_ps(pz, vx, _mm256_mul_ps(px, vz)));
+        __m256 uz = _mm256_mul_ps(two, _mm256_fmsub_ps(px, vy, _mm256_mul_ps(py, vx)));
+
+        __m256 wx = _mm256_fmadd_ps(pw, ux, _mm256_add_ps(ptx, vx));
+        __m256 wy = _mm256_fmadd_ps(pw, uy, _mm256_add_ps(pty, vy));
+        __m256 wz = _mm256_fmadd_ps(pw, uz, _mm256_add_ps(ptz, vz));
+
+        _mm256_storeu_ps(&tx[i], _mm256_add_ps(wx, _mm256_fmsub_ps(py, uz, _mm256_mul_ps(pz, uy))));
+        _mm256_storeu_ps(&ty[i], _mm256_add_ps(wy, _mm256_fmsub_ps(pz, ux, _mm256_mul_ps(px, uz))));
+        _mm256_storeu_ps(&tz[i], _mm256_add_ps(wz, _mm256_fmsub_ps(px, uy, _mm256_mul_ps(py, ux))));
+    }
+
+    _mm256_zeroupper();
+    return i;
+}
+
+#endif
@@ -33,13 +33,12 @@
 #include <VersionHelpers.h>
 #endif
 
-#include <QtConcurrent/QtConcurrent>
-#include <QtCore/QThreadPool>
 #include <QtCore/QBuffer>
 #include <QtMultimedia/QAudioInput>
 #include <QtMultimedia/QAudioOutput>
 
 #include <ThreadHelpers.h>
+#include <JobScheduler.h>
 #include <NodeList.h>
 #include <plugins/CodecPlugin.h>
 #include <plugins/PluginManager.h>
@@ -268,9 +267,9 @@ AudioClient::AudioClient() {
     // deprecate legacy settings
     {
         Setting::Handle<int>::Deprecated("maxFramesOverDesired", InboundAudioStream::MAX_FRAMES_OVER_DESIRED);
-        Setting::Handle<int>::Deprecated("windowStarveThreshold", InboundAudioStream::WINDOW_STARVE_THRESHOLD);
-        Setting::Handle<int>::Deprecated("windowSecondsForDesiredCalcOnTooManyStarves", InboundAudioStream::WINDOW_SECONDS_FOR_DESIRED_CALC_ON_TOO_MANY_STARVES);
-        Setting::Handle<int>::Deprecated("windowSecondsForDesiredReduction", InboundAudioStream::WINDOW_SECONDS_FOR_DESIRED_REDUCTION);
+        Setting::Handle<int>::Deprecated("windowStarveThreshold");
+        Setting::Handle<int>::Deprecated("windowSecondsForDesiredCalcOnTooManyStarves");
+        Setting::Handle<int>::Deprecated("windowSecondsForDesiredReduction");
         Setting::Handle<bool>::Deprecated("useStDevForJitterCalc", InboundAudioStream::USE_STDEV_FOR_JITTER);
         Setting::Handle<bool>::Deprecated("repetitionWithFade", InboundAudioStream::REPETITION_WITH_FADE);
     }
@@ -292,7 +291,7 @@ AudioClient::AudioClient() {
     _checkDevicesTimer = new QTimer(this);
     const unsigned long DEVICE_CHECK_INTERVAL_MSECS = 2 * 1000;
     connect(_checkDevicesTimer, &QTimer::timeout, this, [=] {
-        QtConcurrent::run(QThreadPool::globalInstance(), [=] {
+        JobScheduler::getInstance().submit(JobScheduler::AUDIO, [=] {
             checkDevices();
             // On some systems (Ubuntu) checking all the audio devices can take more than 2 seconds.  To
             // avoid consuming all of the thread pool, don't start the check interval until the previous
@@ -306,7 +305,7 @@ AudioClient::AudioClient() {
     // start a thread to detect peak value changes
     _checkPeakValuesTimer = new QTimer(this);
     connect(_checkPeakValuesTimer, &QTimer::timeout, this, [this] {
-        QtConcurrent::run(QThreadPool::globalInstance(), [this] { checkPeakValues(); });
+        JobScheduler::getInstance().submit(JobScheduler::AUDIO, [this] { checkPeakValues(); });
     });
     const unsigned long PEAK_VALUES_CHECK_INTERVAL_MSECS = 50;
     _checkPeakValuesTimer->start(PEAK_VALUES_CHECK_INTERVAL_MSECS);
@@ -2295,7 +2294,7 @@ qint64 AudioClient::AudioOutputIODevice::readData(char * data, qint64 maxSize) {
     }
 
     // prepare injectors for the next callback
-    QtConcurrent::run(QThreadPool::globalInstance(), [this] {
+    JobScheduler::getInstance().submit(JobScheduler::AUDIO, [this] {
         _audio->prepareLocalAudioInjectors();
     });
 
@@ -751,7 +751,7 @@ static void interpolate(const float* src0, const float* src1, float* dst, float
 #endif
 
 // apply gain crossfade with accumulation (interleaved)
-static void gainfade_1x2(int16_t* src, float* dst, const float* win, float gain0, float gain1, int numFrames) {
+static void gainfade_1x2(const int16_t* src, float* dst, const float* win, float gain0, float gain1, int numFrames) {
 
     gain0 *= (1/32768.0f);  // int16_t to float
     gain1 *= (1/32768.0f);
@@ -769,7 +769,7 @@ static void gainfade_1x2(int16_t* src, float* dst, const float* win, float gain0
 }
 
 // apply gain crossfade with accumulation (interleaved)
-static void gainfade_2x2(int16_t* src, float* dst, const float* win, float gain0, float gain1, int numFrames) {
+static void gainfade_2x2(const int16_t* src, float* dst, const float* win, float gain0, float gain1, int numFrames) {
 
     gain0 *= (1/32768.0f);  // int16_t to float
     gain1 *= (1/32768.0f);
@@ -1127,6 +1127,19 @@ static void setFilters(float firCoef[4][HRTF_TAPS], float bqCoef[5][8], int dela
 
 void AudioHRTF::render(int16_t* input, float* output, int index, float azimuth, float distance, float gain, int numFrames) {
 
+    assert(numFrames == HRTF_BLOCK);
+
+    // convert mono input to float
+    ALIGN32 float in[HRTF_BLOCK];
+    for (int i = 0; i < HRTF_BLOCK; i++) {
+        in[i] = (float)input[i] * (1/32768.0f);
+    }
+
+    render(in, output, index, azimuth, distance, gain, numFrames);
+}
+
+void AudioHRTF::render(const float* input, float* output, int index, float azimuth, float distance, float gain, int numFrames) {
+
     assert(index >= 0);
     assert(index < HRTF_TABLES);
     assert(numFrames == HRTF_BLOCK);
@@ -1159,10 +1172,8 @@ void AudioHRTF::render(int16_t* input, float* output, int index, float azimuth,
     _distanceState = distance;
     _gainState = gain;
 
-    // convert mono input to float
-    for (int i = 0; i < HRTF_BLOCK; i++) {
-        in[HRTF_TAPS+i] = (float)input[i] * (1/32768.0f);
-    }
+    // mono input
+    memcpy(&in[HRTF_TAPS], input, HRTF_BLOCK * sizeof(float));
 
     // FIR state update
     memcpy(in, _firState, HRTF_TAPS * sizeof(float));
@@ -1220,7 +1231,7 @@ void AudioHRTF::render(int16_t* input, float* output, int index, float azimuth,
     _resetState = false;
 }
 
-void AudioHRTF::mixMono(int16_t* input, float* output, float gain, int numFrames) {
+void AudioHRTF::mixMono(const int16_t* input, float* output, float gain, int numFrames) {
 
     assert(numFrames == HRTF_BLOCK);
 
@@ -1241,7 +1252,7 @@ void AudioHRTF::mixMono(int16_t* input, float* output, float gain, int numFrames
     _resetState = false;
 }
 
-void AudioHRTF::mixStereo(int16_t* input, float* output, float gain, int numFrames) {
+void AudioHRTF::mixStereo(const int16_t* input, float* output, float gain, int numFrames) {
 
     assert(numFrames == HRTF_BLOCK);
 
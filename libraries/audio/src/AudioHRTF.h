@@ -50,11 +50,16 @@ public:
     //
     void render(int16_t* input, float* output, int index, float azimuth, float distance, float gain, int numFrames);
 
+    //
+    // Same as above, with mono input already converted to float in [-1, 1)
+    //
+    void render(const float* input, float* output, int index, float azimuth, float distance, float gain, int numFrames);
+
     //
     // Non-spatialized direct mix (accumulates into existing output)
     //
-    void mixMono(int16_t* input, float* output, float gain, int numFrames);
-    void mixStereo(int16_t* input, float* output, float gain, int numFrames);
+    void mixMono(const int16_t* input, float* output, float gain, int numFrames);
+    void mixStereo(const int16_t* input, float* output, float gain, int numFrames);
 
     //
     // Fast path when input is known to be silent and state as been flushed
@@ -0,0 +1,105 @@
+//
+//  AudioJitterEstimator.cpp
+//  libraries/audio/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AudioJitterEstimator.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include <NumericalConstants.h>
+
+#include "AudioConstants.h"
+
+const float AudioJitterEstimator::DEFAULT_PERCENTILE = 0.95f;
+
+// ~14s time constant at 100 packets per second
+const float AudioJitterEstimator::STEADY_FORGET_FACTOR = 0.9993f;
+
+const quint64 AudioJitterEstimator::PEAK_HOLD_USECS = 5 * USECS_PER_SECOND;
+
+AudioJitterEstimator::AudioJitterEstimator(float percentile) :
+    _percentile(std::min(std::max(percentile, 0.5f), 1.0f)) {
+    reset();
+}
+
+void AudioJitterEstimator::reset() {
+    // start out assuming packets arrive exactly once per frame
+    _histogram.fill(0.0f);
+    _histogram[1] = 1.0f;
+    _forgetFactor = 0.0f;
+    _lastArrivalUsecs = 0;
+    _percentileFrames = 1;
+    _peakFrames = 0;
+    _peakUsecs = 0;
+    _targetFrames = 1;
+}
+
+void AudioJitterEstimator::setPercentile(float percentile) {
+    _percentile = std::min(std::max(percentile, 0.5f), 1.0f);
+}
+
+void AudioJitterEstimator::packetReceived(quint64 arrivalUsecs, int sequenceFrames) {
+    quint64 lastArrivalUsecs = _lastArrivalUsecs;
+    _lastArrivalUsecs = arrivalUsecs;
+    if (lastArrivalUsecs == 0 || arrivalUsecs < lastArrivalUsecs) {
+        return;
+    }
+
+    int elapsedFrames = (int)std::lround((double)(arrivalUsecs - lastArrivalUsecs) / AudioConstants::NETWORK_FRAME_USECS);
+    if (elapsedFrames >= MAX_IAT_FRAMES) {
+        // a gap this long is the stream pausing, not jitter
+        return;
+    }
+    int iatFrames = std::max(elapsedFrames - (std::max(sequenceFrames, 1) - 1), 0);
+
+    // the forgetting factor ramps up as a running average until it reaches its steady-state value,
+    // so early packets are weighted equally instead of being forgotten immediately
+    for (auto& probability : _histogram) {
+        probability *= _forgetFactor;
+    }
+    _histogram[iatFrames] += 1.0f - _forgetFactor;
+    _forgetFactor = std::min(STEADY_FORGET_FACTOR, 1.0f - (1.0f - _forgetFactor) / (2.0f - _forgetFactor));
+
+    // find the shortest buffer that covers the percentile
+    float sum = 0.0f;
+    int frames = 0;
+    for (; frames < MAX_IAT_FRAMES - 1; ++frames) {
+        sum += _histogram[frames];
+        if (sum >= _percentile) {
+            break;
+        }
+    }
+    _percentileFrames = std::max(frames, 1);
+
+    updatePeak(arrivalUsecs, iatFrames);
+    updateTarget(arrivalUsecs);
+}
+
+void AudioJitterEstimator::starved(quint64 nowUsecs, int framesSinceLastPacket) {
+    updatePeak(nowUsecs, std::min(framesSinceLastPacket, MAX_IAT_FRAMES - 1));
+    updateTarget(nowUsecs);
+}
+
+void AudioJitterEstimator::updatePeak(quint64 nowUsecs, int frames) {
+    if (frames <= _percentileFrames) {
+        return;
+    }
+    if (frames >= _peakFrames || nowUsecs - _peakUsecs > PEAK_HOLD_USECS) {
+        _peakFrames = frames;
+        _peakUsecs = nowUsecs;
+    }
+}
+
+void AudioJitterEstimator::updateTarget(quint64 nowUsecs) {
+    if (_peakFrames > 0 && nowUsecs - _peakUsecs > PEAK_HOLD_USECS) {
+        _peakFrames = 0;
+    }
+    _targetFrames = std::min(std::max(_percentileFrames, _peakFrames), MAX_IAT_FRAMES - 1);
+}
@@ -0,0 +1,69 @@
+//
+//  AudioJitterEstimator.h
+//  libraries/audio/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AudioJitterEstimator_h
+#define hifi_AudioJitterEstimator_h
+
+#include <array>
+
+#include <QtGlobal>
+
+// Estimates the jitter buffer depth needed to cover a given percentile of packet inter-arrival times.
+//
+// Inter-arrival times are measured in network frames (corrected for frames skipped by packet loss) and
+// accumulated in a histogram with an exponential forgetting factor. The forgetting factor starts low so
+// that a new stream adapts within a few packets, then ramps up towards a slow steady-state value.
+// Isolated late packets are too rare to move the percentile, so any packet later than the current target
+// is also tracked as a peak that holds the target up for PEAK_HOLD_USECS.
+class AudioJitterEstimator {
+public:
+    static const int MAX_IAT_FRAMES = 64;
+    static const float DEFAULT_PERCENTILE;
+    static const float STEADY_FORGET_FACTOR;
+    static const quint64 PEAK_HOLD_USECS;
+
+    AudioJitterEstimator(float percentile = DEFAULT_PERCENTILE);
+
+    void reset();
+
+    // record a packet arriving at arrivalUsecs that advances the stream by sequenceFrames network frames
+    // (1 for an in-order packet, more when packets in between were lost)
+    void packetReceived(quint64 arrivalUsecs, int sequenceFrames = 1);
+
+    // record a buffer starve, framesSinceLastPacket frames after the last packet arrived
+    void starved(quint64 nowUsecs, int framesSinceLastPacket);
+
+    int getTargetFrames() const { return _targetFrames; }
+    int getPercentileFrames() const { return _percentileFrames; }
+    int getPeakFrames() const { return _peakFrames; }
+
+    float getPercentile() const { return _percentile; }
+    void setPercentile(float percentile);
+
+    // probability mass of each inter-arrival time, in frames
+    const std::array<float, MAX_IAT_FRAMES>& getHistogram() const { return _histogram; }
+
+private:
+    void updatePeak(quint64 nowUsecs, int frames);
+    void updateTarget(quint64 nowUsecs);
+
+    std::array<float, MAX_IAT_FRAMES> _histogram;
+    float _percentile;
+    float _forgetFactor { 0.0f };
+
+    quint64 _lastArrivalUsecs { 0 };
+
+    int _percentileFrames { 1 };
+    int _peakFrames { 0 };
+    quint64 _peakUsecs { 0 };
+    int _targetFrames { 1 };
+};
+
+#endif // hifi_AudioJitterEstimator_h
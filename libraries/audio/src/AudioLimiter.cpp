@@ -12,12 +12,96 @@
 
 #include "AudioDynamics.h"
 
+//
+// Block kernels
+//
+// Everything except the envelope, min filter and delay line is independent per frame,
+// so it is done a block at a time where it can be vectorized.
+// The reference kernels are not static, so that AudioDSPTests can check the AVX2 kernels against them.
+//
+
+void peakAttn_ref(const float* input, int32_t* attn, int numChannels, int32_t threshold, int numFrames) {
+
+    float* in = const_cast<float*>(input);
+    for (int i = 0; i < numFrames; i++) {
+
+        // peak detect and convert to log2 domain
+        int32_t peak;
+        if (numChannels == 1) {
+            peak = peaklog2(&in[i]);
+        } else if (numChannels == 2) {
+            peak = peaklog2(&in[2*i+0], &in[2*i+1]);
+        } else {
+            peak = peaklog2(&in[4*i+0], &in[4*i+1], &in[4*i+2], &in[4*i+3]);
+        }
+
+        // compute limiter attenuation
+        attn[i] = MAX(threshold - peak, 0);
+    }
+}
+
+void fixexp2Block_ref(int32_t* x, int numFrames) {
+    for (int i = 0; i < numFrames; i++) {
+        x[i] = fixexp2(x[i]);
+    }
+}
+
+void applyGain_ref(const float* input, const float* gain, const float* dither, int16_t* output, int numChannels, int numFrames) {
+    for (int i = 0; i < numFrames; i++) {
+        for (int c = 0; c < numChannels; c++) {
+            float x = input[numChannels*i + c] * gain[i] + dither[i];
+            output[numChannels*i + c] = (int16_t)floatToInt(x);
+        }
+    }
+}
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+
+//
+// Runtime CPU dispatch
+//
+
+#include "CPUDetect.h"
+
+void peakAttn_AVX2(const float* input, int32_t* attn, int numChannels, int32_t threshold, int numFrames);
+void fixexp2Block_AVX2(int32_t* x, int numFrames);
+void applyGain_AVX2(const float* input, const float* gain, const float* dither, int16_t* output, int numChannels, int numFrames);
+
+static void peakAttn(const float* input, int32_t* attn, int numChannels, int32_t threshold, int numFrames) {
+    static auto f = cpuSupportsAVX2() ? peakAttn_AVX2 : peakAttn_ref;
+    (*f)(input, attn, numChannels, threshold, numFrames);   // dispatch
+}
+
+static void fixexp2Block(int32_t* x, int numFrames) {
+    static auto f = cpuSupportsAVX2() ? fixexp2Block_AVX2 : fixexp2Block_ref;
+    (*f)(x, numFrames); // dispatch
+}
+
+static void applyGain(const float* input, const float* gain, const float* dither, int16_t* output, int numChannels, int numFrames) {
+    static auto f = cpuSupportsAVX2() ? applyGain_AVX2 : applyGain_ref;
+    (*f)(input, gain, dither, output, numChannels, numFrames);  // dispatch
+}
+
+#else   // portable reference code
+
+static auto& peakAttn = peakAttn_ref;
+static auto& fixexp2Block = fixexp2Block_ref;
+static auto& applyGain = applyGain_ref;
+
+#endif
+
 //
 // Limiter (common)
 //
 class LimiterImpl {
 protected:
 
+    static const int BLOCK = 256;
+    int32_t _attnBlock[BLOCK];
+    float _gainBlock[BLOCK];
+    float _ditherBlock[BLOCK];
+    float _delayBlock[4 * BLOCK];
+
     static const int NARC = 64;
     int32_t _holdTable[NARC];
     int32_t _releaseTable[NARC];
@@ -43,6 +127,9 @@ public:
 
     int32_t envelope(int32_t attn);
 
+    // peak detect, envelope and convert from log2 domain, into _attnBlock[]
+    void attenuation(float* input, int numChannels, int numFrames);
+
     virtual void process(float* input, int16_t* output, int numFrames) = 0;
 };
 
@@ -191,6 +278,20 @@ int32_t LimiterImpl::envelope(int32_t attn) {
     return attn;
 }
 
+void LimiterImpl::attenuation(float* input, int numChannels, int numFrames) {
+
+    // peak detect and compute limiter attenuation
+    peakAttn(input, _attnBlock, numChannels, _threshold, numFrames);
+
+    // apply envelope
+    for (int n = 0; n < numFrames; n++) {
+        _attnBlock[n] = envelope(_attnBlock[n]);
+    }
+
+    // convert from log2 domain
+    fixexp2Block(_attnBlock, numFrames);
+}
+
 //
 // Limiter (mono)
 //
@@ -209,36 +310,27 @@ public:
 template<int N>
 void LimiterMono<N>::process(float* input, int16_t* output, int numFrames) {
 
-    for (int n = 0; n < numFrames; n++) {
-
-        // peak detect and convert to log2 domain
-        int32_t peak = peaklog2(&input[n]);
-
-        // compute limiter attenuation
-        int32_t attn = MAX(_threshold - peak, 0);
+    for (int i = 0; i < numFrames; i += BLOCK) {
+        int count = MIN(numFrames - i, BLOCK);
+        float* in = &input[i];
 
-        // apply envelope
-        attn = envelope(attn);
+        attenuation(in, 1, count);
 
-        // convert from log2 domain
-        attn = fixexp2(attn);
+        for (int n = 0; n < count; n++) {
 
-        // lowpass filter
-        attn = _filter.process(attn);
-        float gain = attn * _outGain;
+            // lowpass filter
+            int32_t attn = _filter.process(_attnBlock[n]);
+            _gainBlock[n] = attn * _outGain;
+            _ditherBlock[n] = dither();
 
-        // delay audio
-        float x = input[n];
-        _delay.process(x);
-
-        // apply gain
-        x *= gain;
-
-        // apply dither
-        x += dither();
+            // delay audio
+            float x = in[n];
+            _delay.process(x);
+            _delayBlock[n] = x;
+        }
 
-        // store 16-bit output
-        output[n] = (int16_t)floatToInt(x);
+        // apply gain and dither, and store 16-bit output
+        applyGain(_delayBlock, _gainBlock, _ditherBlock, &output[i], 1, count);
     }
 }
 
@@ -261,41 +353,29 @@ public:
 template<int N>
 void LimiterStereo<N>::process(float* input, int16_t* output, int numFrames) {
 
-    for (int n = 0; n < numFrames; n++) {
-
-        // peak detect and convert to log2 domain
-        int32_t peak = peaklog2(&input[2*n+0], &input[2*n+1]);
-
-        // compute limiter attenuation
-        int32_t attn = MAX(_threshold - peak, 0);
-
-        // apply envelope
-        attn = envelope(attn);
-
-        // convert from log2 domain
-        attn = fixexp2(attn);
+    for (int i = 0; i < numFrames; i += BLOCK) {
+        int count = MIN(numFrames - i, BLOCK);
+        float* in = &input[2*i];
 
-        // lowpass filter
-        attn = _filter.process(attn);
-        float gain = attn * _outGain;
+        attenuation(in, 2, count);
 
-        // delay audio
-        float x0 = input[2*n+0];
-        float x1 = input[2*n+1];
-        _delay.process(x0, x1);
+        for (int n = 0; n < count; n++) {
 
-        // apply gain
-        x0 *= gain;
-        x1 *= gain;
+            // lowpass filter
+            int32_t attn = _filter.process(_attnBlock[n]);
+            _gainBlock[n] = attn * _outGain;
+            _ditherBlock[n] = dither();
 
-        // apply dither
-        float d = dither();
-        x0 += d;
-        x1 += d;
+            // delay audio
+            float x0 = in[2*n+0];
+            float x1 = in[2*n+1];
+            _delay.process(x0, x1);
+            _delayBlock[2*n+0] = x0;
+            _delayBlock[2*n+1] = x1;
+        }
 
-        // store 16-bit output
-        output[2*n+0] = (int16_t)floatToInt(x0);
-        output[2*n+1] = (int16_t)floatToInt(x1);
+        // apply gain and dither, and store 16-bit output
+        applyGain(_delayBlock, _gainBlock, _ditherBlock, &output[2*i], 2, count);
     }
 }
 
@@ -318,49 +398,33 @@ public:
 template<int N>
 void LimiterQuad<N>::process(float* input, int16_t* output, int numFrames) {
 
-    for (int n = 0; n < numFrames; n++) {
-
-        // peak detect and convert to log2 domain
-        int32_t peak = peaklog2(&input[4*n+0], &input[4*n+1], &input[4*n+2], &input[4*n+3]);
+    for (int i = 0; i < numFrames; i += BLOCK) {
+        int count = MIN(numFrames - i, BLOCK);
+        float* in = &input[4*i];
+
+        attenuation(in, 4, count);
+
+        for (int n = 0; n < count; n++) {
+
+            // lowpass filter
+            int32_t attn = _filter.process(_attnBlock[n]);
+            _gainBlock[n] = attn * _outGain;
+            _ditherBlock[n] = dither();
+
+            // delay audio
+            float x0 = in[4*n+0];
+            float x1 = in[4*n+1];
+            float x2 = in[4*n+2];
+            float x3 = in[4*n+3];
+            _delay.process(x0, x1, x2, x3);
+            _delayBlock[4*n+0] = x0;
+            _delayBlock[4*n+1] = x1;
+            _delayBlock[4*n+2] = x2;
+            _delayBlock[4*n+3] = x3;
+        }
 
-        // compute limiter attenuation
-        int32_t attn = MAX(_threshold - peak, 0);
-
-        // apply envelope
-        attn = envelope(attn);
-
-        // convert from log2 domain
-        attn = fixexp2(attn);
-
-        // lowpass filter
-        attn = _filter.process(attn);
-        float gain = attn * _outGain;
-
-        // delay audio
-        float x0 = input[4*n+0];
-        float x1 = input[4*n+1];
-        float x2 = input[4*n+2];
-        float x3 = input[4*n+3];
-        _delay.process(x0, x1, x2, x3);
-
-        // apply gain
-        x0 *= gain;
-        x1 *= gain;
-        x2 *= gain;
-        x3 *= gain;
-
-        // apply dither
-        float d = dither();
-        x0 += d;
-        x1 += d;
-        x2 += d;
-        x3 += d;
-
-        // store 16-bit output
-        output[4*n+0] = (int16_t)floatToInt(x0);
-        output[4*n+1] = (int16_t)floatToInt(x1);
-        output[4*n+2] = (int16_t)floatToInt(x2);
-        output[4*n+3] = (int16_t)floatToInt(x3);
+        // apply gain and dither, and store 16-bit output
+        applyGain(_delayBlock, _gainBlock, _ditherBlock, &output[4*i], 4, count);
     }
 }
 
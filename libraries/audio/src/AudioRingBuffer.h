@@ -93,6 +93,10 @@ public:
     ///       Use samplesAvailable() to see the distance a valid shift can go
     void shiftReadPosition(unsigned int numSamples) { _nextOutput = shiftedPositionAccomodatingWrap(_nextOutput, numSamples); }
 
+    /// Moves the read position back over numSamples of previously read data, making them available again
+    /// NOTE: This is not checked - the caller must make sure the writer cannot reach the rewound samples
+    void rewindReadPosition(unsigned int numSamples) { _nextOutput = shiftedPositionAccomodatingWrap(_nextOutput, -(int)numSamples); }
+
     int samplesAvailable() const;
     int framesAvailable() const { return (_numFrameSamples == 0) ? 0 : samplesAvailable() / _numFrameSamples; }
     float getNextOutputFrameLoudness() const { return getFrameLoudness(_nextOutput); }
@@ -0,0 +1,151 @@
+//
+//  AudioTimeStretch.cpp
+//  libraries/audio/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AudioTimeStretch.h"
+
+#include <algorithm>
+#include <cmath>
+
+const float AudioTimeStretch::ACCELERATE_CORRELATION_THRESHOLD = 0.5f;
+
+// below this mean-square level (about -60dBFS) the audio is treated as silence, and any lag will do
+static const float SILENCE_MEAN_SQUARE = 1000.0f;
+
+static inline int16_t crossfade(int16_t from, int16_t to, float weight) {
+    return (int16_t)lrintf((1.0f - weight) * from + weight * to);
+}
+
+int AudioTimeStretch::findBestLag(const AudioRingBuffer& buffer, int numChannels, int minLag, int maxLag, int overlap,
+                                  float& correlation) {
+    // downmix the search region to mono
+    float mono[MAX_SEARCH_LENGTH];
+    int length = maxLag + overlap;
+    float scale = 1.0f / numChannels;
+    for (int i = 0; i < length; ++i) {
+        float sum = 0.0f;
+        for (int c = 0; c < numChannels; ++c) {
+            sum += buffer[i * numChannels + c];
+        }
+        mono[i] = sum * scale;
+    }
+
+    float energy0 = 0.0f;
+    for (int i = 0; i < overlap; ++i) {
+        energy0 += mono[i] * mono[i];
+    }
+    if (energy0 < SILENCE_MEAN_SQUARE * overlap) {
+        correlation = 1.0f;
+        return maxLag;
+    }
+
+    float energyLag = 0.0f;
+    for (int i = minLag; i < minLag + overlap; ++i) {
+        energyLag += mono[i] * mono[i];
+    }
+
+    int bestLag = minLag;
+    float bestCorrelation = -1.0f;
+    for (int lag = minLag; lag <= maxLag; ++lag) {
+        float dot = 0.0f;
+        for (int i = 0; i < overlap; ++i) {
+            dot += mono[i] * mono[i + lag];
+        }
+        float normalized = (energyLag > 0.0f) ? dot / sqrtf(energy0 * energyLag) : 0.0f;
+        if (normalized > bestCorrelation) {
+            bestCorrelation = normalized;
+            bestLag = lag;
+        }
+
+        // slide the lagged window forward by one sample
+        if (lag < maxLag) {
+            energyLag += mono[lag + overlap] * mono[lag + overlap] - mono[lag] * mono[lag];
+            energyLag = std::max(energyLag, 0.0f);
+        }
+    }
+
+    correlation = bestCorrelation;
+    return bestLag;
+}
+
+int AudioTimeStretch::accelerate(AudioRingBuffer& buffer, int numChannels, int sampleRate) {
+    if (!canStretch(numChannels, sampleRate)) {
+        return 0;
+    }
+
+    int minLag = getMinLag(sampleRate);
+    int overlap = getOverlap(sampleRate);
+    int samplesPerChannel = buffer.samplesAvailable() / numChannels;
+    int maxLag = std::min(getMaxLag(sampleRate), samplesPerChannel - overlap);
+    if (maxLag < minLag) {
+        return 0;
+    }
+
+    float correlation;
+    int lag = findBestLag(buffer, numChannels, minLag, maxLag, overlap, correlation);
+    if (correlation < ACCELERATE_CORRELATION_THRESHOLD) {
+        return 0;
+    }
+
+    // cross-fade the first overlap samples into the segment one lag later, then skip the lag.
+    // working backwards keeps the lagged writes from clobbering samples that are still to be read.
+    for (int i = overlap - 1; i >= 0; --i) {
+        float weight = (i + 0.5f) / overlap;
+        for (int c = 0; c < numChannels; ++c) {
+            buffer[(i + lag) * numChannels + c] = crossfade(buffer[i * numChannels + c],
+                                                            buffer[(i + lag) * numChannels + c], weight);
+        }
+    }
+    buffer.shiftReadPosition(lag * numChannels);
+
+    return lag;
+}
+
+int AudioTimeStretch::expand(AudioRingBuffer& buffer, int numChannels, int sampleRate) {
+    if (!canStretch(numChannels, sampleRate)) {
+        return 0;
+    }
+
+    // the inserted period is written behind the read position, so leave the writer a frame of room
+    int samplesAvailable = buffer.samplesAvailable();
+    int samplesPerChannel = samplesAvailable / numChannels;
+    int roomPerChannel = (buffer.getSampleCapacity() - samplesAvailable - buffer.getNumFrameSamples()) / numChannels;
+    int minLag = getMinLag(sampleRate);
+    int overlap = getOverlap(sampleRate);
+    int maxLag = std::min({ getMaxLag(sampleRate), samplesPerChannel - overlap, roomPerChannel });
+    if (maxLag < minLag) {
+        return 0;
+    }
+
+    float correlation;
+    int lag = findBestLag(buffer, numChannels, minLag, maxLag, overlap, correlation);
+
+    // play the first lag samples, then cross-fade from the following segment back into the first one,
+    // so that one period is heard twice
+    int16_t expanded[MAX_SEARCH_LENGTH * MAX_CHANNELS];
+    for (int i = 0; i < lag * numChannels; ++i) {
+        expanded[i] = buffer[i];
+    }
+    for (int i = 0; i < overlap; ++i) {
+        float weight = (i + 0.5f) / overlap;
+        for (int c = 0; c < numChannels; ++c) {
+            expanded[(lag + i) * numChannels + c] = crossfade(buffer[(lag + i) * numChannels + c],
+                                                              buffer[i * numChannels + c], weight);
+        }
+    }
+
+    int expandedSamples = (lag + overlap) * numChannels;
+    int offset = lag * numChannels;
+    for (int i = 0; i < expandedSamples; ++i) {
+        buffer[i - offset] = expanded[i];
+    }
+    buffer.rewindReadPosition(offset);
+
+    return lag;
+}
@@ -0,0 +1,66 @@
+//
+//  AudioTimeStretch.h
+//  libraries/audio/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AudioTimeStretch_h
+#define hifi_AudioTimeStretch_h
+
+#include "AudioConstants.h"
+#include "AudioRingBuffer.h"
+
+// WSOLA-style time-stretching of the unread audio at the front of a ring buffer.
+//
+// The lag with the best normalized cross-correlation (roughly one pitch period) is found in the
+// upcoming audio, and a single period is removed (accelerate) or repeated (expand) by cross-fading
+// between the two aligned segments. This lets a jitter buffer drain or fill by a few milliseconds
+// at a time without the discontinuity of dropping or inserting whole frames.
+//
+// Both operations only touch samples that have already been written, and must be called from the
+// thread that reads from the buffer. expand() also writes behind the read position and moves it back,
+// so nothing may write to the buffer while it runs.
+class AudioTimeStretch {
+public:
+    static const int MAX_CHANNELS = 2;
+    static const int MAX_SAMPLE_RATE = 192000;
+
+    // the lag search range and cross-fade length, in samples per channel at AudioConstants::SAMPLE_RATE
+    static const int MIN_LAG = 60;          // 2.5ms
+    static const int MAX_LAG = 300;         // 12.5ms
+    static const int OVERLAP = 120;         // 5ms
+    static const float ACCELERATE_CORRELATION_THRESHOLD;
+
+    // the same lengths scaled to another sample rate
+    static int getMinLag(int sampleRate) { return scaleToSampleRate(MIN_LAG, sampleRate); }
+    static int getMaxLag(int sampleRate) { return scaleToSampleRate(MAX_LAG, sampleRate); }
+    static int getOverlap(int sampleRate) { return scaleToSampleRate(OVERLAP, sampleRate); }
+
+    // removes about one pitch period from the front of the buffer.
+    // returns the number of samples per channel removed, or 0 if the audio is not periodic enough to do so cleanly.
+    static int accelerate(AudioRingBuffer& buffer, int numChannels, int sampleRate = AudioConstants::SAMPLE_RATE);
+
+    // repeats about one pitch period at the front of the buffer, reusing the space behind the read position.
+    // returns the number of samples per channel inserted.
+    static int expand(AudioRingBuffer& buffer, int numChannels, int sampleRate = AudioConstants::SAMPLE_RATE);
+
+private:
+    static const int MAX_SEARCH_LENGTH = (MAX_LAG + OVERLAP) * (MAX_SAMPLE_RATE / AudioConstants::SAMPLE_RATE);
+
+    static int scaleToSampleRate(int samples, int sampleRate) {
+        return (int)((qint64)samples * sampleRate / AudioConstants::SAMPLE_RATE);
+    }
+    static bool canStretch(int numChannels, int sampleRate) {
+        return numChannels >= 1 && numChannels <= MAX_CHANNELS &&
+            sampleRate >= AudioConstants::SAMPLE_RATE / 2 && sampleRate <= MAX_SAMPLE_RATE;
+    }
+
+    static int findBestLag(const AudioRingBuffer& buffer, int numChannels, int minLag, int maxLag, int overlap,
+                           float& correlation);
+};
+
+#endif // hifi_AudioTimeStretch_h
@@ -19,18 +19,14 @@
 #include <NodeList.h>
 
 #include "AudioLogging.h"
+#include "AudioTimeStretch.h"
 
 const bool InboundAudioStream::DEFAULT_DYNAMIC_JITTER_BUFFER_ENABLED = true;
 const int InboundAudioStream::DEFAULT_STATIC_JITTER_FRAMES = 1;
 const int InboundAudioStream::MAX_FRAMES_OVER_DESIRED = 10;
-const int InboundAudioStream::WINDOW_STARVE_THRESHOLD = 3;
-const int InboundAudioStream::WINDOW_SECONDS_FOR_DESIRED_CALC_ON_TOO_MANY_STARVES = 50;
-const int InboundAudioStream::WINDOW_SECONDS_FOR_DESIRED_REDUCTION = 10;
 const bool InboundAudioStream::USE_STDEV_FOR_JITTER = false;
 const bool InboundAudioStream::REPETITION_WITH_FADE = true;
 
-static const int STARVE_HISTORY_CAPACITY = 50;
-
 // This is called 1x/s, and we want it to log the last 5s
 static const int UNPLAYED_MS_WINDOW_SECS = 5;
 
@@ -40,6 +36,10 @@ static const int UNPLAYED_MS_WINDOW_SECS = 5;
 // which could lead to a starve soon after.
 static const int DESIRED_JITTER_BUFFER_FRAMES_PADDING = 1;
 
+// The buffer is time-stretched towards _desiredJitterBufferFrames, one pitch period per pop: it is compressed once it
+// holds more than this many frames over the desired size, and expanded once it falls below the desired size.
+static const int TIME_STRETCH_ACCELERATE_FRAMES_OVER_DESIRED = 1;
+
 // this controls the length of the window for stats used in the stats packet (not the stats used in
 // _desiredJitterBufferFrames calculation)
 static const int STATS_FOR_STATS_PACKET_WINDOW_SECONDS = 30;
@@ -59,7 +59,6 @@ InboundAudioStream::InboundAudioStream(int numChannels, int numFrames, int numBl
     _staticJitterBufferFrames(std::max(numStaticJitterBlocks, DEFAULT_STATIC_JITTER_FRAMES)),
     _desiredJitterBufferFrames(_dynamicJitterBufferEnabled ? 1 : _staticJitterBufferFrames),
     _incomingSequenceNumberStats(STATS_FOR_STATS_PACKET_WINDOW_SECONDS),
-    _starveHistory(STARVE_HISTORY_CAPACITY),
     _unplayedMs(0, UNPLAYED_MS_WINDOW_SECS),
     _timeGapStatsForStatsPacket(0, STATS_FOR_STATS_PACKET_WINDOW_SECONDS) {}
 
@@ -87,15 +86,17 @@ void InboundAudioStream::resetStats() {
     _starveCount = 0;
     _silentFramesDropped = 0;
     _oldFramesDropped = 0;
+    _accelerateCount = 0;
+    _expandCount = 0;
     _incomingSequenceNumberStats.reset();
     _lastPacketReceivedTime = 0;
-    _timeGapStatsForDesiredCalcOnTooManyStarves.reset();
-    _timeGapStatsForDesiredReduction.reset();
-    _starveHistory.clear();
+    _jitterEstimator.reset();
+    _calculatedJitterBufferFrames = 1;
     _framesAvailableStat.reset();
     _currentJitterBufferFrames = 0;
     _timeGapStatsForStatsPacket.reset();
     _unplayedMs.reset();
+    _latencyHistogram.fill(0);
 }
 
 void InboundAudioStream::clearBuffer() {
@@ -112,8 +113,6 @@ void InboundAudioStream::setReverb(float reverbTime, float wetLevel) {
 
 void InboundAudioStream::perSecondCallbackForUpdatingStats() {
     _incomingSequenceNumberStats.pushStatsToHistory();
-    _timeGapStatsForDesiredCalcOnTooManyStarves.currentIntervalComplete();
-    _timeGapStatsForDesiredReduction.currentIntervalComplete();
     _timeGapStatsForStatsPacket.currentIntervalComplete();
     _unplayedMs.currentIntervalComplete();
 }
@@ -126,7 +125,7 @@ int InboundAudioStream::parseData(ReceivedMessage& message) {
         _incomingSequenceNumberStats.sequenceNumberReceived(sequence, message.getSourceID());
     QString codecInPacket = message.readString();
 
-    packetReceivedUpdateTimingStats();
+    packetReceivedUpdateTimingStats(arrivalInfo);
 
     int networkFrames;
 
@@ -176,6 +175,7 @@ int InboundAudioStream::parseData(ReceivedMessage& message) {
                     if (packetPCM) {
                         // If there are PCM packets in-flight after the codec is changed, use them.
                         auto afterProperties = message.readWithoutCopy(message.getBytesLeftToRead());
+                        QMutexLocker lock(&_decoderMutex);
                         _ringBuffer.writeData(afterProperties.data(), afterProperties.size());
                     } else {
                         // Since the data in the stream is using a codec that we aren't prepared for,
@@ -215,7 +215,10 @@ int InboundAudioStream::parseData(ReceivedMessage& message) {
     // drop the oldest frames so the ringbuffer is down to the desired size.
     if (framesAvailable > _desiredJitterBufferFrames + MAX_FRAMES_OVER_DESIRED) {
         int framesToDrop = framesAvailable - (_desiredJitterBufferFrames + DESIRED_JITTER_BUFFER_FRAMES_PADDING);
-        _ringBuffer.shiftReadPosition(framesToDrop * _ringBuffer.getNumFrameSamples());
+        {
+            QMutexLocker lock(&_decoderMutex);
+            _ringBuffer.shiftReadPosition(framesToDrop * _ringBuffer.getNumFrameSamples());
+        }
 
         _framesAvailableStat.reset();
         _currentJitterBufferFrames = 0;
@@ -293,23 +296,23 @@ int InboundAudioStream::writeDroppableSilentFrames(int silentFrames) {
     // case we will call the decoder's lostFrame() method, which indicates
     // that it should interpolate from its last known state down toward 
     // silence.
-    {
-        // may block on the real-time thread, which is acceptible as 
-        // writeDroppableSilentFrames is only called by the packet processing
-        // thread which, while high performance, is not as sensitive to
-        // delays as the real-time thread.
-        QMutexLocker lock(&_decoderMutex);
-        if (_decoder) {
-            // FIXME - We could potentially use the output from the codec, in which 
-            // case we might get a cleaner fade toward silence. NOTE: The below logic 
-            // attempts to catch up in the event that the jitter buffers have grown. 
-            // The better long term fix is to use the output from the decode, detect
-            // when it actually reaches silence, and then delete the silent portions
-            // of the jitter buffers. Or petentially do a cross fade from the decode
-            // output to silence.
-            QByteArray decodedBuffer;
-            _decoder->lostFrame(decodedBuffer);
-        }
+    //
+    // may block on the real-time thread, which is acceptible as 
+    // writeDroppableSilentFrames is only called by the packet processing
+    // thread which, while high performance, is not as sensitive to
+    // delays as the real-time thread. the lock is held until the silence is
+    // on the ring buffer, so that it is not written during a time-stretch.
+    QMutexLocker lock(&_decoderMutex);
+    if (_decoder) {
+        // FIXME - We could potentially use the output from the codec, in which 
+        // case we might get a cleaner fade toward silence. NOTE: The below logic 
+        // attempts to catch up in the event that the jitter buffers have grown. 
+        // The better long term fix is to use the output from the decode, detect
+        // when it actually reaches silence, and then delete the silent portions
+        // of the jitter buffers. Or petentially do a cross fade from the decode
+        // output to silence.
+        QByteArray decodedBuffer;
+        _decoder->lostFrame(decodedBuffer);
     }
 
     // calculate how many silent frames we should drop.
@@ -352,6 +355,7 @@ int InboundAudioStream::popSamples(int maxSamples, bool allOrNothing) {
     } else {
         if (samplesAvailable >= maxSamples) {
             // we have enough samples to pop, so we're good to pop
+            timeStretch(maxSamples);
             popSamplesNoCheck(maxSamples);
             samplesPopped = maxSamples;
         } else if (!allOrNothing && samplesAvailable > 0) {
@@ -397,9 +401,43 @@ int InboundAudioStream::popFrames(int maxFrames, bool allOrNothing) {
     return samplesPopped / numFrameSamples;
 }
 
+void InboundAudioStream::timeStretch(int samplesToPop) {
+    if (!_dynamicJitterBufferEnabled) {
+        return;
+    }
+
+    // the stretch rewrites samples around the read position, so keep the packet processing thread from writing
+    // while it runs. this is the real-time thread, so rather than wait, skip stretching until the next pop.
+    MutexTryLocker lock(_decoderMutex);
+    if (!lock.isLocked()) {
+        return;
+    }
+
+    // a frame is always NETWORK_FRAME_MSECS long, so its size gives the rate the buffer is played at
+    int numFrameSamples = _ringBuffer.getNumFrameSamples();
+    int sampleRate = numFrameSamples / _numChannels * AudioConstants::SAMPLE_RATE /
+        AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL;
+    int samplesAvailable = _ringBuffer.samplesAvailable();
+    int framesAvailable = samplesAvailable / numFrameSamples;
+
+    if (framesAvailable > _desiredJitterBufferFrames + TIME_STRETCH_ACCELERATE_FRAMES_OVER_DESIRED) {
+        // make sure there is still enough left for this pop once a period has been removed
+        if (samplesAvailable - AudioTimeStretch::getMaxLag(sampleRate) * _numChannels >= samplesToPop &&
+            AudioTimeStretch::accelerate(_ringBuffer, _numChannels, sampleRate) > 0) {
+            _accelerateCount++;
+        }
+    } else if (framesAvailable < _desiredJitterBufferFrames) {
+        if (AudioTimeStretch::expand(_ringBuffer, _numChannels, sampleRate) > 0) {
+            _expandCount++;
+        }
+    }
+}
+
 void InboundAudioStream::popSamplesNoCheck(int samples) {
     float unplayedMs = (_ringBuffer.samplesAvailable() / (float)_ringBuffer.getNumFrameSamples()) * AudioConstants::NETWORK_FRAME_MSECS;
     _unplayedMs.update(unplayedMs);
+    int bucket = std::min((int)(unplayedMs / LATENCY_HISTOGRAM_BUCKET_MSECS), LATENCY_HISTOGRAM_BUCKETS - 1);
+    _latencyHistogram[bucket]++;
 
     _lastPopOutput = _ringBuffer.nextOutput();
     _ringBuffer.shiftReadPosition(samples);
@@ -423,46 +461,20 @@ void InboundAudioStream::framesAvailableChanged() {
 void InboundAudioStream::setToStarved() {
     _consecutiveNotMixedCount = 0;
     _starveCount++;
+
+    if (_lastPacketReceivedTime > 0) {
+        // the buffer was too short for the current gap between packets. we don't know when the next packet will
+        // arrive, so let the estimator raise the target to cover at least the time since the last packet.
+        quint64 now = usecTimestampNow();
+        int framesSinceLastPacket = ceilf((float)(now - _lastPacketReceivedTime)
+                                          / (float)AudioConstants::NETWORK_FRAME_USECS);
+        _jitterEstimator.starved(now, framesSinceLastPacket);
+        updateDesiredJitterBufferFrames();
+    }
+
     // if we have more than the desired frames when setToStarved() is called, then we'll immediately
     // be considered refilled. in that case, there's no need to set _isStarved to true.
     _isStarved = (_ringBuffer.framesAvailable() < _desiredJitterBufferFrames);
-
-    // record the time of this starve in the starve history
-    quint64 now = usecTimestampNow();
-    _starveHistory.insert(now);
-
-    if (_dynamicJitterBufferEnabled) {
-        // dynamic jitter buffers are enabled. check if this starve put us over the window
-        // starve threshold
-        quint64 windowEnd = now - WINDOW_SECONDS_FOR_DESIRED_CALC_ON_TOO_MANY_STARVES * USECS_PER_SECOND;
-        RingBufferHistory<quint64>::Iterator starvesIterator = _starveHistory.begin();
-        RingBufferHistory<quint64>::Iterator end = _starveHistory.end();
-        int starvesInWindow = 1;
-        do {
-            ++starvesIterator;
-            if (*starvesIterator < windowEnd) {
-                break;
-            }
-            starvesInWindow++;
-        } while (starvesIterator != end);
-
-        // this starve put us over the starve threshold. update _desiredJitterBufferFrames to
-        // value determined by window A.
-        if (starvesInWindow >= WINDOW_STARVE_THRESHOLD) {
-            int calculatedJitterBufferFrames;
-            // we don't know when the next packet will arrive, so it's possible the gap between the last packet and the
-            // next packet will exceed the max time gap in the window.  If the time since the last packet has already exceeded
-            // the window max gap, then we should use that value to calculate desired frames.
-            int framesSinceLastPacket = ceilf((float)(now - _lastPacketReceivedTime)
-                                              / (float)AudioConstants::NETWORK_FRAME_USECS);
-            calculatedJitterBufferFrames = std::max(_calculatedJitterBufferFrames, framesSinceLastPacket);
-            // make sure _desiredJitterBufferFrames does not become lower here
-            if (calculatedJitterBufferFrames >= _desiredJitterBufferFrames) {
-                _desiredJitterBufferFrames = calculatedJitterBufferFrames;
-                qCInfo(audiostream, "Set desired jitter frames to %d (starved)", _desiredJitterBufferFrames);
-            }
-        }
-    }
 }
 
 void InboundAudioStream::setDynamicJitterBufferEnabled(bool enable) {
@@ -470,8 +482,8 @@ void InboundAudioStream::setDynamicJitterBufferEnabled(bool enable) {
         _desiredJitterBufferFrames = _staticJitterBufferFrames;
     } else {
         if (!_dynamicJitterBufferEnabled) {
-            // if we're enabling dynamic jitter buffer frames, start desired frames at 1
-            _desiredJitterBufferFrames = 1;
+            // if we're enabling dynamic jitter buffer frames, start from the current estimate
+            _desiredJitterBufferFrames = _calculatedJitterBufferFrames;
         }
     }
     _dynamicJitterBufferEnabled = enable;
@@ -484,42 +496,37 @@ void InboundAudioStream::setStaticJitterBufferFrames(int staticJitterBufferFrame
     }
 }
 
-void InboundAudioStream::packetReceivedUpdateTimingStats() {
-    
-    // update our timegap stats and desired jitter buffer frames if necessary
+void InboundAudioStream::packetReceivedUpdateTimingStats(const SequenceNumberStats::ArrivalInfo& arrivalInfo) {
+    quint64 now = usecTimestampNow();
+
+    // late and unreasonable packets don't advance the stream, so they say nothing about the buffer we need
+    if (arrivalInfo._status == SequenceNumberStats::OnTime) {
+        _jitterEstimator.packetReceived(now, 1);
+    } else if (arrivalInfo._status == SequenceNumberStats::Early) {
+        _jitterEstimator.packetReceived(now, arrivalInfo._seqDiffFromExpected + 1);
+    }
+    updateDesiredJitterBufferFrames();
+
+    // update our timegap stats
     // discard the first few packets we receive since they usually have gaps that aren't represensative of normal jitter
     const quint32 NUM_INITIAL_PACKETS_DISCARD = 1000; // 10s
-    quint64 now = usecTimestampNow();
     if (_incomingSequenceNumberStats.getReceived() > NUM_INITIAL_PACKETS_DISCARD) {
         quint64 gap = now - _lastPacketReceivedTime;
         _timeGapStatsForStatsPacket.update(gap);
+    }
 
-        // update all stats used for desired frames calculations under dynamic jitter buffer mode
-        _timeGapStatsForDesiredCalcOnTooManyStarves.update(gap);
-        _timeGapStatsForDesiredReduction.update(gap);
+    _lastPacketReceivedTime = now;
+}
 
-        if (_timeGapStatsForDesiredCalcOnTooManyStarves.getNewStatsAvailableFlag()) {
-            _calculatedJitterBufferFrames = ceilf((float)_timeGapStatsForDesiredCalcOnTooManyStarves.getWindowMax()
-                                                             / (float) AudioConstants::NETWORK_FRAME_USECS);
-            _timeGapStatsForDesiredCalcOnTooManyStarves.clearNewStatsAvailableFlag();
-        }
+void InboundAudioStream::updateDesiredJitterBufferFrames() {
+    // leave room in the ring buffer to keep receiving while the buffer fills to the desired size
+    int maxFrames = std::max(_ringBuffer.getFrameCapacity() / 2, 1);
+    _calculatedJitterBufferFrames = std::min(_jitterEstimator.getTargetFrames(), maxFrames);
 
-        if (_dynamicJitterBufferEnabled) {
-            // if the max gap in window B (_timeGapStatsForDesiredReduction) corresponds to a smaller number of frames than _desiredJitterBufferFrames,
-            // then reduce _desiredJitterBufferFrames to that number of frames.
-            if (_timeGapStatsForDesiredReduction.getNewStatsAvailableFlag() && _timeGapStatsForDesiredReduction.isWindowFilled()) {
-                int calculatedJitterBufferFrames = ceilf((float)_timeGapStatsForDesiredReduction.getWindowMax()
-                                                         / (float)AudioConstants::NETWORK_FRAME_USECS);
-                if (calculatedJitterBufferFrames < _desiredJitterBufferFrames) {
-                    _desiredJitterBufferFrames = calculatedJitterBufferFrames;
-                    qCInfo(audiostream, "Set desired jitter frames to %d (reduced)", _desiredJitterBufferFrames);
-                }
-                _timeGapStatsForDesiredReduction.clearNewStatsAvailableFlag();
-            }
-        }
+    if (_dynamicJitterBufferEnabled && _calculatedJitterBufferFrames != _desiredJitterBufferFrames) {
+        _desiredJitterBufferFrames = _calculatedJitterBufferFrames;
+        qCDebug(audiostream, "Set desired jitter frames to %d", _desiredJitterBufferFrames);
     }
-
-    _lastPacketReceivedTime = now;
 }
 
 AudioStreamStats InboundAudioStream::getAudioStreamStats() const {
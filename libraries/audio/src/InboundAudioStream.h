@@ -21,6 +21,9 @@
 
 #include <plugins/CodecPlugin.h>
 
+#include <array>
+
+#include "AudioJitterEstimator.h"
 #include "AudioRingBuffer.h"
 #include "MovingMinMaxAvg.h"
 #include "SequenceNumberStats.h"
@@ -41,13 +44,15 @@ public:
     static const int DEFAULT_STATIC_JITTER_FRAMES;
     // legacy (now static) settings
     static const int MAX_FRAMES_OVER_DESIRED;
-    static const int WINDOW_STARVE_THRESHOLD;
-    static const int WINDOW_SECONDS_FOR_DESIRED_CALC_ON_TOO_MANY_STARVES;
-    static const int WINDOW_SECONDS_FOR_DESIRED_REDUCTION;
     // unused (eradicated) settings
     static const bool USE_STDEV_FOR_JITTER;
     static const bool REPETITION_WITH_FADE;
 
+    // histogram of the buffered audio (in ms) each time a frame is played
+    static const int LATENCY_HISTOGRAM_BUCKETS = 20;
+    static const int LATENCY_HISTOGRAM_BUCKET_MSECS = 10;
+    using LatencyHistogram = std::array<quint32, LATENCY_HISTOGRAM_BUCKETS>;
+
     InboundAudioStream() = delete;
     InboundAudioStream(int numChannels, int numFrames, int numBlocks, int numStaticJitterBlocks);
     ~InboundAudioStream();
@@ -75,6 +80,7 @@ public:
 
     /// returns the desired number of jitter buffer frames under the dyanmic jitter buffers scheme
     int getCalculatedJitterBufferFrames() const { return _calculatedJitterBufferFrames; }
+    const AudioJitterEstimator& getJitterEstimator() const { return _jitterEstimator; }
     
     bool dynamicJitterBufferEnabled() const { return _dynamicJitterBufferEnabled; }
     int getStaticJitterBufferFrames() { return _staticJitterBufferFrames; }
@@ -93,6 +99,9 @@ public:
     int getStarveCount() const { return _starveCount; }
     int getSilentFramesDropped() const { return _silentFramesDropped; }
     int getOverflowCount() const { return _ringBuffer.getOverflowCount(); }
+    int getAccelerateCount() const { return _accelerateCount; }
+    int getExpandCount() const { return _expandCount; }
+    const LatencyHistogram& getLatencyHistogram() const { return _latencyHistogram; }
 
     int getPacketsReceived() const { return _incomingSequenceNumberStats.getReceived(); }
     
@@ -109,14 +118,15 @@ signals:
     void mismatchedAudioCodec(SharedNodePointer sendingNode, const QString& currentCodec, const QString& recievedCodec);
 
 public slots:
-    /// This function should be called every second for all the stats to function properly. If dynamic jitter buffers
-    /// is enabled, those stats are used to calculate _desiredJitterBufferFrames.
-    /// If the stats are not used and dynamic jitter buffers is disabled, it's not necessary to call this function.
+    /// This function should be called every second for all the stats to function properly.
+    /// If the stats are not used, it's not necessary to call this function.
     void perSecondCallbackForUpdatingStats();
 
 private:
-    void packetReceivedUpdateTimingStats();
+    void packetReceivedUpdateTimingStats(const SequenceNumberStats::ArrivalInfo& arrivalInfo);
+    void updateDesiredJitterBufferFrames();
 
+    void timeStretch(int samplesToPop);
     void popSamplesNoCheck(int samples);
     void framesAvailableChanged();
 
@@ -161,18 +171,18 @@ protected:
     int _starveCount { 0 };
     int _silentFramesDropped { 0 };
     int _oldFramesDropped { 0 };
+    int _accelerateCount { 0 };
+    int _expandCount { 0 };
 
     SequenceNumberStats _incomingSequenceNumberStats;
 
     quint64 _lastPacketReceivedTime { 0 };
-    MovingMinMaxAvg<quint64> _timeGapStatsForDesiredCalcOnTooManyStarves { 0, WINDOW_SECONDS_FOR_DESIRED_CALC_ON_TOO_MANY_STARVES };
-    int _calculatedJitterBufferFrames { 0 };
-    MovingMinMaxAvg<quint64> _timeGapStatsForDesiredReduction { 0, WINDOW_SECONDS_FOR_DESIRED_REDUCTION };
-
-    RingBufferHistory<quint64> _starveHistory;
+    AudioJitterEstimator _jitterEstimator;
+    int _calculatedJitterBufferFrames { 1 };
 
     TimeWeightedAvg<int> _framesAvailableStat;
     MovingMinMaxAvg<float> _unplayedMs;
+    LatencyHistogram _latencyHistogram {};
 
     // this value is periodically updated with the time-weighted avg from _framesAvailableStat. it is only used for
     // dropping silent frames right now.
@@ -187,6 +197,7 @@ protected:
 
     CodecPluginPointer _codec;
     QString _selectedCodecName;
+    // held while decoding, and while the packet processing thread writes to _ringBuffer or time-stretching rewrites it
     QMutex _decoderMutex;
     Decoder* _decoder { nullptr };
     int _mismatchedAudioCodecCount { 0 };
@@ -44,6 +44,25 @@ void PositionalAudioStream::resetStats() {
     _lastPopOutputLoudness = 0.0f;
 }
 
+void PositionalAudioStream::captureLastPopOutput() {
+    if (_lastPopOutput.isNull()) {
+        return;
+    }
+
+    auto popOutput = _lastPopOutput;
+    if (_isStereo) {
+        popOutput.readSamples(_lastPopSamples, AudioConstants::NETWORK_FRAME_SAMPLES_STEREO);
+    } else {
+        popOutput.readSamples(_lastPopSamples, AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+
+        const float INT16_TO_FLOAT = 1.0f / 32768.0f;
+        for (int i = 0; i < AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL; i++) {
+            _lastPopFloatSamples[i] = (float)_lastPopSamples[i] * INT16_TO_FLOAT;
+        }
+    }
+    _hasLastPopSamples = true;
+}
+
 void PositionalAudioStream::updateLastPopOutputLoudnessAndTrailingLoudness() {
     _lastPopOutputLoudness = _ringBuffer.getFrameLoudness(_lastPopOutput);
 
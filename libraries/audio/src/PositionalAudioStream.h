@@ -54,6 +54,14 @@ public:
 
     virtual AudioStreamStats getAudioStreamStats() const override;
 
+    // copy the last popped frame out of the ring buffer, once per frame, so that mixes for every
+    // listener can read it as contiguous samples without touching the ring buffer
+    void captureLastPopOutput();
+    bool hasLastPopSamples() const { return _hasLastPopSamples; }
+    const int16_t* getLastPopSamples() const { return _lastPopSamples; }
+    // mono streams only, normalized to [-1, 1) for the HRTF
+    const float* getLastPopFloatSamples() const { return _lastPopFloatSamples; }
+
     void updateLastPopOutputLoudnessAndTrailingLoudness();
     float getLastPopOutputTrailingLoudness() const { return _lastPopOutputTrailingLoudness; }
     float getLastPopOutputLoudness() const { return _lastPopOutputLoudness; }
@@ -109,6 +117,10 @@ protected:
 
     bool _isIgnoreBoxEnabled { false };
     IgnoreBox _ignoreBox;
+
+    bool _hasLastPopSamples { false };
+    int16_t _lastPopSamples[AudioConstants::NETWORK_FRAME_SAMPLES_STEREO] {};
+    float _lastPopFloatSamples[AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL] {};
 };
 
 #endif // hifi_PositionalAudioStream_h
@@ -0,0 +1,202 @@
+//
+//  AudioLimiter_avx2.cpp
+//  libraries/audio/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifdef __AVX2__
+
+#include <assert.h>
+#include <immintrin.h>
+
+#include "../AudioDynamics.h"
+
+// signed 32x32 multiply, returning the high 32 bits (MULHI)
+static inline __m256i mulhi_epi32(__m256i a, __m256i b) {
+    __m256i even = _mm256_mul_epi32(a, b);
+    __m256i odd = _mm256_mul_epi32(_mm256_srli_epi64(a, 32), _mm256_srli_epi64(b, 32));
+    return _mm256_blend_epi32(_mm256_srli_epi64(even, 32), odd, 0xaa);
+}
+
+// evaluate the piecewise polynomial in table[k][0..2] at x
+static inline __m256i polynomial(const int32_t table[][3], __m256i x, __m256i k) {
+    k = _mm256_add_epi32(k, _mm256_add_epi32(k, k));   // k * 3
+
+    __m256i c0 = _mm256_i32gather_epi32((const int*)&table[0][0], k, 4);
+    __m256i c1 = _mm256_i32gather_epi32((const int*)&table[0][1], k, 4);
+    __m256i c2 = _mm256_i32gather_epi32((const int*)&table[0][2], k, 4);
+
+    c1 = _mm256_add_epi32(c1, mulhi_epi32(c0, x));
+    c2 = _mm256_add_epi32(c2, mulhi_epi32(c1, x));
+    return c2;
+}
+
+// -log2(x) of 8 peak values, given as the bits of fabs(x) (see peaklog2)
+static inline __m256i peaklog2_AVX2(__m256i peak) {
+
+    // split into e and x - 1.0
+    __m256i e = _mm256_sub_epi32(_mm256_set1_epi32(IEEE754_EXPN_BIAS + LOG2_HEADROOM),
+                                 _mm256_srli_epi32(peak, IEEE754_MANT_BITS));
+    __m256i x = _mm256_and_si256(_mm256_slli_epi32(peak, IEEE754_EXPN_BITS), _mm256_set1_epi32(0x7fffffff));
+
+    // polynomial for log2(1+x) over x=[0,1]
+    __m256i k = _mm256_srli_epi32(x, 31 - LOG2_TABBITS);
+    __m256i c2 = polynomial(log2Table, x, k);
+
+    // reconstruct result in Q26
+    __m256i result = _mm256_sub_epi32(_mm256_slli_epi32(e, LOG2_FRACBITS), _mm256_srai_epi32(c2, 3));
+
+    // saturate when e > 31 or e < 0
+    __m256i saturate = _mm256_or_si256(_mm256_cmpgt_epi32(e, _mm256_set1_epi32(31)),
+                                       _mm256_cmpgt_epi32(_mm256_setzero_si256(), e));
+    __m256i saturated = _mm256_andnot_si256(_mm256_srai_epi32(e, 31), _mm256_set1_epi32(0x7fffffff));
+    return _mm256_blendv_epi8(result, saturated, saturate);
+}
+
+//
+// Peak detect, convert to log2 domain, and compute the limiter attenuation
+//
+void peakAttn_AVX2(const float* input, int32_t* attn, int numChannels, int32_t threshold, int numFrames) {
+
+    const __m256i absMask = _mm256_set1_epi32(IEEE754_FABS_MASK);
+    const __m256i thresh = _mm256_set1_epi32(threshold);
+    const __m256i zero = _mm256_setzero_si256();
+
+    int i = 0;
+    if (numChannels == 1) {
+
+        for (; i < numFrames - 7; i += 8) {
+            __m256i peak = _mm256_and_si256(_mm256_loadu_si256((const __m256i*)&input[i]), absMask);
+
+            __m256i a = _mm256_max_epi32(_mm256_sub_epi32(thresh, peaklog2_AVX2(peak)), zero);
+            _mm256_storeu_si256((__m256i*)&attn[i], a);
+        }
+
+    } else if (numChannels == 2) {
+
+        for (; i < numFrames - 7; i += 8) {
+            __m256i lo = _mm256_and_si256(_mm256_loadu_si256((const __m256i*)&input[2*i + 0]), absMask);
+            __m256i hi = _mm256_and_si256(_mm256_loadu_si256((const __m256i*)&input[2*i + 8]), absMask);
+
+            // max absolute value of each L/R pair (as integers, since the sign bits are clear)
+            lo = _mm256_max_epi32(lo, _mm256_shuffle_epi32(lo, _MM_SHUFFLE(2,3,0,1)));
+            hi = _mm256_max_epi32(hi, _mm256_shuffle_epi32(hi, _MM_SHUFFLE(2,3,0,1)));
+
+            // pack the pairs back into frame order
+            __m256 packed = _mm256_shuffle_ps(_mm256_castsi256_ps(lo), _mm256_castsi256_ps(hi), _MM_SHUFFLE(2,0,2,0));
+            __m256i peak = _mm256_permute4x64_epi64(_mm256_castps_si256(packed), _MM_SHUFFLE(3,1,2,0));
+
+            __m256i a = _mm256_max_epi32(_mm256_sub_epi32(thresh, peaklog2_AVX2(peak)), zero);
+            _mm256_storeu_si256((__m256i*)&attn[i], a);
+        }
+    }
+
+    // remaining frames, and quad input
+    float* in = const_cast<float*>(input);
+    for (; i < numFrames; i++) {
+        int32_t peak;
+        if (numChannels == 1) {
+            peak = peaklog2(&in[i]);
+        } else if (numChannels == 2) {
+            peak = peaklog2(&in[2*i+0], &in[2*i+1]);
+        } else {
+            peak = peaklog2(&in[4*i+0], &in[4*i+1], &in[4*i+2], &in[4*i+3]);
+        }
+        attn[i] = MAX(threshold - peak, 0);
+    }
+
+    _mm256_zeroupper();
+}
+
+//
+// Convert from log2 domain, in-place (see fixexp2)
+//
+void fixexp2Block_AVX2(int32_t* x, int numFrames) {
+
+    int i = 0;
+    for (; i < numFrames - 7; i += 8) {
+        __m256i u = _mm256_loadu_si256((const __m256i*)&x[i]);
+
+        // split into e and 1.0 - x
+        __m256i e = _mm256_srli_epi32(u, LOG2_FRACBITS);
+        __m256i f = _mm256_andnot_si256(_mm256_slli_epi32(u, LOG2_INTBITS), _mm256_set1_epi32(0x7fffffff));
+
+        // polynomial for exp2(x)
+        __m256i k = _mm256_srli_epi32(f, 31 - EXP2_TABBITS);
+        __m256i c2 = polynomial(exp2Table, f, k);
+
+        // reconstruct result in Q31
+        __m256i result = _mm256_srav_epi32(c2, e);
+
+        // x <= 0 returns 0x7fffffff
+        __m256i unity = _mm256_cmpgt_epi32(_mm256_set1_epi32(1), u);
+        result = _mm256_blendv_epi8(result, _mm256_set1_epi32(0x7fffffff), unity);
+
+        _mm256_storeu_si256((__m256i*)&x[i], result);
+    }
+    for (; i < numFrames; i++) {
+        x[i] = fixexp2(x[i]);
+    }
+
+    _mm256_zeroupper();
+}
+
+//
+// Apply per-frame gain and dither to interleaved input, and convert to 16-bit
+//
+void applyGain_AVX2(const float* input, const float* gain, const float* dither, int16_t* output, int numChannels, int numFrames) {
+
+    int i = 0;
+    if (numChannels == 1) {
+
+        for (; i < numFrames - 7; i += 8) {
+            __m256 g = _mm256_loadu_ps(&gain[i]);
+            __m256 d = _mm256_loadu_ps(&dither[i]);
+            __m256 x = _mm256_add_ps(_mm256_mul_ps(_mm256_loadu_ps(&input[i]), g), d);
+
+            __m256i y = _mm256_cvtps_epi32(x);
+            __m128i out = _mm_packs_epi32(_mm256_castsi256_si128(y), _mm256_extracti128_si256(y, 1));
+            _mm_storeu_si128((__m128i*)&output[i], out);
+        }
+
+    } else if (numChannels == 2) {
+
+        const __m256i spread = _mm256_setr_epi32(0, 0, 1, 1, 2, 2, 3, 3);
+        for (; i < numFrames - 3; i += 4) {
+            __m256 g = _mm256_permutevar8x32_ps(_mm256_castps128_ps256(_mm_loadu_ps(&gain[i])), spread);
+            __m256 d = _mm256_permutevar8x32_ps(_mm256_castps128_ps256(_mm_loadu_ps(&dither[i])), spread);
+            __m256 x = _mm256_add_ps(_mm256_mul_ps(_mm256_loadu_ps(&input[2*i]), g), d);
+
+            __m256i y = _mm256_cvtps_epi32(x);
+            __m128i out = _mm_packs_epi32(_mm256_castsi256_si128(y), _mm256_extracti128_si256(y, 1));
+            _mm_storeu_si128((__m128i*)&output[2*i], out);
+        }
+
+    } else if (numChannels == 4) {
+
+        for (; i < numFrames - 1; i += 2) {
+            __m256 g = _mm256_set_m128(_mm_set1_ps(gain[i+1]), _mm_set1_ps(gain[i]));
+            __m256 d = _mm256_set_m128(_mm_set1_ps(dither[i+1]), _mm_set1_ps(dither[i]));
+            __m256 x = _mm256_add_ps(_mm256_mul_ps(_mm256_loadu_ps(&input[4*i]), g), d);
+
+            __m256i y = _mm256_cvtps_epi32(x);
+            __m128i out = _mm_packs_epi32(_mm256_castsi256_si128(y), _mm256_extracti128_si256(y, 1));
+            _mm_storeu_si128((__m128i*)&output[4*i], out);
+        }
+    }
+
+    for (; i < numFrames; i++) {
+        for (int c = 0; c < numChannels; c++) {
+            float x = input[numChannels*i + c] * gain[i] + dither[i];
+            output[numChannels*i + c] = (int16_t)floatToInt(x);
+        }
+    }
+
+    _mm256_zeroupper();
+}
+
+#endif
@@ -0,0 +1,134 @@
+//
+//  BakeCache.cpp
+//  libraries/baking/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "BakeCache.h"
+
+#include <mutex>
+
+#include <QtCore/QCryptographicHash>
+#include <QtCore/QDataStream>
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtCore/QStandardPaths>
+
+#include <NumericalConstants.h>
+
+#include "ModelBakingLoggingCategory.h"
+
+const uint32_t BakeCache::CURRENT_VERSION = 2;
+
+static const uint32_t BAKE_CACHE_MAGIC = 0x454b4142; // "BAKE"
+static const std::string BAKE_CACHE_DIRNAME { "bake_cache" };
+static const std::string BAKE_CACHE_EXT { "bake" };
+static const size_t BAKE_CACHE_MAX_SIZE { GB_TO_BYTES(2) };
+
+static std::mutex instanceMutex;
+static BakeCachePointer instance;
+static bool isEnabled { true };
+
+std::string BakeCache::getSharedDirectory() {
+    // the per-application data paths differ between the oven and the assignment-client,
+    // so the cache goes one level up, next to them
+    QDir dir(QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation));
+    return dir.absoluteFilePath(QString("High Fidelity/") + BAKE_CACHE_DIRNAME.c_str()).toStdString();
+}
+
+BakeCachePointer BakeCache::getInstance() {
+    std::lock_guard<std::mutex> lock(instanceMutex);
+    if (!isEnabled) {
+        return BakeCachePointer();
+    }
+    if (!instance) {
+        instance = std::make_shared<BakeCache>(getSharedDirectory());
+        instance->initialize();
+    }
+    return instance;
+}
+
+void BakeCache::setEnabled(bool enabled) {
+    std::lock_guard<std::mutex> lock(instanceMutex);
+    isEnabled = enabled;
+    if (!enabled) {
+        instance.reset();
+    }
+}
+
+BakeCache::Key BakeCache::computeKey(const QString& bakerType, const QByteArray& source, const QByteArray& options) {
+    QCryptographicHash hash(QCryptographicHash::Md5);
+    hash.addData(reinterpret_cast<const char*>(&CURRENT_VERSION), sizeof(CURRENT_VERSION));
+    hash.addData(bakerType.toUtf8());
+    hash.addData(options);
+    hash.addData(source);
+    return hash.result().toHex().toStdString();
+}
+
+BakeCache::BakeCache(const std::string& dirname) :
+    FileCache(dirname, BAKE_CACHE_EXT) {
+    setMaxSize(BAKE_CACHE_MAX_SIZE);
+    // the directory is shared by the ovens of several processes
+    setSharedDirectory(true);
+}
+
+bool BakeCache::readResult(const Key& key, Result& result) {
+    auto file = getFile(key);
+    if (!file) {
+        ++_numMisses;
+        return false;
+    }
+    QFile input(file->getFilepath().c_str());
+    if (!input.open(QIODevice::ReadOnly)) {
+        ++_numMisses;
+        return false;
+    }
+
+    QDataStream in(&input);
+    uint32_t magic;
+    uint32_t version;
+    QByteArray checksum;
+    QByteArray payload;
+    in >> magic >> version >> checksum >> payload;
+    if (in.status() != QDataStream::Ok || magic != BAKE_CACHE_MAGIC || version != CURRENT_VERSION) {
+        ++_numMisses;
+        return false;
+    }
+    Result contents;
+    if (QCryptographicHash::hash(payload, QCryptographicHash::Md5) == checksum) {
+        QDataStream payloadIn(payload);
+        payloadIn >> contents;
+        if (payloadIn.status() != QDataStream::Ok) {
+            contents.clear();
+        }
+    }
+    if (contents.isEmpty()) {
+        qCWarning(model_baking) << "BakeCache: could not read" << key.c_str();
+        ++_numMisses;
+        return false;
+    }
+
+    result = contents;
+    ++_numHits;
+    return true;
+}
+
+void BakeCache::writeResult(const Key& key, const Result& result) {
+    QByteArray payload;
+    {
+        QDataStream out(&payload, QIODevice::WriteOnly);
+        out << result;
+    }
+    QByteArray contents;
+    {
+        QDataStream out(&contents, QIODevice::WriteOnly);
+        out << BAKE_CACHE_MAGIC << CURRENT_VERSION << QCryptographicHash::hash(payload, QCryptographicHash::Md5) << payload;
+    }
+    // overwrite, since an existing entry we get here for is stale or unreadable
+    size_t length = contents.size();
+    writeFileAsync(std::move(contents), Metadata(key, length), true);
+}
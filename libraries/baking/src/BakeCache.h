@@ -0,0 +1,66 @@
+//
+//  BakeCache.h
+//  libraries/baking/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_BakeCache_h
+#define hifi_BakeCache_h
+
+#include <atomic>
+#include <memory>
+
+#include <QtCore/QByteArray>
+#include <QtCore/QPair>
+#include <QtCore/QString>
+#include <QtCore/QVector>
+
+#include <shared/FileCache.h>
+
+class BakeCache;
+using BakeCachePointer = std::shared_ptr<BakeCache>;
+
+// An on-disk cache of bake results, keyed by the content of what was baked rather than its URL, so that content that
+// shows up under many paths, in many models or in many domains is only baked once.
+//
+// The directory is shared by every oven and asset-server process on the machine. Entries are written atomically and
+// checksummed, and the least recently used ones are evicted once the whole directory is past the size limit.
+class BakeCache : public cache::FileCache {
+    Q_OBJECT
+
+public:
+    // Whenever what a baker produces changes, this value should be incremented, so that older results are re-baked.
+    static const uint32_t CURRENT_VERSION;
+
+    // A bake result is a list of named blobs, whose names and contents are up to the baker.
+    using Result = QVector<QPair<QString, QByteArray>>;
+
+    // a directory common to the oven and the servers on this machine
+    static std::string getSharedDirectory();
+
+    /// The shared cache, or null if caching was disabled.
+    static BakeCachePointer getInstance();
+    static void setEnabled(bool enabled);
+
+    /// A key for what a type of baker makes of some source content, with the given options.
+    static Key computeKey(const QString& bakerType, const QByteArray& source, const QByteArray& options);
+
+    BakeCache(const std::string& dirname);
+
+    /// Thread-safe, returns whether the result was found.
+    bool readResult(const Key& key, Result& result);
+    void writeResult(const Key& key, const Result& result);
+
+    uint32_t getNumHits() const { return _numHits; }
+    uint32_t getNumMisses() const { return _numMisses; }
+
+private:
+    std::atomic<uint32_t> _numHits { 0 };
+    std::atomic<uint32_t> _numMisses { 0 };
+};
+
+#endif // hifi_BakeCache_h
@@ -22,6 +22,7 @@
 #include <model-baker/PrepareJointsTask.h>
 
 #include <FBXWriter.h>
+#include <HFMBlobWriter.h>
 #include <FSTReader.h>
 
 #ifdef _WIN32
@@ -57,6 +58,7 @@ ModelBaker::ModelBaker(const QUrl& inputModelURL, const QString& bakedOutputDire
         bakedFilename += BAKED_FBX_EXTENSION;
     }
     _bakedModelURL = _bakedOutputDir + "/" + bakedFilename;
+    _bakedBlobURL = _bakedOutputDir + "/" + bakedFilename.left(bakedFilename.lastIndexOf('.')) + HFM_EXTENSION;
 }
 
 void ModelBaker::setOutputURLSuffix(const QUrl& outputURLSuffix) {
@@ -408,7 +410,9 @@ void ModelBaker::outputBakedFST() {
 
     auto outputMapping = _mapping;
     outputMapping[FST_VERSION_FIELD] = FST_VERSION;
+    // the baked FBX stays the model file, for older clients and rebaking, while newer clients load the HFM blob instead
     outputMapping[FILENAME_FIELD] = _bakedModelURL.fileName();
+    outputMapping[HFM_FILENAME_FIELD] = _bakedBlobURL.fileName();
     outputMapping.remove(TEXDIR_FIELD);
     outputMapping.remove(COMMENT_FIELD);
     if (!_materialMappingJSON.isEmpty()) {
@@ -428,7 +432,9 @@ void ModelBaker::outputBakedFST() {
     _outputFiles.push_back(outputFSTURL);
     _outputMappingURL = outputFSTURL;
 
-    exportScene();
+    if (!exportScene()) {
+        return;
+    }
     qCDebug(model_baking) << "Finished baking, emitting finished" << _modelURL;
     emit finished();
 }
@@ -483,7 +489,7 @@ void ModelBaker::setWasAborted(bool wasAborted) {
     }
 }
 
-void ModelBaker::exportScene() {
+bool ModelBaker::exportScene() {
     auto fbxData = FBXWriter::encodeFBX(_rootNode);
 
     QString bakedModelURL = _bakedModelURL.toString();
@@ -491,13 +497,31 @@ void ModelBaker::exportScene() {
 
     if (!bakedFile.open(QIODevice::WriteOnly)) {
         handleError("Error opening " + bakedModelURL + " for writing");
-        return;
+        return false;
     }
 
-    bakedFile.write(fbxData);
+    if (bakedFile.write(fbxData) != fbxData.size()) {
+        handleError("Error writing to " + bakedModelURL);
+        return false;
+    }
 
     _outputFiles.push_back(bakedModelURL);
 
+    // Also write the baked model as an HFM blob, which loads without parsing the FBX or decoding the Draco meshes.
+    // This is the file the baked FST points at.
+    QString bakedBlobURL = _bakedBlobURL.toString();
+    QFile bakedBlobFile(bakedBlobURL);
+    if (!bakedBlobFile.open(QIODevice::WriteOnly)) {
+        handleError("Error opening " + bakedBlobURL + " for writing");
+        return false;
+    }
+    auto blobData = HFMBlobWriter::encodeHFMBlob(*_hfmModel);
+    if (bakedBlobFile.write(blobData) != blobData.size()) {
+        handleError("Error writing to " + bakedBlobURL);
+        return false;
+    }
+    _outputFiles.push_back(bakedBlobURL);
+
 #ifdef HIFI_DUMP_FBX
     {
         FBXToJSON fbxToJSON;
@@ -513,4 +537,5 @@ void ModelBaker::exportScene() {
 #endif
 
     qCDebug(model_baking) << "Exported" << _modelURL << "with re-written paths to" << bakedModelURL;
+    return true;
 }
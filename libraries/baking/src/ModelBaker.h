@@ -32,6 +32,7 @@ static const QString FST_EXTENSION { ".fst" };
 static const QString BAKED_FST_EXTENSION { ".baked.fst" };
 static const QString FBX_EXTENSION { ".fbx" };
 static const QString BAKED_FBX_EXTENSION { ".baked.fbx" };
+static const QString HFM_EXTENSION { ".hfm" };
 static const QString OBJ_EXTENSION { ".obj" };
 static const QString GLTF_EXTENSION { ".gltf" };
 
@@ -65,7 +66,7 @@ public slots:
 protected:
     void saveSourceModel();
     virtual void bakeProcessedSource(const hfm::Model::Pointer& hfmModel, const std::vector<hifi::ByteArray>& dracoMeshes, const std::vector<std::vector<hifi::ByteArray>>& dracoMaterialLists) = 0;
-    void exportScene();
+    bool exportScene();
 
     FBXNode _rootNode;
     QUrl _originalInputModelURL;
@@ -78,6 +79,7 @@ protected:
     QString _originalOutputModelPath;
     QString _outputMappingURL;
     QUrl _bakedModelURL;
+    QUrl _bakedBlobURL;
 
 protected slots:
     void handleModelNetworkReply();
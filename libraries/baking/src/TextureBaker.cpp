@@ -30,6 +30,10 @@ const QString BAKED_TEXTURE_KTX_EXT = ".ktx";
 const QString BAKED_TEXTURE_BCN_SUFFIX = "_bcn.ktx";
 const QString BAKED_META_TEXTURE_SUFFIX = ".texmeta.json";
 
+static const QString TEXTURE_BAKE_CACHE_TYPE = "texture";
+// the name of the uncompressed texture in a bake cache result, the compressed ones are named by their internal format
+static const QString BAKED_TEXTURE_UNCOMPRESSED_NAME = "uncompressed";
+
 bool TextureBaker::_compressionEnabled = true;
 
 TextureBaker::TextureBaker(const QUrl& textureURL, image::TextureUsage::Type textureType,
@@ -153,11 +157,68 @@ void TextureBaker::processTexture() {
         meta.original = _originalCopyFilePath.fileName();
     }
 
+    // The same texture is often used by many models, so the processed textures are looked up in the bake cache,
+    // keyed by what the hash above already covers and by the options they're baked with
+    auto bakeCache = BakeCache::getInstance();
+    BakeCache::Key cacheKey;
+    BakeCache::Result bakedTextures;
+    bool isCached = false;
+    if (bakeCache) {
+        cacheKey = BakeCache::computeKey(TEXTURE_BAKE_CACHE_TYPE, hashData, QByteArray::number((int)_compressionEnabled));
+        isCached = bakeCache->readResult(cacheKey, bakedTextures);
+    }
+
+    if (!isCached && !processOriginalTexture(originalCopyFilePath, hash, bakedTextures)) {
+        return;
+    }
+
+    for (const auto& bakedTexture : bakedTextures) {
+        QString fileName;
+        if (bakedTexture.first == BAKED_TEXTURE_UNCOMPRESSED_NAME) {
+            fileName = _baseFilename + BAKED_TEXTURE_KTX_EXT;
+            meta.uncompressed = fileName;
+        } else {
+            auto format = (khronos::gl::texture::InternalFormat)bakedTexture.first.toUInt();
+            fileName = _baseFilename + "_" + khronos::gl::texture::toString(format) + BAKED_TEXTURE_KTX_EXT;
+            meta.availableTextureTypes[format] = fileName;
+        }
+
+        auto filePath = _outputDirectory.absoluteFilePath(fileName);
+        QFile bakedTextureFile { filePath };
+        if (!bakedTextureFile.open(QIODevice::WriteOnly) || bakedTextureFile.write(bakedTexture.second) == -1) {
+            handleError("Could not write baked texture for " + _textureURL.toString());
+            return;
+        }
+        _outputFiles.push_back(filePath);
+    }
+
+    if (bakeCache && !isCached) {
+        bakeCache->writeResult(cacheKey, bakedTextures);
+    }
+
+    {
+        auto data = meta.serialize();
+        _metaTextureFileName = _outputDirectory.absoluteFilePath(_baseFilename + BAKED_META_TEXTURE_SUFFIX);
+        QFile file { _metaTextureFileName };
+        if (!file.open(QIODevice::WriteOnly) || file.write(data) == -1) {
+            handleError("Could not write meta texture for " + _textureURL.toString());
+            return;
+        } else {
+            _outputFiles.push_back(_metaTextureFileName);
+        }
+    }
+
+    qCDebug(model_baking) << "Baked texture" << _textureURL;
+    setIsFinished(true);
+}
+
+bool TextureBaker::processOriginalTexture(const QString& originalCopyFilePath, const std::string& hash,
+                                          BakeCache::Result& bakedTextures) {
     // Load the copy of the original file from the baked output directory. New images will be created using the original as the source data.
     auto buffer = std::static_pointer_cast<QIODevice>(std::make_shared<QFile>(originalCopyFilePath));
     if (!buffer->open(QIODevice::ReadOnly)) {
         handleError("Could not open original file at " + originalCopyFilePath);
-        return;
+        return false;
     }
 
     // Compressed KTX
@@ -172,38 +233,29 @@ void TextureBaker::processTexture() {
                                                         target, _abortProcessing);
             if (!processedTexture) {
                 handleError("Could not process texture " + _textureURL.toString());
-                return;
+                return false;
             }
             processedTexture->setSourceHash(hash);
 
             if (shouldStop()) {
-                return;
+                return false;
             }
 
             auto memKTX = gpu::Texture::serialize(*processedTexture);
             if (!memKTX) {
                 handleError("Could not serialize " + _textureURL.toString() + " to KTX");
-                return;
+                return false;
             }
 
-            const char* name = khronos::gl::texture::toString(memKTX->_header.getGLInternaFormat());
-            if (name == nullptr) {
+            auto format = memKTX->_header.getGLInternaFormat();
+            if (khronos::gl::texture::toString(format) == nullptr) {
                 handleError("Could not determine internal format for compressed KTX: " + _textureURL.toString());
-                return;
+                return false;
             }
 
             const char* data = reinterpret_cast<const char*>(memKTX->_storage->data());
             const size_t length = memKTX->_storage->size();
-
-            auto fileName = _baseFilename + "_" + name + ".ktx";
-            auto filePath = _outputDirectory.absoluteFilePath(fileName);
-            QFile bakedTextureFile { filePath };
-            if (!bakedTextureFile.open(QIODevice::WriteOnly) || bakedTextureFile.write(data, length) == -1) {
-                handleError("Could not write baked texture for " + _textureURL.toString());
-                return;
-            }
-            _outputFiles.push_back(filePath);
-            meta.availableTextureTypes[memKTX->_header.getGLInternaFormat()] = fileName;
+            bakedTextures.push_back({ QString::number((uint32_t)format), QByteArray(data, (int)length) });
         }
     }
 
@@ -214,50 +266,25 @@ void TextureBaker::processTexture() {
                                                     ABSOLUTE_MAX_TEXTURE_NUM_PIXELS, _textureType, false, gpu::BackendTarget::GL45, _abortProcessing);
         if (!processedTexture) {
             handleError("Could not process texture " + _textureURL.toString());
-            return;
+            return false;
         }
         processedTexture->setSourceHash(hash);
 
         if (shouldStop()) {
-            return;
+            return false;
         }
 
         auto memKTX = gpu::Texture::serialize(*processedTexture);
         if (!memKTX) {
             handleError("Could not serialize " + _textureURL.toString() + " to KTX");
-            return;
+            return false;
         }
 
         const char* data = reinterpret_cast<const char*>(memKTX->_storage->data());
         const size_t length = memKTX->_storage->size();
-
-        auto fileName = _baseFilename + ".ktx";
-        auto filePath = _outputDirectory.absoluteFilePath(fileName);
-        QFile bakedTextureFile { filePath };
-        if (!bakedTextureFile.open(QIODevice::WriteOnly) || bakedTextureFile.write(data, length) == -1) {
-            handleError("Could not write baked texture for " + _textureURL.toString());
-            return;
-        }
-        _outputFiles.push_back(filePath);
-        meta.uncompressed = fileName;
-    } else {
-        buffer.reset();
-    }
-
-    {
-        auto data = meta.serialize();
-        _metaTextureFileName = _outputDirectory.absoluteFilePath(_baseFilename + BAKED_META_TEXTURE_SUFFIX);
-        QFile file { _metaTextureFileName };
-        if (!file.open(QIODevice::WriteOnly) || file.write(data) == -1) {
-            handleError("Could not write meta texture for " + _textureURL.toString());
-            return;
-        } else {
-            _outputFiles.push_back(_metaTextureFileName);
-        }
+        bakedTextures.push_back({ BAKED_TEXTURE_UNCOMPRESSED_NAME, QByteArray(data, (int)length) });
     }
-
-    qCDebug(model_baking) << "Baked texture" << _textureURL;
-    setIsFinished(true);
+    return true;
 }
 
 void TextureBaker::setWasAborted(bool wasAborted) {
@@ -20,6 +20,7 @@
 
 #include <image/TextureProcessing.h>
 
+#include "BakeCache.h"
 #include "Baker.h"
 
 #include <material-networking/MaterialCache.h>
@@ -64,6 +65,8 @@ private slots:
 private:
     void loadTexture();
     void handleTextureNetworkReply();
+    bool processOriginalTexture(const QString& originalCopyFilePath, const std::string& hash,
+                                BakeCache::Result& bakedTextures);
 
     QUrl _textureURL;
     QByteArray _originalTexture;
@@ -416,6 +416,9 @@ bool EntityTree::updateEntity(EntityItemPointer entity, const EntityItemProperti
                         }
                     }
                     if (!simulationBlocked) {
+                        if (entity->getSimulatorID() != senderID) {
+                            _totalSimulationOwnerChanges++;
+                        }
                         entity->setSimulationOwnershipExpiry(usecTimestampNow() + MAX_INCOMING_SIMULATION_UPDATE_PERIOD);
                     }
                 } else {
@@ -3065,6 +3068,24 @@ bool EntityTree::writeToJSON(QString& jsonString, const OctreeElementPointer& el
     return true;
 }
 
+bool EntityTree::writeToJSON(QIODevice& output, const OctreeElementPointer& element) {
+    // the lock is only held while the entities' properties are copied, in a single pass, so the output is a consistent
+    // snapshot of the tree; they're stringified and written (which may be compressing, or writing to disk) after it's
+    // released, a chunk at a time
+    const int JSON_CHUNK_BYTES = 256 * 1024;
+    QScriptEngine scriptEngine;
+    RecurseOctreeToJSONOperator theOperator(element, &scriptEngine, &output);
+    withReadLock([&] {
+        recurseTreeWithOperator(&theOperator);
+    });
+    while (theOperator.hasPendingEntities()) {
+        theOperator.stringifyChunk(JSON_CHUNK_BYTES);
+        theOperator.writeChunk();
+    }
+
+    return !theOperator.hasWriteError();
+}
+
 void EntityTree::resetClientEditStats() {
     _treeResetTime = usecTimestampNow();
     _maxEditDelta = 0;
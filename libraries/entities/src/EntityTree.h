@@ -12,6 +12,8 @@
 #ifndef hifi_EntityTree_h
 #define hifi_EntityTree_h
 
+#include <atomic>
+
 #include <QSet>
 #include <QVector>
 
@@ -195,6 +197,7 @@ public:
                             bool skipThoseWithBadParents) override;
     virtual bool readFromMap(QVariantMap& entityDescription) override;
     virtual bool writeToJSON(QString& jsonString, const OctreeElementPointer& element) override;
+    virtual bool writeToJSON(QIODevice& output, const OctreeElementPointer& element) override;
 
 
     glm::vec3 getContentsDimensions();
@@ -226,6 +229,9 @@ public:
     quint64 getMaxEditDelta() const { return _maxEditDelta; }
     quint64 getTotalTrackedEdits() const { return _totalTrackedEdits; }
 
+    // how many times the server has handed an entity's simulation to a different owner
+    int getTotalSimulationOwnerChanges() const { return _totalSimulationOwnerChanges; }
+
     EntityTreePointer getThisPointer() { return std::static_pointer_cast<EntityTree>(shared_from_this()); }
 
     bool isDeletedEntity(const QUuid& id) {
@@ -345,6 +351,7 @@ protected:
     quint64 _totalCreateTime = 0;
     quint64 _totalLoggingTime = 0;
     quint64 _totalFilterTime = 0;
+    std::atomic<int> _totalSimulationOwnerChanges { 0 };
 
     // these performance statistics are only used in the client
     void resetClientEditStats();
@@ -22,29 +22,67 @@ RecurseOctreeToJSONOperator::RecurseOctreeToJSONOperator(const OctreeElementPoin
     _toStringMethod = _engine->evaluate("(function() { return JSON.stringify(this, null, '    ') })");
 }
 
+RecurseOctreeToJSONOperator::RecurseOctreeToJSONOperator(const OctreeElementPointer& top, QScriptEngine* engine,
+    QIODevice* output, bool skipDefaults, bool skipThoseWithBadParents) :
+    RecurseOctreeToJSONOperator(top, engine, QString(), skipDefaults, skipThoseWithBadParents)
+{
+    _output = output;
+}
+
 bool RecurseOctreeToJSONOperator::postRecursion(const OctreeElementPointer& element) {
     EntityTreeElementPointer entityTreeElement = std::static_pointer_cast<EntityTreeElement>(element);
 
-    entityTreeElement->forEachEntity([&](const EntityItemPointer& entity) { processEntity(entity); } );
+    entityTreeElement->forEachEntity([&](const EntityItemPointer& entity) { processEntity(entity); });
     return true;
 }
 
+void RecurseOctreeToJSONOperator::stringifyChunk(int maxBytes) {
+    while (_nextEntity < _entities.size() && _chunk.size() < maxBytes && !_writeError) {
+        // release each copy as it's done with, so that they aren't all held until the end
+        EntityItemProperties properties = std::move(_entities[_nextEntity++]);
+        processProperties(properties);
+    }
+}
+
+bool RecurseOctreeToJSONOperator::writeChunk() {
+    if (!_writeError && !_chunk.isEmpty()) {
+        _writeError = (_output->write(_chunk) == -1);
+    }
+    _chunk.clear();
+    return !_writeError;
+}
+
 void RecurseOctreeToJSONOperator::processEntity(const EntityItemPointer& entity) {
     if (_skipThoseWithBadParents && !entity->isParentIDValid()) {
         return;  // we weren't able to resolve a parent from _parentID, so don't save this entity.
     }
 
+    if (_output) {
+        _entities.push_back(entity->getProperties());  // stringified later, outside of the tree's lock
+    } else {
+        processProperties(entity->getProperties());
+    }
+}
+
+void RecurseOctreeToJSONOperator::processProperties(const EntityItemProperties& properties) {
     QScriptValue qScriptValues = _skipDefaults
-        ? EntityItemNonDefaultPropertiesToScriptValue(_engine, entity->getProperties())
-        : EntityItemPropertiesToScriptValue(_engine, entity->getProperties());
+        ? EntityItemNonDefaultPropertiesToScriptValue(_engine, properties)
+        : EntityItemPropertiesToScriptValue(_engine, properties);
+
+    // Override default toString():
+    qScriptValues.setProperty("toString", _toStringMethod);
+
+    if (_output) {
+        _chunk += (_comma ? ",\n    " : "\n    ");
+        _chunk += qScriptValues.toString().toUtf8();
+        _comma = true;
+        return;
+    }
 
     if (_comma) {
         _json += ',';
     };
     _comma = true;
     _json += "\n    ";
-
-    // Override default toString():
-    qScriptValues.setProperty("toString", _toStringMethod);
     _json += qScriptValues.toString();
 }
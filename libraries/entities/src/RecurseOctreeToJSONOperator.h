@@ -10,23 +10,40 @@
 //
 
 #include "EntityTree.h"
+#include "EntityItemProperties.h"
 
 class RecurseOctreeToJSONOperator : public RecurseOctreeOperator {
 public:
     RecurseOctreeToJSONOperator(const OctreeElementPointer&, QScriptEngine* engine, QString jsonPrefix = QString(), bool skipDefaults = true,
         bool skipThoseWithBadParents = false);
+    // writes the entities' JSON (as UTF-8) to output a chunk at a time, rather than collecting it. The recursion, under
+    // the tree's read lock, only copies the entities' properties, so that the output is a snapshot of the tree as it was
+    // at that point; each chunk is then built with stringifyChunk() and written with writeChunk(), outside of the lock
+    RecurseOctreeToJSONOperator(const OctreeElementPointer&, QScriptEngine* engine, QIODevice* output, bool skipDefaults = true,
+        bool skipThoseWithBadParents = false);
     virtual bool preRecursion(const OctreeElementPointer& element) override { return true; };
     virtual bool postRecursion(const OctreeElementPointer& element) override;
 
     QString getJson() const { return _json; }
+    bool hasWriteError() const { return _writeError; }
+
+    bool hasPendingEntities() const { return _nextEntity < _entities.size() && !_writeError; }
+    void stringifyChunk(int maxBytes);
+    bool writeChunk();
 
 private:
     void processEntity(const EntityItemPointer& entity);
+    void processProperties(const EntityItemProperties& properties);
 
     QScriptEngine* _engine;
     QScriptValue _toStringMethod;
 
     QString _json;
+    QIODevice* _output { nullptr };
+    std::vector<EntityItemProperties> _entities;
+    size_t _nextEntity { 0 };
+    QByteArray _chunk;
+    bool _writeError { false };
     const bool _skipDefaults;
     bool _skipThoseWithBadParents;
     bool _comma { false };
@@ -89,11 +89,16 @@
 //    (14) When an entity's ownership priority drops to YIELD (=1, below VOLUNTEER) other participants may
 //         bid for it immediately at VOLUNTEER.
 //
+//    (15) A headless physics host (the entity-script-server, when enabled) volunteers at HOST (=RECRUIT + 1)
+//         rather than VOLUNTEER.  It therefore takes over active objects that participants merely volunteered
+//         for, and keeps them while nobody interacts with them, but loses them to any POKE or GRAB bid.
+//
 /* These declarations temporarily moved to SimulationFlags.h while we unravel some spaghetti dependencies.
  * The intent is to move them back here once the dust settles.
 const uint8_t YIELD_SIMULATION_PRIORITY = 1;
 const uint8_t VOLUNTEER_SIMULATION_PRIORITY = YIELD_SIMULATION_PRIORITY + 1;
 const uint8_t RECRUIT_SIMULATION_PRIORITY = VOLUNTEER_SIMULATION_PRIORITY + 1;
+const uint8_t HOST_SIMULATION_PRIORITY = RECRUIT_SIMULATION_PRIORITY + 1;
 
 // When poking objects with scripts an observer will bid at SCRIPT_EDIT priority.
 const uint8_t SCRIPT_GRAB_SIMULATION_PRIORITY = 128;
@@ -11,12 +11,12 @@
 
 #include "FBXSerializer.h"
 
-#include <QBuffer>
-
 #include <glm/gtc/quaternion.hpp>
 #include <glm/gtx/quaternion.hpp>
 #include <glm/gtx/transform.hpp>
 
+#include <QtCore/QFile>
+
 #include <FaceshiftConstants.h>
 
 #include <hfm/ModelFormatLogging.h>
@@ -1668,12 +1668,33 @@ std::unique_ptr<hfm::Serializer::Factory> FBXSerializer::getFactory() const {
 }
 
 HFMModel::Pointer FBXSerializer::read(const hifi::ByteArray& data, const hifi::VariantHash& mapping, const hifi::URL& url) {
-    QBuffer buffer(const_cast<hifi::ByteArray*>(&data));
-    buffer.open(QIODevice::ReadOnly);
-
-    _rootNode = parseFBX(&buffer);
+    _rootNode = parseFBX(data);
 
     // FBXSerializer's mapping parameter supports the bool "deduplicateIndices," which is passed into FBXSerializer::extractMesh as "deduplicate"
 
     return HFMModel::Pointer(extractHFMModel(mapping, url.toString()));
 }
+
+HFMModel::Pointer FBXSerializer::readFile(const QString& path, const hifi::VariantHash& mapping) {
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        throw QString("Could not open ") + path;
+    }
+
+    // The node tree copies everything it keeps out of the mapping, so it can be unmapped as soon as it is read
+    qint64 size = file.size();
+    uchar* mapped = file.map(0, size);
+    if (!mapped) {
+        return FBXSerializer().read(file.readAll(), mapping, hifi::URL::fromLocalFile(path));
+    }
+    auto data = hifi::ByteArray::fromRawData((const char*)mapped, (int)size);
+    HFMModel::Pointer model;
+    try {
+        model = FBXSerializer().read(data, mapping, hifi::URL::fromLocalFile(path));
+    } catch (const QString&) {
+        file.unmap(mapped);
+        throw;
+    }
+    file.unmap(mapped);
+    return model;
+}
@@ -113,9 +113,13 @@ public:
     /// Reads HFMModel from the supplied model and mapping data.
     /// \exception QString if an error occurs in parsing
     HFMModel::Pointer read(const hifi::ByteArray& data, const hifi::VariantHash& mapping, const hifi::URL& url = hifi::URL()) override;
+    /// Reads HFMModel from a local file, parsing it in place from a mapping of the file rather than a copy of it.
+    /// \exception QString if an error occurs in parsing
+    static HFMModel::Pointer readFile(const QString& path, const hifi::VariantHash& mapping = hifi::VariantHash());
 
     FBXNode _rootNode;
     static FBXNode parseFBX(QIODevice* device);
+    static FBXNode parseFBX(const hifi::ByteArray& data);
 
     HFMModel* extractHFMModel(const hifi::VariantHash& mapping, const QString& url);
 
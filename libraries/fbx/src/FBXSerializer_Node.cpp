@@ -11,215 +11,224 @@
 
 #include "FBXSerializer.h"
 
-#include <iostream>
-#include <QtCore/QBuffer>
-#include <QtCore/QDataStream>
+#include <algorithm>
+#include <atomic>
+#include <vector>
+
 #include <QtCore/QIODevice>
 #include <QtCore/QStringList>
 #include <QtCore/QTextStream>
 #include <QtCore/QDebug>
 #include <QtCore/QtEndian>
 #include <QtCore/QFileInfo>
+#include <QtCore/QVector>
+
+#include <tbb/parallel_for.h>
+#include <zlib.h>
 
 #include <shared/NsightHelpers.h>
 #include <hfm/ModelFormatLogging.h>
 
+namespace {
+
+// Above this many bytes of compressed arrays, they are inflated in parallel.
+const quint64 MIN_PARALLEL_INFLATE_BYTES = 256 * 1024;
+
+// Swaps the little-endian array elements of a file into host order, where they differ.
+void toHostByteOrder(char* data, quint64 size, int elementSize) {
+#if Q_BYTE_ORDER == Q_BIG_ENDIAN
+    if (elementSize > 1) {
+        for (char* element = data, *end = data + size; element < end; element += elementSize) {
+            std::reverse(element, element + elementSize);
+        }
+    }
+#else
+    Q_UNUSED(data);
+    Q_UNUSED(size);
+    Q_UNUSED(elementSize);
+#endif
+}
+
+// QVector(int) zero-fills its elements, which for an array that is about to be overwritten in full is a wasted pass
+// over as much memory as the model's geometry, so array storage is allocated without being initialized.
+// T must be a plain old data type.
 template<class T>
-int streamSize() {
-    return sizeof(T);
+QVector<T> allocateArray(int size) {
+    if (size == 0) {
+        return QVector<T>();
+    }
+    QTypedArrayData<T>* data = QTypedArrayData<T>::allocate(size);
+    Q_CHECK_PTR(data);
+    data->size = size;
+    return QVector<T>(QArrayDataPointerRef<T> { data });
+}
+
 }
 
-template<bool>
-int streamSize() {
-    return 1;
+// Reads a binary FBX document straight out of its bytes, rather than value by value through a QDataStream.
+//
+// Each array property is allocated, uninitialized, at its final size in the QVector that ends up in the node, and
+// uncompressed arrays are copied into it directly. Compressed arrays are inflated into their vectors once the whole tree has
+// been read, all of them together, so a large model's arrays are inflated on several threads.
+class BinaryFBXParser {
+public:
+    BinaryFBXParser(const hifi::ByteArray& data) :
+        _begin(data.constData()), _end(data.constData() + data.size()), _position(data.constData()) {}
+
+    FBXNode parse();
+
+private:
+    struct InflateJob {
+        const char* source;
+        quint32 sourceSize;
+        // points into the uninitialized storage of a QVector held by a node property, which is only shared,
+        // never detached, until the arrays have been inflated
+        char* destination;
+        quint64 destinationSize;
+        int elementSize;
+    };
+
+    quint64 getOffset() const { return (quint64)(_position - _begin); }
+    const char* readBytes(quint64 size);
+    template<class T> T read();
+    float readFloat();
+    double readDouble();
+
+    FBXNode parseNode();
+    QVariant parseProperty();
+    template<class T> QVariant parseArray();
+    void inflateArrays();
+
+    const char* _begin;
+    const char* _end;
+    const char* _position;
+    bool _has64BitPositions { false };
+    std::vector<InflateJob> _inflateJobs;
+    quint64 _inflateBytes { 0 };
+};
+
+const char* BinaryFBXParser::readBytes(quint64 size) {
+    if (size > (quint64)(_end - _position)) {
+        throw QString("FBX file most likely corrupt: unexpected end of data");
+    }
+    const char* bytes = _position;
+    _position += size;
+    return bytes;
 }
 
 template<class T>
-QVariant readBinaryArray(QDataStream& in, int& position) {
-    quint32 arrayLength;
-    quint32 encoding;
-    quint32 compressedLength;
+T BinaryFBXParser::read() {
+    return qFromLittleEndian<T>(reinterpret_cast<const uchar*>(readBytes(sizeof(T))));
+}
+
+float BinaryFBXParser::readFloat() {
+    quint32 bits = read<quint32>();
+    float value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
 
-    in >> arrayLength;
+double BinaryFBXParser::readDouble() {
+    quint64 bits = read<quint64>();
+    double value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+template<class T>
+QVariant BinaryFBXParser::parseArray() {
+    quint32 arrayLength = read<quint32>();
     if (arrayLength > std::numeric_limits<int>::max() / sizeof(T)) { // Upcoming byte containers are limited to max signed int
         throw QString("FBX file most likely corrupt: binary data exceeds data limits");
     }
-    in >> encoding;
-    in >> compressedLength;
+    quint32 encoding = read<quint32>();
+    quint32 compressedLength = read<quint32>();
     if (compressedLength > std::numeric_limits<int>::max() / sizeof(T)) { // Upcoming byte containers are limited to max signed int
         throw QString("FBX file most likely corrupt: compressed binary data exceeds data limits");
     }
-    position += sizeof(quint32) * 3;
-
-    QVector<T> values;
-    if ((int)QSysInfo::ByteOrder == (int)in.byteOrder()) {
-        values.resize(arrayLength);
-        hifi::ByteArray arrayData;
-        if (encoding == FBX_PROPERTY_COMPRESSED_FLAG) {
-            // preface encoded data with uncompressed length
-            hifi::ByteArray compressed(sizeof(quint32) + compressedLength, 0);
-            *((quint32*)compressed.data()) = qToBigEndian<quint32>(arrayLength * sizeof(T));
-            in.readRawData(compressed.data() + sizeof(quint32), compressedLength);
-            position += compressedLength;
-            arrayData = qUncompress(compressed);
-            if (arrayData.isEmpty() ||
-                (unsigned int)arrayData.size() != (sizeof(T) * arrayLength)) { // answers empty byte array if corrupt
-                throw QString("corrupt fbx file");
-            }
-        } else {
-            arrayData.resize(sizeof(T) * arrayLength);
-            position += sizeof(T) * arrayLength;
-            in.readRawData(arrayData.data(), arrayData.size());
-        }
 
-        if (arrayData.size() > 0) {
-            memcpy(&values[0], arrayData.constData(), arrayData.size());
-        }
-    } else {
-        values.reserve(arrayLength);
-        if (encoding == FBX_PROPERTY_COMPRESSED_FLAG) {
-            // preface encoded data with uncompressed length
-            hifi::ByteArray compressed(sizeof(quint32) + compressedLength, 0);
-            *((quint32*)compressed.data()) = qToBigEndian<quint32>(arrayLength * sizeof(T));
-            in.readRawData(compressed.data() + sizeof(quint32), compressedLength);
-            position += compressedLength;
-            hifi::ByteArray uncompressed = qUncompress(compressed);
-            if (uncompressed.isEmpty()) { // answers empty byte array if corrupt
-                throw QString("corrupt fbx file");
-            }
-            QDataStream uncompressedIn(uncompressed);
-            uncompressedIn.setByteOrder(QDataStream::LittleEndian);
-            uncompressedIn.setVersion(QDataStream::Qt_4_5); // for single/double precision switch
-            for (quint32 i = 0; i < arrayLength; i++) {
-                T value;
-                uncompressedIn >> value;
-                values.append(value);
-            }
-        } else {
-            for (quint32 i = 0; i < arrayLength; i++) {
-                T value;
-                in >> value;
-                position += streamSize<T>();
-                values.append(value);
-            }
+    QVector<T> values = allocateArray<T>((int)arrayLength);
+    quint64 size = (quint64)arrayLength * sizeof(T);
+    char* destination = reinterpret_cast<char*>(values.data());
+    if (encoding == FBX_PROPERTY_COMPRESSED_FLAG) {
+        const char* source = readBytes(compressedLength);
+        if (size > 0) {
+            _inflateJobs.push_back({ source, compressedLength, destination, size, (int)sizeof(T) });
+            _inflateBytes += compressedLength;
         }
+    } else if (size > 0) {
+        memcpy(destination, readBytes(size), size);
+        toHostByteOrder(destination, size, sizeof(T));
     }
     return QVariant::fromValue(values);
 }
 
-QVariant parseBinaryFBXProperty(QDataStream& in, int& position) {
-    char ch;
-    in.device()->getChar(&ch);
-    position++;
+QVariant BinaryFBXParser::parseProperty() {
+    char ch = *readBytes(1);
     switch (ch) {
-        case 'Y': {
-            qint16 value;
-            in >> value;
-            position += sizeof(qint16);
-            return QVariant::fromValue(value);
-        }
-        case 'C': {
-            bool value;
-            in >> value;
-            position++;
-            return QVariant::fromValue(value);
-        }
-        case 'I': {
-            qint32 value;
-            in >> value;
-            position += sizeof(qint32);
-            return QVariant::fromValue(value);
-        }
-        case 'F': {
-            float value;
-            in >> value;
-            position += sizeof(float);
-            return QVariant::fromValue(value);
-        }
-        case 'D': {
-            double value;
-            in >> value;
-            position += sizeof(double);
-            return QVariant::fromValue(value);
-        }
-        case 'L': {
-            qint64 value;
-            in >> value;
-            position += sizeof(qint64);
-            return QVariant::fromValue(value);
-        }
-        case 'f': {
-            return readBinaryArray<float>(in, position);
-        }
-        case 'd': {
-            return readBinaryArray<double>(in, position);
-        }
-        case 'l': {
-            return readBinaryArray<qint64>(in, position);
-        }
-        case 'i': {
-            return readBinaryArray<qint32>(in, position);
-        }
-        case 'b': {
-            return readBinaryArray<bool>(in, position);
-        }
+        case 'Y':
+            return QVariant::fromValue(read<qint16>());
+        case 'C':
+            return QVariant::fromValue(read<quint8>() != 0);
+        case 'I':
+            return QVariant::fromValue(read<qint32>());
+        case 'F':
+            return QVariant::fromValue(readFloat());
+        case 'D':
+            return QVariant::fromValue(readDouble());
+        case 'L':
+            return QVariant::fromValue(read<qint64>());
+        case 'f':
+            return parseArray<float>();
+        case 'd':
+            return parseArray<double>();
+        case 'l':
+            return parseArray<qint64>();
+        case 'i':
+            return parseArray<qint32>();
+        case 'b':
+            return parseArray<bool>();
         case 'S':
         case 'R': {
-            quint32 length;
-            in >> length;
-            position += sizeof(quint32) + length;
-            return QVariant::fromValue(in.device()->read(length));
+            quint32 length = read<quint32>();
+            return QVariant::fromValue(hifi::ByteArray(readBytes(length), length));
         }
         default:
             throw QString("Unknown property type: ") + ch;
     }
 }
 
-FBXNode parseBinaryFBXNode(QDataStream& in, int& position, bool has64BitPositions = false) {
-    qint64 endOffset;
+FBXNode BinaryFBXParser::parseNode() {
+    quint64 endOffset;
     quint64 propertyCount;
-    quint64 propertyListLength;
-    quint8 nameLength;
 
     // FBX 2016 and beyond uses 64bit positions in the node headers, pre-2016 used 32bit values
-    // our code generally doesn't care about the size that much, so we will use 64bit values
-    // from here on out, but if the file is an older format we read the stream into temp 32bit 
-    // values and then assign to our actual 64bit values.
-    if (has64BitPositions) {
-        in >> endOffset;
-        in >> propertyCount;
-        in >> propertyListLength;
-        position += sizeof(quint64) * 3;
+    if (_has64BitPositions) {
+        endOffset = read<quint64>();
+        propertyCount = read<quint64>();
+        read<quint64>(); // property list length
     } else {
-        qint32 tempEndOffset;
-        quint32 tempPropertyCount;
-        quint32 tempPropertyListLength;
-        in >> tempEndOffset;
-        in >> tempPropertyCount;
-        in >> tempPropertyListLength;
-        position += sizeof(quint32) * 3;
-        endOffset = tempEndOffset;
-        propertyCount = tempPropertyCount;
-        propertyListLength = tempPropertyListLength;
-    }
-    in >> nameLength;
-    position += sizeof(quint8);
+        endOffset = read<quint32>();
+        propertyCount = read<quint32>();
+        read<quint32>(); // property list length
+    }
+    quint8 nameLength = read<quint8>();
 
     FBXNode node;
-    const int MIN_VALID_OFFSET = 40;
+    const quint64 MIN_VALID_OFFSET = 40;
     if (endOffset < MIN_VALID_OFFSET || nameLength == 0) {
         // use a null name to indicate a null node
         return node;
     }
-    node.name = in.device()->read(nameLength);
-    position += nameLength;
+    node.name = hifi::ByteArray(readBytes(nameLength), nameLength);
 
-    for (quint32 i = 0; i < propertyCount; i++) {
-        node.properties.append(parseBinaryFBXProperty(in, position));
+    node.properties.reserve((int)std::min(propertyCount, (quint64)(_end - _position)));
+    for (quint64 i = 0; i < propertyCount; i++) {
+        node.properties.append(parseProperty());
     }
 
-    while (endOffset > position) {
-        FBXNode child = parseBinaryFBXNode(in, position, has64BitPositions);
+    while (endOffset > getOffset()) {
+        FBXNode child = parseNode();
         if (!child.name.isNull()) {
             node.children.append(child);
         }
@@ -228,10 +237,67 @@ FBXNode parseBinaryFBXNode(QDataStream& in, int& position, bool has64BitPosition
     return node;
 }
 
+void BinaryFBXParser::inflateArrays() {
+    std::atomic<bool> corrupt { false };
+    auto inflate = [&](const InflateJob& job) {
+        uLongf size = (uLongf)job.destinationSize;
+        int result = uncompress(reinterpret_cast<Bytef*>(job.destination), &size,
+                                reinterpret_cast<const Bytef*>(job.source), job.sourceSize);
+        if (result != Z_OK || size != job.destinationSize) {
+            corrupt = true;
+            return;
+        }
+        toHostByteOrder(job.destination, job.destinationSize, job.elementSize);
+    };
+
+    if (_inflateBytes < MIN_PARALLEL_INFLATE_BYTES || _inflateJobs.size() < 2) {
+        for (const auto& job : _inflateJobs) {
+            inflate(job);
+        }
+    } else {
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, _inflateJobs.size()), [&](const tbb::blocked_range<size_t>& range) {
+            for (size_t i = range.begin(); i != range.end(); ++i) {
+                inflate(_inflateJobs[i]);
+            }
+        });
+    }
+    _inflateJobs.clear();
+
+    if (corrupt) {
+        throw QString("corrupt fbx file");
+    }
+}
+
+FBXNode BinaryFBXParser::parse() {
+    // see http://code.blender.org/index.php/2013/08/fbx-binary-file-format-specification/ for an explanation
+    // of the FBX binary format
+
+    // The first 27 bytes contain the header.
+    //   Bytes 0 - 20: Kaydara FBX Binary  \x00(file - magic, with 2 spaces at the end, then a NULL terminator).
+    //   Bytes 21 - 22: [0x1A, 0x00](unknown but all observed files show these bytes).
+    //   Bytes 23 - 26 : unsigned int, the version number. 7300 for version 7.3 for example.
+    readBytes(FBX_HEADER_BYTES_BEFORE_VERSION);
+    quint32 fileVersion = read<quint32>();
+    _has64BitPositions = (fileVersion >= FBX_VERSION_2016);
+
+    // parse the top-level node
+    FBXNode top;
+    while (_position < _end) {
+        FBXNode next = parseNode();
+        if (next.name.isNull()) {
+            break;
+        }
+        top.children.append(next);
+    }
+
+    inflateArrays();
+    return top;
+}
+
 class Tokenizer {
 public:
 
-    Tokenizer(QIODevice* device) : _device(device), _pushedBackToken(-1) { }
+    Tokenizer(const hifi::ByteArray& data) : _data(data), _position(0), _pushedBackToken(-1) { }
 
     enum SpecialToken {
         NO_TOKEN = -1,
@@ -243,15 +309,33 @@ public:
     const hifi::ByteArray& getDatum() const { return _datum; }
 
     void pushBackToken(int token) { _pushedBackToken = token; }
-    void ungetChar(char ch) { _device->ungetChar(ch); }
+    void ungetChar() { _position--; }
+    bool atEnd() const { return _position >= _data.size(); }
 
 private:
 
-    QIODevice* _device;
+    bool getChar(char* ch);
+    void skipLine();
+
+    const hifi::ByteArray& _data;
+    int _position;
     hifi::ByteArray _datum;
     int _pushedBackToken;
 };
 
+bool Tokenizer::getChar(char* ch) {
+    if (atEnd()) {
+        return false;
+    }
+    *ch = _data.at(_position++);
+    return true;
+}
+
+void Tokenizer::skipLine() {
+    int end = _data.indexOf('\n', _position);
+    _position = (end == -1) ? _data.size() : end + 1;
+}
+
 int Tokenizer::nextToken() {
     if (_pushedBackToken != NO_PUSHBACKED_TOKEN) {
         int token = _pushedBackToken;
@@ -260,13 +344,13 @@ int Tokenizer::nextToken() {
     }
 
     char ch;
-    while (_device->getChar(&ch)) {
+    while (getChar(&ch)) {
         if (QChar(ch).isSpace()) {
             continue; // skip whitespace
         }
         switch (ch) {
             case ';':
-                _device->readLine(); // skip the comment
+                skipLine(); // skip the comment
                 break;
 
             case ':':
@@ -277,12 +361,12 @@ int Tokenizer::nextToken() {
 
             case '\"':
                 _datum = "";
-                while (_device->getChar(&ch)) {
+                while (getChar(&ch)) {
                     if (ch == '\"') { // end on closing quote
                         break;
                     }
                     if (ch == '\\') { // handle escaped quotes
-                        if (_device->getChar(&ch) && ch != '\"') {
+                        if (getChar(&ch) && ch != '\"') {
                             _datum.append('\\');
                         }
                     }
@@ -293,9 +377,9 @@ int Tokenizer::nextToken() {
             default:
                 _datum = "";
                 _datum.append(ch);
-                while (_device->getChar(&ch)) {
+                while (getChar(&ch)) {
                     if (QChar(ch).isSpace() || ch == ';' || ch == ':' || ch == '{' || ch == '}' || ch == ',' || ch == '\"') {
-                        ungetChar(ch); // read until we encounter a special character, then replace it
+                        ungetChar(); // read until we encounter a special character, then replace it
                         break;
                     }
                     _datum.append(ch);
@@ -333,7 +417,7 @@ FBXNode parseTextFBXNode(Tokenizer& tokenizer) {
         } else if (token == Tokenizer::DATUM_TOKEN && expectingDatum) {
             hifi::ByteArray datum = tokenizer.getDatum();
             if ((token = tokenizer.nextToken()) == ':') {
-                tokenizer.ungetChar(':');
+                tokenizer.ungetChar();
                 tokenizer.pushBackToken(Tokenizer::DATUM_TOKEN);
                 return node;    
                 
@@ -352,13 +436,17 @@ FBXNode parseTextFBXNode(Tokenizer& tokenizer) {
 }
 
 FBXNode FBXSerializer::parseFBX(QIODevice* device) {
-    PROFILE_RANGE_EX(resource_parse, __FUNCTION__, 0xff0000ff, device);
+    return parseFBX(device->readAll());
+}
+
+FBXNode FBXSerializer::parseFBX(const hifi::ByteArray& data) {
+    PROFILE_RANGE_EX(resource_parse, __FUNCTION__, 0xff0000ff, data.size());
     // verify the prolog
-    if (device->peek(FBX_BINARY_PROLOG.size()) != FBX_BINARY_PROLOG) {
+    if (!data.startsWith(FBX_BINARY_PROLOG)) {
         // parse as a text file
         FBXNode top;
-        Tokenizer tokenizer(device);
-        while (device->bytesAvailable()) {
+        Tokenizer tokenizer(data);
+        while (!tokenizer.atEnd()) {
             FBXNode next = parseTextFBXNode(tokenizer);
             if (next.name.isNull()) {
                 return top;
@@ -369,37 +457,7 @@ FBXNode FBXSerializer::parseFBX(QIODevice* device) {
         }
         return top;
     }
-    QDataStream in(device);
-    in.setByteOrder(QDataStream::LittleEndian);
-    in.setVersion(QDataStream::Qt_4_5); // for single/double precision switch
-
-    // see http://code.blender.org/index.php/2013/08/fbx-binary-file-format-specification/ for an explanation
-    // of the FBX binary format
-
-    // The first 27 bytes contain the header.
-    //   Bytes 0 - 20: Kaydara FBX Binary  \x00(file - magic, with 2 spaces at the end, then a NULL terminator).
-    //   Bytes 21 - 22: [0x1A, 0x00](unknown but all observed files show these bytes).
-    //   Bytes 23 - 26 : unsigned int, the version number. 7300 for version 7.3 for example.
-    in.skipRawData(FBX_HEADER_BYTES_BEFORE_VERSION);
-    int position = FBX_HEADER_BYTES_BEFORE_VERSION;
-    quint32 fileVersion;
-    in >> fileVersion;
-    position += sizeof(fileVersion);
-    bool has64BitPositions = (fileVersion >= FBX_VERSION_2016);
-
-    // parse the top-level node
-    FBXNode top;
-    while (device->bytesAvailable()) {
-        FBXNode next = parseBinaryFBXNode(in, position, has64BitPositions);
-        if (next.name.isNull()) {
-            return top;
-
-        } else {
-            top.children.append(next);
-        }
-    }
-
-    return top;
+    return BinaryFBXParser(data).parse();
 }
 
 
@@ -20,6 +20,8 @@ static const QString FST_VERSION_FIELD = "version";
 static const QString NAME_FIELD = "name";
 static const QString TYPE_FIELD = "type";
 static const QString FILENAME_FIELD = "filename";
+// an HFM blob of the same model as the filename, for the clients that can load one
+static const QString HFM_FILENAME_FIELD = "hfmFilename";
 static const QString MARKETPLACE_ID_FIELD = "marketplaceID";
 static const QString TEXDIR_FIELD = "texdir";
 static const QString LOD_FIELD = "lod";
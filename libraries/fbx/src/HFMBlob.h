@@ -0,0 +1,243 @@
+//
+//  HFMBlob.h
+//  libraries/fbx/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_HFMBlob_h
+#define hifi_HFMBlob_h
+
+#include <cstdint>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+// The on-disk layout of an "HFM blob", a baked model stored as the final hfm::Model it loads into.
+//
+// The blob is a Header followed by flat arrays of fixed-size records and plain values (vertices, indices, UTF-16
+// strings, ...). Records refer to their arrays by byte offset from the start of the blob, so the blob is relocatable
+// and can be used straight out of a memory mapping, and every array starts on an ALIGNMENT boundary.
+// Values are stored in the native (little endian) layout of glm; the version changes whenever any record does.
+namespace hfm {
+namespace blob {
+
+static const char MAGIC[8] = { 'H', 'F', 'M', 'B', 'L', 'O', 'B', '\0' };
+static const uint32_t VERSION = 1;
+static const uint64_t ALIGNMENT = 16;
+
+static_assert(sizeof(glm::vec2) == 8 && sizeof(glm::vec3) == 12 && sizeof(glm::quat) == 16 && sizeof(glm::mat4) == 64,
+    "HFM blobs store glm values in their packed layout");
+
+// A run of count elements starting offset bytes into the blob
+struct Array {
+    uint64_t offset { 0 };
+    uint64_t count { 0 };
+};
+
+struct Extents {
+    glm::vec3 minimum;
+    glm::vec3 maximum;
+};
+
+struct Transform {
+    glm::quat rotation;
+    glm::vec3 scale;
+    glm::vec3 translation;
+};
+
+struct Joint {
+    // shapeInfo
+    glm::vec3 avgPoint;
+    Array dots; // float
+    Array points; // glm::vec3
+    Array debugLines; // glm::vec3
+
+    int32_t parentIndex;
+    float distanceToParent;
+    glm::vec3 translation;
+    glm::mat4 preTransform;
+    glm::quat preRotation;
+    glm::quat rotation;
+    glm::quat postRotation;
+    glm::mat4 postTransform;
+    glm::mat4 transform;
+    glm::vec3 rotationMin;
+    glm::vec3 rotationMax;
+    glm::quat inverseDefaultRotation;
+    glm::quat inverseBindRotation;
+    glm::mat4 bindTransform;
+    Array name; // UTF-16
+    uint8_t isSkeletonJoint;
+    uint8_t bindTransformFoundInCluster;
+    uint8_t hasGeometricOffset;
+    glm::vec3 geometricTranslation;
+    glm::quat geometricRotation;
+    glm::vec3 geometricScaling;
+};
+
+struct JointIndex {
+    Array name; // UTF-16
+    int32_t index;
+};
+
+struct JointRotationOffset {
+    int32_t jointIndex;
+    glm::quat rotation;
+};
+
+struct Cluster {
+    int32_t jointIndex;
+    glm::mat4 inverseBindMatrix;
+    Transform inverseBindTransform;
+};
+
+struct Blendshape {
+    Array indices; // int32_t
+    Array vertices; // glm::vec3
+    Array normals; // glm::vec3
+    Array tangents; // glm::vec3
+};
+
+struct MeshPart {
+    Array quadIndices; // int32_t
+    Array quadTrianglesIndices; // int32_t
+    Array triangleIndices; // int32_t
+    Array materialID; // UTF-16
+};
+
+struct Mesh {
+    Array parts; // MeshPart
+    Array vertices; // glm::vec3
+    Array normals; // glm::vec3
+    Array tangents; // glm::vec3
+    Array colors; // glm::vec3
+    Array texCoords; // glm::vec2
+    Array texCoords1; // glm::vec2
+    Array clusterIndices; // uint16_t
+    Array clusterWeights; // uint16_t
+    Array originalIndices; // int32_t
+    Array clusters; // Cluster
+    Array blendshapes; // Blendshape
+    Extents meshExtents;
+    glm::mat4 modelTransform;
+    uint32_t meshIndex;
+    uint32_t wasCompressed;
+};
+
+struct Texture {
+    Array id; // UTF-16
+    Array name; // UTF-16
+    Array filename; // bytes
+    Array content; // bytes
+    Array texcoordSetName; // UTF-16
+    Transform transform;
+    int32_t sourceChannel;
+    int32_t maxNumPixels;
+    int32_t texcoordSet;
+    uint32_t isBumpmap;
+};
+
+// Material::flags
+static const uint32_t IS_PBS_MATERIAL = 1 << 0;
+static const uint32_t USE_NORMAL_MAP = 1 << 1;
+static const uint32_t USE_ALBEDO_MAP = 1 << 2;
+static const uint32_t USE_OPACITY_MAP = 1 << 3;
+static const uint32_t USE_ROUGHNESS_MAP = 1 << 4;
+static const uint32_t USE_SPECULAR_MAP = 1 << 5;
+static const uint32_t USE_METALLIC_MAP = 1 << 6;
+static const uint32_t USE_EMISSIVE_MAP = 1 << 7;
+static const uint32_t USE_OCCLUSION_MAP = 1 << 8;
+// The graphics::Material the serializer built for the material, if any
+static const uint32_t HAS_GRAPHICS_MATERIAL = 1 << 9;
+static const uint32_t GRAPHICS_ALBEDO = 1 << 10;
+static const uint32_t GRAPHICS_UNLIT = 1 << 11;
+
+enum MaterialTextures {
+    NORMAL_TEXTURE = 0,
+    ALBEDO_TEXTURE,
+    OPACITY_TEXTURE,
+    GLOSS_TEXTURE,
+    ROUGHNESS_TEXTURE,
+    SPECULAR_TEXTURE,
+    METALLIC_TEXTURE,
+    EMISSIVE_TEXTURE,
+    OCCLUSION_TEXTURE,
+    SCATTERING_TEXTURE,
+    LIGHTMAP_TEXTURE,
+    NUM_MATERIAL_TEXTURES
+};
+
+struct Material {
+    Array key; // UTF-16, the key of the material in hfm::Model::materials
+    Array materialID; // UTF-16
+    Array name; // UTF-16
+    Array shadingModel; // UTF-16
+    glm::vec3 diffuseColor;
+    float diffuseFactor;
+    glm::vec3 specularColor;
+    float specularFactor;
+    glm::vec3 emissiveColor;
+    float emissiveFactor;
+    float shininess;
+    float opacity;
+    float metallic;
+    float roughness;
+    float emissiveIntensity;
+    float ambientFactor;
+    float bumpMultiplier;
+    glm::vec2 lightmapParams;
+    uint32_t flags;
+    Texture textures[NUM_MATERIAL_TEXTURES];
+
+    // graphics::Material values, linear
+    glm::vec3 graphicsEmissive;
+    glm::vec3 graphicsAlbedo;
+    float graphicsRoughness;
+    float graphicsMetallic;
+    float graphicsOpacity;
+    float graphicsScattering;
+};
+
+struct AnimationFrame {
+    Array rotations; // glm::quat
+    Array translations; // glm::vec3
+};
+
+struct MeshModelName {
+    int32_t meshIndex;
+    Array name; // UTF-16
+};
+
+struct Header {
+    char magic[8];
+    uint32_t version;
+    uint32_t headerSize; // sizeof(Header), which catches layout differences between the writer and reader
+    uint64_t blobSize;
+
+    Array originalURL; // UTF-16
+    Array author; // UTF-16
+    Array applicationName; // UTF-16
+    Array joints; // Joint
+    Array jointIndices; // JointIndex
+    Array jointRotationOffsets; // JointRotationOffset
+    Array meshes; // Mesh
+    Array materials; // Material
+    Array animationFrames; // AnimationFrame
+    Array meshModelNames; // MeshModelName
+    Array blendshapeChannelNames; // Array, each UTF-16
+
+    glm::mat4 offset;
+    glm::vec3 neckPivot;
+    uint32_t hasSkeletonJoints;
+    Extents bindExtents;
+    Extents meshExtents;
+};
+
+} // namespace blob
+} // namespace hfm
+
+#endif // hifi_HFMBlob_h
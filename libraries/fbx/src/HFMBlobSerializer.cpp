@@ -0,0 +1,398 @@
+//
+//  HFMBlobSerializer.cpp
+//  libraries/fbx/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "HFMBlobSerializer.h"
+
+#include <cstring>
+#include <limits>
+
+#include <QFile>
+
+#include <hfm/ModelFormatLogging.h>
+
+#include "HFMBlob.h"
+
+namespace hfm {
+namespace blob {
+namespace {
+
+// Copies records and arrays out of a blob, throwing if anything refers outside of it.
+// Everything is copied with memcpy, so the blob itself need not be aligned in memory.
+class BlobReader {
+public:
+    BlobReader(const char* data, uint64_t size) : _data(data), _size(size) {}
+
+    template <typename T>
+    void read(uint64_t offset, uint64_t count, T* out) const {
+        if (count == 0) {
+            return;
+        }
+        if (offset > _size || count > (_size - offset) / sizeof(T)) {
+            throw QString("HFM blob array out of range");
+        }
+        std::memcpy((void*)out, _data + offset, count * sizeof(T));
+    }
+
+    template <typename T>
+    T getRecord(uint64_t offset) const {
+        T record;
+        read(offset, 1, &record);
+        return record;
+    }
+
+    template <typename T>
+    std::vector<T> getRecords(const Array& array) const {
+        std::vector<T> records(checkedCount<T>(array));
+        read(array.offset, array.count, records.data());
+        return records;
+    }
+
+    template <typename T>
+    QVector<T> getVector(const Array& array) const {
+        QVector<T> values(checkedCount<T>(array));
+        read(array.offset, array.count, values.data());
+        return values;
+    }
+
+    QString getString(const Array& array) const {
+        QString string(checkedCount<uint16_t>(array), Qt::Uninitialized);
+        read(array.offset, array.count, (uint16_t*)string.data());
+        return string;
+    }
+
+    QByteArray getBytes(const Array& array) const {
+        QByteArray bytes(checkedCount<char>(array), Qt::Uninitialized);
+        read(array.offset, array.count, bytes.data());
+        return bytes;
+    }
+
+private:
+    // Rejects arrays that don't fit in the blob before anything is allocated for them, so that a blob can't make the
+    // reader allocate more than it is big
+    template <typename T>
+    int checkedCount(const Array& array) const {
+        if (array.offset > _size || array.count > (_size - array.offset) / sizeof(T) ||
+                array.count > (uint64_t)std::numeric_limits<int>::max()) {
+            throw QString("HFM blob array out of range");
+        }
+        return (int)array.count;
+    }
+
+    const char* _data;
+    uint64_t _size;
+};
+
+::Extents getExtents(const Extents& record) {
+    ::Extents extents;
+    extents.minimum = record.minimum;
+    extents.maximum = record.maximum;
+    return extents;
+}
+
+::Transform getTransform(const Transform& record) {
+    ::Transform transform;
+    transform.setRotation(record.rotation);
+    transform.setScale(record.scale);
+    transform.setTranslation(record.translation);
+    return transform;
+}
+
+hfm::Texture getTexture(const BlobReader& reader, const Texture& record) {
+    hfm::Texture texture;
+    texture.id = reader.getString(record.id);
+    texture.name = reader.getString(record.name);
+    texture.filename = reader.getBytes(record.filename);
+    texture.content = reader.getBytes(record.content);
+    texture.texcoordSetName = reader.getString(record.texcoordSetName);
+    texture.transform = getTransform(record.transform);
+    texture.sourceChannel = (image::ColorChannel)record.sourceChannel;
+    texture.maxNumPixels = record.maxNumPixels;
+    texture.texcoordSet = record.texcoordSet;
+    texture.isBumpmap = record.isBumpmap != 0;
+    return texture;
+}
+
+hfm::Material getMaterial(const BlobReader& reader, const Material& record) {
+    hfm::Material material;
+    material.materialID = reader.getString(record.materialID);
+    material.name = reader.getString(record.name);
+    material.shadingModel = reader.getString(record.shadingModel);
+    material.diffuseColor = record.diffuseColor;
+    material.diffuseFactor = record.diffuseFactor;
+    material.specularColor = record.specularColor;
+    material.specularFactor = record.specularFactor;
+    material.emissiveColor = record.emissiveColor;
+    material.emissiveFactor = record.emissiveFactor;
+    material.shininess = record.shininess;
+    material.opacity = record.opacity;
+    material.metallic = record.metallic;
+    material.roughness = record.roughness;
+    material.emissiveIntensity = record.emissiveIntensity;
+    material.ambientFactor = record.ambientFactor;
+    material.bumpMultiplier = record.bumpMultiplier;
+    material.lightmapParams = record.lightmapParams;
+
+    material.isPBSMaterial = (record.flags & IS_PBS_MATERIAL) != 0;
+    material.useNormalMap = (record.flags & USE_NORMAL_MAP) != 0;
+    material.useAlbedoMap = (record.flags & USE_ALBEDO_MAP) != 0;
+    material.useOpacityMap = (record.flags & USE_OPACITY_MAP) != 0;
+    material.useRoughnessMap = (record.flags & USE_ROUGHNESS_MAP) != 0;
+    material.useSpecularMap = (record.flags & USE_SPECULAR_MAP) != 0;
+    material.useMetallicMap = (record.flags & USE_METALLIC_MAP) != 0;
+    material.useEmissiveMap = (record.flags & USE_EMISSIVE_MAP) != 0;
+    material.useOcclusionMap = (record.flags & USE_OCCLUSION_MAP) != 0;
+
+    material.normalTexture = getTexture(reader, record.textures[NORMAL_TEXTURE]);
+    material.albedoTexture = getTexture(reader, record.textures[ALBEDO_TEXTURE]);
+    material.opacityTexture = getTexture(reader, record.textures[OPACITY_TEXTURE]);
+    material.glossTexture = getTexture(reader, record.textures[GLOSS_TEXTURE]);
+    material.roughnessTexture = getTexture(reader, record.textures[ROUGHNESS_TEXTURE]);
+    material.specularTexture = getTexture(reader, record.textures[SPECULAR_TEXTURE]);
+    material.metallicTexture = getTexture(reader, record.textures[METALLIC_TEXTURE]);
+    material.emissiveTexture = getTexture(reader, record.textures[EMISSIVE_TEXTURE]);
+    material.occlusionTexture = getTexture(reader, record.textures[OCCLUSION_TEXTURE]);
+    material.scatteringTexture = getTexture(reader, record.textures[SCATTERING_TEXTURE]);
+    material.lightmapTexture = getTexture(reader, record.textures[LIGHTMAP_TEXTURE]);
+
+    if (record.flags & HAS_GRAPHICS_MATERIAL) {
+        material._material = std::make_shared<graphics::Material>();
+        if (record.flags & GRAPHICS_ALBEDO) {
+            material._material->setAlbedo(record.graphicsAlbedo, false);
+        }
+        material._material->setEmissive(record.graphicsEmissive, false);
+        material._material->setRoughness(record.graphicsRoughness);
+        material._material->setMetallic(record.graphicsMetallic);
+        material._material->setOpacity(record.graphicsOpacity);
+        material._material->setScattering(record.graphicsScattering);
+        material._material->setUnlit((record.flags & GRAPHICS_UNLIT) != 0);
+    }
+    return material;
+}
+
+hfm::Mesh getMesh(const BlobReader& reader, const Mesh& record) {
+    hfm::Mesh mesh;
+
+    for (const auto& partRecord : reader.getRecords<MeshPart>(record.parts)) {
+        hfm::MeshPart part;
+        part.quadIndices = reader.getVector<int>(partRecord.quadIndices);
+        part.quadTrianglesIndices = reader.getVector<int>(partRecord.quadTrianglesIndices);
+        part.triangleIndices = reader.getVector<int>(partRecord.triangleIndices);
+        part.materialID = reader.getString(partRecord.materialID);
+        mesh.parts.push_back(part);
+    }
+
+    mesh.vertices = reader.getVector<glm::vec3>(record.vertices);
+    mesh.normals = reader.getVector<glm::vec3>(record.normals);
+    mesh.tangents = reader.getVector<glm::vec3>(record.tangents);
+    mesh.colors = reader.getVector<glm::vec3>(record.colors);
+    mesh.texCoords = reader.getVector<glm::vec2>(record.texCoords);
+    mesh.texCoords1 = reader.getVector<glm::vec2>(record.texCoords1);
+    mesh.clusterIndices = reader.getVector<uint16_t>(record.clusterIndices);
+    mesh.clusterWeights = reader.getVector<uint16_t>(record.clusterWeights);
+    mesh.originalIndices = reader.getVector<int32_t>(record.originalIndices);
+
+    for (const auto& clusterRecord : reader.getRecords<Cluster>(record.clusters)) {
+        hfm::Cluster cluster;
+        cluster.jointIndex = clusterRecord.jointIndex;
+        cluster.inverseBindMatrix = clusterRecord.inverseBindMatrix;
+        cluster.inverseBindTransform = getTransform(clusterRecord.inverseBindTransform);
+        mesh.clusters.push_back(cluster);
+    }
+
+    for (const auto& blendshapeRecord : reader.getRecords<Blendshape>(record.blendshapes)) {
+        hfm::Blendshape blendshape;
+        blendshape.indices = reader.getVector<int>(blendshapeRecord.indices);
+        blendshape.vertices = reader.getVector<glm::vec3>(blendshapeRecord.vertices);
+        blendshape.normals = reader.getVector<glm::vec3>(blendshapeRecord.normals);
+        blendshape.tangents = reader.getVector<glm::vec3>(blendshapeRecord.tangents);
+        mesh.blendshapes.push_back(blendshape);
+    }
+
+    mesh.meshExtents = getExtents(record.meshExtents);
+    mesh.modelTransform = record.modelTransform;
+    mesh.meshIndex = record.meshIndex;
+    mesh.wasCompressed = record.wasCompressed != 0;
+    return mesh;
+}
+
+hfm::Joint getJoint(const BlobReader& reader, const Joint& record) {
+    hfm::Joint joint;
+    joint.shapeInfo.avgPoint = record.avgPoint;
+    joint.shapeInfo.dots = reader.getRecords<float>(record.dots);
+    joint.shapeInfo.points = reader.getRecords<glm::vec3>(record.points);
+    joint.shapeInfo.debugLines = reader.getRecords<glm::vec3>(record.debugLines);
+    joint.parentIndex = record.parentIndex;
+    joint.distanceToParent = record.distanceToParent;
+    joint.translation = record.translation;
+    joint.preTransform = record.preTransform;
+    joint.preRotation = record.preRotation;
+    joint.rotation = record.rotation;
+    joint.postRotation = record.postRotation;
+    joint.postTransform = record.postTransform;
+    joint.transform = record.transform;
+    joint.rotationMin = record.rotationMin;
+    joint.rotationMax = record.rotationMax;
+    joint.inverseDefaultRotation = record.inverseDefaultRotation;
+    joint.inverseBindRotation = record.inverseBindRotation;
+    joint.bindTransform = record.bindTransform;
+    joint.name = reader.getString(record.name);
+    joint.isSkeletonJoint = record.isSkeletonJoint != 0;
+    joint.bindTransformFoundInCluster = record.bindTransformFoundInCluster != 0;
+    joint.hasGeometricOffset = record.hasGeometricOffset != 0;
+    joint.geometricTranslation = record.geometricTranslation;
+    joint.geometricRotation = record.geometricRotation;
+    joint.geometricScaling = record.geometricScaling;
+    return joint;
+}
+
+template <typename T>
+void checkIndices(const QVector<T>& indices, int count, const char* what) {
+    for (auto index : indices) {
+        if (index < 0 || index >= count) {
+            throw QString("HFM blob has an out of range ") + what;
+        }
+    }
+}
+
+// The baker and the renderer index with these without checking them
+void checkIndices(const hfm::Model& model) {
+    int numJoints = model.joints.size();
+    for (const auto& joint : model.joints) {
+        if (joint.parentIndex < -1 || joint.parentIndex >= numJoints) {
+            throw QString("HFM blob has an out of range joint parent");
+        }
+    }
+    for (const auto& mesh : model.meshes) {
+        int numVertices = mesh.vertices.size();
+        for (const auto& part : mesh.parts) {
+            checkIndices(part.triangleIndices, numVertices, "triangle index");
+            checkIndices(part.quadIndices, numVertices, "quad index");
+            checkIndices(part.quadTrianglesIndices, numVertices, "quad triangle index");
+        }
+        for (const auto& cluster : mesh.clusters) {
+            if (cluster.jointIndex < 0 || cluster.jointIndex >= numJoints) {
+                throw QString("HFM blob has an out of range cluster joint");
+            }
+        }
+        for (const auto& blendshape : mesh.blendshapes) {
+            checkIndices(blendshape.indices, numVertices, "blendshape index");
+        }
+    }
+}
+
+HFMModel::Pointer decodeModel(const char* data, uint64_t size) {
+    if (size < sizeof(Header)) {
+        throw QString("HFM blob is truncated");
+    }
+    BlobReader reader(data, size);
+    auto header = reader.getRecord<Header>(0);
+    if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0) {
+        throw QString("not an HFM blob");
+    }
+    if (header.version != VERSION || header.headerSize != sizeof(Header)) {
+        throw QString("unsupported HFM blob version ") + QString::number(header.version);
+    }
+    if (header.blobSize != size) {
+        throw QString("HFM blob is truncated");
+    }
+
+    auto model = std::make_shared<hfm::Model>();
+    model->originalURL = reader.getString(header.originalURL);
+    model->author = reader.getString(header.author);
+    model->applicationName = reader.getString(header.applicationName);
+
+    auto joints = reader.getRecords<Joint>(header.joints);
+    model->joints.reserve((int)joints.size());
+    for (const auto& joint : joints) {
+        model->joints.push_back(getJoint(reader, joint));
+    }
+    for (const auto& jointIndex : reader.getRecords<JointIndex>(header.jointIndices)) {
+        model->jointIndices.insert(reader.getString(jointIndex.name), jointIndex.index);
+    }
+    for (const auto& offset : reader.getRecords<JointRotationOffset>(header.jointRotationOffsets)) {
+        model->jointRotationOffsets.insert(offset.jointIndex, offset.rotation);
+    }
+
+    auto meshes = reader.getRecords<Mesh>(header.meshes);
+    model->meshes.reserve((int)meshes.size());
+    for (const auto& mesh : meshes) {
+        model->meshes.push_back(getMesh(reader, mesh));
+    }
+
+    for (const auto& material : reader.getRecords<Material>(header.materials)) {
+        model->materials.insert(reader.getString(material.key), getMaterial(reader, material));
+    }
+
+    for (const auto& frameRecord : reader.getRecords<AnimationFrame>(header.animationFrames)) {
+        hfm::AnimationFrame frame;
+        frame.rotations = reader.getVector<glm::quat>(frameRecord.rotations);
+        frame.translations = reader.getVector<glm::vec3>(frameRecord.translations);
+        model->animationFrames.push_back(frame);
+    }
+
+    for (const auto& meshModelName : reader.getRecords<MeshModelName>(header.meshModelNames)) {
+        model->meshIndicesToModelNames.insert(meshModelName.meshIndex, reader.getString(meshModelName.name));
+    }
+    for (const auto& name : reader.getRecords<Array>(header.blendshapeChannelNames)) {
+        model->blendshapeChannelNames.push_back(reader.getString(name));
+    }
+
+    model->offset = header.offset;
+    model->neckPivot = header.neckPivot;
+    model->hasSkeletonJoints = header.hasSkeletonJoints != 0;
+    model->bindExtents = getExtents(header.bindExtents);
+    model->meshExtents = getExtents(header.meshExtents);
+
+    checkIndices(*model);
+    return model;
+}
+
+}
+} // namespace blob
+} // namespace hfm
+
+MediaType HFMBlobSerializer::getMediaType() const {
+    MediaType mediaType("hfm");
+    mediaType.extensions.push_back("hfm");
+    mediaType.fileSignatures.emplace_back(std::string(hfm::blob::MAGIC, sizeof(hfm::blob::MAGIC)), 0);
+    return mediaType;
+}
+
+std::unique_ptr<hfm::Serializer::Factory> HFMBlobSerializer::getFactory() const {
+    return std::make_unique<hfm::Serializer::SimpleFactory<HFMBlobSerializer>>();
+}
+
+HFMModel::Pointer HFMBlobSerializer::read(const hifi::ByteArray& data, const hifi::VariantHash& mapping, const hifi::URL& url) {
+    try {
+        return hfm::blob::decodeModel(data.constData(), (uint64_t)data.size());
+    } catch (const QString& error) {
+        qCWarning(modelformat) << "Error reading" << url << "--" << error;
+        return HFMModel::Pointer();
+    }
+}
+
+HFMModel::Pointer HFMBlobSerializer::readFile(const QString& path) {
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qCWarning(modelformat) << "Could not open" << path;
+        return HFMModel::Pointer();
+    }
+
+    // The model copies everything it needs out of the mapping, so it can be unmapped as soon as it is read
+    qint64 size = file.size();
+    uchar* mapped = file.map(0, size);
+    if (!mapped) {
+        return HFMBlobSerializer().read(file.readAll(), hifi::VariantHash(), hifi::URL::fromLocalFile(path));
+    }
+    auto data = hifi::ByteArray::fromRawData((const char*)mapped, (int)size);
+    auto model = HFMBlobSerializer().read(data, hifi::VariantHash(), hifi::URL::fromLocalFile(path));
+    file.unmap(mapped);
+    return model;
+}
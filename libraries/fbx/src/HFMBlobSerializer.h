@@ -0,0 +1,29 @@
+//
+//  HFMBlobSerializer.h
+//  libraries/fbx/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_HFMBlobSerializer_h
+#define hifi_HFMBlobSerializer_h
+
+#include <hfm/HFMSerializer.h>
+
+// Reads the HFM blobs written by HFMBlobWriter. The blob already holds the final model, so reading it is a bounds
+// checked copy of its arrays into the HFMModel: there is nothing to parse, and no Draco meshes to decode.
+class HFMBlobSerializer : public HFMSerializer {
+public:
+    MediaType getMediaType() const override;
+    std::unique_ptr<hfm::Serializer::Factory> getFactory() const override;
+
+    HFMModel::Pointer read(const hifi::ByteArray& data, const hifi::VariantHash& mapping, const hifi::URL& url = hifi::URL()) override;
+
+    // Reads a blob on disk through a memory mapping of the file, rather than reading the file into memory first
+    static HFMModel::Pointer readFile(const QString& path);
+};
+
+#endif // hifi_HFMBlobSerializer_h
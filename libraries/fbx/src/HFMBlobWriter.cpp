@@ -0,0 +1,341 @@
+//
+//  HFMBlobWriter.cpp
+//  libraries/fbx/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "HFMBlobWriter.h"
+
+#include <cstring>
+
+#include "HFMBlob.h"
+
+namespace hfm {
+namespace blob {
+namespace {
+
+// Records are zeroed before they are filled in, so that padding doesn't leak into the blob
+template <typename T>
+T makeRecord() {
+    T record;
+    std::memset((void*)&record, 0, sizeof(T));
+    return record;
+}
+
+class BlobBuilder {
+public:
+    BlobBuilder() {
+        // Reserve the header; it is filled in once everything it refers to has been written
+        _data.fill('\0', sizeof(Header));
+    }
+
+    template <typename T>
+    Array append(const T* values, size_t count) {
+        Array array;
+        if (count == 0) {
+            return array;
+        }
+        align();
+        array.offset = (uint64_t)_data.size();
+        array.count = (uint64_t)count;
+        _data.append((const char*)values, (int)(count * sizeof(T)));
+        return array;
+    }
+
+    template <typename T>
+    Array append(const QVector<T>& values) { return append(values.constData(), values.size()); }
+
+    template <typename T>
+    Array append(const std::vector<T>& values) { return append(values.data(), values.size()); }
+
+    Array append(const QString& string) { return append((const uint16_t*)string.utf16(), string.size()); }
+    Array append(const QByteArray& bytes) { return append(bytes.constData(), bytes.size()); }
+
+    QByteArray finish(const Header& header) {
+        align();
+        Header finalHeader = header;
+        std::memcpy(finalHeader.magic, MAGIC, sizeof(MAGIC));
+        finalHeader.version = VERSION;
+        finalHeader.headerSize = (uint32_t)sizeof(Header);
+        finalHeader.blobSize = (uint64_t)_data.size();
+        std::memcpy(_data.data(), &finalHeader, sizeof(Header));
+        return _data;
+    }
+
+private:
+    void align() {
+        int padding = (int)((ALIGNMENT - ((uint64_t)_data.size() % ALIGNMENT)) % ALIGNMENT);
+        if (padding > 0) {
+            _data.append(padding, '\0');
+        }
+    }
+
+    QByteArray _data;
+};
+
+Extents makeExtents(const ::Extents& extents) {
+    auto record = makeRecord<Extents>();
+    record.minimum = extents.minimum;
+    record.maximum = extents.maximum;
+    return record;
+}
+
+Transform makeTransform(const ::Transform& transform) {
+    auto record = makeRecord<Transform>();
+    record.rotation = transform.getRotation();
+    record.scale = transform.getScale();
+    record.translation = transform.getTranslation();
+    return record;
+}
+
+Texture makeTexture(BlobBuilder& builder, const hfm::Texture& texture) {
+    auto record = makeRecord<Texture>();
+    record.id = builder.append(texture.id);
+    record.name = builder.append(texture.name);
+    record.filename = builder.append(texture.filename);
+    record.content = builder.append(texture.content);
+    record.texcoordSetName = builder.append(texture.texcoordSetName);
+    record.transform = makeTransform(texture.transform);
+    record.sourceChannel = (int32_t)texture.sourceChannel;
+    record.maxNumPixels = texture.maxNumPixels;
+    record.texcoordSet = texture.texcoordSet;
+    record.isBumpmap = texture.isBumpmap;
+    return record;
+}
+
+Material makeMaterial(BlobBuilder& builder, const QString& key, const hfm::Material& material) {
+    auto record = makeRecord<Material>();
+    record.key = builder.append(key);
+    record.materialID = builder.append(material.materialID);
+    record.name = builder.append(material.name);
+    record.shadingModel = builder.append(material.shadingModel);
+    record.diffuseColor = material.diffuseColor;
+    record.diffuseFactor = material.diffuseFactor;
+    record.specularColor = material.specularColor;
+    record.specularFactor = material.specularFactor;
+    record.emissiveColor = material.emissiveColor;
+    record.emissiveFactor = material.emissiveFactor;
+    record.shininess = material.shininess;
+    record.opacity = material.opacity;
+    record.metallic = material.metallic;
+    record.roughness = material.roughness;
+    record.emissiveIntensity = material.emissiveIntensity;
+    record.ambientFactor = material.ambientFactor;
+    record.bumpMultiplier = material.bumpMultiplier;
+    record.lightmapParams = material.lightmapParams;
+
+    uint32_t flags = 0;
+    flags |= material.isPBSMaterial ? IS_PBS_MATERIAL : 0;
+    flags |= material.useNormalMap ? USE_NORMAL_MAP : 0;
+    flags |= material.useAlbedoMap ? USE_ALBEDO_MAP : 0;
+    flags |= material.useOpacityMap ? USE_OPACITY_MAP : 0;
+    flags |= material.useRoughnessMap ? USE_ROUGHNESS_MAP : 0;
+    flags |= material.useSpecularMap ? USE_SPECULAR_MAP : 0;
+    flags |= material.useMetallicMap ? USE_METALLIC_MAP : 0;
+    flags |= material.useEmissiveMap ? USE_EMISSIVE_MAP : 0;
+    flags |= material.useOcclusionMap ? USE_OCCLUSION_MAP : 0;
+
+    record.textures[NORMAL_TEXTURE] = makeTexture(builder, material.normalTexture);
+    record.textures[ALBEDO_TEXTURE] = makeTexture(builder, material.albedoTexture);
+    record.textures[OPACITY_TEXTURE] = makeTexture(builder, material.opacityTexture);
+    record.textures[GLOSS_TEXTURE] = makeTexture(builder, material.glossTexture);
+    record.textures[ROUGHNESS_TEXTURE] = makeTexture(builder, material.roughnessTexture);
+    record.textures[SPECULAR_TEXTURE] = makeTexture(builder, material.specularTexture);
+    record.textures[METALLIC_TEXTURE] = makeTexture(builder, material.metallicTexture);
+    record.textures[EMISSIVE_TEXTURE] = makeTexture(builder, material.emissiveTexture);
+    record.textures[OCCLUSION_TEXTURE] = makeTexture(builder, material.occlusionTexture);
+    record.textures[SCATTERING_TEXTURE] = makeTexture(builder, material.scatteringTexture);
+    record.textures[LIGHTMAP_TEXTURE] = makeTexture(builder, material.lightmapTexture);
+
+    if (material._material) {
+        const auto& graphicsMaterial = *material._material;
+        flags |= HAS_GRAPHICS_MATERIAL;
+        flags |= graphicsMaterial.getKey().isAlbedo() ? GRAPHICS_ALBEDO : 0;
+        flags |= graphicsMaterial.isUnlit() ? GRAPHICS_UNLIT : 0;
+        record.graphicsEmissive = graphicsMaterial.getEmissive(false);
+        record.graphicsAlbedo = graphicsMaterial.getAlbedo(false);
+        record.graphicsRoughness = graphicsMaterial.getRoughness();
+        record.graphicsMetallic = graphicsMaterial.getMetallic();
+        record.graphicsOpacity = graphicsMaterial.getOpacity();
+        record.graphicsScattering = graphicsMaterial.getScattering();
+    }
+    record.flags = flags;
+    return record;
+}
+
+Mesh makeMesh(BlobBuilder& builder, const hfm::Mesh& mesh) {
+    std::vector<MeshPart> parts;
+    parts.reserve(mesh.parts.size());
+    for (const auto& part : mesh.parts) {
+        auto partRecord = makeRecord<MeshPart>();
+        partRecord.quadIndices = builder.append(part.quadIndices);
+        partRecord.quadTrianglesIndices = builder.append(part.quadTrianglesIndices);
+        partRecord.triangleIndices = builder.append(part.triangleIndices);
+        partRecord.materialID = builder.append(part.materialID);
+        parts.push_back(partRecord);
+    }
+
+    std::vector<Cluster> clusters;
+    clusters.reserve(mesh.clusters.size());
+    for (const auto& cluster : mesh.clusters) {
+        auto clusterRecord = makeRecord<Cluster>();
+        clusterRecord.jointIndex = cluster.jointIndex;
+        clusterRecord.inverseBindMatrix = cluster.inverseBindMatrix;
+        clusterRecord.inverseBindTransform = makeTransform(cluster.inverseBindTransform);
+        clusters.push_back(clusterRecord);
+    }
+
+    std::vector<Blendshape> blendshapes;
+    blendshapes.reserve(mesh.blendshapes.size());
+    for (const auto& blendshape : mesh.blendshapes) {
+        auto blendshapeRecord = makeRecord<Blendshape>();
+        blendshapeRecord.indices = builder.append(blendshape.indices);
+        blendshapeRecord.vertices = builder.append(blendshape.vertices);
+        blendshapeRecord.normals = builder.append(blendshape.normals);
+        blendshapeRecord.tangents = builder.append(blendshape.tangents);
+        blendshapes.push_back(blendshapeRecord);
+    }
+
+    auto record = makeRecord<Mesh>();
+    record.parts = builder.append(parts);
+    record.vertices = builder.append(mesh.vertices);
+    record.normals = builder.append(mesh.normals);
+    record.tangents = builder.append(mesh.tangents);
+    record.colors = builder.append(mesh.colors);
+    record.texCoords = builder.append(mesh.texCoords);
+    record.texCoords1 = builder.append(mesh.texCoords1);
+    record.clusterIndices = builder.append(mesh.clusterIndices);
+    record.clusterWeights = builder.append(mesh.clusterWeights);
+    record.originalIndices = builder.append(mesh.originalIndices);
+    record.clusters = builder.append(clusters);
+    record.blendshapes = builder.append(blendshapes);
+    record.meshExtents = makeExtents(mesh.meshExtents);
+    record.modelTransform = mesh.modelTransform;
+    record.meshIndex = mesh.meshIndex;
+    record.wasCompressed = mesh.wasCompressed;
+    return record;
+}
+
+Joint makeJoint(BlobBuilder& builder, const hfm::Joint& joint) {
+    auto record = makeRecord<Joint>();
+    record.avgPoint = joint.shapeInfo.avgPoint;
+    record.dots = builder.append(joint.shapeInfo.dots);
+    record.points = builder.append(joint.shapeInfo.points);
+    record.debugLines = builder.append(joint.shapeInfo.debugLines);
+    record.parentIndex = joint.parentIndex;
+    record.distanceToParent = joint.distanceToParent;
+    record.translation = joint.translation;
+    record.preTransform = joint.preTransform;
+    record.preRotation = joint.preRotation;
+    record.rotation = joint.rotation;
+    record.postRotation = joint.postRotation;
+    record.postTransform = joint.postTransform;
+    record.transform = joint.transform;
+    record.rotationMin = joint.rotationMin;
+    record.rotationMax = joint.rotationMax;
+    record.inverseDefaultRotation = joint.inverseDefaultRotation;
+    record.inverseBindRotation = joint.inverseBindRotation;
+    record.bindTransform = joint.bindTransform;
+    record.name = builder.append(joint.name);
+    record.isSkeletonJoint = joint.isSkeletonJoint;
+    record.bindTransformFoundInCluster = joint.bindTransformFoundInCluster;
+    record.hasGeometricOffset = joint.hasGeometricOffset;
+    record.geometricTranslation = joint.geometricTranslation;
+    record.geometricRotation = joint.geometricRotation;
+    record.geometricScaling = joint.geometricScaling;
+    return record;
+}
+
+QByteArray encodeModel(const hfm::Model& model) {
+    BlobBuilder builder;
+    auto header = makeRecord<Header>();
+
+    header.originalURL = builder.append(model.originalURL);
+    header.author = builder.append(model.author);
+    header.applicationName = builder.append(model.applicationName);
+
+    std::vector<Joint> joints;
+    joints.reserve(model.joints.size());
+    for (const auto& joint : model.joints) {
+        joints.push_back(makeJoint(builder, joint));
+    }
+    header.joints = builder.append(joints);
+
+    std::vector<JointIndex> jointIndices;
+    jointIndices.reserve(model.jointIndices.size());
+    for (auto it = model.jointIndices.cbegin(); it != model.jointIndices.cend(); ++it) {
+        auto record = makeRecord<JointIndex>();
+        record.name = builder.append(it.key());
+        record.index = it.value();
+        jointIndices.push_back(record);
+    }
+    header.jointIndices = builder.append(jointIndices);
+
+    std::vector<JointRotationOffset> jointRotationOffsets;
+    for (auto it = model.jointRotationOffsets.cbegin(); it != model.jointRotationOffsets.cend(); ++it) {
+        auto record = makeRecord<JointRotationOffset>();
+        record.jointIndex = it.key();
+        record.rotation = it.value();
+        jointRotationOffsets.push_back(record);
+    }
+    header.jointRotationOffsets = builder.append(jointRotationOffsets);
+
+    std::vector<Mesh> meshes;
+    meshes.reserve(model.meshes.size());
+    for (const auto& mesh : model.meshes) {
+        meshes.push_back(makeMesh(builder, mesh));
+    }
+    header.meshes = builder.append(meshes);
+
+    std::vector<Material> materials;
+    materials.reserve(model.materials.size());
+    for (auto it = model.materials.cbegin(); it != model.materials.cend(); ++it) {
+        materials.push_back(makeMaterial(builder, it.key(), it.value()));
+    }
+    header.materials = builder.append(materials);
+
+    std::vector<AnimationFrame> animationFrames;
+    animationFrames.reserve(model.animationFrames.size());
+    for (const auto& frame : model.animationFrames) {
+        auto record = makeRecord<AnimationFrame>();
+        record.rotations = builder.append(frame.rotations);
+        record.translations = builder.append(frame.translations);
+        animationFrames.push_back(record);
+    }
+    header.animationFrames = builder.append(animationFrames);
+
+    std::vector<MeshModelName> meshModelNames;
+    for (auto it = model.meshIndicesToModelNames.cbegin(); it != model.meshIndicesToModelNames.cend(); ++it) {
+        auto record = makeRecord<MeshModelName>();
+        record.meshIndex = it.key();
+        record.name = builder.append(it.value());
+        meshModelNames.push_back(record);
+    }
+    header.meshModelNames = builder.append(meshModelNames);
+
+    std::vector<Array> blendshapeChannelNames;
+    for (const auto& name : model.blendshapeChannelNames) {
+        blendshapeChannelNames.push_back(builder.append(name));
+    }
+    header.blendshapeChannelNames = builder.append(blendshapeChannelNames);
+
+    header.offset = model.offset;
+    header.neckPivot = model.neckPivot;
+    header.hasSkeletonJoints = model.hasSkeletonJoints;
+    header.bindExtents = makeExtents(model.bindExtents);
+    header.meshExtents = makeExtents(model.meshExtents);
+
+    return builder.finish(header);
+}
+
+}
+} // namespace blob
+} // namespace hfm
+
+QByteArray HFMBlobWriter::encodeHFMBlob(const hfm::Model& model) {
+    return hfm::blob::encodeModel(model);
+}
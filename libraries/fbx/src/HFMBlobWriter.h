@@ -0,0 +1,24 @@
+//
+//  HFMBlobWriter.h
+//  libraries/fbx/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_HFMBlobWriter_h
+#define hifi_HFMBlobWriter_h
+
+#include <QByteArray>
+
+#include <hfm/HFM.h>
+
+class HFMBlobWriter {
+public:
+    // Lays out a (baked) model as an HFM blob. See HFMBlob.h
+    static QByteArray encodeHFMBlob(const hfm::Model& model);
+};
+
+#endif // hifi_HFMBlobWriter_h
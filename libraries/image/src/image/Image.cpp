@@ -4,6 +4,8 @@
 
 #include <nvtt/nvtt.h>
 
+#include <TBBHelpers.h>
+
 using namespace image;
 
 Image::Image(int width, int height, Format format) : 
@@ -202,16 +204,18 @@ Image Image::getConvertedToFormat(Format newFormat) const {
         assert(newImage.hasFloatFormat());
 
         if (newFormat == Format_RGBAF) {
-            FloatPixels::iterator dstIt = newImage._floatData.begin();
-
-            for (int y = 0; y < _dims.y; y++) {
-                auto line = (const QRgb*)getScanLine(y);
-                for (int x = 0; x < _dims.x; x++) {
-                    QRgb pixel = line[x];
-                    *dstIt = glm::vec4(qRed(pixel), qGreen(pixel), qBlue(pixel), qAlpha(pixel)) / MAX_COLOR_VALUE;
-                    dstIt++;
+            // this is how every texture is fed to the ETC2 encoder, so the lines are converted in parallel
+            tbb::parallel_for(tbb::blocked_range<int>(0, _dims.y, 16), [&](const tbb::blocked_range<int>& range) {
+                for (int y = range.begin(); y < range.end(); y++) {
+                    auto line = (const QRgb*)getScanLine(y);
+                    auto dstIt = newImage._floatData.begin() + y * _dims.x;
+                    for (int x = 0; x < _dims.x; x++) {
+                        QRgb pixel = line[x];
+                        *dstIt = glm::vec4(qRed(pixel), qGreen(pixel), qBlue(pixel), qAlpha(pixel)) / MAX_COLOR_VALUE;
+                        dstIt++;
+                    }
                 }
-            }
+            });
         } else {
             auto packFunc = getHDRPackingFunction();
             glm::uint32* dstIt = reinterpret_cast<glm::uint32*>( newImage.editBits() );
@@ -13,6 +13,11 @@
 
 #include <glm/gtc/packing.hpp>
 
+#include <deque>
+
+#include <tbb/task_arena.h>
+#include <tbb/task_group.h>
+
 #include <QtCore/QtGlobal>
 #include <QUrl>
 #include <QRgb>
@@ -23,6 +28,7 @@
 #include <Profile.h>
 #include <StatTracker.h>
 #include <GLMHelpers.h>
+#include <TBBHelpers.h>
 
 #include "TGAReader.h"
 #if !defined(Q_OS_ANDROID)
@@ -420,45 +426,53 @@ Image processSourceImage(Image&& srcImage, bool cubemap, BackendTarget target) {
     return localCopy;
 }
 
+static std::atomic<bool> parallelCompressionEnabled { true };
+
+void setParallelCompressionEnabled(bool enabled) {
+    parallelCompressionEnabled = enabled;
+}
+
+bool isParallelCompressionEnabled() {
+    return parallelCompressionEnabled;
+}
+
 #if defined(NVTT_API)
+// Writes a compressed mip straight into the storage that the texture keeps, rather than into a buffer that is copied.
+// The mips of a face are compressed concurrently, so they are only assigned to the texture once all are done.
 struct OutputHandler : public nvtt::OutputHandler {
-    OutputHandler(gpu::Texture* texture, int face) : _texture(texture), _face(face) {}
-
     virtual void beginImage(int size, int width, int height, int depth, int face, int miplevel) override {
-        _size = size;
-        _miplevel = miplevel;
-
-        _data = static_cast<gpu::Byte*>(malloc(size));
-        _current = _data;
+        _storage = std::make_shared<storage::MemoryStorage>(size);
+        _current = _storage->data();
     }
 
     virtual bool writeData(const void* data, int size) override {
-        assert(_current + size <= _data + _size);
+        assert(_current + size <= _storage->data() + _storage->size());
         memcpy(_current, data, size);
         _current += size;
         return true;
     }
 
     virtual void endImage() override {
-        if (_face >= 0) {
-            _texture->assignStoredMipFace(_miplevel, _face, _size, static_cast<const gpu::Byte*>(_data));
+    }
+
+    void assign(gpu::Texture* texture, int miplevel, int face) {
+        if (!_storage) {
+            return;
+        }
+        storage::StoragePointer storage = _storage;
+        if (face >= 0) {
+            texture->assignStoredMipFace(miplevel, face, storage);
         } else {
-            _texture->assignStoredMip(_miplevel, _size, static_cast<const gpu::Byte*>(_data));
+            texture->assignStoredMip(miplevel, storage);
         }
-        free(_data);
-        _data = nullptr;
     }
 
-    gpu::Byte* _data{ nullptr };
+    std::shared_ptr<storage::MemoryStorage> _storage;
     gpu::Byte* _current{ nullptr };
-    gpu::Texture* _texture{ nullptr };
-    int _miplevel = 0;
-    int _size = 0;
-    int _face = -1;
 };
 
 struct PackedFloatOutputHandler : public OutputHandler {
-    PackedFloatOutputHandler(gpu::Texture* texture, int face, gpu::Element format) : OutputHandler(texture, face) {
+    PackedFloatOutputHandler(gpu::Element format) {
         _packFunc = getHDRPackingFunction(format);
     }
 
@@ -500,68 +514,138 @@ struct MyErrorHandler : public nvtt::ErrorHandler {
     }
 };
 
-#if defined(NVTT_API)
 class SequentialTaskDispatcher : public nvtt::TaskDispatcher {
 public:
-    SequentialTaskDispatcher(const std::atomic<bool>& abortProcessing = false) : _abortProcessing(abortProcessing) {
+    SequentialTaskDispatcher(const std::atomic<bool>& abortProcessing) : _abortProcessing(abortProcessing) {
+    }
+
+    const std::atomic<bool>& _abortProcessing;
+
+    void dispatch(nvtt::Task* task, void* context, int count) override {
+        for (int i = 0; i < count && !_abortProcessing.load(); i++) {
+            task(context, i);
+        }
+    }
+};
+
+// Runs the tasks nvtt splits a compression into, one per row of blocks, over the TBB pool.
+class ParallelTaskDispatcher : public nvtt::TaskDispatcher {
+public:
+    ParallelTaskDispatcher(const std::atomic<bool>& abortProcessing) : _abortProcessing(abortProcessing) {
     }
 
     const std::atomic<bool>& _abortProcessing;
 
     void dispatch(nvtt::Task* task, void* context, int count) override {
-        for (int i = 0; i < count; i++) {
+        tbb::parallel_for(0, count, [&](int i) {
             if (!_abortProcessing.load()) {
                 task(context, i);
-            } else {
-                break;
             }
-        }
+        });
     }
 };
-#endif
+
+using OutputHandlerFactory = std::function<OutputHandler*()>;
+
+// Compresses the surface into the given mip of the texture face and, if buildMips is set, the mips below it.
+// Each mip is built from the one above it, so the chain is built on this thread, but each level is compressed on a
+// task of its own as soon as it's built, while the blocks of each level are spread over the pool by the dispatcher.
+void compressMips(gpu::Texture* texture, nvtt::Surface& surface, int face, int baseMipLevel, bool buildMips,
+                  const nvtt::CompressionOptions& compressionOptions, const OutputHandlerFactory& createOutputHandler,
+                  const std::atomic<bool>& abortProcessing) {
+    bool parallel = isParallelCompressionEnabled();
+    ParallelTaskDispatcher parallelDispatcher(abortProcessing);
+    SequentialTaskDispatcher sequentialDispatcher(abortProcessing);
+    nvtt::TaskDispatcher* dispatcher = parallel ? (nvtt::TaskDispatcher*)&parallelDispatcher : &sequentialDispatcher;
+    tbb::task_group tasks;
+    // the surfaces share their data until modified, and that sharing isn't thread-safe, so the copies are all made,
+    // modified and released on this thread, while the tasks only read them
+    std::deque<nvtt::Surface> levels;
+    std::vector<std::unique_ptr<OutputHandler>> outputHandlers;
+
+    while (true) {
+        int mipLevel = baseMipLevel + (int)levels.size();
+        levels.push_back(surface);
+        outputHandlers.emplace_back(createOutputHandler());
+        const nvtt::Surface* level = &levels.back();
+        OutputHandler* outputHandler = outputHandlers.back().get();
+        auto compressLevel = [&, mipLevel, level, outputHandler] {
+            if (abortProcessing.load()) {
+                return;
+            }
+            nvtt::OutputOptions outputOptions;
+            outputOptions.setOutputHeader(false);
+            outputOptions.setOutputHandler(outputHandler);
+            MyErrorHandler errorHandler;
+            outputOptions.setErrorHandler(&errorHandler);
+
+            nvtt::Context context;
+            context.setTaskDispatcher(dispatcher);
+            context.compress(*level, face, mipLevel, compressionOptions, outputOptions);
+        };
+        if (parallel) {
+            tasks.run(compressLevel);
+        } else {
+            compressLevel();
+        }
+
+        if (!buildMips || !surface.canMakeNextMipmap() || abortProcessing.load()) {
+            break;
+        }
+        surface.buildNextMipmap(nvtt::MipmapFilter_Box);
+    }
+    tasks.wait();
+
+    if (abortProcessing.load()) {
+        return;
+    }
+    for (size_t i = 0; i < outputHandlers.size(); i++) {
+        outputHandlers[i]->assign(texture, baseMipLevel + (int)i, face);
+    }
+}
+
+// The lines are converted in parallel, since these run over whole HDR textures and their mips
+static const int CONVERSION_LINES_PER_TASK = 16;
 
 void convertToFloatFromPacked(const unsigned char* source, int width, int height, size_t srcLineByteStride, gpu::Element sourceFormat,
                               glm::vec4* output, size_t outputLinePixelStride) {
-    glm::vec4* outputIt;
     auto unpackFunc = getHDRUnpackingFunction(sourceFormat);
 
-    outputLinePixelStride -= width;
-    outputIt = output;
-    for (auto lineNb = 0; lineNb < height; lineNb++) {
-        const uint32* srcPixelIt = reinterpret_cast<const uint32*>(source + lineNb * srcLineByteStride);
-        const uint32* srcPixelEnd = srcPixelIt + width;
+    tbb::parallel_for(tbb::blocked_range<int>(0, height, CONVERSION_LINES_PER_TASK), [&](const tbb::blocked_range<int>& range) {
+        for (auto lineNb = range.begin(); lineNb < range.end(); lineNb++) {
+            const uint32* srcPixelIt = reinterpret_cast<const uint32*>(source + lineNb * srcLineByteStride);
+            const uint32* srcPixelEnd = srcPixelIt + width;
+            glm::vec4* outputIt = output + lineNb * outputLinePixelStride;
 
-        while (srcPixelIt < srcPixelEnd) {
-            *outputIt = glm::vec4(unpackFunc(*srcPixelIt), 1.0f);
-            ++srcPixelIt;
-            ++outputIt;
+            while (srcPixelIt < srcPixelEnd) {
+                *outputIt = glm::vec4(unpackFunc(*srcPixelIt), 1.0f);
+                ++srcPixelIt;
+                ++outputIt;
+            }
         }
-        outputIt += outputLinePixelStride;
-    }
+    });
 }
 
 void convertToPackedFromFloat(unsigned char* output, int width, int height, size_t outputLineByteStride, gpu::Element outputFormat,
                               const glm::vec4* source, size_t srcLinePixelStride) {
-    const glm::vec4* sourceIt;
     auto packFunc = getHDRPackingFunction(outputFormat);
 
-    srcLinePixelStride -= width;
-    sourceIt = source;
-    for (auto lineNb = 0; lineNb < height; lineNb++) {
-        uint32* outPixelIt = reinterpret_cast<uint32*>(output + lineNb * outputLineByteStride);
-        uint32* outPixelEnd = outPixelIt + width;
+    tbb::parallel_for(tbb::blocked_range<int>(0, height, CONVERSION_LINES_PER_TASK), [&](const tbb::blocked_range<int>& range) {
+        for (auto lineNb = range.begin(); lineNb < range.end(); lineNb++) {
+            uint32* outPixelIt = reinterpret_cast<uint32*>(output + lineNb * outputLineByteStride);
+            uint32* outPixelEnd = outPixelIt + width;
+            const glm::vec4* sourceIt = source + lineNb * srcLinePixelStride;
 
-        while (outPixelIt < outPixelEnd) {
-            *outPixelIt = packFunc(*sourceIt);
-            ++outPixelIt;
-            ++sourceIt;
+            while (outPixelIt < outPixelEnd) {
+                *outPixelIt = packFunc(*sourceIt);
+                ++outPixelIt;
+                ++sourceIt;
+            }
         }
-        sourceIt += srcLinePixelStride;
-    }
+    });
 }
 
-nvtt::OutputHandler* getNVTTCompressionOutputHandler(gpu::Texture* outputTexture, int face, nvtt::CompressionOptions& compressionOptions) {
-    auto outputFormat = outputTexture->getStoredMipFormat();
+OutputHandlerFactory getNVTTCompressionOutputHandlerFactory(gpu::Element outputFormat, nvtt::CompressionOptions& compressionOptions) {
     bool useNVTT = false;
 
     compressionOptions.setQuality(nvtt::Quality_Production);
@@ -590,9 +674,9 @@ nvtt::OutputHandler* getNVTTCompressionOutputHandler(gpu::Texture* outputTexture
 
     if (!useNVTT) {
         // Don't use NVTT (at least version 2.1) as it outputs wrong RGB9E5 and R11G11B10F values from floats
-        return new PackedFloatOutputHandler(outputTexture, face, outputFormat);
+        return [outputFormat] { return new PackedFloatOutputHandler(outputFormat); };
     } else {
-        return new OutputHandler(outputTexture, face);
+        return [] { return new OutputHandler(); };
     }
 }
 
@@ -604,37 +688,20 @@ void convertImageToHDRTexture(gpu::Texture* texture, Image&& image, BackendTarge
     const int width = localCopy.getWidth();
     const int height = localCopy.getHeight();
 
-    nvtt::OutputOptions outputOptions;
-    outputOptions.setOutputHeader(false);
-
     nvtt::CompressionOptions compressionOptions;
-    std::unique_ptr<nvtt::OutputHandler> outputHandler{ getNVTTCompressionOutputHandler(texture, face, compressionOptions) };
-
-    MyErrorHandler errorHandler;
-    outputOptions.setErrorHandler(&errorHandler);
-    nvtt::Context context;
-    int mipLevel = baseMipLevel;
-
-    outputOptions.setOutputHandler(outputHandler.get());
+    auto createOutputHandler = getNVTTCompressionOutputHandlerFactory(texture->getStoredMipFormat(), compressionOptions);
 
     nvtt::Surface surface;
     surface.setImage(nvtt::InputFormat_RGBA_32F, width, height, 1, localCopy.getBits());
     surface.setAlphaMode(nvtt::AlphaMode_None);
     surface.setWrapMode(nvtt::WrapMode_Mirror);
 
-    SequentialTaskDispatcher dispatcher(abortProcessing);
-    nvtt::Compressor compressor;
-    context.setTaskDispatcher(&dispatcher);
-
-    context.compress(surface, face, mipLevel++, compressionOptions, outputOptions);
-    if (buildMips) {
-        while (surface.canMakeNextMipmap() && !abortProcessing.load()) {
-            surface.buildNextMipmap(nvtt::MipmapFilter_Box);
-            context.compress(surface, face, mipLevel++, compressionOptions, outputOptions);
-        }
-    }
+    compressMips(texture, surface, face, baseMipLevel, buildMips, compressionOptions, createOutputHandler, abortProcessing);
 }
 
+// the ETC2 encodes running at once, across all the threads processing textures
+static std::atomic<int> etcEncodesInFlight { 0 };
+
 void convertImageToLDRTexture(gpu::Texture* texture, Image&& image, BackendTarget target, int baseMipLevel, bool buildMips, const std::atomic<bool>& abortProcessing, int face) {
     // Take a local copy to force move construction
     // https://github.com/isocpp/CppCoreGuidelines/blob/master/CppCoreGuidelines.md#f18-for-consume-parameters-pass-by-x-and-stdmove-the-parameter
@@ -752,23 +819,8 @@ void convertImageToLDRTexture(gpu::Texture* texture, Image&& image, BackendTarge
             return;
         }
 
-        nvtt::OutputOptions outputOptions;
-        outputOptions.setOutputHeader(false);
-        OutputHandler outputHandler(texture, face);
-        outputOptions.setOutputHandler(&outputHandler);
-        MyErrorHandler errorHandler;
-        outputOptions.setErrorHandler(&errorHandler);
-
-        SequentialTaskDispatcher dispatcher(abortProcessing);
-        nvtt::Compressor context;
-
-        context.compress(surface, face, mipLevel++, compressionOptions, outputOptions);
-        if (buildMips) {
-            while (surface.canMakeNextMipmap() && !abortProcessing.load()) {
-                surface.buildNextMipmap(nvtt::MipmapFilter_Box);
-                context.compress(surface, face, mipLevel++, compressionOptions, outputOptions);
-            }
-        }
+        compressMips(texture, surface, face, mipLevel, buildMips, compressionOptions, [] { return new OutputHandler(); },
+                     abortProcessing);
     } else {
         int numMips = 1;
     
@@ -807,7 +859,12 @@ void convertImageToLDRTexture(gpu::Texture* texture, Image&& image, BackendTarge
 
         const Etc::ErrorMetric errorMetric = Etc::ErrorMetric::RGBA;
         const float effort = 1.0f;
-        const int numEncodeThreads = 4;
+        // ETC2 encodes the blocks of each mip on threads of its own, outside the TBB pool, so the textures being
+        // encoded at once split the pool's size between them rather than each starting a thread per core
+        const int numEncodes = ++etcEncodesInFlight;
+        Finally endEncode([] { --etcEncodesInFlight; });
+        const int numEncodeThreads = isParallelCompressionEnabled() ?
+            std::max(tbb::this_task_arena::max_concurrency() / numEncodes, 1) : 1;
         int encodingTime;
 
         if (localCopy.getFormat() != Image::Format_RGBAF) {
@@ -28,6 +28,11 @@ namespace image {
     void convertToPackedFromFloat(unsigned char* output, int width, int height, size_t outputLineByteStride, gpu::Element outputFormat,
                           const glm::vec4* source, size_t srcLinePixelStride);
 
+    // Compression spreads the mips and blocks of a texture over the thread pool, unless this is turned off, in which
+    // case it all runs on the calling thread.  Either way produces the same bytes
+    void setParallelCompressionEnabled(bool enabled);
+    bool isParallelCompressionEnabled();
+
 namespace TextureUsage {
 
 /**jsdoc
@@ -246,6 +246,32 @@ size_t KTXDescriptor::getMipFaceTexelsOffset(uint16_t mip, uint8_t face) const {
     return result;
 }
 
+uint16_t KTXDescriptor::getLowestMipInRange(uint16_t highMip, uint16_t lowestMip, size_t maxRangeSize) const {
+    uint16_t lowMip = highMip;
+    size_t rangeSize = images[highMip]._imageSize;
+    while (lowMip > lowestMip) {
+        size_t mipSize = images[lowMip - 1]._imageSize + images[lowMip - 1]._padding + IMAGE_SIZE_WIDTH;
+        if (rangeSize + mipSize > maxRangeSize) {
+            break;
+        }
+        rangeSize += mipSize;
+        lowMip--;
+    }
+    return lowMip;
+}
+
+std::pair<size_t, size_t> KTXDescriptor::getMipRangeBytes(uint16_t lowMip, uint16_t highMip) const {
+    // the image offsets are from the start of the images, and each image starts with its size
+    size_t imagesOffset = KTX_HEADER_SIZE + header.bytesOfKeyValueData;
+    size_t start = imagesOffset + images[lowMip]._imageOffset + IMAGE_SIZE_WIDTH;
+    size_t end = imagesOffset + images[highMip]._imageOffset + IMAGE_SIZE_WIDTH + images[highMip]._imageSize;
+    return { start, end };
+}
+
+size_t KTXDescriptor::getMipOffsetInRange(uint16_t mip, uint16_t lowMip) const {
+    return images[mip]._imageOffset - images[lowMip]._imageOffset;
+}
+
 ImageDescriptor Image::toImageDescriptor(const Byte* baseAddress) const {
     FaceOffsets offsets;
     offsets.resize(_faceBytes.size());
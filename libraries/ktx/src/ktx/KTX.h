@@ -18,6 +18,7 @@
 #include <cstdint>
 #include <cstring>
 #include <string>
+#include <utility>
 #include <memory>
 
 #include <shared/Storage.h>
@@ -322,6 +323,15 @@ namespace ktx {
         size_t getMipFaceTexelsSize(uint16_t mip = 0, uint8_t face = 0) const;
         size_t getMipFaceTexelsOffset(uint16_t mip = 0, uint8_t face = 0) const;
         size_t getValueOffsetForKey(const std::string& key) const;
+
+        // The mips of a KTX are stored one after the other, so a range of them [lowMip, highMip] can be fetched as one
+        // range of bytes, from the start of lowMip's data to the end of highMip's, with the sizes of the others in between.
+        // Returns the lowest mip, no lower than lowestMip, of a range ending at highMip that fits in maxRangeSize bytes
+        uint16_t getLowestMipInRange(uint16_t highMip, uint16_t lowestMip, size_t maxRangeSize) const;
+        // the offsets in the KTX of the first byte of the range, and of the one after its last
+        std::pair<size_t, size_t> getMipRangeBytes(uint16_t lowMip, uint16_t highMip) const;
+        // the offset of a mip's data in that of a range starting at lowMip
+        size_t getMipOffsetInRange(uint16_t mip, uint16_t lowMip) const;
     };
 
     class KTX {
@@ -13,7 +13,6 @@
 
 #include <mutex>
 
-#include <QtConcurrent/QtConcurrentRun>
 
 #include <QCryptographicHash>
 #include <QImageReader>
@@ -64,6 +63,10 @@ const std::string TextureCache::KTX_DIRNAME{ "ktx_cache" };
 #endif
 const std::string TextureCache::KTX_EXT { "ktx" };
 
+// The mips above the ones already loaded are next to each other in a KTX, so those up to this size are fetched in one
+// range, rather than with a round trip each
+static const size_t MAX_MIP_RANGE_BYTES = 256 * BYTES_PER_KILOBYTE;
+
 /**jsdoc
  * <p>The views that may be visible on the PC display.</p>
  * <table>
@@ -525,7 +528,7 @@ void NetworkTexture::makeRequest() {
 
     if (isLocalUrl(_activeUrl)) {
         auto self = _self;
-        QtConcurrent::run(QThreadPool::globalInstance(), [self] {
+        Resource::scheduleJob(JobScheduler::TEXTURE, self, [self] {
             auto resource = self.lock();
             if (!resource) {
                 return;
@@ -567,6 +570,7 @@ void NetworkTexture::makeRequest() {
         connect(_ktxHeaderRequest, &ResourceRequest::finished, this, &NetworkTexture::ktxInitialDataRequestFinished);
 
         _bytesReceived = _bytesTotal = _bytes = 0;
+        _ktxRequestStartTime = usecTimestampNow();
 
         _ktxHeaderRequest->send();
 
@@ -577,9 +581,11 @@ void NetworkTexture::makeRequest() {
 
             // Add a fragment to the base url so we can identify the section of the ktx being requested when debugging
             // The actual requested url is _activeUrl and will not contain the fragment
-            uint16_t nextMip = _lowestKnownPopulatedMip - 1;
-            _url.setFragment(QString::number(nextMip));
-            startMipRangeRequest(nextMip, nextMip);
+            uint16_t highMip = _lowestKnownPopulatedMip - 1;
+            uint16_t lowMip = _originalKtxDescriptor->getLowestMipInRange(highMip, std::min(_lowestRequestedMipLevel, highMip),
+                                                                          MAX_MIP_RANGE_BYTES);
+            _url.setFragment(QString::number(lowMip) + "-" + QString::number(highMip));
+            startMipRangeRequest(lowMip, highMip);
         }
     } else {
         qWarning(networking) << "NetworkTexture::makeRequest() called while not in a valid state: " << _ktxResourceState;
@@ -725,10 +731,9 @@ void NetworkTexture::startMipRangeRequest(uint16_t low, uint16_t high) {
         connect(_ktxMipRequest, &ResourceRequest::finished, this, &NetworkTexture::ktxInitialDataRequestFinished);
     } else {
         ByteRange range;
-        range.fromInclusive = ktx::KTX_HEADER_SIZE + _originalKtxDescriptor->header.bytesOfKeyValueData
-                              + _originalKtxDescriptor->images[low]._imageOffset + ktx::IMAGE_SIZE_WIDTH;
-        range.toExclusive = ktx::KTX_HEADER_SIZE + _originalKtxDescriptor->header.bytesOfKeyValueData
-                              + _originalKtxDescriptor->images[high + 1]._imageOffset;
+        auto rangeBytes = _originalKtxDescriptor->getMipRangeBytes(low, high);
+        range.fromInclusive = rangeBytes.first;
+        range.toExclusive = rangeBytes.second;
         _ktxMipRequest->setByteRange(range);
 
         connect(_ktxMipRequest, &ResourceRequest::finished, this, &NetworkTexture::ktxMipRequestFinished);
@@ -769,6 +774,12 @@ void NetworkTexture::ktxInitialDataRequestFinished() {
 
         _ktxHeaderData = _ktxHeaderRequest->getData();
         _ktxHighMipData = _ktxMipRequest->getData();
+
+        auto textureCache = DependencyManager::get<TextureCache>();
+        textureCache->_numStreamedTextures++;
+        textureCache->_totalTimeToFirstMip += usecTimestampNow() - _ktxRequestStartTime;
+        textureCache->_totalStreamedBytes += _ktxHeaderData.size() + _ktxHighMipData.size();
+
         handleFinishedInitialLoad();
     } else {
         if (Resource::handleFailedRequest(result)) {
@@ -814,19 +825,25 @@ void NetworkTexture::ktxMipRequestFinished() {
 
         if (_ktxResourceState == REQUESTING_MIP) {
             Q_ASSERT(_ktxMipLevelRangeInFlight.first != NULL_MIP_LEVEL);
-            Q_ASSERT(_ktxMipLevelRangeInFlight.second - _ktxMipLevelRangeInFlight.first == 0);
+            Q_ASSERT(_ktxMipLevelRangeInFlight.second >= _ktxMipLevelRangeInFlight.first);
 
             _ktxResourceState = WAITING_FOR_MIP_REQUEST;
 
             auto self = _self;
             auto url = _url;
             auto data = _ktxMipRequest->getData();
-            auto mipLevel = _ktxMipLevelRangeInFlight.first;
+            auto lowMip = _ktxMipLevelRangeInFlight.first;
+            auto highMip = _ktxMipLevelRangeInFlight.second;
             auto texture = _textureSource->getGPUTexture();
-            DependencyManager::get<StatTracker>()->incrementStat("PendingProcessing");
-            QtConcurrent::run(QThreadPool::globalInstance(), [self, data, mipLevel, url, texture] {
+            // the offset and size of each mip of the range in its data
+            std::vector<std::pair<size_t, size_t>> mipBytes;
+            for (uint16_t mip = lowMip; mip <= highMip; mip++) {
+                mipBytes.push_back({ _originalKtxDescriptor->getMipOffsetInRange(mip, lowMip),
+                                     _originalKtxDescriptor->images[mip]._imageSize });
+            }
+            DependencyManager::get<TextureCache>()->_totalStreamedBytes += data.size();
+            Resource::scheduleJob(JobScheduler::TEXTURE, self, [self, data, lowMip, highMip, mipBytes, url, texture] {
                 PROFILE_RANGE_EX(resource_parse_image, "NetworkTexture - Processing Mip Data", 0xffff0000, 0, { { "url", url.toString() } });
-                DependencyManager::get<StatTracker>()->decrementStat("PendingProcessing");
                 CounterStat counter("Processing");
 
                 auto originalPriority = QThread::currentThread()->priority();
@@ -844,11 +861,20 @@ void NetworkTexture::ktxMipRequestFinished() {
 
                 Q_ASSERT_X(texture, "Async - NetworkTexture::ktxMipRequestFinished", "NetworkTexture should have been assigned a GPU texture by now.");
 
-                texture->assignStoredMip(mipLevel, data.size(), reinterpret_cast<const uint8_t*>(data.data()));
+                // from the smallest up, since a mip is only available once the ones above it are
+                for (int mipLevel = highMip; mipLevel >= lowMip; mipLevel--) {
+                    size_t offset = mipBytes[mipLevel - lowMip].first;
+                    size_t size = mipBytes[mipLevel - lowMip].second;
+                    if (offset + size > (size_t)data.size()) {
+                        qWarning(networking) << "Mip range too short for mip" << mipLevel << "of" << url;
+                        return;
+                    }
+                    texture->assignStoredMip(mipLevel, size, reinterpret_cast<const uint8_t*>(data.data()) + offset);
+                }
 
-                // If mip level assigned above is still unavailable, then we assume future requests will also fail.
+                // If mip levels assigned above are still unavailable, then we assume future requests will also fail.
                 auto minMipLevel = texture->minAvailableMipLevel();
-                if (minMipLevel > mipLevel) {
+                if (minMipLevel > lowMip) {
                     return;
                 }
 
@@ -891,10 +917,8 @@ void NetworkTexture::handleFinishedInitialLoad() {
 
     auto self = _self;
     auto url = _url;
-    DependencyManager::get<StatTracker>()->incrementStat("PendingProcessing");
-    QtConcurrent::run(QThreadPool::globalInstance(), [self, ktxHeaderData, ktxHighMipData, url] {
+    Resource::scheduleJob(JobScheduler::TEXTURE, self, [self, ktxHeaderData, ktxHighMipData, url] {
         PROFILE_RANGE_EX(resource_parse_image, "NetworkTexture - Processing Initial Data", 0xffff0000, 0, { { "url", url.toString() } });
-        DependencyManager::get<StatTracker>()->decrementStat("PendingProcessing");
         CounterStat counter("Processing");
 
         auto originalPriority = QThread::currentThread()->priority();
@@ -1127,7 +1151,7 @@ void NetworkTexture::loadTextureContent(const QByteArray& content) {
         return;
     }
 
-    QThreadPool::globalInstance()->start(new ImageReader(_self, _url, content, _extraHash, _maxNumPixels, _sourceChannel));
+    Resource::scheduleJob(JobScheduler::TEXTURE, _self, new ImageReader(_self, _url, content, _extraHash, _maxNumPixels, _sourceChannel));
 }
 
 void NetworkTexture::refresh() {
@@ -1160,7 +1184,6 @@ ImageReader::ImageReader(const QWeakPointer<Resource>& resource, const QUrl& url
     _maxNumPixels(maxNumPixels),
     _sourceChannel(sourceChannel)
 {
-    DependencyManager::get<StatTracker>()->incrementStat("PendingProcessing");
     listSupportedImageFormats();
 
 #if DEBUG_DUMP_TEXTURE_LOADS
@@ -1193,7 +1216,6 @@ void ImageReader::listSupportedImageFormats() {
 
 void ImageReader::run() {
     PROFILE_RANGE_EX(resource_parse_image, __FUNCTION__, 0xffff0000, 0, { { "url", _url.toString() } });
-    DependencyManager::get<StatTracker>()->decrementStat("PendingProcessing");
     CounterStat counter("Processing");
 
     auto originalPriority = QThread::currentThread()->priority();
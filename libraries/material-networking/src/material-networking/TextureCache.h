@@ -12,6 +12,8 @@
 #ifndef hifi_TextureCache_h
 #define hifi_TextureCache_h
 
+#include <atomic>
+
 #include <gpu/Texture.h>
 
 #include <QImage>
@@ -130,6 +132,8 @@ private:
     uint16_t _lowestRequestedMipLevel { NULL_MIP_LEVEL };
     uint16_t _lowestKnownPopulatedMip { NULL_MIP_LEVEL };
 
+    quint64 _ktxRequestStartTime { 0 };
+
     // This is a copy of the original KTX descriptor from the source url.
     // We need this because the KTX that will be cached will likely include extra data
     // in its key/value data, and so will not match up with the original, causing
@@ -198,6 +202,11 @@ public:
     void setGPUContext(const gpu::ContextPointer& context) { _gpuContext = context; }
     gpu::ContextPointer getGPUContext() const { return _gpuContext; }
 
+    /// How long streamed KTX textures took, on average, from their first request until their first mips were in,
+    /// and how many bytes of each were streamed.
+    quint64 getAverageTimeToFirstMip() const { return _numStreamedTextures > 0 ? _totalTimeToFirstMip / _numStreamedTextures : 0; }
+    quint64 getAverageStreamedBytesPerTexture() const { return _numStreamedTextures > 0 ? _totalStreamedBytes / _numStreamedTextures : 0; }
+
 signals:
     void spectatorCameraFramebufferReset();
 
@@ -225,6 +234,10 @@ private:
 
     std::shared_ptr<cache::FileCache> _ktxCache { std::make_shared<KTXCache>(KTX_DIRNAME, KTX_EXT) };
 
+    std::atomic<quint64> _numStreamedTextures { 0 };
+    std::atomic<quint64> _totalTimeToFirstMip { 0 };
+    std::atomic<quint64> _totalStreamedBytes { 0 };
+
     // Map from image hashes to texture weak pointers
     std::unordered_map<std::string, std::weak_ptr<gpu::Texture>> _texturesByHashes;
     std::mutex _texturesByHashesMutex;
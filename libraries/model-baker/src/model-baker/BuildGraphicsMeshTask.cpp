@@ -14,6 +14,8 @@
 #include <glm/gtc/packing.hpp>
 
 #include <LogHandler.h>
+#include <TBBHelpers.h>
+
 #include "ModelBakerLogging.h"
 #include "ModelMath.h"
 
@@ -380,20 +382,23 @@ void BuildGraphicsMeshTask::run(const baker::BakeContextPointer& context, const
 
     auto& graphicsMeshes = output;
 
+    const std::string urlString = url.toString().toStdString();
+
+    // Each mesh is built into its own slot, so the meshes can be processed in parallel
     int n = (int)meshes.size();
-    for (int i = 0; i < n; i++) {
-        graphicsMeshes.emplace_back();
+    graphicsMeshes.resize(n);
+    tbb::parallel_for(0, n, [&](int i) {
         auto& graphicsMesh = graphicsMeshes[i];
-        
+
         // Try to create the graphics::Mesh
         buildGraphicsMesh(meshes[i], graphicsMesh, baker::safeGet(normalsPerMesh, i), baker::safeGet(tangentsPerMesh, i));
 
         // Choose a name for the mesh
         if (graphicsMesh) {
-            graphicsMesh->displayName = url.toString().toStdString() + "#/mesh/" + std::to_string(i);
+            graphicsMesh->displayName = urlString + "#/mesh/" + std::to_string(i);
             if (meshIndicesToModelNames.find(i) != meshIndicesToModelNames.cend()) {
                 graphicsMesh->modelName = meshIndicesToModelNames[i].toStdString();
             }
         }
-    }
+    });
 }
@@ -39,83 +39,8 @@ namespace baker {
         return vector[i];
     }
 
-    void setTangent(const HFMMesh& mesh, const IndexAccessor& vertexAccessor, int firstIndex, int secondIndex) {
-        glm::vec3 vertex[2];
-        glm::vec2 texCoords[2];
-        glm::vec3 normal;
-        glm::vec3* tangent = vertexAccessor(firstIndex, secondIndex, vertex, texCoords, normal);
-        if (tangent) {
-            glm::vec3 bitangent = glm::cross(normal, vertex[1] - vertex[0]);
-            if (glm::length(bitangent) < EPSILON) {
-                return;
-            }
-            glm::vec2 texCoordDelta = texCoords[1] - texCoords[0];
-            glm::vec3 normalizedNormal = glm::normalize(normal);
-            *tangent += glm::cross(glm::angleAxis(-atan2f(-texCoordDelta.t, texCoordDelta.s), normalizedNormal) *
-                glm::normalize(bitangent), normalizedNormal);
-        }
-    }
-
-    void calculateNormals(const hfm::Mesh& mesh, NormalAccessor normalAccessor, VertexSetter vertexSetter) {
+    void warnIndicesNotDivisibleByThree(const char* function) {
         static int repeatMessageID = LogHandler::getInstance().newRepeatedMessageID();
-        for (const HFMMeshPart& part : mesh.parts) {
-            for (int i = 0; i < part.quadIndices.size(); i += 4) {
-                glm::vec3* n0 = normalAccessor(part.quadIndices[i]);
-                glm::vec3* n1 = normalAccessor(part.quadIndices[i + 1]);
-                glm::vec3* n2 = normalAccessor(part.quadIndices[i + 2]);
-                glm::vec3* n3 = normalAccessor(part.quadIndices[i + 3]);
-                if (!n0 || !n1 || !n2 || !n3) {
-                    // Quad is not in the mesh (can occur with blendshape meshes, which are a subset of the hfm Mesh vertices)
-                    continue;
-                }
-                glm::vec3 vertices[3]; // Assume all vertices in this quad are in the same plane, so only the first three are needed to calculate the normal
-                vertexSetter(part.quadIndices[i], vertices[0]);
-                vertexSetter(part.quadIndices[i + 1], vertices[1]);
-                vertexSetter(part.quadIndices[i + 2], vertices[2]);
-                *n0 = *n1 = *n2 = *n3 = glm::cross(vertices[1] - vertices[0], vertices[2] - vertices[0]);
-            }
-            // <= size - 3 in order to prevent overflowing triangleIndices when (i % 3) != 0
-            // This is most likely evidence of a further problem in extractMesh()
-            for (int i = 0; i <= part.triangleIndices.size() - 3; i += 3) {
-                glm::vec3* n0 = normalAccessor(part.triangleIndices[i]);
-                glm::vec3* n1 = normalAccessor(part.triangleIndices[i + 1]);
-                glm::vec3* n2 = normalAccessor(part.triangleIndices[i + 2]);
-                if (!n0 || !n1 || !n2) {
-                    // Tri is not in the mesh (can occur with blendshape meshes, which are a subset of the hfm Mesh vertices)
-                    continue;
-                }
-                glm::vec3 vertices[3];
-                vertexSetter(part.triangleIndices[i], vertices[0]);
-                vertexSetter(part.triangleIndices[i + 1], vertices[1]);
-                vertexSetter(part.triangleIndices[i + 2], vertices[2]);
-                *n0 = *n1 = *n2 = glm::cross(vertices[1] - vertices[0], vertices[2] - vertices[0]);
-            }
-            if ((part.triangleIndices.size() % 3) != 0) {
-                HIFI_FCDEBUG_ID(model_baker(), repeatMessageID, "Error in baker::calculateNormals: part.triangleIndices.size() is not divisible by three");
-            }
-        }
-    }
-
-    void calculateTangents(const hfm::Mesh& mesh, IndexAccessor accessor) {
-        static int repeatMessageID = LogHandler::getInstance().newRepeatedMessageID();
-        for (const HFMMeshPart& part : mesh.parts) {
-            for (int i = 0; i < part.quadIndices.size(); i += 4) {
-                setTangent(mesh, accessor, part.quadIndices.at(i), part.quadIndices.at(i + 1));
-                setTangent(mesh, accessor, part.quadIndices.at(i + 1), part.quadIndices.at(i + 2));
-                setTangent(mesh, accessor, part.quadIndices.at(i + 2), part.quadIndices.at(i + 3));
-                setTangent(mesh, accessor, part.quadIndices.at(i + 3), part.quadIndices.at(i));
-            }
-            // <= size - 3 in order to prevent overflowing triangleIndices when (i % 3) != 0
-            // This is most likely evidence of a further problem in extractMesh()
-            for (int i = 0; i <= part.triangleIndices.size() - 3; i += 3) {
-                setTangent(mesh, accessor, part.triangleIndices.at(i), part.triangleIndices.at(i + 1));
-                setTangent(mesh, accessor, part.triangleIndices.at(i + 1), part.triangleIndices.at(i + 2));
-                setTangent(mesh, accessor, part.triangleIndices.at(i + 2), part.triangleIndices.at(i));
-            }
-            if ((part.triangleIndices.size() % 3) != 0) {
-                HIFI_FCDEBUG_ID(model_baker(), repeatMessageID, "Error in baker::calculateTangents: part.triangleIndices.size() is not divisible by three");
-            }
-        }
+        HIFI_FCDEBUG_ID(model_baker(), repeatMessageID, "Error in baker::" << function << ": part.triangleIndices.size() is not divisible by three");
     }
 }
-
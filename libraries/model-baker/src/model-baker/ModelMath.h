@@ -9,6 +9,11 @@
 //  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
 //
 
+#ifndef hifi_ModelMath_h
+#define hifi_ModelMath_h
+
+#include <NumericalConstants.h>
+
 #include <hfm/HFM.h>
 
 #include "BakerTypes.h"
@@ -36,21 +41,114 @@ namespace baker {
         }
     }
 
-    // Returns a reference to the normal at the specified index, or nullptr if it cannot be accessed
-    using NormalAccessor = std::function<glm::vec3*(int index)>;
+    void warnIndicesNotDivisibleByThree(const char* function);
 
-    // Assigns a vertex to outVertex given the lookup index
-    using VertexSetter = std::function<void(int index, glm::vec3& outVertex)>;
+    // The accessors are template parameters rather than std::functions, so that they inline into the per-face loops,
+    // which run for every mesh and blendshape of a model.
+    //
+    // normalAccessor: glm::vec3*(int index), returns the normal at the specified index, or nullptr if it cannot be accessed
+    // vertexSetter: void(int index, glm::vec3& outVertex), assigns a vertex to outVertex given the lookup index
+    template <typename NormalAccessor, typename VertexSetter>
+    void calculateNormals(const hfm::Mesh& mesh, NormalAccessor normalAccessor, VertexSetter vertexSetter) {
+        for (const HFMMeshPart& part : mesh.parts) {
+            for (int i = 0; i < part.quadIndices.size(); i += 4) {
+                glm::vec3* n0 = normalAccessor(part.quadIndices[i]);
+                glm::vec3* n1 = normalAccessor(part.quadIndices[i + 1]);
+                glm::vec3* n2 = normalAccessor(part.quadIndices[i + 2]);
+                glm::vec3* n3 = normalAccessor(part.quadIndices[i + 3]);
+                if (!n0 || !n1 || !n2 || !n3) {
+                    // Quad is not in the mesh (can occur with blendshape meshes, which are a subset of the hfm Mesh vertices)
+                    continue;
+                }
+                glm::vec3 vertices[3]; // Assume all vertices in this quad are in the same plane, so only the first three are needed to calculate the normal
+                vertexSetter(part.quadIndices[i], vertices[0]);
+                vertexSetter(part.quadIndices[i + 1], vertices[1]);
+                vertexSetter(part.quadIndices[i + 2], vertices[2]);
+                *n0 = *n1 = *n2 = *n3 = glm::cross(vertices[1] - vertices[0], vertices[2] - vertices[0]);
+            }
+            // <= size - 3 in order to prevent overflowing triangleIndices when (i % 3) != 0
+            // This is most likely evidence of a further problem in extractMesh()
+            for (int i = 0; i <= part.triangleIndices.size() - 3; i += 3) {
+                glm::vec3* n0 = normalAccessor(part.triangleIndices[i]);
+                glm::vec3* n1 = normalAccessor(part.triangleIndices[i + 1]);
+                glm::vec3* n2 = normalAccessor(part.triangleIndices[i + 2]);
+                if (!n0 || !n1 || !n2) {
+                    // Tri is not in the mesh (can occur with blendshape meshes, which are a subset of the hfm Mesh vertices)
+                    continue;
+                }
+                glm::vec3 vertices[3];
+                vertexSetter(part.triangleIndices[i], vertices[0]);
+                vertexSetter(part.triangleIndices[i + 1], vertices[1]);
+                vertexSetter(part.triangleIndices[i + 2], vertices[2]);
+                *n0 = *n1 = *n2 = glm::cross(vertices[1] - vertices[0], vertices[2] - vertices[0]);
+            }
+            if ((part.triangleIndices.size() % 3) != 0) {
+                warnIndicesNotDivisibleByThree("calculateNormals");
+            }
+        }
+    }
+
+    // The tangent contribution of the edge from vertex[0] to vertex[1], with the given texture coordinates, to a vertex with the given normal:
+    // the edge's bitangent, rotated about the normal by the angle of the texture coordinate delta, then crossed with the normal.
+    // The rotation is done in closed form, since the bitangent is perpendicular to the normal, rather than through atan2 and a quaternion.
+    // Returns false if the edge is degenerate and contributes nothing.
+    inline bool calculateTangent(const glm::vec3 vertex[2], const glm::vec2 texCoords[2], const glm::vec3& normal, glm::vec3& outTangent) {
+        glm::vec3 bitangent = glm::cross(normal, vertex[1] - vertex[0]);
+        float bitangentLength = glm::length(bitangent);
+        if (bitangentLength < EPSILON) {
+            return false;
+        }
+        bitangent /= bitangentLength;
+        glm::vec3 normalizedNormal = glm::normalize(normal);
+        glm::vec2 texCoordDelta = texCoords[1] - texCoords[0];
+        float texCoordLength = glm::length(texCoordDelta);
+        glm::vec3 rotated = bitangent;
+        if (texCoordLength > 0.0f) {
+            rotated = (bitangent * texCoordDelta.s + glm::cross(normalizedNormal, bitangent) * texCoordDelta.t) / texCoordLength;
+        }
+        outTangent = glm::cross(rotated, normalizedNormal);
+        return true;
+    }
 
-    void calculateNormals(const hfm::Mesh& mesh, NormalAccessor normalAccessor, VertexSetter vertexAccessor);
+    // accessor: glm::vec3*(int firstIndex, int secondIndex, glm::vec3* outVertices, glm::vec2* outTexCoords, glm::vec3& outNormal)
+    //  firstIndex, secondIndex: the vertex indices to be used for calculation
+    //  outVertices: should be assigned a 2 element array containing the vertices at firstIndex and secondIndex
+    //  outTexCoords: same as outVertices but for texture coordinates
+    //  outNormal: reference to the normal of this triangle
+    //  Return value: pointer to the tangent you want to be calculated
+    template <typename IndexAccessor>
+    void setTangent(IndexAccessor& accessor, int firstIndex, int secondIndex) {
+        glm::vec3 vertex[2];
+        glm::vec2 texCoords[2];
+        glm::vec3 normal;
+        glm::vec3* tangent = accessor(firstIndex, secondIndex, vertex, texCoords, normal);
+        glm::vec3 contribution;
+        if (tangent && calculateTangent(vertex, texCoords, normal, contribution)) {
+            *tangent += contribution;
+        }
+    }
 
-    // firstIndex, secondIndex: the vertex indices to be used for calculation
-    // outVertices: should be assigned a 2 element array containing the vertices at firstIndex and secondIndex
-    // outTexCoords: same as outVertices but for texture coordinates
-    // outNormal: reference to the normal of this triangle
-    //
-    // Return value: pointer to the tangent you want to be calculated
-    using IndexAccessor = std::function<glm::vec3*(int firstIndex, int secondIndex, glm::vec3* outVertices, glm::vec2* outTexCoords, glm::vec3& outNormal)>;
+    template <typename IndexAccessor>
+    void calculateTangents(const hfm::Mesh& mesh, IndexAccessor accessor) {
+        for (const HFMMeshPart& part : mesh.parts) {
+            for (int i = 0; i < part.quadIndices.size(); i += 4) {
+                setTangent(accessor, part.quadIndices.at(i), part.quadIndices.at(i + 1));
+                setTangent(accessor, part.quadIndices.at(i + 1), part.quadIndices.at(i + 2));
+                setTangent(accessor, part.quadIndices.at(i + 2), part.quadIndices.at(i + 3));
+                setTangent(accessor, part.quadIndices.at(i + 3), part.quadIndices.at(i));
+            }
+            // <= size - 3 in order to prevent overflowing triangleIndices when (i % 3) != 0
+            // This is most likely evidence of a further problem in extractMesh()
+            for (int i = 0; i <= part.triangleIndices.size() - 3; i += 3) {
+                setTangent(accessor, part.triangleIndices.at(i), part.triangleIndices.at(i + 1));
+                setTangent(accessor, part.triangleIndices.at(i + 1), part.triangleIndices.at(i + 2));
+                setTangent(accessor, part.triangleIndices.at(i + 2), part.triangleIndices.at(i));
+            }
+            if ((part.triangleIndices.size() % 3) != 0) {
+                warnIndicesNotDivisibleByThree("calculateTangents");
+            }
+        }
+    }
+}
 
-    void calculateTangents(const hfm::Mesh& mesh, IndexAccessor accessor);
-};
+#endif // hifi_ModelMath_h
@@ -16,8 +16,6 @@
 #include <gpu/Batch.h>
 #include <gpu/Stream.h>
 
-#include <QThreadPool>
-
 #include <Gzip.h>
 
 #include "ModelNetworkingLogging.h"
@@ -27,6 +25,7 @@
 #include <FBXSerializer.h>
 #include <OBJSerializer.h>
 #include <GLTFSerializer.h>
+#include <HFMBlobSerializer.h>
 #include <model-baker/Baker.h>
 
 Q_LOGGING_CATEGORY(trace_resource_parse_geometry, "trace.resource.parse.geometry")
@@ -39,6 +38,7 @@ public:
 };
 
 int geometryMappingPairTypeId = qRegisterMetaType<GeometryMappingPair>("GeometryMappingPair");
+int geometryBlendshapesPointerTypeId = qRegisterMetaType<Geometry::BlendshapesPointer>("Geometry::BlendshapesPointer");
 
 // From: https://stackoverflow.com/questions/41145012/how-to-hash-qvariant
 class QVariantHasher {
@@ -85,13 +85,35 @@ namespace std {
     };
 }
 
+// pack the blendshapes of each mesh, so that blending only touches the vertices that move
+static Geometry::BlendshapesPointer buildBlendshapes(const HFMModel& hfmModel) {
+    if (!hfmModel.hasBlendedMeshes()) {
+        return nullptr;
+    }
+
+    // normal and tangent offsets are blended at a smaller scale than positions
+    const float NORMAL_COEFFICIENT_SCALE = 0.01f;
+
+    auto blendshapes = std::make_shared<Geometry::GeometryBlendshapes>();
+    blendshapes->reserve(hfmModel.meshes.size());
+    for (const HFMMesh& mesh : hfmModel.meshes) {
+        blendshapes->emplace_back(mesh.vertices.size());
+        auto& deltas = blendshapes->back();
+        for (const HFMBlendshape& blendshape : mesh.blendshapes) {
+            int numIndices = std::min({ blendshape.indices.size(), blendshape.vertices.size(), blendshape.normals.size() });
+            deltas.addBlendshape(blendshape.indices.constData(), blendshape.vertices.constData(), blendshape.normals.constData(),
+                                 numIndices, blendshape.tangents.constData(), blendshape.tangents.size(),
+                                 NORMAL_COEFFICIENT_SCALE);
+        }
+    }
+    return blendshapes;
+}
+
 class GeometryReader : public QRunnable {
 public:
     GeometryReader(const ModelLoader& modelLoader, QWeakPointer<Resource>& resource, const QUrl& url, const GeometryMappingPair& mapping,
                    const QByteArray& data, bool combineParts, const QString& webMediaType) :
         _modelLoader(modelLoader), _resource(resource), _url(url), _mapping(mapping), _data(data), _combineParts(combineParts), _webMediaType(webMediaType) {
-
-        DependencyManager::get<StatTracker>()->incrementStat("PendingProcessing");
     }
 
     virtual void run() override;
@@ -107,7 +129,6 @@ private:
 };
 
 void GeometryReader::run() {
-    DependencyManager::get<StatTracker>()->decrementStat("PendingProcessing");
     CounterStat counter("Processing");
     PROFILE_RANGE_EX(resource_parse_geometry, "GeometryReader::run", 0xFF00FF00, 0, { { "url", _url.toString() } });
     auto originalPriority = QThread::currentThread()->priority();
@@ -180,9 +201,11 @@ void GeometryReader::run() {
 
         auto processedHFMModel = modelBaker.getHFMModel();
         auto materialMapping = modelBaker.getMaterialMapping();
+        auto blendshapes = buildBlendshapes(*processedHFMModel);
 
         QMetaObject::invokeMethod(resource.data(), "setGeometryDefinition",
-                Q_ARG(HFMModel::Pointer, processedHFMModel), Q_ARG(MaterialMapping, materialMapping));
+                Q_ARG(HFMModel::Pointer, processedHFMModel), Q_ARG(MaterialMapping, materialMapping),
+                Q_ARG(Geometry::BlendshapesPointer, blendshapes));
     } catch (const std::exception&) {
         auto resource = _resource.toStrongRef();
         if (resource) {
@@ -224,7 +247,11 @@ void GeometryResource::downloadFinished(const QByteArray& data) {
         // store parsed contents of FST file
         _mapping = FSTReader::readMapping(data);
 
-        QString filename = _mapping.value("filename").toString();
+        // a baked model's HFM blob loads without parsing its FBX
+        QString filename = _mapping.value(HFM_FILENAME_FIELD).toString();
+        if (filename.isNull()) {
+            filename = _mapping.value(FILENAME_FIELD).toString();
+        }
 
         if (filename.isNull()) {
             finishedLoading(false);
@@ -287,7 +314,7 @@ void GeometryResource::downloadFinished(const QByteArray& data) {
             _url = _effectiveBaseURL;
             _textureBaseURL = _effectiveBaseURL;
         }
-        QThreadPool::globalInstance()->start(new GeometryReader(_modelLoader, _self, _effectiveBaseURL, _mappingPair, data, _combineParts, _request->getWebMediaType()));
+        Resource::scheduleJob(JobScheduler::GEOMETRY, _self, new GeometryReader(_modelLoader, _self, _effectiveBaseURL, _mappingPair, data, _combineParts, _request->getWebMediaType()));
     }
 }
 
@@ -297,6 +324,7 @@ void GeometryResource::onGeometryMappingLoaded(bool success) {
         _materialMapping = _geometryResource->_materialMapping;
         _meshParts = _geometryResource->_meshParts;
         _meshes = _geometryResource->_meshes;
+        _blendshapes = _geometryResource->_blendshapes;
         _materials = _geometryResource->_materials;
 
         // Avoid holding onto extra references
@@ -316,10 +344,12 @@ void GeometryResource::setExtra(void* extra) {
     _combineParts = geometryExtra ? geometryExtra->combineParts : true;
 }
 
-void GeometryResource::setGeometryDefinition(HFMModel::Pointer hfmModel, const MaterialMapping& materialMapping) {
+void GeometryResource::setGeometryDefinition(HFMModel::Pointer hfmModel, const MaterialMapping& materialMapping,
+                                             const Geometry::BlendshapesPointer& blendshapes) {
     // Assume ownership of the processed HFMModel
     _hfmModel = hfmModel;
     _materialMapping = materialMapping;
+    _blendshapes = blendshapes;
 
     // Copy materials
     QHash<QString, size_t> materialIDAtlas;
@@ -374,6 +404,7 @@ ModelCache::ModelCache() {
     modelFormatRegistry->addFormat(FBXSerializer());
     modelFormatRegistry->addFormat(OBJSerializer());
     modelFormatRegistry->addFormat(GLTFSerializer());
+    modelFormatRegistry->addFormat(HFMBlobSerializer());
 }
 
 QSharedPointer<Resource> ModelCache::createResource(const QUrl& url) {
@@ -429,6 +460,7 @@ Geometry::Geometry(const Geometry& geometry) {
     _materialMapping = geometry._materialMapping;
     _meshes = geometry._meshes;
     _meshParts = geometry._meshParts;
+    _blendshapes = geometry._blendshapes;
 
     _materials.reserve(geometry._materials.size());
     for (const auto& material : geometry._materials) {
@@ -12,6 +12,7 @@
 #ifndef hifi_ModelCache_h
 #define hifi_ModelCache_h
 
+#include <BlendshapeDeltas.h>
 #include <DependencyManager.h>
 #include <ResourceCache.h>
 
@@ -43,12 +44,17 @@ public:
     // Mutable, but must retain structure of vector
     using NetworkMaterials = std::vector<std::shared_ptr<NetworkMaterial>>;
 
+    // The blendshapes of each mesh, packed at load time for the ModelBlender
+    using GeometryBlendshapes = std::vector<BlendshapeDeltas>;
+    using BlendshapesPointer = std::shared_ptr<const GeometryBlendshapes>;
+
     bool isHFMModelLoaded() const { return (bool)_hfmModel; }
 
     const HFMModel& getHFMModel() const { return *_hfmModel; }
     const HFMModel::ConstPointer& getConstHFMModelPointer() const { return _hfmModel; }
     const MaterialMapping& getMaterialMapping() const { return _materialMapping; }
     const GeometryMeshes& getMeshes() const { return *_meshes; }
+    const BlendshapesPointer& getBlendshapes() const { return _blendshapes; }
     const std::shared_ptr<NetworkMaterial> getShapeMaterial(int shapeID) const;
 
     const QVariantMap getTextures() const;
@@ -64,6 +70,7 @@ protected:
     MaterialMapping _materialMapping;
     std::shared_ptr<const GeometryMeshes> _meshes;
     std::shared_ptr<const GeometryMeshParts> _meshParts;
+    BlendshapesPointer _blendshapes;
 
     // Copied to each geometry, mutable throughout lifetime via setTextures
     NetworkMaterials _materials;
@@ -75,6 +82,8 @@ private:
     mutable bool _areTexturesLoaded { false };
 };
 
+Q_DECLARE_METATYPE(Geometry::BlendshapesPointer)
+
 /// A geometry loaded from the network.
 class GeometryResource : public Resource, public Geometry {
     Q_OBJECT
@@ -99,7 +108,8 @@ private slots:
 protected:
     friend class ModelCache;
 
-    Q_INVOKABLE void setGeometryDefinition(HFMModel::Pointer hfmModel, const MaterialMapping& materialMapping);
+    Q_INVOKABLE void setGeometryDefinition(HFMModel::Pointer hfmModel, const MaterialMapping& materialMapping,
+                                           const Geometry::BlendshapesPointer& blendshapes);
 
     // Geometries may not hold onto textures while cached - that is for the texture cache
     // Instead, these methods clear and reset textures from the geometry when caching/loading
@@ -22,12 +22,12 @@
 #include <QtCore/QStringList>
 #include <QtCore/QStandardPaths>
 #include <QtCore/QUrlQuery>
-#include <QtCore/QThreadPool>
 #include <QtNetwork/QHttpMultiPart>
 #include <QtNetwork/QNetworkRequest>
 #include <QtNetwork/QNetworkReply>
 #include <qthread.h>
 
+#include <JobScheduler.h>
 #include <SettingHandle.h>
 
 #include "NetworkLogging.h"
@@ -956,11 +956,9 @@ void AccountManager::generateNewKeypair(bool isUserKeypair, const QUuid& domainI
         connect(keypairGenerator, &RSAKeypairGenerator::errorGeneratingKeypair, this,
             &AccountManager::handleKeypairGenerationError);
 
-        static constexpr int RSA_THREAD_PRIORITY = 1;
-        qCDebug(networking) << "Starting worker thread to generate 2048-bit RSA keypair, priority"
-            << RSA_THREAD_PRIORITY << "- QThreadPool::maxThreadCount =" << QThreadPool::globalInstance()->maxThreadCount();
-        // Start on Qt's global thread pool.
-        QThreadPool::globalInstance()->start(keypairGenerator, RSA_THREAD_PRIORITY);
+        qCDebug(networking) << "Queueing background job to generate 2048-bit RSA keypair -"
+            << JobScheduler::getInstance().getNumQueuedJobs() << "jobs queued";
+        JobScheduler::getInstance().submit(JobScheduler::BACKGROUND, keypairGenerator);
     }
 }
 
@@ -447,27 +447,82 @@ MessageID AssetClient::getAsset(const QString& hash, AssetUtils::DataOffset star
 
         auto messageID = ++_currentID;
 
-        auto payloadSize = sizeof(messageID) + AssetUtils::SHA256_HASH_LENGTH + sizeof(start) + sizeof(end);
-        auto packet = NLPacket::create(PacketType::AssetGet, payloadSize, true);
-
         qCDebug(asset_client) << "Requesting data from" << start << "to" << end << "of" << hash << "from asset-server.";
 
-        packet->writePrimitive(messageID);
+        // the resource caches start their requests one after the other, in order of priority, so rather than a packet
+        // each, they're queued until the next pass of the event loop and go out together
+        if (_queuedGetsNode != assetServer) {
+            sendQueuedGets();
+        }
+        if (_queuedGets.empty()) {
+            QMetaObject::invokeMethod(this, "sendQueuedGets", Qt::QueuedConnection);
+        }
+        _queuedGetsNode = assetServer;
+        _queuedGets.push_back({ messageID, QByteArray::fromHex(hash.toLatin1()), start, end });
+        _pendingRequests[assetServer][messageID] = { QSharedPointer<ReceivedMessage>(), callback, progressCallback };
 
-        packet->write(QByteArray::fromHex(hash.toLatin1()));
+        return messageID;
+    }
 
-        packet->writePrimitive(start);
-        packet->writePrimitive(end);
+    callback(false, AssetUtils::AssetServerError::NoError, QByteArray());
+    return INVALID_MESSAGE_ID;
+}
 
-        if (nodeList->sendPacket(std::move(packet), *assetServer) != -1) {
-            _pendingRequests[assetServer][messageID] = { QSharedPointer<ReceivedMessage>(), callback, progressCallback };
+void AssetClient::sendQueuedGets() {
+    if (_queuedGets.empty()) {
+        return;
+    }
 
-            return messageID;
-        }
+    auto assetServer = _queuedGetsNode;
+    auto queuedGets = std::move(_queuedGets);
+    _queuedGets.clear();
+    _queuedGetsNode.reset();
+
+    // if the asset server went away while they were queued, their requests have already been failed
+    auto pendingRequestsIt = _pendingRequests.find(assetServer);
+    if (pendingRequestsIt == _pendingRequests.end()) {
+        return;
     }
+    auto nodeList = DependencyManager::get<LimitedNodeList>();
+    auto& pendingRequests = pendingRequestsIt->second;
+    const qint64 GET_SIZE = sizeof(MessageID) + AssetUtils::SHA256_HASH_LENGTH + 2 * sizeof(AssetUtils::DataOffset);
+
+    std::unique_ptr<NLPacket> packet;
+    std::vector<MessageID> packetMessageIDs;
+    auto sendPacket = [&] {
+        if (nodeList->sendPacket(std::move(packet), *assetServer) == -1) {
+            for (auto messageID : packetMessageIDs) {
+                auto requestIt = pendingRequests.find(messageID);
+                if (requestIt != pendingRequests.end()) {
+                    auto callback = requestIt->second.completeCallback;
+                    pendingRequests.erase(requestIt);
+                    callback(false, AssetUtils::AssetServerError::NoError, QByteArray());
+                }
+            }
+        }
+        packetMessageIDs.clear();
+    };
 
-    callback(false, AssetUtils::AssetServerError::NoError, QByteArray());
-    return INVALID_MESSAGE_ID;
+    for (const auto& get : queuedGets) {
+        if (pendingRequests.find(get.messageID) == pendingRequests.end()) {
+            // cancelled while it was queued
+            continue;
+        }
+        if (packet && packet->bytesAvailableForWrite() < GET_SIZE) {
+            sendPacket();
+        }
+        if (!packet) {
+            packet = NLPacket::create(PacketType::AssetGet, -1, true);
+        }
+        packet->writePrimitive(get.messageID);
+        packet->write(get.hash);
+        packet->writePrimitive(get.start);
+        packet->writePrimitive(get.end);
+        packetMessageIDs.push_back(get.messageID);
+    }
+    if (packet) {
+        sendPacket();
+    }
 }
 
 MessageID AssetClient::getAssetInfo(const QString& hash, GetInfoCallback callback) {
@@ -996,6 +1051,11 @@ void AssetClient::handleNodeClientConnectionReset(SharedNodePointer node) {
 
 void AssetClient::forceFailureOfPendingRequests(SharedNodePointer node) {
 
+    if (_queuedGetsNode == node) {
+        _queuedGets.clear();
+        _queuedGetsNode.reset();
+    }
+
     {
         auto messageMapIt = _pendingRequests.find(node);
         if (messageMapIt != _pendingRequests.end()) {
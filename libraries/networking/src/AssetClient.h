@@ -105,18 +105,31 @@ private:
 
     void forceFailureOfPendingRequests(SharedNodePointer node);
 
+    Q_INVOKABLE void sendQueuedGets();
+
     struct GetAssetRequestData {
         QSharedPointer<ReceivedMessage> message;
         ReceivedAssetCallback completeCallback;
         ProgressCallback progressCallback;
     };
 
+    struct QueuedGet {
+        MessageID messageID;
+        QByteArray hash;
+        AssetUtils::DataOffset start;
+        AssetUtils::DataOffset end;
+    };
+
     static MessageID _currentID;
     std::unordered_map<SharedNodePointer, std::unordered_map<MessageID, MappingOperationCallback>> _pendingMappingRequests;
     std::unordered_map<SharedNodePointer, std::unordered_map<MessageID, GetAssetRequestData>> _pendingRequests;
     std::unordered_map<SharedNodePointer, std::unordered_map<MessageID, GetInfoCallback>> _pendingInfoRequests;
     std::unordered_map<SharedNodePointer, std::unordered_map<MessageID, UploadResultCallback>> _pendingUploads;
 
+    // The gets made in the same pass of the event loop, which are sent together, in as few packets as they fit in
+    SharedNodePointer _queuedGetsNode;
+    std::vector<QueuedGet> _queuedGets;
+
     QString _cacheDir;
 
     friend class AssetRequest;
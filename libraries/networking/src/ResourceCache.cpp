@@ -29,14 +29,120 @@
 #include "NodeList.h"
 
 bool ResourceCacheSharedItems::appendRequest(QWeakPointer<Resource> resource) {
+    auto locked = resource.lock();
     Lock lock(_mutex);
     if ((uint32_t)_loadingRequests.size() < _requestLimit) {
         _loadingRequests.append(resource);
         return true;
-    } else {
-        _pendingRequests.append(resource);
+    }
+    if (!locked) {
         return false;
     }
+
+    PendingRequest request { resource, locked.data(), locked->getLoadPriority(),
+        locked->getURL().scheme() == HIFI_URL_SCHEME_FILE, _nextPendingSequence++ };
+    auto found = _pendingIndices.find(request.key);
+    if (found != _pendingIndices.end()) {
+        // either a retry of a request that is still pending, or a new resource at the address of a freed one
+        size_t index = found->second;
+        placeRequest(index, request);
+        siftUp(index);
+        siftDown(_pendingIndices[request.key]);
+    } else {
+        _pendingRequests.emplace_back();
+        placeRequest(_pendingRequests.size() - 1, request);
+        siftUp(_pendingRequests.size() - 1);
+    }
+    locked->_isPending = true;
+    return false;
+}
+
+bool ResourceCacheSharedItems::isHigherPriority(const PendingRequest& a, const PendingRequest& b) const {
+    // local files first, since they load right away, then by priority, and the most recent of equals
+    if (a.isFile != b.isFile) {
+        return a.isFile;
+    }
+    if (a.priority != b.priority) {
+        return a.priority > b.priority;
+    }
+    return a.sequence > b.sequence;
+}
+
+void ResourceCacheSharedItems::placeRequest(size_t index, PendingRequest request) {
+    _pendingIndices[request.key] = index;
+    _pendingRequests[index] = std::move(request);
+}
+
+void ResourceCacheSharedItems::siftUp(size_t index) {
+    PendingRequest request = std::move(_pendingRequests[index]);
+    while (index > 0) {
+        size_t parent = (index - 1) / HEAP_ARITY;
+        if (!isHigherPriority(request, _pendingRequests[parent])) {
+            break;
+        }
+        placeRequest(index, std::move(_pendingRequests[parent]));
+        index = parent;
+    }
+    placeRequest(index, std::move(request));
+}
+
+void ResourceCacheSharedItems::siftDown(size_t index) {
+    size_t size = _pendingRequests.size();
+    PendingRequest request = std::move(_pendingRequests[index]);
+    while (true) {
+        size_t first = index * HEAP_ARITY + 1;
+        if (first >= size) {
+            break;
+        }
+        size_t best = first;
+        size_t last = std::min(first + HEAP_ARITY, size);
+        for (size_t child = first + 1; child < last; child++) {
+            if (isHigherPriority(_pendingRequests[child], _pendingRequests[best])) {
+                best = child;
+            }
+        }
+        if (!isHigherPriority(_pendingRequests[best], request)) {
+            break;
+        }
+        placeRequest(index, std::move(_pendingRequests[best]));
+        index = best;
+    }
+    placeRequest(index, std::move(request));
+}
+
+void ResourceCacheSharedItems::removePendingAt(size_t index) {
+    _pendingIndices.erase(_pendingRequests[index].key);
+    size_t last = _pendingRequests.size() - 1;
+    if (index == last) {
+        _pendingRequests.pop_back();
+        return;
+    }
+
+    // fill the hole with the last request, which may belong either above or below it
+    Resource* moved = _pendingRequests[last].key;
+    placeRequest(index, std::move(_pendingRequests[last]));
+    _pendingRequests.pop_back();
+    siftUp(index);
+    siftDown(_pendingIndices[moved]);
+}
+
+void ResourceCacheSharedItems::updatePendingRequestPriority(Resource* resource, float priority) {
+    Lock lock(_mutex);
+    auto found = _pendingIndices.find(resource);
+    if (found == _pendingIndices.end()) {
+        return;
+    }
+    size_t index = found->second;
+    float oldPriority = _pendingRequests[index].priority;
+    if (priority == oldPriority) {
+        return;
+    }
+    _pendingRequests[index].priority = priority;
+    if (priority > oldPriority) {
+        siftUp(index);
+    } else {
+        siftDown(index);
+    }
 }
 
 void ResourceCacheSharedItems::setRequestLimit(uint32_t limit) {
@@ -53,8 +159,8 @@ QList<QSharedPointer<Resource>> ResourceCacheSharedItems::getPendingRequests() c
     QList<QSharedPointer<Resource>> result;
     Lock lock(_mutex);
 
-    foreach (QWeakPointer<Resource> resource, _pendingRequests) {
-        auto locked = resource.lock();
+    for (const auto& request : _pendingRequests) {
+        auto locked = request.resource.lock();
         if (locked) {
             result.append(locked);
         }
@@ -65,7 +171,7 @@ QList<QSharedPointer<Resource>> ResourceCacheSharedItems::getPendingRequests() c
 
 uint32_t ResourceCacheSharedItems::getPendingRequestsCount() const {
     Lock lock(_mutex);
-    return _pendingRequests.size();
+    return (uint32_t)_pendingRequests.size();
 }
 
 QList<QSharedPointer<Resource>> ResourceCacheSharedItems::getLoadingRequests() const {
@@ -105,44 +211,42 @@ void ResourceCacheSharedItems::removeRequest(QWeakPointer<Resource> resource) {
 }
 
 QSharedPointer<Resource> ResourceCacheSharedItems::getHighestPendingRequest() {
-    // look for the highest priority pending request
-    int highestIndex = -1;
-    float highestPriority = -FLT_MAX;
-    QSharedPointer<Resource> highestResource;
     Lock lock(_mutex);
+    while (!_pendingRequests.empty()) {
+        auto& top = _pendingRequests.front();
 
-    bool currentHighestIsFile = false;
-
-    for (int i = 0; i < _pendingRequests.size();) {
         // Clear any freed resources
-        auto resource = _pendingRequests.at(i).lock();
+        auto resource = top.resource.lock();
         if (!resource) {
-            _pendingRequests.removeAt(i);
+            removePendingAt(0);
             continue;
         }
 
-        // Check load priority
+        // the priority may have dropped since it was cached, when one of its owners went away
         float priority = resource->getLoadPriority();
-        bool isFile = resource->getURL().scheme() == HIFI_URL_SCHEME_FILE;
-        if (priority >= highestPriority && (isFile || !currentHighestIsFile)) {
-            highestPriority = priority;
-            highestIndex = i;
-            highestResource = resource;
-            currentHighestIsFile = isFile;
+        if (priority != top.priority) {
+            top.priority = priority;
+            siftDown(0);
+            continue;
         }
-        i++;
-    }
 
-    if (highestIndex >= 0) {
-        _pendingRequests.takeAt(highestIndex);
+        removePendingAt(0);
+        resource->_isPending = false;
+        return resource;
     }
-
-    return highestResource;
+    return QSharedPointer<Resource>();
 }
 
 void ResourceCacheSharedItems::clear() {
     Lock lock(_mutex);
+    for (const auto& request : _pendingRequests) {
+        auto resource = request.resource.lock();
+        if (resource) {
+            resource->_isPending = false;
+        }
+    }
     _pendingRequests.clear();
+    _pendingIndices.clear();
     _loadingRequests.clear();
 }
 
@@ -570,6 +674,7 @@ Resource::Resource(const Resource& other) :
     _failedToLoad(other._failedToLoad),
     _loaded(other._loaded),
     _loadPriorities(other._loadPriorities),
+    _cachedLoadPriority(other._cachedLoadPriority.load()),
     _bytesReceived(other._bytesReceived),
     _bytesTotal(other._bytesTotal),
     _bytes(other._bytes),
@@ -606,6 +711,7 @@ void Resource::ensureLoading() {
 void Resource::setLoadPriority(const QPointer<QObject>& owner, float priority) {
     if (!_failedToLoad) {
         _loadPriorities.insert(owner, priority);
+        updatePendingPriority();
     }
 }
 
@@ -617,16 +723,26 @@ void Resource::setLoadPriorities(const QHash<QPointer<QObject>, float>& prioriti
             it != priorities.constEnd(); it++) {
         _loadPriorities.insert(it.key(), it.value());
     }
+    updatePendingPriority();
 }
 
 void Resource::clearLoadPriority(const QPointer<QObject>& owner) {
     if (!_failedToLoad) {
         _loadPriorities.remove(owner);
+        updatePendingPriority();
+    }
+}
+
+void Resource::updatePendingPriority() {
+    float priority = getLoadPriority();
+    if (_isPending) {
+        DependencyManager::get<ResourceCacheSharedItems>()->updatePendingRequestPriority(this, priority);
     }
 }
 
 float Resource::getLoadPriority() {
     if (_loadPriorities.size() == 0) {
+        _cachedLoadPriority = 0.0f;
         return 0;
     }
 
@@ -639,9 +755,31 @@ float Resource::getLoadPriority() {
         highestPriority = qMax(highestPriority, it.value());
         it++;
     }
+    _cachedLoadPriority = highestPriority;
     return highestPriority;
 }
 
+// called from whichever thread the scheduler dispatches on, so it only reads the priority the resource last computed
+static JobScheduler::PriorityOperator loadPriorityOperator(const QWeakPointer<Resource>& resource) {
+    return [resource] {
+        auto strongResource = resource.lock();
+        return strongResource ? strongResource->getCachedLoadPriority() : 0.0f;
+    };
+}
+
+// the resource's _self is replaced when its references are all cleared, so the old pointer expires even if it stays cached
+static JobScheduler::CancelOperator resourceReleasedOperator(const QWeakPointer<Resource>& resource) {
+    return [resource] { return resource.isNull(); };
+}
+
+void Resource::scheduleJob(JobScheduler::JobClass jobClass, const QWeakPointer<Resource>& resource, QRunnable* runnable) {
+    JobScheduler::getInstance().submit(jobClass, runnable, loadPriorityOperator(resource), resourceReleasedOperator(resource));
+}
+
+void Resource::scheduleJob(JobScheduler::JobClass jobClass, const QWeakPointer<Resource>& resource, JobScheduler::Job job) {
+    JobScheduler::getInstance().submit(jobClass, std::move(job), loadPriorityOperator(resource), resourceReleasedOperator(resource));
+}
+
 void Resource::refresh() {
     if (_request && !(_loaded || _failedToLoad)) {
         return;
@@ -718,6 +856,7 @@ void Resource::attemptRequest() {
 void Resource::finishedLoading(bool success) {
     if (success) {
         _loadPriorities.clear();
+        _cachedLoadPriority = 0.0f;
         _loaded = true;
     } else {
         _failedToLoad = true;
@@ -14,6 +14,8 @@
 
 #include <atomic>
 #include <mutex>
+#include <unordered_map>
+#include <vector>
 
 #include <QtCore/QHash>
 #include <QtCore/QList>
@@ -31,6 +33,7 @@
 #include <QScriptEngine>
 
 #include <DependencyManager.h>
+#include <JobScheduler.h>
 
 #include "ResourceManager.h"
 
@@ -77,11 +80,34 @@ public:
     uint32_t getLoadingRequestsCount() const;
     void clear();
 
+    /// Moves a pending request to its place for a new load priority, without scanning the other pending requests.
+    void updatePendingRequestPriority(Resource* resource, float priority);
+
 private:
     ResourceCacheSharedItems() = default;
 
+    // The pending requests are kept in an indexed 4-ary heap, so that the highest priority request can be taken,
+    // and any request can be moved when its priority changes, in O(log N) rather than with a scan of them all.
+    // Freed resources stay in the heap until they come up to the top.
+    struct PendingRequest {
+        QWeakPointer<Resource> resource;
+        Resource* key;
+        float priority;
+        bool isFile;
+        uint64_t sequence;
+    };
+    static const size_t HEAP_ARITY = 4;
+
+    bool isHigherPriority(const PendingRequest& a, const PendingRequest& b) const;
+    void placeRequest(size_t index, PendingRequest request);
+    void siftUp(size_t index);
+    void siftDown(size_t index);
+    void removePendingAt(size_t index);
+
     mutable Mutex _mutex;
-    QList<QWeakPointer<Resource>> _pendingRequests;
+    std::vector<PendingRequest> _pendingRequests;
+    std::unordered_map<Resource*, size_t> _pendingIndices;
+    uint64_t _nextPendingSequence { 0 };
     QList<QWeakPointer<Resource>> _loadingRequests;
     const uint32_t DEFAULT_REQUEST_LIMIT = 10;
     uint32_t _requestLimit { DEFAULT_REQUEST_LIMIT };
@@ -432,6 +458,14 @@ public:
     /// Returns the highest load priority across all owners.
     float getLoadPriority();
 
+    /// Returns the load priority as last computed by the resource's own thread; safe to call from any thread.
+    float getCachedLoadPriority() const { return _cachedLoadPriority; }
+
+    /// Queues processing for a resource on the JobScheduler, ordered by the resource's load priority. The job is dropped
+    /// if every reference to the resource is released before it starts.
+    static void scheduleJob(JobScheduler::JobClass jobClass, const QWeakPointer<Resource>& resource, QRunnable* runnable);
+    static void scheduleJob(JobScheduler::JobClass jobClass, const QWeakPointer<Resource>& resource, JobScheduler::Job job);
+
     /// Checks whether the resource has loaded.
     virtual bool isLoaded() const { return _loaded; }
 
@@ -535,6 +569,7 @@ protected:
     bool _loaded = false;
 
     QHash<QPointer<QObject>, float> _loadPriorities;
+    std::atomic<float> _cachedLoadPriority { 0.0f };
     QWeakPointer<Resource> _self;
     QPointer<ResourceCache> _cache;
 
@@ -553,8 +588,11 @@ public slots:
 
 private:
     friend class ResourceCache;
+    friend class ResourceCacheSharedItems;
     friend class ScriptableResource;
     
+    void updatePendingPriority();
+
     void setLRUKey(int lruKey) { _lruKey = lruKey; }
     
     void retry();
@@ -569,6 +607,9 @@ private:
     static const int MAX_ATTEMPTS = 8;
     unsigned int _attemptsRemaining { MAX_ATTEMPTS };
     bool _isInScript{ false };
+
+    // set while the resource waits in the pending requests, so that priority changes are only forwarded then
+    std::atomic<bool> _isPending { false };
 };
 
 uint qHash(const QPointer<QObject>& value, uint seed = 0);
@@ -299,7 +299,8 @@ enum class AssetServerPacketVersion: PacketVersion {
     VegasCongestionControl = 19,
     RangeRequestSupport,
     RedirectedMappings,
-    BakingTextureMeta
+    BakingTextureMeta,
+    BatchedGets
 };
 
 enum class AvatarMixerPacketVersion : PacketVersion {
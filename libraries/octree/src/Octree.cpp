@@ -16,6 +16,7 @@
 #include <cmath>
 #include <fstream> // to load voxels from file
 
+#include <QBuffer>
 #include <QDataStream>
 #include <QDebug>
 #include <QEventLoop>
@@ -32,11 +33,13 @@
 #include <QFileInfo>
 #include <QSaveFile>
 #include <QString>
+#include <QThread>
 #include <QRegularExpression>
 #include <QRegularExpressionMatch>
 
 #include <GeometryUtil.h>
 #include <Gzip.h>
+#include <GzipDevice.h>
 #include <LogHandler.h>
 #include <NetworkAccessManager.h>
 #include <OctalCode.h>
@@ -699,16 +702,19 @@ bool Octree::readJSONFromGzippedFile(QString qFileName) {
         qCritical() << "Cannot open gzipped json file for reading: " << qFileName;
         return false;
     }
-    QByteArray compressedJsonData = file.readAll();
-    QByteArray jsonData;
 
-    if (!gunzip(compressedJsonData, jsonData)) {
-        qCritical() << "json File not in gzip format: " << qFileName;
+    // inflate the file as it is read, so that only the JSON is held in memory
+    GzipDevice gzipDevice(&file);
+    QByteArray jsonData;
+    if (gzipDevice.open(QIODevice::ReadOnly)) {
+        jsonData = gzipDevice.readAll();
+    }
+    if (!gzipDevice.isOpen() || gzipDevice.hasError()) {
+        qCritical() << "json File not in gzip format: " << qFileName << gzipDevice.errorString();
         return false;
     }
 
-    QDataStream jsonStream(jsonData);
-    return readJSONFromStream(-1, jsonStream);
+    return readJSONFromData(jsonData);
 }
 
 // hack to get the marketplace id into the entities.  We will create a way to get this from a hash of
@@ -834,11 +840,16 @@ bool Octree::readJSONFromStream(
         if (got == 0) {
             break;
         }
-        jsonBuffer += QByteArray(rawData, got);
+        jsonBuffer.append(rawData, got);
     }
+    delete[] rawData;
 
+    return readJSONFromData(jsonBuffer, marketplaceID);
+}
+
+bool Octree::readJSONFromData(const QByteArray& jsonData, const QString& marketplaceID /*=""*/) {
     OctreeEntitiesFileParser octreeParser;
-    octreeParser.setEntitiesString(jsonBuffer);
+    octreeParser.setEntitiesString(jsonData);
     QVariantMap asMap;
     if (!octreeParser.parseEntities(asMap)) {
         qCritical() << "Couldn't parse Entities JSON:" << octreeParser.getErrorString().c_str();
@@ -849,9 +860,7 @@ bool Octree::readJSONFromStream(
         addMarketplaceIDToDocumentEntities(asMap, marketplaceID);
     }
 
-    bool success = readFromMap(asMap);
-    delete[] rawData;
-    return success;
+    return readFromMap(asMap);
 }
 
 bool Octree::writeToFile(const char* fileName, const OctreeElementPointer& element, QString persistAsFileType) {
@@ -928,17 +937,51 @@ bool Octree::toJSONString(QString& jsonString, const OctreeElementPointer& eleme
     return true;
 }
 
-bool Octree::toJSON(QByteArray* data, const OctreeElementPointer& element, bool doGzip) {
+bool Octree::toJSON(QIODevice& output, const OctreeElementPointer& element) {
+    OctreeElementPointer top;
+    if (element) {
+        top = element;
+    } else {
+        top = _rootElement;
+    }
+
+    if (output.write(QString("{\n  \"DataVersion\": %1,\n  \"Entities\": [").arg(_persistDataVersion).toUtf8()) == -1) {
+        return false;
+    }
+
+    if (!writeToJSON(output, top)) {
+        return false;
+    }
+
+    // include the "bitstream" version
+    PacketType expectedType = expectedDataPacketType();
+    PacketVersion expectedVersion = versionForPacketType(expectedType);
+
+    QString trailer = QString("\n    ],\n  \"Id\": \"%1\",\n  \"Version\": %2\n}\n").arg(_persistID.toString()).arg((int)expectedVersion);
+    return output.write(trailer.toUtf8()) != -1;
+}
+
+bool Octree::writeToJSON(QIODevice& output, const OctreeElementPointer& element) {
     QString jsonString;
-    toJSONString(jsonString);
+    if (!writeToJSON(jsonString, element)) {
+        return false;
+    }
+    return output.write(jsonString.toUtf8()) != -1;
+}
 
-    if (doGzip) {
-        if (!gzip(jsonString.toUtf8(), *data, -1)) {
-            qCritical("Unable to gzip data while saving to json.");
-            return false;
-        }
-    } else {
-        *data = jsonString.toUtf8();
+bool Octree::toJSON(QByteArray* data, const OctreeElementPointer& element, bool doGzip) {
+    data->clear();
+    QBuffer buffer(data);
+    buffer.open(QIODevice::WriteOnly);
+
+    if (!doGzip) {
+        return toJSON(buffer, element);
+    }
+
+    GzipDevice gzipDevice(&buffer, -1, QThread::idealThreadCount());
+    if (!gzipDevice.open(QIODevice::WriteOnly) || !toJSON(gzipDevice, element) || !gzipDevice.finish()) {
+        qCritical() << "Unable to gzip data while saving to json:" << gzipDevice.errorString();
+        return false;
     }
 
     return true;
@@ -947,24 +990,29 @@ bool Octree::toJSON(QByteArray* data, const OctreeElementPointer& element, bool
 bool Octree::writeToJSONFile(const char* fileName, const OctreeElementPointer& element, bool doGzip) {
     qCDebug(octree, "Saving JSON SVO to file %s...", fileName);
 
-    QByteArray jsonDataForFile;
-    if (!toJSON(&jsonDataForFile, element, doGzip)) {
+    // the JSON is written (and compressed) a piece at a time as the tree is walked, so it is never held in memory whole
+    QSaveFile persistFile(fileName);
+    if (!persistFile.open(QIODevice::WriteOnly)) {
+        qCritical("Failed to open JSON file for writing.");
         return false;
     }
 
-    QSaveFile persistFile(fileName);
-    bool success = false;
-    if (persistFile.open(QIODevice::WriteOnly)) {
-        if (persistFile.write(jsonDataForFile) != -1) {
-            success = persistFile.commit();
-            if (!success) {
-                qCritical() << "Failed to commit to JSON save file:" << persistFile.errorString();
-            }
-        } else {
-            qCritical("Failed to write to JSON file.");
-        }
+    bool success;
+    if (doGzip) {
+        GzipDevice gzipDevice(&persistFile, -1, QThread::idealThreadCount());
+        success = gzipDevice.open(QIODevice::WriteOnly) && toJSON(gzipDevice, element) && gzipDevice.finish();
     } else {
-        qCritical("Failed to open JSON file for writing.");
+        success = toJSON(persistFile, element);
+    }
+    if (!success) {
+        qCritical() << "Failed to write to JSON file:" << persistFile.errorString();
+        persistFile.cancelWriting();
+        return false;
+    }
+
+    success = persistFile.commit();
+    if (!success) {
+        qCritical() << "Failed to commit to JSON save file:" << persistFile.errorString();
     }
 
     return success;
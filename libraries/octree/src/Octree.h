@@ -17,6 +17,7 @@
 #include <stdint.h>
 
 #include <QHash>
+#include <QIODevice>
 #include <QObject>
 #include <QtCore/QJsonObject>
 
@@ -208,11 +209,14 @@ public:
     bool toJSONDocument(QJsonDocument* doc, const OctreeElementPointer& element = nullptr);
     bool toJSONString(QString& jsonString, const OctreeElementPointer& element = nullptr);
     bool toJSON(QByteArray* data, const OctreeElementPointer& element = nullptr, bool doGzip = false);
+    bool toJSON(QIODevice& output, const OctreeElementPointer& element = nullptr);
     bool writeToFile(const char* filename, const OctreeElementPointer& element = nullptr, QString persistAsFileType = "json.gz");
     bool writeToJSONFile(const char* filename, const OctreeElementPointer& element = nullptr, bool doGzip = false);
     virtual bool writeToMap(QVariantMap& entityDescription, OctreeElementPointer element, bool skipDefaultValues,
                             bool skipThoseWithBadParents) = 0;
     virtual bool writeToJSON(QString& jsonString, const OctreeElementPointer& element) = 0;
+    // writes the entities as they are visited, rather than collecting them into a string first
+    virtual bool writeToJSON(QIODevice& output, const OctreeElementPointer& element);
 
     // Octree importers
     bool readFromFile(const char* filename);
@@ -220,6 +224,7 @@ public:
     bool readFromStream(uint64_t streamLength, QDataStream& inputStream, const QString& marketplaceID="");
     bool readSVOFromStream(uint64_t streamLength, QDataStream& inputStream);
     bool readJSONFromStream(uint64_t streamLength, QDataStream& inputStream, const QString& marketplaceID="");
+    bool readJSONFromData(const QByteArray& jsonData, const QString& marketplaceID="");
     bool readJSONFromGzippedFile(QString qFileName);
     virtual bool readFromMap(QVariantMap& entityDescription) = 0;
 
@@ -12,12 +12,15 @@
 #include "OctreeEntitiesFileParser.h"
 
 #include <Gzip.h>
+#include <GzipDevice.h>
 #include <udt/PacketHeaders.h>
 
+#include <QBuffer>
 #include <QDebug>
 #include <QJsonObject>
 #include <QJsonDocument>
 #include <QFile>
+#include <QThread>
 
 bool OctreeUtils::RawOctreeData::readOctreeDataInfoFromMap(const QVariantMap& map) {
     if (map.contains("Id") && map.contains("DataVersion") && map.contains("Version")) {
@@ -55,7 +58,20 @@ bool OctreeUtils::RawOctreeData::readOctreeDataInfoFromFile(QString path) {
         return false;
     }
 
-    QByteArray data = file.readAll();
+    if (!GzipDevice::isGzipped(&file)) {
+        return readOctreeDataInfoFromData(file.readAll());
+    }
+
+    // inflate as the file is read, rather than holding the compressed data as well
+    GzipDevice gzipDevice(&file);
+    QByteArray data;
+    if (gzipDevice.open(QIODevice::ReadOnly)) {
+        data = gzipDevice.readAll();
+    }
+    if (!gzipDevice.isOpen() || gzipDevice.hasError()) {
+        qCritical() << "Cannot inflate json file: " << path << gzipDevice.errorString();
+        return false;
+    }
 
     return readOctreeDataInfoFromData(data);
 }
@@ -73,10 +89,12 @@ QByteArray OctreeUtils::RawOctreeData::toByteArray() {
 }
 
 QByteArray OctreeUtils::RawOctreeData::toGzippedByteArray() {
-    auto data = toByteArray();
     QByteArray gzData;
+    QBuffer buffer(&gzData);
+    buffer.open(QIODevice::WriteOnly);
 
-    if (!gzip(data, gzData, -1)) {
+    GzipDevice gzipDevice(&buffer, -1, QThread::idealThreadCount());
+    if (!gzipDevice.open(QIODevice::WriteOnly) || gzipDevice.write(toByteArray()) == -1 || !gzipDevice.finish()) {
         qCritical("Unable to gzip data while converting json.");
         return QByteArray();
     }
@@ -31,7 +31,7 @@
 #include <NumericalConstants.h>
 #include <PerfStat.h>
 #include <PathUtils.h>
-#include <Gzip.h>
+#include <GzipDevice.h>
 
 #include "OctreeLogging.h"
 #include "OctreeUtils.h"
@@ -75,11 +75,20 @@ void OctreePersistThread::start() {
     qCDebug(octree) << "Reading octree data from" << _filename;
     QFile file(_filename);
     if (file.open(QIODevice::ReadOnly)) {
-        QByteArray jsonData(file.readAll());
-        file.close();
-        if (!gunzip(jsonData, _cachedJSONData)) {
-            _cachedJSONData = jsonData;
+        if (GzipDevice::isGzipped(&file)) {
+            // inflate as the file is read, rather than holding the compressed data as well
+            GzipDevice gzipDevice(&file);
+            if (gzipDevice.open(QIODevice::ReadOnly)) {
+                _cachedJSONData = gzipDevice.readAll();
+            }
+            if (gzipDevice.hasError()) {
+                qCWarning(octree) << "Couldn't inflate" << _filename << gzipDevice.errorString();
+                _cachedJSONData.clear();
+            }
+        } else {
+            _cachedJSONData = file.readAll();
         }
+        file.close();
 
         if (data.readOctreeDataInfoFromData(_cachedJSONData)) {
             qCDebug(octree) << "Current octree data: ID(" << data.id << ") DataVersion(" << data.dataVersion << ")";
@@ -156,8 +165,7 @@ void OctreePersistThread::handleOctreeDataFileReply(QSharedPointer<ReceivedMessa
         if (_cachedJSONData.isEmpty()) {
             persistentFileRead = _tree->readFromFile(_filename.toLocal8Bit().constData());
         } else {
-            QDataStream jsonStream(_cachedJSONData);
-            persistentFileRead = _tree->readFromStream(-1, jsonStream);
+            persistentFileRead = _tree->readJSONFromData(_cachedJSONData);
         }
         _tree->pruneTree();
     });
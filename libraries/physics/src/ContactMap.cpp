@@ -0,0 +1,113 @@
+//
+//  ContactMap.cpp
+//  libraries/physics/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ContactMap.h"
+
+#include <assert.h>
+#include <algorithm>
+
+static const size_t MIN_CAPACITY = 64;      // power of two
+
+static size_t hashKey(const ContactKey& key) {
+    uint64_t a = (uint64_t)(uintptr_t)key._a;
+    uint64_t b = (uint64_t)(uintptr_t)key._b;
+    uint64_t h = (a ^ (b * 0x9e3779b97f4a7c15ULL)) * 0xbf58476d1ce4e5b9ULL;
+    return (size_t)(h ^ (h >> 31));
+}
+
+size_t ContactMap::findIndex(const ContactKey& key) const {
+    size_t capacity = _states.size();
+    if (capacity == 0) {
+        return capacity;
+    }
+    size_t mask = capacity - 1;
+    for (size_t i = hashKey(key) & mask; ; i = (i + 1) & mask) {
+        if (_states[i] == EMPTY) {
+            return capacity;
+        }
+        if (_states[i] == FULL && _entries[i].first == key) {
+            return i;
+        }
+    }
+}
+
+ContactMap::iterator ContactMap::find(const ContactKey& key) {
+    return iterator(this, findIndex(key));
+}
+
+ContactInfo& ContactMap::operator[](const ContactKey& key) {
+    size_t capacity = _states.size();
+    if ((_size + _numErased + 1) * 4 > capacity * 3) {
+        // grow when mostly full of live entries, otherwise just sweep out the erased ones
+        rehash((_size + 1) * 2 > capacity ? std::max(capacity * 2, MIN_CAPACITY) : capacity);
+        capacity = _states.size();
+    }
+
+    size_t mask = capacity - 1;
+    size_t reusable = capacity;
+    for (size_t i = hashKey(key) & mask; ; i = (i + 1) & mask) {
+        if (_states[i] == EMPTY) {
+            if (reusable == capacity) {
+                reusable = i;
+            } else {
+                --_numErased;
+            }
+            break;
+        }
+        if (_states[i] == FULL) {
+            if (_entries[i].first == key) {
+                return _entries[i].second;
+            }
+        } else if (reusable == capacity) {
+            reusable = i;
+        }
+    }
+
+    _states[reusable] = FULL;
+    _entries[reusable] = Entry();
+    _entries[reusable].first = key;
+    ++_size;
+    return _entries[reusable].second;
+}
+
+ContactMap::iterator ContactMap::erase(iterator itr) {
+    assert(itr._index < _states.size() && _states[itr._index] == FULL);
+    _states[itr._index] = ERASED;
+    --_size;
+    ++_numErased;
+    ++itr;
+    return itr;
+}
+
+void ContactMap::clear() {
+    _entries.clear();
+    _states.clear();
+    _size = 0;
+    _numErased = 0;
+}
+
+void ContactMap::rehash(size_t capacity) {
+    std::vector<Entry> entries(capacity);
+    std::vector<uint8_t> states(capacity, EMPTY);
+    size_t mask = capacity - 1;
+    for (size_t j = 0; j < _states.size(); ++j) {
+        if (_states[j] == FULL) {
+            size_t i = hashKey(_entries[j].first) & mask;
+            while (states[i] != EMPTY) {
+                i = (i + 1) & mask;
+            }
+            states[i] = FULL;
+            entries[i] = _entries[j];
+        }
+    }
+    _entries.swap(entries);
+    _states.swap(states);
+    _numErased = 0;
+}
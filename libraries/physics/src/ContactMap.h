@@ -0,0 +1,86 @@
+//
+//  ContactMap.h
+//  libraries/physics/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_ContactMap_h
+#define hifi_ContactMap_h
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+#include "ContactInfo.h"
+
+// simple class for keeping track of contacts
+class ContactKey {
+public:
+    ContactKey() = delete;
+    ContactKey(void* a, void* b) : _a(a), _b(b) {}
+    bool operator<(const ContactKey& other) const { return _a < other._a || (_a == other._a && _b < other._b); }
+    bool operator==(const ContactKey& other) const { return _a == other._a && _b == other._b; }
+    void* _a; // ObjectMotionState pointer
+    void* _b; // ObjectMotionState pointer
+};
+
+// Open-addressing hash map from a pair of ObjectMotionStates to their latest ContactInfo.
+// It is updated for every manifold on every substep, so it keeps its entries in one flat array
+// rather than allocating a node per contact. Erased entries leave a marker until the next rehash,
+// which keeps iterators valid while erasing, as with the std::map it replaces.
+class ContactMap {
+public:
+    struct Entry {
+        ContactKey first { nullptr, nullptr };
+        ContactInfo second;
+    };
+
+    class iterator {
+    public:
+        iterator(ContactMap* map, size_t index) : _map(map), _index(index) { skipUnused(); }
+        Entry& operator*() const { return _map->_entries[_index]; }
+        Entry* operator->() const { return &_map->_entries[_index]; }
+        iterator& operator++() { ++_index; skipUnused(); return *this; }
+        bool operator==(const iterator& other) const { return _index == other._index; }
+        bool operator!=(const iterator& other) const { return _index != other._index; }
+
+    private:
+        void skipUnused() {
+            while (_index < _map->_states.size() && _map->_states[_index] != FULL) {
+                ++_index;
+            }
+        }
+
+        ContactMap* _map;
+        size_t _index;
+        friend class ContactMap;
+    };
+
+    ContactInfo& operator[](const ContactKey& key);
+
+    iterator begin() { return iterator(this, 0); }
+    iterator end() { return iterator(this, _states.size()); }
+    iterator find(const ContactKey& key);
+    iterator erase(iterator itr);
+
+    size_t size() const { return _size; }
+    bool empty() const { return _size == 0; }
+    void clear();
+
+private:
+    enum : uint8_t { EMPTY = 0, FULL, ERASED };
+
+    size_t findIndex(const ContactKey& key) const;
+    void rehash(size_t capacity);
+
+    std::vector<Entry> _entries;
+    std::vector<uint8_t> _states;
+    size_t _size { 0 };
+    size_t _numErased { 0 };
+};
+
+#endif // hifi_ContactMap_h
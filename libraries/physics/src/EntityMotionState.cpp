@@ -150,7 +150,7 @@ void EntityMotionState::handleEasyChanges(uint32_t& flags) {
             } else {
                 // disowned object is still moving --> start timer for ownership bid
                 // TODO? put a delay in here proportional to distance from object?
-                _bumpedPriority = glm::max(_bumpedPriority, VOLUNTEER_SIMULATION_PRIORITY);
+                _bumpedPriority = glm::max(_bumpedPriority, Physics::getVolunteerPriority());
                 _nextBidExpiry = usecTimestampNow() + USECS_BETWEEN_OWNERSHIP_BIDS;
             }
             _loopsWithoutOwner = 0;
@@ -283,7 +283,7 @@ void EntityMotionState::setWorldTransform(const btTransform& worldTrans) {
     if (_entity->getSimulatorID().isNull()) {
         _loopsWithoutOwner++;
         if (_loopsWithoutOwner > LOOPS_FOR_SIMULATION_ORPHAN && usecTimestampNow() > _nextBidExpiry) {
-            _bumpedPriority = glm::max(_bumpedPriority, VOLUNTEER_SIMULATION_PRIORITY);
+            _bumpedPriority = glm::max(_bumpedPriority, Physics::getVolunteerPriority());
         }
     }
 }
@@ -748,7 +748,7 @@ bool EntityMotionState::shouldSendBid() const {
     return _body->isActive()
         && (_region == workload::Region::R1)
         && _ownershipState != EntityMotionState::OwnershipState::Unownable
-        && glm::max(glm::max(VOLUNTEER_SIMULATION_PRIORITY, _bumpedPriority), _entity->getScriptSimulationPriority()) >= _entity->getSimulationPriority()
+        && glm::max(glm::max(Physics::getVolunteerPriority(), _bumpedPriority), _entity->getScriptSimulationPriority()) >= _entity->getSimulationPriority()
         && !_entity->getLocked()
         && (!_body->isStaticOrKinematicObject() || _entity->stillHasMyGrab());
 }
@@ -764,7 +764,7 @@ void EntityMotionState::setRigidBody(btRigidBody* body) {
 
 uint8_t EntityMotionState::computeFinalBidPriority() const {
     return (_region == workload::Region::R1) ?
-        glm::max(glm::max(VOLUNTEER_SIMULATION_PRIORITY, _bumpedPriority), _entity->getScriptSimulationPriority()) : 0;
+        glm::max(glm::max(Physics::getVolunteerPriority(), _bumpedPriority), _entity->getScriptSimulationPriority()) : 0;
 }
 
 bool EntityMotionState::isLocallyOwned() const {
@@ -777,7 +777,7 @@ bool EntityMotionState::isLocallyOwnedOrShouldBe() const {
     if (_entity->getSimulatorID() == Physics::getSessionUUID()) {
         return true;
     } else {
-        return computeFinalBidPriority() > glm::max(VOLUNTEER_SIMULATION_PRIORITY, _entity->getSimulationPriority());
+        return computeFinalBidPriority() > glm::max(Physics::getVolunteerPriority(), _entity->getSimulationPriority());
     }
 }
 
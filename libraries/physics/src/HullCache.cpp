@@ -0,0 +1,161 @@
+//
+//  HullCache.cpp
+//  libraries/physics/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "HullCache.h"
+
+#include <string.h>
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QCryptographicHash>
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtCore/QStandardPaths>
+
+#include <BulletCollision/CollisionShapes/btOptimizedBvh.h>
+
+#include <NumericalConstants.h>
+#include <shared/GlobalAppProperties.h>
+
+#include "PhysicsLogging.h"
+#include "ShapeFactory.h"
+
+const uint32_t HullCache::CURRENT_VERSION = 2;
+
+static const uint32_t HULL_CACHE_MAGIC = 0x4c4c5548; // "HULL"
+static const QString HULL_CACHE_DIRNAME { "hull_cache" };
+static const std::string HULL_CACHE_EXT { "hull" };
+static const size_t HULL_CACHE_MAX_SIZE { MB_TO_BYTES(256) };
+static const int CHECKSUM_SIZE { 16 };
+
+struct HullCacheHeader {
+    uint32_t magic;
+    uint32_t version;
+    // BVHs are stored as Bullet lays them out in memory, so they can only be read by a build with the same layout
+    uint32_t layout;
+    uint32_t length;
+    char checksum[CHECKSUM_SIZE];
+};
+
+static uint32_t getLayout() {
+    return (uint32_t)((sizeof(void*) << 24) | (sizeof(btOptimizedBvh) << 12) | sizeof(btQuantizedBvhNode)) ^
+        (uint32_t)BT_BULLET_VERSION;
+}
+
+static QByteArray computeChecksum(const char* data, int size) {
+    return QCryptographicHash::hash(QByteArray::fromRawData(data, size), QCryptographicHash::Md5);
+}
+
+std::string HullCache::getSharedDirectory() {
+    QString overriddenPath = qApp ? qApp->property(hifi::properties::APP_LOCAL_DATA_PATH).toString() : QString();
+    if (!overriddenPath.isEmpty()) {
+        return QDir(overriddenPath).absoluteFilePath(HULL_CACHE_DIRNAME).toStdString();
+    }
+    // the per-application data paths differ between applications, so the cache goes one level up, next to them
+    QDir dir(QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation));
+    return dir.absoluteFilePath(QString("High Fidelity/") + HULL_CACHE_DIRNAME).toStdString();
+}
+
+HullCachePointer HullCache::create() {
+    auto cache = std::make_shared<HullCache>(getSharedDirectory());
+    cache->initialize();
+    return cache;
+}
+
+HullCache::Key HullCache::computeKey(const ShapeInfo& info) {
+    QCryptographicHash hash(QCryptographicHash::Md5);
+    uint32_t type = (uint32_t)info.getType();
+    hash.addData(reinterpret_cast<const char*>(&type), sizeof(type));
+    glm::vec3 halfExtents = info.getHalfExtents();
+    hash.addData(reinterpret_cast<const char*>(&halfExtents), sizeof(halfExtents));
+    glm::vec3 offset = info.getOffset();
+    hash.addData(reinterpret_cast<const char*>(&offset), sizeof(offset));
+    for (const auto& points : info.getPointCollection()) {
+        uint32_t numPoints = (uint32_t)points.size();
+        hash.addData(reinterpret_cast<const char*>(&numPoints), sizeof(numPoints));
+        hash.addData(reinterpret_cast<const char*>(points.constData()), numPoints * (int)sizeof(glm::vec3));
+    }
+    const ShapeInfo::TriangleIndices& indices = info.getTriangleIndices();
+    hash.addData(reinterpret_cast<const char*>(indices.constData()), indices.size() * (int)sizeof(indices[0]));
+    return hash.result().toHex().toStdString();
+}
+
+HullCache::HullCache(const std::string& dirname) :
+    FileCache(dirname, HULL_CACHE_EXT) {
+    setMaxSize(HULL_CACHE_MAX_SIZE);
+    // the directory is shared by the shape workers of several processes
+    setSharedDirectory(true);
+}
+
+const btCollisionShape* HullCache::getOrCreateShape(const ShapeInfo& info) {
+    if (!ShapeFactory::isExpensiveToBuild(info.getType())) {
+        return ShapeFactory::createShapeFromInfo(info);
+    }
+
+    Key key = computeKey(info);
+    QByteArray data;
+    if (readData(key, data)) {
+        const btCollisionShape* shape = ShapeFactory::createShapeFromData(info, data);
+        if (shape) {
+            ++_numHits;
+            return shape;
+        }
+        qCWarning(physics) << "HullCache: failed to rebuild shape" << key.c_str();
+    }
+
+    ++_numMisses;
+    const btCollisionShape* shape = ShapeFactory::createShapeFromInfo(info);
+    if (shape && ShapeFactory::serializeShape(info, shape, data)) {
+        writeData(key, data);
+    }
+    return shape;
+}
+
+bool HullCache::readData(const Key& key, QByteArray& data) {
+    auto file = getFile(key);
+    if (!file) {
+        return false;
+    }
+    QFile input(file->getFilepath().c_str());
+    if (!input.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    QByteArray contents = input.readAll();
+
+    // the whole record is checked before any of it is used, since a BVH is used in place as it was read
+    HullCacheHeader header;
+    if (contents.size() < (int)sizeof(header)) {
+        return false;
+    }
+    memcpy(&header, contents.constData(), sizeof(header));
+    if (header.magic != HULL_CACHE_MAGIC || header.version != CURRENT_VERSION || header.layout != getLayout() ||
+            header.length != (uint32_t)contents.size() - sizeof(header)) {
+        return false;
+    }
+    const char* payload = contents.constData() + sizeof(header);
+    if (computeChecksum(payload, (int)header.length) != QByteArray::fromRawData(header.checksum, CHECKSUM_SIZE)) {
+        qCWarning(physics) << "HullCache: corrupt entry" << key.c_str();
+        return false;
+    }
+    data = contents.mid(sizeof(header));
+    return true;
+}
+
+void HullCache::writeData(const Key& key, const QByteArray& data) {
+    HullCacheHeader header { HULL_CACHE_MAGIC, CURRENT_VERSION, getLayout(), (uint32_t)data.size(), {} };
+    QByteArray checksum = computeChecksum(data.constData(), data.size());
+    memcpy(header.checksum, checksum.constData(), CHECKSUM_SIZE);
+    QByteArray contents;
+    contents.reserve((int)sizeof(header) + data.size());
+    contents.append(reinterpret_cast<const char*>(&header), sizeof(header));
+    contents.append(data);
+    // overwrite, since an existing entry we get here for is stale or unreadable
+    size_t length = contents.size();
+    writeFileAsync(std::move(contents), Metadata(key, length), true);
+}
@@ -0,0 +1,64 @@
+//
+//  HullCache.h
+//  libraries/physics/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_HullCache_h
+#define hifi_HullCache_h
+
+#include <atomic>
+
+#include <QtCore/QByteArray>
+
+#include <shared/FileCache.h>
+#include <ShapeInfo.h>
+
+class btCollisionShape;
+
+// An on-disk cache of the expensive parts of collision shapes: the reduced hulls of compound and hull
+// shapes, and the BVHs of static meshes.  Entries are keyed by a hash of the shape's points, not its URL,
+// so they stay valid across sessions.
+//
+// The directory is shared by every process on the machine that builds shapes.  Entries are written atomically
+// and checksummed, and the least recently used ones are evicted once the whole directory is past the size limit.
+//
+// getOrCreateShape() is thread-safe, and is meant to be called from ShapeFactory::Worker.
+class HullCache : public cache::FileCache {
+    Q_OBJECT
+
+public:
+    // Whenever the serialized format, or the way shapes are built, changes in a way that isn't backward
+    // compatible this value should be incremented.  Entries with a different version are rebuilt.
+    static const uint32_t CURRENT_VERSION;
+
+    // a directory common to the processes on this machine
+    static std::string getSharedDirectory();
+
+    // returns an initialized cache in the shared directory
+    static std::shared_ptr<HullCache> create();
+
+    static Key computeKey(const ShapeInfo& info);
+
+    HullCache(const std::string& dirname);
+
+    const btCollisionShape* getOrCreateShape(const ShapeInfo& info);
+
+    uint32_t getNumHits() const { return _numHits; }
+    uint32_t getNumMisses() const { return _numMisses; }
+
+private:
+    bool readData(const Key& key, QByteArray& data);
+    void writeData(const Key& key, const QByteArray& data);
+
+    std::atomic<uint32_t> _numHits { 0 };
+    std::atomic<uint32_t> _numMisses { 0 };
+};
+
+using HullCachePointer = std::shared_ptr<HullCache>;
+
+#endif // hifi_HullCache_h
@@ -16,6 +16,7 @@
 
 #include "PhysicsHelpers.h"
 #include "PhysicsLogging.h"
+#include "ShapeFactory.h"
 #include "ShapeManager.h"
 
 
@@ -39,6 +40,11 @@ void PhysicalEntitySimulation::init(
     _entityPacketSender = packetSender;
 }
 
+uint8_t PhysicalEntitySimulation::getRegion(const EntityItemPointer& entity) const {
+    // without a workload space (e.g. a headless physics host) there is no view to be far from
+    return _space ? _space->getRegion(entity->getSpaceIndex()) : (uint8_t)workload::Region::R1;
+}
+
 // begin EntitySimulation overrides
 void PhysicalEntitySimulation::updateEntitiesInternal(uint64_t now) {
     // Do nothing here because the "internal" update the PhysicsEngine::stepSimulation() which is done elsewhere.
@@ -48,7 +54,7 @@ void PhysicalEntitySimulation::addEntityInternal(EntityItemPointer entity) {
     QMutexLocker lock(&_mutex);
     assert(entity);
     assert(!entity->isDead());
-    uint8_t region = _space->getRegion(entity->getSpaceIndex());
+    uint8_t region = getRegion(entity);
     bool maybeShouldBePhysical = (region < workload::Region::R3 || region == workload::Region::UNKNOWN) && entity->shouldBePhysical();
     bool canBeKinematic = region <= workload::Region::R3;
     if (maybeShouldBePhysical) {
@@ -137,7 +143,7 @@ void PhysicalEntitySimulation::processChangedEntity(const EntityItemPointer& ent
 
     // queue incoming changes: from external sources (script, EntityServer, etc) to physics engine
     EntityMotionState* motionState = static_cast<EntityMotionState*>(entity->getPhysicsInfo());
-    uint8_t region = _space->getRegion(entity->getSpaceIndex());
+    uint8_t region = getRegion(entity);
     bool shouldBePhysical = region < workload::Region::R3 && entity->shouldBePhysical();
     bool canBeKinematic = region <= workload::Region::R3;
     if (motionState) {
@@ -243,7 +249,7 @@ void PhysicalEntitySimulation::buildMotionStatesForEntitiesThatNeedThem() {
     auto buildMotionState = [&](btCollisionShape* shape, EntityItemPointer entity) {
         EntityMotionState* motionState = new EntityMotionState(shape, entity);
         entity->setPhysicsInfo(static_cast<void*>(motionState));
-        motionState->setRegion(_space->getRegion(entity->getSpaceIndex()));
+        motionState->setRegion(getRegion(entity));
         _physicalObjects.insert(motionState);
         _incomingChanges.insert(motionState);
     };
@@ -277,7 +283,7 @@ void PhysicalEntitySimulation::buildMotionStatesForEntitiesThatNeedThem() {
                         // bummer, the hashes are different and we no longer want the shape we've received
                         ObjectMotionState::getShapeManager()->releaseShape(shape);
                         // try again
-                        shape = const_cast<btCollisionShape*>(ObjectMotionState::getShapeManager()->getShape(shapeInfo));
+                        shape = const_cast<btCollisionShape*>(ObjectMotionState::getShapeManager()->requestShape(shapeInfo));
                         if (shape) {
                             buildMotionState(shape, entity);
                             requestItr = _shapeRequests.erase(requestItr);
@@ -331,7 +337,7 @@ void PhysicalEntitySimulation::buildMotionStatesForEntitiesThatNeedThem() {
             continue;
         }
 
-        uint8_t region = _space->getRegion(entity->getSpaceIndex());
+        uint8_t region = getRegion(entity);
         if (region == workload::Region::UNKNOWN) {
             // the workload hasn't categorized it yet --> skip for later
             ++entityItr;
@@ -343,6 +349,12 @@ void PhysicalEntitySimulation::buildMotionStatesForEntitiesThatNeedThem() {
             continue;
         }
 
+        if (!_modelShapesAvailable && ShapeFactory::isExpensiveToBuild(entity->getShapeType())) {
+            // its collider can't be built here, and simulating it without one would be wrong
+            entityItr = _entitiesToAddToPhysics.erase(entityItr);
+            continue;
+        }
+
         if (entity->isReadyToComputeShape()) {
             ShapeRequest shapeRequest(entity);
             ShapeRequests::iterator  requestItr = _shapeRequests.find(shapeRequest);
@@ -351,7 +363,7 @@ void PhysicalEntitySimulation::buildMotionStatesForEntitiesThatNeedThem() {
                 ShapeInfo shapeInfo;
                 entity->computeShapeInfo(shapeInfo);
                 uint32_t requestCount = ObjectMotionState::getShapeManager()->getWorkRequestCount();
-                btCollisionShape* shape = const_cast<btCollisionShape*>(ObjectMotionState::getShapeManager()->getShape(shapeInfo));
+                btCollisionShape* shape = const_cast<btCollisionShape*>(ObjectMotionState::getShapeManager()->requestShape(shapeInfo));
                 if (shape) {
                     buildMotionState(shape, entity);
                 } else if (requestCount != ObjectMotionState::getShapeManager()->getWorkRequestCount()) {
@@ -407,14 +419,14 @@ void PhysicalEntitySimulation::buildPhysicsTransaction(PhysicsEngine::Transactio
         bool needsNewShape = object->needsNewShape();
         if (needsNewShape) {
             ShapeType shapeType = object->getShapeType();
-            if (shapeType == SHAPE_TYPE_STATIC_MESH) {
+            if (ShapeFactory::isExpensiveToBuild(shapeType)) {
                 ShapeRequest shapeRequest(object->_entity);
                 ShapeRequests::iterator  requestItr = _shapeRequests.find(shapeRequest);
                 if (requestItr == _shapeRequests.end()) {
                     ShapeInfo shapeInfo;
                     object->_entity->computeShapeInfo(shapeInfo);
                     uint32_t requestCount = ObjectMotionState::getShapeManager()->getWorkRequestCount();
-                    btCollisionShape* shape = const_cast<btCollisionShape*>(ObjectMotionState::getShapeManager()->getShape(shapeInfo));
+                    btCollisionShape* shape = const_cast<btCollisionShape*>(ObjectMotionState::getShapeManager()->requestShape(shapeInfo));
                     if (shape) {
                         object->setShape(shape);
                         handledFlags |= Simulation::DIRTY_SHAPE;
@@ -58,6 +58,11 @@ public:
     void init(EntityTreePointer tree, PhysicsEnginePointer engine, EntityEditPacketSender* packetSender);
     void setWorkloadSpace(const workload::SpacePointer space) { _space = space; }
 
+    // whether the hull, compound and mesh shapes built from models can be computed here. without them (e.g. on a
+    // headless physics host, which doesn't load models) entities with those shapes are left out of the simulation,
+    // so that this participant never bids for them and they keep whatever owner they have
+    void setModelShapesAvailable(bool available) { _modelShapesAvailable = available; }
+
     virtual void addDynamic(EntityDynamicPointer dynamic) override;
     virtual void applyDynamicChanges() override;
 
@@ -96,8 +101,11 @@ public:
     void sendOwnershipBids(uint32_t numSubsteps);
     void sendOwnedUpdates(uint32_t numSubsteps);
 
+    uint32_t getNumOwnedEntities() const { return (uint32_t)_owned.size(); }
+
 private:
     void buildMotionStatesForEntitiesThatNeedThem();
+    uint8_t getRegion(const EntityItemPointer& entity) const;
 
     class ShapeRequest {
     public:
@@ -127,6 +135,7 @@ private:
     uint64_t _nextBidExpiry;
     uint32_t _lastStepSendPackets { 0 };
     uint32_t _lastWorkDeliveryCount { 0 };
+    bool _modelShapesAvailable { true };
 };
 
 
@@ -11,6 +11,7 @@
 
 #include "PhysicsEngine.h"
 
+#include <algorithm>
 #include <functional>
 
 #include <QFile>
@@ -26,6 +27,10 @@
 #include "PhysicsDebugDraw.h"
 #include "ThreadSafeDynamicsWorld.h"
 #include "PhysicsLogging.h"
+#include "PhysicsTaskScheduler.h"
+
+// overlapping pairs per narrow-phase task, large enough to amortize the task overhead over cheap pairs
+static const int NARROW_PHASE_GRAIN_SIZE = 40;
 
 PhysicsEngine::PhysicsEngine(const glm::vec3& offset) :
         _originOffset(offset),
@@ -37,18 +42,24 @@ PhysicsEngine::~PhysicsEngine() {
     delete _collisionConfig;
     delete _collisionDispatcher;
     delete _broadphaseFilter;
-    delete _constraintSolver;
     delete _dynamicsWorld;
+    delete _constraintSolver;
+    delete _constraintSolverPool;
     delete _ghostPairCallback;
 }
 
 void PhysicsEngine::init() {
     if (!_dynamicsWorld) {
+        // Bullet spreads the narrow-phase over the dispatcher's batches of pairs, and solves the simulation
+        // islands in parallel: small islands each on one solver from the pool, large ones with the Mt solver.
+        int numThreads = PhysicsTaskScheduler::getInstance().getNumThreads();
         _collisionConfig = new btDefaultCollisionConfiguration();
-        _collisionDispatcher = new btCollisionDispatcher(_collisionConfig);
+        _collisionDispatcher = new btCollisionDispatcherMt(_collisionConfig, NARROW_PHASE_GRAIN_SIZE);
         _broadphaseFilter = new btDbvtBroadphase();
-        _constraintSolver = new btSequentialImpulseConstraintSolver;
-        _dynamicsWorld = new ThreadSafeDynamicsWorld(_collisionDispatcher, _broadphaseFilter, _constraintSolver, _collisionConfig);
+        _constraintSolverPool = new btConstraintSolverPoolMt(numThreads);
+        _constraintSolver = new btSequentialImpulseConstraintSolverMt();
+        _dynamicsWorld = new ThreadSafeDynamicsWorld(_collisionDispatcher, _broadphaseFilter,
+                                                     _constraintSolverPool, _constraintSolver, _collisionConfig);
         _physicsDebugDraw.reset(new PhysicsDebugDraw());
 
         // hook up debug draw renderer
@@ -70,6 +81,15 @@ void PhysicsEngine::init() {
     }
 }
 
+void PhysicsEngine::setNumThreads(int numThreads) {
+    // the scheduler is shared by every engine, and the solver pool was sized at init()
+    PhysicsTaskScheduler::getInstance().setNumThreads(numThreads);
+}
+
+int PhysicsEngine::getNumThreads() const {
+    return PhysicsTaskScheduler::getInstance().getNumThreads();
+}
+
 uint32_t PhysicsEngine::getNumSubsteps() const {
     return _dynamicsWorld->getNumSubsteps();
 }
@@ -147,7 +167,7 @@ void PhysicsEngine::addObjectToDynamicsWorld(ObjectMotionState* motionState) {
             body->setCollisionFlags(btCollisionObject::CF_STATIC_OBJECT);
             body->updateInertiaTensor();
             if (motionState->isLocallyOwned()) {
-                _activeStaticBodies.insert(body);
+                _activeStaticBodies.push_back(body);
             }
             break;
         }
@@ -192,10 +212,9 @@ void PhysicsEngine::removeObjects(const VectorOfMotionStates& objects) {
         // frame (because the framerate is faster than our physics simulation rate).  When this happens we must scan
         // _activeStaticBodies for objects that were recently deleted so we don't try to access a dangling pointer.
         for (auto object : objects) {
-            std::set<btRigidBody*>::iterator itr = _activeStaticBodies.find(object->getRigidBody());
-            if (itr != _activeStaticBodies.end()) {
-                _activeStaticBodies.erase(itr);
-            }
+            btRigidBody* body = object->getRigidBody();
+            _activeStaticBodies.erase(std::remove(_activeStaticBodies.begin(), _activeStaticBodies.end(), body),
+                                      _activeStaticBodies.end());
         }
     }
 
@@ -257,10 +276,8 @@ void PhysicsEngine::processTransaction(PhysicsEngine::Transaction& transaction)
         btRigidBody* body = object->getRigidBody();
         if (body) {
             if (body->isStaticObject() && _activeStaticBodies.size() > 0) {
-                std::set<btRigidBody*>::iterator itr = _activeStaticBodies.find(body);
-                if (itr != _activeStaticBodies.end()) {
-                    _activeStaticBodies.erase(itr);
-                }
+                _activeStaticBodies.erase(std::remove(_activeStaticBodies.begin(), _activeStaticBodies.end(), body),
+                                          _activeStaticBodies.end());
             }
             removeDynamicsForBody(body);
             _dynamicsWorld->removeRigidBody(body);
@@ -285,7 +302,7 @@ void PhysicsEngine::processTransaction(PhysicsEngine::Transaction& transaction)
     for (auto object : transaction.activeStaticObjects) {
         btRigidBody* body = object->getRigidBody();
         _dynamicsWorld->updateSingleAabb(body);
-        _activeStaticBodies.insert(body);
+        _activeStaticBodies.push_back(body);
     }
 }
 
@@ -609,16 +626,16 @@ const VectorOfMotionStates& PhysicsEngine::getChangedMotionStates() {
     _dynamicsWorld->synchronizeMotionStates();
 
     // Bullet will not deactivate static objects (it doesn't expect them to be active)
-    // so we must deactivate them ourselves
-    std::set<btRigidBody*>::const_iterator itr = _activeStaticBodies.begin();
-    while (itr != _activeStaticBodies.end()) {
+    // so we must deactivate them ourselves.  A body may have been activated more than once.
+    std::sort(_activeStaticBodies.begin(), _activeStaticBodies.end());
+    auto last = std::unique(_activeStaticBodies.begin(), _activeStaticBodies.end());
+    for (auto itr = _activeStaticBodies.begin(); itr != last; ++itr) {
         btRigidBody* body = *itr;
         body->forceActivationState(ISLAND_SLEEPING);
         ObjectMotionState* motionState = static_cast<ObjectMotionState*>(body->getUserPointer());
         if (motionState) {
             _dynamicsWorld->addChangedMotionState(motionState);
         }
-        ++itr;
     }
     _activeStaticBodies.clear();
 
@@ -19,9 +19,12 @@
 #include <QUuid>
 #include <btBulletDynamicsCommon.h>
 #include <BulletCollision/CollisionDispatch/btGhostObject.h>
+#include <BulletCollision/CollisionDispatch/btCollisionDispatcherMt.h>
+#include <BulletDynamics/ConstraintSolver/btSequentialImpulseConstraintSolverMt.h>
 
 #include "BulletUtil.h"
 #include "ContactInfo.h"
+#include "ContactMap.h"
 #include "ObjectMotionState.h"
 #include "ThreadSafeDynamicsWorld.h"
 #include "ObjectAction.h"
@@ -32,17 +35,6 @@ const float HALF_SIMULATION_EXTENT = 512.0f; // meters
 class CharacterController;
 class PhysicsDebugDraw;
 
-// simple class for keeping track of contacts
-class ContactKey {
-public:
-    ContactKey() = delete;
-    ContactKey(void* a, void* b) : _a(a), _b(b) {}
-    bool operator<(const ContactKey& other) const { return _a < other._a || (_a == other._a && _b < other._b); }
-    bool operator==(const ContactKey& other) const { return _a == other._a && _b == other._b; }
-    void* _a; // ObjectMotionState pointer
-    void* _b; // ObjectMotionState pointer
-};
-
 struct ContactTestResult {
     ContactTestResult() = delete;
 
@@ -69,7 +61,6 @@ struct ContactTestResult {
     glm::vec3 collisionNormal;
 };
 
-using ContactMap = std::map<ContactKey, ContactInfo>;
 using CollisionEvents = std::vector<Collision>;
 
 class PhysicsEngine {
@@ -156,6 +147,10 @@ public:
 
     void setContactAddedCallback(ContactAddedCallback cb);
 
+    // the number of threads used for the narrow-phase and for solving islands, 1 to step serially
+    void setNumThreads(int numThreads);
+    int getNumThreads() const;
+
     btDiscreteDynamicsWorld* getDynamicsWorld() const { return _dynamicsWorld; }
     void removeContacts(ObjectMotionState* motionState);
 
@@ -170,9 +165,10 @@ private:
 
     btClock _clock;
     btDefaultCollisionConfiguration* _collisionConfig = NULL;
-    btCollisionDispatcher* _collisionDispatcher = NULL;
+    btCollisionDispatcherMt* _collisionDispatcher = NULL;
     btBroadphaseInterface* _broadphaseFilter = NULL;
-    btSequentialImpulseConstraintSolver* _constraintSolver = NULL;
+    btConstraintSolverPoolMt* _constraintSolverPool = NULL;
+    btSequentialImpulseConstraintSolverMt* _constraintSolver = NULL;
     ThreadSafeDynamicsWorld* _dynamicsWorld = NULL;
     btGhostPairCallback* _ghostPairCallback = NULL;
     std::unique_ptr<PhysicsDebugDraw> _physicsDebugDraw;
@@ -181,7 +177,7 @@ private:
     CollisionEvents _collisionEvents;
     QHash<QUuid, EntityDynamicPointer> _objectDynamics;
     QHash<btRigidBody*, QSet<QUuid>> _objectDynamicsByBody;
-    std::set<btRigidBody*> _activeStaticBodies;
+    std::vector<btRigidBody*> _activeStaticBodies;
     QString _statsFilename;
 
     glm::vec3 _originOffset;
@@ -0,0 +1,78 @@
+//
+//  PhysicsTaskScheduler.cpp
+//  libraries/physics/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "PhysicsTaskScheduler.h"
+
+#include <algorithm>
+#include <thread>
+
+#include <LinearMath/btQuickprof.h>
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/parallel_reduce.h>
+
+// physics stops scaling well past this, and the rest of the frame needs the other cores
+static const int MAX_PHYSICS_THREADS = 8;
+
+PhysicsTaskScheduler& PhysicsTaskScheduler::getInstance() {
+    static PhysicsTaskScheduler* instance = [] {
+        PhysicsTaskScheduler* scheduler = new PhysicsTaskScheduler();
+        btSetTaskScheduler(scheduler);
+        return scheduler;
+    }();
+    return *instance;
+}
+
+PhysicsTaskScheduler::PhysicsTaskScheduler() : btITaskScheduler("PhysicsTBB") {
+    setNumThreads(std::min((int)std::thread::hardware_concurrency(), MAX_PHYSICS_THREADS));
+}
+
+PhysicsTaskScheduler::~PhysicsTaskScheduler() {
+}
+
+int PhysicsTaskScheduler::getMaxNumThreads() const {
+    return std::min(std::max((int)std::thread::hardware_concurrency(), 1), (int)BT_MAX_THREAD_COUNT);
+}
+
+void PhysicsTaskScheduler::setNumThreads(int numThreads) {
+    _numThreads = std::max(1, std::min(numThreads, getMaxNumThreads()));
+    _arena.reset(new tbb::task_arena(_numThreads));
+}
+
+void PhysicsTaskScheduler::parallelFor(int iBegin, int iEnd, int grainSize, const btIParallelForBody& body) {
+    BT_PROFILE("parallelFor");
+    if (_numThreads == 1 || iEnd - iBegin <= grainSize) {
+        body.forLoop(iBegin, iEnd);
+        return;
+    }
+    _arena->execute([&] {
+        tbb::parallel_for(tbb::blocked_range<int>(iBegin, iEnd, std::max(grainSize, 1)),
+            [&](const tbb::blocked_range<int>& range) {
+                body.forLoop(range.begin(), range.end());
+            }, tbb::simple_partitioner());
+    });
+}
+
+btScalar PhysicsTaskScheduler::parallelSum(int iBegin, int iEnd, int grainSize, const btIParallelSumBody& body) {
+    BT_PROFILE("parallelSum");
+    if (_numThreads == 1 || iEnd - iBegin <= grainSize) {
+        return body.sumLoop(iBegin, iEnd);
+    }
+    btScalar sum = btScalar(0);
+    _arena->execute([&] {
+        sum = tbb::parallel_reduce(tbb::blocked_range<int>(iBegin, iEnd, std::max(grainSize, 1)), btScalar(0),
+            [&](const tbb::blocked_range<int>& range, btScalar partial) {
+                return partial + body.sumLoop(range.begin(), range.end());
+            }, [](btScalar a, btScalar b) {
+                return a + b;
+            }, tbb::simple_partitioner());
+    });
+    return sum;
+}
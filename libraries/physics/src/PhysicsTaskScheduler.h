@@ -0,0 +1,42 @@
+//
+//  PhysicsTaskScheduler.h
+//  libraries/physics/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_PhysicsTaskScheduler_h
+#define hifi_PhysicsTaskScheduler_h
+
+#include <memory>
+
+#include <LinearMath/btThreads.h>
+#include <tbb/task_arena.h>
+
+// Runs Bullet's parallel loops (narrow-phase, island solving, integration) on TBB, in an arena
+// limited to a few threads so that physics doesn't crowd out rendering and the other simulation work.
+// Bullet only calls into the scheduler when it was built with BT_THREADSAFE; otherwise the loops run serially.
+class PhysicsTaskScheduler : public btITaskScheduler {
+public:
+    // installs the shared scheduler into Bullet on first use
+    static PhysicsTaskScheduler& getInstance();
+
+    PhysicsTaskScheduler();
+    ~PhysicsTaskScheduler();
+
+    int getMaxNumThreads() const override;
+    int getNumThreads() const override { return _numThreads; }
+    void setNumThreads(int numThreads) override;
+
+    void parallelFor(int iBegin, int iEnd, int grainSize, const btIParallelForBody& body) override;
+    btScalar parallelSum(int iBegin, int iEnd, int grainSize, const btIParallelSumBody& body) override;
+
+private:
+    std::unique_ptr<tbb::task_arena> _arena;
+    int _numThreads { 1 };
+};
+
+#endif // hifi_PhysicsTaskScheduler_h
@@ -12,12 +12,30 @@
 #include "ShapeFactory.h"
 
 #include <glm/gtx/norm.hpp>
+#include <QtCore/QDataStream>
 
 #include <SharedUtil.h> // for MILLIMETERS_PER_METER
 
 #include "BulletUtil.h"
+#include "HullCache.h"
 
 
+// util method
+static void deleteStaticMeshArray(btTriangleIndexVertexArray* dataArray) {
+    IndexedMeshArray& meshes = dataArray->getIndexedMeshArray();
+    for (int32_t i = 0; i < meshes.size(); ++i) {
+        btIndexedMesh mesh = meshes[i];
+        mesh.m_numTriangles = 0;
+        delete [] mesh.m_triangleIndexBase;
+        mesh.m_triangleIndexBase = nullptr;
+        mesh.m_numVertices = 0;
+        delete [] mesh.m_vertexBase;
+        mesh.m_vertexBase = nullptr;
+    }
+    meshes.clear();
+    delete dataArray;
+}
+
 class StaticMeshShape : public btBvhTriangleMeshShape {
 public:
     StaticMeshShape() = delete;
@@ -27,26 +45,31 @@ public:
         assert(_dataArray);
     }
 
-    ~StaticMeshShape() {
+    // use a BVH that was deserialized in place rather than building a new one.
+    // The StaticMeshShape takes ownership of the bvhBuffer (from btAlignedAlloc) that holds it.
+    StaticMeshShape(btTriangleIndexVertexArray* dataArray, btOptimizedBvh* bvh, void* bvhBuffer)
+    :   btBvhTriangleMeshShape(dataArray, true, false), _dataArray(dataArray), _bvhBuffer(bvhBuffer) {
         assert(_dataArray);
-        IndexedMeshArray& meshes = _dataArray->getIndexedMeshArray();
-        for (int32_t i = 0; i < meshes.size(); ++i) {
-            btIndexedMesh mesh = meshes[i];
-            mesh.m_numTriangles = 0;
-            delete [] mesh.m_triangleIndexBase;
-            mesh.m_triangleIndexBase = nullptr;
-            mesh.m_numVertices = 0;
-            delete [] mesh.m_vertexBase;
-            mesh.m_vertexBase = nullptr;
+        assert(bvh && _bvhBuffer);
+        setOptimizedBvh(bvh);
+    }
+
+    ~StaticMeshShape() {
+        if (_bvhBuffer) {
+            // the BVH lives in our buffer, so the base class doesn't own it
+            getOptimizedBvh()->~btOptimizedBvh();
+            btAlignedFree(_bvhBuffer);
+            _bvhBuffer = nullptr;
         }
-        meshes.clear();
-        delete _dataArray;
+        assert(_dataArray);
+        deleteStaticMeshArray(_dataArray);
         _dataArray = nullptr;
     }
 
 private:
     // the StaticMeshShape owns its vertex/index data
     btTriangleIndexVertexArray* _dataArray;
+    void* _bvhBuffer { nullptr };
 };
 
 // the dataArray must be created before we create the StaticMeshShape
@@ -270,6 +293,33 @@ btTriangleIndexVertexArray* createStaticMeshArray(const ShapeInfo& info) {
     return dataArray;
 }
 
+// util method
+btCollisionShape* applyOffset(const ShapeInfo& info, btCollisionShape* shape) {
+    if (glm::length2(info.getOffset()) > MIN_SHAPE_OFFSET * MIN_SHAPE_OFFSET) {
+        // we need to apply an offset
+        btTransform offset;
+        offset.setIdentity();
+        offset.setOrigin(glmToBullet(info.getOffset()));
+
+        if (shape->getShapeType() == (int)COMPOUND_SHAPE_PROXYTYPE) {
+            // this shape is already compound
+            // walk through the child shapes and adjust their transforms
+            btCompoundShape* compound = static_cast<btCompoundShape*>(shape);
+            int32_t numSubShapes = compound->getNumChildShapes();
+            for (int32_t i = 0; i < numSubShapes; ++i) {
+                compound->updateChildTransform(i, offset * compound->getChildTransform(i), false);
+            }
+            compound->recalculateLocalAabb();
+        } else {
+            // wrap this shape in a compound
+            auto compound = new btCompoundShape();
+            compound->addChildShape(offset, shape);
+            shape = compound;
+        }
+    }
+    return shape;
+}
+
 const btCollisionShape* ShapeFactory::createShapeFromInfo(const ShapeInfo& info) {
     btCollisionShape* shape = nullptr;
     int type = info.getType();
@@ -439,28 +489,7 @@ const btCollisionShape* ShapeFactory::createShapeFromInfo(const ShapeInfo& info)
         break;
     }
     if (shape) {
-        if (glm::length2(info.getOffset()) > MIN_SHAPE_OFFSET * MIN_SHAPE_OFFSET) {
-            // we need to apply an offset
-            btTransform offset;
-            offset.setIdentity();
-            offset.setOrigin(glmToBullet(info.getOffset()));
-
-            if (shape->getShapeType() == (int)COMPOUND_SHAPE_PROXYTYPE) {
-                // this shape is already compound
-                // walk through the child shapes and adjust their transforms
-                btCompoundShape* compound = static_cast<btCompoundShape*>(shape);
-                int32_t numSubShapes = compound->getNumChildShapes();
-                for (int32_t i = 0; i < numSubShapes; ++i) {
-                    compound->updateChildTransform(i, offset * compound->getChildTransform(i), false);
-                }
-                compound->recalculateLocalAabb();
-            } else {
-                // wrap this shape in a compound
-                auto compound = new btCompoundShape();
-                compound->addChildShape(offset, shape);
-                shape = compound;
-            }
-        }
+        shape = applyOffset(info, shape);
     } else {
         // TODO: warn about this case
     }
@@ -488,7 +517,159 @@ void ShapeFactory::deleteShape(const btCollisionShape* shape) {
     delete nonConstShape;
 }
 
+bool ShapeFactory::isExpensiveToBuild(ShapeType type) {
+    return type == SHAPE_TYPE_COMPOUND || type == SHAPE_TYPE_SIMPLE_HULL ||
+        type == SHAPE_TYPE_SIMPLE_COMPOUND || type == SHAPE_TYPE_STATIC_MESH;
+}
+
+// util method
+static void writeHull(QDataStream& stream, const btConvexHullShape* hull) {
+    int32_t numPoints = hull->getNumPoints();
+    const btVector3* points = hull->getUnscaledPoints();
+    stream << (float)hull->getMargin() << numPoints;
+    for (int32_t i = 0; i < numPoints; ++i) {
+        stream << (float)points[i].getX() << (float)points[i].getY() << (float)points[i].getZ();
+    }
+}
+
+// util method
+static btConvexHullShape* readHull(QDataStream& stream) {
+    float margin;
+    int32_t numPoints;
+    stream >> margin >> numPoints;
+    if (stream.status() != QDataStream::Ok || numPoints < 1 || numPoints > MAX_HULL_POINTS) {
+        return nullptr;
+    }
+    btConvexHullShape* hull = new btConvexHullShape();
+    hull->setMargin(margin);
+    for (int32_t i = 0; i < numPoints; ++i) {
+        float x, y, z;
+        stream >> x >> y >> z;
+        hull->addPoint(btVector3(x, y, z), false);
+    }
+    if (stream.status() != QDataStream::Ok) {
+        delete hull;
+        return nullptr;
+    }
+    hull->recalcLocalAabb();
+    return hull;
+}
+
+bool ShapeFactory::serializeShape(const ShapeInfo& info, const btCollisionShape* shape, QByteArray& data) {
+    data.clear();
+    QDataStream stream(&data, QIODevice::WriteOnly);
+    stream.setFloatingPointPrecision(QDataStream::SinglePrecision);
+
+    if (info.getType() == SHAPE_TYPE_STATIC_MESH) {
+        // the mesh itself is quick to copy from the ShapeInfo, so only its BVH is kept
+        if (shape->getShapeType() == (int)COMPOUND_SHAPE_PROXYTYPE) {
+            // unwrap the offset
+            shape = static_cast<const btCompoundShape*>(shape)->getChildShape(0);
+        }
+        if (shape->getShapeType() != TRIANGLE_MESH_SHAPE_PROXYTYPE) {
+            return false;
+        }
+        btOptimizedBvh* bvh = const_cast<btBvhTriangleMeshShape*>(static_cast<const btBvhTriangleMeshShape*>(shape))->getOptimizedBvh();
+        if (!bvh) {
+            return false;
+        }
+        uint32_t bvhSize = bvh->calculateSerializeBufferSize();
+        void* buffer = btAlignedAlloc(bvhSize, 16);
+        bool serialized = bvh->serializeInPlace(buffer, bvhSize, false);
+        if (serialized) {
+            stream << bvhSize;
+            stream.writeRawData(static_cast<const char*>(buffer), (int)bvhSize);
+        }
+        btAlignedFree(buffer);
+        return serialized;
+    }
+
+    // the hulls have already been reduced and corrected for margin, so they can be used as they are
+    if (shape->getShapeType() == (int)COMPOUND_SHAPE_PROXYTYPE) {
+        const btCompoundShape* compound = static_cast<const btCompoundShape*>(shape);
+        int32_t numChildren = compound->getNumChildShapes();
+        stream << numChildren;
+        for (int32_t i = 0; i < numChildren; ++i) {
+            const btCollisionShape* child = compound->getChildShape(i);
+            if (child->getShapeType() != CONVEX_HULL_SHAPE_PROXYTYPE) {
+                return false;
+            }
+            const btTransform& transform = compound->getChildTransform(i);
+            btVector3 origin = transform.getOrigin();
+            btQuaternion rotation = transform.getRotation();
+            stream << (float)origin.getX() << (float)origin.getY() << (float)origin.getZ();
+            stream << (float)rotation.getX() << (float)rotation.getY() << (float)rotation.getZ() << (float)rotation.getW();
+            writeHull(stream, static_cast<const btConvexHullShape*>(child));
+        }
+    } else if (shape->getShapeType() == CONVEX_HULL_SHAPE_PROXYTYPE) {
+        // zero children means a lone hull
+        stream << (int32_t)0;
+        writeHull(stream, static_cast<const btConvexHullShape*>(shape));
+    } else {
+        return false;
+    }
+    return stream.status() == QDataStream::Ok;
+}
+
+const btCollisionShape* ShapeFactory::createShapeFromData(const ShapeInfo& info, const QByteArray& data) {
+    QDataStream stream(data);
+    stream.setFloatingPointPrecision(QDataStream::SinglePrecision);
+
+    if (info.getType() == SHAPE_TYPE_STATIC_MESH) {
+        uint32_t bvhSize;
+        stream >> bvhSize;
+        // the BVH is used in place, so it must be the whole of the rest of the data, and at least hold its header
+        if (stream.status() != QDataStream::Ok || bvhSize < sizeof(btOptimizedBvh) ||
+                (int)bvhSize != data.size() - (int)sizeof(bvhSize)) {
+            return nullptr;
+        }
+        btTriangleIndexVertexArray* dataArray = createStaticMeshArray(info);
+        if (!dataArray) {
+            return nullptr;
+        }
+        void* buffer = btAlignedAlloc(bvhSize, 16);
+        btOptimizedBvh* bvh = nullptr;
+        if (stream.readRawData(static_cast<char*>(buffer), (int)bvhSize) == (int)bvhSize) {
+            bvh = btOptimizedBvh::deSerializeInPlace(buffer, bvhSize, false);
+        }
+        if (!bvh) {
+            btAlignedFree(buffer);
+            deleteStaticMeshArray(dataArray);
+            return nullptr;
+        }
+        return applyOffset(info, new StaticMeshShape(dataArray, bvh, buffer));
+    }
+
+    int32_t numChildren;
+    stream >> numChildren;
+    if (stream.status() != QDataStream::Ok || numChildren < 0) {
+        return nullptr;
+    }
+    if (numChildren == 0) {
+        return readHull(stream);
+    }
+
+    btCompoundShape* compound = new btCompoundShape();
+    for (int32_t i = 0; i < numChildren; ++i) {
+        float x, y, z, w;
+        stream >> x >> y >> z;
+        btVector3 origin(x, y, z);
+        stream >> x >> y >> z >> w;
+        btConvexHullShape* hull = readHull(stream);
+        if (!hull) {
+            ShapeFactory::deleteShape(compound);
+            return nullptr;
+        }
+        compound->addChildShape(btTransform(btQuaternion(x, y, z, w), origin), hull);
+    }
+    return compound;
+}
+
 void ShapeFactory::Worker::run() {
-    shape = ShapeFactory::createShapeFromInfo(shapeInfo);
+    if (cache) {
+        shape = cache->getOrCreateShape(shapeInfo);
+    } else {
+        shape = ShapeFactory::createShapeFromInfo(shapeInfo);
+    }
     emit submitWork(this);
 }
@@ -12,19 +12,33 @@
 #ifndef hifi_ShapeFactory_h
 #define hifi_ShapeFactory_h
 
+#include <memory>
+
 #include <btBulletDynamicsCommon.h>
 #include <glm/glm.hpp>
 #include <QObject>
+#include <QtCore/QByteArray>
 #include <QtCore/QRunnable>
 
 #include <ShapeInfo.h>
 
+class HullCache;
+
 // The ShapeFactory assembles and correctly disassembles btCollisionShapes.
 
 namespace ShapeFactory {
     const btCollisionShape* createShapeFromInfo(const ShapeInfo& info);
     void deleteShape(const btCollisionShape* shape);
 
+    // true for the shapes whose construction is slow enough to do off the simulation thread
+    // (hull reduction and mesh BVH building), which are also the ones worth keeping in a HullCache
+    bool isExpensiveToBuild(ShapeType type);
+
+    // Save the expensive results (reduced hull points, or a mesh's BVH) of a shape built from info,
+    // and rebuild the shape from them.  serializeShape() returns false for shapes it can't save.
+    bool serializeShape(const ShapeInfo& info, const btCollisionShape* shape, QByteArray& data);
+    const btCollisionShape* createShapeFromData(const ShapeInfo& info, const QByteArray& data);
+
     class Worker : public QObject, public QRunnable {
         Q_OBJECT
     public:
@@ -32,6 +46,7 @@ namespace ShapeFactory {
         void run() override;
         ShapeInfo shapeInfo;
         const btCollisionShape* shape;
+        std::shared_ptr<HullCache> cache;
     signals:
         void submitWork(Worker*);
     };
@@ -12,8 +12,8 @@
 #include "ShapeManager.h"
 
 #include <glm/gtx/norm.hpp>
-#include <QThreadPool>
 
+#include <JobScheduler.h>
 #include <NumericalConstants.h>
 
 const int MAX_RING_SIZE = 256;
@@ -37,6 +37,14 @@ ShapeManager::~ShapeManager() {
 }
 
 const btCollisionShape* ShapeManager::getShape(const ShapeInfo& info) {
+    return getShape(info, info.getType() == SHAPE_TYPE_STATIC_MESH);
+}
+
+const btCollisionShape* ShapeManager::requestShape(const ShapeInfo& info) {
+    return getShape(info, ShapeFactory::isExpensiveToBuild(info.getType()));
+}
+
+const btCollisionShape* ShapeManager::getShape(const ShapeInfo& info, bool buildOffThread) {
     if (info.getType() == SHAPE_TYPE_NONE) {
         return nullptr;
     }
@@ -47,17 +55,17 @@ const btCollisionShape* ShapeManager::getShape(const ShapeInfo& info) {
         return shapeRef->shape;
     }
     const btCollisionShape* shape = nullptr;
-    if (info.getType() == SHAPE_TYPE_STATIC_MESH) {
+    if (buildOffThread) {
         uint64_t hash = info.getHash();
 
         // bump the request count to the caller knows we're 
         // starting or waiting on a thread.
         ++_workRequestCount;
 
-        const auto itr = std::find(_pendingMeshShapes.begin(), _pendingMeshShapes.end(), hash);
-        if (itr == _pendingMeshShapes.end()) {
+        const auto itr = std::find(_pendingShapes.begin(), _pendingShapes.end(), hash);
+        if (itr == _pendingShapes.end()) {
             // start a worker
-            _pendingMeshShapes.push_back(hash);
+            _pendingShapes.push_back(hash);
             // try to recycle old deadWorker
             ShapeFactory::Worker* worker = _deadWorker;
             if (!worker) {
@@ -66,14 +74,15 @@ const btCollisionShape* ShapeManager::getShape(const ShapeInfo& info) {
                 worker->shapeInfo = info;
                 _deadWorker = nullptr;
             }
+            worker->cache = _hullCache;
             // we will delete worker manually later
             worker->setAutoDelete(false);
             QObject::connect(worker, &ShapeFactory::Worker::submitWork, this, &ShapeManager::acceptWork);
-            QThreadPool::globalInstance()->start(worker);
+            JobScheduler::getInstance().submit(JobScheduler::GEOMETRY, worker);
         }
         // else we're still waiting for the shape to be created on another thread
     } else {
-        shape = ShapeFactory::createShapeFromInfo(info);
+        shape = _hullCache ? _hullCache->getOrCreateShape(info) : ShapeFactory::createShapeFromInfo(info);
         if (shape) {
             ShapeReference newRef;
             newRef.refCount = 1;
@@ -208,8 +217,8 @@ bool ShapeManager::hasShape(const btCollisionShape* shape) const {
 
 // slot: called when ShapeFactory::Worker is done building shape
 void ShapeManager::acceptWork(ShapeFactory::Worker* worker) {
-    auto itr = std::find(_pendingMeshShapes.begin(), _pendingMeshShapes.end(), worker->shapeInfo.getHash());
-    if (itr == _pendingMeshShapes.end()) {
+    auto itr = std::find(_pendingShapes.begin(), _pendingShapes.end(), worker->shapeInfo.getHash());
+    if (itr == _pendingShapes.end()) {
         // we've received a shape but don't remember asking for it
         // (should not fall in here, but if we do: delete the unwanted shape)
         if (worker->shape) {
@@ -217,8 +226,8 @@ void ShapeManager::acceptWork(ShapeFactory::Worker* worker) {
         }
     } else {
         // clear pending status
-        *itr = _pendingMeshShapes.back();
-        _pendingMeshShapes.pop_back();
+        *itr = _pendingShapes.back();
+        _pendingShapes.pop_back();
 
         // cache the new shape
         if (worker->shape) {
@@ -277,6 +286,7 @@ void ShapeManager::acceptWork(ShapeFactory::Worker* worker) {
     // save this dead worker for later
     worker->shapeInfo.clear();
     worker->shape = nullptr;
+    worker->cache.reset();
     _deadWorker = worker;
     ++_workDeliveryCount;
 }
@@ -24,6 +24,7 @@
 
 #include "ShapeFactory.h"
 #include "HashKey.h"
+#include "HullCache.h"
 
 // The ShapeManager handles the ref-counting on shared shapes:
 //
@@ -41,6 +42,12 @@
 // and returns the pointer.  If not it asks the ShapeFactory to create it, adds an
 // entry in the map with a ref-count of 1, and returns the pointer.
 //
+// Shapes that are expensive to build (see ShapeFactory::isExpensiveToBuild()) may instead be built
+// on a background job: requestShape() returns nullptr and bumps the work request count, and the shape
+// is delivered later (bumping the delivery count) to be fetched with getShapeByKey().  Static meshes
+// are always built this way.  When a HullCache is set the expensive results are loaded from, and saved
+// to, disk.
+//
 // When a body stops using a shape the ShapeManager must be informed so it can
 // decrement its ref-count.  When a ref-count drops to zero the ShapeManager
 // doesn't delete it right away.  Instead it puts the shape's key on a list delete
@@ -57,6 +64,9 @@ public:
 
     /// \return pointer to shape
     const btCollisionShape* getShape(const ShapeInfo& info);
+
+    /// \return pointer to shape, or nullptr if the shape is being built off-thread
+    const btCollisionShape* requestShape(const ShapeInfo& info);
     const btCollisionShape* getShapeByKey(uint64_t key);
     bool hasShapeWithKey(uint64_t key) const;
 
@@ -74,10 +84,13 @@ public:
     uint32_t getWorkRequestCount() const { return _workRequestCount; }
     uint32_t getWorkDeliveryCount() const { return _workDeliveryCount; }
 
+    void setHullCache(const HullCachePointer& hullCache) { _hullCache = hullCache; }
+
 protected slots:
     void acceptWork(ShapeFactory::Worker* worker);
 
 private:
+    const btCollisionShape* getShape(const ShapeInfo& info, bool buildOffThread);
     void addToGarbage(uint64_t key);
     bool releaseShapeByKey(uint64_t key);
 
@@ -100,9 +113,10 @@ private:
     // btHashMap is required because it supports memory alignment of the btCollisionShapes
     btHashMap<HashKey, ShapeReference> _shapeMap;
     std::vector<uint64_t> _garbageRing;
-    std::vector<uint64_t> _pendingMeshShapes;
+    std::vector<uint64_t> _pendingShapes;
     std::vector<KeyExpiry> _orphans;
     ShapeFactory::Worker* _deadWorker { nullptr };
+    HullCachePointer _hullCache;
     TimePoint _nextOrphanExpiry;
     uint32_t _ringIndex { 0 };
     std::atomic_uint _workRequestCount { 0 };
@@ -30,10 +30,22 @@ Clip::Pointer Clip::fromFile(const QString& filePath) {
 }
 
 void Clip::toFile(const QString& filePath, const Clip::ConstPointer& clip) {
+    // Clips that already live on disk, such as streamed recordings, are copied rather than re-encoded
+    if (auto fileClip = std::dynamic_pointer_cast<const FileClip>(clip)) {
+        if (fileClip->copyTo(filePath)) {
+            return;
+        }
+    }
     FileClip::write(filePath, clip->duplicate());
 }
 
 QByteArray Clip::toBuffer(const Clip::ConstPointer& clip) {
+    if (auto fileClip = std::dynamic_pointer_cast<const FileClip>(clip)) {
+        QFile file(fileClip->getName());
+        if (file.open(QFile::ReadOnly)) {
+            return file.readAll();
+        }
+    }
     QBuffer buffer;
     if (buffer.open(QFile::Truncate | QFile::WriteOnly)) {
         clip->duplicate()->write(buffer);
@@ -90,10 +102,62 @@ bool writeFrame(QIODevice& output, const Frame& frame, bool compressed = true) {
     return true;
 }
 
+// Frames are grouped into blocks of roughly this many uncompressed bytes, so that each
+// decompression call amortizes over many frames and seeking only needs to decode one block
+const int Clip::TARGET_FRAME_BLOCK_SIZE = 64 * 1024;
+const size_t Clip::MAX_FRAMES_PER_BLOCK = 256;
+
+bool Clip::isValidBlockFrame(const FrameConstPointer& frame) {
+    if (frame->type == Frame::TYPE_INVALID) {
+        qWarning() << "Attempting to write invalid frame";
+        return false;
+    }
+    if (frame->data.size() > std::numeric_limits<FrameSize>::max()) {
+        qCWarning(recordingLog) << "Frame of" << frame->data.size() << "bytes is too large, skipping";
+        return false;
+    }
+    return true;
+}
+
+bool Clip::writeFrameBlock(QIODevice& output, const std::vector<FrameConstPointer>& frames) {
+    if (frames.empty()) {
+        return true;
+    }
+
+    QByteArray payload;
+    for (const auto& frame : frames) {
+        payload.append(frame->data);
+    }
+    QByteArray compressedPayload = qCompress(payload);
+
+    ClipBlockHeader blockHeader;
+    blockHeader.frameCount = (uint32_t)frames.size();
+    blockHeader.uncompressedSize = (uint32_t)payload.size();
+    blockHeader.compressedSize = (uint32_t)compressedPayload.size();
+    if (output.write((char*)&blockHeader, sizeof(ClipBlockHeader)) != sizeof(ClipBlockHeader)) {
+        return false;
+    }
+
+    // The per frame index is stored uncompressed so readers can seek without decoding the payload
+    for (const auto& frame : frames) {
+        FrameSize dataSize = (FrameSize)frame->data.size();
+        if (output.write((char*)&(frame->type), sizeof(FrameType)) != sizeof(FrameType) ||
+            output.write((char*)&(frame->timeOffset), sizeof(Frame::Time)) != sizeof(Frame::Time) ||
+            output.write((char*)&dataSize, sizeof(FrameSize)) != sizeof(FrameSize)) {
+            return false;
+        }
+    }
+
+    return output.write(compressedPayload) == compressedPayload.size();
+}
+
 const QString Clip::FRAME_TYPE_MAP = QStringLiteral("frameTypes");
 const QString Clip::FRAME_COMREPSSION_FLAG = QStringLiteral("compressed");
+const QString Clip::FORMAT_VERSION = QStringLiteral("formatVersion");
+const int Clip::LEGACY_FORMAT_VERSION = 1;
+const int Clip::BLOCK_FORMAT_VERSION = 2;
 
-bool Clip::write(QIODevice& output) {
+bool Clip::writeHeader(QIODevice& output) {
     auto frameTypes = Frame::getFrameTypes();
     QJsonObject frameTypeObj;
     for (const auto& frameTypeName : frameTypes.keys()) {
@@ -102,20 +166,37 @@ bool Clip::write(QIODevice& output) {
 
     QJsonObject rootObject;
     rootObject.insert(FRAME_TYPE_MAP, frameTypeObj);
-    // Always mark new files as compressed
-    rootObject.insert(FRAME_COMREPSSION_FLAG, true);
+    // New files are block compressed, which only readers that know the format version can read.  Older readers
+    // don't check it, and will misread the block headers as frames rather than reject the file
+    rootObject.insert(FORMAT_VERSION, BLOCK_FORMAT_VERSION);
     QByteArray headerFrameData = QJsonDocument(rootObject).toBinaryData();
     // Never compress the header frame
-    if (!writeFrame(output, Frame({ Frame::TYPE_HEADER, 0, headerFrameData }), false)) {
+    return writeFrame(output, Frame({ Frame::TYPE_HEADER, 0, headerFrameData }), false);
+}
+
+bool Clip::write(QIODevice& output) {
+    if (!writeHeader(output)) {
         return false;
     }
 
     seek(0);
 
+    std::vector<FrameConstPointer> blockFrames;
+    blockFrames.reserve(MAX_FRAMES_PER_BLOCK);
+    int blockSize = 0;
     for (auto frame = nextFrame(); frame; frame = nextFrame()) {
-        if (!writeFrame(output, *frame)) {
-            return false;
+        if (!isValidBlockFrame(frame)) {
+            continue;
+        }
+        blockFrames.push_back(frame);
+        blockSize += frame->data.size();
+        if (blockSize >= TARGET_FRAME_BLOCK_SIZE || blockFrames.size() >= MAX_FRAMES_PER_BLOCK) {
+            if (!writeFrameBlock(output, blockFrames)) {
+                return false;
+            }
+            blockFrames.clear();
+            blockSize = 0;
         }
     }
-    return true;
+    return writeFrameBlock(output, blockFrames);
 }
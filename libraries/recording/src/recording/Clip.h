@@ -13,6 +13,7 @@
 #include "Forward.h"
 
 #include <mutex>
+#include <vector>
 
 #include <QtCore/QObject>
 
@@ -49,6 +50,11 @@ public:
 
     bool write(QIODevice& output);
 
+    // Low level serialization, shared with the streaming ClipWriter
+    static bool writeHeader(QIODevice& output);
+    static bool isValidBlockFrame(const FrameConstPointer& frame);
+    static bool writeFrameBlock(QIODevice& output, const std::vector<FrameConstPointer>& frames);
+
     static Pointer fromFile(const QString& filePath);
     static void toFile(const QString& filePath, const ConstPointer& clip);
     static QByteArray toBuffer(const ConstPointer& clip);
@@ -56,6 +62,13 @@ public:
     
     static const QString FRAME_TYPE_MAP;
     static const QString FRAME_COMREPSSION_FLAG;
+    // The layout of the frames after the header: absent (LEGACY_FORMAT_VERSION) for individual, optionally
+    // qCompressed frames, BLOCK_FORMAT_VERSION for frames grouped into compressed blocks
+    static const QString FORMAT_VERSION;
+    static const int LEGACY_FORMAT_VERSION;
+    static const int BLOCK_FORMAT_VERSION;
+    static const int TARGET_FRAME_BLOCK_SIZE;
+    static const size_t MAX_FRAMES_PER_BLOCK;
 
 protected:
     friend class WrapperClip;
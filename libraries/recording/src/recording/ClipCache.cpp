@@ -16,6 +16,91 @@
 #include "Logging.h"
 
 using namespace recording;
+
+// Enough for a few minutes of full-body avatar playback per distinct clip
+const size_t DecodedFrameCache::DEFAULT_MAX_SIZE = 64 * 1024 * 1024;
+
+DecodedFrameCache& DecodedFrameCache::instance() {
+    static DecodedFrameCache cache;
+    return cache;
+}
+
+size_t DecodedFrameCache::blockSize(const FrameBlock& block) {
+    size_t result = sizeof(FrameBlock);
+    for (const auto& frame : block) {
+        result += sizeof(Frame) + (frame ? frame->data.size() : 0);
+    }
+    return result;
+}
+
+DecodedFrameCache::FrameBlockPointer DecodedFrameCache::find(const QByteArray& contentKey, uint32_t blockIndex) {
+    std::unique_lock<std::mutex> lock(_mutex);
+    auto itr = _entries.find(Key(contentKey, blockIndex));
+    if (itr == _entries.end()) {
+        ++_misses;
+        return FrameBlockPointer();
+    }
+    ++_hits;
+    // Move to the most recently used position
+    _lru.splice(_lru.begin(), _lru, itr->second);
+    return itr->second->block;
+}
+
+DecodedFrameCache::FrameBlockPointer DecodedFrameCache::insert(const QByteArray& contentKey, uint32_t blockIndex, const FrameBlockPointer& block) {
+    if (!block) {
+        return block;
+    }
+    Key key(contentKey, blockIndex);
+    std::unique_lock<std::mutex> lock(_mutex);
+    auto itr = _entries.find(key);
+    if (itr != _entries.end()) {
+        // Another player decoded the same block while we were working, share theirs
+        _lru.splice(_lru.begin(), _lru, itr->second);
+        return itr->second->block;
+    }
+    auto size = blockSize(*block);
+    _lru.push_front({ key, block, size });
+    _entries[key] = _lru.begin();
+    _size += size;
+    evict();
+    return block;
+}
+
+void DecodedFrameCache::evict() {
+    // Never evict the most recently inserted block, even if it alone exceeds the budget
+    while (_size > _maxSize && _lru.size() > 1) {
+        const auto& entry = _lru.back();
+        _size -= entry.size;
+        _entries.erase(entry.key);
+        _lru.pop_back();
+    }
+}
+
+void DecodedFrameCache::clear() {
+    std::unique_lock<std::mutex> lock(_mutex);
+    _entries.clear();
+    _lru.clear();
+    _size = 0;
+    _hits = 0;
+    _misses = 0;
+}
+
+void DecodedFrameCache::setMaxSize(size_t maxSize) {
+    std::unique_lock<std::mutex> lock(_mutex);
+    _maxSize = maxSize;
+    evict();
+}
+
+size_t DecodedFrameCache::getMaxSize() const {
+    std::unique_lock<std::mutex> lock(_mutex);
+    return _maxSize;
+}
+
+size_t DecodedFrameCache::getSize() const {
+    std::unique_lock<std::mutex> lock(_mutex);
+    return _size;
+}
+
 NetworkClipLoader::NetworkClipLoader(const QUrl& url) :
     Resource(url),
     _clip(std::make_shared<NetworkClip>(url)) {
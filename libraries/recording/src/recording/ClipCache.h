@@ -9,6 +9,12 @@
 #ifndef hifi_Recording_ClipCache_h
 #define hifi_Recording_ClipCache_h
 
+#include <atomic>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
 #include <ResourceCache.h>
 
 #include "Forward.h"
@@ -16,6 +22,54 @@
 
 namespace recording {
 
+// Process-wide cache of decoded frame blocks.  Clips that refer to the same content (the same
+// URL or file) share a content key, so players replaying the same clip at nearby offsets only
+// pay for decompression once.
+class DecodedFrameCache {
+public:
+    using FrameBlock = DecodedFrameBlock;
+    using FrameBlockPointer = DecodedFrameBlockPointer;
+
+    static DecodedFrameCache& instance();
+
+    // contentKey identifies the clip data, see PointerClip::computeContentKey()
+    FrameBlockPointer find(const QByteArray& contentKey, uint32_t blockIndex);
+    // Returns the cached block, which may be a block inserted concurrently by another player
+    FrameBlockPointer insert(const QByteArray& contentKey, uint32_t blockIndex, const FrameBlockPointer& block);
+    void clear();
+
+    void setMaxSize(size_t maxSize);
+    size_t getMaxSize() const;
+    size_t getSize() const;
+    size_t getHits() const { return _hits; }
+    size_t getMisses() const { return _misses; }
+
+    static const size_t DEFAULT_MAX_SIZE;
+
+private:
+    using Key = std::pair<QByteArray, uint32_t>;
+    struct KeyHash {
+        size_t operator()(const Key& key) const { return qHash(key.first, key.second); }
+    };
+    struct Entry {
+        Key key;
+        FrameBlockPointer block;
+        size_t size;
+    };
+    using EntryList = std::list<Entry>;
+
+    static size_t blockSize(const FrameBlock& block);
+    void evict();
+
+    mutable std::mutex _mutex;
+    EntryList _lru;
+    std::unordered_map<Key, EntryList::iterator, KeyHash> _entries;
+    size_t _size { 0 };
+    size_t _maxSize { DEFAULT_MAX_SIZE };
+    std::atomic<size_t> _hits { 0 };
+    std::atomic<size_t> _misses { 0 };
+};
+
 class NetworkClip : public PointerClip {
 public:
     using Pointer = std::shared_ptr<NetworkClip>;
@@ -24,6 +78,9 @@ public:
     virtual void init(const QByteArray& clipData);
     virtual QString getName() const override { return _url.toString(); }
 
+protected:
+    QByteArray getSourceKey() const override { return _url.toString().toUtf8(); }
+
 private:
     QByteArray _clipData;
     QUrl _url;
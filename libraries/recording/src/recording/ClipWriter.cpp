@@ -0,0 +1,143 @@
+//
+//  ClipWriter.cpp
+//  libraries/recording/src/recording
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ClipWriter.h"
+
+#include "Clip.h"
+#include "Frame.h"
+#include "Logging.h"
+
+using namespace recording;
+
+const size_t ClipWriter::PENDING_BLOCKS_WARNING_THRESHOLD = 8;
+// about 2 MB of frames at the target block size
+const size_t ClipWriter::MAX_PENDING_BLOCKS = 32;
+
+ClipWriter::ClipWriter(const QString& filePath) : _file(filePath) {
+}
+
+ClipWriter::~ClipWriter() {
+    finish();
+}
+
+bool ClipWriter::open() {
+    if (_open) {
+        return true;
+    }
+
+    if (!_file.open(QFile::Truncate | QFile::WriteOnly)) {
+        qCWarning(recordingLog) << "Unable to open recording file" << _file.fileName();
+        return false;
+    }
+
+    if (!Clip::writeHeader(_file) || !_file.flush()) {
+        qCWarning(recordingLog) << "Unable to write recording header to" << _file.fileName();
+        _file.close();
+        _file.remove();
+        return false;
+    }
+
+    _open = true;
+    _finishing = false;
+    _failed = false;
+    _fallingBehind = false;
+    _numDroppedFrames = 0;
+    _thread = std::thread([this] { run(); });
+    return true;
+}
+
+void ClipWriter::addFrame(const FrameConstPointer& frame) {
+    if (!_open || !frame || !Clip::isValidBlockFrame(frame)) {
+        return;
+    }
+
+    _currentBlock.push_back(frame);
+    _currentBlockSize += frame->data.size();
+    if (_currentBlockSize >= Clip::TARGET_FRAME_BLOCK_SIZE || _currentBlock.size() >= Clip::MAX_FRAMES_PER_BLOCK) {
+        queueCurrentBlock();
+    }
+}
+
+void ClipWriter::queueCurrentBlock() {
+    if (_currentBlock.empty()) {
+        return;
+    }
+
+    std::unique_lock<std::mutex> lock(_mutex);
+    // The caller is the recording thread, which must never wait on the disk, so a slow disk grows the queue,
+    // up to its limit, and past that loses frames instead
+    bool fallingBehind = _pendingBlocks.size() >= PENDING_BLOCKS_WARNING_THRESHOLD;
+    if (fallingBehind && !_fallingBehind) {
+        qCWarning(recordingLog) << "Recording to" << _file.fileName() << "is falling behind," << _pendingBlocks.size() << "blocks pending";
+    }
+    _fallingBehind = fallingBehind;
+    if (_pendingBlocks.size() < MAX_PENDING_BLOCKS) {
+        _pendingBlocks.push_back(std::move(_currentBlock));
+    } else {
+        if (_numDroppedFrames == 0) {
+            qCWarning(recordingLog) << "Recording to" << _file.fileName() << "can't keep up, dropping frames";
+        }
+        _numDroppedFrames += _currentBlock.size();
+    }
+    _currentBlock = Block();
+    _currentBlock.reserve(Clip::MAX_FRAMES_PER_BLOCK);
+    _currentBlockSize = 0;
+    lock.unlock();
+    _condition.notify_all();
+}
+
+void ClipWriter::run() {
+    while (true) {
+        Block block;
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _condition.wait(lock, [this] { return _finishing || !_pendingBlocks.empty(); });
+            if (_pendingBlocks.empty()) {
+                return;
+            }
+            block = std::move(_pendingBlocks.front());
+            _pendingBlocks.pop_front();
+        }
+        _condition.notify_all();
+
+        if (_failed) {
+            continue;
+        }
+
+        // Each block carries its own frame index, so flushing after every block keeps the file
+        // readable up to the last complete block
+        if (!Clip::writeFrameBlock(_file, block) || !_file.flush()) {
+            qCWarning(recordingLog) << "Failed writing recording to" << _file.fileName();
+            _failed = true;
+        }
+    }
+}
+
+bool ClipWriter::finish() {
+    if (!_open) {
+        return !_failed;
+    }
+
+    queueCurrentBlock();
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _finishing = true;
+    }
+    _condition.notify_all();
+    if (_thread.joinable()) {
+        _thread.join();
+    }
+    _file.close();
+    _open = false;
+    if (_numDroppedFrames > 0) {
+        qCWarning(recordingLog) << "Recording to" << _file.fileName() << "dropped" << (quint64)_numDroppedFrames << "frames";
+    }
+    return !_failed;
+}
@@ -0,0 +1,80 @@
+//
+//  ClipWriter.h
+//  libraries/recording/src/recording
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+#ifndef hifi_Recording_ClipWriter_h
+#define hifi_Recording_ClipWriter_h
+
+#include "Forward.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <QtCore/QFile>
+
+namespace recording {
+
+// Streams frames to a block compressed clip file as they are recorded.  Frames are gathered
+// into blocks which are compressed and appended by a background thread, so memory use is
+// a handful of blocks regardless of the recording length.  addFrame never waits for the writer,
+// since it is called from the recording thread: when the disk falls so far behind that
+// MAX_PENDING_BLOCKS are waiting, further blocks are dropped, and their frames counted, until it
+// catches up.  Every block is flushed once written, so a partial file left behind by a crash is
+// still a readable clip.
+class ClipWriter {
+public:
+    using Pointer = std::shared_ptr<ClipWriter>;
+
+    ClipWriter(const QString& filePath);
+    ~ClipWriter();
+
+    bool open();
+    // Frames must be added in time order
+    void addFrame(const FrameConstPointer& frame);
+    // Writes any pending frames and closes the file, returns false if any write failed
+    bool finish();
+
+    QString getFilePath() const { return _file.fileName(); }
+    bool isOpen() const { return _open; }
+    // The number of frames left out of the clip because the disk couldn't keep up
+    size_t getNumDroppedFrames() const { return _numDroppedFrames; }
+
+    // The number of completed blocks waiting to be written above which the writer warns it is falling behind
+    static const size_t PENDING_BLOCKS_WARNING_THRESHOLD;
+    // The number of completed blocks waiting to be written at which further blocks are dropped
+    static const size_t MAX_PENDING_BLOCKS;
+
+private:
+    using Block = std::vector<FrameConstPointer>;
+
+    void queueCurrentBlock();
+    void run();
+
+    QFile _file;
+    std::thread _thread;
+    std::mutex _mutex;
+    std::condition_variable _condition;
+    std::deque<Block> _pendingBlocks;
+    Block _currentBlock;
+    int _currentBlockSize { 0 };
+    std::atomic<size_t> _numDroppedFrames { 0 };
+    bool _open { false };
+    bool _finishing { false };
+    bool _failed { false };
+    bool _fallingBehind { false };
+};
+
+}
+
+#endif
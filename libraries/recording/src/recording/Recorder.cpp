@@ -10,29 +10,76 @@
 
 #include <NumericalConstants.h>
 #include <SharedUtil.h>
+#include <UUID.h>
+
+#include <QtCore/QDir>
+#include <QtCore/QUuid>
 
 #include "impl/BufferClip.h"
+#include "impl/FileClip.h"
+#include "Clip.h"
+#include "ClipWriter.h"
 #include "Frame.h"
+#include "Logging.h"
 
 using namespace recording;
 
 Recorder::Recorder(QObject* parent) 
-    : QObject(parent) {}
+    : QObject(parent), _spoolDirectory(QDir::tempPath()) {}
+
+Recorder::~Recorder() {
+    Locker lock(_mutex);
+    if (_writer) {
+        _writer->finish();
+        _writer.reset();
+    }
+    removeSpoolFile();
+    _clip.reset();
+}
+
+void Recorder::setSpoolDirectory(const QString& directory) {
+    Locker lock(_mutex);
+    _spoolDirectory = directory;
+}
 
 float Recorder::position() {
     Locker lock(_mutex);
+    if (_writer) {
+        return Frame::frameTimeToSeconds(_lastFrameTime);
+    }
     if (_clip) {
         return _clip->duration();
     }
     return 0.0f;
 }
 
+void Recorder::removeSpoolFile() {
+    // Once recording stops the clip owns the spool file and removes it itself, so this only applies to an
+    // unfinished recording
+    if (!_spoolFile.isEmpty()) {
+        QFile::remove(_spoolFile);
+        _spoolFile.clear();
+    }
+}
+
 void Recorder::start() {
     Locker lock(_mutex);
     if (!_recording) {
         _recording = true;
+        removeSpoolFile();
+        _clip.reset();
+        _lastFrameTime = 0;
+
         // FIXME for now just record a new clip every time
-        _clip = std::make_shared<BufferClip>();
+        auto spoolFile = QDir(_spoolDirectory).filePath(QString("recording-%1.hfr").arg(uuidStringWithoutCurlyBraces(QUuid::createUuid())));
+        _writer = std::make_shared<ClipWriter>(spoolFile);
+        if (_writer->open()) {
+            _spoolFile = spoolFile;
+        } else {
+            qCWarning(recordingLog) << "Unable to stream recording to disk, recording to memory instead";
+            _writer.reset();
+            _clip = std::make_shared<BufferClip>();
+        }
         _startEpoch = usecTimestampNow();
         _timer.start();
         emit recordingStateChanged();
@@ -44,6 +91,23 @@ void Recorder::stop() {
     if (_recording) {
         _recording = false;
         _elapsed = _timer.elapsed();
+        if (_writer) {
+            if (!_writer->finish()) {
+                qCWarning(recordingLog) << "Recording to" << _spoolFile << "is incomplete";
+            }
+            _writer.reset();
+
+            // The clip removes the spool file once the last player lets go of it
+            auto spoolClip = std::make_shared<FileClip>(_spoolFile);
+            spoolClip->setRemoveFileOnClose(true);
+            _spoolFile.clear();
+            if (spoolClip->frameCount() > 0) {
+                _clip = spoolClip;
+            } else {
+                // Nothing was recorded
+                _clip = std::make_shared<BufferClip>();
+            }
+        }
         emit recordingStateChanged();
     }
 }
@@ -55,12 +119,17 @@ bool Recorder::isRecording() {
 
 void Recorder::clear() {
     Locker lock(_mutex);
+    if (_writer) {
+        _writer->finish();
+        _writer.reset();
+    }
+    removeSpoolFile();
     _clip.reset();
 }
 
 void Recorder::recordFrame(FrameType type, QByteArray frameData) {
     Locker lock(_mutex);
-    if (!_recording || !_clip) {
+    if (!_recording || (!_clip && !_writer)) {
         return;
     }
 
@@ -68,7 +137,12 @@ void Recorder::recordFrame(FrameType type, QByteArray frameData) {
     frame->type = type;
     frame->data = frameData;
     frame->timeOffset = (usecTimestampNow() - _startEpoch) / USECS_PER_MSEC;
-    _clip->addFrame(frame);
+    if (_writer) {
+        _writer->addFrame(frame);
+        _lastFrameTime = frame->timeOffset;
+    } else {
+        _clip->addFrame(frame);
+    }
 }
 
 ClipPointer Recorder::getClip() {
@@ -21,12 +21,19 @@
 
 namespace recording {
 
+class ClipWriter;
+
 // An interface for interacting with clips, creating them by recording or
 // playing them back.  Also serialization to and from files / network sources
+//
+// Recordings are streamed to a spool file as they are captured, so memory use stays
+// constant however long the session is.  If the spool file can't be created the
+// recorder falls back to collecting frames in memory.
 class Recorder : public QObject, public Dependency {
     Q_OBJECT
 public:
     Recorder(QObject* parent = nullptr);
+    ~Recorder();
 
     float position();
 
@@ -43,9 +50,12 @@ public:
 
     void recordFrame(FrameType type, QByteArray frameData);
 
-    // Return the currently recorded content
+    // Return the currently recorded content.  While streaming this is only available once recording stops.
     ClipPointer getClip();
 
+    // The directory streamed recordings are spooled to, defaults to the system temp directory
+    void setSpoolDirectory(const QString& directory);
+
 signals:
     void recordingStateChanged();
 
@@ -53,9 +63,15 @@ private:
     using Mutex = std::recursive_mutex;
     using Locker = std::unique_lock<Mutex>;
 
+    void removeSpoolFile();
+
     Mutex _mutex;
     QElapsedTimer _timer;
     ClipPointer _clip;
+    std::shared_ptr<ClipWriter> _writer;
+    QString _spoolDirectory;
+    QString _spoolFile;
+    quint64 _lastFrameTime { 0 };
     quint64 _elapsed { 0 };
     quint64 _startEpoch { 0 };
     bool _recording { false };
@@ -10,7 +10,9 @@
 
 #include <algorithm>
 
+#include <QtCore/QDateTime>
 #include <QtCore/QDebug>
+#include <QtCore/QFileInfo>
 
 #include <Finally.h>
 
@@ -38,6 +40,11 @@ QString FileClip::getName() const {
     return _file.fileName();
 }
 
+QByteArray FileClip::getSourceKey() const {
+    QFileInfo fileInfo(_file.fileName());
+    return (fileInfo.canonicalFilePath() + "|" + QString::number(fileInfo.lastModified().toMSecsSinceEpoch())).toUtf8();
+}
+
 
 
 bool FileClip::write(const QString& fileName, Clip::Pointer clip) {
@@ -57,11 +64,28 @@ bool FileClip::write(const QString& fileName, Clip::Pointer clip) {
     return clip->write(outputFile);
 }
 
+bool FileClip::copyTo(const QString& fileName) const {
+    if (frameCount() == 0) {
+        return false;
+    }
+    auto sourceName = _file.fileName();
+    if (QFileInfo(sourceName) == QFileInfo(fileName)) {
+        return true;
+    }
+    if (QFile::exists(fileName) && !QFile::remove(fileName)) {
+        return false;
+    }
+    return QFile::copy(sourceName, fileName);
+}
+
 FileClip::~FileClip() {
     Locker lock(_mutex);
     _file.unmap(_data);
     if (_file.isOpen()) {
         _file.close();
     }
+    if (_removeFileOnClose) {
+        _file.remove();
+    }
     reset();
 }
@@ -26,9 +26,17 @@ public:
     virtual QString getName() const override;
 
     static bool write(const QString& filePath, Clip::Pointer clip);
+    bool copyTo(const QString& filePath) const;
+
+    // Deletes the file when the clip is destroyed, for clips backed by a temporary file
+    void setRemoveFileOnClose(bool remove) { _removeFileOnClose = remove; }
+
+protected:
+    QByteArray getSourceKey() const override;
 
 private:
     QFile _file;
+    bool _removeFileOnClose { false };
 };
 
 }
@@ -9,13 +9,16 @@
 #include "PointerClip.h"
 
 #include <algorithm>
+#include <atomic>
 
+#include <QtCore/QCryptographicHash>
 #include <QtCore/QDebug>
 #include <QtCore/QJsonDocument>
 #include <QtCore/QJsonObject>
 
 #include <Finally.h>
 
+#include "../ClipCache.h"
 #include "../Frame.h"
 #include "../Logging.h"
 #include "BufferClip.h"
@@ -45,20 +48,25 @@ FrameTranslationMap parseTranslationMap(const QJsonDocument& doc) {
 }
 
 
-PointerFrameHeaderList parseFrameHeaders(uchar* const start, const size_t& size) {
+bool parseFrameHeader(uchar*& current, uchar* const end, PointerFrameHeader& header) {
+    if (end - current < PointerClip::MINIMUM_FRAME_SIZE) {
+        return false;
+    }
+    memcpy(&(header.type), current, sizeof(FrameType));
+    current += sizeof(FrameType);
+    memcpy(&(header.timeOffset), current, sizeof(Frame::Time));
+    current += sizeof(Frame::Time);
+    memcpy(&(header.size), current, sizeof(FrameSize));
+    current += sizeof(FrameSize);
+    return true;
+}
+
+PointerFrameHeaderList parseFrameHeaders(uchar* const start, uchar* current, uchar* const end) {
     PointerFrameHeaderList results;
-    auto current = start;
-    auto end = current + size;
     // Read all the frame headers
     // FIXME move to Frame::readHeader?
-    while (end - current >= PointerClip::MINIMUM_FRAME_SIZE) {
-        PointerFrameHeader header;
-        memcpy(&(header.type), current, sizeof(FrameType));
-        current += sizeof(FrameType);
-        memcpy(&(header.timeOffset), current, sizeof(Frame::Time));
-        current += sizeof(Frame::Time);
-        memcpy(&(header.size), current, sizeof(FrameSize));
-        current += sizeof(FrameSize);
+    PointerFrameHeader header;
+    while (parseFrameHeader(current, end, header)) {
         header.fileOffset = current - start;
         if (end - current < header.size) {
             break;
@@ -74,10 +82,58 @@ PointerFrameHeaderList parseFrameHeaders(uchar* const start, const size_t& size)
     return results;
 }
 
+// Reads the block headers and their frame index without touching the compressed payloads
+PointerFrameHeaderList parseBlockHeaders(uchar* const start, uchar* current, uchar* const end, std::vector<PointerBlockHeader>& blocks) {
+    PointerFrameHeaderList results;
+    while ((size_t)(end - current) >= sizeof(ClipBlockHeader)) {
+        ClipBlockHeader blockHeader;
+        memcpy(&blockHeader, current, sizeof(ClipBlockHeader));
+        current += sizeof(ClipBlockHeader);
+
+        auto indexSize = (quint64)blockHeader.frameCount * PointerClip::MINIMUM_FRAME_SIZE;
+        if ((quint64)(end - current) < indexSize + blockHeader.compressedSize) {
+            qCWarning(recordingLog) << "Truncated frame block, ignoring the remainder of the clip";
+            break;
+        }
+
+        PointerBlockHeader block;
+        uint32_t blockIndex = (uint32_t)blocks.size();
+        quint64 blockOffset = 0;
+        PointerFrameHeader header;
+        for (uint32_t i = 0; i < blockHeader.frameCount; ++i) {
+            parseFrameHeader(current, end, header);
+            header.fileOffset = blockOffset;
+            header.blockIndex = blockIndex;
+            blockOffset += header.size;
+            results.push_back(header);
+        }
+        if (blockOffset != blockHeader.uncompressedSize) {
+            qCWarning(recordingLog) << "Frame block index does not match its payload size, ignoring the remainder of the clip";
+            while (!results.empty() && results.back().blockIndex == blockIndex) {
+                results.pop_back();
+            }
+            break;
+        }
+
+        block.fileOffset = current - start;
+        block.compressedSize = blockHeader.compressedSize;
+        block.uncompressedSize = blockHeader.uncompressedSize;
+        blocks.push_back(block);
+        current += blockHeader.compressedSize;
+    }
+    qDebug(recordingLog) << "Parsed source data into " << results.size() << " frames in " << blocks.size() << " blocks";
+    return results;
+}
+
 void PointerClip::reset() {
     _frames.clear();
+    _blocks.clear();
+    _currentBlock.reset();
+    _currentBlockIndex = 0;
     _data = nullptr;
     _size = 0;
+    _contentKey.clear();
+    _blockCompressed = false;
     _header = QJsonDocument();
 }
 
@@ -87,33 +143,39 @@ void PointerClip::init(uchar* data, size_t size) {
     _data = data;
     _size = size;
 
-    auto parsedFrameHeaders = parseFrameHeaders(data, size);
-    // Verify that at least one frame exists and that the first frame is a header
-    if (0 == parsedFrameHeaders.size()) {
-        qWarning() << "No frames found, invalid file";
-        reset();
-        return;
-    }
+    auto current = data;
+    auto end = data + size;
 
     // Grab the file header
     {
-        auto fileHeaderFrameHeader = *parsedFrameHeaders.begin();
-        parsedFrameHeaders.pop_front();
+        PointerFrameHeader fileHeaderFrameHeader;
+        if (!parseFrameHeader(current, end, fileHeaderFrameHeader) || (end - current) < fileHeaderFrameHeader.size) {
+            qWarning() << "No frames found, invalid file";
+            reset();
+            return;
+        }
         if (fileHeaderFrameHeader.type != Frame::TYPE_HEADER) {
             qWarning() << "Missing header frame, invalid file";
             reset();
             return;
         }
 
-        QByteArray fileHeaderData((char*)_data + fileHeaderFrameHeader.fileOffset, fileHeaderFrameHeader.size);
+        QByteArray fileHeaderData((char*)current, fileHeaderFrameHeader.size);
+        current += fileHeaderFrameHeader.size;
         _header = QJsonDocument::fromBinaryData(fileHeaderData);
     }
 
     // Check for compression
     {
-        _compressed = _header.object()[FRAME_COMREPSSION_FLAG].toBool();
+        _blockCompressed = _header.object()[FORMAT_VERSION].toInt(LEGACY_FORMAT_VERSION) >= BLOCK_FORMAT_VERSION;
+        _compressed = !_blockCompressed && _header.object()[FRAME_COMREPSSION_FLAG].toBool();
     }
 
+    std::vector<PointerBlockHeader> fileBlocks;
+    auto parsedFrameHeaders = _blockCompressed ?
+        parseBlockHeaders(data, current, end, fileBlocks) :
+        parseFrameHeaders(data, current, end);
+
     // Find the type enum translation map and fix up the frame headers
     {
         FrameTranslationMap translationMap = parseTranslationMap(_header);
@@ -130,26 +192,106 @@ void PointerClip::init(uchar* data, size_t size) {
                 continue;
             }
             frameHeader.type = translationMap[frameHeader.type];
+            if (!_blockCompressed) {
+                frameHeader.blockIndex = (uint32_t)(_frames.size() / FRAMES_PER_CACHE_BLOCK);
+            }
             _frames.push_back(frameHeader);
         }
     }
 
+    // Group the surviving frames by block so they can be decoded and cached together
+    {
+        if (!_blockCompressed) {
+            fileBlocks.resize((_frames.size() + FRAMES_PER_CACHE_BLOCK - 1) / FRAMES_PER_CACHE_BLOCK);
+        }
+        _blocks = std::move(fileBlocks);
+        for (uint32_t i = 0; i < (uint32_t)_frames.size(); ++i) {
+            auto& block = _blocks[_frames[i].blockIndex];
+            if (0 == block.frameCount) {
+                block.firstFrame = i;
+            }
+            ++block.frameCount;
+        }
+    }
+
+    _contentKey = computeContentKey();
+}
+
+QByteArray PointerClip::computeContentKey() const {
+    QByteArray sourceKey = getSourceKey();
+    if (sourceKey.isEmpty()) {
+        // Nothing to tell if another clip holds the same data, so never share
+        static std::atomic<uint64_t> nextPrivateKey { 0 };
+        return "private:" + QByteArray::number((qulonglong)++nextPrivateKey);
+    }
+
+    // The source, along with the size and the block index parsed from it, rather than a hash of all the data,
+    // which would read the whole clip just to open it.  Rewriting the source changes at least one of these.
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(sourceKey);
+    quint64 size = _size;
+    hash.addData((const char*)&size, sizeof(size));
+    for (const auto& block : _blocks) {
+        hash.addData((const char*)&block.fileOffset, sizeof(block.fileOffset));
+        hash.addData((const char*)&block.compressedSize, sizeof(block.compressedSize));
+        hash.addData((const char*)&block.uncompressedSize, sizeof(block.uncompressedSize));
+        hash.addData((const char*)&block.frameCount, sizeof(block.frameCount));
+    }
+    return hash.result();
+}
+
+// Internal only function, needs no locking
+DecodedFrameBlockPointer PointerClip::decodeBlock(uint32_t blockIndex) const {
+    auto result = std::make_shared<DecodedFrameBlock>();
+    const auto& block = _blocks[blockIndex];
+    result->reserve(block.frameCount);
+
+    QByteArray blockData;
+    if (_blockCompressed && block.compressedSize) {
+        blockData = qUncompress(_data + block.fileOffset, (int)block.compressedSize);
+        if ((uint32_t)blockData.size() != block.uncompressedSize) {
+            qCWarning(recordingLog) << "Frame block" << blockIndex << "failed to decompress";
+            blockData.clear();
+        }
+    }
+
+    for (uint32_t i = 0; i < block.frameCount; ++i) {
+        const auto& header = _frames[block.firstFrame + i];
+        auto frame = std::make_shared<Frame>();
+        frame->type = header.type;
+        frame->timeOffset = header.timeOffset;
+        if (header.size) {
+            if (_blockCompressed) {
+                if (header.fileOffset + header.size <= (quint64)blockData.size()) {
+                    frame->data = blockData.mid((int)header.fileOffset, header.size);
+                }
+            } else {
+                frame->data.insert(0, reinterpret_cast<char*>(_data) + header.fileOffset, header.size);
+                if (_compressed) {
+                    frame->data = qUncompress(frame->data);
+                }
+            }
+        }
+        result->push_back(frame);
+    }
+    return result;
 }
 
 // Internal only function, needs no locking
 FrameConstPointer PointerClip::readFrame(size_t frameIndex) const {
-    FramePointer result;
+    FrameConstPointer result;
     if (frameIndex < _frames.size()) {
-        result = std::make_shared<Frame>();
-        const auto& header = _frames[frameIndex];
-        result->type = header.type;
-        result->timeOffset = header.timeOffset;
-        if (header.size) {
-            result->data.insert(0, reinterpret_cast<char*>(_data)+header.fileOffset, header.size);
-            if (_compressed) {
-                result->data = qUncompress(result->data);
+        auto blockIndex = _frames[frameIndex].blockIndex;
+        if (!_currentBlock || _currentBlockIndex != blockIndex) {
+            auto& cache = DecodedFrameCache::instance();
+            auto block = cache.find(_contentKey, blockIndex);
+            if (!block) {
+                block = cache.insert(_contentKey, blockIndex, decodeBlock(blockIndex));
             }
+            _currentBlock = block;
+            _currentBlockIndex = blockIndex;
         }
+        result = (*_currentBlock)[frameIndex - _blocks[blockIndex].firstFrame];
     }
     return result;
 }
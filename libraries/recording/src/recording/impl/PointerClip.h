@@ -13,6 +13,7 @@
 #include "ArrayClip.h"
 
 #include <mutex>
+#include <vector>
 
 #include <QtCore/QJsonDocument>
 
@@ -20,15 +21,38 @@
 
 namespace recording {
 
+using DecodedFrameBlock = std::vector<FrameConstPointer>;
+using DecodedFrameBlockPointer = std::shared_ptr<const DecodedFrameBlock>;
+
 struct PointerFrameHeader : public FrameHeader {
     FrameType type;
     Frame::Time timeOffset;
     uint16_t size;
+    // Offset from the start of the file, or from the start of the decompressed block for block compressed clips
     quint64 fileOffset;
+    uint32_t blockIndex { 0 };
 };
 
 using PointerFrameHeaderList = std::list<PointerFrameHeader>;
 
+// On-disk header preceding each group of frames in a block compressed clip.  It is followed by
+// frameCount (type, time, size) records, which act as the seek index, and then by the
+// compressed concatenation of the frame payloads.
+struct ClipBlockHeader {
+    uint32_t frameCount;
+    uint32_t uncompressedSize;
+    uint32_t compressedSize;
+};
+
+struct PointerBlockHeader {
+    quint64 fileOffset { 0 };
+    uint32_t compressedSize { 0 };
+    uint32_t uncompressedSize { 0 };
+    // The range of entries in _frames belonging to this block
+    uint32_t firstFrame { 0 };
+    uint32_t frameCount { 0 };
+};
+
 class PointerClip : public ArrayClip<PointerFrameHeader> {
 public:
     using Pointer = std::shared_ptr<PointerClip>;
@@ -44,13 +68,28 @@ public:
 
     // FIXME move to frame?
     static const qint64 MINIMUM_FRAME_SIZE = sizeof(FrameType) + sizeof(Frame::Time) + sizeof(FrameSize);
+    // Clips without block compression are still cached in groups of this many frames
+    static const uint32_t FRAMES_PER_CACHE_BLOCK = 64;
+
 protected:
     void reset() override;
     virtual FrameConstPointer readFrame(size_t index) const override;
+    DecodedFrameBlockPointer decodeBlock(uint32_t blockIndex) const;
+    // Identifies where the data came from, such as a file or URL, so clips loaded from the same source share their
+    // decoded blocks.  Empty, the default, keeps the clip's blocks to itself
+    virtual QByteArray getSourceKey() const { return QByteArray(); }
+    QByteArray computeContentKey() const;
+
     QJsonDocument _header;
     uchar* _data { nullptr };
     size_t _size { 0 };
     bool _compressed { true };
+    bool _blockCompressed { false };
+    std::vector<PointerBlockHeader> _blocks;
+    QByteArray _contentKey;
+    // The last block this clip decoded, held so sequential playback doesn't go through the shared cache per frame
+    mutable DecodedFrameBlockPointer _currentBlock;
+    mutable uint32_t _currentBlockIndex { 0 };
 };
 
 }
@@ -13,7 +13,6 @@
 
 #include <QMetaType>
 #include <QRunnable>
-#include <QThreadPool>
 
 #include <glm/gtx/transform.hpp>
 #include <glm/gtx/norm.hpp>
@@ -24,6 +23,7 @@
 #include <PerfStat.h>
 #include <ViewFrustum.h>
 #include <GLMHelpers.h>
+#include <JobScheduler.h>
 #include <TBBHelpers.h>
 
 #include <model-networking/SimpleMeshProxy.h>
@@ -1741,87 +1741,79 @@ static auto& packBlendshapeOffsets = packBlendshapeOffsets_ref;
 
 class Blender : public QRunnable {
 public:
+    struct Blend {
+        ModelPointer model;
+        Geometry::BlendshapesPointer blendshapes;
+        QVector<float> coefficients;
+        int blendNumber;
+    };
 
-    Blender(ModelPointer model, HFMModel::ConstPointer hfmModel, int blendNumber, const QVector<float>& blendshapeCoefficients);
+    Blender(std::vector<Blend>&& blends);
 
     virtual void run() override;
 
 private:
-    ModelPointer _model;
-    HFMModel::ConstPointer _hfmModel;
-    int _blendNumber;
-    QVector<float> _blendshapeCoefficients;
+    void blendModel(const Blend& blend);
+
+    std::vector<Blend> _blends;
+    std::vector<BlendshapeOffsetUnpacked> _unpackedBlendshapeOffsets;   // reused for all meshes
 };
 
-Blender::Blender(ModelPointer model, HFMModel::ConstPointer hfmModel, int blendNumber, const QVector<float>& blendshapeCoefficients) :
-    _model(model),
-    _hfmModel(hfmModel),
-    _blendNumber(blendNumber),
-    _blendshapeCoefficients(blendshapeCoefficients) {
+Blender::Blender(std::vector<Blend>&& blends) :
+    _blends(std::move(blends)) {
 }
 
 void Blender::run() {
-    DETAILED_PROFILE_RANGE_EX(simulation_animation, __FUNCTION__, 0xFFFF0000, 0, { { "url", _model->getURL().toString() } });
+    for (const auto& blend : _blends) {
+        blendModel(blend);
+    }
+
+    // after the results, since queued calls from one thread are delivered in order
+    QMetaObject::invokeMethod(DependencyManager::get<ModelBlender>().data(), "blenderFinished");
+}
+
+void Blender::blendModel(const Blend& blend) {
+    DETAILED_PROFILE_RANGE_EX(simulation_animation, __FUNCTION__, 0xFFFF0000, 0, { { "url", blend.model->getURL().toString() } });
     int numBlendshapeOffsets = 0;  // number of offsets required for all meshes.
     int maxBlendshapeOffsets = 0;  // number of offsets in the largest mesh.
-    int numMeshes = 0;  // number of meshes in this model.
-    for (auto meshIter = _hfmModel->meshes.cbegin(); meshIter != _hfmModel->meshes.cend(); ++meshIter) {
-        numMeshes++;
-        if (meshIter->blendshapes.isEmpty()) {
+    for (const auto& mesh : *blend.blendshapes) {
+        if (mesh.getNumBlendshapes() == 0) {
             continue;
         }
-        int numVertsInMesh = meshIter->vertices.size();
-        numBlendshapeOffsets += numVertsInMesh;
-        maxBlendshapeOffsets = std::max(maxBlendshapeOffsets, numVertsInMesh);
+        numBlendshapeOffsets += mesh.getNumVertices();
+        maxBlendshapeOffsets = std::max(maxBlendshapeOffsets, mesh.getNumVertices());
     }
 
     // allocate the required sizes
     QVector<int> blendedMeshSizes;
-    blendedMeshSizes.reserve(numMeshes);
+    blendedMeshSizes.reserve((int)blend.blendshapes->size());
 
     QVector<BlendshapeOffset> packedBlendshapeOffsets;
     packedBlendshapeOffsets.resize(numBlendshapeOffsets);
 
-    QVector<BlendshapeOffsetUnpacked> unpackedBlendshapeOffsets;
-    unpackedBlendshapeOffsets.resize(maxBlendshapeOffsets);    // reuse for all meshes
+    if ((int)_unpackedBlendshapeOffsets.size() < maxBlendshapeOffsets) {
+        _unpackedBlendshapeOffsets.resize(maxBlendshapeOffsets);
+    }
+
+    static_assert(sizeof(BlendshapeOffsetUnpacked) == BlendshapeDeltas::DELTA_SIZE * sizeof(float),
+                  "struct BlendshapeOffsetUnpacked size doesn't match.");
+    auto unpacked = _unpackedBlendshapeOffsets.data();
 
     int offset = 0;
-    for (auto meshIter = _hfmModel->meshes.cbegin(); meshIter != _hfmModel->meshes.cend(); ++meshIter) {
-        if (meshIter->blendshapes.isEmpty()) {
+    for (const auto& mesh : *blend.blendshapes) {
+        if (mesh.getNumBlendshapes() == 0) {
             blendedMeshSizes.push_back(0);
             continue;
         }
-        int numVertsInMesh = meshIter->vertices.size();
+        int numVertsInMesh = mesh.getNumVertices();
         blendedMeshSizes.push_back(numVertsInMesh);
 
-        // initialize offsets to zero
-        memset(unpackedBlendshapeOffsets.data(), 0, numVertsInMesh * sizeof(BlendshapeOffsetUnpacked));
-
-        // for each blendshape in this mesh, accumulate the offsets into unpackedBlendshapeOffsets.
-        const float NORMAL_COEFFICIENT_SCALE = 0.01f;
-        for (int i = 0, n = qMin(_blendshapeCoefficients.size(), meshIter->blendshapes.size()); i < n; i++) {
-            float vertexCoefficient = _blendshapeCoefficients.at(i);
-            const float EPSILON = 0.0001f;
-            if (vertexCoefficient < EPSILON) {
-                continue;
-            }
-
-            float normalCoefficient = vertexCoefficient * NORMAL_COEFFICIENT_SCALE;
-            const HFMBlendshape& blendshape = meshIter->blendshapes.at(i);
-            for (int j = 0; j < blendshape.indices.size(); ++j) {
-                int index = blendshape.indices.at(j);
-
-                auto& currentBlendshapeOffset = unpackedBlendshapeOffsets[index];
-                currentBlendshapeOffset.positionOffset += blendshape.vertices.at(j) * vertexCoefficient;
-                currentBlendshapeOffset.normalOffset += blendshape.normals.at(j) * normalCoefficient;
-                if (j < blendshape.tangents.size()) {
-                    currentBlendshapeOffset.tangentOffset += blendshape.tangents.at(j) * normalCoefficient;
-                }
-            }
-        }
+        // accumulate the deltas of the active blendshapes into unpackedBlendshapeOffsets
+        const float EPSILON = 0.0001f;
+        mesh.blend(blend.coefficients.constData(), blend.coefficients.size(), EPSILON,
+                   reinterpret_cast<float(*)[BlendshapeDeltas::DELTA_SIZE]>(unpacked));
 
         // convert unpackedBlendshapeOffsets into packedBlendshapeOffsets for the gpu.
-        auto unpacked = unpackedBlendshapeOffsets.data();
         auto packed = packedBlendshapeOffsets.data() + offset;
         packBlendshapeOffsets(unpacked, packed, numVertsInMesh);
 
@@ -1831,22 +1823,28 @@ void Blender::run() {
 
     // post the result to the ModelBlender, which will dispatch to the model if still alive
     QMetaObject::invokeMethod(DependencyManager::get<ModelBlender>().data(), "setBlendedVertices",
-                              Q_ARG(ModelPointer, _model), Q_ARG(int, _blendNumber),
+                              Q_ARG(ModelPointer, blend.model), Q_ARG(int, blend.blendNumber),
                               Q_ARG(QVector<BlendshapeOffset>, packedBlendshapeOffsets),
                               Q_ARG(QVector<int>, blendedMeshSizes));
 }
 
-bool Model::maybeStartBlender() {
-    if (isLoaded()) {
-        QThreadPool::globalInstance()->start(new Blender(getThisPointer(), getGeometry()->getConstHFMModelPointer(),
-                                                         ++_blendNumber, _blendshapeCoefficients));
+bool Model::prepareBlend(Geometry::BlendshapesPointer& blendshapes, QVector<float>& coefficients, int& blendNumber) {
+    if (isLoaded() && _renderGeometry->getBlendshapes()) {
+        blendshapes = _renderGeometry->getBlendshapes();
+        coefficients = _blendshapeCoefficients;
+        blendNumber = ++_blendNumber;
         return true;
     }
     return false;
 }
 
+// blending gets a fixed share of the job scheduler's threads, and runs the models that queue up meanwhile in batches
+static const int BLENDER_THREADS = 2;
+static const size_t MAX_BLEND_BATCH_SIZE = 16;
+
 ModelBlender::ModelBlender() :
     _pendingBlenders(0) {
+    JobScheduler::getInstance().setConcurrencyLimit(JobScheduler::BLENDSHAPE, BLENDER_THREADS);
 }
 
 ModelBlender::~ModelBlender() {
@@ -1858,18 +1856,27 @@ void ModelBlender::noteRequiresBlend(ModelPointer model) {
         _modelsRequiringBlendsQueue.push(model);
         _modelsRequiringBlendsSet.insert(model);
     }
+    startBlenders();
+}
 
-    if (_pendingBlenders < QThread::idealThreadCount()) {
-        while (!_modelsRequiringBlendsQueue.empty()) {
+void ModelBlender::startBlenders() {
+    while (_pendingBlenders < BLENDER_THREADS && !_modelsRequiringBlendsQueue.empty()) {
+        std::vector<Blender::Blend> blends;
+        while (blends.size() < MAX_BLEND_BATCH_SIZE && !_modelsRequiringBlendsQueue.empty()) {
             auto weakPtr = _modelsRequiringBlendsQueue.front();
             _modelsRequiringBlendsQueue.pop();
             _modelsRequiringBlendsSet.erase(weakPtr);
-            ModelPointer nextModel = weakPtr.lock();
-            if (nextModel && nextModel->maybeStartBlender()) {
-                _pendingBlenders++;
-                return;
+
+            Blender::Blend blend;
+            blend.model = weakPtr.lock();
+            if (blend.model && blend.model->prepareBlend(blend.blendshapes, blend.coefficients, blend.blendNumber)) {
+                blends.push_back(std::move(blend));
             }
         }
+        if (!blends.empty()) {
+            JobScheduler::getInstance().submit(JobScheduler::BLENDSHAPE, new Blender(std::move(blends)));
+            _pendingBlenders++;
+        }
     }
 }
 
@@ -1880,19 +1887,10 @@ void ModelBlender::setBlendedVertices(ModelPointer model, int blendNumber, QVect
             blendshapeOperator(blendNumber, blendshapeOffsets, blendedMeshSizes, model->fetchRenderItemIDs());
         }
     }
+}
 
-    {
-        Lock lock(_mutex);
-        _pendingBlenders--;
-        while (!_modelsRequiringBlendsQueue.empty()) {
-            auto weakPtr = _modelsRequiringBlendsQueue.front();
-            _modelsRequiringBlendsQueue.pop();
-            _modelsRequiringBlendsSet.erase(weakPtr);
-            ModelPointer nextModel = weakPtr.lock();
-            if (nextModel && nextModel->maybeStartBlender()) {
-                _pendingBlenders++;
-                break;
-            }
-        }
-    }
+void ModelBlender::blenderFinished() {
+    Lock lock(_mutex);
+    _pendingBlenders--;
+    startBlenders();
 }
@@ -161,7 +161,8 @@ public:
     AABox getRenderableMeshBound() const;
     const render::ItemIDs& fetchRenderItemIDs() const;
 
-    bool maybeStartBlender();
+    // the packed blendshapes and coefficients of the next blend, numbered so that stale results can be told apart
+    bool prepareBlend(Geometry::BlendshapesPointer& blendshapes, QVector<float>& coefficients, int& blendNumber);
 
     bool isLoaded() const { return (bool)_renderGeometry && _renderGeometry->isHFMModelLoaded(); }
     bool isAddedToScene() const { return _addedToScene; }
@@ -534,6 +535,9 @@ public slots:
     void setBlendedVertices(ModelPointer model, int blendNumber, QVector<BlendshapeOffset> blendshapeOffsets, QVector<int> blendedMeshSizes);
     void setComputeBlendshapes(bool computeBlendshapes) { _computeBlendshapes = computeBlendshapes; }
 
+private slots:
+    void blenderFinished();
+
 private:
     using Mutex = std::mutex;
     using Lock = std::unique_lock<Mutex>;
@@ -541,6 +545,9 @@ private:
     ModelBlender();
     virtual ~ModelBlender();
 
+    // start blenders on batches of the queued models, up to the worker budget. call with _mutex held.
+    void startBlenders();
+
     std::queue<ModelWeakPointer> _modelsRequiringBlendsQueue;
     std::set<ModelWeakPointer, std::owner_less<ModelWeakPointer>> _modelsRequiringBlendsSet;
     int _pendingBlenders;
@@ -37,8 +37,9 @@ void DeferredForwardSwitchJob::build(JobModel& task, const render::Varying& inpu
     task.addBranch<RenderForwardTask>("RenderForwardTask", 1, input);
 }
 
-void RenderViewTask::build(JobModel& task, const render::Varying& input, render::Varying& output, render::CullFunctor cullFunctor, uint8_t tagBits, uint8_t tagMask) {
-    const auto items = task.addJob<RenderFetchCullSortTask>("FetchCullSort", cullFunctor, tagBits, tagMask);
+void RenderViewTask::build(JobModel& task, const render::Varying& input, render::Varying& output, render::CullFunctor cullFunctor, uint8_t tagBits, uint8_t tagMask,
+                           bool parallelCull) {
+    const auto items = task.addJob<RenderFetchCullSortTask>("FetchCullSort", cullFunctor, tagBits, tagMask, parallelCull);
 
     // Issue the lighting model, aka the big global settings for the view 
     const auto lightingModel = task.addJob<MakeLightingModel>("LightingModel");
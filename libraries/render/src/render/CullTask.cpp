@@ -16,6 +16,12 @@
 
 #include <PerfStat.h>
 #include <OctreeUtils.h>
+#include <TBBHelpers.h>
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+#include <xmmintrin.h>
+#define CULL_SSE
+#endif
 
 using namespace render;
 
@@ -352,6 +358,185 @@ void CullSpatialSelection::run(const RenderContextPointer& renderContext,
     std::static_pointer_cast<Config>(renderContext->jobConfig)->numItems = (int)outItems.size();
 }
 
+void render::boxesIntersectFrustum(const ViewFrustum& frustum, const ItemBound* items, size_t numItems, uint8_t* inView) {
+    size_t i = 0;
+
+#ifdef CULL_SSE
+    const ::Plane* planes = frustum.getPlanes();
+    const __m128 zero = _mm_setzero_ps();
+
+    for (; i + 3 < numItems; i += 4) {
+        const AABox& b0 = items[i + 0].bound;
+        const AABox& b1 = items[i + 1].bound;
+        const AABox& b2 = items[i + 2].bound;
+        const AABox& b3 = items[i + 3].bound;
+
+        // transpose the four boxes
+        __m128 cx = _mm_setr_ps(b0.getCorner().x, b1.getCorner().x, b2.getCorner().x, b3.getCorner().x);
+        __m128 cy = _mm_setr_ps(b0.getCorner().y, b1.getCorner().y, b2.getCorner().y, b3.getCorner().y);
+        __m128 cz = _mm_setr_ps(b0.getCorner().z, b1.getCorner().z, b2.getCorner().z, b3.getCorner().z);
+        __m128 sx = _mm_setr_ps(b0.getScale().x, b1.getScale().x, b2.getScale().x, b3.getScale().x);
+        __m128 sy = _mm_setr_ps(b0.getScale().y, b1.getScale().y, b2.getScale().y, b3.getScale().y);
+        __m128 sz = _mm_setr_ps(b0.getScale().z, b1.getScale().z, b2.getScale().z, b3.getScale().z);
+
+        __m128 outside = zero;
+        for (int p = 0; p < NUM_FRUSTUM_PLANES; p++) {
+            const glm::vec3& normal = planes[p].getNormal();
+
+            // distance to the farthest box point along the plane normal
+            __m128 fx = (normal.x > 0.0f) ? _mm_add_ps(cx, sx) : cx;
+            __m128 fy = (normal.y > 0.0f) ? _mm_add_ps(cy, sy) : cy;
+            __m128 fz = (normal.z > 0.0f) ? _mm_add_ps(cz, sz) : cz;
+            __m128 dot = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(normal.x), fx), _mm_mul_ps(_mm_set1_ps(normal.y), fy)),
+                                    _mm_mul_ps(_mm_set1_ps(normal.z), fz));
+            __m128 distance = _mm_add_ps(_mm_set1_ps(planes[p].getDCoefficient()), dot);
+            outside = _mm_or_ps(outside, _mm_cmplt_ps(distance, zero));
+        }
+
+        int mask = _mm_movemask_ps(outside);
+        inView[i + 0] = !(mask & 1);
+        inView[i + 1] = !(mask & 2);
+        inView[i + 2] = !(mask & 4);
+        inView[i + 3] = !(mask & 8);
+    }
+#endif
+
+    for (; i < numItems; i++) {
+        inView[i] = frustum.boxIntersectsFrustum(items[i].bound);
+    }
+}
+
+void ParallelCullSpatialSelection::configure(const Config& config) {
+    _justFrozeFrustum = _justFrozeFrustum || (config.freezeFrustum && !_freezeFrustum);
+    _freezeFrustum = config.freezeFrustum;
+    _skipCulling = config.skipCulling;
+}
+
+void ParallelCullSpatialSelection::cullChunk(const RenderContextPointer& renderContext, const ItemFilter& filter, Chunk& chunk) {
+    RenderArgs* args = renderContext->args;
+    auto& scene = renderContext->_scene;
+
+    chunk.candidates.clear();
+    chunk.items.clear();
+    chunk.outOfView = 0;
+    chunk.tooSmall = 0;
+
+    // filter
+    for (size_t i = 0; i < chunk.numIDs; i++) {
+        auto id = chunk.ids[i];
+        auto& item = scene->getItem(id);
+        if (filter.test(item.getKey())) {
+            chunk.candidates.emplace_back(id, item.getBound());
+        }
+    }
+
+    // frustum cull in batches
+    size_t numCandidates = chunk.candidates.size();
+    chunk.inView.resize(numCandidates);
+    if (chunk.frustumCull) {
+        boxesIntersectFrustum(args->getViewFrustum(), chunk.candidates.data(), numCandidates, chunk.inView.data());
+    } else {
+        std::fill(chunk.inView.begin(), chunk.inView.end(), (uint8_t)1);
+    }
+
+    // distance cull, and expand the meta cull groups
+    for (size_t i = 0; i < numCandidates; i++) {
+        const auto& itemBound = chunk.candidates[i];
+        if (!chunk.inView[i]) {
+            chunk.outOfView++;
+            continue;
+        }
+        if (chunk.solidAngleCull && !_cullFunctor(args, itemBound.bound)) {
+            chunk.tooSmall++;
+            continue;
+        }
+        chunk.items.emplace_back(itemBound);
+        auto& item = scene->getItem(itemBound.id);
+        if (item.getKey().isMetaCullGroup()) {
+            item.fetchMetaSubItemBounds(chunk.items, (*scene));
+        }
+    }
+}
+
+void ParallelCullSpatialSelection::run(const RenderContextPointer& renderContext,
+                                       const Inputs& inputs, ItemBounds& outItems) {
+    assert(renderContext->args);
+    assert(renderContext->args->hasViewFrustum());
+    RenderArgs* args = renderContext->args;
+    auto& inSelection = inputs.get0();
+
+    auto& details = args->_details.edit(_detailType);
+    details._considered += (int)inSelection.numItems();
+
+    // Eventually use a frozen frustum
+    if (_freezeFrustum) {
+        if (_justFrozeFrustum) {
+            _justFrozeFrustum = false;
+            _frozenFrustum = args->getViewFrustum();
+        }
+        args->pushViewFrustum(_frozenFrustum); // replace the true view frustum by the frozen one
+    }
+
+    outItems.clear();
+
+    const auto srcFilter = inputs.get1();
+    if (!srcFilter.selectsNothing()) {
+        auto filter = render::ItemFilter::Builder(srcFilter).withoutSubMetaCulled().build();
+
+        // Split the selection into chunks, in the same order as the serial job:
+        // inside & fit items are only filtered, subcell items are distance culled
+        // and partial items are frustum culled
+        size_t numChunks = 0;
+        auto addChunks = [&](const ItemIDs& ids, bool frustumCull, bool solidAngleCull) {
+            for (size_t offset = 0; offset < ids.size(); offset += CHUNK_SIZE) {
+                if (numChunks == _chunks.size()) {
+                    _chunks.emplace_back();
+                }
+                auto& chunk = _chunks[numChunks++];
+                chunk.ids = ids.data() + offset;
+                chunk.numIDs = (ids.size() - offset < CHUNK_SIZE) ? (ids.size() - offset) : CHUNK_SIZE;
+                chunk.frustumCull = frustumCull && !_skipCulling;
+                chunk.solidAngleCull = solidAngleCull && !_skipCulling;
+            }
+        };
+        addChunks(inSelection.insideItems, false, false);
+        addChunks(inSelection.insideSubcellItems, false, true);
+        addChunks(inSelection.partialItems, true, false);
+        addChunks(inSelection.partialSubcellItems, true, true);
+
+        {
+            PerformanceTimer perfTimer("cullChunks");
+            tbb::parallel_for(tbb::blocked_range<size_t>(0, numChunks), [&](const tbb::blocked_range<size_t>& range) {
+                for (size_t i = range.begin(); i < range.end(); i++) {
+                    cullChunk(renderContext, filter, _chunks[i]);
+                }
+            });
+        }
+
+        // Gather the chunks in order
+        size_t numItems = 0;
+        for (size_t i = 0; i < numChunks; i++) {
+            numItems += _chunks[i].items.size();
+        }
+        outItems.reserve(numItems);
+        for (size_t i = 0; i < numChunks; i++) {
+            auto& chunk = _chunks[i];
+            outItems.insert(outItems.end(), chunk.items.begin(), chunk.items.end());
+            details._outOfView += chunk.outOfView;
+            details._tooSmall += chunk.tooSmall;
+        }
+    }
+
+    details._rendered += (int)outItems.size();
+
+    // Restore frustum if using the frozen one:
+    if (_freezeFrustum) {
+        args->popViewFrustum();
+    }
+
+    std::static_pointer_cast<Config>(renderContext->jobConfig)->numItems = (int)outItems.size();
+}
+
 void CullShapeBounds::run(const RenderContextPointer& renderContext, const Inputs& inputs, Outputs& outputs) {
     assert(renderContext->args);
     assert(renderContext->args->hasViewFrustum());
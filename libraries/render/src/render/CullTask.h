@@ -17,6 +17,8 @@
 
 namespace render {
 
+    // Returns true if a bound is big enough to render. ParallelCullSpatialSelection calls it from several threads at
+    // once, so it must only read the args and the bound, as LODManager::shouldRender does.
     using CullFunctor = std::function<bool(const RenderArgs*, const AABox&)>;
 
     void cullItems(const RenderContextPointer& renderContext, const CullFunctor& cullFunctor, RenderDetails::Item& details,
@@ -124,6 +126,59 @@ namespace render {
         void run(const RenderContextPointer& renderContext, const Inputs& inputs, ItemBounds& outItems);
     };
 
+    // Same inputs, outputs and config as CullSpatialSelection, but the selection is split into chunks
+    // that are filtered and culled in parallel, testing frustum planes against four boxes at a time.
+    // The chunk buffers are kept from frame to frame so the steady state does not allocate.
+    // The chunks run on TBB workers while the render thread waits, so the scene is not changing underneath them: each
+    // item is only looked at by the one chunk that selected it, and Item::fetchMetaSubItemBounds only reads the payload's
+    // sub item IDs and the scene's item bounds. Payloads' metaFetchMetaSubItems must likewise only read.
+    class ParallelCullSpatialSelection {
+        bool _freezeFrustum{ false }; // initialized by Config
+        bool _justFrozeFrustum{ false };
+        bool _skipCulling{ false };
+        ViewFrustum _frozenFrustum;
+
+        struct Chunk {
+            const ItemID* ids{ nullptr };
+            size_t numIDs{ 0 };
+            bool frustumCull{ false };
+            bool solidAngleCull{ false };
+
+            ItemBounds candidates;
+            std::vector<uint8_t> inView;
+            ItemBounds items;
+            int outOfView{ 0 };
+            int tooSmall{ 0 };
+        };
+        std::vector<Chunk> _chunks;
+
+        void cullChunk(const RenderContextPointer& renderContext, const ItemFilter& filter, Chunk& chunk);
+
+    public:
+        using Config = CullSpatialSelectionConfig;
+        using Inputs = CullSpatialSelection::Inputs;
+        using JobModel = Job::ModelIO<ParallelCullSpatialSelection, Inputs, ItemBounds, Config>;
+
+        static const size_t CHUNK_SIZE = 1024;
+
+        ParallelCullSpatialSelection(CullFunctor cullFunctor, RenderDetails::Type type) :
+            _cullFunctor{ cullFunctor },
+            _detailType(type) {}
+
+        ParallelCullSpatialSelection(CullFunctor cullFunctor) :
+            _cullFunctor{ cullFunctor } {
+        }
+
+        CullFunctor _cullFunctor;
+        RenderDetails::Type _detailType{ RenderDetails::OTHER };
+
+        void configure(const Config& config);
+        void run(const RenderContextPointer& renderContext, const Inputs& inputs, ItemBounds& outItems);
+    };
+
+    // Frustum test of many boxes, equivalent to ViewFrustum::boxIntersectsFrustum on each one
+    void boxesIntersectFrustum(const ViewFrustum& frustum, const ItemBound* items, size_t numItems, uint8_t* inView);
+
     class CullShapeBounds {
     public:
         using Inputs = render::VaryingSet4<ShapeBounds, ItemFilter, ItemFilter, ViewFrustumPointer>;
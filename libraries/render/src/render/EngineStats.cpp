@@ -64,5 +64,7 @@ void EngineStats::run(const RenderContextPointer& renderContext) {
     config->frameSetPipelineCount = _gpuStats._PSNumSetPipelines;
     config->frameSetInputFormatCount = _gpuStats._ISNumFormatChanges;
 
+    config->transactionBacklog = (quint32)renderContext->_scene->getTransactionBacklog();
+
     // These new stat values are notified with the "newStats" signal triggered by the timer
 }
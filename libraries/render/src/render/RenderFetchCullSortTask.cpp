@@ -17,7 +17,15 @@
 
 using namespace render;
 
-void RenderFetchCullSortTask::build(JobModel& task, const Varying& input, Varying& output, CullFunctor cullFunctor, uint8_t tagBits, uint8_t tagMask) {
+static Varying addDepthSortJob(RenderFetchCullSortTask::JobModel& task, const std::string& name, const Varying& input, bool frontToBack, bool parallel) {
+    if (parallel) {
+        return task.addJob<RadixDepthSortItems>(name, input, RadixDepthSortItems(frontToBack));
+    }
+    return task.addJob<DepthSortItems>(name, input, DepthSortItems(frontToBack));
+}
+
+void RenderFetchCullSortTask::build(JobModel& task, const Varying& input, Varying& output, CullFunctor cullFunctor, uint8_t tagBits, uint8_t tagMask,
+                                    bool parallel) {
     cullFunctor = cullFunctor ? cullFunctor : [](const RenderArgs*, const AABox&){ return true; };
 
     // CPU jobs:
@@ -27,7 +35,9 @@ void RenderFetchCullSortTask::build(JobModel& task, const Varying& input, Varyin
     const auto fetchInput = FetchSpatialTree::Inputs(filter, glm::ivec2(0,0)).asVarying();
     const auto spatialSelection = task.addJob<FetchSpatialTree>("FetchSceneSelection", fetchInput);
     const auto cullInputs = CullSpatialSelection::Inputs(spatialSelection, spatialFilter).asVarying();
-    const auto culledSpatialSelection = task.addJob<CullSpatialSelection>("CullSceneSelection", cullInputs, cullFunctor, RenderDetails::ITEM);
+    const auto culledSpatialSelection = parallel ?
+        task.addJob<ParallelCullSpatialSelection>("CullSceneSelection", cullInputs, cullFunctor, RenderDetails::ITEM) :
+        task.addJob<CullSpatialSelection>("CullSceneSelection", cullInputs, cullFunctor, RenderDetails::ITEM);
 
     // Layered objects are not culled
     const ItemFilter layeredFilter = ItemFilter::Builder::visibleWorldItems().withTagBits(tagBits, tagMask);
@@ -61,16 +71,16 @@ void RenderFetchCullSortTask::build(JobModel& task, const Varying& input, Varyin
             .get<MultiFilterItems<NUM_NON_SPATIAL_FILTERS>::ItemBoundsArray>();
 
     // Extract opaques / transparents / lights / layered
-    const auto opaques = task.addJob<DepthSortItems>("DepthSortOpaque", filteredSpatialBuckets[OPAQUE_SHAPE_BUCKET]);
-    const auto transparents = task.addJob<DepthSortItems>("DepthSortTransparent", filteredSpatialBuckets[TRANSPARENT_SHAPE_BUCKET], DepthSortItems(false));
+    const auto opaques = addDepthSortJob(task, "DepthSortOpaque", filteredSpatialBuckets[OPAQUE_SHAPE_BUCKET], true, parallel);
+    const auto transparents = addDepthSortJob(task, "DepthSortTransparent", filteredSpatialBuckets[TRANSPARENT_SHAPE_BUCKET], false, parallel);
     const auto lights = filteredSpatialBuckets[LIGHT_BUCKET];
     const auto metas = filteredSpatialBuckets[META_BUCKET];
 
     const auto background = filteredNonspatialBuckets[BACKGROUND_BUCKET];
 
     // split up the layered objects into 3D front, hud
-    const auto layeredOpaques = task.addJob<DepthSortItems>("DepthSortLayaredOpaque", filteredNonspatialBuckets[OPAQUE_SHAPE_BUCKET]);
-    const auto layeredTransparents = task.addJob<DepthSortItems>("DepthSortLayeredTransparent", filteredNonspatialBuckets[TRANSPARENT_SHAPE_BUCKET], DepthSortItems(false));
+    const auto layeredOpaques = addDepthSortJob(task, "DepthSortLayaredOpaque", filteredNonspatialBuckets[OPAQUE_SHAPE_BUCKET], true, parallel);
+    const auto layeredTransparents = addDepthSortJob(task, "DepthSortLayeredTransparent", filteredNonspatialBuckets[TRANSPARENT_SHAPE_BUCKET], false, parallel);
     const auto filteredLayeredOpaque = task.addJob<FilterLayeredItems>("FilterLayeredOpaque", layeredOpaques, ItemKey::Layer::LAYER_1);
     const auto filteredLayeredTransparent = task.addJob<FilterLayeredItems>("FilterLayeredTransparent", layeredTransparents, ItemKey::Layer::LAYER_1);
 
@@ -39,7 +39,10 @@ public:
 
     RenderFetchCullSortTask() {}
 
-    void build(JobModel& task, const render::Varying& inputs, render::Varying& outputs, render::CullFunctor cullFunctor, uint8_t tagBits, uint8_t tagMask);
+    // parallel selects the chunked parallel cull and radix depth sort jobs over the serial ones, which only pay for
+    // themselves on views with many items (see CullSortTests::benchmark)
+    void build(JobModel& task, const render::Varying& inputs, render::Varying& outputs, render::CullFunctor cullFunctor, uint8_t tagBits, uint8_t tagMask,
+               bool parallel = false);
 };
 
 #endif // hifi_RenderFetchCullSortTask_h
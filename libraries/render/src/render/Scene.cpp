@@ -12,12 +12,16 @@
 
 #include <numeric>
 #include <gpu/Batch.h>
+#include <SharedUtil.h>
 #include "Logging.h"
 #include "TransitionStage.h"
 #include "HighlightStage.h"
 
 using namespace render;
 
+// Item transactions are applied in batches of this size, checking the budget in between
+static const size_t TRANSACTION_BATCH_SIZE = 256;
+
 void Transaction::resetItem(ItemID id, const PayloadPointer& payload) {
     if (payload) {
         _resetItems.emplace_back(Reset{ id, payload });
@@ -189,6 +193,13 @@ Scene::Scene(glm::vec3 origin, float size) :
 
 Scene::~Scene() {
     qCDebug(renderlogging) << "Scene::~Scene()";
+
+    auto node = _transactionStack.exchange(nullptr);
+    while (node) {
+        auto next = node->next;
+        delete node;
+        node = next;
+    }
 }
 
 ItemID Scene::allocateID() {
@@ -201,55 +212,96 @@ bool Scene::isAllocatedID(const ItemID& id) const {
 }
 
 /// Enqueue change batch to the scene
+void Scene::pushTransaction(TransactionNode* node) {
+    node->next = _transactionStack.load(std::memory_order_relaxed);
+    while (!_transactionStack.compare_exchange_weak(node->next, node, std::memory_order_release, std::memory_order_relaxed)) {
+    }
+}
+
 void Scene::enqueueTransaction(const Transaction& transaction) {
-    std::unique_lock<std::mutex> lock(_transactionQueueMutex);
-    _transactionQueue.emplace_back(transaction);
+    pushTransaction(new TransactionNode(transaction));
 }
 
 void Scene::enqueueTransaction(Transaction&& transaction) {
-    std::unique_lock<std::mutex> lock(_transactionQueueMutex);
-    _transactionQueue.emplace_back(std::move(transaction));
+    pushTransaction(new TransactionNode(std::move(transaction)));
 }
 
 uint32_t Scene::enqueueFrame() {
     PROFILE_RANGE(render, __FUNCTION__);
+
+    // Take the whole stack at once, and restore the submission order
+    TransactionNode* reversed = nullptr;
+    auto node = _transactionStack.exchange(nullptr, std::memory_order_acquire);
+    while (node) {
+        auto next = node->next;
+        node->next = reversed;
+        reversed = node;
+        node = next;
+    }
+
     TransactionQueue localTransactionQueue;
-    {
-        std::unique_lock<std::mutex> lock(_transactionQueueMutex);
-        localTransactionQueue.swap(_transactionQueue);
+    while (reversed) {
+        auto next = reversed->next;
+        localTransactionQueue.emplace_back(std::move(reversed->transaction));
+        delete reversed;
+        reversed = next;
     }
 
     Transaction consolidatedTransaction;
     consolidatedTransaction.merge(std::move(localTransactionQueue));
+    _transactionBacklog += consolidatedTransaction._resetItems.size() + consolidatedTransaction._updatedItems.size() +
+        consolidatedTransaction._removedItems.size();
     {
         std::unique_lock<std::mutex> lock(_transactionFramesMutex);
-        _transactionFrames.push_back(consolidatedTransaction);
+        _transactionFrames.push_back(std::move(consolidatedTransaction));
     }
 
     return ++_transactionFrameNumber;
 }
 
  
-void Scene::processTransactionQueue() {
+void Scene::processTransactionQueue(uint64_t budgetUsecs) {
     PROFILE_RANGE(render, __FUNCTION__);
 
-    static TransactionFrames queuedFrames;
     {
         // capture the queued frames and clear the queue
         std::unique_lock<std::mutex> lock(_transactionFramesMutex);
-        queuedFrames.swap(_transactionFrames);
+        _queuedFrames.swap(_transactionFrames);
+    }
+    for (auto& frame : _queuedFrames) {
+        _pendingFrames.push_back(std::move(frame));
     }
+    _queuedFrames.clear();
 
-    // go through the queue of frames and process them
-    for (auto& frame : queuedFrames) {
-        processTransactionFrame(frame);
+    // go through the queue of frames and process them, until the budget is spent
+    uint64_t deadline = (budgetUsecs > 0) ? usecTimestampNow() + budgetUsecs : 0;
+    while (!_pendingFrames.empty()) {
+        if (!processTransactionFrame(_pendingFrames.front(), deadline)) {
+            break;
+        }
+        _pendingFrames.pop_front();
+        _frameProgress = FrameProgress();
     }
+}
 
-    queuedFrames.clear();
+// Apply the item transactions from begin in batches, until they are all done or the deadline has passed.
+// Returns where to resume from.
+template <class T, class F>
+static size_t applyBatches(const std::vector<T>& transactions, size_t begin, uint64_t deadline, F apply) {
+    while (begin < transactions.size()) {
+        size_t end = std::min(begin + TRANSACTION_BATCH_SIZE, transactions.size());
+        apply(transactions, begin, end);
+        begin = end;
+        if (deadline > 0 && usecTimestampNow() > deadline) {
+            break;
+        }
+    }
+    return begin;
 }
 
-void Scene::processTransactionFrame(const Transaction& transaction) {
+bool Scene::processTransactionFrame(const Transaction& transaction, uint64_t deadline) {
     PROFILE_RANGE(render, __FUNCTION__);
+    auto& progress = _frameProgress;
     {
         std::unique_lock<std::mutex> lock(_itemsMutex);
         // Here we should be able to check the value of last ItemID allocated 
@@ -257,21 +309,41 @@ void Scene::processTransactionFrame(const Transaction& transaction) {
         ItemID maxID = _IDAllocator.load();
         if (maxID > _items.size()) {
             _items.resize(maxID + 100); // allocate the maxId and more
+            _updateStamps.resize(_items.size(), 0);
         }
         // Now we know for sure that we have enough items in the array to
         // capture anything coming from the transaction
 
         // resets and potential NEW items
-        resetItems(transaction._resetItems);
+        size_t begin = progress.resets;
+        progress.resets = applyBatches(transaction._resetItems, begin, deadline,
+            [this](const Transaction::Resets& resets, size_t from, size_t to) { resetItems(resets, from, to); });
+        _transactionBacklog -= progress.resets - begin;
+        if (progress.resets < transaction._resetItems.size()) {
+            return false;
+        }
 
-        // Update the numItemsAtomic counter AFTER the reset changes went through
+        // Update the numItemsAtomic counter AFTER the reset changes went through, all of them: until then some of
+        // the new IDs are still empty
         _numAllocatedItems.exchange(maxID);
 
         // updates
-        updateItems(transaction._updatedItems);
+        begin = progress.updates;
+        progress.updates = applyBatches(transaction._updatedItems, begin, deadline,
+            [this](const Transaction::Updates& updates, size_t from, size_t to) { updateItems(updates, from, to); });
+        _transactionBacklog -= progress.updates - begin;
+        if (progress.updates < transaction._updatedItems.size()) {
+            return false;
+        }
 
         // removes
-        removeItems(transaction._removedItems);
+        begin = progress.removes;
+        progress.removes = applyBatches(transaction._removedItems, begin, deadline,
+            [this](const Transaction::Removes& removes, size_t from, size_t to) { removeItems(removes, from, to); });
+        _transactionBacklog -= progress.removes - begin;
+        if (progress.removes < transaction._removedItems.size()) {
+            return false;
+        }
 
         // add transitions
         resetTransitionItems(transaction._resetTransitions);
@@ -288,10 +360,13 @@ void Scene::processTransactionFrame(const Transaction& transaction) {
     resetHighlights(transaction._highlightResets);
     removeHighlights(transaction._highlightRemoves);
     queryHighlights(transaction._highlightQueries);
+
+    return true;
 }
 
-void Scene::resetItems(const Transaction::Resets& transactions) {
-    for (auto& reset : transactions) {
+void Scene::resetItems(const Transaction::Resets& transactions, size_t begin, size_t end) {
+    for (size_t i = begin; i < end; i++) {
+        const auto& reset = transactions[i];
         // Access the true item
         auto itemId = std::get<0>(reset);
         auto& item = _items[itemId];
@@ -313,8 +388,9 @@ void Scene::resetItems(const Transaction::Resets& transactions) {
     }
 }
 
-void Scene::removeItems(const Transaction::Removes& transactions) {
-    for (auto removedID : transactions) {
+void Scene::removeItems(const Transaction::Removes& transactions, size_t begin, size_t end) {
+    for (size_t i = begin; i < end; i++) {
+        auto removedID = transactions[i];
         // Access the true item
         auto& item = _items[removedID];
         auto oldCell = item.getCell();
@@ -335,8 +411,13 @@ void Scene::removeItems(const Transaction::Removes& transactions) {
     }
 }
 
-void Scene::updateItems(const Transaction::Updates& transactions) {
-    for (auto& update : transactions) {
+void Scene::updateItems(const Transaction::Updates& transactions, size_t begin, size_t end) {
+    // Run all the update functors in order, remembering where each item was before its first one.
+    // The functors can't be merged, since each may change a different part of the item, but an update without one
+    // only asks for the item to be re-sorted, which its first update in the batch has already done
+    _itemsToResort.clear();
+    for (size_t i = begin; i < end; i++) {
+        const auto& update = transactions[i];
         auto updateID = std::get<0>(update);
         if (updateID == Item::INVALID_ITEM_ID) {
             continue;
@@ -350,12 +431,29 @@ void Scene::updateItems(const Transaction::Updates& transactions) {
             continue;
         }
 
-        // Good to go, deal with the update
-        auto oldCell = item.getCell();
-        auto oldKey = item.getKey();
+        const auto& functor = std::get<1>(update);
+        if (_updateStamps[updateID] != _updateStamp) {
+            _updateStamps[updateID] = _updateStamp;
+            _itemsToResort.push_back({ updateID, item.getCell(), item.getKey() });
+        } else if (!functor) {
+            continue;
+        }
 
         // Update the item
-        item.update(std::get<1>(update));
+        item.update(functor);
+    }
+
+    if (++_updateStamp == 0) {
+        std::fill(_updateStamps.begin(), _updateStamps.end(), 0);
+        _updateStamp = 1;
+    }
+
+    // Then move each updated item in the spatial tree once
+    for (const auto& updated : _itemsToResort) {
+        auto updateID = updated.id;
+        auto& item = _items[updateID];
+        auto oldCell = updated.oldCell;
+        auto oldKey = updated.oldKey;
         auto newKey = item.getKey();
 
         // Update the item's container
@@ -12,6 +12,8 @@
 #ifndef hifi_render_Scene_h
 #define hifi_render_Scene_h
 
+#include <deque>
+
 #include "Item.h"
 #include "SpatialTree.h"
 #include "Stage.h"
@@ -146,17 +148,21 @@ public:
     // THis is the total number of allocated items, this a threadsafe call
     size_t getNumItems() const { return _numAllocatedItems.load(); }
 
-    // Enqueue transaction to the scene
+    // Enqueue transaction to the scene, this a lock free threadsafe call
     void enqueueTransaction(const Transaction& transaction);
 
-    // Enqueue transaction to the scene
+    // Enqueue transaction to the scene, this a lock free threadsafe call
     void enqueueTransaction(Transaction&& transaction);
 
     // Enqueue end of frame transactions boundary
     uint32_t enqueueFrame();
 
-    // Process the pending transactions queued
-    void processTransactionQueue();
+    // Process the pending transactions queued.
+    // With a budget, stop once it is spent and carry on from there on the next call, 0 applies everything
+    void processTransactionQueue(uint64_t budgetUsecs = 0);
+
+    // Number of item resets, updates and removes enqueued in frames but not applied yet, this a threadsafe call
+    size_t getTransactionBacklog() const { return _transactionBacklog.load(); }
 
     // Access a particular selection (empty if doesn't exist)
     // Thread safe
@@ -199,17 +205,36 @@ protected:
     // Thread safe elements that can be accessed from anywhere
     std::atomic<unsigned int> _IDAllocator{ 1 }; // first valid itemID will be One
     std::atomic<unsigned int> _numAllocatedItems{ 1 }; // num of allocated items, matching the _items.size()
-    std::mutex _transactionQueueMutex;
-    TransactionQueue _transactionQueue;
 
-    
+    // Transactions are pushed on a lock free stack, and popped all at once by enqueueFrame
+    struct TransactionNode {
+        TransactionNode(const Transaction& transaction) : transaction(transaction) {}
+        TransactionNode(Transaction&& transaction) : transaction(std::move(transaction)) {}
+
+        Transaction transaction;
+        TransactionNode* next { nullptr };
+    };
+    std::atomic<TransactionNode*> _transactionStack { nullptr };
+    void pushTransaction(TransactionNode* node);
+
     std::mutex _transactionFramesMutex;
     using TransactionFrames = std::vector<Transaction>;
     TransactionFrames _transactionFrames;
     uint32_t _transactionFrameNumber{ 0 };
+    std::atomic<size_t> _transactionBacklog { 0 };
+
+    // Frames being applied on the render thread, the front one may be partially applied
+    TransactionFrames _queuedFrames;
+    std::deque<Transaction> _pendingFrames;
+    struct FrameProgress {
+        size_t resets { 0 };
+        size_t updates { 0 };
+        size_t removes { 0 };
+    };
+    FrameProgress _frameProgress;
 
-    // Process one transaction frame 
-    void processTransactionFrame(const Transaction& transaction);
+    // Process the front transaction frame until the deadline (0 for none), returns true once it is fully applied
+    bool processTransactionFrame(const Transaction& transaction, uint64_t deadline);
 
     // The actual database
     // database of items is protected for editing by a mutex
@@ -218,10 +243,20 @@ protected:
     ItemSpatialTree _masterSpatialTree;
     ItemIDSet _masterNonspatialSet;
 
-    void resetItems(const Transaction::Resets& transactions);
+    void resetItems(const Transaction::Resets& transactions, size_t begin, size_t end);
     void resetTransitionFinishedOperator(const Transaction::TransitionFinishedOperators& transactions);
-    void removeItems(const Transaction::Removes& transactions);
-    void updateItems(const Transaction::Updates& transactions);
+    void removeItems(const Transaction::Removes& transactions, size_t begin, size_t end);
+    void updateItems(const Transaction::Updates& transactions, size_t begin, size_t end);
+
+    // Items touched by the current batch of updates, so each one is moved in the spatial tree once
+    struct UpdatedItem {
+        ItemID id;
+        ItemCell oldCell;
+        ItemKey oldKey;
+    };
+    std::vector<UpdatedItem> _itemsToResort;
+    std::vector<uint32_t> _updateStamps;
+    uint32_t _updateStamp { 1 };
 
     void resetTransitionItems(const Transaction::TransitionResets& transactions);
     void removeTransitionItems(const Transaction::TransitionRemoves& transactions);
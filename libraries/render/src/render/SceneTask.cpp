@@ -10,12 +10,15 @@
 //
 #include "SceneTask.h"
 
+#include <NumericalConstants.h>
+
 
 using namespace render;
 
 void PerformSceneTransaction::configure(const Config& config) {
+    _budgetUsecs = (uint64_t)(std::max(config.budget, 0.0f) * USECS_PER_MSEC);
 }
 
 void PerformSceneTransaction::run(const RenderContextPointer& renderContext) {
-    renderContext->_scene->processTransactionQueue();
+    renderContext->_scene->processTransactionQueue(_budgetUsecs);
 }
@@ -18,7 +18,12 @@ namespace render {
 
     class PerformSceneTransactionConfig : public Job::Config {
         Q_OBJECT
+        // msecs per frame spent applying transactions, 0 for no limit. Anything queued behind the spent budget,
+        // including the transitions and selections at the end of each frame, waits for a later frame
+        Q_PROPERTY(float budget MEMBER budget NOTIFY dirty)
     public:
+        float budget { 4.0f };
+
     signals:
         void dirty();
 
@@ -33,6 +38,7 @@ namespace render {
         void configure(const Config& config);
         void run(const RenderContextPointer& renderContext);
     protected:
+        uint64_t _budgetUsecs { 0 };
     };
 
 
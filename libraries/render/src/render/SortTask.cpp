@@ -13,10 +13,20 @@
 #include "ShapePipeline.h"
 
 #include <assert.h>
+#include <string.h>
+#include <TBBHelpers.h>
 #include <ViewFrustum.h>
 
 using namespace render;
 
+static const int RADIX_BITS = 8;
+static const int RADIX_PASSES = 3;
+static const uint32_t RADIX_MASK = (1 << RADIX_BITS) - 1;
+static const uint32_t DEPTH_KEY_MASK = (1 << (RADIX_BITS * RADIX_PASSES)) - 1;
+
+// below this many items the depth keys are computed on the calling thread
+static const size_t PARALLEL_DEPTH_KEYS_THRESHOLD = 4096;
+
 struct ItemBoundSort {
     float _centerDepth = 0.0f;
     float _nearDepth = 0.0f;
@@ -45,7 +55,6 @@ void render::depthSortItems(const RenderContextPointer& renderContext, bool fron
     assert(renderContext->args);
     assert(renderContext->args->hasViewFrustum());
 
-    auto& scene = renderContext->_scene;
     RenderArgs* args = renderContext->args;
 
 
@@ -56,10 +65,9 @@ void render::depthSortItems(const RenderContextPointer& renderContext, bool fron
 
     // Make a local dataset of the center distance and closest point distance
     std::vector<ItemBoundSort> itemBoundSorts;
-    itemBoundSorts.reserve(outItems.size());
+    itemBoundSorts.reserve(inItems.size());
 
-    for (auto itemDetails : inItems) {
-        auto item = scene->getItem(itemDetails.id);
+    for (const auto& itemDetails : inItems) {
         auto bound = itemDetails.bound; // item.getBound();
         float distanceSquared = args->getViewFrustum().distanceToCameraSquared(bound.calcCenter());
 
@@ -98,23 +106,106 @@ void render::depthSortItems(const RenderContextPointer& renderContext, bool fron
     }
 }
 
+void render::radixDepthSortItems(const RenderContextPointer& renderContext, bool frontToBack, const ItemBounds& inItems,
+                                 ItemBounds& outItems, DepthSortBuffers& buffers, AABox* bounds) {
+    assert(renderContext->args);
+    assert(renderContext->args->hasViewFrustum());
+
+    const ViewFrustum& frustum = renderContext->args->getViewFrustum();
+    size_t numItems = inItems.size();
+
+    outItems.clear();
+    outItems.reserve(numItems);
+
+    auto& keys = buffers.keys;
+    auto& indices = buffers.indices;
+    for (int i = 0; i < 2; i++) {
+        keys[i].resize(numItems);
+        indices[i].resize(numItems);
+    }
+
+    // Squared distances are positive, so their float bits sort in the same order.
+    // Keep the exponent and the top 15 bits of mantissa as a 24-bit key.
+    auto computeKeys = [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            float distanceSquared = frustum.distanceToCameraSquared(inItems[i].bound.calcCenter());
+            uint32_t bits;
+            memcpy(&bits, &distanceSquared, sizeof(bits));
+            uint32_t key = bits >> (32 - RADIX_BITS * RADIX_PASSES);
+            keys[0][i] = frontToBack ? key : (DEPTH_KEY_MASK - key);
+            indices[0][i] = (uint32_t)i;
+        }
+    };
+    if (numItems > PARALLEL_DEPTH_KEYS_THRESHOLD) {
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, numItems), [&](const tbb::blocked_range<size_t>& range) {
+            computeKeys(range.begin(), range.end());
+        });
+    } else {
+        computeKeys(0, numItems);
+    }
+
+    // LSD radix sort, ping-ponging between the two buffers
+    int src = 0;
+    for (int pass = 0; pass < RADIX_PASSES; pass++) {
+        int shift = pass * RADIX_BITS;
+        int dst = 1 - src;
+
+        uint32_t offsets[RADIX_MASK + 1] = {};
+        for (size_t i = 0; i < numItems; i++) {
+            offsets[(keys[src][i] >> shift) & RADIX_MASK]++;
+        }
+        uint32_t offset = 0;
+        for (auto& count : offsets) {
+            uint32_t bucketSize = count;
+            count = offset;
+            offset += bucketSize;
+        }
+        for (size_t i = 0; i < numItems; i++) {
+            uint32_t slot = offsets[(keys[src][i] >> shift) & RADIX_MASK]++;
+            keys[dst][slot] = keys[src][i];
+            indices[dst][slot] = indices[src][i];
+        }
+        src = dst;
+    }
+
+    // Finally once sorted result to a list of itemID and keep uniques
+    const auto& sorted = indices[src];
+    render::ItemID previousID = Item::INVALID_ITEM_ID;
+    if (bounds && numItems > 0 && bounds->isNull()) {
+        *bounds = inItems[sorted.front()].bound;
+    }
+    for (size_t i = 0; i < numItems; i++) {
+        const auto& item = inItems[sorted[i]];
+        if (item.id != previousID) {
+            outItems.emplace_back(item);
+            previousID = item.id;
+            if (bounds) {
+                *bounds += item.bound;
+            }
+        }
+    }
+}
+
 void PipelineSortShapes::run(const RenderContextPointer& renderContext, const ItemBounds& inItems, ShapeBounds& outShapes) {
     auto& scene = renderContext->_scene;
-    outShapes.clear();
+
+    // Keep last frame's buckets, so their storage is reused
+    for (auto& items : outShapes) {
+        items.second.clear();
+    }
 
     for (const auto& item : inItems) {
         auto key = scene->getItem(item.id).getShapeKey();
-        auto outItems = outShapes.find(key);
-        if (outItems == outShapes.end()) {
-            outItems = outShapes.insert(std::make_pair(key, ItemBounds{})).first;
-            outItems->second.reserve(inItems.size());
-        }
-
-        outItems->second.push_back(item);
+        outShapes[key].push_back(item);
     }
 
-    for (auto& items : outShapes) {
-        items.second.shrink_to_fit();
+    // Drop the pipelines that are no longer in use
+    for (auto items = outShapes.begin(); items != outShapes.end();) {
+        if (items->second.empty()) {
+            items = outShapes.erase(items);
+        } else {
+            ++items;
+        }
     }
 }
 
@@ -157,3 +248,7 @@ void DepthSortShapesAndComputeBounds::run(const RenderContextPointer& renderCont
 void DepthSortItems::run(const RenderContextPointer& renderContext, const ItemBounds& inItems, ItemBounds& outItems) {
     depthSortItems(renderContext, _frontToBack, inItems, outItems);
 }
+
+void RadixDepthSortItems::run(const RenderContextPointer& renderContext, const ItemBounds& inItems, ItemBounds& outItems) {
+    radixDepthSortItems(renderContext, _frontToBack, inItems, outItems, _buffers);
+}
@@ -17,6 +17,17 @@
 namespace render {
     void depthSortItems(const RenderContextPointer& renderContext, bool frontToBack, const ItemBounds& inItems, ItemBounds& outItems, AABox* bounds = nullptr);
 
+    // Scratch space for radixDepthSortItems, kept by the caller so that sorting does not allocate every frame
+    struct DepthSortBuffers {
+        std::vector<uint32_t> keys[2];
+        std::vector<uint32_t> indices[2];
+    };
+
+    // Same result as depthSortItems, but sorts on quantized depth keys with a stable radix sort,
+    // so items at (nearly) equal depth keep their input order
+    void radixDepthSortItems(const RenderContextPointer& renderContext, bool frontToBack, const ItemBounds& inItems, ItemBounds& outItems,
+                             DepthSortBuffers& buffers, AABox* bounds = nullptr);
+
     class PipelineSortShapes {
     public:
         using JobModel = Job::ModelIO<PipelineSortShapes, ItemBounds, ShapeBounds>;
@@ -53,6 +64,19 @@ namespace render {
 
         void run(const RenderContextPointer& renderContext, const ItemBounds& inItems, ItemBounds& outItems);
     };
+
+    class RadixDepthSortItems {
+    public:
+        using JobModel = Job::ModelIO<RadixDepthSortItems, ItemBounds, ItemBounds>;
+
+        bool _frontToBack;
+        RadixDepthSortItems(bool frontToBack = true) : _frontToBack(frontToBack) {}
+
+        void run(const RenderContextPointer& renderContext, const ItemBounds& inItems, ItemBounds& outItems);
+
+    private:
+        DepthSortBuffers _buffers;
+    };
 }
 
 #endif // hifi_render_SortTask_h;
@@ -0,0 +1,99 @@
+//
+//  BlendshapeDeltas.cpp
+//  libraries/shared/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "BlendshapeDeltas.h"
+
+#include <algorithm>
+#include <cstring>
+
+void BlendshapeDeltas::addBlendshape(const int* indices, const glm::vec3* vertices, const glm::vec3* normals, int numIndices,
+                                     const glm::vec3* tangents, int numTangents, float normalScale) {
+    const glm::vec3 ZERO(0.0f);
+    for (int j = 0; j < numIndices; j++) {
+        int index = indices[j];
+        glm::vec3 normal = normals[j] * normalScale;
+        glm::vec3 tangent = (j < numTangents) ? tangents[j] * normalScale : ZERO;
+        if (index < 0 || index >= _numVertices || (vertices[j] == ZERO && normal == ZERO && tangent == ZERO)) {
+            continue;
+        }
+
+        _indices.push_back(index);
+        for (const glm::vec3& delta : { vertices[j], normal, tangent }) {
+            _deltas.push_back(delta.x);
+            _deltas.push_back(delta.y);
+            _deltas.push_back(delta.z);
+        }
+    }
+    _rows.push_back((int)_indices.size());
+}
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+
+#include <xmmintrin.h>
+
+//
+// SSE code
+//
+
+static void accumulateDeltas_SSE(const int* indices, const float (*deltas)[BlendshapeDeltas::DELTA_SIZE], int numDeltas,
+                                 float coefficient, float (*offsets)[BlendshapeDeltas::DELTA_SIZE]) {
+    const __m128 c = _mm_set1_ps(coefficient);
+    for (int j = 0; j < numDeltas; j++) {
+        float* offset = offsets[indices[j]];
+        const float* delta = deltas[j];
+        _mm_storeu_ps(&offset[0], _mm_add_ps(_mm_loadu_ps(&offset[0]), _mm_mul_ps(_mm_loadu_ps(&delta[0]), c)));
+        _mm_storeu_ps(&offset[4], _mm_add_ps(_mm_loadu_ps(&offset[4]), _mm_mul_ps(_mm_loadu_ps(&delta[4]), c)));
+        offset[8] += delta[8] * coefficient;
+    }
+}
+
+//
+// Runtime CPU dispatch
+//
+
+#include "CPUDetect.h"
+
+void accumulateDeltas_AVX2(const int* indices, const float (*deltas)[9], int numDeltas, float coefficient, float (*offsets)[9]);
+
+static void accumulateDeltas(const int* indices, const float (*deltas)[BlendshapeDeltas::DELTA_SIZE], int numDeltas,
+                             float coefficient, float (*offsets)[BlendshapeDeltas::DELTA_SIZE]) {
+    static auto f = cpuSupportsAVX2() ? accumulateDeltas_AVX2 : accumulateDeltas_SSE;
+    (*f)(indices, deltas, numDeltas, coefficient, offsets);  // dispatch
+}
+
+#else   // portable reference code
+
+static void accumulateDeltas(const int* indices, const float (*deltas)[BlendshapeDeltas::DELTA_SIZE], int numDeltas,
+                             float coefficient, float (*offsets)[BlendshapeDeltas::DELTA_SIZE]) {
+    for (int j = 0; j < numDeltas; j++) {
+        float* offset = offsets[indices[j]];
+        for (int k = 0; k < BlendshapeDeltas::DELTA_SIZE; k++) {
+            offset[k] += deltas[j][k] * coefficient;
+        }
+    }
+}
+
+#endif
+
+void BlendshapeDeltas::blend(const float* coefficients, int numCoefficients, float threshold, float (*offsets)[DELTA_SIZE]) const {
+    memset(offsets, 0, _numVertices * sizeof(offsets[0]));
+
+    auto deltas = reinterpret_cast<const float (*)[DELTA_SIZE]>(_deltas.data());
+    int numBlendshapes = std::min(numCoefficients, getNumBlendshapes());
+    for (int i = 0; i < numBlendshapes; i++) {
+        float coefficient = coefficients[i];
+        if (coefficient < threshold) {
+            continue;
+        }
+        int begin = _rows[i];
+        int end = _rows[i + 1];
+        accumulateDeltas(&_indices[begin], &deltas[begin], end - begin, coefficient, offsets);
+    }
+}
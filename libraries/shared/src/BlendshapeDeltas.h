@@ -0,0 +1,47 @@
+//
+//  BlendshapeDeltas.h
+//  libraries/shared/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_BlendshapeDeltas_h
+#define hifi_BlendshapeDeltas_h
+
+#include <vector>
+
+#include <glm/glm.hpp>
+
+// The blendshapes of one mesh, packed at load time as compressed sparse rows.
+// The deltas of blendshape i are the entries [_rows[i], _rows[i + 1]), each a vertex index and the
+// position, normal and tangent offsets of that vertex, laid out like BlendshapeOffsetUnpacked.
+// Entries that would not move their vertex are dropped.
+class BlendshapeDeltas {
+public:
+    static const int DELTA_SIZE = 9;
+
+    explicit BlendshapeDeltas(int numVertices = 0) : _numVertices(numVertices) {}
+
+    // normals and tangents are stored pre-multiplied by normalScale. there may be fewer tangents than indices.
+    void addBlendshape(const int* indices, const glm::vec3* vertices, const glm::vec3* normals, int numIndices,
+                       const glm::vec3* tangents, int numTangents, float normalScale);
+
+    int getNumVertices() const { return _numVertices; }
+    int getNumBlendshapes() const { return (int)_rows.size() - 1; }
+    int getNumDeltas() const { return (int)_indices.size(); }
+
+    // overwrite offsets (getNumVertices() entries) with the sum of the deltas of each blendshape,
+    // weighted by its coefficient. coefficients below threshold are skipped.
+    void blend(const float* coefficients, int numCoefficients, float threshold, float (*offsets)[DELTA_SIZE]) const;
+
+private:
+    int _numVertices;
+    std::vector<int> _rows { 0 };
+    std::vector<int> _indices;
+    std::vector<float> _deltas;
+};
+
+#endif // hifi_BlendshapeDeltas_h
@@ -0,0 +1,352 @@
+//
+//  GzipDevice.cpp
+//  libraries/shared/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "GzipDevice.h"
+
+#include <limits>
+
+#include <QThreadPool>
+
+#include <zlib.h>
+
+static const int GZIP_WINDOWS_BIT = 31;
+static const int DEFAULT_MEM_LEVEL = 8;
+static const int GZIP_DEVICE_CHUNK_SIZE = 64 * 1024;
+
+// the deflate window, which is how much of the previous block each parallel block may refer back to
+static const int DICTIONARY_SIZE = 32 * 1024;
+
+// the gzip header of a parallel stream: deflate, no name or time, unknown OS
+static const char GZIP_HEADER[] = { '\x1f', '\x8b', '\x08', '\x00', '\x00', '\x00', '\x00', '\x00', '\x00', '\xff' };
+// an empty, final, fixed-Huffman deflate block, which ends the stream after the last (sync-flushed) block
+static const char DEFLATE_END[] = { '\x03', '\x00' };
+
+static int clampCompressionLevel(int compressionLevel) {
+    return qMax(Z_DEFAULT_COMPRESSION, qMin(9, compressionLevel));
+}
+
+class GzipDevice::CompressTask : public QRunnable {
+public:
+    CompressTask(std::promise<Block> promise, QByteArray input, QByteArray dictionary, int compressionLevel) :
+        _promise(std::move(promise)), _input(std::move(input)), _dictionary(std::move(dictionary)),
+        _compressionLevel(compressionLevel) {}
+
+    void run() override { _promise.set_value(compressBlock(_input, _dictionary, _compressionLevel)); }
+
+private:
+    std::promise<Block> _promise;
+    QByteArray _input;
+    QByteArray _dictionary;
+    int _compressionLevel;
+};
+
+GzipDevice::GzipDevice(QIODevice* device, int compressionLevel, int numThreads, int blockSize) :
+    _device(device),
+    _compressionLevel(clampCompressionLevel(compressionLevel)),
+    _numThreads(qMax(1, numThreads)),
+    _blockSize(qMax(DICTIONARY_SIZE, blockSize)) {
+}
+
+GzipDevice::~GzipDevice() {
+    close();
+}
+
+bool GzipDevice::isGzipped(QIODevice* device) {
+    QByteArray magic = device->peek(2);
+    return magic.size() == 2 && magic.at(0) == GZIP_HEADER[0] && magic.at(1) == GZIP_HEADER[1];
+}
+
+bool GzipDevice::open(OpenMode mode) {
+    if (isOpen() || !_device || (mode & ReadWrite) == ReadWrite || (mode & Append)) {
+        return false;
+    }
+
+    _stream = new z_stream;
+    _stream->zalloc = Z_NULL;
+    _stream->zfree = Z_NULL;
+    _stream->opaque = Z_NULL;
+    _stream->next_in = Z_NULL;
+    _stream->avail_in = 0;
+    _reading = (mode & ReadOnly);
+    _streamEnded = false;
+    _finished = false;
+    _hasError = false;
+
+    int status = Z_OK;
+    if (_reading) {
+        status = inflateInit2(_stream, GZIP_WINDOWS_BIT);
+        _buffer.resize(GZIP_DEVICE_CHUNK_SIZE);
+    } else if (_numThreads == 1) {
+        status = deflateInit2(_stream, _compressionLevel, Z_DEFLATED, GZIP_WINDOWS_BIT,
+                              DEFAULT_MEM_LEVEL, Z_DEFAULT_STRATEGY);
+        _buffer.resize(GZIP_DEVICE_CHUNK_SIZE);
+    } else {
+        // the parallel writer lays out the gzip wrapper itself, and only deflates raw blocks (on other threads)
+        delete _stream;
+        _stream = nullptr;
+        _block.reserve(_blockSize);
+        _dictionary.clear();
+        _crc = crc32(0L, Z_NULL, 0);
+        _length = 0;
+        if (!_threadPool) {
+            _threadPool.reset(new QThreadPool());
+            _threadPool->setMaxThreadCount(_numThreads);
+        }
+    }
+    if (status != Z_OK) {
+        delete _stream;
+        _stream = nullptr;
+        return false;
+    }
+
+    if (!QIODevice::open(mode)) {
+        close();
+        return false;
+    }
+    if ((mode & WriteOnly) && _numThreads > 1 && !writeToDevice(GZIP_HEADER, sizeof(GZIP_HEADER))) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+void GzipDevice::close() {
+    if (openMode() & WriteOnly) {
+        finish();
+    }
+    if (_stream) {
+        if (_reading) {
+            inflateEnd(_stream);
+        } else {
+            deflateEnd(_stream);
+        }
+        delete _stream;
+        _stream = nullptr;
+    }
+    _pendingBlocks.clear();
+    // waits for any block still being compressed after a failed write
+    _threadPool.reset();
+    _buffer = QByteArray();
+    _block = QByteArray();
+    _dictionary = QByteArray();
+    QIODevice::close();
+}
+
+bool GzipDevice::atEnd() const {
+    return !isOpen() || ((_streamEnded || _hasError) && QIODevice::bytesAvailable() == 0);
+}
+
+bool GzipDevice::fail(const QString& error) {
+    if (!_hasError) {
+        _hasError = true;
+        setErrorString(error);
+    }
+    return false;
+}
+
+bool GzipDevice::writeToDevice(const char* data, qint64 size) {
+    if (_device->write(data, size) != size) {
+        return fail("Error writing gzip data: " + _device->errorString());
+    }
+    return true;
+}
+
+qint64 GzipDevice::readData(char* data, qint64 maxSize) {
+    if (_hasError) {
+        return -1;
+    }
+    if (_streamEnded || maxSize <= 0) {
+        return 0;
+    }
+
+    _stream->next_out = (Bytef*)data;
+    _stream->avail_out = (uInt)qMin(maxSize, (qint64)std::numeric_limits<uInt>::max());
+    uInt requested = _stream->avail_out;
+
+    while (_stream->avail_out > 0 && !_streamEnded) {
+        if (_stream->avail_in == 0) {
+            qint64 got = _device->read(_buffer.data(), _buffer.size());
+            if (got < 0) {
+                fail("Error reading gzip data: " + _device->errorString());
+                break;
+            }
+            if (got == 0) {
+                if (_device->atEnd()) {
+                    fail("Gzip data is truncated");
+                }
+                // otherwise more of a sequential device has yet to arrive
+                break;
+            }
+            _stream->next_in = (Bytef*)_buffer.data();
+            _stream->avail_in = (uInt)got;
+        }
+
+        int status = inflate(_stream, Z_NO_FLUSH);
+        if (status == Z_STREAM_END) {
+            _streamEnded = true;
+        } else if (status != Z_OK && status != Z_BUF_ERROR) {
+            fail(QString("Gzip data is corrupt: ") + (_stream->msg ? _stream->msg : "inflate failed"));
+            break;
+        }
+    }
+
+    qint64 produced = requested - _stream->avail_out;
+    return (produced == 0 && _hasError) ? -1 : produced;
+}
+
+qint64 GzipDevice::writeData(const char* data, qint64 size) {
+    if (_hasError || _finished) {
+        return -1;
+    }
+
+    if (_stream) {
+        qint64 remaining = size;
+        while (remaining > 0) {
+            uInt chunk = (uInt)qMin(remaining, (qint64)std::numeric_limits<uInt>::max());
+            _stream->next_in = (Bytef*)data;
+            _stream->avail_in = chunk;
+            if (!deflateInput(Z_NO_FLUSH)) {
+                return -1;
+            }
+            data += chunk;
+            remaining -= chunk;
+        }
+        return size;
+    }
+
+    qint64 remaining = size;
+    while (remaining > 0) {
+        int chunk = (int)qMin(remaining, (qint64)(_blockSize - _block.size()));
+        _block.append(data, chunk);
+        data += chunk;
+        remaining -= chunk;
+        if (_block.size() == _blockSize && !submitBlock()) {
+            return -1;
+        }
+    }
+    return size;
+}
+
+bool GzipDevice::deflateInput(int flush) {
+    int status;
+    do {
+        _stream->next_out = (Bytef*)_buffer.data();
+        _stream->avail_out = (uInt)_buffer.size();
+        status = deflate(_stream, flush);
+        if (status == Z_STREAM_ERROR) {
+            return fail("Error compressing gzip data");
+        }
+        if (!writeToDevice(_buffer.constData(), _buffer.size() - _stream->avail_out)) {
+            return false;
+        }
+    } while (_stream->avail_out == 0 || (flush == Z_FINISH && status != Z_STREAM_END));
+    return true;
+}
+
+GzipDevice::Block GzipDevice::compressBlock(QByteArray input, QByteArray dictionary, int compressionLevel) {
+    Block block;
+    block.length = input.size();
+    block.crc = crc32(crc32(0L, Z_NULL, 0), (const Bytef*)input.constData(), (uInt)input.size());
+
+    z_stream stream;
+    stream.zalloc = Z_NULL;
+    stream.zfree = Z_NULL;
+    stream.opaque = Z_NULL;
+    if (deflateInit2(&stream, compressionLevel, Z_DEFLATED, -MAX_WBITS, DEFAULT_MEM_LEVEL, Z_DEFAULT_STRATEGY) != Z_OK) {
+        return block;
+    }
+    if (!dictionary.isEmpty()) {
+        deflateSetDictionary(&stream, (const Bytef*)dictionary.constData(), (uInt)dictionary.size());
+    }
+
+    // a sync flush rather than a finish ends the block on a byte boundary without ending the stream, so that the
+    // blocks can be joined one after the other
+    const int SYNC_FLUSH_MARKER_SIZE = 6;
+    block.data.resize((int)deflateBound(&stream, (uLong)input.size()) + SYNC_FLUSH_MARKER_SIZE);
+    stream.next_in = (Bytef*)input.constData();
+    stream.avail_in = (uInt)input.size();
+    int status;
+    int offset = 0;
+    do {
+        if (offset == block.data.size()) {
+            block.data.resize(block.data.size() * 2);
+        }
+        stream.next_out = (Bytef*)block.data.data() + offset;
+        stream.avail_out = (uInt)(block.data.size() - offset);
+        status = deflate(&stream, Z_SYNC_FLUSH);
+        offset = block.data.size() - stream.avail_out;
+    } while (status != Z_STREAM_ERROR && stream.avail_out == 0);
+    deflateEnd(&stream);
+
+    block.data.resize(offset);
+    block.success = (status != Z_STREAM_ERROR);
+    return block;
+}
+
+bool GzipDevice::submitBlock() {
+    QByteArray dictionary = _dictionary;
+    _dictionary = _block.right(DICTIONARY_SIZE);
+    std::promise<Block> promise;
+    _pendingBlocks.push_back(promise.get_future());
+    _threadPool->start(new CompressTask(std::move(promise), _block, dictionary, _compressionLevel));
+    _block = QByteArray();
+    _block.reserve(_blockSize);
+
+    // keep at most a block per thread in flight, writing them out in order as the oldest completes
+    if ((int)_pendingBlocks.size() >= _numThreads) {
+        return writeBlock();
+    }
+    return true;
+}
+
+bool GzipDevice::writeBlock() {
+    Block block = _pendingBlocks.front().get();
+    _pendingBlocks.pop_front();
+    if (!block.success) {
+        return fail("Error compressing gzip data");
+    }
+    _crc = crc32_combine(_crc, block.crc, (z_off_t)block.length);
+    _length += block.length;
+    return writeToDevice(block.data.constData(), block.data.size());
+}
+
+bool GzipDevice::finish() {
+    if (!(openMode() & WriteOnly)) {
+        return false;
+    }
+    if (_finished || _hasError) {
+        return _finished && !_hasError;
+    }
+    _finished = true;
+
+    if (_stream) {
+        _stream->next_in = Z_NULL;
+        _stream->avail_in = 0;
+        return deflateInput(Z_FINISH);
+    }
+
+    if (!_block.isEmpty() && !submitBlock()) {
+        return false;
+    }
+    while (!_pendingBlocks.empty()) {
+        if (!writeBlock()) {
+            return false;
+        }
+    }
+
+    // the trailer: the crc and length (modulo 2^32) of the uncompressed data, little endian
+    char trailer[8];
+    quint32 length = (quint32)_length;
+    for (int i = 0; i < 4; i++) {
+        trailer[i] = (char)((_crc >> (8 * i)) & 0xff);
+        trailer[4 + i] = (char)((length >> (8 * i)) & 0xff);
+    }
+    return writeToDevice(DEFLATE_END, sizeof(DEFLATE_END)) && writeToDevice(trailer, sizeof(trailer));
+}
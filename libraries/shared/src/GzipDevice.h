@@ -0,0 +1,94 @@
+//
+//  GzipDevice.h
+//  libraries/shared/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_GzipDevice_h
+#define hifi_GzipDevice_h
+
+#include <deque>
+#include <future>
+#include <memory>
+
+#include <QIODevice>
+
+class QThreadPool;
+struct z_stream_s;
+
+// A sequential device that gzips what is written to it into another device (opened WriteOnly), or gunzips what
+// is read from another device (opened ReadOnly), a chunk at a time, so that neither side is ever held in memory whole.
+//
+// When writing with more than one thread the input is cut into blocks that are deflated in parallel, on a pool of that
+// many threads, each primed with the last 32 KB of the block before it as pigz does, and joined into a single gzip
+// member that any gunzip reads.
+// The underlying device must be open, and is not closed or owned by the GzipDevice.
+class GzipDevice : public QIODevice {
+public:
+    static const int DEFAULT_BLOCK_SIZE { 128 * 1024 };
+
+    // compressionLevel is as for gzip() in Gzip.h
+    GzipDevice(QIODevice* device, int compressionLevel = -1, int numThreads = 1, int blockSize = DEFAULT_BLOCK_SIZE);
+    ~GzipDevice() override;
+
+    // true if the device's next bytes are a gzip header
+    static bool isGzipped(QIODevice* device);
+
+    bool open(OpenMode mode) override;
+    void close() override;
+    bool isSequential() const override { return true; }
+    bool atEnd() const override;
+
+    // writes out the rest of the stream, as close() does, returning false if it or any earlier write failed
+    bool finish();
+
+    // a write failed, or the data read is corrupt or truncated; see errorString()
+    bool hasError() const { return _hasError; }
+
+protected:
+    qint64 readData(char* data, qint64 maxSize) override;
+    qint64 writeData(const char* data, qint64 size) override;
+
+private:
+    struct Block {
+        QByteArray data;
+        unsigned long crc { 0 };
+        qint64 length { 0 };
+        bool success { false };
+    };
+    class CompressTask;
+
+    static Block compressBlock(QByteArray input, QByteArray dictionary, int compressionLevel);
+
+    bool fail(const QString& error);
+    bool writeToDevice(const char* data, qint64 size);
+    bool deflateInput(int flush);
+    bool submitBlock();
+    bool writeBlock();
+
+    QIODevice* _device;
+    int _compressionLevel;
+    int _numThreads;
+    int _blockSize;
+
+    struct z_stream_s* _stream { nullptr };
+    bool _reading { false };
+    QByteArray _buffer;
+    bool _streamEnded { false };
+    bool _finished { false };
+    bool _hasError { false };
+
+    // parallel compression
+    std::unique_ptr<QThreadPool> _threadPool;
+    QByteArray _block;
+    QByteArray _dictionary;
+    std::deque<std::future<Block>> _pendingBlocks;
+    unsigned long _crc { 0 };
+    quint64 _length { 0 };
+};
+
+#endif // hifi_GzipDevice_h
@@ -0,0 +1,340 @@
+//
+//  JobScheduler.cpp
+//  libraries/shared/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "JobScheduler.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iterator>
+#include <vector>
+
+#include "Profile.h"
+#include "SharedUtil.h"
+
+// how often the priorities of the queued jobs are re-evaluated, since the view they depend on keeps moving
+static const quint64 REPRIORITIZE_INTERVAL_USECS = 50 * USECS_PER_MSEC;
+
+// wait times are averaged over roughly this many jobs
+static const qint64 WAIT_TIME_AVERAGE_JOBS = 16;
+
+static const int DEFAULT_BLENDSHAPE_LIMIT = 2;
+static const int DEFAULT_BACKGROUND_LIMIT = 1;
+
+namespace {
+
+class FunctionRunnable : public QRunnable {
+public:
+    FunctionRunnable(JobScheduler::Job job) : _job(std::move(job)) {}
+    void run() override { _job(); }
+
+private:
+    JobScheduler::Job _job;
+};
+
+}
+
+class JobScheduler::JobRunner : public QRunnable {
+public:
+    JobRunner(JobScheduler* scheduler, JobClass jobClass, QRunnable* runnable) :
+        _scheduler(scheduler), _jobClass(jobClass), _runnable(runnable) {}
+
+    void run() override {
+        // as QThreadPool does, check before running, since a runnable that doesn't autoDelete()
+        // may be deleted by its owner as soon as it's done
+        bool autoDelete = _runnable->autoDelete();
+        _runnable->run();
+        if (autoDelete) {
+            delete _runnable;
+        }
+        _scheduler->jobFinished(_jobClass);
+    }
+
+private:
+    JobScheduler* _scheduler;
+    JobClass _jobClass;
+    QRunnable* _runnable;
+};
+
+JobScheduler& JobScheduler::getInstance() {
+    static JobScheduler* instance = globalInstance<JobScheduler>("com.highfidelity.JobScheduler");
+    return *instance;
+}
+
+const char* JobScheduler::getJobClassName(JobClass jobClass) {
+    switch (jobClass) {
+        case AUDIO:
+            return "audio";
+        case BLENDSHAPE:
+            return "blendshape";
+        case GEOMETRY:
+            return "geometry";
+        case TEXTURE:
+            return "texture";
+        case BACKGROUND:
+            return "background";
+        default:
+            return "unknown";
+    }
+}
+
+JobScheduler::JobScheduler() :
+    _pool(&_threadPool) {
+    _queues[BLENDSHAPE].limit = DEFAULT_BLENDSHAPE_LIMIT;
+    _queues[BACKGROUND].limit = DEFAULT_BACKGROUND_LIMIT;
+}
+
+JobScheduler::~JobScheduler() {
+    clear();
+}
+
+void JobScheduler::submit(JobClass jobClass, QRunnable* runnable, PriorityOperator priority, CancelOperator isCancelled) {
+    Q_ASSERT(jobClass >= 0 && jobClass < NUM_JOB_CLASSES);
+    float cachedPriority = priority ? priority() : 0.0f;
+    {
+        Lock lock(_mutex);
+        auto& jobs = _queues[jobClass].jobs;
+        jobs.push_back({ runnable, std::move(priority), std::move(isCancelled), cachedPriority, usecTimestampNow(),
+                         _nextSequence++ });
+        std::push_heap(jobs.begin(), jobs.end(), isLowerPriority);
+    }
+    dispatch();
+}
+
+void JobScheduler::submit(JobClass jobClass, Job job, PriorityOperator priority, CancelOperator isCancelled) {
+    submit(jobClass, new FunctionRunnable(std::move(job)), std::move(priority), std::move(isCancelled));
+}
+
+void JobScheduler::setConcurrencyLimit(JobClass jobClass, int limit) {
+    {
+        Lock lock(_mutex);
+        _queues[jobClass].limit = std::max(limit, 0);
+    }
+    dispatch();
+}
+
+int JobScheduler::getConcurrencyLimit(JobClass jobClass) const {
+    Lock lock(_mutex);
+    return _queues[jobClass].limit;
+}
+
+void JobScheduler::setMaxThreadCount(int maxThreadCount) {
+    {
+        Lock lock(_mutex);
+        _threadPool.setMaxThreadCount(std::max(maxThreadCount, 1));
+    }
+    dispatch();
+}
+
+int JobScheduler::getMaxThreadCount() const {
+    Lock lock(_mutex);
+    return _threadPool.maxThreadCount();
+}
+
+void JobScheduler::setThreadPool(QThreadPool* pool) {
+    Lock lock(_mutex);
+    _pool = pool;
+}
+
+JobScheduler::Stats JobScheduler::getStats(JobClass jobClass) {
+    Lock lock(_mutex);
+    auto& queue = _queues[jobClass];
+    Stats stats;
+    stats.queued = (int)queue.jobs.size();
+    stats.running = queue.running;
+    stats.averageWaitUsecs = queue.averageWaitUsecs;
+    stats.maxWaitUsecs = queue.maxWaitUsecs;
+    queue.maxWaitUsecs = 0;
+    return stats;
+}
+
+int JobScheduler::getNumQueuedJobs() const {
+    Lock lock(_mutex);
+    int numQueued = 0;
+    for (const auto& queue : _queues) {
+        numQueued += (int)queue.jobs.size();
+    }
+    return numQueued;
+}
+
+int JobScheduler::getNumRunningJobs() const {
+    Lock lock(_mutex);
+    return _numRunning;
+}
+
+quint64 JobScheduler::getAverageWaitTime() const {
+    Lock lock(_mutex);
+    quint64 longest = 0;
+    for (const auto& queue : _queues) {
+        longest = std::max(longest, queue.averageWaitUsecs);
+    }
+    return longest;
+}
+
+void JobScheduler::clear() {
+    std::vector<PendingJob> dropped;
+    {
+        Lock lock(_mutex);
+        for (auto& queue : _queues) {
+            std::move(queue.jobs.begin(), queue.jobs.end(), std::back_inserter(dropped));
+            queue.jobs.clear();
+        }
+        if (isIdle()) {
+            _doneCondition.notify_all();
+        }
+    }
+    for (auto& job : dropped) {
+        drop(job);
+    }
+    updateCounters();
+}
+
+bool JobScheduler::isIdle() const {
+    if (_numRunning > 0) {
+        return false;
+    }
+    for (const auto& queue : _queues) {
+        if (!queue.jobs.empty()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool JobScheduler::waitForDone(int msecs) {
+    Lock lock(_mutex);
+    auto isDone = [this] { return isIdle(); };
+    if (msecs < 0) {
+        _doneCondition.wait(lock, isDone);
+        return true;
+    }
+    return _doneCondition.wait_for(lock, std::chrono::milliseconds(msecs), isDone);
+}
+
+void JobScheduler::drop(PendingJob& job) {
+    if (job.runnable->autoDelete()) {
+        delete job.runnable;
+    }
+    job.runnable = nullptr;
+}
+
+int JobScheduler::getEffectiveLimit(const JobQueue& queue, int poolSize) const {
+    if (queue.limit > 0) {
+        return std::min(queue.limit, poolSize);
+    }
+    return std::max(poolSize - 1, 1);
+}
+
+bool JobScheduler::isLowerPriority(const PendingJob& a, const PendingJob& b) {
+    if (a.cachedPriority != b.cachedPriority) {
+        return a.cachedPriority < b.cachedPriority;
+    }
+    return a.sequence > b.sequence;
+}
+
+void JobScheduler::reprioritize(quint64 now, std::vector<PendingJob>& cancelled) {
+    _lastReprioritize = now;
+    for (auto& queue : _queues) {
+        auto& jobs = queue.jobs;
+        size_t kept = 0;
+        for (size_t i = 0; i < jobs.size(); i++) {
+            if (jobs[i].isCancelled && jobs[i].isCancelled()) {
+                cancelled.push_back(std::move(jobs[i]));
+                continue;
+            }
+            if (jobs[i].priority) {
+                jobs[i].cachedPriority = jobs[i].priority();
+            }
+            if (kept != i) {
+                jobs[kept] = std::move(jobs[i]);
+            }
+            kept++;
+        }
+        jobs.erase(jobs.begin() + kept, jobs.end());
+        std::make_heap(jobs.begin(), jobs.end(), isLowerPriority);
+    }
+}
+
+void JobScheduler::dispatch() {
+    std::vector<PendingJob> cancelled;
+    std::vector<QRunnable*> started;
+    {
+        Lock lock(_mutex);
+        int poolSize = std::max(_pool->maxThreadCount(), 1);
+        quint64 now = usecTimestampNow();
+        if (now - _lastReprioritize > REPRIORITIZE_INTERVAL_USECS) {
+            reprioritize(now, cancelled);
+        }
+
+        for (int c = 0; c < NUM_JOB_CLASSES && _numRunning < poolSize; c++) {
+            auto& queue = _queues[c];
+            int limit = getEffectiveLimit(queue, poolSize);
+            while (!queue.jobs.empty() && queue.running < limit && _numRunning < poolSize) {
+                // the highest priority, and the oldest of equals
+                std::pop_heap(queue.jobs.begin(), queue.jobs.end(), isLowerPriority);
+                PendingJob job = std::move(queue.jobs.back());
+                queue.jobs.pop_back();
+
+                if (job.isCancelled && job.isCancelled()) {
+                    cancelled.push_back(std::move(job));
+                    continue;
+                }
+
+                qint64 wait = (qint64)(now - std::min(now, job.submitTime));
+                qint64 average = (qint64)queue.averageWaitUsecs;
+                queue.averageWaitUsecs = (quint64)(average + (wait - average) / WAIT_TIME_AVERAGE_JOBS);
+                queue.maxWaitUsecs = std::max(queue.maxWaitUsecs, (quint64)wait);
+
+                queue.running++;
+                _numRunning++;
+                started.push_back(new JobRunner(this, (JobClass)c, job.runnable));
+            }
+        }
+
+        if (isIdle()) {
+            _doneCondition.notify_all();
+        }
+    }
+
+    // outside of the lock, since a job may finish before start() returns
+    for (auto runner : started) {
+        _pool->start(runner);
+    }
+    for (auto& job : cancelled) {
+        drop(job);
+    }
+    updateCounters();
+}
+
+void JobScheduler::jobFinished(JobClass jobClass) {
+    {
+        Lock lock(_mutex);
+        _queues[jobClass].running--;
+        _numRunning--;
+    }
+    dispatch();
+}
+
+void JobScheduler::updateCounters() {
+    if (!trace_resource().isDebugEnabled()) {
+        return;
+    }
+
+    QVariantMap queued;
+    QVariantMap running;
+    {
+        Lock lock(_mutex);
+        for (int c = 0; c < NUM_JOB_CLASSES; c++) {
+            queued[getJobClassName((JobClass)c)] = (int)_queues[c].jobs.size();
+            running[getJobClassName((JobClass)c)] = _queues[c].running;
+        }
+    }
+    PROFILE_COUNTER(resource, "JobSchedulerQueued", queued);
+    PROFILE_COUNTER(resource, "JobSchedulerRunning", running);
+}
@@ -0,0 +1,136 @@
+//
+//  JobScheduler.h
+//  libraries/shared/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_JobScheduler_h
+#define hifi_JobScheduler_h
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+#include <QtCore/QRunnable>
+#include <QtCore/QThreadPool>
+
+// Schedules background work onto a thread pool by class and priority.
+//
+// Jobs wait in per-class queues rather than in a pool of its own, so that the most important work is started
+// each time a thread becomes free: the highest class first, and within a class the job with the highest
+// priority. Each class has a concurrency limit, so a flood of one kind of work (e.g. texture decoding
+// during a domain load) can never occupy every thread. Jobs whose cancel operator returns true are
+// dropped without running.
+class JobScheduler {
+public:
+    // in order of precedence
+    enum JobClass {
+        AUDIO = 0,      // audio device and injector work, which is latency sensitive
+        BLENDSHAPE,     // model blending
+        GEOMETRY,       // model parsing
+        TEXTURE,        // image decoding and ktx processing
+        BACKGROUND,     // work that can wait, e.g. key generation
+        NUM_JOB_CLASSES
+    };
+
+    using Job = std::function<void()>;
+    using PriorityOperator = std::function<float()>;
+    using CancelOperator = std::function<bool()>;
+
+    struct Stats {
+        int queued { 0 };
+        int running { 0 };
+        quint64 averageWaitUsecs { 0 };
+        quint64 maxWaitUsecs { 0 };         // since the last call to getStats()
+    };
+
+    static JobScheduler& getInstance();
+    static const char* getJobClassName(JobClass jobClass);
+
+    JobScheduler();
+    ~JobScheduler();
+
+    // priority and isCancelled, when given, are called from whichever thread dispatches, and should be cheap.
+    // as with QThreadPool::start(), a runnable that autoDelete()s is deleted once run or dropped.
+    void submit(JobClass jobClass, QRunnable* runnable,
+                PriorityOperator priority = nullptr, CancelOperator isCancelled = nullptr);
+    void submit(JobClass jobClass, Job job,
+                PriorityOperator priority = nullptr, CancelOperator isCancelled = nullptr);
+
+    // the most jobs of a class to run at once. 0 allows all but one thread of the pool, leaving room
+    // for the other classes.
+    void setConcurrencyLimit(JobClass jobClass, int limit);
+    int getConcurrencyLimit(JobClass jobClass) const;
+
+    // the size of the scheduler's own pool, which is kept apart from QThreadPool::globalInstance() so that
+    // other users of the global pool can neither starve the scheduled jobs nor be starved by them
+    void setMaxThreadCount(int maxThreadCount);
+    int getMaxThreadCount() const;
+
+    // the pool to run on instead of the scheduler's own, e.g. for tests
+    void setThreadPool(QThreadPool* pool);
+
+    Stats getStats(JobClass jobClass);
+    int getNumQueuedJobs() const;
+    int getNumRunningJobs() const;
+    quint64 getAverageWaitTime() const;   // usecs, the longest of the per-class averages
+
+    // drop all queued jobs; jobs already running are unaffected
+    void clear();
+
+    // wait until every job has either run or been dropped, with no timeout when msecs < 0
+    bool waitForDone(int msecs = -1);
+
+private:
+    class JobRunner;
+
+    struct PendingJob {
+        QRunnable* runnable;
+        PriorityOperator priority;
+        CancelOperator isCancelled;
+        float cachedPriority;
+        quint64 submitTime;
+        uint64_t sequence;
+    };
+
+    // Each queue is a binary heap on the cached priorities, and the oldest of equals, so that the next job is
+    // taken in O(log N). Priorities are only ever re-evaluated all together, after which the heap is rebuilt in
+    // O(N), so unlike the resource cache's heap this one needs no index of where each job is.
+    struct JobQueue {
+        std::vector<PendingJob> jobs;
+        int limit { 0 };
+        int running { 0 };
+        quint64 averageWaitUsecs { 0 };
+        quint64 maxWaitUsecs { 0 };
+    };
+
+    static bool isLowerPriority(const PendingJob& a, const PendingJob& b);
+
+    void dispatch();
+    void jobFinished(JobClass jobClass);
+    bool isIdle() const;
+    void drop(PendingJob& job);
+    void reprioritize(quint64 now, std::vector<PendingJob>& cancelled);
+    int getEffectiveLimit(const JobQueue& queue, int poolSize) const;
+    void updateCounters();
+
+    using Mutex = std::mutex;
+    using Lock = std::unique_lock<Mutex>;
+    mutable Mutex _mutex;
+    std::condition_variable _doneCondition;
+    JobQueue _queues[NUM_JOB_CLASSES];
+    QThreadPool* _pool;
+    int _numRunning { 0 };
+    quint64 _lastReprioritize { 0 };
+    uint64_t _nextSequence { 0 };
+
+    // last, so that it is destroyed first, waiting for the running jobs while the rest is still valid
+    QThreadPool _threadPool;
+};
+
+#endif // hifi_JobScheduler_h
@@ -14,6 +14,7 @@
 #include <QUuid>
 
 #include "PhysicsCollisionGroups.h"
+#include "SimulationFlags.h"
 
 // This chunk of code was copied from Bullet-2.82, so we include the Bullet license here:
 /*
@@ -98,3 +99,13 @@ const QUuid& Physics::getSessionUUID() {
     return _sessionID;
 }
 
+static uint8_t _volunteerPriority = VOLUNTEER_SIMULATION_PRIORITY;
+
+void Physics::setVolunteerPriority(uint8_t priority) {
+    _volunteerPriority = priority;
+}
+
+uint8_t Physics::getVolunteerPriority() {
+    return _volunteerPriority;
+}
+
@@ -36,6 +36,10 @@ namespace Physics {
 
     void setSessionUUID(const QUuid& sessionID);
     const QUuid& getSessionUUID();
+
+    // the priority at which this participant bids for active objects it isn't otherwise interested in
+    void setVolunteerPriority(uint8_t priority);
+    uint8_t getVolunteerPriority();
 };
 
 #endif // hifi_PhysicsHelpers_h
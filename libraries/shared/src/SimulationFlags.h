@@ -16,6 +16,10 @@ const uint8_t YIELD_SIMULATION_PRIORITY = 1;
 const uint8_t VOLUNTEER_SIMULATION_PRIORITY = YIELD_SIMULATION_PRIORITY + 1;
 const uint8_t RECRUIT_SIMULATION_PRIORITY = VOLUNTEER_SIMULATION_PRIORITY + 1;
 
+// a headless physics host volunteers just above the clients' RECRUIT, so it keeps the objects
+// nobody is interacting with, but loses them to any grab, poke or avatar collision
+const uint8_t HOST_SIMULATION_PRIORITY = RECRUIT_SIMULATION_PRIORITY + 1;
+
 const uint8_t SCRIPT_GRAB_SIMULATION_PRIORITY = 128;
 const uint8_t SCRIPT_POKE_SIMULATION_PRIORITY = SCRIPT_GRAB_SIMULATION_PRIORITY - 1;
 
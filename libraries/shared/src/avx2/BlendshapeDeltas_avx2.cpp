@@ -0,0 +1,31 @@
+//
+//  BlendshapeDeltas_avx2.cpp
+//  libraries/shared/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifdef __AVX2__
+
+#include <immintrin.h>
+
+//
+// Scatter-add the weighted deltas of one blendshape into the offsets of their vertices.
+// Each delta is 9 floats: the first 8 go through one register, the tangent z is done separately.
+//
+void accumulateDeltas_AVX2(const int* indices, const float (*deltas)[9], int numDeltas, float coefficient, float (*offsets)[9]) {
+    const __m256 c = _mm256_set1_ps(coefficient);
+
+    for (int j = 0; j < numDeltas; j++) {
+        float* offset = offsets[indices[j]];
+        _mm256_storeu_ps(&offset[0], _mm256_fmadd_ps(_mm256_loadu_ps(&deltas[j][0]), c, _mm256_loadu_ps(&offset[0])));
+        offset[8] += deltas[j][8] * coefficient;
+    }
+
+    _mm256_zeroupper();
+}
+
+#endif
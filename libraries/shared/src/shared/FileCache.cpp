@@ -13,9 +13,13 @@
 
 
 #include <unordered_set>
-#include <queue>
+#include <algorithm>
+#include <condition_variable>
 #include <cassert>
+#include <list>
+#include <thread>
 
+#include <QtCore/QDataStream>
 #include <QtCore/QDateTime>
 #include <QtCore/QDir>
 #include <QtCore/QSaveFile>
@@ -40,10 +44,32 @@ using namespace cache;
 static const char DIR_SEP = '/';
 static const char EXT_SEP = '.';
 
+static const char* INDEX_FILENAME = "filecache.idx";
+static const quint32 INDEX_MAGIC = 0x58444946; // "FIDX"
+static const quint32 INDEX_VERSION = 1;
+
 const size_t FileCache::DEFAULT_MAX_SIZE { GB_TO_BYTES(5) };
 const size_t FileCache::MAX_MAX_SIZE { GB_TO_BYTES(100) };
 const size_t FileCache::DEFAULT_MIN_FREE_STORAGE_SPACE { GB_TO_BYTES(1) };
-
+const size_t FileCache::MAX_PENDING_WRITE_BYTES { 64 * 1024 * 1024 };
+const int FileCache::DEFAULT_RESCAN_INTERVAL_MSECS { (int)(10 * MSECS_PER_SECOND) };
+
+// a shared directory is rescanned regardless of the interval once the files known to the cache take this much of it
+static const float RESCAN_SIZE_FRACTION { 0.9f };
+
+// The state shared between a cache and its background thread.  The thread only holds a weak reference to the cache,
+// and may end up dropping the last one, in which case this has to outlive the cache until the thread exits.
+struct FileCache::Worker {
+    std::mutex mutex;
+    std::condition_variable condition;
+    std::condition_variable idleCondition;
+    std::list<PendingWrite> pendingWrites;
+    size_t pendingWriteBytes { 0 };
+    bool cleanRequested { false };
+    bool busy { false };
+    bool stopping { false };
+    std::thread thread;
+};
 
 std::string getCacheName(const std::string& dirname_str) {
     QString dirname { dirname_str.c_str() };
@@ -63,6 +89,13 @@ std::string getCachePath(const std::string& dirname_str) {
     return PathUtils::getAppLocalDataFilePath(dirname).toStdString();
 }
 
+static bool saveToDisk(const std::string& filepath, const char* data, size_t length) {
+    QSaveFile saveFile(QString::fromStdString(filepath));
+    return saveFile.open(QIODevice::WriteOnly)
+        && saveFile.write(data, length) == static_cast<qint64>(length)
+        && saveFile.commit();
+}
+
 void FileCache::setMinFreeSize(size_t size) {
     _minFreeSpaceSize = size;
     clean();
@@ -83,6 +116,7 @@ FileCache::FileCache(const std::string& dirname, const std::string& ext, QObject
 }
 
 FileCache::~FileCache() {
+    stopWorker();
     clear();
 }
 
@@ -92,51 +126,113 @@ void FileCache::initialize() {
         qCWarning(file_cache) << "File cache already initialized";
         return;
     }
+    _weakSelf = shared_from_this();
 
     QDir dir(_dirpath.c_str());
 
     if (dir.exists()) {
-        auto nameFilters = QStringList(("*." + _ext).c_str());
-        auto filters = QDir::Filters(QDir::NoDotAndDotDot | QDir::Files);
-        auto sort = QDir::SortFlags(QDir::Time);
-        auto files = dir.entryList(nameFilters, filters, sort);
-
-        // load persisted files
-        foreach(QString filename, files) {
-            const Key key = filename.section('.', 0, 0).toStdString();
-            const std::string filepath = dir.filePath(filename).toStdString();
-            const size_t length = QFileInfo(filepath.c_str()).size();
-            addFile(Metadata(key, length), filepath);
-        }
+        if (_warmStartEnabled && !_sharedDirectory && loadIndex()) {
+            qCDebug(file_cache, "[%s] Initialized %s from its index", _dirname.c_str(), _dirpath.c_str());
+        } else {
+            auto nameFilters = QStringList(("*." + _ext).c_str());
+            auto filters = QDir::Filters(QDir::NoDotAndDotDot | QDir::Files);
+            auto sort = QDir::SortFlags(QDir::Time);
+            auto files = dir.entryInfoList(nameFilters, filters, sort);
+
+            // load persisted files
+            foreach(const QFileInfo& info, files) {
+                const Key key = info.fileName().section('.', 0, 0).toStdString();
+                const std::string filepath = info.filePath().toStdString();
+                addFile(Metadata(key, info.size()), filepath, false, info.lastRead().toMSecsSinceEpoch());
+            }
 
-        qCDebug(file_cache, "[%s] Initialized %s", _dirname.c_str(), _dirpath.c_str());
+            qCDebug(file_cache, "[%s] Initialized %s", _dirname.c_str(), _dirpath.c_str());
+        }
     } else {
         dir.mkpath(_dirpath.c_str());
         qCDebug(file_cache, "[%s] Created %s", _dirname.c_str(), _dirpath.c_str());
     }
 
+    _worker = std::make_shared<Worker>();
+    _worker->thread = std::thread(&FileCache::runWorker, _worker, _weakSelf);
     _initialized = true;
+    requestClean();
 }
 
 std::unique_ptr<File> FileCache::createFile(Metadata&& metadata, const std::string& filepath) {
     return std::unique_ptr<File>(new cache::File(std::move(metadata), filepath));
 }
 
-FilePointer FileCache::addFile(Metadata&& metadata, const std::string& filepath) {
+FilePointer FileCache::addFile(Metadata&& metadata, const std::string& filepath, bool locked, int64_t modified) {
     File* rawFile = createFile(std::move(metadata), filepath).release();
     FilePointer file(rawFile, std::bind(&File::deleter, rawFile));
     if (file) {
-        _numTotalFiles += 1;
-        _totalFilesSize += file->getLength();
-        file->_parent = shared_from_this();
-        file->_locked = true;
+        file->_modified = modified;
+        file->_parent = _weakSelf;
+        file->_locked = locked;
+
+        const Key& key = file->getKey();
+        auto& shard = getShard(key);
+        // dropped once the shard is unlocked
+        std::vector<FilePointer> superseded;
+        {
+            Lock lock(shard.mutex);
+            if (0 == modified) {
+                // A file that was just written: evicting the entry it replaces would have unlinked it, so make sure it's still there
+                QFileInfo info(filepath.c_str());
+                if (!info.exists()) {
+                    qCWarning(file_cache, "[%s] Lost %s to an eviction", _dirname.c_str(), key.c_str());
+                    file->_locked = false;
+                    file->_shouldPersist = true;
+                    return FilePointer();
+                }
+                file->_modified = info.lastRead().toMSecsSinceEpoch();
+            }
+            supersede(shard, key, superseded);
+            _numTotalFiles += 1;
+            _totalFilesSize += file->getLength();
+            shard.files[key] = { file, file.get() };
+            if (!locked) {
+                shard.unusedFiles[key] = file;
+                _numUnusedFiles += 1;
+                _unusedFilesSize += file->getLength();
+            }
+        }
         emit dirty();
-
-        _files[file->getKey()] = file;
     }
     return file;
 }
 
+// Called with the shard locked, before a newly written file takes over the entry for its key
+void FileCache::supersede(Shard& shard, const Key& key, std::vector<FilePointer>& superseded) {
+    const auto it = shard.files.find(key);
+    if (it == shard.files.cend()) {
+        return;
+    }
+    FilePointer existing = it->second.file.lock();
+    if (!existing) {
+        // on its way back to the unused files, which it no longer belongs in
+        File* released = it->second.rawFile;
+        released->_shouldPersist = true;
+        _numTotalFiles -= 1;
+        _totalFilesSize -= released->getLength();
+        return;
+    }
+
+    // the new file has replaced this one on disk, so it must not be unlinked when it goes away
+    existing->_shouldPersist = true;
+    _numTotalFiles -= 1;
+    _totalFilesSize -= existing->getLength();
+    const auto unused = shard.unusedFiles.find(key);
+    if (unused != shard.unusedFiles.cend() && unused->second == existing) {
+        existing->_locked = false;
+        shard.unusedFiles.erase(unused);
+        _numUnusedFiles -= 1;
+        _unusedFilesSize -= existing->getLength();
+    }
+    superseded.push_back(std::move(existing));
+}
+
 FilePointer FileCache::writeFile(const char* data, File::Metadata&& metadata, bool overwrite) {
     FilePointer file;
 
@@ -145,9 +241,6 @@ FilePointer FileCache::writeFile(const char* data, File::Metadata&& metadata, bo
         return file;
     }
 
-
-    Lock lock(_mutex);
-
     if (!_initialized) {
         qCWarning(file_cache) << "File cache used before initialization";
         return file;
@@ -163,43 +256,89 @@ FilePointer FileCache::writeFile(const char* data, File::Metadata&& metadata, bo
             return file;
         } else {
             qCWarning(file_cache, "[%s] Overwriting %s", _dirname.c_str(), metadata.key.c_str());
-            file.reset();
         }
     }
 
-    QSaveFile saveFile(QString::fromStdString(filepath));
-    if (saveFile.open(QIODevice::WriteOnly)
-        && saveFile.write(data, metadata.length) == static_cast<qint64>(metadata.length)
-        && saveFile.commit()) {
-
+    // the write doesn't need any of the locks, since it goes to a temporary file and is renamed into place.
+    // The file it replaces stays in use until then, so that it can't be evicted, and unlink the new one
+    FilePointer replaced = std::move(file);
+    if (saveToDisk(filepath, data, metadata.length)) {
         file = addFile(std::move(metadata), filepath);
-    } else {
+        requestClean();
+    }
+    if (!file) {
         qCWarning(file_cache, "[%s] Failed to write %s", _dirname.c_str(), metadata.key.c_str());
     }
     assert(!file || (file->_locked && file->_parent.lock()));
     return file;
 }
 
+void FileCache::writeFileAsync(QByteArray data, Metadata&& metadata, bool overwrite) {
+    if (0 == metadata.length) {
+        qCWarning(file_cache) << "Cannot store empty files in the cache";
+        return;
+    }
 
-FilePointer FileCache::getFile(const Key& key) {
-    Lock lock(_mutex);
+    if (!_initialized) {
+        qCWarning(file_cache) << "File cache used before initialization";
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(_worker->mutex);
+        if (_worker->pendingWriteBytes + data.size() <= MAX_PENDING_WRITE_BYTES) {
+            _worker->pendingWriteBytes += data.size();
+            _worker->pendingWrites.push_back({ std::move(data), std::move(metadata), overwrite });
+            _worker->condition.notify_one();
+            return;
+        }
+    }
+
+    // the disk isn't keeping up, so rather than buffer any more, write this one on the caller's thread
+    writeFile(data.constData(), std::move(metadata), overwrite);
+}
+
+void FileCache::commitWrite(PendingWrite& write) {
+    const Key key = write.metadata.key;
+    // as in writeFile, keep the file being replaced in use until the new one takes over
+    FilePointer replaced = getFile(key);
+    if (replaced && !write.overwrite) {
+        qCWarning(file_cache, "[%s] Attempted to overwrite %s", _dirname.c_str(), key.c_str());
+        return;
+    }
+
+    std::string filepath = getFilepath(key);
+    if (saveToDisk(filepath, write.data.constData(), write.metadata.length) &&
+            addFile(std::move(write.metadata), filepath, false)) {
+        requestClean();
+    } else {
+        qCWarning(file_cache, "[%s] Failed to write %s", _dirname.c_str(), key.c_str());
+    }
+}
 
+FilePointer FileCache::getFile(const Key& key) {
     FilePointer file;
     if (!_initialized) {
         qCWarning(file_cache) << "File cache used before initialization";
         return file;
     }
 
+    auto& shard = getShard(key);
+    Lock lock(shard.mutex);
+
     // check if file exists
-    const auto it = _files.find(key);
-    if (it != _files.cend()) {
-        file = it->second.lock();
+    const auto it = shard.files.find(key);
+    if (it != shard.files.cend()) {
+        // if it's being released, it's a miss until it's back among the unused files
+        file = it->second.file.lock();
         if (file) {
             file->touch();
             // if it exists, it is active - remove it from the cache
-            if (_unusedFiles.erase(file)) {
+            const auto unused = shard.unusedFiles.find(key);
+            if (unused != shard.unusedFiles.cend() && unused->second == file) {
                 assert(!file->_locked);
                 file->_locked = true;
+                shard.unusedFiles.erase(unused);
                 _numUnusedFiles -= 1;
                 _unusedFilesSize -= file->getLength();
             } else {
@@ -207,30 +346,83 @@ FilePointer FileCache::getFile(const Key& key) {
             }
             qCDebug(file_cache, "[%s] Found %s", _dirname.c_str(), key.c_str());
             emit dirty();
-        } else {
-            // if not, remove the weak_ptr
-            _files.erase(it);
         }
+    } else if (_sharedDirectory) {
+        // it may have been written by another process
+        file = adoptFile(key);
     }
 
     assert(!file || (file->_locked && file->_parent.lock()));
     return file;
 }
 
+// Called with the shard locked, for a key it has no entry for
+FilePointer FileCache::adoptFile(const Key& key) {
+    std::string filepath = getFilepath(key);
+    QFileInfo info(filepath.c_str());
+    if (!info.exists() || 0 == info.size()) {
+        return FilePointer();
+    }
+    FilePointer file = addFile(Metadata(key, info.size()), filepath, true, info.lastRead().toMSecsSinceEpoch());
+    if (file) {
+        file->touch();
+        qCDebug(file_cache, "[%s] Adopted %s", _dirname.c_str(), key.c_str());
+        requestClean();
+    }
+    return file;
+}
+
+// Called while evicting from a shared directory, to count the files other processes have written to it.
+// Entries for the files they have evicted stay until they are evicted here too, which costs nothing
+void FileCache::rescan() {
+    _lastRescan = QDateTime::currentMSecsSinceEpoch();
+    auto nameFilters = QStringList(("*." + _ext).c_str());
+    auto files = QDir(_dirpath.c_str()).entryInfoList(nameFilters, QDir::Filters(QDir::NoDotAndDotDot | QDir::Files));
+    foreach(const QFileInfo& info, files) {
+        const Key key = info.fileName().section('.', 0, 0).toStdString();
+        auto& shard = getShard(key);
+        Lock lock(shard.mutex);
+        if (shard.files.find(key) == shard.files.cend()) {
+            addFile(Metadata(key, info.size()), info.filePath().toStdString(), false, info.lastRead().toMSecsSinceEpoch());
+        }
+    }
+}
+
+bool FileCache::isRescanDue() const {
+    if (QDateTime::currentMSecsSinceEpoch() - _lastRescan >= _rescanIntervalMsecs) {
+        return true;
+    }
+    return _totalFilesSize >= (size_t)(RESCAN_SIZE_FRACTION * _maxSize);
+}
+
+void FileCache::flush() {
+    if (!_worker) {
+        return;
+    }
+    std::unique_lock<std::mutex> lock(_worker->mutex);
+    _worker->idleCondition.wait(lock, [&] {
+        return _worker->stopping || (_worker->pendingWrites.empty() && !_worker->cleanRequested && !_worker->busy);
+    });
+}
+
 std::string FileCache::getFilepath(const Key& key) {
     return _dirpath + DIR_SEP + key + EXT_SEP + _ext;
 }
 
-// This is a non-public function that uses the mutex because it's 
-// essentially a public function specifically to a File object
-void FileCache::addUnusedFile(const FilePointer& file) {
+std::string FileCache::getIndexFilepath() const {
+    return _dirpath + DIR_SEP + INDEX_FILENAME;
+}
+
+// Called with the shard locked, by releaseFile
+void FileCache::addUnusedFile(Shard& shard, const FilePointer& file) {
     assert(file->_locked);
     file->_locked = false;
-    _files[file->getKey()] = file;
-    _unusedFiles.insert(file);
+    const Key& key = file->getKey();
+    shard.files[key] = { file, file.get() };
+    shard.unusedFiles[key] = file;
     _numUnusedFiles += 1;
     _unusedFilesSize += file->getLength();
-    clean();
+    requestClean();
 
     emit dirty();
 }
@@ -250,31 +442,39 @@ size_t FileCache::getOverbudgetAmount() const {
     return result;
 }
 
-namespace cache {
-    struct FilePointerComparator {
-        bool operator()(const FilePointer& a, const FilePointer& b) {
-            return a->_modified > b->_modified;
-        }
-    };
-}
-
-// Take file pointer by value to insure it doesn't get destructed during the "erase()" calls
-void FileCache::eject(FilePointer file) {
+// Called with the shard locked.  The caller should drop the file before unlocking it, so that it gets unlinked
+// before a new file for the same key can be registered
+void FileCache::eject(Shard& shard, const FilePointer& file) {
     file->_locked = false;
     const auto& length = file->getLength();
     const auto& key = file->getKey();
 
-    if (0 != _files.erase(key)) {
+    if (0 != shard.unusedFiles.erase(key)) {
+        _numUnusedFiles -= 1;
+        _unusedFilesSize -= length;
+    }
+    if (0 != shard.files.erase(key)) {
         _numTotalFiles -= 1;
         _totalFilesSize -= length;
     }
-    if (0 != _unusedFiles.erase(file)) {
-        _numUnusedFiles -= 1;
-        _unusedFilesSize -= length;
+}
+
+void FileCache::requestClean() {
+    // before initialize() there is nothing to evict, and during shutdown clear() takes care of it
+    if (!_worker) {
+        return;
     }
+    std::lock_guard<std::mutex> lock(_worker->mutex);
+    _worker->cleanRequested = true;
+    _worker->condition.notify_one();
 }
 
 void FileCache::clean() {
+    // one eviction pass at a time
+    Lock lock(_mutex);
+    if (_sharedDirectory && isRescanDue()) {
+        rescan();
+    }
     size_t overbudgetAmount = getOverbudgetAmount();
 
     // Avoid sorting the unused files by LRU if we're not over budget / under free space
@@ -282,25 +482,52 @@ void FileCache::clean() {
         return;
     }
 
-    using Queue = std::priority_queue<FilePointer, std::vector<FilePointer>, FilePointerComparator>;
-    Queue queue;
-    for (const auto& file : _unusedFiles) {
-        queue.push(file);
+    // Gather the unused files, one shard at a time, and order them least recently used first
+    struct Candidate {
+        Key key;
+        int64_t modified;
+    };
+    std::vector<Candidate> candidates;
+    for (auto& shard : _shards) {
+        Lock shardLock(shard.mutex);
+        for (const auto& entry : shard.unusedFiles) {
+            candidates.push_back({ entry.first, entry.second->_modified });
+        }
+    }
+    std::sort(candidates.begin(), candidates.end(), [](const Candidate& a, const Candidate& b) {
+        return a.modified < b.modified;
+    });
+
+    size_t numEjected = 0;
+    for (const auto& candidate : candidates) {
+        if (0 == overbudgetAmount) {
+            break;
+        }
+        auto& shard = getShard(candidate.key);
+        Lock shardLock(shard.mutex);
+        // skip the files that were picked up (or replaced) since they were gathered
+        const auto it = shard.unusedFiles.find(candidate.key);
+        if (it == shard.unusedFiles.cend() || it->second->_modified != candidate.modified) {
+            continue;
+        }
+        FilePointer file = it->second;
+        eject(shard, file);
+        overbudgetAmount -= std::min(file->getLength(), overbudgetAmount);
+        ++numEjected;
     }
 
-    while (!queue.empty() && overbudgetAmount > 0) {
-        auto file = queue.top();
-        queue.pop();
-        eject(file);
-        auto length = file->getLength();
-        overbudgetAmount -= std::min(length, overbudgetAmount);
+    if (numEjected > 0) {
+        emit dirty();
     }
 }
 
 void FileCache::wipe() {
-    Lock lock(_mutex);
-    while (!_unusedFiles.empty()) {
-        eject(*_unusedFiles.begin());
+    for (auto& shard : _shards) {
+        Lock lock(shard.mutex);
+        while (!shard.unusedFiles.empty()) {
+            FilePointer file = shard.unusedFiles.begin()->second;
+            eject(shard, file);
+        }
     }
 }
 
@@ -310,25 +537,208 @@ void FileCache::clear() {
     // Eliminate any overbudget files
     clean();
 
+    saveIndex();
+
     // Mark everything remaining as persisted while effectively ejecting from the cache
-    for (auto& file : _unusedFiles) {
-        file->_shouldPersist = true;
-        file->_parent.reset();
-        qCDebug(file_cache, "[%s] Persisting %s", _dirname.c_str(), file->getKey().c_str());
+    for (auto& shard : _shards) {
+        Lock shardLock(shard.mutex);
+        for (auto& entry : shard.unusedFiles) {
+            auto& file = entry.second;
+            file->_shouldPersist = true;
+            file->_parent.reset();
+            qCDebug(file_cache, "[%s] Persisting %s", _dirname.c_str(), file->getKey().c_str());
+        }
+        shard.unusedFiles.clear();
+    }
+}
+
+bool FileCache::loadIndex() {
+    QFile indexFile(getIndexFilepath().c_str());
+    if (!indexFile.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    QDataStream stream(&indexFile);
+    quint32 magic { 0 };
+    quint32 version { 0 };
+    qint64 dirModified { 0 };
+    quint32 count { 0 };
+    stream >> magic >> version >> dirModified >> count;
+    if (stream.status() != QDataStream::Ok || magic != INDEX_MAGIC || version != INDEX_VERSION) {
+        return false;
+    }
+    // any file created or removed since the index was saved, by a crashed session or another process, makes it stale
+    if (QFileInfo(_dirpath.c_str()).lastModified().toMSecsSinceEpoch() != dirModified) {
+        qCDebug(file_cache, "[%s] Ignoring stale index", _dirname.c_str());
+        return false;
+    }
+
+    struct Entry {
+        QByteArray key;
+        quint64 length;
+        qint64 modified;
+    };
+    std::vector<Entry> entries;
+    for (quint32 i = 0; i < count; ++i) {
+        Entry entry;
+        stream >> entry.key >> entry.length >> entry.modified;
+        if (stream.status() != QDataStream::Ok) {
+            qCWarning(file_cache, "[%s] Truncated index, rescanning", _dirname.c_str());
+            return false;
+        }
+        entries.push_back(entry);
+    }
+
+    // the directory time only changes as often as the filesystem's timestamps tick, so also check that the files
+    // are still there as they were written. this stats each file, but still spares reading the directory
+    std::vector<std::string> filepaths;
+    filepaths.reserve(entries.size());
+    for (auto& entry : entries) {
+        std::string filepath = getFilepath(entry.key.toStdString());
+        QFileInfo fileInfo(filepath.c_str());
+        if (!fileInfo.exists() || (quint64)fileInfo.size() != entry.length) {
+            qCDebug(file_cache, "[%s] Ignoring stale index", _dirname.c_str());
+            return false;
+        }
+        filepaths.push_back(std::move(filepath));
+    }
+
+    for (size_t i = 0; i < entries.size(); ++i) {
+        addFile(Metadata(entries[i].key.toStdString(), (size_t)entries[i].length), filepaths[i], false, entries[i].modified);
+    }
+    return true;
+}
+
+void FileCache::saveIndex() {
+    if (!_warmStartEnabled || _sharedDirectory || !_initialized) {
+        return;
+    }
+
+    struct Entry {
+        Key key;
+        size_t length;
+        int64_t modified;
+    };
+    std::vector<Entry> entries;
+    for (auto& shard : _shards) {
+        Lock lock(shard.mutex);
+        for (const auto& entry : shard.files) {
+            auto file = entry.second.file.lock();
+            if (file) {
+                entries.push_back({ file->getKey(), file->getLength(), file->_modified });
+            }
+        }
+    }
+
+    // Written in place rather than through a QSaveFile, and stamped with the directory time once it's open:
+    // renaming it into place would touch the directory afterwards, and make it look stale on the next start
+    QFile indexFile(getIndexFilepath().c_str());
+    if (!indexFile.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qCWarning(file_cache, "[%s] Failed to save the index", _dirname.c_str());
+        return;
+    }
+    qint64 dirModified = QFileInfo(_dirpath.c_str()).lastModified().toMSecsSinceEpoch();
+    QDataStream stream(&indexFile);
+    stream << INDEX_MAGIC << INDEX_VERSION << dirModified << (quint32)entries.size();
+    for (const auto& entry : entries) {
+        stream << QByteArray::fromStdString(entry.key) << (quint64)entry.length << (qint64)entry.modified;
+    }
+}
+
+void FileCache::runWorker(WorkerPointer worker, FileCacheWeakPointer weakCache) {
+    std::unique_lock<std::mutex> lock(worker->mutex);
+    while (true) {
+        worker->condition.wait(lock, [&] {
+            return worker->stopping || worker->cleanRequested || !worker->pendingWrites.empty();
+        });
+        // whatever is still queued gets written by the cache itself as it shuts down
+        if (worker->stopping) {
+            break;
+        }
+
+        std::list<PendingWrite> writes;
+        if (!worker->pendingWrites.empty()) {
+            writes.splice(writes.begin(), worker->pendingWrites, worker->pendingWrites.begin());
+        }
+        bool shouldClean = worker->cleanRequested;
+        worker->cleanRequested = false;
+        worker->busy = true;
+        lock.unlock();
+
+        size_t writtenBytes = 0;
+        {
+            FileCachePointer cache = weakCache.lock();
+            if (cache) {
+                for (auto& write : writes) {
+                    writtenBytes += write.data.size();
+                    cache->commitWrite(write);
+                }
+                if (shouldClean) {
+                    cache->clean();
+                }
+                writes.clear();
+            }
+            // if this was the last reference, the cache is destroyed right here, so nothing below may touch it
+        }
+
+        lock.lock();
+        // put back the writes the cache didn't get to, so that it can finish them itself
+        worker->pendingWrites.splice(worker->pendingWrites.begin(), writes);
+        worker->pendingWriteBytes -= writtenBytes;
+        worker->busy = false;
+        if (worker->pendingWrites.empty() && !worker->cleanRequested) {
+            worker->idleCondition.notify_all();
+        }
+    }
+    worker->idleCondition.notify_all();
+}
+
+void FileCache::stopWorker() {
+    if (!_worker) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(_worker->mutex);
+        _worker->stopping = true;
+    }
+    _worker->condition.notify_all();
+    if (_worker->thread.get_id() == std::this_thread::get_id()) {
+        // the worker dropped the last reference to the cache, and exits as soon as this returns
+        _worker->thread.detach();
+    } else {
+        _worker->thread.join();
+    }
+
+    std::list<PendingWrite> writes;
+    {
+        std::lock_guard<std::mutex> lock(_worker->mutex);
+        writes.swap(_worker->pendingWrites);
+    }
+    _worker.reset();
+
+    for (auto& write : writes) {
+        commitWrite(write);
     }
-    _unusedFiles.clear();
 }
 
 void FileCache::releaseFile(File* file) {
-    Lock lock(_mutex);
-    if (file->_locked) {
-        addUnusedFile(FilePointer(file, std::bind(&File::deleter, file)));
+    auto& shard = getShard(file->getKey());
+    Lock lock(shard.mutex);
+    // a superseded file is no longer the entry for its key
+    if (file->_locked && !file->_shouldPersist) {
+        addUnusedFile(shard, FilePointer(file, std::bind(&File::deleter, file)));
     } else {
         delete file;
     }
 }
 
 void File::deleter(File* file) {
+    // An unlocked file has already been ejected from the cache, so there's nothing to hand back to it
+    if (!file->_locked) {
+        delete file;
+        return;
+    }
+
     // If the cache shut down before the file was destroyed, then we should leave the file alone (prevents crash on shutdown)
     FileCachePointer cache = file->_parent.lock();
     if (!cache) {
@@ -344,8 +754,7 @@ void File::deleter(File* file) {
 File::File(Metadata&& metadata, const std::string& filepath) :
     _key(std::move(metadata.key)),
     _length(metadata.length),
-    _filepath(filepath),
-    _modified(QFileInfo(_filepath.c_str()).lastRead().toMSecsSinceEpoch()) {
+    _filepath(filepath) {
 }
 
 File::~File() {
@@ -360,4 +769,3 @@ void File::touch() {
     utime(_filepath.c_str(), nullptr);
     _modified = std::max<int64_t>(QFileInfo(_filepath.c_str()).lastRead().toMSecsSinceEpoch(), _modified);
 }
-
@@ -10,6 +10,7 @@
 #ifndef hifi_FileCache_h
 #define hifi_FileCache_h
 
+#include <array>
 #include <atomic>
 #include <memory>
 #include <cstddef>
@@ -18,7 +19,9 @@
 #include <mutex>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
+#include <QByteArray>
 #include <QObject>
 #include <QLoggingCategory>
 
@@ -44,6 +47,8 @@ class FileCache : public QObject, public std::enable_shared_from_this<FileCache>
     static const size_t DEFAULT_MAX_SIZE;
     static const size_t MAX_MAX_SIZE;
     static const size_t DEFAULT_MIN_FREE_STORAGE_SPACE;
+    static const size_t MAX_PENDING_WRITE_BYTES;
+    static const int DEFAULT_RESCAN_INTERVAL_MSECS;
 
     friend class ::FileCacheTests;
 
@@ -69,6 +74,19 @@ public:
     // to free up more space, regardless of the cache max size
     void setMinFreeSize(size_t size);
 
+    // Save an index of the entries on shutdown, so that the next initialize() doesn't have to scan the directory.
+    // Must be set before initialize(); it is ignored for shared directories, whose entries the index would miss
+    void setWarmStartEnabled(bool enabled) { _warmStartEnabled = enabled; }
+
+    // For a directory that other processes write to as well: getFile() also finds the files they wrote since
+    // initialize(), and eviction rescans the directory first, so that the size limit applies to all of it.
+    // Must be set before initialize()
+    void setSharedDirectory(bool shared) { _sharedDirectory = shared; }
+
+    // In a shared directory, eviction rescans it at most this often, unless what this cache knows of is already
+    // near the size limit, so that frequent writes don't each list the whole directory
+    void setRescanInterval(int msecs) { _rescanIntervalMsecs = msecs; }
+
     using Key = std::string;
     struct Metadata {
         Metadata(const Key& key, size_t length) :
@@ -97,29 +115,73 @@ public:
 
     // Add file to the cache and return the cache entry.  
     FilePointer writeFile(const char* data, Metadata&& metadata, bool overwrite = false);
+    // Queue a file to be written by the background thread, for callers that don't need the entry back.
+    // It can be found with getFile once it has been written.
+    void writeFileAsync(QByteArray data, Metadata&& metadata, bool overwrite = false);
     FilePointer getFile(const Key& key);
 
+    // Wait for the queued writes to land, and for the background eviction to catch up
+    void flush();
+
     /// create a file
     virtual std::unique_ptr<File> createFile(Metadata&& metadata, const std::string& filepath);
 
 private:
+    static const size_t NUM_SHARDS = 16;
+
     using Mutex = std::recursive_mutex;
     using Lock = std::unique_lock<Mutex>;
-    using Map = std::unordered_map<Key, std::weak_ptr<File>>;
-    using Set = std::unordered_set<FilePointer>;
+    // The weak pointer expires while the last user of a file is releasing it, until it's back among the unused files.
+    // The raw one stays valid until then, as a file in the index is only deleted once it has left it
+    struct Entry {
+        std::weak_ptr<File> file;
+        File* rawFile;
+    };
+    using Map = std::unordered_map<Key, Entry>;
+    using UnusedMap = std::unordered_map<Key, FilePointer>;
     using KeySet = std::unordered_set<Key>;
 
+    // The index is split by key into shards with their own locks, so that threads looking up
+    // different files don't contend with each other
+    struct Shard {
+        Mutex mutex;
+        Map files;
+        UnusedMap unusedFiles;
+    };
+
+    struct PendingWrite {
+        QByteArray data;
+        Metadata metadata;
+        bool overwrite;
+    };
+    struct Worker;
+    using WorkerPointer = std::shared_ptr<Worker>;
+
     friend class File;
 
     std::string getFilepath(const Key& key);
-
-    FilePointer addFile(Metadata&& metadata, const std::string& filepath);
-    void addUnusedFile(const FilePointer& file);
+    std::string getIndexFilepath() const;
+    Shard& getShard(const Key& key) { return _shards[std::hash<Key>()(key) % NUM_SHARDS]; }
+
+    FilePointer addFile(Metadata&& metadata, const std::string& filepath, bool locked = true, int64_t modified = 0);
+    FilePointer adoptFile(const Key& key);
+    void rescan();
+    bool isRescanDue() const;
+    void addUnusedFile(Shard& shard, const FilePointer& file);
+    void supersede(Shard& shard, const Key& key, std::vector<FilePointer>& superseded);
     void releaseFile(File* file);
+    void commitWrite(PendingWrite& write);
+    void requestClean();
     void clean();
     void clear();
     // Remove a file from the cache
-    void eject(FilePointer file);
+    void eject(Shard& shard, const FilePointer& file);
+
+    bool loadIndex();
+    void saveIndex();
+
+    static void runWorker(WorkerPointer worker, FileCacheWeakPointer cache);
+    void stopWorker();
 
     size_t getOverbudgetAmount() const;
 
@@ -135,11 +197,17 @@ private:
     const std::string _ext;
     const std::string _dirname;
     const std::string _dirpath;
-    bool _initialized { false };
-
+    std::atomic<bool> _initialized { false };
+    bool _warmStartEnabled { true };
+    bool _sharedDirectory { false };
+    std::atomic<int> _rescanIntervalMsecs { DEFAULT_RESCAN_INTERVAL_MSECS };
+    int64_t _lastRescan { 0 };
+    FileCacheWeakPointer _weakSelf;
+
+    // held while initializing and evicting, which walk all of the shards
     Mutex _mutex;
-    Map _files;
-    Set _unusedFiles;
+    std::array<Shard, NUM_SHARDS> _shards;
+    WorkerPointer _worker;
 };
 
 class File {
@@ -161,7 +229,6 @@ protected:
 
 private:
     friend class FileCache;
-    friend struct FilePointerComparator;
     friend class ::FileCacheTests;
 
     const Key _key;
@@ -11,6 +11,8 @@
 #include <QtCore/qlogging.h>
 #include <QtCore/QString>
 #include <QtCore/QByteArray>
+#include <QtCore/QDir>
+#include <QtCore/QProcessEnvironment>
 
 #if defined(Q_OS_WIN)
 #include <Windows.h>
@@ -37,4 +39,14 @@ void installTestMessageHandler() {
 bool downloadFile(const QString& file, const std::function<void(const QByteArray&)> handler) {
     FileDownloader(file, handler).waitForDownload();
     return true;
+}
+
+static const QString FBX_TEST_DIR_ENV = "HIFI_FBX_TEST_DIR";
+
+QFileInfoList getFBXTestFiles(const QStringList& nameFilters) {
+    QString path = QProcessEnvironment::systemEnvironment().value(FBX_TEST_DIR_ENV);
+    if (path.isEmpty()) {
+        return QFileInfoList();
+    }
+    return QDir(path).entryInfoList(nameFilters, QDir::Files);
 }
\ No newline at end of file
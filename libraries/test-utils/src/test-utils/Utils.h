@@ -12,6 +12,13 @@ class QString;
 
 #include <functional>
 
+#include <QtCore/QFileInfo>
+#include <QtCore/QStringList>
+
 void installTestMessageHandler();
 
+// The files matching nameFilters in the directory named by HIFI_FBX_TEST_DIR, for the benchmarks that run over real
+// models, or none if it isn't set
+QFileInfoList getFBXTestFiles(const QStringList& nameFilters);
+
 bool downloadFile(const QString& url, const std::function<void(const QByteArray&)> handler);
\ No newline at end of file
@@ -18,8 +18,81 @@
 
 #include <glm/gtx/quaternion.hpp>
 
+#include <TBBHelpers.h>
+
 using namespace workload;
 
+//
+// Region classification
+//
+// A proxy is in region k when it touches the region k sphere of any view, taking the lowest such k,
+// and in R4 when it touches none. regionSpheres holds the region spheres ordered by region, then view.
+//
+static void classify_ref(const float* x, const float* y, const float* z, const float* r, uint32_t numProxies,
+                         const Sphere* regionSpheres, uint32_t numViews, uint8_t* regions) {
+    for (uint32_t i = 0; i < numProxies; ++i) {
+        glm::vec3 proxyCenter(x[i], y[i], z[i]);
+        uint8_t region = Region::R4;
+        for (uint32_t k = 0; k < Region::NUM_TRACKED_REGIONS && region == Region::R4; ++k) {
+            for (uint32_t j = 0; j < numViews; ++j) {
+                const Sphere& sphere = regionSpheres[k * numViews + j];
+                float touchDistance = r[i] + sphere.w;
+                if (distance2(proxyCenter, glm::vec3(sphere)) < touchDistance * touchDistance) {
+                    region = (uint8_t)k;
+                    break;
+                }
+            }
+        }
+        regions[i] = region;
+    }
+}
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+
+#include <emmintrin.h>
+
+// classify four proxies at a time, testing every region sphere branch-free
+static void classify(const float* x, const float* y, const float* z, const float* r, uint32_t numProxies,
+                     const Sphere* regionSpheres, uint32_t numViews, uint8_t* regions) {
+    uint32_t i = 0;
+    for (; i + 3 < numProxies; i += 4) {
+        __m128 px = _mm_loadu_ps(&x[i]);
+        __m128 py = _mm_loadu_ps(&y[i]);
+        __m128 pz = _mm_loadu_ps(&z[i]);
+        __m128 pr = _mm_loadu_ps(&r[i]);
+
+        // work from the outermost region in, so the innermost touching region wins
+        __m128i region = _mm_set1_epi32(Region::R4);
+        for (int32_t k = Region::NUM_TRACKED_REGIONS - 1; k >= 0; --k) {
+            __m128 touching = _mm_setzero_ps();
+            for (uint32_t j = 0; j < numViews; ++j) {
+                const Sphere& sphere = regionSpheres[k * numViews + j];
+                __m128 dx = _mm_sub_ps(px, _mm_set1_ps(sphere.x));
+                __m128 dy = _mm_sub_ps(py, _mm_set1_ps(sphere.y));
+                __m128 dz = _mm_sub_ps(pz, _mm_set1_ps(sphere.z));
+                __m128 d2 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz));
+                __m128 touchDistance = _mm_add_ps(pr, _mm_set1_ps(sphere.w));
+                touching = _mm_or_ps(touching, _mm_cmplt_ps(d2, _mm_mul_ps(touchDistance, touchDistance)));
+            }
+            __m128i mask = _mm_castps_si128(touching);
+            region = _mm_or_si128(_mm_and_si128(mask, _mm_set1_epi32(k)), _mm_andnot_si128(mask, region));
+        }
+
+        // narrow to bytes
+        region = _mm_packs_epi32(region, region);
+        region = _mm_packus_epi16(region, region);
+        int32_t packed = _mm_cvtsi128_si32(region);
+        memcpy(&regions[i], &packed, 4);
+    }
+    classify_ref(&x[i], &y[i], &z[i], &r[i], numProxies - i, regionSpheres, numViews, &regions[i]);
+}
+
+#else   // portable reference code
+
+static auto& classify = classify_ref;
+
+#endif
+
 Space::Space() : Collection() {
 }
 
@@ -28,9 +101,8 @@ void Space::processTransactionFrame(const Transaction& transaction) {
     // Here we should be able to check the value of last ProxyID allocated
     // and allocate new proxies accordingly
     ProxyID maxID = _IDAllocator.getNumAllocatedIndices();
-    if (maxID > (Index) _proxies.size()) {
-        _proxies.resize(maxID + 100); // allocate the maxId and more
-        _owners.resize(maxID + 100);
+    if (maxID > (Index) _regions.size()) {
+        resizeProxies(maxID + 100); // allocate the maxId and more
     }
     // Now we know for sure that we have enough items in the array to
     // capture anything coming from the transaction
@@ -40,6 +112,26 @@ void Space::processTransactionFrame(const Transaction& transaction) {
     processRemoves(transaction._removedItems);
 }
 
+void Space::resizeProxies(uint32_t numProxies) {
+    _centersX.resize(numProxies, 0.0f);
+    _centersY.resize(numProxies, 0.0f);
+    _centersZ.resize(numProxies, 0.0f);
+    _radii.resize(numProxies, 0.0f);
+    _regions.resize(numProxies, Region::INVALID);
+    _prevRegions.resize(numProxies, Region::INVALID);
+    _owners.resize(numProxies);
+    // resizes are rare, so rather than work out which blocks changed, the whole snapshot is taken again
+    _dirtyBlocks.assign((numProxies + SNAPSHOT_BLOCK_SIZE - 1) / SNAPSHOT_BLOCK_SIZE, 1);
+}
+
+void Space::setSphere(int32_t proxyID, const Sphere& sphere) {
+    _centersX[proxyID] = sphere.x;
+    _centersY[proxyID] = sphere.y;
+    _centersZ[proxyID] = sphere.z;
+    _radii[proxyID] = sphere.w;
+    markDirty(proxyID);
+}
+
 void Space::processResets(const Transaction::Resets& transactions) {
     for (auto& reset : transactions) {
         // Access the true item
@@ -49,11 +141,9 @@ void Space::processResets(const Transaction::Resets& transactions) {
         if (!_IDAllocator.checkIndex(proxyID)) {
             continue;
         }
-        auto& item = _proxies[proxyID];
-
         // Reset the item with a new payload
-        item.sphere = (std::get<1>(reset));
-        item.prevRegion = item.region = Region::UNKNOWN;
+        setSphere(proxyID, std::get<1>(reset));
+        _prevRegions[proxyID] = _regions[proxyID] = Region::UNKNOWN;
 
         _owners[proxyID] = (std::get<2>(reset));
     }
@@ -66,12 +156,10 @@ void Space::processRemoves(const Transaction::Removes& transactions) {
         }
         _IDAllocator.freeIndex(removedID);
 
-        // Access the true item
-        auto& item = _proxies[removedID];
-
         // Kill it
-        item.prevRegion = item.region = Region::INVALID;
+        _prevRegions[removedID] = _regions[removedID] = Region::INVALID;
         _owners[removedID] = Owner();
+        markDirty(removedID);
     }
 }
 
@@ -82,39 +170,82 @@ void Space::processUpdates(const Transaction::Updates& transactions) {
             continue;
         }
 
-        // Access the true item
-        auto& item = _proxies[updateID];
-
         // Update the item
-        item.sphere = (std::get<1>(update));
+        setSphere(updateID, std::get<1>(update));
     }
 }
 
 void Space::categorizeAndGetChanges(std::vector<Space::Change>& changes) {
-    std::unique_lock<std::mutex> lock(_proxiesMutex);
-    uint32_t numProxies = (uint32_t)_proxies.size();
     uint32_t numViews = (uint32_t)_views.size();
-    for (uint32_t i = 0; i < numProxies; ++i) {
-        Proxy& proxy = _proxies[i];
-        if (proxy.region < Region::INVALID) {
-            glm::vec3 proxyCenter = glm::vec3(proxy.sphere);
-            float proxyRadius = proxy.sphere.w;
-            uint8_t region = Region::R4;
-            for (uint32_t j = 0; j < numViews; ++j) {
-                auto& view = _views[j];
-                // for each 'view' we need only increment 'k' below the current value of 'region'
-                for (uint8_t k = 0; k < region; ++k) {
-                    float touchDistance = proxyRadius + view.regions[k].w;
-                    if (distance2(proxyCenter, glm::vec3(view.regions[k])) < touchDistance * touchDistance) {
-                        region = k;
-                        break;
-                    }
-                }
+
+    // gather the region spheres of every view, ordered by region then view
+    std::vector<Sphere> regionSpheres(Region::NUM_TRACKED_REGIONS * numViews);
+    for (uint32_t k = 0; k < Region::NUM_TRACKED_REGIONS; ++k) {
+        for (uint32_t j = 0; j < numViews; ++j) {
+            regionSpheres[k * numViews + j] = _views[j].regions[k];
+        }
+    }
+
+    // Bring the snapshot of the spheres and regions up to date, so that transactions can be processed while it is
+    // classified
+    uint32_t numProxies;
+    {
+        std::unique_lock<std::mutex> lock(_proxiesMutex);
+        numProxies = (uint32_t)_regions.size();
+        _snapshotX.resize(numProxies);
+        _snapshotY.resize(numProxies);
+        _snapshotZ.resize(numProxies);
+        _snapshotRadii.resize(numProxies);
+        _snapshotRegions.resize(numProxies);
+        for (uint32_t b = 0; b < (uint32_t)_dirtyBlocks.size(); ++b) {
+            if (!_dirtyBlocks[b]) {
+                continue;
             }
-            proxy.prevRegion = proxy.region;
-            proxy.region = region;
-            if (proxy.region != proxy.prevRegion) {
-                changes.emplace_back(Space::Change((int32_t)i, proxy.region, proxy.prevRegion));
+            _dirtyBlocks[b] = 0;
+            uint32_t begin = b * SNAPSHOT_BLOCK_SIZE;
+            uint32_t count = std::min(begin + SNAPSHOT_BLOCK_SIZE, numProxies) - begin;
+            std::copy_n(&_centersX[begin], count, &_snapshotX[begin]);
+            std::copy_n(&_centersY[begin], count, &_snapshotY[begin]);
+            std::copy_n(&_centersZ[begin], count, &_snapshotZ[begin]);
+            std::copy_n(&_radii[begin], count, &_snapshotRadii[begin]);
+            std::copy_n(&_regions[begin], count, &_snapshotRegions[begin]);
+        }
+    }
+    _newRegions.resize(numProxies);
+
+    // each batch writes its own range of new regions, so the workers share nothing but read-only views
+    uint32_t numBatches = (numProxies + CATEGORIZE_BATCH_SIZE - 1) / CATEGORIZE_BATCH_SIZE;
+    auto categorizeBatches = [&](uint32_t first, uint32_t last) {
+        for (uint32_t b = first; b < last; ++b) {
+            uint32_t begin = b * CATEGORIZE_BATCH_SIZE;
+            uint32_t end = std::min(begin + CATEGORIZE_BATCH_SIZE, numProxies);
+            classify(&_snapshotX[begin], &_snapshotY[begin], &_snapshotZ[begin], &_snapshotRadii[begin], end - begin,
+                     regionSpheres.data(), numViews, &_newRegions[begin]);
+        }
+    };
+    if (numBatches > 1) {
+        tbb::parallel_for(tbb::blocked_range<uint32_t>(0, numBatches), [&](const tbb::blocked_range<uint32_t>& range) {
+            categorizeBatches(range.begin(), range.end());
+        });
+    } else {
+        categorizeBatches(0, numBatches);
+    }
+
+    // Apply the new regions, in proxy order so the changes stay sorted by proxy, and keep the snapshot's regions
+    // in step with them.
+    // A proxy that was reset or removed since the snapshot keeps its new region until the next pass, and one
+    // that moved is categorized at its old position, as if the update had come just after this pass.  Either way
+    // its block was marked dirty, so the next pass sees it as it is now.
+    std::unique_lock<std::mutex> lock(_proxiesMutex);
+    numProxies = std::min(numProxies, (uint32_t)_regions.size());
+    for (uint32_t i = 0; i < numProxies; ++i) {
+        uint8_t region = _regions[i];
+        if (region < Region::INVALID && region == _snapshotRegions[i]) {
+            _prevRegions[i] = region;
+            _regions[i] = _newRegions[i];
+            _snapshotRegions[i] = _newRegions[i];
+            if (_regions[i] != region) {
+                changes.emplace_back(Space::Change((int32_t)i, _regions[i], region));
             }
         }
     }
@@ -122,14 +253,18 @@ void Space::categorizeAndGetChanges(std::vector<Space::Change>& changes) {
 
 uint32_t Space::copyProxyValues(Proxy* proxies, uint32_t numDestProxies) const {
     std::unique_lock<std::mutex> lock(_proxiesMutex);
-    auto numCopied = std::min(numDestProxies, (uint32_t)_proxies.size());
-    memcpy(proxies, _proxies.data(), numCopied * sizeof(Proxy));
+    auto numCopied = std::min(numDestProxies, (uint32_t)_regions.size());
+    for (uint32_t i = 0; i < numCopied; ++i) {
+        proxies[i].sphere = Sphere(_centersX[i], _centersY[i], _centersZ[i], _radii[i]);
+        proxies[i].region = _regions[i];
+        proxies[i].prevRegion = _prevRegions[i];
+    }
     return numCopied;
 }
 
 const Owner Space::getOwner(int32_t proxyID) const {
     std::unique_lock<std::mutex> lock(_proxiesMutex);
-    if (isAllocatedID(proxyID) && (proxyID < (Index)_proxies.size())) {
+    if (isAllocatedID(proxyID) && (proxyID < (Index)_owners.size())) {
         return _owners[proxyID];
     }
     return Owner();
@@ -137,8 +272,8 @@ const Owner Space::getOwner(int32_t proxyID) const {
 
 uint8_t Space::getRegion(int32_t proxyID) const {
     std::unique_lock<std::mutex> lock(_proxiesMutex);
-    if (isAllocatedID(proxyID) && (proxyID < (Index)_proxies.size())) {
-        return _proxies[proxyID].region;
+    if (isAllocatedID(proxyID) && (proxyID < (Index)_regions.size())) {
+        return _regions[proxyID];
     }
     return (uint8_t)Region::INVALID;
 }
@@ -147,8 +282,7 @@ void Space::clear() {
     Collection::clear();
     std::unique_lock<std::mutex> lock(_proxiesMutex);
     _IDAllocator.clear();
-    _proxies.clear();
-    _owners.clear();
+    resizeProxies(0);
     _views.clear();
 }
 
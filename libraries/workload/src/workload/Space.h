@@ -52,6 +52,10 @@ public:
     uint8_t getRegion(int32_t proxyID) const;
 
     void clear() override;
+
+    // proxies are categorized in batches of this size, which are spread across worker threads
+    static const uint32_t CATEGORIZE_BATCH_SIZE = 4096;
+
 private:
 
     void processTransactionFrame(const Transaction& transaction) override;
@@ -59,11 +63,36 @@ private:
     void processRemoves(const Transaction::Removes& transactions);
     void processUpdates(const Transaction::Updates& transactions);
 
-    // The database of proxies is protected for editing by a mutex
+    void resizeProxies(uint32_t numProxies);
+    void setSphere(int32_t proxyID, const Sphere& sphere);
+    void markDirty(int32_t proxyID) { _dirtyBlocks[proxyID / SNAPSHOT_BLOCK_SIZE] = 1; }
+
+    // The database of proxies is protected for editing by a mutex.
+    // It is stored as a structure of arrays, so categorization streams through only the spheres and regions.
     mutable std::mutex _proxiesMutex;
-    Proxy::Vector _proxies;
+    std::vector<float> _centersX;
+    std::vector<float> _centersY;
+    std::vector<float> _centersZ;
+    std::vector<float> _radii;
+    std::vector<uint8_t> _regions;
+    std::vector<uint8_t> _prevRegions;
     std::vector<Owner> _owners;
 
+    // Categorization classifies a copy of the spheres without holding _proxiesMutex, then applies the new regions
+    // under it, so it only holds up processTransactions for the copy and the apply.  The copy persists from pass to
+    // pass, and only the blocks of proxies whose sphere or region was changed by a transaction since the last pass
+    // are copied again, so a pass over a mostly static space copies little.
+    static const uint32_t SNAPSHOT_BLOCK_SIZE = 256;
+    std::vector<uint8_t> _dirtyBlocks;
+
+    // These buffers are only used by categorizeAndGetChanges, which is called from one thread at a time.
+    std::vector<float> _snapshotX;
+    std::vector<float> _snapshotY;
+    std::vector<float> _snapshotZ;
+    std::vector<float> _snapshotRadii;
+    std::vector<uint8_t> _snapshotRegions;
+    std::vector<uint8_t> _newRegions;
+
     Views _views;
 };
 
@@ -97,6 +97,19 @@ Item {
             ]
         }
 
+        PlotPerf {
+            title: "Scene Transactions"
+            height: parent.evalEvenHeight()
+            object: stats.config
+            plots: [
+                {
+                    prop: "transactionBacklog",
+                    label: "Backlog",
+                    color: "#FED959"
+                }
+            ]
+        }
+
         property var drawOpaqueConfig: Render.getConfig("RenderMainView.DrawOpaqueDeferred")
         property var drawTransparentConfig: Render.getConfig("RenderMainView.DrawTransparentDeferred")
         property var drawLightConfig: Render.getConfig("RenderMainView.DrawLight")
@@ -0,0 +1,253 @@
+//
+//  AnimPoseBufferTests.cpp
+//  tests/animation/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AnimPoseBufferTests.h"
+
+#include <iostream>
+
+#include <AnimPoseBuffer.h>
+#include <AnimSkeleton.h>
+#include <AnimUtil.h>
+#include <NumericalConstants.h>
+#include <SharedUtil.h>
+
+#include <test-utils/GLMTestUtils.h>
+#include <test-utils/QTestExtensions.h>
+
+QTEST_MAIN(AnimPoseBufferTests)
+
+const float EPSILON = 0.0001f;
+const float ANGLE_EPSILON = 0.0001f;
+
+static glm::quat randomRotation() {
+    glm::vec3 axis = glm::normalize(glm::vec3(randFloatInRange(-1.0f, 1.0f), randFloatInRange(-1.0f, 1.0f), 1.0f));
+    return glm::angleAxis(randFloatInRange(-PI, PI), axis);
+}
+
+static glm::vec3 randomVector() {
+    return glm::vec3(randFloatInRange(-1.0f, 1.0f), randFloatInRange(-1.0f, 1.0f), randFloatInRange(-1.0f, 1.0f));
+}
+
+static AnimPoseVec randomPoses(int numPoses) {
+    AnimPoseVec poses(numPoses);
+    for (auto& pose : poses) {
+        pose = AnimPose(glm::vec3(randFloatInRange(0.5f, 2.0f)), randomRotation(), randomVector());
+    }
+    return poses;
+}
+
+// the per-pose blend that ::blend() replaces with the AnimPoseBuffer kernels
+static void blendPosesByPose(const AnimPoseVec& a, const AnimPoseVec& b, const float* alphas, AnimPoseVec& result) {
+    result.resize(a.size());
+    for (size_t i = 0; i < a.size(); i++) {
+        result[i].scale() = glm::mix(a[i].scale(), b[i].scale(), alphas[i]);
+        result[i].rot() = safeLerp(a[i].rot(), b[i].rot(), alphas[i]);
+        result[i].trans() = glm::mix(a[i].trans(), b[i].trans(), alphas[i]);
+    }
+}
+
+// a skeleton with a few long chains and many short branches, like a humanoid with fingers
+static AnimSkeleton::Pointer makeSkeleton(int numJoints) {
+    std::vector<HFMJoint> joints(numJoints);
+    for (int i = 0; i < numJoints; i++) {
+        HFMJoint& joint = joints[i];
+        joint.parentIndex = (i < 8) ? i - 1 : randIntInRange(0, i - 1);
+        joint.translation = randomVector();
+        joint.rotation = randomRotation();
+        joint.name = "Joint" + QString::number(i);
+        joint.isSkeletonJoint = true;
+    }
+    return std::make_shared<AnimSkeleton>(joints, QMap<int, glm::quat>());
+}
+
+// the matrix path that buildAbsolutePoses replaces
+static void buildAbsolutePosesByMatrix(const AnimSkeleton& skeleton, const AnimPoseVec& relativePoses,
+                                       const AnimPose& rootPose, AnimPoseVec& absolutePoses) {
+    absolutePoses.resize(relativePoses.size());
+    for (int i = 0; i < (int)relativePoses.size(); i++) {
+        int parentIndex = skeleton.getParentIndex(i);
+        absolutePoses[i] = (parentIndex == -1 ? rootPose : absolutePoses[parentIndex]) * relativePoses[i];
+    }
+}
+
+static void comparePoses(const AnimPoseVec& a, const AnimPoseVec& b) {
+    QCOMPARE(a.size(), b.size());
+    for (size_t i = 0; i < a.size(); i++) {
+        QCOMPARE_WITH_ABS_ERROR(a[i].scale(), b[i].scale(), EPSILON);
+        QCOMPARE_QUATS(a[i].rot(), b[i].rot(), ANGLE_EPSILON);
+        QCOMPARE_WITH_ABS_ERROR(a[i].trans(), b[i].trans(), EPSILON);
+    }
+}
+
+void AnimPoseBufferTests::loadStore() {
+    const int NUM_POSES = 13;
+    AnimPoseVec poses = randomPoses(NUM_POSES);
+
+    AnimPoseBuffer buffer;
+    buffer.load(poses.data(), NUM_POSES);
+    QCOMPARE(buffer.size(), NUM_POSES);
+    QCOMPARE(buffer.stride() % AnimPoseBuffer::POSE_LANES, 0);
+
+    // the padding holds identity poses
+    for (int i = NUM_POSES; i < buffer.stride(); i++) {
+        QCOMPARE(buffer.channel(AnimPoseBuffer::SCALE_X)[i], 1.0f);
+        QCOMPARE(buffer.channel(AnimPoseBuffer::ROT_W)[i], 1.0f);
+        QCOMPARE(buffer.channel(AnimPoseBuffer::TRANS_Z)[i], 0.0f);
+    }
+
+    // store through a permutation, and back
+    std::vector<int> order(NUM_POSES);
+    for (int i = 0; i < NUM_POSES; i++) {
+        order[i] = (i * 5) % NUM_POSES;
+    }
+    AnimPoseVec shuffled(NUM_POSES);
+    buffer.store(shuffled.data(), order.data());
+    for (int i = 0; i < NUM_POSES; i++) {
+        QCOMPARE(shuffled[order[i]].trans(), poses[i].trans());
+    }
+
+    AnimPoseBuffer unshuffled;
+    unshuffled.load(shuffled.data(), NUM_POSES, order.data());
+    AnimPoseVec result(NUM_POSES);
+    unshuffled.store(result.data());
+    for (int i = 0; i < NUM_POSES; i++) {
+        QCOMPARE(result[i].scale(), poses[i].scale());
+        QCOMPARE(result[i].rot(), poses[i].rot());
+        QCOMPARE(result[i].trans(), poses[i].trans());
+    }
+}
+
+void AnimPoseBufferTests::blendPoses() {
+    // not a multiple of the SIMD width, to cover the padding
+    const int NUM_POSES = 67;
+    AnimPoseVec a = randomPoses(NUM_POSES);
+    AnimPoseVec b = randomPoses(NUM_POSES);
+
+    for (float alpha : { 0.0f, 0.25f, 0.5f, 1.0f }) {
+        std::vector<float> alphas(NUM_POSES, alpha);
+        AnimPoseVec expected;
+        blendPosesByPose(a, b, alphas.data(), expected);
+
+        AnimPoseVec result(NUM_POSES);
+        ::blend(NUM_POSES, a.data(), b.data(), alpha, result.data());
+        comparePoses(result, expected);
+
+        // in place
+        result = a;
+        ::blend(NUM_POSES, result.data(), b.data(), alpha, result.data());
+        comparePoses(result, expected);
+    }
+
+    // a weight for each pose, as AnimOverlay blends
+    std::vector<float> alphas(NUM_POSES);
+    for (auto& alpha : alphas) {
+        alpha = randFloatInRange(0.0f, 1.0f);
+    }
+    AnimPoseVec expected;
+    blendPosesByPose(a, b, alphas.data(), expected);
+    AnimPoseVec result(NUM_POSES);
+    ::blend(NUM_POSES, a.data(), b.data(), alphas.data(), result.data());
+    comparePoses(result, expected);
+}
+
+void AnimPoseBufferTests::buildAbsolutePoses() {
+    for (int numJoints : { 1, 7, 60, 250 }) {
+        AnimSkeleton::Pointer skeleton = makeSkeleton(numJoints);
+        AnimPoseVec relativePoses = randomPoses(numJoints);
+
+        // a mirrored joint keeps a uniform scale
+        relativePoses[0].scale() = glm::vec3(-1.0f);
+
+        AnimPose rootPose(glm::vec3(0.01f), randomRotation(), randomVector());
+        AnimPoseVec expected;
+        buildAbsolutePosesByMatrix(*skeleton, relativePoses, rootPose, expected);
+
+        AnimPoseVec result;
+        skeleton->buildAbsolutePoses(relativePoses, result, &rootPose);
+        comparePoses(result, expected);
+
+        // in place, with the roots left alone
+        buildAbsolutePosesByMatrix(*skeleton, relativePoses, AnimPose::identity, expected);
+        result = relativePoses;
+        skeleton->convertRelativePosesToAbsolute(result);
+        comparePoses(result, expected);
+    }
+}
+
+void AnimPoseBufferTests::nonUniformScale() {
+    const int NUM_JOINTS = 60;
+    AnimSkeleton::Pointer skeleton = makeSkeleton(NUM_JOINTS);
+    AnimPoseVec relativePoses = randomPoses(NUM_JOINTS);
+    relativePoses[3].scale() = glm::vec3(1.0f, 2.0f, 0.5f);
+
+    // falls back to the matrix path
+    AnimPose rootPose(randomRotation(), randomVector());
+    AnimPoseVec expected;
+    buildAbsolutePosesByMatrix(*skeleton, relativePoses, rootPose, expected);
+
+    AnimPoseVec result;
+    skeleton->buildAbsolutePoses(relativePoses, result, &rootPose);
+    for (int i = 0; i < NUM_JOINTS; i++) {
+        QCOMPARE(result[i].scale(), expected[i].scale());
+        QCOMPARE(result[i].rot(), expected[i].rot());
+        QCOMPARE(result[i].trans(), expected[i].trans());
+    }
+}
+
+#ifdef MANUAL_TEST
+
+void AnimPoseBufferTests::benchmark() {
+    const int NUM_ITERATIONS = 10000;
+
+    for (int numJoints : { 60, 250, 1000 }) {
+        AnimSkeleton::Pointer skeleton = makeSkeleton(numJoints);
+        AnimPoseVec relativePoses = randomPoses(numJoints);
+        AnimPoseVec absolutePoses;
+        AnimPose rootPose(glm::vec3(0.01f), randomRotation(), randomVector());
+
+        uint64_t start = usecTimestampNow();
+        for (int i = 0; i < NUM_ITERATIONS; i++) {
+            buildAbsolutePosesByMatrix(*skeleton, relativePoses, rootPose, absolutePoses);
+        }
+        uint64_t matrix = usecTimestampNow() - start;
+
+        start = usecTimestampNow();
+        for (int i = 0; i < NUM_ITERATIONS; i++) {
+            skeleton->buildAbsolutePoses(relativePoses, absolutePoses, &rootPose);
+        }
+        uint64_t levels = usecTimestampNow() - start;
+
+        AnimPoseVec a = randomPoses(numJoints);
+        AnimPoseVec b = randomPoses(numJoints);
+        std::vector<float> alphas(numJoints, 0.3f);
+        AnimPoseVec result(numJoints);
+
+        start = usecTimestampNow();
+        for (int i = 0; i < NUM_ITERATIONS; i++) {
+            blendPosesByPose(a, b, alphas.data(), result);
+        }
+        uint64_t blendByPose = usecTimestampNow() - start;
+
+        start = usecTimestampNow();
+        for (int i = 0; i < NUM_ITERATIONS; i++) {
+            ::blend(numJoints, a.data(), b.data(), 0.3f, result.data());
+        }
+        uint64_t blendBuffer = usecTimestampNow() - start;
+
+        double numPoses = (double)numJoints * NUM_ITERATIONS;
+        std::cout << numJoints << " joints:" << std::endl;
+        std::cout << "    absolute poses by matrix " << numPoses / matrix << " joints/us, by level "
+                  << numPoses / levels << " joints/us" << std::endl;
+        std::cout << "    blend by pose " << numPoses / blendByPose << " joints/us, through AnimPoseBuffer "
+                  << numPoses / blendBuffer << " joints/us" << std::endl;
+    }
+}
+
+#endif // MANUAL_TEST
@@ -0,0 +1,231 @@
+//
+//  CrowdAnimationTests.cpp
+//  tests/animation/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "CrowdAnimationTests.h"
+
+#include <iostream>
+#include <memory>
+
+#include <glm/gtx/transform.hpp>
+
+#include <JointData.h>
+#include <NumericalConstants.h>
+#include <Rig.h>
+#include <SharedUtil.h>
+#include <TBBHelpers.h>
+
+#include <test-utils/GLMTestUtils.h>
+#include <test-utils/QTestExtensions.h>
+
+QTEST_MAIN(CrowdAnimationTests)
+
+const float EPSILON = 0.001f;
+
+static int addJoint(HFMModel& hfmModel, const QString& name, int parentIndex, const glm::vec3& translation) {
+    HFMJoint joint;
+    joint.isFree = false;
+    joint.parentIndex = parentIndex;
+    joint.distanceToParent = glm::length(translation);
+    joint.translation = translation;
+    joint.rotationMin = glm::vec3(-PI);
+    joint.rotationMax = glm::vec3(PI);
+    joint.name = name;
+    joint.isSkeletonJoint = true;
+
+    glm::mat4 parentTransform = (parentIndex == -1) ? glm::mat4() : hfmModel.joints[parentIndex].transform;
+    joint.transform = parentTransform * glm::translate(translation);
+    joint.bindTransform = joint.transform;
+
+    hfmModel.joints.push_back(joint);
+    return (int)hfmModel.joints.size() - 1;
+}
+
+// a humanoid skeleton of about the size of a typical avatar's
+static void makeHumanoid(HFMModel& hfmModel) {
+    int hips = addJoint(hfmModel, "Hips", -1, glm::vec3(0.0f, 1.0f, 0.0f));
+    int spine = hips;
+    for (int i = 0; i < 3; i++) {
+        spine = addJoint(hfmModel, "Spine" + QString::number(i), spine, glm::vec3(0.0f, 0.15f, 0.0f));
+    }
+    int neck = addJoint(hfmModel, "Neck", spine, glm::vec3(0.0f, 0.15f, 0.0f));
+    int head = addJoint(hfmModel, "Head", neck, glm::vec3(0.0f, 0.1f, 0.0f));
+    addJoint(hfmModel, "LeftEye", head, glm::vec3(0.03f, 0.08f, 0.08f));
+    addJoint(hfmModel, "RightEye", head, glm::vec3(-0.03f, 0.08f, 0.08f));
+
+    for (float side : { 1.0f, -1.0f }) {
+        QString prefix = (side > 0.0f) ? "Left" : "Right";
+        int shoulder = addJoint(hfmModel, prefix + "Shoulder", spine, glm::vec3(side * 0.05f, 0.1f, 0.0f));
+        int arm = addJoint(hfmModel, prefix + "Arm", shoulder, glm::vec3(side * 0.1f, 0.0f, 0.0f));
+        int foreArm = addJoint(hfmModel, prefix + "ForeArm", arm, glm::vec3(side * 0.25f, 0.0f, 0.0f));
+        int hand = addJoint(hfmModel, prefix + "Hand", foreArm, glm::vec3(side * 0.25f, 0.0f, 0.0f));
+        for (int finger = 0; finger < 5; finger++) {
+            int joint = hand;
+            for (int segment = 1; segment <= 4; segment++) {
+                joint = addJoint(hfmModel, prefix + "HandFinger" + QString::number(finger) + "_" + QString::number(segment),
+                                 joint, glm::vec3(side * 0.03f, 0.0f, 0.02f * (finger - 2)));
+            }
+        }
+
+        int upLeg = addJoint(hfmModel, prefix + "UpLeg", hips, glm::vec3(side * 0.1f, -0.05f, 0.0f));
+        int leg = addJoint(hfmModel, prefix + "Leg", upLeg, glm::vec3(0.0f, -0.45f, 0.0f));
+        int foot = addJoint(hfmModel, prefix + "Foot", leg, glm::vec3(0.0f, -0.45f, 0.0f));
+        addJoint(hfmModel, prefix + "ToeBase", foot, glm::vec3(0.0f, -0.05f, 0.1f));
+    }
+}
+
+// Joint data as it arrives from the avatar mixer: absolute rig-frame rotations of a swaying skeleton
+static void recordJointData(const HFMModel& hfmModel, int numFrames, std::vector<QVector<JointData>>& frames) {
+    int numJoints = (int)hfmModel.joints.size();
+    frames.resize(numFrames);
+    std::vector<glm::quat> absoluteRotations(numJoints);
+    for (int frame = 0; frame < numFrames; frame++) {
+        auto& jointData = frames[frame];
+        jointData.resize(numJoints);
+        for (int i = 0; i < numJoints; i++) {
+            float angle = 0.3f * sinf(TWO_PI * (frame / 90.0f + i / (float)numJoints));
+            glm::quat relativeRotation = glm::angleAxis(angle, glm::normalize(glm::vec3(1.0f, (float)(i % 3), 0.5f)));
+            int parentIndex = hfmModel.joints[i].parentIndex;
+            absoluteRotations[i] = (parentIndex == -1) ? relativeRotation : absoluteRotations[parentIndex] * relativeRotation;
+
+            jointData[i].rotation = absoluteRotations[i];
+            jointData[i].rotationIsDefaultPose = false;
+            jointData[i].translationIsDefaultPose = true;
+        }
+    }
+}
+
+void CrowdAnimationTests::decodeJointData() {
+    HFMModel hfmModel;
+    makeHumanoid(hfmModel);
+    std::vector<QVector<JointData>> frames;
+    recordJointData(hfmModel, 10, frames);
+
+    Rig rig;
+    rig.initJointStates(hfmModel, glm::mat4());
+
+    // decoding leaves the rig alone, and gives the same poses as copying into it
+    AnimPoseVec decoded;
+    QVERIFY(rig.decodeJointData(frames[5], decoded));
+    QCOMPARE(decoded.size(), rig.getRelativePoses().size());
+
+    rig.copyJointsFromJointData(frames[5]);
+    const auto& copied = rig.getRelativePoses();
+    for (size_t i = 0; i < decoded.size(); i++) {
+        QCOMPARE_WITH_ABS_ERROR(decoded[i].rot(), copied[i].rot(), EPSILON);
+        QCOMPARE_WITH_ABS_ERROR(decoded[i].trans(), copied[i].trans(), EPSILON);
+    }
+
+    // mismatched joint data is rejected
+    QVector<JointData> truncated = frames[5];
+    truncated.resize(truncated.size() - 1);
+    QVERIFY(!rig.decodeJointData(truncated, decoded));
+}
+
+void CrowdAnimationTests::interpolateJointPoses() {
+    HFMModel hfmModel;
+    makeHumanoid(hfmModel);
+    std::vector<QVector<JointData>> frames;
+    recordJointData(hfmModel, 60, frames);
+
+    Rig rig;
+    rig.initJointStates(hfmModel, glm::mat4());
+
+    AnimPoseVec from, to;
+    QVERIFY(rig.decodeJointData(frames[0], from));
+    QVERIFY(rig.decodeJointData(frames[40], to));
+
+    rig.interpolateJointPoses(from, to, 0.0f);
+    for (size_t i = 0; i < from.size(); i++) {
+        QCOMPARE_WITH_ABS_ERROR(rig.getRelativePoses()[i].rot(), from[i].rot(), EPSILON);
+    }
+
+    rig.interpolateJointPoses(from, to, 1.0f);
+    for (size_t i = 0; i < to.size(); i++) {
+        QCOMPARE_WITH_ABS_ERROR(rig.getRelativePoses()[i].rot(), to[i].rot(), EPSILON);
+    }
+
+    // halfway, each joint has turned about as far from both ends
+    rig.interpolateJointPoses(from, to, 0.5f);
+    for (size_t i = 0; i < to.size(); i++) {
+        float fromAngle = glm::angle(glm::inverse(from[i].rot()) * rig.getRelativePoses()[i].rot());
+        float toAngle = glm::angle(glm::inverse(to[i].rot()) * rig.getRelativePoses()[i].rot());
+        QCOMPARE_WITH_ABS_ERROR(fromAngle, toAngle, EPSILON);
+    }
+}
+
+#ifdef MANUAL_TEST
+
+void CrowdAnimationTests::benchmark() {
+    const int NUM_FRAMES = 300;
+
+    HFMModel hfmModel;
+    makeHumanoid(hfmModel);
+    std::vector<QVector<JointData>> frames;
+    recordJointData(hfmModel, NUM_FRAMES, frames);
+    std::cout << hfmModel.joints.size() << " joints per avatar" << std::endl;
+
+    for (int numAvatars : { 20, 50, 150 }) {
+        std::vector<std::unique_ptr<Rig>> rigs;
+        for (int i = 0; i < numAvatars; i++) {
+            rigs.emplace_back(new Rig());
+            rigs.back()->initJointStates(hfmModel, glm::mat4());
+        }
+
+        // what OtherAvatar::simulate() used to do, one avatar after the other
+        auto fullRate = [&](int avatar, int frame) {
+            Rig& rig = *rigs[avatar];
+            rig.copyJointsFromJointData(frames[(frame + avatar) % NUM_FRAMES]);
+            rig.computeExternalPoses(glm::mat4());
+        };
+
+        uint64_t start = usecTimestampNow();
+        for (int frame = 0; frame < NUM_FRAMES; frame++) {
+            for (int avatar = 0; avatar < numAvatars; avatar++) {
+                fullRate(avatar, frame);
+            }
+        }
+        uint64_t serial = usecTimestampNow() - start;
+
+        start = usecTimestampNow();
+        for (int frame = 0; frame < NUM_FRAMES; frame++) {
+            tbb::parallel_for(0, numAvatars, [&](int avatar) {
+                fullRate(avatar, frame);
+            });
+        }
+        uint64_t parallel = usecTimestampNow() - start;
+
+        // a crowd where a third of the avatars are near and the rest decode every 4th frame and interpolate
+        const int INTERVAL = 4;
+        std::vector<AnimPoseVec> fromPoses(numAvatars), toPoses(numAvatars);
+        start = usecTimestampNow();
+        for (int frame = 0; frame < NUM_FRAMES; frame++) {
+            tbb::parallel_for(0, numAvatars, [&](int avatar) {
+                if (avatar % 3 == 0) {
+                    fullRate(avatar, frame);
+                    return;
+                }
+                Rig& rig = *rigs[avatar];
+                int step = (frame + avatar) % INTERVAL;
+                if (step == 0) {
+                    fromPoses[avatar] = rig.getRelativePoses();
+                    rig.decodeJointData(frames[(frame + avatar) % NUM_FRAMES], toPoses[avatar]);
+                }
+                rig.interpolateJointPoses(fromPoses[avatar], toPoses[avatar], (float)(step + 1) / INTERVAL);
+                rig.computeExternalPoses(glm::mat4());
+            });
+        }
+        uint64_t lod = usecTimestampNow() - start;
+
+        std::cout << numAvatars << " avatars: serial = " << serial / NUM_FRAMES << " usec/frame, parallel = "
+            << parallel / NUM_FRAMES << " usec/frame, parallel with LOD = " << lod / NUM_FRAMES << " usec/frame" << std::endl;
+    }
+}
+
+#endif // MANUAL_TEST
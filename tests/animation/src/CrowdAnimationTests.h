@@ -0,0 +1,27 @@
+//
+//  CrowdAnimationTests.h
+//  tests/animation/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_CrowdAnimationTests_h
+#define hifi_CrowdAnimationTests_h
+
+#include <QtTest/QtTest>
+
+class CrowdAnimationTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void decodeJointData();
+    void interpolateJointPoses();
+#ifdef MANUAL_TEST
+    void benchmark();
+#endif // MANUAL_TEST
+};
+
+#endif // hifi_CrowdAnimationTests_h
@@ -0,0 +1,275 @@
+//
+//  AudioDSPTests.cpp
+//  tests/audio/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AudioDSPTests.h"
+
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <AudioDynamics.h>
+#include <AudioGate.h>
+#include <AudioHRTF.h>
+#include <AudioLimiter.h>
+#include <AudioReverb.h>
+#include <NumericalConstants.h>
+#include <SharedUtil.h>
+
+QTEST_MAIN(AudioDSPTests)
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+
+#include <CPUDetect.h>
+
+// the limiter's block kernels, from AudioLimiter.cpp and avx2/AudioLimiter_avx2.cpp
+void peakAttn_ref(const float* input, int32_t* attn, int numChannels, int32_t threshold, int numFrames);
+void fixexp2Block_ref(int32_t* x, int numFrames);
+void applyGain_ref(const float* input, const float* gain, const float* dither, int16_t* output, int numChannels, int numFrames);
+void peakAttn_AVX2(const float* input, int32_t* attn, int numChannels, int32_t threshold, int numFrames);
+void fixexp2Block_AVX2(int32_t* x, int numFrames);
+void applyGain_AVX2(const float* input, const float* gain, const float* dither, int16_t* output, int numChannels, int numFrames);
+
+#endif
+
+static const int SAMPLE_RATE = 24000;
+static const int FRAMES_PER_BLOCK = 240;    // one network frame
+static const float FULL_SCALE = 32768.0f;   // float input of 1.0f is 0dBFS
+
+// interleaved sine wave, with each channel at a different frequency
+static void generateSine(std::vector<float>& buffer, int numChannels, int numFrames, float amplitude, int& phase) {
+    buffer.resize(numChannels * numFrames);
+    for (int i = 0; i < numFrames; i++) {
+        for (int c = 0; c < numChannels; c++) {
+            float frequency = 440.0f * (c + 1);
+            buffer[numChannels * i + c] = amplitude * sinf(TWO_PI * frequency * (phase + i) / SAMPLE_RATE);
+        }
+    }
+    phase += numFrames;
+}
+
+static int peakOf(const std::vector<int16_t>& buffer) {
+    int peak = 0;
+    for (int16_t x : buffer) {
+        peak = std::max(peak, std::abs((int)x));
+    }
+    return peak;
+}
+
+void AudioDSPTests::limiterCeiling() {
+    // the output ceiling is -0.3dBFS, plus a little dither
+    const int CEILING = 31700;
+
+    for (int numChannels : { 1, 2, 4 }) {
+        AudioLimiter limiter(SAMPLE_RATE, numChannels);
+        limiter.setThreshold(-6.0f);
+
+        std::vector<float> input;
+        std::vector<int16_t> output(numChannels * FRAMES_PER_BLOCK);
+        int phase = 0;
+        int peak = 0;
+        for (int block = 0; block < 100; block++) {
+            // alternate between heavy overload and silence, to exercise attack and release
+            float amplitude = (block % 20 < 10) ? 4.0f : 0.0f;
+            generateSine(input, numChannels, FRAMES_PER_BLOCK, amplitude, phase);
+            limiter.render(input.data(), output.data(), FRAMES_PER_BLOCK);
+            peak = std::max(peak, peakOf(output));
+        }
+        QVERIFY(peak > 30000);
+        QVERIFY(peak <= CEILING);
+    }
+}
+
+void AudioDSPTests::limiterPassThrough() {
+    // below threshold, the limiter only applies the makeup gain (-0.3dB at 0dB threshold)
+    const float MAKEUP_GAIN = 0.966f;
+    const float AMPLITUDE = 0.25f;
+
+    for (int numChannels : { 1, 2, 4 }) {
+        AudioLimiter limiter(SAMPLE_RATE, numChannels);
+        limiter.setThreshold(0.0f);
+
+        std::vector<float> input;
+        std::vector<int16_t> output(numChannels * FRAMES_PER_BLOCK);
+        int phase = 0;
+        int peak = 0;
+        for (int block = 0; block < 50; block++) {
+            generateSine(input, numChannels, FRAMES_PER_BLOCK, AMPLITUDE, phase);
+            limiter.render(input.data(), output.data(), FRAMES_PER_BLOCK);
+            if (block > 10) {
+                peak = std::max(peak, peakOf(output));
+            }
+        }
+        float expected = MAKEUP_GAIN * AMPLITUDE * FULL_SCALE;
+        QVERIFY(std::abs(peak - expected) < 0.01f * expected);
+    }
+}
+
+void AudioDSPTests::limiterBlockSizes() {
+    // the limiter works in internal blocks, so the output must not depend on how the input is split up
+    const int NUM_FRAMES = 2400;
+
+    for (int numChannels : { 1, 2, 4 }) {
+        std::vector<float> input;
+        int phase = 0;
+        generateSine(input, numChannels, NUM_FRAMES, 4.0f, phase);
+
+        // dither is drawn from a shared pseudo-random sequence, so allow for it in the comparison
+        AudioLimiter whole(SAMPLE_RATE, numChannels);
+        std::vector<int16_t> expected(numChannels * NUM_FRAMES);
+        whole.render(input.data(), expected.data(), NUM_FRAMES);
+
+        AudioLimiter split(SAMPLE_RATE, numChannels);
+        std::vector<int16_t> actual(numChannels * NUM_FRAMES);
+        int offset = 0;
+        for (int numFrames : { 1, 7, 240, 300, 1000, 852 }) {
+            split.render(&input[numChannels * offset], &actual[numChannels * offset], numFrames);
+            offset += numFrames;
+        }
+        QCOMPARE(offset, NUM_FRAMES);
+
+        for (size_t i = 0; i < expected.size(); i++) {
+            QVERIFY(std::abs(expected[i] - actual[i]) <= 2);
+        }
+    }
+}
+
+// Reports the throughput of each DSP block, in samples per second on one core
+void AudioDSPTests::limiterKernels() {
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+    if (!cpuSupportsAVX2()) {
+        QSKIP("AVX2 is not supported");
+    }
+
+    // odd sizes exercise the scalar tails
+    const int FRAME_COUNTS[] = { 1, 3, 7, 8, 9, 31, 240, 256 };
+    const int NUM_PASSES = 20;
+
+    std::mt19937 random(FRAMES_PER_BLOCK);
+    std::uniform_real_distribution<float> sample(-1.0f, 1.0f);
+    std::uniform_int_distribution<int> scale(-24, 3);
+    std::uniform_real_distribution<float> threshold(-48.0f, 0.0f);
+    std::uniform_int_distribution<int32_t> attenuation(0, 0x7fffffff);
+    std::uniform_real_distribution<float> gain(0.0f, 0.97f * FULL_SCALE);
+
+    for (int pass = 0; pass < NUM_PASSES; pass++) {
+        for (int numChannels : { 1, 2, 4 }) {
+            for (int numFrames : FRAME_COUNTS) {
+                // samples over a wide range of levels, with some silence
+                std::vector<float> input(numChannels * numFrames);
+                for (auto& x : input) {
+                    x = (random() % 8 == 0) ? 0.0f : ldexpf(sample(random), scale(random));
+                }
+
+                // the threshold in the log2 domain, as LimiterImpl::setThreshold computes it
+                int32_t logThreshold = (int32_t)(-(double)threshold(random) * DB_TO_LOG2 * (1 << LOG2_FRACBITS));
+                logThreshold += LOG2_BIAS + EXP2_BIAS + (LOG2_HEADROOM << LOG2_FRACBITS);
+
+                std::vector<int32_t> expected(numFrames);
+                std::vector<int32_t> actual(numFrames);
+                peakAttn_ref(input.data(), expected.data(), numChannels, logThreshold, numFrames);
+                peakAttn_AVX2(input.data(), actual.data(), numChannels, logThreshold, numFrames);
+                QCOMPARE(actual, expected);
+
+                // the attenuations that peak detection gives, and any others
+                for (int i = 0; i < numFrames; i += 2) {
+                    expected[i] = attenuation(random);
+                }
+                actual = expected;
+                fixexp2Block_ref(expected.data(), numFrames);
+                fixexp2Block_AVX2(actual.data(), numFrames);
+                QCOMPARE(actual, expected);
+
+                // gains up to full scale, so that the output stays within 16 bits
+                std::vector<float> gains(numFrames);
+                std::vector<float> dither(numFrames);
+                for (int i = 0; i < numFrames; i++) {
+                    gains[i] = gain(random);
+                    dither[i] = sample(random);
+                    for (int c = 0; c < numChannels; c++) {
+                        input[numChannels * i + c] = sample(random);
+                    }
+                }
+                std::vector<int16_t> expectedOutput(numChannels * numFrames);
+                std::vector<int16_t> actualOutput(numChannels * numFrames);
+                applyGain_ref(input.data(), gains.data(), dither.data(), expectedOutput.data(), numChannels, numFrames);
+                applyGain_AVX2(input.data(), gains.data(), dither.data(), actualOutput.data(), numChannels, numFrames);
+
+                // within 1 LSB, in case the compiler fuses the scalar multiply and add
+                for (size_t i = 0; i < expectedOutput.size(); i++) {
+                    QVERIFY(std::abs(actualOutput[i] - expectedOutput[i]) <= 1);
+                }
+            }
+        }
+    }
+#else
+    QSKIP("The AVX2 kernels are x86 only");
+#endif
+}
+
+void AudioDSPTests::benchmark() {
+    const int NUM_BLOCKS = 2000;
+
+    auto report = [](const char* name, int numChannels, uint64_t usecs) {
+        double samplesPerSecond = (double)NUM_BLOCKS * FRAMES_PER_BLOCK * numChannels * USECS_PER_SECOND / std::max(usecs, (uint64_t)1);
+        std::cout << name << ": " << (uint64_t)(samplesPerSecond / 1000000.0) << " Msamples/sec/core" << std::endl;
+    };
+
+    std::vector<float> input;
+    int phase = 0;
+    generateSine(input, 4, FRAMES_PER_BLOCK, 2.0f, phase);
+    std::vector<int16_t> input16(4 * FRAMES_PER_BLOCK);
+    for (size_t i = 0; i < input16.size(); i++) {
+        input16[i] = (int16_t)(input[i] * 0.25f * FULL_SCALE);
+    }
+    std::vector<int16_t> output(4 * FRAMES_PER_BLOCK);
+    std::vector<float> outputFloat(2 * FRAMES_PER_BLOCK);
+
+    for (int numChannels : { 1, 2, 4 }) {
+        AudioLimiter limiter(SAMPLE_RATE, numChannels);
+        uint64_t start = usecTimestampNow();
+        for (int i = 0; i < NUM_BLOCKS; i++) {
+            limiter.render(input.data(), output.data(), FRAMES_PER_BLOCK);
+        }
+        uint64_t usecs = usecTimestampNow() - start;
+        std::string name = "AudioLimiter (" + std::to_string(numChannels) + " channel)";
+        report(name.c_str(), numChannels, usecs);
+    }
+
+    {
+        AudioGate gate(SAMPLE_RATE, 1);
+        uint64_t start = usecTimestampNow();
+        for (int i = 0; i < NUM_BLOCKS; i++) {
+            gate.render(input16.data(), output.data(), FRAMES_PER_BLOCK);
+        }
+        report("AudioGate (1 channel)", 1, usecTimestampNow() - start);
+    }
+
+    {
+        AudioReverb reverb(SAMPLE_RATE);
+        uint64_t start = usecTimestampNow();
+        for (int i = 0; i < NUM_BLOCKS; i++) {
+            reverb.render(input16.data(), output.data(), FRAMES_PER_BLOCK);
+        }
+        report("AudioReverb (2 channel)", 2, usecTimestampNow() - start);
+    }
+
+    {
+        AudioHRTF hrtf;
+        uint64_t start = usecTimestampNow();
+        for (int i = 0; i < NUM_BLOCKS; i++) {
+            memset(outputFloat.data(), 0, outputFloat.size() * sizeof(float));
+            hrtf.render(input16.data(), outputFloat.data(), 0, 0.5f, 2.0f, 1.0f, HRTF_BLOCK);
+        }
+        report("AudioHRTF (1 channel)", 1, usecTimestampNow() - start);
+    }
+}
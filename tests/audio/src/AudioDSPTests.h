@@ -0,0 +1,27 @@
+//
+//  AudioDSPTests.h
+//  tests/audio/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AudioDSPTests_h
+#define hifi_AudioDSPTests_h
+
+#include <QtTest/QtTest>
+
+class AudioDSPTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void limiterCeiling();
+    void limiterPassThrough();
+    void limiterBlockSizes();
+    void limiterKernels();
+    void benchmark();
+};
+
+#endif // hifi_AudioDSPTests_h
@@ -0,0 +1,199 @@
+//
+//  BakeCacheTests.cpp
+//  tests/baking/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "BakeCacheTests.h"
+
+#include <QtCore/QTemporaryDir>
+
+#include <BakeCache.h>
+
+QTEST_GUILESS_MAIN(BakeCacheTests)
+
+static const QString TEST_BAKER_TYPE { "test" };
+static const int BLOB_SIZE { 1000 };
+
+static BakeCachePointer makeBakeCache(const QTemporaryDir& dir) {
+    auto cache = std::make_shared<BakeCache>(dir.path().toStdString());
+    cache->initialize();
+    return cache;
+}
+
+static BakeCache::Key makeKey(int i) {
+    return BakeCache::computeKey(TEST_BAKER_TYPE, QByteArray::number(i), QByteArray());
+}
+
+static BakeCache::Result makeResult(int i) {
+    BakeCache::Result result;
+    result.push_back({ "baked.ktx", QByteArray(BLOB_SIZE, (char)i) });
+    result.push_back({ "baked.txt", QByteArray::number(i) });
+    return result;
+}
+
+static qint64 getDirectorySize(const QTemporaryDir& dir, int* numFiles = nullptr) {
+    qint64 size = 0;
+    auto files = QDir(dir.path()).entryInfoList({ "*.bake" }, QDir::Files);
+    for (const auto& file : files) {
+        size += file.size();
+    }
+    if (numFiles) {
+        *numFiles = files.size();
+    }
+    return size;
+}
+
+void BakeCacheTests::hit() {
+    QTemporaryDir dir;
+    auto cache = makeBakeCache(dir);
+    cache->writeResult(makeKey(1), makeResult(1));
+    cache->flush();
+
+    BakeCache::Result result;
+    QVERIFY(cache->readResult(makeKey(1), result));
+    QCOMPARE(result, makeResult(1));
+    QCOMPARE(cache->getNumHits(), (uint32_t)1);
+    QCOMPARE(cache->getNumMisses(), (uint32_t)0);
+
+    // and in a later session
+    cache.reset();
+    cache = makeBakeCache(dir);
+    result.clear();
+    QVERIFY(cache->readResult(makeKey(1), result));
+    QCOMPARE(result, makeResult(1));
+}
+
+void BakeCacheTests::miss() {
+    QTemporaryDir dir;
+    auto cache = makeBakeCache(dir);
+    cache->writeResult(makeKey(1), makeResult(1));
+    cache->flush();
+
+    // the same source baked with other options, or by another baker, is a different entry
+    BakeCache::Result result;
+    QVERIFY(!cache->readResult(makeKey(2), result));
+    QVERIFY(!cache->readResult(BakeCache::computeKey(TEST_BAKER_TYPE, QByteArray::number(1), "options"), result));
+    QVERIFY(!cache->readResult(BakeCache::computeKey("other", QByteArray::number(1), QByteArray()), result));
+    QVERIFY(result.isEmpty());
+    QCOMPARE(cache->getNumHits(), (uint32_t)0);
+    QCOMPARE(cache->getNumMisses(), (uint32_t)3);
+}
+
+void BakeCacheTests::corruptEntry() {
+    QTemporaryDir dir;
+    auto cache = makeBakeCache(dir);
+    cache->writeResult(makeKey(1), makeResult(1));
+    cache->flush();
+    cache.reset();
+
+    // flip a byte of the first blob, which keeps the record well formed
+    QFile file(QDir(dir.path()).absoluteFilePath(QString::fromStdString(makeKey(1)) + ".bake"));
+    QVERIFY(file.open(QIODevice::ReadWrite));
+    QByteArray contents = file.readAll();
+    int index = contents.indexOf(QByteArray(BLOB_SIZE, (char)1));
+    QVERIFY(index > 0);
+    contents[index + BLOB_SIZE / 2] = 2;
+    QVERIFY(file.seek(0));
+    QCOMPARE(file.write(contents), (qint64)contents.size());
+    file.close();
+
+    cache = makeBakeCache(dir);
+    BakeCache::Result result;
+    QVERIFY(!cache->readResult(makeKey(1), result));
+    QVERIFY(result.isEmpty());
+    QCOMPARE(cache->getNumMisses(), (uint32_t)1);
+
+    // the baker then writes it again, over the corrupt one
+    cache->writeResult(makeKey(1), makeResult(1));
+    cache->flush();
+    QVERIFY(cache->readResult(makeKey(1), result));
+    QCOMPARE(result, makeResult(1));
+}
+
+void BakeCacheTests::sharedDirectory() {
+    QTemporaryDir dir;
+    // two caches on the same directory, as in two oven processes
+    auto cache = makeBakeCache(dir);
+    auto otherCache = makeBakeCache(dir);
+
+    cache->writeResult(makeKey(1), makeResult(1));
+    cache->flush();
+
+    // the other finds what the first wrote since it started, and counts it from then on
+    BakeCache::Result result;
+    QVERIFY(otherCache->readResult(makeKey(1), result));
+    QCOMPARE(result, makeResult(1));
+    QCOMPARE(otherCache->getNumTotalFiles(), (size_t)1);
+}
+
+void BakeCacheTests::eviction() {
+    QTemporaryDir dir;
+    auto cache = makeBakeCache(dir);
+    auto otherCache = makeBakeCache(dir);
+
+    // room for a handful of entries, between the two of them
+    const int NUM_ENTRIES = 5;
+    cache->writeResult(makeKey(0), makeResult(0));
+    cache->flush();
+    int entrySize = (int)getDirectorySize(dir);
+    QVERIFY(entrySize > BLOB_SIZE);
+    const size_t MAX_SIZE = NUM_ENTRIES * entrySize + entrySize / 2;
+    cache->setMaxSize(MAX_SIZE);
+    otherCache->setMaxSize(MAX_SIZE);
+    // each cache only knows of about half of the directory, so without a rescan per pass neither would see it fill
+    cache->setRescanInterval(0);
+    otherCache->setRescanInterval(0);
+
+    for (int i = 1; i < 4 * NUM_ENTRIES; ++i) {
+        auto& writer = (i % 2) ? otherCache : cache;
+        writer->writeResult(makeKey(i), makeResult(i));
+        writer->flush();
+        // keep the access times apart, so that the least recently used is well defined
+        QThread::msleep(10);
+    }
+
+    // the limit applies to the directory, not to what each cache wrote itself
+    int numFiles = 0;
+    QVERIFY(getDirectorySize(dir, &numFiles) <= (qint64)MAX_SIZE);
+    QCOMPARE(numFiles, NUM_ENTRIES);
+
+    // and the oldest were evicted, while the newest are still there
+    BakeCache::Result result;
+    QVERIFY(!cache->readResult(makeKey(0), result));
+    QVERIFY(otherCache->readResult(makeKey(4 * NUM_ENTRIES - 1), result));
+    QCOMPARE(result, makeResult(4 * NUM_ENTRIES - 1));
+}
+
+void BakeCacheTests::rescanInterval() {
+    QTemporaryDir dir;
+    auto cache = makeBakeCache(dir);
+    auto otherCache = makeBakeCache(dir);
+
+    cache->writeResult(makeKey(0), makeResult(0));
+    cache->flush();
+    int entrySize = (int)getDirectorySize(dir);
+    const int NUM_ENTRIES = 10;
+    cache->setMaxSize(NUM_ENTRIES * entrySize * 2);
+
+    // the other process fills the directory, while this cache's own files are far from the limit
+    for (int i = 1; i <= 4 * NUM_ENTRIES; ++i) {
+        otherCache->writeResult(makeKey(i), makeResult(i));
+    }
+    otherCache->flush();
+
+    // between rescans, the cache doesn't see the other process's files
+    cache->writeResult(makeKey(-1), makeResult(-1));
+    cache->flush();
+    QCOMPARE(cache->getNumTotalFiles(), (size_t)2);
+
+    // once one is due, it counts them all and evicts down to the limit
+    cache->setRescanInterval(0);
+    cache->writeResult(makeKey(-2), makeResult(-2));
+    cache->flush();
+    QVERIFY(getDirectorySize(dir) <= (qint64)(NUM_ENTRIES * entrySize * 2));
+}
@@ -0,0 +1,239 @@
+//
+//  FBXParserTests.cpp
+//  tests/fbx/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "FBXParserTests.h"
+
+#include <iostream>
+#include <random>
+
+#include <FBXSerializer.h>
+#include <FBXWriter.h>
+#include <SharedUtil.h>
+#include <test-utils/Utils.h>
+
+QTEST_GUILESS_MAIN(FBXParserTests)
+
+// large enough that the writer compresses them
+static const int NUM_ARRAY_VALUES = 10000;
+
+static FBXNode makeNode(const hifi::ByteArray& name, const QVariantList& properties, const FBXNodeList& children = FBXNodeList()) {
+    FBXNode node;
+    node.name = name;
+    node.properties = properties;
+    node.children = children;
+    return node;
+}
+
+static FBXNode makeDocument() {
+    QVector<double> vertices;
+    QVector<int> indices;
+    QVector<float> weights;
+    QVector<qint64> times;
+    for (int i = 0; i < NUM_ARRAY_VALUES; i++) {
+        vertices.append(i * 0.25);
+        indices.append((i % 3 == 2) ? ~i : i);
+        weights.append(1.0f / (i + 1));
+        times.append((qint64)i << 32);
+    }
+
+    FBXNode geometry = makeNode("Geometry", { QVariant::fromValue((qint64)1234), hifi::ByteArray("Geometry::Mesh", 14) }, {
+        makeNode("Vertices", { QVariant::fromValue(vertices) }),
+        makeNode("PolygonVertexIndex", { QVariant::fromValue(indices) }),
+        makeNode("Weights", { QVariant::fromValue(weights) }),
+        makeNode("KeyTime", { QVariant::fromValue(times) }),
+        makeNode("Small", { QVariant::fromValue(QVector<double>({ 1.0, 2.0, 3.0 })) })
+    });
+    FBXNode top;
+    top.children = {
+        makeNode("Version", { QVariant::fromValue((int)FBX_DRACO_MESH_VERSION), QVariant::fromValue(2.5) }),
+        makeNode("Objects", QVariantList(), { geometry })
+    };
+    return top;
+}
+
+void FBXParserTests::binaryRoundTrip() {
+    FBXNode document = makeDocument();
+    hifi::ByteArray data = FBXWriter::encodeFBX(document);
+    FBXNode top = FBXSerializer::parseFBX(data);
+
+    QCOMPARE(top.children.size(), 2);
+    const FBXNode& version = top.children.at(0);
+    QCOMPARE(version.name, hifi::ByteArray("Version"));
+    QCOMPARE(version.properties.at(0).toInt(), FBX_DRACO_MESH_VERSION);
+    QCOMPARE(version.properties.at(1).toDouble(), 2.5);
+
+    const FBXNode& geometry = top.children.at(1).children.at(0);
+    QCOMPARE(geometry.properties.at(0).value<qint64>(), (qint64)1234);
+    QCOMPARE(geometry.properties.at(1).toByteArray(), hifi::ByteArray("Geometry::Mesh"));
+
+    const FBXNode& expected = document.children.at(1).children.at(0);
+    QCOMPARE(geometry.children.size(), expected.children.size());
+    QCOMPARE(FBXSerializer::getDoubleVector(geometry.children.at(0)), FBXSerializer::getDoubleVector(expected.children.at(0)));
+    QCOMPARE(FBXSerializer::getIntVector(geometry.children.at(1)), FBXSerializer::getIntVector(expected.children.at(1)));
+    QCOMPARE(FBXSerializer::getFloatVector(geometry.children.at(2)), FBXSerializer::getFloatVector(expected.children.at(2)));
+    QCOMPARE(geometry.children.at(3).properties.at(0).value<QVector<qint64>>(),
+             expected.children.at(3).properties.at(0).value<QVector<qint64>>());
+    QCOMPARE(FBXSerializer::getDoubleVector(geometry.children.at(4)), QVector<double>({ 1.0, 2.0, 3.0 }));
+
+    // the same document read through a device
+    QBuffer buffer(&data);
+    buffer.open(QIODevice::ReadOnly);
+    FBXNode fromDevice = FBXSerializer::parseFBX(&buffer);
+    QCOMPARE(FBXSerializer::getDoubleVector(fromDevice.children.at(1).children.at(0).children.at(0)),
+             FBXSerializer::getDoubleVector(expected.children.at(0)));
+}
+
+void FBXParserTests::largeRoundTrip() {
+    // Values below 2^16 compress to about half their size, so that these arrays come to well over the 256 KB of
+    // compressed data above which the parser inflates them in parallel
+    const int NUM_ARRAYS = 8;
+    const int NUM_VALUES = 100000;
+    const int MIN_COMPRESSED_BYTES = 256 * 1024;
+
+    std::mt19937 random(NUM_VALUES);
+    std::uniform_int_distribution<int> value(0, 0xffff);
+    FBXNodeList arrays;
+    for (int i = 0; i < NUM_ARRAYS; i++) {
+        QVector<int> values;
+        for (int j = 0; j < NUM_VALUES; j++) {
+            values.append(value(random));
+        }
+        arrays.append(makeNode("Array", { QVariant::fromValue(values) }));
+    }
+    FBXNode document;
+    document.children = { makeNode("Objects", QVariantList(), arrays) };
+
+    hifi::ByteArray data = FBXWriter::encodeFBX(document);
+    QVERIFY(data.size() > 2 * MIN_COMPRESSED_BYTES);
+    QVERIFY(data.size() < NUM_ARRAYS * NUM_VALUES * (int)sizeof(int));
+
+    FBXNode top = FBXSerializer::parseFBX(data);
+    QCOMPARE(top.children.size(), 1);
+    const FBXNodeList& parsed = top.children.at(0).children;
+    QCOMPARE(parsed.size(), NUM_ARRAYS);
+    for (int i = 0; i < NUM_ARRAYS; i++) {
+        QCOMPARE(FBXSerializer::getIntVector(parsed.at(i)), FBXSerializer::getIntVector(arrays.at(i)));
+    }
+}
+
+void FBXParserTests::textFile() {
+    hifi::ByteArray data =
+        "; FBX 7.3.0 project file\n"
+        "FBXHeaderExtension:  {\n"
+        "\tFBXHeaderVersion: 1003\n"
+        "\tCreator: \"a \\\"quoted\\\" name\"\n"
+        "}\n"
+        "Objects:  {\n"
+        "\tModel: 123, \"Model::Box\", \"Mesh\" {\n"
+        "\t\tVersion: 232\n"
+        "\t}\n"
+        "}\n";
+    FBXNode top = FBXSerializer::parseFBX(data);
+
+    QCOMPARE(top.children.size(), 2);
+    const FBXNode& header = top.children.at(0);
+    QCOMPARE(header.name, hifi::ByteArray("FBXHeaderExtension"));
+    QCOMPARE(header.children.size(), 2);
+    QCOMPARE(header.children.at(0).properties.at(0).toByteArray(), hifi::ByteArray("1003"));
+    QCOMPARE(header.children.at(1).properties.at(0).toByteArray(), hifi::ByteArray("a \"quoted\" name"));
+
+    const FBXNode& model = top.children.at(1).children.at(0);
+    QCOMPARE(model.name, hifi::ByteArray("Model"));
+    QCOMPARE(model.properties.size(), 3);
+    QCOMPARE(model.properties.at(1).toByteArray(), hifi::ByteArray("Model::Box"));
+    QCOMPARE(model.children.at(0).name, hifi::ByteArray("Version"));
+}
+
+void FBXParserTests::truncatedFile() {
+    hifi::ByteArray data = FBXWriter::encodeFBX(makeDocument());
+    data.truncate(data.size() / 2);
+    bool thrown = false;
+    try {
+        FBXSerializer::parseFBX(data);
+    } catch (const QString&) {
+        thrown = true;
+    }
+    QVERIFY(thrown);
+}
+
+#ifdef MANUAL_TEST
+
+struct TreeBytes {
+    quint64 arrays { 0 };
+    // the nodes, their names and properties, and the arrays
+    quint64 total { 0 };
+};
+
+static void getTreeBytes(const FBXNode& node, TreeBytes& bytes) {
+    bytes.total += sizeof(FBXNode) + node.name.capacity() + node.properties.size() * sizeof(QVariant);
+    for (const auto& property : node.properties) {
+        int type = property.userType();
+        quint64 arrayBytes = 0;
+        if (type == qMetaTypeId<QVector<double>>()) {
+            arrayBytes = property.value<QVector<double>>().capacity() * sizeof(double);
+        } else if (type == qMetaTypeId<QVector<float>>()) {
+            arrayBytes = property.value<QVector<float>>().capacity() * sizeof(float);
+        } else if (type == qMetaTypeId<QVector<int>>()) {
+            arrayBytes = property.value<QVector<int>>().capacity() * sizeof(int);
+        } else if (type == qMetaTypeId<QVector<qint64>>()) {
+            arrayBytes = property.value<QVector<qint64>>().capacity() * sizeof(qint64);
+        } else if (type == qMetaTypeId<QVector<bool>>()) {
+            arrayBytes = property.value<QVector<bool>>().capacity() * sizeof(bool);
+        } else if (type == QMetaType::QByteArray) {
+            bytes.total += property.toByteArray().capacity();
+        }
+        bytes.arrays += arrayBytes;
+        bytes.total += arrayBytes;
+    }
+    for (const auto& child : node.children) {
+        getTreeBytes(child, bytes);
+    }
+}
+
+void FBXParserTests::parseBenchmark() {
+    const int NUM_RUNS = 5;
+
+    auto files = getFBXTestFiles({ "*.fbx" });
+    if (files.isEmpty()) {
+        QSKIP("Set HIFI_FBX_TEST_DIR to a directory of binary FBX files");
+    }
+
+    for (const auto& fileInfo : files) {
+        QFile file(fileInfo.absoluteFilePath());
+        QVERIFY(file.open(QIODevice::ReadOnly));
+        hifi::ByteArray data = file.readAll();
+
+        quint64 start = usecTimestampNow();
+        for (int i = 0; i < NUM_RUNS; i++) {
+            FBXSerializer::parseFBX(data);
+        }
+        quint64 elapsed = (usecTimestampNow() - start) / NUM_RUNS;
+
+        // the memory a parsed tree holds, and, where the platform reports it, what the process gains while holding it
+        MemoryInfo before;
+        MemoryInfo after;
+        bool hasMemoryInfo = getMemoryInfo(before);
+        FBXNode top = FBXSerializer::parseFBX(data);
+        hasMemoryInfo = hasMemoryInfo && getMemoryInfo(after);
+        TreeBytes treeBytes;
+        getTreeBytes(top, treeBytes);
+
+        std::cout << qPrintable(fileInfo.fileName()) << ": " << data.size() / BYTES_PER_KILOBYTE << " KB, parsed in "
+                  << (float)elapsed / USECS_PER_MSEC << " ms, tree of " << treeBytes.total / BYTES_PER_KILOBYTE
+                  << " KB with " << treeBytes.arrays / BYTES_PER_KILOBYTE << " KB of arrays";
+        if (hasMemoryInfo) {
+            qint64 processBytes = (qint64)after.processUsedMemoryBytes - (qint64)before.processUsedMemoryBytes;
+            std::cout << ", process grew " << processBytes / BYTES_PER_KILOBYTE << " KB";
+        }
+        std::cout << std::endl;
+    }
+}
+
+#endif // MANUAL_TEST
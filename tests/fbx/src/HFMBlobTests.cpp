@@ -0,0 +1,231 @@
+//
+//  HFMBlobTests.cpp
+//  tests/fbx/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "HFMBlobTests.h"
+
+#include <functional>
+#include <iostream>
+#include <limits>
+
+#include <FBXSerializer.h>
+#include <HFMBlob.h>
+#include <HFMBlobSerializer.h>
+#include <HFMBlobWriter.h>
+#include <SharedUtil.h>
+#include <test-utils/Utils.h>
+
+QTEST_GUILESS_MAIN(HFMBlobTests)
+
+static hfm::Model makeModel() {
+    hfm::Model model;
+    model.originalURL = "file:///model.fbx";
+    model.author = "author";
+    for (int i = 0; i < 3; i++) {
+        hfm::Joint joint;
+        joint.name = "joint" + QString::number(i);
+        joint.parentIndex = i - 1;
+        joint.translation = glm::vec3(i, 2.0f, 3.0f);
+        joint.shapeInfo.points = { glm::vec3(1.0f, 2.0f, 3.0f) };
+        joint.isSkeletonJoint = (i == 1);
+        joint.bindTransformFoundInCluster = false;
+        joint.hasGeometricOffset = false;
+        model.joints.append(joint);
+        model.jointIndices.insert(joint.name, i + 1);
+    }
+    model.jointRotationOffsets.insert(1, glm::quat(0.5f, 0.5f, 0.5f, 0.5f));
+
+    for (int i = 0; i < 2; i++) {
+        hfm::Mesh mesh;
+        for (int j = 0; j < 7 + i; j++) {
+            mesh.vertices.append(glm::vec3(j, i, 1.0f));
+            mesh.normals.append(glm::vec3(0.0f, 0.0f, 1.0f));
+            mesh.texCoords.append(glm::vec2(j, 1.0f));
+            mesh.clusterIndices.append((uint16_t)j);
+        }
+        hfm::MeshPart part;
+        part.triangleIndices = { 0, 5, 6 };
+        part.materialID = "material";
+        mesh.parts.append(part);
+
+        hfm::Blendshape blendshape;
+        blendshape.indices.append(2);
+        blendshape.vertices.append(glm::vec3(9.0f));
+        mesh.blendshapes.append(blendshape);
+
+        hfm::Cluster cluster;
+        cluster.jointIndex = 1;
+        cluster.inverseBindTransform.setTranslation(glm::vec3(4.0f, 5.0f, 6.0f));
+        mesh.clusters.append(cluster);
+
+        mesh.meshIndex = i;
+        mesh.meshExtents.minimum = glm::vec3(-1.0f);
+        model.meshes.append(mesh);
+    }
+
+    hfm::Material material;
+    material.materialID = "material";
+    material.albedoTexture.filename = "albedo.png";
+    material.albedoTexture.content = hifi::ByteArray("\x01\x02\x03", 3);
+    material.useAlbedoMap = true;
+    material._material = std::make_shared<graphics::Material>();
+    material._material->setAlbedo(glm::vec3(0.5f), false);
+    model.materials.insert(material.materialID, material);
+
+    model.meshIndicesToModelNames.insert(1, "second");
+    model.blendshapeChannelNames.append("smile");
+    model.hasSkeletonJoints = true;
+    return model;
+}
+
+void HFMBlobTests::roundTrip() {
+    hfm::Model model = makeModel();
+    QByteArray blob = HFMBlobWriter::encodeHFMBlob(model);
+    QCOMPARE(blob.size() % (int)hfm::blob::ALIGNMENT, 0);
+    QCOMPARE(HFMBlobWriter::encodeHFMBlob(model), blob);
+
+    // read from an unaligned copy, as the data of a network reply may be
+    QByteArray shifted = "x" + blob;
+    HFMModel::Pointer result = HFMBlobSerializer().read(QByteArray::fromRawData(shifted.constData() + 1, blob.size()),
+                                                        hifi::VariantHash());
+    QVERIFY(result);
+
+    QCOMPARE(result->originalURL, model.originalURL);
+    QCOMPARE(result->author, model.author);
+    QCOMPARE(result->joints.size(), model.joints.size());
+    for (int i = 0; i < model.joints.size(); i++) {
+        QCOMPARE(result->joints[i].name, model.joints[i].name);
+        QCOMPARE(result->joints[i].parentIndex, model.joints[i].parentIndex);
+        QCOMPARE(result->joints[i].translation, model.joints[i].translation);
+        QCOMPARE(result->joints[i].isSkeletonJoint, model.joints[i].isSkeletonJoint);
+        QCOMPARE(result->joints[i].shapeInfo.points, model.joints[i].shapeInfo.points);
+    }
+    QCOMPARE(result->getJointIndex("joint2"), 2);
+    QCOMPARE(result->jointRotationOffsets.at(1), model.jointRotationOffsets.at(1));
+
+    QCOMPARE(result->meshes.size(), model.meshes.size());
+    for (int i = 0; i < model.meshes.size(); i++) {
+        const hfm::Mesh& mesh = result->meshes[i];
+        const hfm::Mesh& expected = model.meshes[i];
+        QCOMPARE(mesh.vertices, expected.vertices);
+        QCOMPARE(mesh.normals, expected.normals);
+        QVERIFY(mesh.tangents.isEmpty());
+        QCOMPARE(mesh.texCoords, expected.texCoords);
+        QCOMPARE(mesh.clusterIndices, expected.clusterIndices);
+        QCOMPARE(mesh.parts[0].triangleIndices, expected.parts[0].triangleIndices);
+        QCOMPARE(mesh.parts[0].materialID, expected.parts[0].materialID);
+        QCOMPARE(mesh.blendshapes[0].indices, expected.blendshapes[0].indices);
+        QCOMPARE(mesh.blendshapes[0].vertices, expected.blendshapes[0].vertices);
+        QCOMPARE(mesh.clusters[0].inverseBindTransform.getTranslation(), glm::vec3(4.0f, 5.0f, 6.0f));
+        QCOMPARE(mesh.meshIndex, expected.meshIndex);
+        QCOMPARE(mesh.meshExtents.minimum, expected.meshExtents.minimum);
+    }
+
+    const hfm::Material& material = result->materials.at(QString("material"));
+    QCOMPARE(material.albedoTexture.filename, QByteArray("albedo.png"));
+    QCOMPARE(material.albedoTexture.content, QByteArray("\x01\x02\x03", 3));
+    QVERIFY(material.useAlbedoMap);
+    QVERIFY(!material.useNormalMap);
+    QVERIFY(material._material);
+    QCOMPARE(material._material->getAlbedo(false), glm::vec3(0.5f));
+
+    QCOMPARE(result->meshIndicesToModelNames.at(1), QString("second"));
+    QCOMPARE(result->blendshapeChannelNames, model.blendshapeChannelNames);
+    QVERIFY(result->hasSkeletonJoints);
+}
+
+void HFMBlobTests::corruptBlob() {
+    QByteArray blob = HFMBlobWriter::encodeHFMBlob(makeModel());
+    HFMBlobSerializer serializer;
+
+    for (int size : { 0, 8, (int)sizeof(hfm::blob::Header), blob.size() - (int)hfm::blob::ALIGNMENT }) {
+        QVERIFY(!serializer.read(blob.left(size), hifi::VariantHash()));
+    }
+
+    // arrays that run past the end of the blob
+    hfm::blob::Header header;
+    memcpy((void*)&header, blob.constData(), sizeof(header));
+    QByteArray corrupt = blob;
+    hfm::blob::Header badOffset = header;
+    badOffset.meshes.offset = blob.size() - 8;
+    memcpy(corrupt.data(), &badOffset, sizeof(badOffset));
+    QVERIFY(!serializer.read(corrupt, hifi::VariantHash()));
+
+    hfm::blob::Header badCount = header;
+    badCount.meshes.count = std::numeric_limits<uint64_t>::max() / 2;
+    memcpy(corrupt.data(), &badCount, sizeof(badCount));
+    QVERIFY(!serializer.read(corrupt, hifi::VariantHash()));
+
+    // a count that fits in the blob's bytes but not in its records
+    hfm::blob::Header badRecordCount = header;
+    badRecordCount.meshes.count = blob.size() - header.meshes.offset;
+    memcpy(corrupt.data(), &badRecordCount, sizeof(badRecordCount));
+    QVERIFY(!serializer.read(corrupt, hifi::VariantHash()));
+
+    hfm::blob::Header badVersion = header;
+    badVersion.version = hfm::blob::VERSION + 1;
+    memcpy(corrupt.data(), &badVersion, sizeof(badVersion));
+    QVERIFY(!serializer.read(corrupt, hifi::VariantHash()));
+
+    // indices that are in the blob but out of range of what they index
+    std::vector<std::function<void(hfm::Model&)>> corruptions = {
+        [](hfm::Model& model) { model.meshes[0].parts[0].triangleIndices[1] = 7; },
+        [](hfm::Model& model) { model.meshes[1].parts[0].quadIndices = { 0, 1, 2, 100 }; },
+        [](hfm::Model& model) { model.meshes[0].parts[0].triangleIndices[0] = -1; },
+        [](hfm::Model& model) { model.meshes[0].clusters[0].jointIndex = 3; },
+        [](hfm::Model& model) { model.joints[2].parentIndex = 3; },
+        [](hfm::Model& model) { model.joints[0].parentIndex = -2; },
+        [](hfm::Model& model) { model.meshes[1].blendshapes[0].indices[0] = 8; }
+    };
+    for (const auto& corruption : corruptions) {
+        hfm::Model model = makeModel();
+        corruption(model);
+        QVERIFY(!serializer.read(HFMBlobWriter::encodeHFMBlob(model), hifi::VariantHash()));
+    }
+}
+
+#ifdef MANUAL_TEST
+
+void HFMBlobTests::loadBenchmark() {
+    const int NUM_RUNS = 5;
+
+    // baked models, each <name>.baked.fbx beside the <name>.baked.hfm written with it
+    auto files = getFBXTestFiles({ "*.baked.fbx" });
+    if (files.isEmpty()) {
+        QSKIP("Set HIFI_FBX_TEST_DIR to a directory of baked models");
+    }
+
+    for (const auto& fileInfo : files) {
+        QString blobPath = fileInfo.absolutePath() + "/" + fileInfo.completeBaseName() + ".hfm";
+        if (!QFile::exists(blobPath)) {
+            continue;
+        }
+        QFile file(fileInfo.absoluteFilePath());
+        QVERIFY(file.open(QIODevice::ReadOnly));
+        hifi::ByteArray data = file.readAll();
+
+        quint64 start = usecTimestampNow();
+        for (int i = 0; i < NUM_RUNS; i++) {
+            QVERIFY(FBXSerializer().read(data, hifi::VariantHash(), QUrl::fromLocalFile(file.fileName())));
+        }
+        quint64 fbxElapsed = (usecTimestampNow() - start) / NUM_RUNS;
+
+        start = usecTimestampNow();
+        for (int i = 0; i < NUM_RUNS; i++) {
+            QVERIFY(HFMBlobSerializer::readFile(blobPath));
+        }
+        quint64 blobElapsed = (usecTimestampNow() - start) / NUM_RUNS;
+
+        std::cout << qPrintable(fileInfo.fileName()) << ": FBX read in " << (float)fbxElapsed / USECS_PER_MSEC
+                  << " ms, blob (" << QFileInfo(blobPath).size() / BYTES_PER_KILOBYTE << " KB) read in "
+                  << (float)blobElapsed / USECS_PER_MSEC << " ms" << std::endl;
+    }
+}
+
+#endif // MANUAL_TEST
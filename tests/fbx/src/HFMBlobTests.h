@@ -0,0 +1,26 @@
+//
+//  HFMBlobTests.h
+//  tests/fbx/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_HFMBlobTests_h
+#define hifi_HFMBlobTests_h
+
+#include <QtTest/QtTest>
+
+class HFMBlobTests : public QObject {
+    Q_OBJECT
+private slots:
+    void roundTrip();
+    void corruptBlob();
+#ifdef MANUAL_TEST
+    void loadBenchmark();
+#endif // MANUAL_TEST
+};
+
+#endif // hifi_HFMBlobTests_h
@@ -0,0 +1,367 @@
+//
+//  JitterBufferTests.cpp
+//  tests/jitter/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "JitterBufferTests.h"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include <QtCore/QFile>
+#include <QtCore/QTextStream>
+
+#include <AudioConstants.h>
+#include <AudioJitterEstimator.h>
+#include <AudioRingBuffer.h>
+#include <AudioTimeStretch.h>
+#include <NumericalConstants.h>
+
+QTEST_MAIN(JitterBufferTests)
+
+// set this to a file of "<arrival usecs> <sequence number>" lines, as logged by a receiving node, to replay it
+static const char* TRACE_FILE_ENVIRONMENT_VARIABLE = "HIFI_JITTER_TRACE";
+
+static const int FRAME_SAMPLES = AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL;
+static const quint64 FRAME_USECS = AudioConstants::NETWORK_FRAME_USECS;
+
+// 200Hz at 24kHz, so the pitch period is 120 samples
+static const int TONE_PERIOD = 120;
+static const float TONE_AMPLITUDE = 8000.0f;
+
+// largest step between consecutive samples of the tone, with some headroom for the cross-fades
+static const int MAX_TONE_STEP = (int)(TONE_AMPLITUDE * TWO_PI / TONE_PERIOD * 1.5f);
+
+struct TracePacket {
+    quint64 arrivalUsecs;
+    int sequence;
+};
+
+struct ReplayResult {
+    int framesPlayed { 0 };
+    int starves { 0 };
+    int accelerated { 0 };
+    int expanded { 0 };
+    double averageLatencyMsecs { 0.0 };
+};
+
+static void fillTone(int16_t* samples, int numFrames, int numChannels, int firstFrame) {
+    for (int i = 0; i < numFrames; ++i) {
+        float phase = TWO_PI * ((firstFrame + i) % TONE_PERIOD) / TONE_PERIOD;
+        for (int c = 0; c < numChannels; ++c) {
+            samples[i * numChannels + c] = (int16_t)(TONE_AMPLITUDE * sinf(phase));
+        }
+    }
+}
+
+static int maxStep(const AudioRingBuffer& buffer, int numChannels, int numFrames, int previous) {
+    int step = std::abs(buffer[0] - previous);
+    for (int i = 1; i < numFrames; ++i) {
+        step = std::max(step, std::abs(buffer[i * numChannels] - buffer[(i - 1) * numChannels]));
+    }
+    return step;
+}
+
+static std::vector<TracePacket> makeTrace(int numPackets, double meanJitterUsecs, int spikeInterval, quint64 spikeUsecs,
+                                          double lossRate, unsigned int seed) {
+    const quint64 BASE_DELAY_USECS = 20000;
+
+    std::mt19937 random(seed);
+    std::exponential_distribution<double> jitter(1.0 / meanJitterUsecs);
+    std::uniform_real_distribution<double> loss(0.0, 1.0);
+
+    std::vector<TracePacket> trace;
+    for (int i = 0; i < numPackets; ++i) {
+        if (loss(random) < lossRate) {
+            continue;
+        }
+        quint64 arrival = i * FRAME_USECS + BASE_DELAY_USECS + (quint64)jitter(random);
+        if (spikeInterval > 0 && i % spikeInterval == spikeInterval - 1) {
+            arrival += spikeUsecs;
+        }
+        trace.push_back({ arrival, i });
+    }
+    std::stable_sort(trace.begin(), trace.end(), [](const TracePacket& a, const TracePacket& b) {
+        return a.arrivalUsecs < b.arrivalUsecs;
+    });
+    return trace;
+}
+
+// plays a trace through a mono jitter buffer drained once per network frame, following the policy of InboundAudioStream.
+// a staticFrames of 0 uses the adaptive estimator and time-stretching.
+static ReplayResult replay(const std::vector<TracePacket>& trace, int staticFrames) {
+    const int FRAME_CAPACITY = 100;
+    const int MAX_DESIRED_FRAMES = FRAME_CAPACITY / 2;
+    const int MAX_FRAMES_OVER_DESIRED = 10;
+
+    ReplayResult result;
+    if (trace.empty()) {
+        return result;
+    }
+
+    AudioRingBuffer buffer(FRAME_SAMPLES, FRAME_CAPACITY);
+    AudioJitterEstimator estimator;
+    bool dynamic = (staticFrames == 0);
+    int desired = dynamic ? 1 : staticFrames;
+    bool starved = true;
+    int expectedSequence = trace.front().sequence;
+    quint64 lastArrivalUsecs = 0;
+    double latencySum = 0.0;
+    int16_t frame[FRAME_SAMPLES];
+
+    size_t next = 0;
+    for (quint64 now = trace.front().arrivalUsecs; next < trace.size(); now += FRAME_USECS) {
+        for (; next < trace.size() && trace[next].arrivalUsecs <= now; ++next) {
+            const TracePacket& packet = trace[next];
+            if (packet.sequence < expectedSequence) {
+                // late packets are ignored
+                continue;
+            }
+            int sequenceFrames = packet.sequence - expectedSequence + 1;
+            estimator.packetReceived(packet.arrivalUsecs, sequenceFrames);
+            lastArrivalUsecs = packet.arrivalUsecs;
+            if (dynamic) {
+                desired = std::min(estimator.getTargetFrames(), MAX_DESIRED_FRAMES);
+            }
+
+            // conceal lost packets with silence
+            buffer.addSilentSamples((sequenceFrames - 1) * FRAME_SAMPLES);
+            fillTone(frame, FRAME_SAMPLES, 1, packet.sequence * FRAME_SAMPLES);
+            buffer.writeSamples(frame, FRAME_SAMPLES);
+            expectedSequence = packet.sequence + 1;
+
+            if (starved && buffer.framesAvailable() >= desired) {
+                starved = false;
+            }
+            if (buffer.framesAvailable() > desired + MAX_FRAMES_OVER_DESIRED) {
+                buffer.shiftReadPosition((buffer.framesAvailable() - desired - 1) * FRAME_SAMPLES);
+            }
+        }
+
+        if (starved) {
+            continue;
+        }
+        if (buffer.samplesAvailable() < FRAME_SAMPLES) {
+            result.starves++;
+            if (dynamic) {
+                int framesSinceLastPacket = (int)((now - lastArrivalUsecs + FRAME_USECS - 1) / FRAME_USECS);
+                estimator.starved(now, framesSinceLastPacket);
+                desired = std::min(estimator.getTargetFrames(), MAX_DESIRED_FRAMES);
+            }
+            starved = true;
+            buffer.shiftReadPosition(buffer.samplesAvailable());
+            continue;
+        }
+
+        if (dynamic) {
+            int framesAvailable = buffer.framesAvailable();
+            if (framesAvailable > desired + 1) {
+                if (buffer.samplesAvailable() - AudioTimeStretch::MAX_LAG >= FRAME_SAMPLES &&
+                    AudioTimeStretch::accelerate(buffer, 1) > 0) {
+                    result.accelerated++;
+                }
+            } else if (framesAvailable < desired) {
+                if (AudioTimeStretch::expand(buffer, 1) > 0) {
+                    result.expanded++;
+                }
+            }
+        }
+
+        latencySum += buffer.samplesAvailable() * AudioConstants::NETWORK_FRAME_MSECS / FRAME_SAMPLES;
+        buffer.shiftReadPosition(FRAME_SAMPLES);
+        result.framesPlayed++;
+    }
+
+    result.averageLatencyMsecs = (result.framesPlayed > 0) ? latencySum / result.framesPlayed : 0.0;
+    return result;
+}
+
+static void report(const char* name, const ReplayResult& result) {
+    qDebug("%-12s played %6d starves %5d accelerated %5d expanded %5d average latency %6.1fms",
+           name, result.framesPlayed, result.starves, result.accelerated, result.expanded, result.averageLatencyMsecs);
+}
+
+void JitterBufferTests::steadyStream() {
+    AudioJitterEstimator estimator;
+    for (int i = 0; i < 1000; ++i) {
+        estimator.packetReceived(USECS_PER_SECOND + i * FRAME_USECS);
+    }
+    QCOMPARE(estimator.getTargetFrames(), 1);
+    QCOMPARE(estimator.getPeakFrames(), 0);
+}
+
+void JitterBufferTests::burstyStream() {
+    // three frames at a time, every three frames
+    AudioJitterEstimator estimator;
+    const int BURST = 3;
+    for (int i = 0; i < 30; ++i) {
+        estimator.packetReceived(USECS_PER_SECOND + (i / BURST) * BURST * FRAME_USECS);
+    }
+    QCOMPARE(estimator.getPercentileFrames(), BURST);
+    QCOMPARE(estimator.getTargetFrames(), BURST);
+}
+
+void JitterBufferTests::latePacketPeak() {
+    AudioJitterEstimator estimator;
+    quint64 now = USECS_PER_SECOND;
+    int sequence = 0;
+    for (; sequence < 500; ++sequence) {
+        now = USECS_PER_SECOND + sequence * FRAME_USECS;
+        estimator.packetReceived(now);
+    }
+    QCOMPARE(estimator.getTargetFrames(), 1);
+
+    // the network stalls for 80ms, then the held packets arrive together
+    const int STALL_FRAMES = 8;
+    now += (STALL_FRAMES + 1) * FRAME_USECS;
+    for (int i = 0; i <= STALL_FRAMES; ++i, ++sequence) {
+        estimator.packetReceived(now);
+    }
+    QVERIFY(estimator.getTargetFrames() >= STALL_FRAMES + 1);
+
+    // a single stall is too rare for the percentile, so the target falls back once the peak is released
+    quint64 released = now + AudioJitterEstimator::PEAK_HOLD_USECS + FRAME_USECS;
+    while (now <= released) {
+        now += FRAME_USECS;
+        estimator.packetReceived(now);
+    }
+    QCOMPARE(estimator.getPeakFrames(), 0);
+    QCOMPARE(estimator.getTargetFrames(), 1);
+}
+
+void JitterBufferTests::accelerate() {
+    const int NUM_CHANNELS = 2;
+    const int NUM_FRAMES = 4;
+    AudioRingBuffer buffer(FRAME_SAMPLES * NUM_CHANNELS, 10);
+
+    int16_t samples[FRAME_SAMPLES * NUM_CHANNELS * NUM_FRAMES];
+    fillTone(samples, FRAME_SAMPLES * NUM_FRAMES, NUM_CHANNELS, 0);
+    buffer.writeSamples(samples, FRAME_SAMPLES * NUM_CHANNELS * NUM_FRAMES);
+
+    int lag = AudioTimeStretch::accelerate(buffer, NUM_CHANNELS);
+    QVERIFY(lag >= AudioTimeStretch::MIN_LAG && lag <= AudioTimeStretch::MAX_LAG);
+
+    // the removed segment lines up with the pitch period, and nothing else is lost
+    int periodOffset = lag % TONE_PERIOD;
+    QVERIFY(std::min(periodOffset, TONE_PERIOD - periodOffset) <= 1);
+    QCOMPARE(buffer.samplesAvailable(), (FRAME_SAMPLES * NUM_FRAMES - lag) * NUM_CHANNELS);
+
+    // and the result is still a smooth tone
+    QVERIFY(maxStep(buffer, NUM_CHANNELS, FRAME_SAMPLES * NUM_FRAMES - lag, buffer[0]) <= MAX_TONE_STEP);
+}
+
+void JitterBufferTests::expand() {
+    const int NUM_CHANNELS = 2;
+    const int NUM_FRAMES = 4;
+    AudioRingBuffer buffer(FRAME_SAMPLES * NUM_CHANNELS, 10);
+
+    int16_t samples[FRAME_SAMPLES * NUM_CHANNELS * NUM_FRAMES];
+    fillTone(samples, FRAME_SAMPLES * NUM_FRAMES, NUM_CHANNELS, 0);
+    buffer.writeSamples(samples, FRAME_SAMPLES * NUM_CHANNELS * NUM_FRAMES);
+
+    // play the first frame, so the expansion has room behind the read position
+    buffer.shiftReadPosition(FRAME_SAMPLES * NUM_CHANNELS);
+    int lastPlayed = samples[(FRAME_SAMPLES - 1) * NUM_CHANNELS];
+
+    int lag = AudioTimeStretch::expand(buffer, NUM_CHANNELS);
+    QVERIFY(lag >= AudioTimeStretch::MIN_LAG && lag <= AudioTimeStretch::MAX_LAG);
+
+    int periodOffset = lag % TONE_PERIOD;
+    QVERIFY(std::min(periodOffset, TONE_PERIOD - periodOffset) <= 1);
+    int remainingFrames = FRAME_SAMPLES * (NUM_FRAMES - 1) + lag;
+    QCOMPARE(buffer.samplesAvailable(), remainingFrames * NUM_CHANNELS);
+
+    // the inserted period continues smoothly from what was already played
+    QVERIFY(maxStep(buffer, NUM_CHANNELS, remainingFrames, lastPlayed) <= MAX_TONE_STEP);
+}
+
+void JitterBufferTests::stretchAtDeviceRate() {
+    // a client's buffer holds audio resampled to its output device, so the same tone has twice the period
+    const int SAMPLE_RATE = 48000;
+    const int DEVICE_FRAME_SAMPLES = FRAME_SAMPLES * SAMPLE_RATE / AudioConstants::SAMPLE_RATE;
+    const int DEVICE_TONE_PERIOD = TONE_PERIOD * SAMPLE_RATE / AudioConstants::SAMPLE_RATE;
+    const int NUM_FRAMES = 4;
+    AudioRingBuffer buffer(DEVICE_FRAME_SAMPLES, 10);
+
+    std::vector<int16_t> samples(DEVICE_FRAME_SAMPLES * NUM_FRAMES);
+    for (size_t i = 0; i < samples.size(); ++i) {
+        samples[i] = (int16_t)(TONE_AMPLITUDE * sinf(TWO_PI * (i % DEVICE_TONE_PERIOD) / DEVICE_TONE_PERIOD));
+    }
+    buffer.writeSamples(samples.data(), (int)samples.size());
+    buffer.shiftReadPosition(DEVICE_FRAME_SAMPLES);
+
+    // the search covers the same span of time as at the network rate, so it still finds the whole period
+    int lag = AudioTimeStretch::expand(buffer, 1, SAMPLE_RATE);
+    QVERIFY(lag >= AudioTimeStretch::getMinLag(SAMPLE_RATE) && lag <= AudioTimeStretch::getMaxLag(SAMPLE_RATE));
+    int periodOffset = lag % DEVICE_TONE_PERIOD;
+    QVERIFY(std::min(periodOffset, DEVICE_TONE_PERIOD - periodOffset) <= 1);
+    QCOMPARE(buffer.samplesAvailable(), DEVICE_FRAME_SAMPLES * (NUM_FRAMES - 1) + lag);
+
+    lag = AudioTimeStretch::accelerate(buffer, 1, SAMPLE_RATE);
+    QVERIFY(lag >= AudioTimeStretch::getMinLag(SAMPLE_RATE) && lag <= AudioTimeStretch::getMaxLag(SAMPLE_RATE));
+    periodOffset = lag % DEVICE_TONE_PERIOD;
+    QVERIFY(std::min(periodOffset, DEVICE_TONE_PERIOD - periodOffset) <= 1);
+}
+
+void JitterBufferTests::replaySyntheticTrace() {
+    // 60s of a link with ~8ms of exponential jitter, 1% loss, and a 100ms stall every 10s
+    auto trace = makeTrace(6000, 8000.0, 1000, 100000, 0.01, 42);
+
+    ReplayResult adaptive = replay(trace, 0);
+    ReplayResult minimal = replay(trace, 1);
+    ReplayResult generous = replay(trace, 20);
+    report("adaptive", adaptive);
+    report("static 1", minimal);
+    report("static 20", generous);
+
+    QVERIFY(adaptive.framesPlayed > 0);
+    QVERIFY(adaptive.starves < minimal.starves);
+    QVERIFY(adaptive.starves < adaptive.framesPlayed / 20);
+    QVERIFY(adaptive.averageLatencyMsecs < generous.averageLatencyMsecs);
+}
+
+void JitterBufferTests::replayRecordedTrace() {
+    QString path = qgetenv(TRACE_FILE_ENVIRONMENT_VARIABLE);
+    if (path.isEmpty()) {
+        QSKIP("set HIFI_JITTER_TRACE to replay a recorded arrival-time trace");
+    }
+
+    QFile file(path);
+    QVERIFY2(file.open(QIODevice::ReadOnly | QIODevice::Text), qPrintable("cannot open " + path));
+
+    // sequence numbers are 16 bits on the wire, so unwrap them as they are read
+    std::vector<TracePacket> trace;
+    QTextStream stream(&file);
+    quint16 lastSequence = 0;
+    int sequence = 0;
+    while (!stream.atEnd()) {
+        QString line = stream.readLine().trimmed();
+        if (line.isEmpty() || line.startsWith('#')) {
+            continue;
+        }
+        QStringList fields = line.split(QRegExp("\\s+"));
+        if (fields.size() < 2) {
+            continue;
+        }
+        quint64 arrivalUsecs = fields[0].toULongLong();
+        quint16 wireSequence = (quint16)fields[1].toUInt();
+        sequence = trace.empty() ? 0 : sequence + (qint16)(wireSequence - lastSequence);
+        lastSequence = wireSequence;
+        trace.push_back({ arrivalUsecs, sequence });
+    }
+    QVERIFY(!trace.empty());
+
+    ReplayResult adaptive = replay(trace, 0);
+    report("adaptive", adaptive);
+    for (int frames : { 1, 3, 5, 10 }) {
+        report(qPrintable(QString("static %1").arg(frames)), replay(trace, frames));
+    }
+    QVERIFY(adaptive.framesPlayed > 0);
+}
@@ -0,0 +1,30 @@
+//
+//  JitterBufferTests.h
+//  tests/jitter/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_JitterBufferTests_h
+#define hifi_JitterBufferTests_h
+
+#include <QtTest/QtTest>
+
+class JitterBufferTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void steadyStream();
+    void burstyStream();
+    void latePacketPeak();
+    void accelerate();
+    void expand();
+    void stretchAtDeviceRate();
+    void replaySyntheticTrace();
+    void replayRecordedTrace();
+};
+
+#endif // hifi_JitterBufferTests_h
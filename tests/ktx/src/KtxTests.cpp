@@ -8,6 +8,9 @@
 
 #include "KtxTests.h"
 
+#include <functional>
+#include <iostream>
+#include <limits>
 #include <mutex>
 
 #include <QtTest/QtTest>
@@ -15,6 +18,9 @@
 #include <ktx/KTX.h>
 #include <gpu/Texture.h>
 #include <image/Image.h>
+#include <image/TextureProcessing.h>
+#include <NumericalConstants.h>
+#include <SharedUtil.h>
 
 
 QTEST_GUILESS_MAIN(KtxTests)
@@ -142,6 +148,170 @@ void KtxTests::testKtxSerialization() {
     testTexture->setKtxBacking(TEST_IMAGE_KTX.fileName().toStdString());
 }
 
+void KtxTests::testMipRanges() {
+    const int SIZE = 256;
+    QImage source(SIZE, SIZE, QImage::Format_RGB32);
+    for (int y = 0; y < SIZE; y++) {
+        auto line = reinterpret_cast<QRgb*>(source.scanLine(y));
+        for (int x = 0; x < SIZE; x++) {
+            int noise = (x * 7919 + y * 104729) % 64;
+            line[x] = qRgb((x + noise) % 256, (y + noise) % 256, (x + y + noise) % 256);
+        }
+    }
+    std::atomic<bool> abortSignal { false };
+    auto texture = image::TextureUsage::process2DTextureColorFromImage(QImage(source), "ranges", true,
+                                                                        gpu::BackendTarget::GL45, false, abortSignal);
+    QVERIFY(texture.get());
+    auto ktxMemory = gpu::Texture::serialize(*texture);
+    QVERIFY(ktxMemory.get());
+    auto descriptor = ktxMemory->toDescriptor();
+    const auto& images = descriptor.images;
+    QVERIFY(images.size() > 4);
+    const uint16_t highMip = (uint16_t)images.size() - 1;
+    const size_t UNLIMITED = std::numeric_limits<size_t>::max();
+
+    // a range holds at least its highest mip, and goes no lower than asked
+    QCOMPARE(descriptor.getLowestMipInRange(highMip, 0, images[highMip]._imageSize), highMip);
+    QCOMPARE(descriptor.getLowestMipInRange(highMip, 0, UNLIMITED), (uint16_t)0);
+    QCOMPARE(descriptor.getLowestMipInRange(highMip, 2, UNLIMITED), (uint16_t)2);
+
+    // otherwise it stops at the mip that would take it past the limit
+    const size_t maxRangeSize = images[1]._imageSize;
+    uint16_t lowMip = descriptor.getLowestMipInRange(highMip, 0, maxRangeSize);
+    QVERIFY(lowMip > 0 && lowMip < highMip);
+    auto rangeBytes = descriptor.getMipRangeBytes(lowMip, highMip);
+    QVERIFY(rangeBytes.second - rangeBytes.first <= maxRangeSize);
+    auto widerRangeBytes = descriptor.getMipRangeBytes(lowMip - 1, highMip);
+    QVERIFY(widerRangeBytes.second - widerRangeBytes.first > maxRangeSize);
+
+    // the bytes of the range, as the asset server sends them, split back into the texture's mips
+    QVERIFY(rangeBytes.second <= ktxMemory->_storage->size());
+    QByteArray rangeData(reinterpret_cast<const char*>(ktxMemory->_storage->data()) + rangeBytes.first,
+                         (int)(rangeBytes.second - rangeBytes.first));
+    for (uint16_t mip = lowMip; mip <= highMip; mip++) {
+        size_t offset = descriptor.getMipOffsetInRange(mip, lowMip);
+        auto storedMip = texture->accessStoredMipFace(mip);
+        QVERIFY(storedMip.get());
+        QCOMPARE(storedMip->size(), (size_t)images[mip]._imageSize);
+        QVERIFY(offset + storedMip->size() <= (size_t)rangeData.size());
+        QVERIFY(0 == memcmp(rangeData.constData() + offset, storedMip->data(), storedMip->size()));
+    }
+    // and the last one ends the range
+    QCOMPARE(descriptor.getMipOffsetInRange(highMip, lowMip) + images[highMip]._imageSize, (size_t)rangeData.size());
+}
+
+void KtxTests::testParallelCompression() {
+    const int SIZE = 256;
+
+    // a noisy gradient, with a soft alpha on the left half and a mask on the right
+    QImage source(SIZE, SIZE, QImage::Format_ARGB32);
+    QImage maskSource(SIZE, SIZE, QImage::Format_ARGB32);
+    for (int y = 0; y < SIZE; y++) {
+        auto line = reinterpret_cast<QRgb*>(source.scanLine(y));
+        auto maskLine = reinterpret_cast<QRgb*>(maskSource.scanLine(y));
+        for (int x = 0; x < SIZE; x++) {
+            int noise = (x * 7919 + y * 104729) % 64;
+            int red = (x + noise) % 256;
+            int green = (y + noise) % 256;
+            int blue = (x + y + noise) % 256;
+            line[x] = qRgba(red, green, blue, (x < SIZE / 2) ? (y + noise) % 256 : 255);
+            maskLine[x] = qRgba(red, green, blue, ((x / 16 + y / 16) % 2) ? 255 : 0);
+        }
+    }
+
+    using ProcessFunction = std::function<gpu::TexturePointer(gpu::BackendTarget, const std::atomic<bool>&)>;
+    using namespace image::TextureUsage;
+    const std::vector<std::pair<const char*, ProcessFunction>> PROCESSES {
+        { "color", [&](gpu::BackendTarget target, const std::atomic<bool>& abort) {
+            return process2DTextureColorFromImage(QImage(source).convertToFormat(QImage::Format_RGB32), "color", true,
+                                                  target, false, abort);
+        } },
+        { "alpha", [&](gpu::BackendTarget target, const std::atomic<bool>& abort) {
+            return process2DTextureColorFromImage(QImage(source), "alpha", true, target, false, abort);
+        } },
+        { "mask", [&](gpu::BackendTarget target, const std::atomic<bool>& abort) {
+            return process2DTextureColorFromImage(QImage(maskSource), "mask", true, target, false, abort);
+        } },
+        { "uncompressed", [&](gpu::BackendTarget target, const std::atomic<bool>& abort) {
+            return process2DTextureColorFromImage(QImage(source), "uncompressed", false, target, false, abort);
+        } },
+        { "normal", [&](gpu::BackendTarget target, const std::atomic<bool>& abort) {
+            return process2DTextureNormalMapFromImage(QImage(source), "normal", true, target, false, abort);
+        } },
+        { "grayscale", [&](gpu::BackendTarget target, const std::atomic<bool>& abort) {
+            return process2DTextureGrayscaleFromImage(QImage(source), "grayscale", true, target, false, abort);
+        } }
+    };
+    const std::vector<gpu::BackendTarget> TARGETS { gpu::BackendTarget::GL45, gpu::BackendTarget::GLES32 };
+
+    std::atomic<bool> abortSignal { false };
+    for (auto target : TARGETS) {
+        for (const auto& process : PROCESSES) {
+            // GLES textures are always ETC2 encoded
+            if (target == gpu::BackendTarget::GLES32 && process.first == std::string("uncompressed")) {
+                continue;
+            }
+            image::setParallelCompressionEnabled(false);
+            auto serialTexture = process.second(target, abortSignal);
+            image::setParallelCompressionEnabled(true);
+            auto parallelTexture = process.second(target, abortSignal);
+            QVERIFY2(serialTexture && parallelTexture, process.first);
+            QCOMPARE(parallelTexture->getStoredMipFormat().getRaw(), serialTexture->getStoredMipFormat().getRaw());
+            QVERIFY2(serialTexture->getNumMips() > 1, process.first);
+
+            auto serialKtx = gpu::Texture::serialize(*serialTexture);
+            auto parallelKtx = gpu::Texture::serialize(*parallelTexture);
+            QVERIFY2(serialKtx && parallelKtx, process.first);
+            QCOMPARE(parallelKtx->_storage->size(), serialKtx->_storage->size());
+            QVERIFY2(0 == memcmp(parallelKtx->_storage->data(), serialKtx->_storage->data(), serialKtx->_storage->size()),
+                     process.first);
+        }
+    }
+}
+
+#ifdef MANUAL_TEST
+
+void KtxTests::textureProcessingBenchmark() {
+    const int SIZE = 2048;
+    const int NUM_RUNS = 3;
+
+    // a noisy gradient, so the block compressors have some work to do
+    QImage source(SIZE, SIZE, QImage::Format_ARGB32);
+    for (int y = 0; y < SIZE; y++) {
+        auto line = reinterpret_cast<QRgb*>(source.scanLine(y));
+        for (int x = 0; x < SIZE; x++) {
+            int noise = (x * 7919 + y * 104729) % 64;
+            line[x] = qRgba((x / 8 + noise) % 256, (y / 8 + noise) % 256, (x + y + noise) % 256, 255);
+        }
+    }
+    const float sourceMegabytes = (float)source.byteCount() / (BYTES_PER_KILOBYTE * BYTES_PER_KILOBYTE);
+
+    const std::vector<std::pair<const char*, gpu::BackendTarget>> TARGETS {
+        { "BCn", gpu::BackendTarget::GL45 },
+        { "ETC2", gpu::BackendTarget::GLES32 }
+    };
+    std::atomic<bool> abortSignal { false };
+    for (const auto& target : TARGETS) {
+        size_t ktxSize = 0;
+        quint64 start = usecTimestampNow();
+        for (int i = 0; i < NUM_RUNS; i++) {
+            auto texture = image::TextureUsage::process2DTextureColorFromImage(QImage(source), "benchmark", true,
+                                                                                target.second, false, abortSignal);
+            QVERIFY(texture.get());
+            auto ktxMemory = gpu::Texture::serialize(*texture);
+            QVERIFY(ktxMemory.get());
+            ktxSize = ktxMemory->getStorage()->size();
+        }
+        float seconds = (float)(usecTimestampNow() - start) / (NUM_RUNS * USECS_PER_SECOND);
+
+        std::cout << target.first << ": " << SIZE << "x" << SIZE << " with mips in " << seconds * MSECS_PER_SECOND
+                  << " ms, " << sourceMegabytes / seconds << " MB/s, " << ktxSize / BYTES_PER_KILOBYTE << " KB of KTX"
+                  << std::endl;
+    }
+}
+
+#endif // MANUAL_TEST
+
 #if 0
 
 static const QString TEST_FOLDER { "H:/ktx_cacheold" };
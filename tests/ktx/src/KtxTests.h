@@ -16,6 +16,11 @@ private slots:
     void testKtxEvalFunctions();
     void testKhronosCompressionFunctions();
     void testKtxSerialization();
+    void testMipRanges();
+    void testParallelCompression();
+#ifdef MANUAL_TEST
+    void textureProcessingBenchmark();
+#endif // MANUAL_TEST
 };
 
 
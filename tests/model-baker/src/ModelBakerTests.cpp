@@ -0,0 +1,227 @@
+//
+//  ModelBakerTests.cpp
+//  tests/model-baker/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ModelBakerTests.h"
+
+#include <iostream>
+#include <random>
+
+#include <glm/gtc/quaternion.hpp>
+
+#include <model-baker/CalculateBlendshapeNormalsTask.h>
+#include <model-baker/CalculateBlendshapeTangentsTask.h>
+#include <model-baker/CalculateMeshNormalsTask.h>
+#include <model-baker/CalculateMeshTangentsTask.h>
+#include <model-baker/ModelMath.h>
+
+QTEST_GUILESS_MAIN(ModelBakerTests)
+
+static const int NUM_MESHES = 12;
+
+// A bumpy grid of alternating quads and triangle pairs, with a blendshape that moves every other vertex
+static hfm::Mesh makeMesh(int size) {
+    hfm::Mesh mesh;
+    for (int y = 0; y <= size; y++) {
+        for (int x = 0; x <= size; x++) {
+            mesh.vertices.append(glm::vec3(x, y, sinf(x * 0.7f) * cosf(y * 0.3f)));
+            mesh.texCoords.append(glm::vec2(x, y * 0.5f) / (float)size);
+        }
+    }
+
+    HFMMeshPart part;
+    for (int y = 0; y < size; y++) {
+        for (int x = 0; x < size; x++) {
+            int i0 = y * (size + 1) + x;
+            int i1 = i0 + 1;
+            int i2 = i1 + size + 1;
+            int i3 = i0 + size + 1;
+            if ((x + y) % 2 == 0) {
+                part.quadIndices << i0 << i1 << i2 << i3;
+            } else {
+                part.triangleIndices << i0 << i1 << i2 << i0 << i2 << i3;
+            }
+        }
+    }
+    mesh.parts.append(part);
+
+    hfm::Blendshape blendshape;
+    for (int i = 0; i < mesh.vertices.size(); i += 2) {
+        blendshape.indices.append(i);
+        blendshape.vertices.append(mesh.vertices[i] + glm::vec3(0.0f, 0.0f, 0.25f));
+    }
+    mesh.blendshapes.append(blendshape);
+    return mesh;
+}
+
+static std::vector<hfm::Mesh> makeMeshes() {
+    std::vector<hfm::Mesh> meshes;
+    for (int i = 0; i < NUM_MESHES; i++) {
+        meshes.push_back(makeMesh(4 + i * 3));
+    }
+    // One mesh with normals that should be passed through as they are
+    meshes[1].normals.fill(glm::vec3(0.0f, 1.0f, 0.0f), meshes[1].vertices.size());
+    return meshes;
+}
+
+static baker::BlendshapesPerMesh getBlendshapes(const std::vector<hfm::Mesh>& meshes) {
+    baker::BlendshapesPerMesh blendshapesPerMesh;
+    for (const auto& mesh : meshes) {
+        blendshapesPerMesh.push_back(mesh.blendshapes.toStdVector());
+    }
+    return blendshapesPerMesh;
+}
+
+void ModelBakerTests::tangentMatchesRotation() {
+    std::mt19937 generator(1234);
+    std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+    auto randomVec3 = [&] { return glm::vec3(distribution(generator), distribution(generator), distribution(generator)); };
+
+    for (int i = 0; i < 1000; i++) {
+        glm::vec3 vertices[2] = { randomVec3(), randomVec3() };
+        glm::vec2 texCoords[2] = { glm::vec2(distribution(generator), distribution(generator)), glm::vec2() };
+        texCoords[1] = (i % 10 == 0) ? texCoords[0] : glm::vec2(distribution(generator), distribution(generator));
+        glm::vec3 normal = randomVec3();
+
+        glm::vec3 tangent;
+        if (!baker::calculateTangent(vertices, texCoords, normal, tangent)) {
+            continue;
+        }
+
+        // The rotation the tangent calculation used to do with atan2 and a quaternion
+        glm::vec3 bitangent = glm::cross(normal, vertices[1] - vertices[0]);
+        glm::vec2 texCoordDelta = texCoords[1] - texCoords[0];
+        glm::vec3 normalizedNormal = glm::normalize(normal);
+        glm::vec3 expected = glm::cross(glm::angleAxis(-atan2f(-texCoordDelta.t, texCoordDelta.s), normalizedNormal) *
+            glm::normalize(bitangent), normalizedNormal);
+
+        QVERIFY(glm::length(tangent - expected) < 1.0e-4f);
+    }
+}
+
+// The tasks process the meshes in parallel; each mesh's result should be exactly what it gets when baked on its own
+void ModelBakerTests::meshTasksMatchPerMesh() {
+    const auto meshes = makeMeshes();
+
+    baker::NormalsPerMesh normalsPerMesh;
+    CalculateMeshNormalsTask().run(baker::BakeContextPointer(), meshes, normalsPerMesh);
+    CalculateMeshTangentsTask::Input tangentsInput;
+    tangentsInput.edit0() = normalsPerMesh;
+    tangentsInput.edit1() = meshes;
+    baker::TangentsPerMesh tangentsPerMesh;
+    CalculateMeshTangentsTask().run(baker::BakeContextPointer(), tangentsInput, tangentsPerMesh);
+
+    QCOMPARE(normalsPerMesh.size(), meshes.size());
+    QCOMPARE(tangentsPerMesh.size(), meshes.size());
+    QVERIFY(normalsPerMesh[1] == meshes[1].normals.toStdVector());
+
+    for (size_t i = 0; i < meshes.size(); i++) {
+        std::vector<hfm::Mesh> single { meshes[i] };
+
+        baker::NormalsPerMesh normals;
+        CalculateMeshNormalsTask().run(baker::BakeContextPointer(), single, normals);
+        CalculateMeshTangentsTask::Input input;
+        input.edit0() = normals;
+        input.edit1() = single;
+        baker::TangentsPerMesh tangents;
+        CalculateMeshTangentsTask().run(baker::BakeContextPointer(), input, tangents);
+
+        QCOMPARE(normalsPerMesh[i].size(), (size_t)meshes[i].vertices.size());
+        QVERIFY(normalsPerMesh[i] == normals[0]);
+        QCOMPARE(tangentsPerMesh[i].size(), (size_t)meshes[i].vertices.size());
+        QVERIFY(tangentsPerMesh[i] == tangents[0]);
+    }
+}
+
+void ModelBakerTests::blendshapeTasksMatchPerMesh() {
+    const auto meshes = makeMeshes();
+    const auto blendshapesPerMesh = getBlendshapes(meshes);
+
+    CalculateBlendshapeNormalsTask::Input normalsInput;
+    normalsInput.edit0() = blendshapesPerMesh;
+    normalsInput.edit1() = meshes;
+    CalculateBlendshapeNormalsTask::Output normalsPerBlendshapePerMesh;
+    CalculateBlendshapeNormalsTask().run(baker::BakeContextPointer(), normalsInput, normalsPerBlendshapePerMesh);
+
+    CalculateBlendshapeTangentsTask::Input tangentsInput;
+    tangentsInput.edit0() = normalsPerBlendshapePerMesh;
+    tangentsInput.edit1() = blendshapesPerMesh;
+    tangentsInput.edit2() = meshes;
+    CalculateBlendshapeTangentsTask::Output tangentsPerBlendshapePerMesh;
+    CalculateBlendshapeTangentsTask().run(baker::BakeContextPointer(), tangentsInput, tangentsPerBlendshapePerMesh);
+
+    QCOMPARE(normalsPerBlendshapePerMesh.size(), meshes.size());
+    QCOMPARE(tangentsPerBlendshapePerMesh.size(), meshes.size());
+
+    for (size_t i = 0; i < meshes.size(); i++) {
+        std::vector<hfm::Mesh> single { meshes[i] };
+        baker::BlendshapesPerMesh singleBlendshapes { blendshapesPerMesh[i] };
+
+        CalculateBlendshapeNormalsTask::Input singleNormalsInput;
+        singleNormalsInput.edit0() = singleBlendshapes;
+        singleNormalsInput.edit1() = single;
+        CalculateBlendshapeNormalsTask::Output normals;
+        CalculateBlendshapeNormalsTask().run(baker::BakeContextPointer(), singleNormalsInput, normals);
+
+        CalculateBlendshapeTangentsTask::Input singleTangentsInput;
+        singleTangentsInput.edit0() = normals;
+        singleTangentsInput.edit1() = singleBlendshapes;
+        singleTangentsInput.edit2() = single;
+        CalculateBlendshapeTangentsTask::Output tangents;
+        CalculateBlendshapeTangentsTask().run(baker::BakeContextPointer(), singleTangentsInput, tangents);
+
+        QCOMPARE(normalsPerBlendshapePerMesh[i].size(), blendshapesPerMesh[i].size());
+        QVERIFY(normalsPerBlendshapePerMesh[i] == normals[0]);
+        QCOMPARE(tangentsPerBlendshapePerMesh[i].size(), blendshapesPerMesh[i].size());
+        QVERIFY(tangentsPerBlendshapePerMesh[i] == tangents[0]);
+    }
+}
+
+#ifdef MANUAL_TEST
+
+#include <FBXSerializer.h>
+#include <NumericalConstants.h>
+#include <SharedUtil.h>
+#include <model-baker/Baker.h>
+#include <test-utils/Utils.h>
+
+void ModelBakerTests::bakeBenchmark() {
+    auto files = getFBXTestFiles({ "*.fbx" });
+    if (files.isEmpty()) {
+        QSKIP("Set HIFI_FBX_TEST_DIR to a directory of FBX files");
+    }
+
+    for (const auto& fileInfo : files) {
+        QFile file(fileInfo.absoluteFilePath());
+        QVERIFY(file.open(QIODevice::ReadOnly));
+        hifi::ByteArray data = file.readAll();
+        hifi::URL url = QUrl::fromLocalFile(fileInfo.absoluteFilePath());
+        auto hfmModel = FBXSerializer().read(data, hifi::VariantHash(), url);
+        QVERIFY(hfmModel);
+
+        baker::Baker baker(hfmModel, hifi::VariantHash(), url);
+        auto config = baker.getConfiguration();
+        config->getJobConfig("BuildDracoMesh")->setEnabled(true);
+
+        quint64 start = usecTimestampNow();
+        baker.run();
+        quint64 elapsed = usecTimestampNow() - start;
+
+        std::cout << qPrintable(fileInfo.fileName()) << ": " << hfmModel->meshes.size() << " meshes, baked in "
+                  << (float)elapsed / USECS_PER_MSEC << " ms" << std::endl;
+        for (const auto& subConfig : config->getSubConfigs()) {
+            auto jobConfig = qobject_cast<task::JobConfig*>(subConfig);
+            if (jobConfig) {
+                std::cout << "    " << qPrintable(jobConfig->objectName()) << ": " << jobConfig->getCPURunTime() << " ms" << std::endl;
+            }
+        }
+    }
+}
+
+#endif // MANUAL_TEST
@@ -0,0 +1,27 @@
+//
+//  ModelBakerTests.h
+//  tests/model-baker/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_ModelBakerTests_h
+#define hifi_ModelBakerTests_h
+
+#include <QtTest/QtTest>
+
+class ModelBakerTests : public QObject {
+    Q_OBJECT
+private slots:
+    void tangentMatchesRotation();
+    void meshTasksMatchPerMesh();
+    void blendshapeTasksMatchPerMesh();
+#ifdef MANUAL_TEST
+    void bakeBenchmark();
+#endif // MANUAL_TEST
+};
+
+#endif // hifi_ModelBakerTests_h
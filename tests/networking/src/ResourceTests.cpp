@@ -9,6 +9,9 @@
 
 #include "ResourceTests.h"
 
+#include <iostream>
+#include <random>
+
 #include <QNetworkDiskCache>
 
 #include <ResourceCache.h>
@@ -17,6 +20,7 @@
 #include <NetworkAccessManager.h>
 #include <DependencyManager.h>
 #include <StatTracker.h>
+#include <SharedUtil.h>
 
 QTEST_MAIN(ResourceTests)
 
@@ -93,3 +97,99 @@ void ResourceTests::downloadAgain() {
 
     QVERIFY(resource->isLoaded());
 }
+
+static QSharedPointer<Resource> makePendingResource(const QString& url) {
+    auto pending = QSharedPointer<Resource>::create(QUrl(url));
+    pending->setSelf(pending);
+    return pending;
+}
+
+void ResourceTests::pendingRequestOrder() {
+    auto sharedItems = DependencyManager::get<ResourceCacheSharedItems>();
+    uint32_t requestLimit = sharedItems->getRequestLimit();
+    // with no room to load, every request waits in the pending requests
+    sharedItems->setRequestLimit(0);
+
+    QObject owner;
+    QList<QSharedPointer<Resource>> resources;
+    for (int i = 0; i < 4; i++) {
+        resources.append(makePendingResource(QString("http://localhost/%1").arg(i)));
+        resources[i]->setLoadPriority(&owner, (float)i);
+        QVERIFY(!sharedItems->appendRequest(resources[i]));
+    }
+    auto file = makePendingResource("file:///tmp/pending");
+    QVERIFY(!sharedItems->appendRequest(file));
+    QCOMPARE(sharedItems->getPendingRequestsCount(), (uint32_t)5);
+
+    // raising and lowering priorities while pending reorders the requests
+    resources[0]->setLoadPriority(&owner, 10.0f);
+    resources[3]->setLoadPriority(&owner, -1.0f);
+
+    // freed resources are dropped when they come up
+    resources[2].reset();
+
+    QCOMPARE(sharedItems->getHighestPendingRequest(), file);
+    QCOMPARE(sharedItems->getHighestPendingRequest(), resources[0]);
+    QCOMPARE(sharedItems->getHighestPendingRequest(), resources[1]);
+    QCOMPARE(sharedItems->getHighestPendingRequest(), resources[3]);
+    QVERIFY(sharedItems->getHighestPendingRequest().isNull());
+    QCOMPARE(sharedItems->getPendingRequestsCount(), (uint32_t)0);
+
+    sharedItems->setRequestLimit(requestLimit);
+}
+
+#ifdef MANUAL_TEST
+
+void ResourceTests::pendingRequestBenchmark() {
+    const int NUM_RESOURCES = 50000;
+    const int NUM_FRAMES = 100;
+    const int UPDATES_PER_FRAME = 2000;
+    const int REQUESTS_PER_FRAME = 10;
+
+    auto sharedItems = DependencyManager::get<ResourceCacheSharedItems>();
+    uint32_t requestLimit = sharedItems->getRequestLimit();
+    sharedItems->setRequestLimit(0);
+
+    std::mt19937 generator(1);
+    std::uniform_real_distribution<float> priorities(0.0f, 1.0f);
+    QObject owner;
+    QList<QSharedPointer<Resource>> resources;
+    for (int i = 0; i < NUM_RESOURCES; i++) {
+        resources.append(makePendingResource(QString("http://localhost/%1").arg(i)));
+        resources[i]->setLoadPriority(&owner, priorities(generator));
+    }
+
+    uint64_t start = usecTimestampNow();
+    for (auto& pending : resources) {
+        sharedItems->appendRequest(pending);
+    }
+    uint64_t append = usecTimestampNow() - start;
+
+    // each frame, the models in view re-prioritize some of their resources, and a few requests complete
+    uint64_t update = 0;
+    uint64_t take = 0;
+    int taken = 0;
+    for (int frame = 0; frame < NUM_FRAMES; frame++) {
+        start = usecTimestampNow();
+        for (int i = 0; i < UPDATES_PER_FRAME; i++) {
+            resources[generator() % NUM_RESOURCES]->setLoadPriority(&owner, priorities(generator));
+        }
+        update += usecTimestampNow() - start;
+
+        start = usecTimestampNow();
+        for (int i = 0; i < REQUESTS_PER_FRAME; i++) {
+            taken += sharedItems->getHighestPendingRequest() ? 1 : 0;
+        }
+        take += usecTimestampNow() - start;
+    }
+    QCOMPARE(taken, NUM_FRAMES * REQUESTS_PER_FRAME);
+
+    std::cout << NUM_RESOURCES << " pending resources: append " << (float)append / NUM_RESOURCES << " us/request, "
+              << "priority update " << (float)update / (NUM_FRAMES * UPDATES_PER_FRAME) << " us, "
+              << "take highest " << (float)take / taken << " us" << std::endl;
+
+    sharedItems->clear();
+    sharedItems->setRequestLimit(requestLimit);
+}
+
+#endif // MANUAL_TEST
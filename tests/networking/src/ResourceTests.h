@@ -18,6 +18,10 @@ private slots:
     void initTestCase();
     void downloadFirst();
     void downloadAgain();
+    void pendingRequestOrder();
+#ifdef MANUAL_TEST
+    void pendingRequestBenchmark();
+#endif // MANUAL_TEST
     void cleanupTestCase();
 };
 
@@ -0,0 +1,216 @@
+//
+//  PhysicsStepTests.cpp
+//  tests/physics/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "PhysicsStepTests.h"
+
+#include <iostream>
+#include <map>
+#include <memory>
+#include <vector>
+
+#include <btBulletDynamicsCommon.h>
+#include <BulletCollision/CollisionDispatch/btCollisionDispatcherMt.h>
+#include <BulletDynamics/ConstraintSolver/btSequentialImpulseConstraintSolverMt.h>
+
+#include <ContactMap.h>
+#include <PhysicsTaskScheduler.h>
+#include <SharedUtil.h>
+#include <ThreadSafeDynamicsWorld.h>
+
+QTEST_MAIN(PhysicsStepTests)
+
+const float BOX_HALF_EXTENT = 0.5f;
+const float FIXED_SUBSTEP = 1.0f / 90.0f;
+const int MAX_SUBSTEPS = 6;
+
+// a dynamics world configured the way PhysicsEngine::init() does it
+class TestWorld {
+public:
+    TestWorld() {
+        int numThreads = PhysicsTaskScheduler::getInstance().getNumThreads();
+        _collisionConfig.reset(new btDefaultCollisionConfiguration());
+        _dispatcher.reset(new btCollisionDispatcherMt(_collisionConfig.get(), 40));
+        _broadphase.reset(new btDbvtBroadphase());
+        _solverPool.reset(new btConstraintSolverPoolMt(numThreads));
+        _solver.reset(new btSequentialImpulseConstraintSolverMt());
+        _world.reset(new ThreadSafeDynamicsWorld(_dispatcher.get(), _broadphase.get(),
+                                                 _solverPool.get(), _solver.get(), _collisionConfig.get()));
+        _world->setGravity(btVector3(0.0f, -9.8f, 0.0f));
+
+        _boxShape.reset(new btBoxShape(btVector3(BOX_HALF_EXTENT, BOX_HALF_EXTENT, BOX_HALF_EXTENT)));
+        _groundShape.reset(new btBoxShape(btVector3(500.0f, 1.0f, 500.0f)));
+        addBody(_groundShape.get(), 0.0f, btVector3(0.0f, -1.0f, 0.0f));
+    }
+
+    ~TestWorld() {
+        for (auto& body : _bodies) {
+            _world->removeRigidBody(body.get());
+        }
+    }
+
+    btRigidBody* addBox(const btVector3& position) {
+        return addBody(_boxShape.get(), 1.0f, position);
+    }
+
+    void step(int numSubsteps) {
+        _world->stepSimulationWithSubstepCallback(numSubsteps * FIXED_SUBSTEP, MAX_SUBSTEPS, FIXED_SUBSTEP);
+    }
+
+    int getNumManifolds() const { return _dispatcher->getNumManifolds(); }
+
+private:
+    btRigidBody* addBody(btCollisionShape* shape, float mass, const btVector3& position) {
+        btVector3 inertia(0.0f, 0.0f, 0.0f);
+        if (mass > 0.0f) {
+            shape->calculateLocalInertia(mass, inertia);
+        }
+        btRigidBody* body = new btRigidBody(mass, nullptr, shape, inertia);
+        body->setWorldTransform(btTransform(btQuaternion::getIdentity(), position));
+        _world->addRigidBody(body);
+        _bodies.emplace_back(body);
+        return body;
+    }
+
+    std::unique_ptr<btDefaultCollisionConfiguration> _collisionConfig;
+    std::unique_ptr<btCollisionDispatcherMt> _dispatcher;
+    std::unique_ptr<btDbvtBroadphase> _broadphase;
+    std::unique_ptr<btConstraintSolverPoolMt> _solverPool;
+    std::unique_ptr<btSequentialImpulseConstraintSolverMt> _solver;
+    std::unique_ptr<ThreadSafeDynamicsWorld> _world;
+    std::unique_ptr<btBoxShape> _boxShape;
+    std::unique_ptr<btBoxShape> _groundShape;
+    std::vector<std::unique_ptr<btRigidBody>> _bodies;
+};
+
+// stacks of boxes on a square grid, separated enough that each stack is its own island
+static void buildStacks(TestWorld& world, int numBoxes, int stackHeight, std::vector<btRigidBody*>& boxes) {
+    int numStacks = (numBoxes + stackHeight - 1) / stackHeight;
+    int side = (int)ceilf(sqrtf((float)numStacks));
+    const float SPACING = 4.0f * BOX_HALF_EXTENT;
+    const float GAP = 0.01f;
+    for (int i = 0; i < numBoxes; ++i) {
+        int stack = i / stackHeight;
+        int level = i % stackHeight;
+        btVector3 position((stack % side) * SPACING, BOX_HALF_EXTENT + level * (2.0f * BOX_HALF_EXTENT + GAP),
+                           (stack / side) * SPACING);
+        boxes.push_back(world.addBox(position));
+    }
+}
+
+void PhysicsStepTests::testContactMap() {
+    // the flat map must behave like the std::map it replaced, including erasing while iterating
+    ContactMap contacts;
+    std::map<std::pair<uintptr_t, uintptr_t>, uint32_t> expected;
+    const uintptr_t NUM_OBJECTS = 200;
+    uint32_t frame = 0;
+    btManifoldPoint point;
+    for (int pass = 0; pass < 10; ++pass) {
+        ++frame;
+        point.m_distance1 = (btScalar)frame;
+        for (uintptr_t a = 1; a < NUM_OBJECTS; a += 1 + (pass % 3)) {
+            uintptr_t b = (a * 7 + pass) % NUM_OBJECTS + 1;
+            ContactKey key((void*)(a * 16), (void*)(b * 16));
+            contacts[key].update(frame, point);
+            expected[{ a * 16, b * 16 }] = frame;
+        }
+
+        // erase everything that wasn't touched by this pass
+        for (auto itr = contacts.begin(); itr != contacts.end();) {
+            if (itr->second.distance == (btScalar)frame) {
+                ++itr;
+            } else {
+                itr = contacts.erase(itr);
+            }
+        }
+        for (auto itr = expected.begin(); itr != expected.end();) {
+            if (itr->second == frame) {
+                ++itr;
+            } else {
+                itr = expected.erase(itr);
+            }
+        }
+
+        QCOMPARE(contacts.size(), expected.size());
+        for (auto& entry : expected) {
+            ContactKey key((void*)entry.first.first, (void*)entry.first.second);
+            auto itr = contacts.find(key);
+            QVERIFY(itr != contacts.end());
+            QCOMPARE(itr->second.distance, (btScalar)entry.second);
+        }
+    }
+
+    QVERIFY(contacts.find(ContactKey((void*)1, (void*)2)) == contacts.end());
+    contacts.clear();
+    QVERIFY(contacts.empty());
+    QVERIFY(contacts.begin() == contacts.end());
+}
+
+void PhysicsStepTests::testStackedBoxes() {
+    const int NUM_BOXES = 400;
+    const int STACK_HEIGHT = 8;
+
+    for (int numThreads : { 1, PhysicsTaskScheduler::getInstance().getMaxNumThreads() }) {
+        PhysicsTaskScheduler::getInstance().setNumThreads(numThreads);
+        TestWorld world;
+        std::vector<btRigidBody*> boxes;
+        buildStacks(world, NUM_BOXES, STACK_HEIGHT, boxes);
+
+        // two seconds of simulation, which is plenty for the stacks to settle
+        for (int i = 0; i < 180; ++i) {
+            world.step(1);
+        }
+
+        // every stack should still be standing: nothing fell through or toppled
+        const float TOLERANCE = 0.1f;
+        for (int i = 0; i < NUM_BOXES; ++i) {
+            int level = i % STACK_HEIGHT;
+            float expectedHeight = BOX_HALF_EXTENT + level * 2.0f * BOX_HALF_EXTENT;
+            float height = boxes[i]->getWorldTransform().getOrigin().getY();
+            QVERIFY(fabsf(height - expectedHeight) < TOLERANCE);
+        }
+        QVERIFY(world.getNumManifolds() >= NUM_BOXES);
+    }
+    PhysicsTaskScheduler::getInstance().setNumThreads(PhysicsTaskScheduler::getInstance().getMaxNumThreads());
+}
+
+#ifdef MANUAL_TEST
+
+void PhysicsStepTests::benchmark() {
+    const int STACK_HEIGHT = 10;
+    const int NUM_STEPS = 90;
+    int maxThreads = PhysicsTaskScheduler::getInstance().getMaxNumThreads();
+
+    std::cout << "[numBoxes, numThreads, usecsPerStep] = [" << std::endl;
+    for (int numBoxes : { 1000, 5000, 10000 }) {
+        for (int numThreads : { 1, 2, 4, maxThreads }) {
+            if (numThreads > maxThreads) {
+                continue;
+            }
+            PhysicsTaskScheduler::getInstance().setNumThreads(numThreads);
+            TestWorld world;
+            std::vector<btRigidBody*> boxes;
+            buildStacks(world, numBoxes, STACK_HEIGHT, boxes);
+
+            // let the piles collide once so that the first-contact spike isn't measured
+            world.step(1);
+
+            uint64_t startTime = usecTimestampNow();
+            for (int i = 0; i < NUM_STEPS; ++i) {
+                world.step(1);
+            }
+            uint64_t usecs = usecTimestampNow() - startTime;
+            std::cout << "    " << numBoxes << ", " << numThreads << ", " << (usecs / NUM_STEPS) << std::endl;
+        }
+    }
+    std::cout << "];" << std::endl;
+    PhysicsTaskScheduler::getInstance().setNumThreads(maxThreads);
+}
+
+#endif // MANUAL_TEST
@@ -0,0 +1,27 @@
+//
+//  PhysicsStepTests.h
+//  tests/physics/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_PhysicsStepTests_h
+#define hifi_PhysicsStepTests_h
+
+#include <QtTest/QtTest>
+
+class PhysicsStepTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testContactMap();
+    void testStackedBoxes();
+#ifdef MANUAL_TEST
+    void benchmark();
+#endif // MANUAL_TEST
+};
+
+#endif // hifi_PhysicsStepTests_h
@@ -13,6 +13,12 @@
 
 #include <iostream>
 
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtCore/QTemporaryDir>
+#include <shared/GlobalAppProperties.h>
+
+#include <HullCache.h>
 #include <ShapeManager.h>
 #include <StreamUtils.h>
 #include <Extents.h>
@@ -244,3 +250,133 @@ void ShapeManagerTests::addCompoundShape() {
     QCOMPARE(shapeManager.getNumShapes(), 0);
     QCOMPARE(shapeManager.getNumReferences(info), 0);
 }
+
+// two hulls with more points than MAX_HULL_POINTS, so that they must be reduced, and an offset
+static ShapeInfo makeReducibleCompoundInfo() {
+    ShapeInfo::PointCollection pointCollection;
+    const int NUM_POINTS = 200;
+    for (int i = 0; i < 2; ++i) {
+        ShapeInfo::PointList pointList;
+        for (int j = 0; j < NUM_POINTS; ++j) {
+            float theta = (float)j * 0.37f;
+            float z = 1.0f - 2.0f * (float)j / (float)(NUM_POINTS - 1);
+            float r = sqrtf(1.0f - z * z);
+            pointList.push_back(glm::vec3(r * cosf(theta) + 2.0f * (float)i, r * sinf(theta), z));
+        }
+        pointCollection.push_back(pointList);
+    }
+    ShapeInfo info;
+    info.setParams(SHAPE_TYPE_COMPOUND, glm::vec3(2.0f, 1.0f, 1.0f));
+    info.setPointCollection(pointCollection);
+    info.setOffset(glm::vec3(0.0f, 0.5f, 0.0f));
+    return info;
+}
+
+void ShapeManagerTests::hullCache() {
+    ShapeInfo info = makeReducibleCompoundInfo();
+
+    QTemporaryDir dir;
+    std::string dirname = dir.path().toStdString();
+
+    // the first cache must build the shape and store it
+    auto cache = std::make_shared<HullCache>(dirname);
+    cache->initialize();
+    const btCollisionShape* built = cache->getOrCreateShape(info);
+    QVERIFY(built != nullptr);
+    QCOMPARE(cache->getNumMisses(), (uint32_t)1);
+    QCOMPARE(cache->getNumHits(), (uint32_t)0);
+
+    // a new cache on the same directory, as in a later session, must load it
+    cache.reset();
+    auto otherCache = std::make_shared<HullCache>(dirname);
+    otherCache->initialize();
+    const btCollisionShape* loaded = otherCache->getOrCreateShape(info);
+    QVERIFY(loaded != nullptr);
+    QCOMPARE(otherCache->getNumHits(), (uint32_t)1);
+    QCOMPARE(otherCache->getNumMisses(), (uint32_t)0);
+
+    // and the loaded shape must match the built one
+    QCOMPARE(loaded->getShapeType(), (int)COMPOUND_SHAPE_PROXYTYPE);
+    const btCompoundShape* builtCompound = static_cast<const btCompoundShape*>(built);
+    const btCompoundShape* loadedCompound = static_cast<const btCompoundShape*>(loaded);
+    QCOMPARE(loadedCompound->getNumChildShapes(), builtCompound->getNumChildShapes());
+    for (int i = 0; i < builtCompound->getNumChildShapes(); ++i) {
+        QCOMPARE(loadedCompound->getChildTransform(i).getOrigin(), builtCompound->getChildTransform(i).getOrigin());
+        const btConvexHullShape* builtHull = static_cast<const btConvexHullShape*>(builtCompound->getChildShape(i));
+        const btConvexHullShape* loadedHull = static_cast<const btConvexHullShape*>(loadedCompound->getChildShape(i));
+        QVERIFY(builtHull->getNumPoints() <= MAX_HULL_POINTS);
+        QCOMPARE(loadedHull->getNumPoints(), builtHull->getNumPoints());
+        QCOMPARE(loadedHull->getMargin(), builtHull->getMargin());
+        for (int j = 0; j < builtHull->getNumPoints(); ++j) {
+            QCOMPARE(loadedHull->getUnscaledPoints()[j], builtHull->getUnscaledPoints()[j]);
+        }
+    }
+
+    // a different shape mustn't be found
+    info.setOffset(glm::vec3(0.0f));
+    const btCollisionShape* other = otherCache->getOrCreateShape(info);
+    QCOMPARE(otherCache->getNumMisses(), (uint32_t)1);
+
+    ShapeFactory::deleteShape(built);
+    ShapeFactory::deleteShape(loaded);
+    ShapeFactory::deleteShape(other);
+}
+
+void ShapeManagerTests::hullCacheCorruptEntry() {
+    ShapeInfo info = makeReducibleCompoundInfo();
+
+    QTemporaryDir dir;
+    std::string dirname = dir.path().toStdString();
+
+    auto cache = std::make_shared<HullCache>(dirname);
+    cache->initialize();
+    const btCollisionShape* built = cache->getOrCreateShape(info);
+    QVERIFY(built != nullptr);
+    cache.reset();
+
+    // flip a byte in the middle of the stored record, past its header
+    QFile file(QDir(dir.path()).absoluteFilePath(QString::fromStdString(HullCache::computeKey(info)) + ".hull"));
+    QVERIFY(file.open(QIODevice::ReadWrite));
+    QByteArray contents = file.readAll();
+    QVERIFY(contents.size() > 64);
+    contents[contents.size() / 2] = contents[contents.size() / 2] ^ 0x5a;
+    QVERIFY(file.seek(0));
+    QCOMPARE(file.write(contents), (qint64)contents.size());
+    file.close();
+
+    // the corrupt record must be rejected, and the shape built again
+    auto otherCache = std::make_shared<HullCache>(dirname);
+    otherCache->initialize();
+    const btCollisionShape* rebuilt = otherCache->getOrCreateShape(info);
+    QVERIFY(rebuilt != nullptr);
+    QCOMPARE(otherCache->getNumHits(), (uint32_t)0);
+    QCOMPARE(otherCache->getNumMisses(), (uint32_t)1);
+
+    ShapeFactory::deleteShape(built);
+    ShapeFactory::deleteShape(rebuilt);
+}
+
+void ShapeManagerTests::hullCacheSharedDirectory() {
+    QTemporaryDir dir;
+    qApp->setProperty(hifi::properties::APP_LOCAL_DATA_PATH, dir.path());
+
+    // two caches alive at once, as in two processes, share the one directory
+    QCOMPARE(QString::fromStdString(HullCache::getSharedDirectory()), QDir(dir.path()).absoluteFilePath("hull_cache"));
+    auto cache = HullCache::create();
+    auto otherCache = HullCache::create();
+
+    // so a shape one of them built is found by the other
+    ShapeInfo info = makeReducibleCompoundInfo();
+    const btCollisionShape* built = cache->getOrCreateShape(info);
+    QCOMPARE(cache->getNumMisses(), (uint32_t)1);
+    cache->flush();
+    const btCollisionShape* loaded = otherCache->getOrCreateShape(info);
+    QCOMPARE(otherCache->getNumHits(), (uint32_t)1);
+    QCOMPARE(otherCache->getNumMisses(), (uint32_t)0);
+    ShapeFactory::deleteShape(built);
+    ShapeFactory::deleteShape(loaded);
+
+    cache.reset();
+    otherCache.reset();
+    qApp->setProperty(hifi::properties::APP_LOCAL_DATA_PATH, QVariant());
+}
@@ -25,6 +25,9 @@ private slots:
     void addCylinderShape();
     void addCapsuleShape();
     void addCompoundShape();
+    void hullCache();
+    void hullCacheCorruptEntry();
+    void hullCacheSharedDirectory();
 };
 
 #endif // hifi_ShapeManagerTests_h
@@ -16,8 +16,13 @@
 
 #include <QtGlobal>
 #include <QtTest/QtTest>
+#include <QtCore/QTemporaryDir>
 #include <QtCore/QTemporaryFile>
 #include <QtCore/QString>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QFileInfo>
+
+#include <thread>
 
 #if defined(__clang__)
 #pragma clang diagnostic pop
@@ -28,8 +33,12 @@
 #endif
 
 #include <recording/Clip.h>
+#include <recording/ClipCache.h>
+#include <recording/ClipWriter.h>
 #include <recording/Frame.h>
+#include <recording/Recorder.h>
 
+#include <NumericalConstants.h>
 #include <SharedUtil.h>
 
 #include "Constants.h"
@@ -119,10 +128,209 @@ void testClipOrdering() {
     Q_UNUSED(lastFrameTimeOffset); // FIXME - Unix build not yet upgraded to Qt 5.5.1 we can remove this once it is
 }
 
+void testBlockSeek() {
+    QTemporaryFile file;
+    QVERIFY(file.open());
+    QString fileName = file.fileName();
+    file.close();
+
+    // Enough frames to span several compressed blocks
+    auto writeClip = Clip::newClip();
+    for (int i = 0; i < 2000; ++i) {
+        writeClip->addFrame(std::make_shared<Frame>(TEST_FRAME_TYPE, (float)i, QByteArray(100 + (i % 50), (char)i)));
+    }
+    Clip::toFile(fileName, writeClip);
+
+    auto readClip = Clip::fromFile(fileName);
+    QVERIFY(readClip != Clip::Pointer());
+    QVERIFY(readClip->frameCount() == 2000);
+    readClip->seekFrameTime(1500);
+    auto frame = readClip->nextFrame();
+    QVERIFY(frame && frame->timeOffset == 1500);
+    QVERIFY(frame->data == QByteArray(100 + (1500 % 50), (char)1500));
+}
+
+void testSharedCacheKey() {
+    // Two clips that differ only in one frame in the middle must not share decoded frames
+    static const int FRAME_COUNT = 2000;
+    static const int CHANGED_FRAME = FRAME_COUNT / 2;
+    std::vector<Clip::Pointer> readClips;
+    std::vector<std::unique_ptr<QTemporaryFile>> files;
+    for (char changed : { 'a', 'b' }) {
+        files.emplace_back(new QTemporaryFile());
+        QVERIFY(files.back()->open());
+        QString fileName = files.back()->fileName();
+        files.back()->close();
+
+        auto writeClip = Clip::newClip();
+        for (int i = 0; i < FRAME_COUNT; ++i) {
+            QByteArray data(100, (char)i);
+            if (i == CHANGED_FRAME) {
+                data[50] = changed;
+            }
+            writeClip->addFrame(std::make_shared<Frame>(TEST_FRAME_TYPE, (float)i, data));
+        }
+        Clip::toFile(fileName, writeClip);
+        readClips.push_back(Clip::fromFile(fileName));
+        QVERIFY(readClips.back() != Clip::Pointer());
+    }
+
+    for (size_t i = 0; i < readClips.size(); ++i) {
+        readClips[i]->seekFrameTime((Frame::Time)CHANGED_FRAME);
+        auto frame = readClips[i]->nextFrame();
+        QVERIFY(frame && frame->data.size() == 100);
+        QVERIFY(frame->data[50] == (i == 0 ? 'a' : 'b'));
+    }
+
+    // The same file opened again does share them
+    auto& cache = DecodedFrameCache::instance();
+    auto hits = cache.getHits();
+    auto reopened = Clip::fromFile(files.front()->fileName());
+    QVERIFY(reopened != Clip::Pointer());
+    reopened->seekFrameTime((Frame::Time)CHANGED_FRAME);
+    auto frame = reopened->nextFrame();
+    QVERIFY(frame && frame->data[50] == 'a');
+    QVERIFY(cache.getHits() > hits);
+}
+
+void testStreamingWriter() {
+    QTemporaryFile file;
+    QVERIFY(file.open());
+    QString fileName = file.fileName();
+    file.close();
+
+    static const int FRAME_COUNT = 5000;
+    {
+        ClipWriter writer(fileName);
+        QVERIFY(writer.open());
+        for (int i = 0; i < FRAME_COUNT; ++i) {
+            writer.addFrame(std::make_shared<Frame>(TEST_FRAME_TYPE, (float)i, QByteArray(200, (char)i)));
+        }
+        QVERIFY(writer.finish());
+        // far fewer blocks than the queue holds, so none can have been dropped
+        QVERIFY(writer.getNumDroppedFrames() == 0);
+    }
+
+    auto readClip = Clip::fromFile(fileName);
+    QVERIFY(readClip != Clip::Pointer());
+    QVERIFY(readClip->frameCount() == FRAME_COUNT);
+    readClip.reset();
+
+    // Simulate a crash part way through writing a block, everything before it must still be readable
+    QFile truncated(fileName);
+    QVERIFY(truncated.resize(truncated.size() - 10));
+    readClip = Clip::fromFile(fileName);
+    QVERIFY(readClip != Clip::Pointer());
+    QVERIFY(readClip->frameCount() > 0 && readClip->frameCount() < FRAME_COUNT);
+    readClip->seek(0);
+    auto frame = readClip->nextFrame();
+    QVERIFY(frame && frame->data == QByteArray(200, (char)0));
+}
+
+void testSpoolFileRemoved() {
+    QTemporaryDir spoolDirectory;
+    QVERIFY(spoolDirectory.isValid());
+    auto spoolFiles = [&] { return QDir(spoolDirectory.path()).entryList(QDir::Files); };
+
+    Recorder recorder;
+    recorder.setSpoolDirectory(spoolDirectory.path());
+    recorder.start();
+    for (int i = 0; i < 100; ++i) {
+        recorder.recordFrame(TEST_FRAME_TYPE, QByteArray(100, (char)i));
+    }
+    recorder.stop();
+    QVERIFY(spoolFiles().size() == 1);
+
+    // A player holding the recording keeps the file alive past a clear
+    auto clip = recorder.getClip();
+    QVERIFY(clip && clip->frameCount() == 100);
+    recorder.clear();
+    QVERIFY(spoolFiles().size() == 1);
+    clip.reset();
+    QVERIFY(spoolFiles().isEmpty());
+
+    // Clearing an unfinished recording removes its file too
+    recorder.start();
+    recorder.recordFrame(TEST_FRAME_TYPE, QByteArray(100, 0));
+    recorder.clear();
+    QVERIFY(spoolFiles().isEmpty());
+}
+
+// Replays one synthetic avatar clip with N concurrent players and reports decode
+// throughput and decoded frame cache memory, with and without the shared cache
+void benchmarkConcurrentPlayback() {
+    static const int FRAME_RATE = 90;
+    static const int CLIP_SECONDS = 60;
+    static const int FRAME_SIZE = 1500;
+    static const size_t PLAYER_COUNTS[] = { 1, 10, 100 };
+
+    QTemporaryFile file;
+    QVERIFY(file.open());
+    QString fileName = file.fileName();
+    file.close();
+
+    auto writeClip = Clip::newClip();
+    QByteArray frameData(FRAME_SIZE, 0);
+    for (int i = 0; i < FRAME_RATE * CLIP_SECONDS; ++i) {
+        // Mostly static payload with some per frame variation, like real joint data
+        for (int j = 0; j < FRAME_SIZE; j += 16) {
+            frameData[j] = (char)(i * j);
+        }
+        writeClip->addFrame(std::make_shared<Frame>(TEST_FRAME_TYPE, (float)(i * 1000 / FRAME_RATE), frameData));
+    }
+    Clip::toFile(fileName, writeClip);
+    qDebug() << "Clip file size" << QFileInfo(fileName).size() << "bytes for" << writeClip->frameCount() << "frames";
+
+    auto& cache = DecodedFrameCache::instance();
+    auto defaultCacheSize = cache.getMaxSize();
+    for (bool shared : { false, true }) {
+        for (auto playerCount : PLAYER_COUNTS) {
+            cache.clear();
+            cache.setMaxSize(shared ? defaultCacheSize : 0);
+
+            std::vector<Clip::Pointer> players;
+            for (size_t i = 0; i < playerCount; ++i) {
+                players.push_back(Clip::fromFile(fileName));
+            }
+
+            QElapsedTimer timer;
+            timer.start();
+            std::vector<std::thread> threads;
+            std::atomic<size_t> framesRead { 0 };
+            for (size_t i = 0; i < playerCount; ++i) {
+                threads.emplace_back([&, i] {
+                    auto player = players[i];
+                    // Stagger the players slightly, as agents started a moment apart would be
+                    player->seekFrameTime((Frame::Time)(i * 10));
+                    size_t count = 0;
+                    for (auto frame = player->nextFrame(); frame; frame = player->nextFrame()) {
+                        ++count;
+                    }
+                    framesRead += count;
+                });
+            }
+            for (auto& thread : threads) {
+                thread.join();
+            }
+            auto elapsed = timer.nsecsElapsed();
+            qDebug() << (shared ? "Shared cache," : "No cache,") << playerCount << "players:"
+                << (double)framesRead * NSECS_PER_SECOND / elapsed << "frames/sec,"
+                << cache.getSize() / 1024 << "KB decoded," << cache.getHits() << "hits" << cache.getMisses() << "misses";
+        }
+    }
+    cache.clear();
+    cache.setMaxSize(defaultCacheSize);
+}
+
 int main(int, const char**) {
     setupHifiApplication("Recording Test");
 
     testFrameTypeRegistration();
     testFilePersist();
     testClipOrdering();
+    testBlockSeek();
+    testSharedCacheKey();
+    testStreamingWriter();
+    testSpoolFileRemoved();
+    benchmarkConcurrentPlayback();
 }
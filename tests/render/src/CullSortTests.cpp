@@ -0,0 +1,286 @@
+//
+//  CullSortTests.cpp
+//  tests/render/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "CullSortTests.h"
+
+#include <cfloat>
+#include <iostream>
+#include <random>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <NumericalConstants.h>
+#include <SharedUtil.h>
+#include <ViewFrustum.h>
+
+#include <render/CullTask.h>
+#include <render/Scene.h>
+#include <render/SortTask.h>
+
+QTEST_MAIN(CullSortTests)
+
+static const float SCENE_SIZE = 400.0f;
+
+// a scene item that is either plain, a meta cull group, or one of a group's sub items
+struct TestItem {
+    AABox bound;
+    bool isMeta { false };
+    bool isSubItem { false };
+    render::ItemIDs subItems;
+};
+
+namespace render {
+    template <> const ItemKey payloadGetKey(const std::shared_ptr<TestItem>& item) {
+        auto builder = ItemKey::Builder::opaqueShape();
+        if (item->isMeta) {
+            builder.withMetaCullGroup();
+        }
+        if (item->isSubItem) {
+            builder.withSubMetaCulled();
+        }
+        return builder.build();
+    }
+    template <> const Item::Bound payloadGetBound(const std::shared_ptr<TestItem>& item) {
+        return item->bound;
+    }
+    template <> uint32_t metaFetchMetaSubItems(const std::shared_ptr<TestItem>& item, ItemIDs& subItems) {
+        subItems.insert(subItems.end(), item->subItems.begin(), item->subItems.end());
+        return (uint32_t)item->subItems.size();
+    }
+}
+
+using TestPayload = render::Payload<TestItem>;
+
+// a camera at the origin looking down -z, with the items scattered all around it
+static ViewFrustum makeFrustum() {
+    ViewFrustum frustum;
+    frustum.setProjection(glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, SCENE_SIZE));
+    frustum.setPosition(glm::vec3(0.0f));
+    frustum.setOrientation(glm::angleAxis(PI / 7.0f, glm::normalize(glm::vec3(1.0f, 2.0f, 3.0f))));
+    frustum.calculate();
+    return frustum;
+}
+
+static render::RenderContextPointer makeContext(render::Args& args, const ViewFrustum& frustum) {
+    args.setViewFrustum(frustum);
+    auto context = std::make_shared<render::RenderContext>();
+    context->args = &args;
+    return context;
+}
+
+static void generateItems(size_t numItems, render::ItemBounds& items) {
+    std::mt19937 random(numItems);
+    std::uniform_real_distribution<float> position(-SCENE_SIZE, SCENE_SIZE);
+    std::uniform_real_distribution<float> size(0.01f, 20.0f);
+
+    items.clear();
+    items.reserve(numItems);
+    for (size_t i = 0; i < numItems; i++) {
+        glm::vec3 corner(position(random), position(random), position(random));
+        glm::vec3 scale(size(random), size(random), size(random));
+        items.emplace_back((render::ItemID)i, AABox(corner, scale));
+    }
+}
+
+void CullSortTests::boxesIntersectFrustum() {
+    ViewFrustum frustum = makeFrustum();
+
+    // odd sizes exercise the scalar tail
+    for (size_t numItems : { 0, 1, 3, 4, 7, 1001 }) {
+        render::ItemBounds items;
+        generateItems(numItems, items);
+
+        std::vector<uint8_t> inView(numItems);
+        render::boxesIntersectFrustum(frustum, items.data(), numItems, inView.data());
+
+        for (size_t i = 0; i < numItems; i++) {
+            QCOMPARE((bool)inView[i], frustum.boxIntersectsFrustum(items[i].bound));
+        }
+    }
+}
+
+void CullSortTests::parallelCullMatchesSerial() {
+    const int NUM_ITEMS = 20000;
+    const int MAX_SUB_ITEMS = 3;
+
+    auto scene = std::make_shared<render::Scene>(glm::vec3(-SCENE_SIZE), 2.0f * SCENE_SIZE);
+    render::Transaction transaction;
+    std::mt19937 random(NUM_ITEMS);
+    std::uniform_real_distribution<float> position(-SCENE_SIZE, SCENE_SIZE);
+    std::uniform_real_distribution<float> size(0.01f, 20.0f);
+    std::uniform_int_distribution<int> kind(0, 9);
+    std::uniform_int_distribution<int> numSubItems(0, MAX_SUB_ITEMS);
+    for (int i = 0; i < NUM_ITEMS; i++) {
+        auto item = std::make_shared<TestItem>();
+        item->bound = AABox(glm::vec3(position(random), position(random), position(random)),
+                            glm::vec3(size(random), size(random), size(random)));
+        // one in ten is a meta cull group, whose sub items are only selected through it
+        item->isMeta = (kind(random) == 0);
+        if (item->isMeta) {
+            for (int j = numSubItems(random); j > 0; j--) {
+                auto subItem = std::make_shared<TestItem>();
+                subItem->bound = AABox(item->bound.getCorner(), 0.5f * item->bound.getScale());
+                subItem->isSubItem = true;
+                auto subID = scene->allocateID();
+                transaction.resetItem(subID, std::make_shared<TestPayload>(subItem));
+                item->subItems.push_back(subID);
+            }
+        }
+        transaction.resetItem(scene->allocateID(), std::make_shared<TestPayload>(item));
+    }
+    scene->enqueueTransaction(transaction);
+    scene->enqueueFrame();
+    scene->processTransactionQueue();
+
+    ViewFrustum frustum = makeFrustum();
+    render::Args args;
+    args._lodAngleHalfTan = 0.01f;
+    args._lodAngleHalfTanSq = args._lodAngleHalfTan * args._lodAngleHalfTan;
+    auto context = makeContext(args, frustum);
+    context->_scene = scene;
+    context->jobConfig = std::make_shared<render::CullSpatialSelectionConfig>();
+
+    auto filter = render::ItemFilter::Builder::opaqueShape().build();
+    render::ItemSpatialTree::ItemSelection selection;
+    scene->getSpatialTree().selectCellItems(selection, filter, frustum, args._lodAngleHalfTan);
+    QVERIFY(selection.numItems() > 0);
+
+    // the same test as LODManager::shouldRender
+    render::CullFunctor cullFunctor = [](const RenderArgs* args, const AABox& bounds) {
+        auto offset = args->getViewFrustum().getPosition() - bounds.calcCenter();
+        auto dimensions = bounds.getDimensions();
+        return 0.25f * glm::dot(dimensions, dimensions) >= args->_lodAngleHalfTanSq * glm::dot(offset, offset);
+    };
+    render::CullSpatialSelection::Inputs inputs(render::Varying(selection), render::Varying(filter));
+
+    render::CullSpatialSelection serialCull(cullFunctor, render::RenderDetails::ITEM);
+    render::ItemBounds expected;
+    serialCull.run(context, inputs, expected);
+    auto expectedDetails = args._details._item;
+
+    // run twice, so that the second pass reuses the chunk buffers of the first
+    render::ParallelCullSpatialSelection parallelCull(cullFunctor, render::RenderDetails::ITEM);
+    for (int pass = 0; pass < 2; pass++) {
+        args._details = render::RenderDetails();
+        render::ItemBounds items;
+        parallelCull.run(context, inputs, items);
+
+        QCOMPARE(items.size(), expected.size());
+        for (size_t i = 0; i < items.size(); i++) {
+            QCOMPARE(items[i].id, expected[i].id);
+            QCOMPARE(items[i].bound.getCorner(), expected[i].bound.getCorner());
+            QCOMPARE(items[i].bound.getScale(), expected[i].bound.getScale());
+        }
+        QCOMPARE(args._details._item._considered, expectedDetails._considered);
+        QCOMPARE(args._details._item._outOfView, expectedDetails._outOfView);
+        QCOMPARE(args._details._item._tooSmall, expectedDetails._tooSmall);
+        QCOMPARE(args._details._item._rendered, expectedDetails._rendered);
+    }
+}
+
+void CullSortTests::radixDepthSort() {
+    ViewFrustum frustum = makeFrustum();
+    render::Args args;
+    auto context = makeContext(args, frustum);
+
+    render::ItemBounds items;
+    generateItems(10000, items);
+
+    // duplicate IDs are collapsed, as in depthSortItems
+    items.push_back(items[5]);
+    items.push_back(items[5]);
+
+    render::DepthSortBuffers buffers;
+    for (bool frontToBack : { true, false }) {
+        render::ItemBounds expected;
+        AABox expectedBounds;
+        render::depthSortItems(context, frontToBack, items, expected, &expectedBounds);
+
+        render::ItemBounds sorted;
+        AABox bounds;
+        render::radixDepthSortItems(context, frontToBack, items, sorted, buffers, &bounds);
+
+        QCOMPARE(sorted.size(), expected.size());
+        QCOMPARE(bounds.getCorner(), expectedBounds.getCorner());
+        QCOMPARE(bounds.getScale(), expectedBounds.getScale());
+
+        // the keys are quantized, so only the order of clearly separated depths has to match
+        const float TOLERANCE = 1.0f + 1.0f / (1 << 14);
+        float previous = frontToBack ? 0.0f : FLT_MAX;
+        for (const auto& item : sorted) {
+            float distance = frustum.distanceToCameraSquared(item.bound.calcCenter());
+            if (frontToBack) {
+                QVERIFY(distance * TOLERANCE >= previous);
+            } else {
+                QVERIFY(distance <= previous * TOLERANCE);
+            }
+            previous = distance;
+        }
+    }
+}
+
+#ifdef MANUAL_TEST
+
+void CullSortTests::benchmark() {
+    const int NUM_FRAMES = 20;
+
+    ViewFrustum frustum = makeFrustum();
+    render::Args args;
+    auto context = makeContext(args, frustum);
+
+    for (size_t numItems : { 10000, 100000, 500000 }) {
+        render::ItemBounds items;
+        generateItems(numItems, items);
+        std::vector<uint8_t> inView(numItems);
+
+        uint64_t start = usecTimestampNow();
+        for (int i = 0; i < NUM_FRAMES; i++) {
+            for (size_t j = 0; j < numItems; j++) {
+                inView[j] = frustum.boxIntersectsFrustum(items[j].bound);
+            }
+        }
+        uint64_t serialCull = usecTimestampNow() - start;
+
+        start = usecTimestampNow();
+        for (int i = 0; i < NUM_FRAMES; i++) {
+            render::boxesIntersectFrustum(frustum, items.data(), numItems, inView.data());
+        }
+        uint64_t simdCull = usecTimestampNow() - start;
+
+        render::ItemBounds visible;
+        for (size_t j = 0; j < numItems; j++) {
+            if (inView[j]) {
+                visible.push_back(items[j]);
+            }
+        }
+
+        render::ItemBounds sorted;
+        start = usecTimestampNow();
+        for (int i = 0; i < NUM_FRAMES; i++) {
+            render::depthSortItems(context, true, visible, sorted);
+        }
+        uint64_t serialSort = usecTimestampNow() - start;
+
+        render::DepthSortBuffers buffers;
+        start = usecTimestampNow();
+        for (int i = 0; i < NUM_FRAMES; i++) {
+            render::radixDepthSortItems(context, true, visible, sorted, buffers);
+        }
+        uint64_t radixSort = usecTimestampNow() - start;
+
+        std::cout << numItems << " items, " << visible.size() << " in view" << std::endl;
+        std::cout << "    cull: serial = " << (serialCull / NUM_FRAMES) << " usec/frame, simd = "
+            << (simdCull / NUM_FRAMES) << " usec/frame" << std::endl;
+        std::cout << "    sort: std::sort = " << (serialSort / NUM_FRAMES) << " usec/frame, radix = "
+            << (radixSort / NUM_FRAMES) << " usec/frame" << std::endl;
+    }
+}
+
+#endif // MANUAL_TEST
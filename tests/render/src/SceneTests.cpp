@@ -0,0 +1,152 @@
+//
+//  SceneTests.cpp
+//  tests/render/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "SceneTests.h"
+
+#include <thread>
+
+#include <render/Scene.h>
+
+QTEST_MAIN(SceneTests)
+
+struct TestItem {
+    glm::vec3 position;
+    std::vector<int> history;
+};
+
+namespace render {
+    template <> const ItemKey payloadGetKey(const std::shared_ptr<TestItem>& item) {
+        return ItemKey::Builder::opaqueShape();
+    }
+    template <> const Item::Bound payloadGetBound(const std::shared_ptr<TestItem>& item) {
+        return Item::Bound(item->position, 1.0f);
+    }
+}
+
+using TestPayload = render::Payload<TestItem>;
+
+static const float SCENE_SIZE = 1000.0f;
+
+static render::ScenePointer makeScene() {
+    return std::make_shared<render::Scene>(glm::vec3(-0.5f * SCENE_SIZE), SCENE_SIZE);
+}
+
+static render::ItemID addItem(const render::ScenePointer& scene, render::Transaction& transaction, const glm::vec3& position) {
+    auto id = scene->allocateID();
+    auto item = std::make_shared<TestItem>();
+    item->position = position;
+    transaction.resetItem(id, std::make_shared<TestPayload>(item));
+    return id;
+}
+
+void SceneTests::concurrentEnqueue() {
+    const int NUM_THREADS = 4;
+    const int NUM_TRANSACTIONS = 500;
+
+    auto scene = makeScene();
+    std::vector<std::vector<render::ItemID>> ids(NUM_THREADS);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < NUM_THREADS; t++) {
+        threads.emplace_back([&, t] {
+            for (int i = 0; i < NUM_TRANSACTIONS; i++) {
+                render::Transaction transaction;
+                ids[t].push_back(addItem(scene, transaction, glm::vec3((float)t, (float)i, 0.0f)));
+                scene->enqueueTransaction(transaction);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    scene->enqueueFrame();
+    QCOMPARE(scene->getTransactionBacklog(), (size_t)(NUM_THREADS * NUM_TRANSACTIONS));
+    scene->processTransactionQueue();
+    QCOMPARE(scene->getTransactionBacklog(), (size_t)0);
+
+    for (const auto& threadIDs : ids) {
+        for (auto id : threadIDs) {
+            QVERIFY(scene->getItemSafe(id).exist());
+        }
+    }
+}
+
+void SceneTests::budgetedProcessing() {
+    const int NUM_ITEMS = 50000;
+
+    auto scene = makeScene();
+    render::Transaction transaction;
+    std::vector<render::ItemID> ids;
+    for (int i = 0; i < NUM_ITEMS; i++) {
+        ids.push_back(addItem(scene, transaction, glm::vec3((float)(i % 100), (float)(i / 100), 0.0f)));
+    }
+    scene->enqueueTransaction(transaction);
+
+    // an item removed in the same frame is only gone once the resets have all gone through
+    render::Transaction removal;
+    removal.removeItem(ids.front());
+    scene->enqueueTransaction(removal);
+    scene->enqueueFrame();
+
+    // a tiny budget still makes progress on every call
+    const uint64_t BUDGET_USECS = 1;
+    int numCalls = 0;
+    size_t backlog = scene->getTransactionBacklog();
+    while (backlog > 0) {
+        scene->processTransactionQueue(BUDGET_USECS);
+        numCalls++;
+        QVERIFY(scene->getTransactionBacklog() < backlog);
+        backlog = scene->getTransactionBacklog();
+    }
+    QVERIFY(numCalls > 1);
+
+    QVERIFY(!scene->getItemSafe(ids.front()).exist());
+    for (size_t i = 1; i < ids.size(); i++) {
+        QVERIFY(scene->getItemSafe(ids[i]).exist());
+    }
+}
+
+void SceneTests::updateOrder() {
+    auto scene = makeScene();
+    render::Transaction transaction;
+    auto id = addItem(scene, transaction, glm::vec3(0.0f));
+    scene->enqueueTransaction(transaction);
+    scene->enqueueFrame();
+    scene->processTransactionQueue();
+
+    // several updates to one item in a frame all run, in order, and the last position wins, whatever re-sort only
+    // updates are mixed in with them
+    render::Transaction updates;
+    for (int i = 0; i < 10; i++) {
+        updates.updateItem<TestItem>(id, [i](TestItem& item) {
+            item.history.push_back(i);
+            item.position = glm::vec3((float)i, 0.0f, 0.0f);
+        });
+        updates.updateItem(id);
+    }
+    scene->enqueueTransaction(updates);
+    scene->enqueueFrame();
+    scene->processTransactionQueue();
+
+    std::vector<int> history;
+    render::Transaction query;
+    query.updateItem<TestItem>(id, [&history](TestItem& item) {
+        history = item.history;
+    });
+    scene->enqueueTransaction(query);
+    scene->enqueueFrame();
+    scene->processTransactionQueue();
+
+    QCOMPARE((int)history.size(), 10);
+    for (int i = 0; i < 10; i++) {
+        QCOMPARE(history[i], i);
+    }
+    QCOMPARE(scene->getItem(id).getBound().getCorner().x, 9.0f);
+}
@@ -0,0 +1,25 @@
+//
+//  SceneTests.h
+//  tests/render/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_render_SceneTests_h
+#define hifi_render_SceneTests_h
+
+#include <QtTest/QtTest>
+
+class SceneTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void concurrentEnqueue();
+    void budgetedProcessing();
+    void updateOrder();
+};
+
+#endif // hifi_render_SceneTests_h
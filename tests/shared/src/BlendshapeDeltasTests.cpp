@@ -0,0 +1,200 @@
+//
+//  BlendshapeDeltasTests.cpp
+//  tests/shared/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "BlendshapeDeltasTests.h"
+
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+#include <test-utils/QTestExtensions.h>
+
+#include <BlendshapeDeltas.h>
+#include <SharedUtil.h>
+#include <glm/gtc/random.hpp>
+
+QTEST_MAIN(BlendshapeDeltasTests)
+
+const float NORMAL_COEFFICIENT_SCALE = 0.01f;
+const float COEFFICIENT_THRESHOLD = 0.0001f;
+
+// a blendshape as it comes out of the model loader
+struct Blendshape {
+    QVector<int> indices;
+    QVector<glm::vec3> vertices;
+    QVector<glm::vec3> normals;
+    QVector<glm::vec3> tangents;
+};
+
+// a face-like mesh: each blendshape moves a patch of the vertices, and leaves a few of the listed ones where they are
+static QVector<Blendshape> makeBlendshapes(int numVertices, int numBlendshapes) {
+    QVector<Blendshape> blendshapes(numBlendshapes);
+    for (auto& blendshape : blendshapes) {
+        int patchSize = numVertices / 10;
+        int first = randIntInRange(0, numVertices - patchSize);
+        for (int j = 0; j < patchSize; j++) {
+            bool moves = (j % 4) != 0;
+            blendshape.indices.push_back(first + j);
+            blendshape.vertices.push_back(moves ? glm::linearRand(glm::vec3(-0.01f), glm::vec3(0.01f)) : glm::vec3(0.0f));
+            blendshape.normals.push_back(moves ? glm::linearRand(glm::vec3(-1.0f), glm::vec3(1.0f)) : glm::vec3(0.0f));
+            blendshape.tangents.push_back(moves ? glm::linearRand(glm::vec3(-1.0f), glm::vec3(1.0f)) : glm::vec3(0.0f));
+        }
+        // models without tangents for some of the vertices
+        blendshape.tangents.resize(patchSize / 2);
+    }
+    return blendshapes;
+}
+
+static BlendshapeDeltas packBlendshapes(int numVertices, const QVector<Blendshape>& blendshapes) {
+    BlendshapeDeltas deltas(numVertices);
+    for (const auto& blendshape : blendshapes) {
+        deltas.addBlendshape(blendshape.indices.constData(), blendshape.vertices.constData(), blendshape.normals.constData(),
+                             blendshape.indices.size(), blendshape.tangents.constData(), blendshape.tangents.size(),
+                             NORMAL_COEFFICIENT_SCALE);
+    }
+    return deltas;
+}
+
+// every listed vertex of every active blendshape, as the per-model Blender did it
+static void blendDense(int numVertices, const QVector<Blendshape>& blendshapes, const QVector<float>& coefficients,
+                       std::vector<float>& offsets) {
+    offsets.assign(numVertices * BlendshapeDeltas::DELTA_SIZE, 0.0f);
+    for (int i = 0, n = std::min(coefficients.size(), blendshapes.size()); i < n; i++) {
+        float vertexCoefficient = coefficients.at(i);
+        if (vertexCoefficient < COEFFICIENT_THRESHOLD) {
+            continue;
+        }
+        float normalCoefficient = vertexCoefficient * NORMAL_COEFFICIENT_SCALE;
+        const Blendshape& blendshape = blendshapes.at(i);
+        for (int j = 0; j < blendshape.indices.size(); ++j) {
+            float* offset = &offsets[blendshape.indices.at(j) * BlendshapeDeltas::DELTA_SIZE];
+            for (int k = 0; k < 3; k++) {
+                offset[k] += blendshape.vertices.at(j)[k] * vertexCoefficient;
+                offset[3 + k] += blendshape.normals.at(j)[k] * normalCoefficient;
+                if (j < blendshape.tangents.size()) {
+                    offset[6 + k] += blendshape.tangents.at(j)[k] * normalCoefficient;
+                }
+            }
+        }
+    }
+}
+
+static QVector<float> makeCoefficients(int numBlendshapes) {
+    // a handful of active coefficients, as while talking
+    QVector<float> coefficients(numBlendshapes, 0.0f);
+    for (int i = 0; i < numBlendshapes; i += 6) {
+        coefficients[i] = randFloatInRange(0.1f, 1.0f);
+    }
+    return coefficients;
+}
+
+void BlendshapeDeltasTests::sparseRows() {
+    const int NUM_VERTICES = 8;
+    BlendshapeDeltas deltas(NUM_VERTICES);
+    QCOMPARE(deltas.getNumBlendshapes(), 0);
+
+    // a vertex that doesn't move, and one that doesn't exist, are dropped
+    int indices[] = { 1, 2, 3, NUM_VERTICES };
+    glm::vec3 vertices[] = { glm::vec3(1.0f), glm::vec3(0.0f), glm::vec3(0.0f), glm::vec3(1.0f) };
+    glm::vec3 normals[] = { glm::vec3(0.0f), glm::vec3(0.0f), glm::vec3(1.0f), glm::vec3(1.0f) };
+    deltas.addBlendshape(indices, vertices, normals, 4, nullptr, 0, NORMAL_COEFFICIENT_SCALE);
+    QCOMPARE(deltas.getNumBlendshapes(), 1);
+    QCOMPARE(deltas.getNumDeltas(), 2);
+
+    // an empty blendshape still gets its row
+    deltas.addBlendshape(nullptr, nullptr, nullptr, 0, nullptr, 0, NORMAL_COEFFICIENT_SCALE);
+    QCOMPARE(deltas.getNumBlendshapes(), 2);
+    QCOMPARE(deltas.getNumDeltas(), 2);
+
+    float offsets[NUM_VERTICES][BlendshapeDeltas::DELTA_SIZE];
+    memset(offsets, 0xff, sizeof(offsets));
+    float coefficients[] = { 0.5f, 1.0f };
+    deltas.blend(coefficients, 2, COEFFICIENT_THRESHOLD, offsets);
+
+    QCOMPARE(offsets[1][0], 0.5f);
+    QCOMPARE(offsets[1][3], 0.0f);
+    QCOMPARE(offsets[3][0], 0.0f);
+    QCOMPARE(offsets[3][3], 0.5f * NORMAL_COEFFICIENT_SCALE);
+    for (int k = 0; k < BlendshapeDeltas::DELTA_SIZE; k++) {
+        QCOMPARE(offsets[0][k], 0.0f);
+        QCOMPARE(offsets[2][k], 0.0f);
+    }
+}
+
+void BlendshapeDeltasTests::blend() {
+    const int NUM_VERTICES = 2000;
+    const int NUM_BLENDSHAPES = 50;
+    QVector<Blendshape> blendshapes = makeBlendshapes(NUM_VERTICES, NUM_BLENDSHAPES);
+    BlendshapeDeltas deltas = packBlendshapes(NUM_VERTICES, blendshapes);
+    QCOMPARE(deltas.getNumBlendshapes(), NUM_BLENDSHAPES);
+
+    for (int frame = 0; frame < 10; frame++) {
+        QVector<float> coefficients = makeCoefficients(NUM_BLENDSHAPES);
+        // below the threshold, or negative, is skipped
+        coefficients[1] = COEFFICIENT_THRESHOLD * 0.5f;
+        coefficients[2] = -1.0f;
+        // fewer coefficients than blendshapes is fine, too
+        coefficients.resize(NUM_BLENDSHAPES - frame);
+
+        std::vector<float> expected;
+        blendDense(NUM_VERTICES, blendshapes, coefficients, expected);
+
+        std::vector<float> offsets(NUM_VERTICES * BlendshapeDeltas::DELTA_SIZE, 1.0f);
+        deltas.blend(coefficients.constData(), coefficients.size(), COEFFICIENT_THRESHOLD,
+                     reinterpret_cast<float(*)[BlendshapeDeltas::DELTA_SIZE]>(offsets.data()));
+
+        for (size_t i = 0; i < offsets.size(); i++) {
+            QCOMPARE_WITH_ABS_ERROR(offsets[i], expected[i], 1.0e-6f);
+        }
+    }
+}
+
+#ifdef MANUAL_TEST
+
+void BlendshapeDeltasTests::benchmark() {
+    const int NUM_VERTICES = 10000;
+    const int NUM_BLENDSHAPES = 52;
+    const int NUM_FRAMES = 100;
+
+    QVector<Blendshape> blendshapes = makeBlendshapes(NUM_VERTICES, NUM_BLENDSHAPES);
+    BlendshapeDeltas deltas = packBlendshapes(NUM_VERTICES, blendshapes);
+    std::cout << NUM_VERTICES << " vertices, " << NUM_BLENDSHAPES << " blendshapes, "
+              << deltas.getNumDeltas() << " deltas that move a vertex" << std::endl;
+
+    for (int numModels : { 1, 10, 50 }) {
+        std::vector<QVector<float>> coefficients;
+        for (int i = 0; i < numModels; i++) {
+            coefficients.push_back(makeCoefficients(NUM_BLENDSHAPES));
+        }
+        std::vector<float> offsets(NUM_VERTICES * BlendshapeDeltas::DELTA_SIZE);
+
+        uint64_t start = usecTimestampNow();
+        for (int frame = 0; frame < NUM_FRAMES; frame++) {
+            for (int i = 0; i < numModels; i++) {
+                blendDense(NUM_VERTICES, blendshapes, coefficients[i], offsets);
+            }
+        }
+        uint64_t dense = usecTimestampNow() - start;
+
+        start = usecTimestampNow();
+        for (int frame = 0; frame < NUM_FRAMES; frame++) {
+            for (int i = 0; i < numModels; i++) {
+                deltas.blend(coefficients[i].constData(), coefficients[i].size(), COEFFICIENT_THRESHOLD,
+                             reinterpret_cast<float(*)[BlendshapeDeltas::DELTA_SIZE]>(offsets.data()));
+            }
+        }
+        uint64_t sparse = usecTimestampNow() - start;
+
+        std::cout << numModels << " models: dense " << (float)dense / NUM_FRAMES << " us/frame, sparse "
+                  << (float)sparse / NUM_FRAMES << " us/frame" << std::endl;
+    }
+}
+
+#endif // MANUAL_TEST
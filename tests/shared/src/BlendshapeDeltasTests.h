@@ -0,0 +1,26 @@
+//
+//  BlendshapeDeltasTests.h
+//  tests/shared/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_BlendshapeDeltasTests_h
+#define hifi_BlendshapeDeltasTests_h
+
+#include <QtTest/QtTest>
+
+class BlendshapeDeltasTests : public QObject {
+    Q_OBJECT
+private slots:
+    void sparseRows();
+    void blend();
+#ifdef MANUAL_TEST
+    void benchmark();
+#endif // MANUAL_TEST
+};
+
+#endif // hifi_BlendshapeDeltasTests_h
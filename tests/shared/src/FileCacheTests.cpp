@@ -10,7 +10,13 @@
 
 #include "FileCacheTests.h"
 
+#include <iostream>
+#include <random>
+#include <thread>
+
 #include <shared/FileCache.h>
+#include <NumericalConstants.h>
+#include <SharedUtil.h>
 
 QTEST_GUILESS_MAIN(FileCacheTests)
 
@@ -58,8 +64,9 @@ void FileCacheTests::testUnusedFiles() {
         }
         QCOMPARE(cache->getNumCachedFiles(), (size_t)0);
         QCOMPARE(cache->getNumTotalFiles(), (size_t)100);
-        // Release the in-use files
+        // Release the in-use files, and let the cache evict the overbudget ones
         inUseFiles.clear();
+        cache->flush();
         QCOMPARE(cache->getNumCachedFiles(), (size_t)10);
         QCOMPARE(cache->getNumTotalFiles(), (size_t)10);
         QVERIFY(getCacheDirectorySize() <= MAX_UNUSED_SIZE);
@@ -110,6 +117,7 @@ void FileCacheTests::testUnusedFiles() {
         QCOMPARE(cache->getNumCachedFiles(), (size_t)0);
         QCOMPARE(cache->getNumTotalFiles(), (size_t)10);
         inUseFiles.clear();
+        cache->flush();
         QCOMPARE(cache->getNumCachedFiles(), (size_t)10);
         QCOMPARE(cache->getNumTotalFiles(), (size_t)10);
     }
@@ -156,6 +164,85 @@ void FileCacheTests::testWipe() {
     QCOMPARE(getCacheDirectorySize(), (size_t)0);
 }
 
+void FileCacheTests::testAsyncWrites() {
+    QTemporaryDir testDir;
+    auto cache = makeFileCache(testDir.path());
+    for (int i = 0; i < 20; ++i) {
+        cache->writeFileAsync(TEST_DATA, FileCache::Metadata(getFileKey(i), TEST_DATA.size()));
+        QThread::msleep(10);
+    }
+    cache->flush();
+    // only the newest 10 fit
+    QCOMPARE(cache->getNumTotalFiles(), (size_t)10);
+    QCOMPARE(cache->getNumCachedFiles(), (size_t)10);
+    QVERIFY(cache->getSizeTotalFiles() <= MAX_UNUSED_SIZE);
+
+    // Restarting picks the entries back up from the index
+    cache.reset();
+    QVERIFY(QFileInfo(QDir(testDir.path()).filePath("filecache.idx")).exists());
+    cache = makeFileCache(testDir.path());
+    QCOMPARE(cache->getNumTotalFiles(), (size_t)10);
+    for (int i = 10; i < 20; ++i) {
+        QVERIFY(cache->getFile(getFileKey(i)).get());
+    }
+
+    // ... unless the directory changed behind its back
+    cache.reset();
+    QFile::remove(QDir(testDir.path()).filePath((getFileKey(10) + ".tmp").c_str()));
+    cache = makeFileCache(testDir.path());
+    QCOMPARE(cache->getNumTotalFiles(), (size_t)9);
+    QVERIFY(!cache->getFile(getFileKey(10)).get());
+}
+
+#ifdef MANUAL_TEST
+
+void FileCacheTests::concurrentBenchmark() {
+    const int NUM_KEYS = 2000;
+    const int OPERATIONS_PER_THREAD = 5000;
+    const QByteArray data { 16 * 1024, 'x' };
+    const int numThreads = std::max((int)std::thread::hardware_concurrency(), 2);
+
+    QTemporaryDir testDir;
+    auto cache = makeFileCache(testDir.path());
+    // a quarter of the keys fit, so that the readers keep the eviction busy
+    cache->setMaxSize(NUM_KEYS / 4 * data.size());
+
+    std::atomic<int> hits { 0 };
+    std::atomic<int> misses { 0 };
+    std::vector<std::thread> threads;
+    uint64_t start = usecTimestampNow();
+    for (int t = 0; t < numThreads; ++t) {
+        threads.emplace_back([&, t] {
+            std::mt19937 random(t);
+            std::uniform_int_distribution<int> keys(0, NUM_KEYS - 1);
+            for (int i = 0; i < OPERATIONS_PER_THREAD; ++i) {
+                std::string key = QString::number(keys(random)).toStdString();
+                if (cache->getFile(key)) {
+                    ++hits;
+                } else {
+                    ++misses;
+                    if (i % 2) {
+                        cache->writeFileAsync(data, FileCache::Metadata(key, data.size()));
+                    } else {
+                        cache->writeFile(data.constData(), FileCache::Metadata(key, data.size()));
+                    }
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    uint64_t elapsed = usecTimestampNow() - start;
+    cache->flush();
+
+    int operations = numThreads * OPERATIONS_PER_THREAD;
+    std::cout << numThreads << " threads: " << (float)operations * USECS_PER_SECOND / elapsed << " ops/s, "
+              << hits << " hits, " << misses << " misses, " << cache->getNumTotalFiles() << " files left" << std::endl;
+    QVERIFY(cache->getSizeTotalFiles() <= NUM_KEYS / 4 * (size_t)data.size());
+}
+
+#endif // MANUAL_TEST
 
 void FileCacheTests::cleanupTestCase() {
 }
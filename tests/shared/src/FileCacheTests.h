@@ -21,6 +21,10 @@ private slots:
     void testFreeSpacePreservation();
     void cleanupTestCase();
     void testWipe();
+    void testAsyncWrites();
+#ifdef MANUAL_TEST
+    void concurrentBenchmark();
+#endif // MANUAL_TEST
 
 private:
     size_t getFreeSpace() const;
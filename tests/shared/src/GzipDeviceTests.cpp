@@ -0,0 +1,151 @@
+//
+//  GzipDeviceTests.cpp
+//  tests/shared/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "GzipDeviceTests.h"
+
+#include <iostream>
+
+#include <Gzip.h>
+#include <GzipDevice.h>
+#include <NumericalConstants.h>
+#include <SharedUtil.h>
+
+QTEST_GUILESS_MAIN(GzipDeviceTests)
+
+// entity-like JSON, several blocks long
+static QByteArray makeJson(int size) {
+    QByteArray json;
+    qsrand(1);
+    while (json.size() < size) {
+        json += QString("{\n    \"id\": \"%1\",\n    \"position\": { \"x\": %2, \"y\": 1.5, \"z\": -2 }\n},\n")
+            .arg(QUuid::createUuid().toString()).arg(qrand() % 1000).toUtf8();
+    }
+    return json;
+}
+
+// writes the data in uneven pieces, as a JSON writer would
+static QByteArray compress(const QByteArray& data, int numThreads) {
+    QByteArray compressed;
+    QBuffer buffer(&compressed);
+    buffer.open(QIODevice::WriteOnly);
+    GzipDevice gzipDevice(&buffer, -1, numThreads);
+    if (!gzipDevice.open(QIODevice::WriteOnly)) {
+        return QByteArray();
+    }
+    int position = 0;
+    int size = 1;
+    while (position < data.size()) {
+        size = qMin(size, data.size() - position);
+        if (gzipDevice.write(data.constData() + position, size) != size) {
+            return QByteArray();
+        }
+        position += size;
+        size = size * 3 + 7;
+    }
+    return gzipDevice.finish() ? compressed : QByteArray();
+}
+
+static QByteArray decompress(QByteArray compressed, bool* hasError = nullptr) {
+    QBuffer buffer(&compressed);
+    buffer.open(QIODevice::ReadOnly);
+    GzipDevice gzipDevice(&buffer);
+    gzipDevice.open(QIODevice::ReadOnly);
+    QByteArray data = gzipDevice.readAll();
+    if (hasError) {
+        *hasError = gzipDevice.hasError();
+    }
+    return data;
+}
+
+void GzipDeviceTests::roundTrip() {
+    for (int size : { 0, 5, GzipDevice::DEFAULT_BLOCK_SIZE, 1000000 }) {
+        QByteArray json = makeJson(size);
+        QByteArray compressed = compress(json, 1);
+        QVERIFY(!compressed.isEmpty());
+
+        // the streaming writer gives what gzip() does, and each reads the other's output
+        QByteArray gzipped;
+        QVERIFY(gzip(json, gzipped));
+        if (!json.isEmpty()) {
+            QCOMPARE(compressed, gzipped);
+        }
+        QByteArray gunzipped;
+        QVERIFY(gunzip(compressed, gunzipped));
+        QCOMPARE(gunzipped, json);
+
+        bool hasError = true;
+        QCOMPARE(decompress(compressed, &hasError), json);
+        QVERIFY(!hasError);
+    }
+}
+
+void GzipDeviceTests::parallelMatchesGunzip() {
+    QByteArray json = makeJson(3000000);
+    QByteArray compressed = compress(json, 4);
+    QVERIFY(!compressed.isEmpty());
+
+    // a single gzip member that any gunzip reads
+    QByteArray gunzipped;
+    QVERIFY(gunzip(compressed, gunzipped));
+    QCOMPARE(gunzipped, json);
+    QCOMPARE(decompress(compressed), json);
+
+    // the output doesn't depend on the number of threads, and the blocks cost little in size
+    QCOMPARE(compress(json, 8), compressed);
+    QVERIFY(compressed.size() < compress(json, 1).size() * 1.01);
+
+    QCOMPARE(decompress(compress(QByteArray(), 4)), QByteArray());
+}
+
+void GzipDeviceTests::corruptData() {
+    QByteArray json = makeJson(1000000);
+    QByteArray compressed = compress(json, 4);
+
+    bool hasError = false;
+    decompress(compressed.left(compressed.size() - 12), &hasError);
+    QVERIFY(hasError);
+
+    hasError = false;
+    decompress(json, &hasError);
+    QVERIFY(hasError);
+
+    QBuffer buffer(&json);
+    buffer.open(QIODevice::ReadOnly);
+    QVERIFY(!GzipDevice::isGzipped(&buffer));
+    buffer.close();
+    buffer.setBuffer(&compressed);
+    buffer.open(QIODevice::ReadOnly);
+    QVERIFY(GzipDevice::isGzipped(&buffer));
+}
+
+#ifdef MANUAL_TEST
+
+void GzipDeviceTests::compressBenchmark() {
+    const int JSON_SIZE = 200 * BYTES_PER_KILOBYTE * BYTES_PER_KILOBYTE;
+    QByteArray json = makeJson(JSON_SIZE);
+
+    for (int numThreads = 1; numThreads <= QThread::idealThreadCount(); numThreads *= 2) {
+        quint64 start = usecTimestampNow();
+        QByteArray compressed = compress(json, numThreads);
+        quint64 elapsed = usecTimestampNow() - start;
+        std::cout << numThreads << " threads: " << json.size() / BYTES_PER_KILOBYTE << " KB to "
+                  << compressed.size() / BYTES_PER_KILOBYTE << " KB in " << (float)elapsed / USECS_PER_MSEC << " ms"
+                  << std::endl;
+    }
+
+    QByteArray compressed = compress(json, QThread::idealThreadCount());
+    quint64 start = usecTimestampNow();
+    QByteArray data = decompress(compressed);
+    quint64 elapsed = usecTimestampNow() - start;
+    QCOMPARE(data.size(), json.size());
+    std::cout << "inflated in " << (float)elapsed / USECS_PER_MSEC << " ms" << std::endl;
+}
+
+#endif // MANUAL_TEST
@@ -0,0 +1,27 @@
+//
+//  GzipDeviceTests.h
+//  tests/shared/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_GzipDeviceTests_h
+#define hifi_GzipDeviceTests_h
+
+#include <QtTest/QtTest>
+
+class GzipDeviceTests : public QObject {
+    Q_OBJECT
+private slots:
+    void roundTrip();
+    void parallelMatchesGunzip();
+    void corruptData();
+#ifdef MANUAL_TEST
+    void compressBenchmark();
+#endif // MANUAL_TEST
+};
+
+#endif // hifi_GzipDeviceTests_h
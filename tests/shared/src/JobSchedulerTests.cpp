@@ -0,0 +1,206 @@
+//
+//  JobSchedulerTests.cpp
+//  tests/shared/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "JobSchedulerTests.h"
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+#include <QtCore/QSemaphore>
+
+#include <JobScheduler.h>
+
+QTEST_MAIN(JobSchedulerTests)
+
+// occupies a thread until released
+class Blocker {
+public:
+    JobScheduler::Job job() { return [this] { _started.release(); _release.acquire(); }; }
+    void waitUntilStarted() { _started.acquire(); }
+    void release() { _release.release(); }
+
+private:
+    QSemaphore _started;
+    QSemaphore _release;
+};
+
+class Recorder {
+public:
+    JobScheduler::Job job(int id) {
+        return [this, id] {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _order.push_back(id);
+        };
+    }
+    std::vector<int> order() {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _order;
+    }
+
+private:
+    std::mutex _mutex;
+    std::vector<int> _order;
+};
+
+class DeleteCounter : public QRunnable {
+public:
+    DeleteCounter(std::atomic<int>& runs, std::atomic<int>& deletes) : _runs(runs), _deletes(deletes) {}
+    ~DeleteCounter() { _deletes++; }
+    void run() override { _runs++; }
+
+private:
+    std::atomic<int>& _runs;
+    std::atomic<int>& _deletes;
+};
+
+void JobSchedulerTests::priorityOrder() {
+    QThreadPool pool;
+    pool.setMaxThreadCount(1);
+    JobScheduler scheduler;
+    scheduler.setThreadPool(&pool);
+
+    Blocker blocker;
+    Recorder recorder;
+    scheduler.submit(JobScheduler::AUDIO, blocker.job());
+    blocker.waitUntilStarted();
+
+    // queued behind the blocker: the class comes first, then the priority, then the order of submission
+    scheduler.submit(JobScheduler::TEXTURE, recorder.job(1), [] { return 1.0f; });
+    scheduler.submit(JobScheduler::TEXTURE, recorder.job(2), [] { return 3.0f; });
+    scheduler.submit(JobScheduler::TEXTURE, recorder.job(3), [] { return 2.0f; });
+    scheduler.submit(JobScheduler::BACKGROUND, recorder.job(4));
+    scheduler.submit(JobScheduler::GEOMETRY, recorder.job(5));
+    scheduler.submit(JobScheduler::TEXTURE, recorder.job(6), [] { return 3.0f; });
+    QCOMPARE(scheduler.getNumQueuedJobs(), 6);
+    QCOMPARE(scheduler.getStats(JobScheduler::TEXTURE).queued, 4);
+
+    blocker.release();
+    QVERIFY(scheduler.waitForDone(10000));
+
+    std::vector<int> expected { 5, 2, 6, 3, 1, 4 };
+    QCOMPARE(recorder.order(), expected);
+    QCOMPARE(scheduler.getNumQueuedJobs(), 0);
+    QCOMPARE(scheduler.getNumRunningJobs(), 0);
+    pool.waitForDone();
+}
+
+void JobSchedulerTests::manyJobsOrder() {
+    const int NUM_JOBS = 500;
+    const int NUM_PRIORITIES = 37;
+
+    QThreadPool pool;
+    pool.setMaxThreadCount(1);
+    JobScheduler scheduler;
+    scheduler.setThreadPool(&pool);
+
+    Blocker blocker;
+    Recorder recorder;
+    scheduler.submit(JobScheduler::AUDIO, blocker.job());
+    blocker.waitUntilStarted();
+
+    // many repeated priorities, so that the order of submission decides between most of them
+    std::vector<int> expected;
+    for (int i = 0; i < NUM_JOBS; i++) {
+        float priority = (float)((i * 11) % NUM_PRIORITIES);
+        scheduler.submit(JobScheduler::TEXTURE, recorder.job(i), [priority] { return priority; });
+        expected.push_back(i);
+    }
+    std::stable_sort(expected.begin(), expected.end(), [&](int a, int b) {
+        return (a * 11) % NUM_PRIORITIES > (b * 11) % NUM_PRIORITIES;
+    });
+
+    blocker.release();
+    QVERIFY(scheduler.waitForDone(10000));
+    QCOMPARE(recorder.order(), expected);
+    pool.waitForDone();
+}
+
+void JobSchedulerTests::cancellation() {
+    QThreadPool pool;
+    pool.setMaxThreadCount(1);
+    JobScheduler scheduler;
+    scheduler.setThreadPool(&pool);
+
+    Blocker blocker;
+    scheduler.submit(JobScheduler::AUDIO, blocker.job());
+    blocker.waitUntilStarted();
+
+    std::atomic<int> runs { 0 };
+    std::atomic<int> deletes { 0 };
+    std::atomic<bool> released { false };
+    scheduler.submit(JobScheduler::TEXTURE, new DeleteCounter(runs, deletes), nullptr, [&] { return released.load(); });
+    scheduler.submit(JobScheduler::TEXTURE, new DeleteCounter(runs, deletes));
+    released = true;
+
+    blocker.release();
+    QVERIFY(scheduler.waitForDone(10000));
+    pool.waitForDone();
+
+    QCOMPARE(runs.load(), 1);
+    QCOMPARE(deletes.load(), 2);
+}
+
+void JobSchedulerTests::concurrencyLimit() {
+    const int NUM_THREADS = 4;
+    const int NUM_JOBS = 16;
+    QThreadPool pool;
+    pool.setMaxThreadCount(NUM_THREADS);
+    JobScheduler scheduler;
+    scheduler.setThreadPool(&pool);
+
+    for (int limit : { 1, 2, 0 }) {
+        scheduler.setConcurrencyLimit(JobScheduler::TEXTURE, limit);
+        int expectedLimit = limit > 0 ? limit : NUM_THREADS - 1;
+
+        std::atomic<int> running { 0 };
+        std::atomic<int> mostRunning { 0 };
+        for (int i = 0; i < NUM_JOBS; i++) {
+            scheduler.submit(JobScheduler::TEXTURE, [&] {
+                int nowRunning = ++running;
+                int most = mostRunning.load();
+                while (nowRunning > most && !mostRunning.compare_exchange_weak(most, nowRunning)) {}
+                QThread::msleep(5);
+                running--;
+            });
+        }
+        QVERIFY(scheduler.waitForDone(10000));
+        pool.waitForDone();
+
+        QVERIFY(mostRunning.load() <= expectedLimit);
+        QVERIFY(mostRunning.load() > 0);
+    }
+}
+
+void JobSchedulerTests::clear() {
+    QThreadPool pool;
+    pool.setMaxThreadCount(1);
+    JobScheduler scheduler;
+    scheduler.setThreadPool(&pool);
+
+    Blocker blocker;
+    scheduler.submit(JobScheduler::AUDIO, blocker.job());
+    blocker.waitUntilStarted();
+
+    std::atomic<int> runs { 0 };
+    std::atomic<int> deletes { 0 };
+    for (int i = 0; i < 4; i++) {
+        scheduler.submit(JobScheduler::GEOMETRY, new DeleteCounter(runs, deletes));
+    }
+    scheduler.clear();
+    QCOMPARE(scheduler.getNumQueuedJobs(), 0);
+    QCOMPARE(deletes.load(), 4);
+
+    blocker.release();
+    QVERIFY(scheduler.waitForDone(10000));
+    pool.waitForDone();
+    QCOMPARE(runs.load(), 0);
+}
@@ -0,0 +1,26 @@
+//
+//  JobSchedulerTests.h
+//  tests/shared/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_JobSchedulerTests_h
+#define hifi_JobSchedulerTests_h
+
+#include <QtTest/QtTest>
+
+class JobSchedulerTests : public QObject {
+    Q_OBJECT
+private slots:
+    void priorityOrder();
+    void manyJobsOrder();
+    void cancellation();
+    void concurrencyLimit();
+    void clear();
+};
+
+#endif // hifi_JobSchedulerTests_h
@@ -12,6 +12,7 @@
 #include "SpaceTests.h"
 
 #include <iostream>
+#include <thread>
 
 #include <workload/Space.h>
 #include <StreamUtils.h>
@@ -22,85 +23,117 @@ const float INV_SQRT_3 = 1.0f / sqrtf(3.0f);
 
 QTEST_MAIN(SpaceTests)
 
+using Changes = std::vector<workload::Space::Change>;
+
+static int32_t createProxy(workload::Space& space, const workload::Sphere& sphere) {
+    int32_t proxyId = space.allocateID();
+    workload::Transaction transaction;
+    transaction.reset(proxyId, sphere, workload::Owner());
+    space.enqueueTransaction(transaction);
+    return proxyId;
+}
+
+static void updateProxy(workload::Space& space, int32_t proxyId, const workload::Sphere& sphere) {
+    workload::Transaction transaction;
+    transaction.update(proxyId, sphere);
+    space.enqueueTransaction(transaction);
+}
+
+static void deleteProxy(workload::Space& space, int32_t proxyId) {
+    workload::Transaction transaction;
+    transaction.remove(proxyId);
+    space.enqueueTransaction(transaction);
+}
+
+static void processTransactions(workload::Space& space) {
+    space.enqueueFrame();
+    space.processTransactionQueue();
+}
+
+static workload::View makeView(const glm::vec3& center, float near, float mid, float far) {
+    workload::View view;
+    view.origin = center;
+    view.regions[workload::Region::R1] = workload::Sphere(center, near);
+    view.regions[workload::Region::R2] = workload::Sphere(center, mid);
+    view.regions[workload::Region::R3] = workload::Sphere(center, far);
+    return view;
+}
+
 void SpaceTests::testOverlaps() {
     workload::Space space;
-    using Changes = std::vector<workload::Space::Change>;
-    using Views = std::vector<workload::Space::View>;
 
     glm::vec3 viewCenter(0.0f, 0.0f, 0.0f);
     float near = 1.0f;
     float mid = 2.0f;
     float far = 3.0f;
 
-    Views views;
-    views.push_back(workload::Space::View(viewCenter, near, mid, far));
+    workload::Views views;
+    views.push_back(makeView(viewCenter, near, mid, far));
     space.setViews(views);
 
     int32_t proxyId = 0;
     const float DELTA = 0.001f;
     float proxyRadius = 0.5f;
     glm::vec3 proxyPosition = viewCenter + glm::vec3(0.0f, 0.0f, far + proxyRadius + DELTA);
-    workload::Space::Sphere proxySphere(proxyPosition, proxyRadius);
+    workload::Sphere proxySphere(proxyPosition, proxyRadius);
 
     { // create very_far proxy
-        proxyId = space.createProxy(proxySphere);
+        proxyId = createProxy(space, proxySphere);
+        processTransactions(space);
         QVERIFY(space.getNumObjects() == 1);
 
         Changes changes;
         space.categorizeAndGetChanges(changes);
-        QVERIFY(changes.size() == 0);
+        QVERIFY(changes.size() == 1);
+        QVERIFY(changes[0].proxyId == proxyId);
+        QVERIFY(changes[0].region == workload::Region::R4);
+        QVERIFY(changes[0].prevRegion == workload::Region::UNKNOWN);
     }
 
     { // move proxy far
         float newRadius = 1.0f;
         glm::vec3 newPosition = viewCenter + glm::vec3(0.0f, 0.0f, far + newRadius - DELTA);
-        workload::Space::Sphere newSphere(newPosition, newRadius);
-        std::vector<workload::Space::ProxyUpdate> updates;
-        updates.push_back(workload::Space::ProxyUpdate(proxyId, newSphere));
-        space.updateProxies(updates);
+        updateProxy(space, proxyId, workload::Sphere(newPosition, newRadius));
+        processTransactions(space);
         Changes changes;
         space.categorizeAndGetChanges(changes);
         QVERIFY(changes.size() == 1);
         QVERIFY(changes[0].proxyId == proxyId);
-        QVERIFY(changes[0].region == workload::Space::REGION_FAR);
-        QVERIFY(changes[0].prevRegion == workload::Space::REGION_UNKNOWN);
+        QVERIFY(changes[0].region == workload::Region::R3);
+        QVERIFY(changes[0].prevRegion == workload::Region::R4);
     }
 
     { // move proxy mid
         float newRadius = 1.0f;
         glm::vec3 newPosition = viewCenter + glm::vec3(0.0f, 0.0f, mid + newRadius - DELTA);
-        workload::Space::Sphere newSphere(newPosition, newRadius);
-        std::vector<workload::Space::ProxyUpdate> updates;
-        updates.push_back(workload::Space::ProxyUpdate(proxyId, newSphere));
-        space.updateProxies(updates);
+        updateProxy(space, proxyId, workload::Sphere(newPosition, newRadius));
+        processTransactions(space);
         Changes changes;
         space.categorizeAndGetChanges(changes);
         QVERIFY(changes.size() == 1);
         QVERIFY(changes[0].proxyId == proxyId);
-        QVERIFY(changes[0].region == workload::Space::REGION_MIDDLE);
-        QVERIFY(changes[0].prevRegion == workload::Space::REGION_FAR);
+        QVERIFY(changes[0].region == workload::Region::R2);
+        QVERIFY(changes[0].prevRegion == workload::Region::R3);
     }
 
     { // move proxy near
         float newRadius = 1.0f;
         glm::vec3 newPosition = viewCenter + glm::vec3(0.0f, 0.0f, near + newRadius - DELTA);
-        workload::Space::Sphere newSphere(newPosition, newRadius);
-        std::vector<workload::Space::ProxyUpdate> updates;
-        updates.push_back(workload::Space::ProxyUpdate(proxyId, newSphere));
-        space.updateProxies(updates);
+        updateProxy(space, proxyId, workload::Sphere(newPosition, newRadius));
+        processTransactions(space);
         Changes changes;
         space.categorizeAndGetChanges(changes);
         QVERIFY(changes.size() == 1);
         QVERIFY(changes[0].proxyId == proxyId);
-        QVERIFY(changes[0].region == workload::Space::REGION_NEAR);
-        QVERIFY(changes[0].prevRegion == workload::Space::REGION_MIDDLE);
+        QVERIFY(changes[0].region == workload::Region::R1);
+        QVERIFY(changes[0].prevRegion == workload::Region::R2);
+        QVERIFY(space.getRegion(proxyId) == workload::Region::R1);
     }
 
     { // delete proxy
         // NOTE: atm deleting a proxy doesn't result in a "Change"
-        std::vector<int32_t> deadProxies;
-        deadProxies.push_back(proxyId);
-        space.deleteProxies(deadProxies);
+        deleteProxy(space, proxyId);
+        processTransactions(space);
         Changes changes;
         space.categorizeAndGetChanges(changes);
         QVERIFY(changes.size() == 0);
@@ -108,8 +141,6 @@ void SpaceTests::testOverlaps() {
     }
 }
 
-#ifdef MANUAL_TEST
-
 const float WORLD_WIDTH = 1000.0f;
 const float MIN_RADIUS = 1.0f;
 const float MAX_RADIUS = 100.0f;
@@ -123,35 +154,169 @@ glm::vec3 randomVec3() {
     return v;
 }
 
-void generateSpheres(uint32_t numProxies, std::vector<workload::Space::Sphere>& spheres) {
+void generateSpheres(uint32_t numProxies, std::vector<workload::Sphere>& spheres) {
     spheres.reserve(numProxies);
     for (uint32_t i = 0; i < numProxies; ++i) {
-        workload::Space::Sphere sphere(
+        workload::Sphere sphere(
                 WORLD_WIDTH * randomFloat(),
                 WORLD_WIDTH * randomFloat(),
                 WORLD_WIDTH * randomFloat(),
-                (MIN_RADIUS + (MAX_RADIUS - MIN_RADIUS)) * randomFloat());
+                MIN_RADIUS + (MAX_RADIUS - MIN_RADIUS) * 0.5f * (randomFloat() + 1.0f));
         spheres.push_back(sphere);
     }
 }
 
-void generatePositions(uint32_t numProxies, std::vector<glm::vec3>& positions) {
-    positions.reserve(numProxies);
-    for (uint32_t i = 0; i < numProxies; ++i) {
-        positions.push_back(WORLD_WIDTH * randomVec3());
+void generateViews(const glm::vec3& offset, workload::Views& views) {
+    float radius0 = 0.25f * WORLD_WIDTH;
+    float radius1 = 0.50f * WORLD_WIDTH;
+    float radius2 = 0.75f * WORLD_WIDTH;
+    views.clear();
+    views.push_back(makeView(offset, radius0, radius1, radius2));
+    views.push_back(makeView(offset + glm::vec3(0.0f, 0.0f, 0.1f * WORLD_WIDTH), radius0, radius1, radius2));
+}
+
+// the innermost region of any view that the sphere touches
+static uint8_t expectedRegion(const workload::Sphere& sphere, const workload::Views& views) {
+    uint8_t region = workload::Region::R4;
+    for (auto& view : views) {
+        for (uint8_t k = 0; k < region; ++k) {
+            float touchDistance = sphere.w + view.regions[k].w;
+            if (glm::distance2(glm::vec3(sphere), glm::vec3(view.regions[k])) < touchDistance * touchDistance) {
+                region = k;
+                break;
+            }
+        }
     }
+    return region;
 }
 
-void generateRadiuses(uint32_t numRadiuses, std::vector<float>& radiuses) {
-    radiuses.reserve(numRadiuses);
-    for (uint32_t i = 0; i < numRadiuses; ++i) {
-        radiuses.push_back(MIN_RADIUS + (MAX_RADIUS - MIN_RADIUS) * randomFloat());
+void SpaceTests::testManyProxies() {
+    // enough proxies to span several categorization batches, with a partial batch at the end
+    const uint32_t NUM_PROXIES = 5 * workload::Space::CATEGORIZE_BATCH_SIZE + 123;
+
+    srand(0);
+    workload::Space space;
+    workload::Views views;
+    generateViews(glm::vec3(0.0f), views);
+    space.setViews(views);
+
+    std::vector<workload::Sphere> spheres;
+    generateSpheres(NUM_PROXIES, spheres);
+    std::vector<int32_t> proxyIds;
+    for (auto& sphere : spheres) {
+        proxyIds.push_back(createProxy(space, sphere));
+    }
+    processTransactions(space);
+
+    // every proxy starts UNKNOWN, so every proxy changes
+    Changes changes;
+    space.categorizeAndGetChanges(changes);
+    QCOMPARE((uint32_t)changes.size(), NUM_PROXIES);
+    for (uint32_t i = 0; i < NUM_PROXIES; ++i) {
+        QCOMPARE(changes[i].proxyId, proxyIds[i]);
+        QCOMPARE(changes[i].prevRegion, (uint8_t)workload::Region::UNKNOWN);
+        QCOMPARE(changes[i].region, expectedRegion(spheres[i], views));
+    }
+
+    // move the views, and only the proxies that change region are reported, in order
+    workload::Views oldViews = views;
+    generateViews(glm::vec3(0.1f * WORLD_WIDTH, 0.0f, 0.0f), views);
+    space.setViews(views);
+    changes.clear();
+    space.categorizeAndGetChanges(changes);
+
+    uint32_t numExpectedChanges = 0;
+    for (uint32_t i = 0; i < NUM_PROXIES; ++i) {
+        uint8_t region = expectedRegion(spheres[i], views);
+        QCOMPARE(space.getRegion(proxyIds[i]), region);
+        if (region != expectedRegion(spheres[i], oldViews)) {
+            ++numExpectedChanges;
+        }
+    }
+    QVERIFY(numExpectedChanges > 0);
+    QCOMPARE((uint32_t)changes.size(), numExpectedChanges);
+    for (size_t i = 1; i < changes.size(); ++i) {
+        QVERIFY(changes[i - 1].proxyId < changes[i].proxyId);
+    }
+    for (auto& change : changes) {
+        QCOMPARE(change.region, expectedRegion(spheres[change.proxyId], views));
+        QCOMPARE(change.prevRegion, expectedRegion(spheres[change.proxyId], oldViews));
+    }
+
+    // move a few scattered proxies, and the next pass sees them where they are now, and the rest where they were
+    std::vector<workload::Sphere> movedSpheres;
+    generateSpheres(NUM_PROXIES / 1000, movedSpheres);
+    for (uint32_t j = 0; j < (uint32_t)movedSpheres.size(); ++j) {
+        uint32_t i = j * 997 % NUM_PROXIES;
+        spheres[i] = movedSpheres[j];
+        updateProxy(space, proxyIds[i], spheres[i]);
+    }
+    processTransactions(space);
+    changes.clear();
+    space.categorizeAndGetChanges(changes);
+    for (uint32_t i = 0; i < NUM_PROXIES; ++i) {
+        QCOMPARE(space.getRegion(proxyIds[i]), expectedRegion(spheres[i], views));
     }
 }
 
+void SpaceTests::testConcurrentTransactions() {
+    const uint32_t NUM_PROXIES = 3 * workload::Space::CATEGORIZE_BATCH_SIZE;
+    const int NUM_FRAMES = 50;
+
+    srand(0);
+    workload::Space space;
+    workload::Views views;
+    generateViews(glm::vec3(0.0f), views);
+    space.setViews(views);
+
+    std::vector<workload::Sphere> spheres;
+    generateSpheres(NUM_PROXIES, spheres);
+    std::vector<int32_t> proxyIds;
+    for (auto& sphere : spheres) {
+        proxyIds.push_back(createProxy(space, sphere));
+    }
+    processTransactions(space);
+
+    // move, remove and add proxies while the main thread categorizes
+    std::vector<workload::Sphere> newSpheres;
+    generateSpheres(NUM_PROXIES, newSpheres);
+    std::thread transactions([&] {
+        for (int frame = 0; frame < NUM_FRAMES; ++frame) {
+            for (uint32_t i = frame; i < NUM_PROXIES; i += NUM_FRAMES) {
+                if (i % 3 == 0) {
+                    deleteProxy(space, proxyIds[i]);
+                    proxyIds[i] = createProxy(space, newSpheres[i]);
+                } else {
+                    updateProxy(space, proxyIds[i], newSpheres[i]);
+                }
+            }
+            processTransactions(space);
+        }
+    });
+    Changes changes;
+    for (int frame = 0; frame < NUM_FRAMES; ++frame) {
+        space.categorizeAndGetChanges(changes);
+        for (size_t i = 1; i < changes.size(); ++i) {
+            QVERIFY(changes[i - 1].proxyId < changes[i].proxyId);
+        }
+        changes.clear();
+    }
+    transactions.join();
+
+    // anything changed during the last pass is picked up by the next one
+    space.categorizeAndGetChanges(changes);
+    space.categorizeAndGetChanges(changes);
+    QCOMPARE(space.getNumObjects(), NUM_PROXIES);
+    for (uint32_t i = 0; i < NUM_PROXIES; ++i) {
+        QCOMPARE(space.getRegion(proxyIds[i]), expectedRegion(newSpheres[i], views));
+    }
+}
+
+#ifdef MANUAL_TEST
+
 void SpaceTests::benchmark() {
-    uint32_t numProxies[] = { 100, 1000, 10000, 100000 };
-    uint32_t numTests = 4;
+    uint32_t numProxies[] = { 10000, 100000, 1000000 };
+    uint32_t numTests = 3;
     std::vector<uint64_t> timeToAddAll;
     std::vector<uint64_t> timeToMoveView;
     std::vector<uint64_t> timeToMoveProxies;
@@ -159,23 +324,13 @@ void SpaceTests::benchmark() {
     for (uint32_t i = 0; i < numTests; ++i) {
 
         workload::Space space;
-
-        { // build the views
-            std::vector<glm::vec3> viewPositions;
-            viewPositions.push_back(glm::vec3(0.0f, 0.0f, 0.0f));
-            viewPositions.push_back(glm::vec3(0.0f, 0.0f, 0.1f * WORLD_WIDTH));
-            float radius0 = 0.25f * WORLD_WIDTH;
-            float radius1 = 0.50f * WORLD_WIDTH;
-            float radius2 = 0.75f * WORLD_WIDTH;
-            std::vector<workload::Space::View> views;
-            views.push_back(workload::Space::View(viewPositions[0], radius0, radius1, radius2));
-            views.push_back(workload::Space::View(viewPositions[1], radius0, radius1, radius2));
-            space.setViews(views);
-        }
+        workload::Views views;
+        generateViews(glm::vec3(0.0f), views);
+        space.setViews(views);
 
         // build the proxies
         uint32_t n = numProxies[i];
-        std::vector<workload::Space::Sphere> proxySpheres;
+        std::vector<workload::Sphere> proxySpheres;
         generateSpheres(n, proxySpheres);
         std::vector<int32_t> proxyKeys;
         proxyKeys.reserve(n);
@@ -183,28 +338,18 @@ void SpaceTests::benchmark() {
         // measure time to put proxies in the space
         uint64_t startTime = usecTimestampNow();
         for (uint32_t j = 0; j < n; ++j) {
-            int32_t key = space.createProxy(proxySpheres[j]);
-            proxyKeys.push_back(key);
+            proxyKeys.push_back(createProxy(space, proxySpheres[j]));
         }
+        processTransactions(space);
+        Changes changes;
+        space.categorizeAndGetChanges(changes);
         uint64_t usec = usecTimestampNow() - startTime;
         timeToAddAll.push_back(usec);
 
-        {
-            // build the views
-            std::vector<glm::vec3> viewPositions;
-            viewPositions.push_back(glm::vec3(1.0f, 2.0f, 3.0f));
-            viewPositions.push_back(glm::vec3(1.0f, 2.0f, 3.0f + 0.1f * WORLD_WIDTH));
-            float radius0 = 0.25f * WORLD_WIDTH;
-            float radius1 = 0.50f * WORLD_WIDTH;
-            float radius2 = 0.75f * WORLD_WIDTH;
-            std::vector<workload::Space::View> views;
-            views.push_back(workload::Space::View(viewPositions[0], radius0, radius1, radius2));
-            views.push_back(workload::Space::View(viewPositions[1], radius0, radius1, radius2));
-            space.setViews(views);
-        }
-
-        // measure time to categorizeAndGetChanges everything
-        std::vector<workload::Space::Change> changes;
+        // measure time to categorizeAndGetChanges everything after the views move
+        generateViews(glm::vec3(1.0f, 2.0f, 3.0f), views);
+        space.setViews(views);
+        changes.clear();
         startTime = usecTimestampNow();
         space.categorizeAndGetChanges(changes);
         usec = usecTimestampNow() - startTime;
@@ -212,28 +357,16 @@ void SpaceTests::benchmark() {
 
         // move every 10th proxy around
         const float proxySpeed = 1.0f;
-        std::vector<workload::Space::Sphere> newSpheres;
-        uint32_t numMovingProxies = n / 10;
-        uint32_t jstep = n / numMovingProxies;
-        uint32_t maxJ = numMovingProxies * jstep - 1;
-        glm::vec3 direction;
-        for (uint32_t j = 0; j < maxJ - jstep; j += jstep) {
-            glm::vec3 position = (glm::vec3)proxySpheres[j];
-            glm::vec3 destination = (glm::vec3)proxySpheres[j + jstep];
-            direction = glm::normalize(destination - position);
-            glm::vec3 newPosition = position + proxySpeed * direction;
-            newSpheres.push_back(workload::Space::Sphere(newPosition, proxySpheres[j].w));
-        }
-        glm::vec3 position = (glm::vec3)proxySpheres[maxJ = jstep];
-        glm::vec3 destination = (glm::vec3)proxySpheres[0];
-        direction = glm::normalize(destination - position);
-        direction = position + proxySpeed * direction;
-        newSpheres.push_back(workload::Space::Sphere(direction, proxySpheres[0].w));
-        uint32_t k = 0;
         startTime = usecTimestampNow();
-        for (uint32_t j = 0; j < maxJ; j += jstep) {
-            space.updateProxy(proxyKeys[j], newSpheres[k++]);
+        workload::Transaction transaction;
+        for (uint32_t j = 0; j + 10 < n; j += 10) {
+            glm::vec3 position = (glm::vec3)proxySpheres[j];
+            glm::vec3 destination = (glm::vec3)proxySpheres[j + 10];
+            glm::vec3 newPosition = position + proxySpeed * glm::normalize(destination - position);
+            transaction.update(proxyKeys[j], workload::Sphere(newPosition, proxySpheres[j].w));
         }
+        space.enqueueTransaction(transaction);
+        processTransactions(space);
         changes.clear();
         space.categorizeAndGetChanges(changes);
         usec = usecTimestampNow() - startTime;
@@ -242,8 +375,9 @@ void SpaceTests::benchmark() {
         // measure time to remove proxies from space
         startTime = usecTimestampNow();
         for (uint32_t j = 0; j < n; ++j) {
-            space.deleteProxy(proxyKeys[j]);
+            deleteProxy(space, proxyKeys[j]);
         }
+        processTransactions(space);
         usec = usecTimestampNow() - startTime;
         timeToRemoveAll.push_back(usec);
     }
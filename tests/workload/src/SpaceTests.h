@@ -14,13 +14,13 @@
 
 #include <QtTest/QtTest>
 
-//#define MANUAL_TEST
-
 class SpaceTests : public QObject {
     Q_OBJECT
 
 private slots:
     void testOverlaps();
+    void testManyProxies();
+    void testConcurrentTransactions();
 #ifdef MANUAL_TEST
     void benchmark();
 #endif // MANUAL_TEST
@@ -15,12 +15,18 @@
 #include <QImageReader>
 #include <QtCore/QDebug>
 #include <QFile>
+#include <QJsonDocument>
+#include <QJsonObject>
 
+#include <iostream>
+#include <string>
+#include <thread>
 #include <unordered_map>
 
 #include "OvenCLIApplication.h"
 #include "ModelBakingLoggingCategory.h"
 #include "baking/BakerLibrary.h"
+#include "BakeCache.h"
 #include "JSBaker.h"
 #include "TextureBaker.h"
 #include "MaterialBaker.h"
@@ -29,6 +35,56 @@ BakerCLI::BakerCLI(OvenCLIApplication* parent) : QObject(parent) {
     
 }
 
+void BakerCLI::startWorker() {
+    _isWorker = true;
+    qDebug() << "Waiting for bake jobs";
+
+    // std::getline blocks, so stdin gets a thread of its own, and hands each line over to the main thread
+    std::thread([this] {
+        std::string line;
+        while (std::getline(std::cin, line)) {
+            QMetaObject::invokeMethod(this, "bakeJob", Qt::QueuedConnection, Q_ARG(QByteArray, QByteArray::fromStdString(line)));
+        }
+        QMetaObject::invokeMethod(QCoreApplication::instance(), "quit", Qt::QueuedConnection);
+    }).detach();
+}
+
+void BakerCLI::bakeJob(const QByteArray& line) {
+    auto job = QJsonDocument::fromJson(line).object();
+    if (job.isEmpty()) {
+        qCDebug(model_baking) << "Ignoring invalid bake job" << line;
+        finish(OVEN_STATUS_CODE_FAIL);
+        return;
+    }
+    bakeFile(QDir::fromNativeSeparators(job["input"].toString()), QDir::fromNativeSeparators(job["output"].toString()),
+             job["type"].toString());
+}
+
+void BakerCLI::finish(int statusCode) {
+    uint32_t cacheHits = 0;
+    uint32_t cacheMisses = 0;
+    if (auto bakeCache = BakeCache::getInstance()) {
+        cacheHits = bakeCache->getNumHits() - _startCacheHits;
+        cacheMisses = bakeCache->getNumMisses() - _startCacheMisses;
+        // a worker lives on after reporting, and may be killed at any point once it has, so the results it cached
+        // must be on disk first, where the other workers can find them
+        bakeCache->flush();
+    }
+    if (cacheHits + cacheMisses > 0) {
+        qCDebug(model_baking) << "Bake cache hits:" << cacheHits << "of" << (cacheHits + cacheMisses);
+    }
+
+    if (!_isWorker) {
+        QCoreApplication::exit(statusCode);
+        return;
+    }
+    if (_baker) {
+        // the baker lives on one of the oven's worker threads
+        _baker.release()->deleteLater();
+    }
+    std::cout << OVEN_WORKER_RESULT_PREFIX.constData() << statusCode << " " << cacheHits << " " << cacheMisses << std::endl;
+}
+
 void BakerCLI::bakeFile(QUrl inputUrl, const QString& outputPath, const QString& type) {
 
     // if the URL doesn't have a scheme, assume it is a local file
@@ -45,6 +101,11 @@ void BakerCLI::bakeFile(QUrl inputUrl, const QString& outputPath, const QString&
 
     _outputPath = outputPath;
 
+    if (auto bakeCache = BakeCache::getInstance()) {
+        _startCacheHits = bakeCache->getNumHits();
+        _startCacheMisses = bakeCache->getNumMisses();
+    }
+
     // create our appropiate baker
     if (type == MODEL_EXTENSION || type == FBX_EXTENSION) {
         QUrl bakeableModelURL = getBakeableModelURL(inputUrl);
@@ -91,7 +152,8 @@ void BakerCLI::bakeFile(QUrl inputUrl, const QString& outputPath, const QString&
             auto it = STRING_TO_TEXTURE_USAGE_TYPE_MAP.find(type);
             if (it == STRING_TO_TEXTURE_USAGE_TYPE_MAP.end()) {
                 qCDebug(model_baking) << "Unknown texture usage type:" << type;
-                QCoreApplication::exit(OVEN_STATUS_CODE_FAIL);
+                finish(OVEN_STATUS_CODE_FAIL);
+                return;
             }
             _baker = std::unique_ptr<Baker> { new TextureBaker(inputUrl, it->second, outputPath) };
             _baker->moveToThread(Oven::instance().getNextWorkerThread());
@@ -100,7 +162,7 @@ void BakerCLI::bakeFile(QUrl inputUrl, const QString& outputPath, const QString&
 
     if (!_baker) {
         qCDebug(model_baking) << "Failed to determine baker type for file" << inputUrl;
-        QCoreApplication::exit(OVEN_STATUS_CODE_FAIL);
+        finish(OVEN_STATUS_CODE_FAIL);
         return;
     }
 
@@ -125,5 +187,5 @@ void BakerCLI::handleFinishedBaker() {
             errorFile.close();
         }
     }
-    QCoreApplication::exit(exitCode);
+    finish(exitCode);
 }
@@ -27,21 +27,38 @@ static const int OVEN_STATUS_CODE_ABORT { 2 };
 
 static const QString OVEN_ERROR_FILENAME = "errors.txt";
 
+// In worker mode, the oven reads bake jobs from stdin, one JSON object per line with the same input, output and type
+// as the command line, and writes the result of each to stdout, on a line that starts with this prefix, followed by
+// the status code and the number of bake cache hits and misses of the job.
+static const QByteArray OVEN_WORKER_RESULT_PREFIX = "OVEN_RESULT ";
+
 class BakerCLI : public QObject {
     Q_OBJECT
 
 public:
     BakerCLI(OvenCLIApplication* parent);
 
+    /// Keeps baking the jobs read from stdin until it is closed, rather than exiting after one file.
+    /// Jobs are expected one at a time: the next one is only written once the result of the last has been read.
+    void startWorker();
+
 public slots:
     void bakeFile(QUrl inputUrl, const QString& outputPath, const QString& type = QString::null);
 
 private slots:
     void handleFinishedBaker();  
+    void bakeJob(const QByteArray& line);
 
 private:
+    void finish(int statusCode);
+
     QDir _outputPath;
     std::unique_ptr<Baker> _baker;
+    bool _isWorker { false };
+
+    // the bake cache counters when the current job started
+    uint32_t _startCacheHits { 0 };
+    uint32_t _startCacheMisses { 0 };
 };
 
 #endif // hifi_BakerCLI_h
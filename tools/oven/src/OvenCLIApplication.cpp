@@ -15,6 +15,7 @@
 #include <QtCore/QUrl>
 
 #include <image/TextureProcessing.h>
+#include <BakeCache.h>
 #include <TextureBaker.h>
 
 #include "BakerCLI.h"
@@ -23,15 +24,22 @@ static const QString CLI_INPUT_PARAMETER = "i";
 static const QString CLI_OUTPUT_PARAMETER = "o";
 static const QString CLI_TYPE_PARAMETER = "t";
 static const QString CLI_DISABLE_TEXTURE_COMPRESSION_PARAMETER = "disable-texture-compression";
+static const QString CLI_WORKER_PARAMETER = "worker";
+static const QString CLI_DISABLE_BAKE_CACHE_PARAMETER = "disable-bake-cache";
 
 QUrl OvenCLIApplication::_inputUrlParameter;
 QUrl OvenCLIApplication::_outputUrlParameter;
 QString OvenCLIApplication::_typeParameter;
+bool OvenCLIApplication::_workerParameter { false };
 
 OvenCLIApplication::OvenCLIApplication(int argc, char* argv[]) :
     QCoreApplication(argc, argv)
 {
     BakerCLI* cli = new BakerCLI(this);
+    if (_workerParameter) {
+        cli->startWorker();
+        return;
+    }
     QMetaObject::invokeMethod(cli, "bakeFile", Qt::QueuedConnection, Q_ARG(QUrl, _inputUrlParameter),
                               Q_ARG(QString, _outputUrlParameter.toString()), Q_ARG(QString, _typeParameter));
 }
@@ -45,7 +53,9 @@ void OvenCLIApplication::parseCommandLine(int argc, char* argv[]) {
         { CLI_INPUT_PARAMETER, "Path to file that you would like to bake.", "input" },
         { CLI_OUTPUT_PARAMETER, "Path to folder that will be used as output.", "output" },
         { CLI_TYPE_PARAMETER, "Type of asset. [model|material]"/*|js]"*/, "type" },
-        { CLI_DISABLE_TEXTURE_COMPRESSION_PARAMETER, "Disable texture compression." }
+        { CLI_DISABLE_TEXTURE_COMPRESSION_PARAMETER, "Disable texture compression." },
+        { CLI_WORKER_PARAMETER, "Keep running, and bake the jobs written to stdin as JSON lines with input, output and type." },
+        { CLI_DISABLE_BAKE_CACHE_PARAMETER, "Always bake, rather than reuse the results of earlier bakes of the same content." }
     });
 
     auto versionOption = parser.addVersionOption();
@@ -73,7 +83,9 @@ void OvenCLIApplication::parseCommandLine(int argc, char* argv[]) {
         Q_UNREACHABLE();
     }
 
-    if (!parser.isSet(CLI_INPUT_PARAMETER) || !parser.isSet(CLI_OUTPUT_PARAMETER)) {
+    _workerParameter = parser.isSet(CLI_WORKER_PARAMETER);
+
+    if (!_workerParameter && (!parser.isSet(CLI_INPUT_PARAMETER) || !parser.isSet(CLI_OUTPUT_PARAMETER))) {
         std::cout << "Error: Input and Output not set" << std::endl; // Avoid Qt log spam
         QCoreApplication mockApp(argc, argv); // required for call to showHelp()
         parser.showHelp();
@@ -89,4 +101,9 @@ void OvenCLIApplication::parseCommandLine(int argc, char* argv[]) {
         qDebug() << "Disabling texture compression";
         TextureBaker::setCompressionEnabled(false);
     }
+
+    if (parser.isSet(CLI_DISABLE_BAKE_CACHE_PARAMETER)) {
+        qDebug() << "Disabling bake cache";
+        BakeCache::setEnabled(false);
+    }
 }
@@ -42,14 +42,14 @@ bool vhacd::VHACDUtil::loadFBX(const QString filename, HFMModel& result) {
         return false;
     }
     try {
-        hifi::ByteArray fbxContents = fbx.readAll();
         HFMModel::Pointer hfmModel;
         hifi::VariantHash mapping;
         mapping["deduplicateIndices"] = true;
         if (filename.toLower().endsWith(".obj")) {
-            hfmModel = OBJSerializer().read(fbxContents, mapping, filename);
+            hfmModel = OBJSerializer().read(fbx.readAll(), mapping, filename);
         } else if (filename.toLower().endsWith(".fbx")) {
-            hfmModel = FBXSerializer().read(fbxContents, mapping, filename);
+            // parsed from a mapping of the file, since the models given to this tool can be large
+            hfmModel = FBXSerializer::readFile(filename, mapping);
         } else {
             qWarning() << "file has unknown extension" << filename;
             return false;